@@ -67,7 +67,18 @@ hg_test_usage(const char *execname)
     printf("    -t, --threads       Number of server threads\n");
     printf("    -B, --bidirectional Bidirectional communication\n");
     printf("    -u, --mrecv-ops     Number of multi-recv ops (server only)\n");
+    printf("    -A, --mrecv-adapt   Adapt multi-recv buffers (server only)\n");
+    printf("    -g, --hugepages     Use hugepage-backed message buffers\n");
     printf("    -i, --post-init     Number of handles posted (server only)\n");
+    printf("    -r, --trim-time     Idle time in ms before extra handles are "
+           "freed\n");
+    printf("    -e, --trace         Write handle trace to file\n");
+    printf("    -W, --spin-max      Max progress spin time in us before "
+           "blocking\n");
+    printf("    -q, --coalesce      Coalesce requests / responses to the same "
+           "peer\n");
+    printf("    -n, --req-max       Max number of requests in process (server "
+           "only)\n");
 }
 
 /*---------------------------------------------------------------------------*/
@@ -106,10 +117,34 @@ hg_test_parse_options(int argc, char *argv[], struct hg_test_info *hg_test_info)
                 hg_test_info->multi_recv_op_max =
                     (unsigned int) atoi(na_test_opt_arg_g);
                 break;
+            case 'A': /* multi_recv_adaptive */
+                hg_test_info->multi_recv_adaptive = HG_TRUE;
+                break;
+            case 'g': /* hugepage_arena */
+                hg_test_info->hugepage_arena = HG_TRUE;
+                break;
             case 'i': /* request_post_init */
                 hg_test_info->request_post_init =
                     (unsigned int) atoi(na_test_opt_arg_g);
                 break;
+            case 'r': /* request_trim_time */
+                hg_test_info->request_trim_time =
+                    (unsigned int) atoi(na_test_opt_arg_g);
+                break;
+            case 'e': /* trace_file */
+                hg_test_info->trace_file = na_test_opt_arg_g;
+                break;
+            case 'W': /* progress_spin_max */
+                hg_test_info->progress_spin_max =
+                    (unsigned int) atoi(na_test_opt_arg_g);
+                break;
+            case 'q': /* coalesce */
+                hg_test_info->coalesce = HG_TRUE;
+                break;
+            case 'n': /* request_max */
+                hg_test_info->request_max =
+                    (unsigned int) atoi(na_test_opt_arg_g);
+                break;
             default:
                 break;
         }
@@ -225,9 +260,27 @@ HG_Test_init(int argc, char *argv[], struct hg_test_info *hg_test_info)
         /* Multi-recv */
         hg_init_info.no_multi_recv = hg_test_info->na_test_info.no_multi_recv;
         hg_init_info.multi_recv_op_max = hg_test_info->multi_recv_op_max;
+        hg_init_info.multi_recv_adaptive = hg_test_info->multi_recv_adaptive;
+
+        /* Message buffers */
+        hg_init_info.hugepage_arena = hg_test_info->hugepage_arena;
 
         /* Post init */
         hg_init_info.request_post_init = hg_test_info->request_post_init;
+        hg_init_info.request_trim_time = hg_test_info->request_trim_time;
+
+        /* Admission control */
+        hg_init_info.request_max = hg_test_info->request_max;
+
+        /* Handle tracing */
+        hg_init_info.trace_file = hg_test_info->trace_file;
+
+        /* Adaptive progress spin */
+        hg_init_info.progress_spin_max = hg_test_info->progress_spin_max;
+
+        /* Coalescing */
+        hg_init_info.coalesce_requests = hg_test_info->coalesce;
+        hg_init_info.coalesce_responses = hg_test_info->coalesce;
 
         /* Init HG with init options */
         hg_test_info->hg_classes[i] =
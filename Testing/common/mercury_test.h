@@ -24,8 +24,15 @@ struct hg_test_info {
     unsigned int thread_count;        /* Max number of threads */
     unsigned int multi_recv_op_max;   /* Max number of multi-recv ops */
     unsigned int request_post_init;   /* Init number of posted handles */
+    unsigned int progress_spin_max;   /* Max progress spin time (us) */
+    unsigned int request_trim_time;   /* Idle time before trim (ms) */
+    unsigned int request_max;         /* Max number of requests in process */
+    const char *trace_file;           /* Handle trace file */
     hg_bool_t auto_sm;                /* Use shared-memory */
     hg_bool_t bidirectional;          /* Bidirectional tests */
+    hg_bool_t multi_recv_adaptive;    /* Adapt multi-recv buffers */
+    hg_bool_t hugepage_arena;         /* Hugepage-backed msg buffers */
+    hg_bool_t coalesce;               /* Coalesce requests / responses */
 };
 
 /*****************/
@@ -15,7 +15,7 @@
 int na_test_opt_ind_g = 1;            /* token pointer */
 const char *na_test_opt_arg_g = NULL; /* flag argument (or value) */
 const char *na_test_short_opt_g =
-    "hc:d:p:H:P:sSk:l:bC:X:VZ:y:z:w:x:mt:BRvMUf:T:u:i:";
+    "hc:d:p:H:P:sSk:l:bC:X:VZ:y:z:w:x:mt:BRvMUf:T:u:i:W:Agr:e:qn:";
 /* clang-format off */
 const struct na_test_opt na_test_opt_g[] = {
     {"help", no_arg, 'h'},
@@ -48,6 +48,13 @@ const struct na_test_opt na_test_opt_g[] = {
     {"tclass", require_arg, 'T'},
     {"mrecv-ops", require_arg, 'u'},
     {"post-init", require_arg, 'i'},
+    {"spin-max", require_arg, 'W'},
+    {"mrecv-adapt", no_arg, 'A'},
+    {"hugepages", no_arg, 'g'},
+    {"trim-time", require_arg, 'r'},
+    {"trace", require_arg, 'e'},
+    {"coalesce", no_arg, 'q'},
+    {"req-max", require_arg, 'n'},
     {NULL, 0, '\0'} /* Must add this at the end */
 };
 /* clang-format on */
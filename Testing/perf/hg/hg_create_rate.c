@@ -0,0 +1,175 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_perf.h"
+
+#include "mercury_thread.h"
+
+/****************/
+/* Local Macros */
+/****************/
+#define BENCHMARK_NAME "Handle create/destroy rate"
+
+/* Number of create/destroy pairs per thread and per loop */
+#define HG_PERF_CREATE_COUNT (10000)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+struct hg_perf_create_info {
+    hg_context_t *context;   /* HG context */
+    hg_addr_t addr;          /* Target addr */
+    hg_atomic_int32_t start; /* Threads can start */
+    int loop;                /* Number of loops */
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static HG_THREAD_RETURN_TYPE
+hg_perf_create_thread(void *arg);
+
+static hg_return_t
+hg_perf_run(const struct hg_test_info *hg_test_info,
+    struct hg_perf_class_info *info, unsigned int thread_count);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+hg_perf_create_thread(void *arg)
+{
+    struct hg_perf_create_info *create_info =
+        (struct hg_perf_create_info *) arg;
+    hg_thread_ret_t thread_ret = (hg_thread_ret_t) 0;
+    int loop;
+
+    while (!hg_atomic_get32(&create_info->start))
+        hg_thread_yield();
+
+    for (loop = 0; loop < create_info->loop; loop++) {
+        int i;
+
+        for (i = 0; i < HG_PERF_CREATE_COUNT; i++) {
+            hg_handle_t handle;
+            hg_return_t ret;
+
+            ret = HG_Create(create_info->context, create_info->addr,
+                (hg_id_t) HG_PERF_RATE, &handle);
+            HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Create() failed (%s)",
+                HG_Error_to_string(ret));
+
+            ret = HG_Destroy(handle);
+            HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Destroy() failed (%s)",
+                HG_Error_to_string(ret));
+        }
+    }
+
+done:
+    hg_thread_exit(thread_ret);
+    return thread_ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_run(const struct hg_test_info *hg_test_info,
+    struct hg_perf_class_info *info, unsigned int thread_count)
+{
+    struct hg_perf_create_info create_info = {.context = info->context,
+        .addr = info->target_addrs[0],
+        .start = HG_ATOMIC_VAR_INIT(0),
+        .loop = hg_test_info->na_test_info.loop};
+    hg_thread_t *threads = NULL;
+    unsigned int thread_started = 0, i;
+    hg_time_t t1, t2;
+    hg_return_t ret;
+
+    threads = (hg_thread_t *) malloc(thread_count * sizeof(*threads));
+    HG_TEST_CHECK_ERROR(threads == NULL, error, ret, HG_NOMEM,
+        "Could not allocate array of %u threads", thread_count);
+
+    for (i = 0; i < thread_count; i++) {
+        int rc =
+            hg_thread_create(&threads[i], hg_perf_create_thread, &create_info);
+        HG_TEST_CHECK_ERROR(
+            rc != 0, error, ret, HG_NOMEM, "hg_thread_create() failed");
+        thread_started++;
+    }
+
+    hg_time_get_current(&t1);
+    hg_atomic_set32(&create_info.start, 1);
+
+    for (i = 0; i < thread_started; i++)
+        hg_thread_join(threads[i]);
+
+    hg_time_get_current(&t2);
+
+    hg_perf_print_rate(thread_count,
+        (size_t) thread_count * (size_t) create_info.loop *
+            HG_PERF_CREATE_COUNT,
+        hg_time_subtract(t2, t1));
+
+    free(threads);
+
+    return HG_SUCCESS;
+
+error:
+    /* Let started threads exit without running */
+    create_info.loop = 0;
+    hg_atomic_set32(&create_info.start, 1);
+    for (i = 0; i < thread_started; i++)
+        hg_thread_join(threads[i]);
+    free(threads);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    struct hg_perf_info perf_info;
+    struct hg_test_info *hg_test_info;
+    struct hg_perf_class_info *info;
+    unsigned int thread_count;
+    hg_return_t hg_ret;
+
+    /* Initialize the interface */
+    hg_ret = hg_perf_init(argc, argv, false, &perf_info);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_init() failed (%s)",
+        HG_Error_to_string(hg_ret));
+    hg_test_info = &perf_info.hg_test_info;
+    info = &perf_info.class_info[0];
+
+    /* Handles are never forwarded, only target self */
+    HG_TEST_CHECK_ERROR(!hg_test_info->na_test_info.self_send, error, hg_ret,
+        HG_INVALID_ARG, "%s must be run with --self_send", argv[0]);
+
+    /* Header info */
+    hg_perf_print_header_create(hg_test_info, info, BENCHMARK_NAME);
+
+    /* Increase number of threads */
+    for (thread_count = 1; thread_count <= hg_test_info->thread_count;
+         thread_count *= 2) {
+        hg_ret = hg_perf_run(hg_test_info, info, thread_count);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_run() failed (%s)",
+            HG_Error_to_string(hg_ret));
+    }
+
+    hg_perf_cleanup(&perf_info);
+
+    return EXIT_SUCCESS;
+
+error:
+    hg_perf_cleanup(&perf_info);
+
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,349 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_perf.h"
+
+#include "mercury_thread.h"
+
+#ifndef _WIN32
+#    include <sys/uio.h>
+#endif
+
+/****************/
+/* Local Macros */
+/****************/
+#define BENCHMARK_NAME "Multi-threaded RPC forward rate"
+
+/* Number of RPCs forwarded per thread and per loop */
+#define HG_PERF_FORWARD_COUNT (10000)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+#ifdef _WIN32
+struct iovec {
+    void *iov_base; /* Pointer to data.  */
+    size_t iov_len; /* Length of data.  */
+};
+#endif
+
+struct hg_perf_forward_info {
+    hg_context_t *context;          /* Context of this thread */
+    hg_handle_t *handles;           /* Handles of this thread */
+    struct hg_perf_request request; /* RPCs completed */
+    struct iovec iov;               /* RPC payload */
+    hg_atomic_int32_t *start;       /* Threads can start */
+    int32_t forward_count;          /* Number of RPCs forwarded */
+    hg_return_t ret;                /* Thread return code */
+    hg_thread_t thread;             /* Thread */
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static hg_return_t
+hg_perf_forward_cb(const struct hg_cb_info *hg_cb_info);
+
+static HG_THREAD_RETURN_TYPE
+hg_perf_forward_thread(void *arg);
+
+static hg_return_t
+hg_perf_forward_info_init(struct hg_perf_class_info *info,
+    struct hg_perf_forward_info *forward_info, int32_t expected_count,
+    hg_atomic_int32_t *start);
+
+static void
+hg_perf_forward_info_free(
+    struct hg_perf_class_info *info, struct hg_perf_forward_info *forward_info);
+
+static hg_return_t
+hg_perf_run(const struct hg_test_info *hg_test_info,
+    struct hg_perf_class_info *info, unsigned int thread_count);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_forward_cb(const struct hg_cb_info *hg_cb_info)
+{
+    struct hg_perf_forward_info *forward_info =
+        (struct hg_perf_forward_info *) hg_cb_info->arg;
+    struct hg_perf_request *request = &forward_info->request;
+    hg_return_t ret = hg_cb_info->ret;
+
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "RPC failed (%s)", HG_Error_to_string(ret));
+
+    if ((++request->complete_count) == request->expected_count) {
+        hg_atomic_set32(&request->completed, (int32_t) true);
+        return HG_SUCCESS;
+    }
+
+    /* Keep the same number of RPCs in-flight until all are forwarded */
+    if (forward_info->forward_count < request->expected_count) {
+        forward_info->forward_count++;
+        ret = HG_Forward(hg_cb_info->info.forward.handle, hg_perf_forward_cb,
+            forward_info, &forward_info->iov);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    return HG_SUCCESS;
+
+error:
+    forward_info->ret = ret;
+    hg_atomic_set32(&request->completed, (int32_t) true);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+hg_perf_forward_thread(void *arg)
+{
+    struct hg_perf_forward_info *forward_info =
+        (struct hg_perf_forward_info *) arg;
+    struct hg_perf_request *request = &forward_info->request;
+    hg_thread_ret_t thread_ret = (hg_thread_ret_t) 0;
+    int32_t i;
+    hg_return_t ret;
+
+    while (!hg_atomic_get32(forward_info->start))
+        hg_thread_yield();
+
+    if (request->expected_count == 0)
+        goto done;
+
+    for (i = 0; i < forward_info->forward_count; i++) {
+        ret = HG_Forward(forward_info->handles[i], hg_perf_forward_cb,
+            forward_info, &forward_info->iov);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    /* Each thread makes progress on its own context */
+    while (!hg_atomic_get32(&request->completed)) {
+        unsigned int actual_count = 0;
+
+        ret = HG_Progress(forward_info->context, 0);
+        HG_TEST_CHECK_ERROR(ret != HG_SUCCESS && ret != HG_TIMEOUT, error, ret,
+            ret, "HG_Progress() failed (%s)", HG_Error_to_string(ret));
+
+        ret = HG_Trigger(forward_info->context, 0,
+            (unsigned int) forward_info->forward_count, &actual_count);
+        HG_TEST_CHECK_ERROR(ret != HG_SUCCESS && ret != HG_TIMEOUT, error, ret,
+            ret, "HG_Trigger() failed (%s)", HG_Error_to_string(ret));
+    }
+
+done:
+    hg_thread_exit(thread_ret);
+    return thread_ret;
+
+error:
+    forward_info->ret = ret;
+
+    hg_thread_exit(thread_ret);
+    return thread_ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_forward_info_init(struct hg_perf_class_info *info,
+    struct hg_perf_forward_info *forward_info, int32_t expected_count,
+    hg_atomic_int32_t *start)
+{
+    size_t i;
+    hg_return_t ret;
+
+    forward_info->request = (struct hg_perf_request){
+        .expected_count = expected_count,
+        .complete_count = 0,
+        .completed = HG_ATOMIC_VAR_INIT(0)};
+    forward_info->iov = (struct iovec){
+        .iov_base = info->rpc_buf, .iov_len = info->buf_size_min};
+    forward_info->start = start;
+    forward_info->forward_count = (int32_t) MIN(info->handle_max,
+        (size_t) expected_count); /* RPCs initially in-flight */
+    forward_info->ret = HG_SUCCESS;
+
+    forward_info->context = HG_Context_create(info->hg_class);
+    HG_TEST_CHECK_ERROR(forward_info->context == NULL, error, ret, HG_NOMEM,
+        "HG_Context_create() failed");
+
+    forward_info->handles =
+        (hg_handle_t *) calloc(info->handle_max, sizeof(hg_handle_t));
+    HG_TEST_CHECK_ERROR(forward_info->handles == NULL, error, ret, HG_NOMEM,
+        "Could not allocate array of %zu handles", info->handle_max);
+
+    for (i = 0; i < info->handle_max; i++) {
+        ret = HG_Create(forward_info->context, info->target_addrs[0],
+            (hg_id_t) HG_PERF_RATE, &forward_info->handles[i]);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    return HG_SUCCESS;
+
+error:
+    hg_perf_forward_info_free(info, forward_info);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_perf_forward_info_free(
+    struct hg_perf_class_info *info, struct hg_perf_forward_info *forward_info)
+{
+    if (forward_info->handles != NULL) {
+        size_t i;
+
+        for (i = 0; i < info->handle_max; i++)
+            if (forward_info->handles[i] != HG_HANDLE_NULL)
+                (void) HG_Destroy(forward_info->handles[i]);
+        free(forward_info->handles);
+        forward_info->handles = NULL;
+    }
+
+    if (forward_info->context != NULL) {
+        (void) HG_Context_destroy(forward_info->context);
+        forward_info->context = NULL;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_run(const struct hg_test_info *hg_test_info,
+    struct hg_perf_class_info *info, unsigned int thread_count)
+{
+    struct hg_perf_forward_info *forward_infos = NULL;
+    hg_atomic_int32_t start = HG_ATOMIC_VAR_INIT(0);
+    int32_t expected_count =
+        hg_test_info->na_test_info.loop * HG_PERF_FORWARD_COUNT;
+    unsigned int thread_started = 0, i;
+    hg_time_t t1, t2;
+    hg_return_t ret;
+
+    forward_infos = (struct hg_perf_forward_info *) calloc(
+        thread_count, sizeof(*forward_infos));
+    HG_TEST_CHECK_ERROR(forward_infos == NULL, error, ret, HG_NOMEM,
+        "Could not allocate array of %u thread infos", thread_count);
+
+    /* Contexts and handles are created before threads start */
+    for (i = 0; i < thread_count; i++) {
+        ret = hg_perf_forward_info_init(
+            info, &forward_infos[i], expected_count, &start);
+        HG_TEST_CHECK_HG_ERROR(error, ret,
+            "hg_perf_forward_info_init() failed (%s)",
+            HG_Error_to_string(ret));
+    }
+
+    for (i = 0; i < thread_count; i++) {
+        int rc = hg_thread_create(&forward_infos[i].thread,
+            hg_perf_forward_thread, &forward_infos[i]);
+        HG_TEST_CHECK_ERROR(
+            rc != 0, error, ret, HG_NOMEM, "hg_thread_create() failed");
+        thread_started++;
+    }
+
+    hg_time_get_current(&t1);
+    hg_atomic_set32(&start, 1);
+
+    for (i = 0; i < thread_started; i++)
+        hg_thread_join(forward_infos[i].thread);
+
+    hg_time_get_current(&t2);
+
+    for (i = 0; i < thread_count; i++)
+        HG_TEST_CHECK_HG_ERROR(error_free, forward_infos[i].ret,
+            "Thread %u failed (%s)", i,
+            HG_Error_to_string(forward_infos[i].ret));
+
+    hg_perf_print_rate(thread_count,
+        (size_t) thread_count * (size_t) expected_count,
+        hg_time_subtract(t2, t1));
+
+    for (i = 0; i < thread_count; i++)
+        hg_perf_forward_info_free(info, &forward_infos[i]);
+    free(forward_infos);
+
+    return HG_SUCCESS;
+
+error:
+    /* Let started threads exit without running */
+    for (i = 0; i < thread_started; i++)
+        forward_infos[i].request.expected_count = 0;
+    hg_atomic_set32(&start, 1);
+    for (i = 0; i < thread_started; i++)
+        hg_thread_join(forward_infos[i].thread);
+
+error_free:
+    if (forward_infos != NULL) {
+        for (i = 0; i < thread_count; i++)
+            hg_perf_forward_info_free(info, &forward_infos[i]);
+        free(forward_infos);
+    }
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    struct hg_perf_info perf_info;
+    struct hg_test_info *hg_test_info;
+    struct hg_perf_class_info *info;
+    unsigned int thread_count;
+    hg_return_t hg_ret;
+
+    /* Initialize the interface */
+    hg_ret = hg_perf_init(argc, argv, false, &perf_info);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_init() failed (%s)",
+        HG_Error_to_string(hg_ret));
+    hg_test_info = &perf_info.hg_test_info;
+    info = &perf_info.class_info[0];
+
+    /* Set HG handles (only used for buffer init) */
+    hg_ret = hg_perf_set_handles(hg_test_info, info, HG_PERF_RATE);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_set_handles() failed (%s)",
+        HG_Error_to_string(hg_ret));
+
+    /* Allocate RPC buffers */
+    hg_ret = hg_perf_rpc_buf_init(hg_test_info, info);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_init_rpc_buf() failed (%s)",
+        HG_Error_to_string(hg_ret));
+
+    /* Header info */
+    if (hg_test_info->na_test_info.mpi_info.rank == 0)
+        hg_perf_print_header_create(hg_test_info, info, BENCHMARK_NAME);
+
+    /* Increase number of threads, each thread uses its own context */
+    for (thread_count = 1; thread_count <= hg_test_info->thread_count;
+         thread_count *= 2) {
+        hg_ret = hg_perf_run(hg_test_info, info, thread_count);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_run() failed (%s)",
+            HG_Error_to_string(hg_ret));
+    }
+
+    /* Finalize interface */
+    if (hg_test_info->na_test_info.mpi_info.rank == 0)
+        hg_perf_send_done(info);
+
+    hg_perf_cleanup(&perf_info);
+
+    return EXIT_SUCCESS;
+
+error:
+    hg_perf_cleanup(&perf_info);
+
+    return EXIT_FAILURE;
+}
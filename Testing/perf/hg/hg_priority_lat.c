@@ -0,0 +1,260 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_perf.h"
+
+#ifndef _WIN32
+#    include <sys/uio.h>
+#endif
+
+/****************/
+/* Local Macros */
+/****************/
+#define BENCHMARK_NAME "RPC priority latency"
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+#ifdef _WIN32
+struct iovec {
+    void *iov_base; /* Pointer to data.  */
+    size_t iov_len; /* Length of data.  */
+};
+#endif
+
+struct hg_perf_priority_info {
+    struct hg_perf_request high_request; /* High priority RPCs completed */
+    struct hg_perf_request low_request;  /* Background handles stopped */
+    struct hg_histogram *histogram;      /* High priority latencies */
+    struct iovec high_iov;               /* High priority payload */
+    struct iovec low_iov;                /* Background payload */
+    hg_time_t forward_time;              /* Last high priority forward */
+    int32_t skip;                        /* Warm up count */
+    bool stop;                           /* Stop background traffic */
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static hg_return_t
+hg_perf_high_cb(const struct hg_cb_info *hg_cb_info);
+
+static hg_return_t
+hg_perf_low_cb(const struct hg_cb_info *hg_cb_info);
+
+static hg_return_t
+hg_perf_run(const struct hg_test_info *hg_test_info,
+    struct hg_perf_class_info *info, struct hg_perf_priority_info *prio_info,
+    bool prioritize);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_high_cb(const struct hg_cb_info *hg_cb_info)
+{
+    struct hg_perf_priority_info *prio_info =
+        (struct hg_perf_priority_info *) hg_cb_info->arg;
+    struct hg_perf_request *request = &prio_info->high_request;
+    hg_time_t now;
+    hg_return_t ret;
+
+    hg_time_get_current(&now);
+    if (request->complete_count >= prio_info->skip)
+        hg_histogram_record(prio_info->histogram,
+            (uint64_t) (hg_time_to_double(
+                            hg_time_subtract(now, prio_info->forward_time)) *
+                        1e9));
+
+    if ((++request->complete_count) == request->expected_count) {
+        prio_info->stop = true;
+        hg_atomic_set32(&request->completed, (int32_t) true);
+        return HG_SUCCESS;
+    }
+
+    prio_info->forward_time = now;
+    ret = HG_Forward(hg_cb_info->info.forward.handle, hg_perf_high_cb,
+        prio_info, &prio_info->high_iov);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_low_cb(const struct hg_cb_info *hg_cb_info)
+{
+    struct hg_perf_priority_info *prio_info =
+        (struct hg_perf_priority_info *) hg_cb_info->arg;
+    struct hg_perf_request *request = &prio_info->low_request;
+    hg_return_t ret;
+
+    /* Keep background traffic going until high priority RPCs are done */
+    if (prio_info->stop) {
+        if ((++request->complete_count) == request->expected_count)
+            hg_atomic_set32(&request->completed, (int32_t) true);
+        return HG_SUCCESS;
+    }
+
+    ret = HG_Forward(hg_cb_info->info.forward.handle, hg_perf_low_cb,
+        prio_info, &prio_info->low_iov);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_run(const struct hg_test_info *hg_test_info,
+    struct hg_perf_class_info *info, struct hg_perf_priority_info *prio_info,
+    bool prioritize)
+{
+    hg_return_t ret;
+    size_t i;
+
+    hg_histogram_reset(prio_info->histogram);
+    prio_info->high_request = (struct hg_perf_request){
+        .expected_count = prio_info->skip + hg_test_info->na_test_info.loop,
+        .complete_count = 0,
+        .completed = HG_ATOMIC_VAR_INIT(0)};
+    prio_info->low_request = (struct hg_perf_request){
+        .expected_count = (int32_t) info->handle_max - 1,
+        .complete_count = 0,
+        .completed = HG_ATOMIC_VAR_INIT(0)};
+    prio_info->stop = false;
+
+    /* Handle 0 carries latency-critical RPCs, others carry background RPCs */
+    ret = HG_Set_priority(info->handles[0],
+        prioritize ? HG_PRIORITY_HIGH : HG_PRIORITY_DEFAULT);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Set_priority() failed (%s)", HG_Error_to_string(ret));
+
+    for (i = 1; i < info->handle_max; i++) {
+        ret = HG_Set_priority(info->handles[i],
+            prioritize ? HG_PRIORITY_LOW : HG_PRIORITY_DEFAULT);
+        HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Set_priority() failed (%s)",
+            HG_Error_to_string(ret));
+
+        ret = HG_Forward(
+            info->handles[i], hg_perf_low_cb, prio_info, &prio_info->low_iov);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    hg_time_get_current(&prio_info->forward_time);
+    ret = HG_Forward(
+        info->handles[0], hg_perf_high_cb, prio_info, &prio_info->high_iov);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+
+    ret = hg_perf_request_wait(
+        info, &prio_info->high_request, HG_MAX_IDLE_TIME, NULL);
+    HG_TEST_CHECK_HG_ERROR(error, ret, "hg_perf_request_wait() failed (%s)",
+        HG_Error_to_string(ret));
+
+    /* Drain background traffic */
+    ret = hg_perf_request_wait(
+        info, &prio_info->low_request, HG_MAX_IDLE_TIME, NULL);
+    HG_TEST_CHECK_HG_ERROR(error, ret, "hg_perf_request_wait() failed (%s)",
+        HG_Error_to_string(ret));
+
+    hg_perf_print_priority(
+        prioritize ? "priority" : "fifo", prio_info->histogram);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    struct hg_perf_priority_info prio_info;
+    struct hg_perf_info perf_info;
+    struct hg_test_info *hg_test_info;
+    struct hg_perf_class_info *info;
+    hg_return_t hg_ret;
+
+    memset(&prio_info, 0, sizeof(prio_info));
+
+    /* Initialize the interface */
+    hg_ret = hg_perf_init(argc, argv, false, &perf_info);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_init() failed (%s)",
+        HG_Error_to_string(hg_ret));
+    hg_test_info = &perf_info.hg_test_info;
+    info = &perf_info.class_info[0];
+
+    /* One handle is used for high priority traffic */
+    HG_TEST_CHECK_ERROR(info->handle_max < 2, error, hg_ret, HG_INVALID_ARG,
+        "%s must be run with at least 2 handles in-flight", argv[0]);
+
+    prio_info.histogram =
+        (struct hg_histogram *) calloc(1, sizeof(*prio_info.histogram));
+    HG_TEST_CHECK_ERROR(prio_info.histogram == NULL, error, hg_ret, HG_NOMEM,
+        "Could not allocate histogram");
+
+    /* Allocate RPC buffers */
+    hg_ret = hg_perf_rpc_buf_init(hg_test_info, info);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_init_rpc_buf() failed (%s)",
+        HG_Error_to_string(hg_ret));
+
+    /* Set HG handles */
+    hg_ret = hg_perf_set_handles(hg_test_info, info, HG_PERF_RATE);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_set_handles() failed (%s)",
+        HG_Error_to_string(hg_ret));
+
+    /* High priority RPCs use the smallest size and background RPCs the
+     * largest size */
+    prio_info.high_iov = (struct iovec){
+        .iov_base = info->rpc_buf, .iov_len = info->buf_size_min};
+    prio_info.low_iov = (struct iovec){
+        .iov_base = info->rpc_buf, .iov_len = info->buf_size_max};
+    prio_info.skip = HG_PERF_LAT_SKIP_SMALL;
+
+    /* Header info */
+    if (hg_test_info->na_test_info.mpi_info.rank == 0)
+        hg_perf_print_header_priority(hg_test_info, info, BENCHMARK_NAME,
+            info->buf_size_min, info->buf_size_max);
+
+    /* Same traffic without and with priorities */
+    hg_ret = hg_perf_run(hg_test_info, info, &prio_info, false);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_run() failed (%s)",
+        HG_Error_to_string(hg_ret));
+
+    hg_ret = hg_perf_run(hg_test_info, info, &prio_info, true);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_run() failed (%s)",
+        HG_Error_to_string(hg_ret));
+
+    /* Finalize interface */
+    if (hg_test_info->na_test_info.mpi_info.rank == 0)
+        hg_perf_send_done(info);
+
+    free(prio_info.histogram);
+    hg_perf_cleanup(&perf_info);
+
+    return EXIT_SUCCESS;
+
+error:
+    free(prio_info.histogram);
+    hg_perf_cleanup(&perf_info);
+
+    return EXIT_FAILURE;
+}
@@ -35,6 +35,10 @@ static hg_return_t
 hg_perf_run(const struct hg_test_info *hg_test_info,
     struct hg_perf_class_info *info, size_t buf_size, size_t skip);
 
+static hg_return_t
+hg_perf_run_sizes(
+    const struct hg_test_info *hg_test_info, struct hg_perf_class_info *info);
+
 /*******************/
 /* Local Variables */
 /*******************/
@@ -108,6 +112,37 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_run_sizes(
+    const struct hg_test_info *hg_test_info, struct hg_perf_class_info *info)
+{
+    size_t size;
+    hg_return_t ret;
+
+    /* NULL RPC */
+    if (info->buf_size_min == 0) {
+        ret = hg_perf_run(hg_test_info, info, 0, HG_PERF_LAT_SKIP_SMALL);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "hg_perf_run() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    /* RPC with different sizes */
+    for (size = MAX(1, info->buf_size_min); size <= info->buf_size_max;
+         size *= 2) {
+        ret = hg_perf_run(hg_test_info, info, size,
+            (size > HG_PERF_LARGE_SIZE) ? HG_PERF_LAT_SKIP_LARGE
+                                        : HG_PERF_LAT_SKIP_SMALL);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "hg_perf_run() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 int
 main(int argc, char *argv[])
@@ -115,7 +150,6 @@ main(int argc, char *argv[])
     struct hg_perf_info perf_info;
     struct hg_test_info *hg_test_info;
     struct hg_perf_class_info *info;
-    size_t size;
     hg_return_t hg_ret;
 
     /* Initialize the interface */
@@ -139,21 +173,26 @@ main(int argc, char *argv[])
     if (hg_test_info->na_test_info.mpi_info.rank == 0)
         hg_perf_print_header_lat(hg_test_info, info, BENCHMARK_NAME);
 
-    /* NULL RPC */
-    if (info->buf_size_min == 0) {
-        hg_ret = hg_perf_run(hg_test_info, info, 0, HG_PERF_LAT_SKIP_SMALL);
-        HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_run() failed (%s)",
-            HG_Error_to_string(hg_ret));
-    }
+    hg_ret = hg_perf_run_sizes(hg_test_info, info);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_run_sizes() failed (%s)",
+        HG_Error_to_string(hg_ret));
 
-    /* RPC with different sizes */
-    for (size = MAX(1, info->buf_size_min); size <= info->buf_size_max;
-         size *= 2) {
-        hg_ret = hg_perf_run(hg_test_info, info, size,
-            (size > HG_PERF_LARGE_SIZE) ? HG_PERF_LAT_SKIP_LARGE
-                                        : HG_PERF_LAT_SKIP_SMALL);
-        HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_run() failed (%s)",
+    /* Compare with the same RPCs to self when procs are bypassed, the RPC
+     * callback then reads the origin buffer which prevents verification */
+    if (hg_test_info->na_test_info.self_send && !info->verify) {
+        hg_ret = HG_Registered_set_self_bypass(info->hg_class, HG_PERF_RATE,
+            sizeof(struct iovec), info->bidir ? sizeof(struct iovec) : 0);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+            "HG_Registered_set_self_bypass() failed (%s)",
             HG_Error_to_string(hg_ret));
+
+        if (hg_test_info->na_test_info.mpi_info.rank == 0)
+            hg_perf_print_header_lat(
+                hg_test_info, info, BENCHMARK_NAME " (self, no proc)");
+
+        hg_ret = hg_perf_run_sizes(hg_test_info, info);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+            "hg_perf_run_sizes() failed (%s)", HG_Error_to_string(hg_ret));
     }
 
     /* Finalize interface */
@@ -0,0 +1,229 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_perf.h"
+
+#include "mercury_thread.h"
+
+/****************/
+/* Local Macros */
+/****************/
+#define BENCHMARK_NAME "Completion trigger rate"
+
+/* RPC ID used for self-forwarded RPCs (no response) */
+#define HG_PERF_TRIGGER_RATE (HG_PERF_DONE + 1)
+
+/* Trigger timeout */
+#define HG_PERF_TRIGGER_TIMEOUT (100)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+struct hg_perf_trigger_info {
+    hg_context_t *context;             /* HG context */
+    hg_atomic_int64_t triggered_count; /* Number of triggered entries */
+    hg_atomic_int32_t completed;       /* Number of completed forwards */
+    hg_atomic_int32_t done;            /* Threads must exit */
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static HG_THREAD_RETURN_TYPE
+hg_perf_trigger_thread(void *arg);
+
+static hg_return_t
+hg_perf_trigger_rpc_cb(hg_handle_t handle);
+
+static hg_return_t
+hg_perf_trigger_forward_cb(const struct hg_cb_info *hg_cb_info);
+
+static hg_return_t
+hg_perf_run(const struct hg_test_info *hg_test_info,
+    struct hg_perf_class_info *info, unsigned int thread_count);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+hg_perf_trigger_thread(void *arg)
+{
+    struct hg_perf_trigger_info *trigger_info =
+        (struct hg_perf_trigger_info *) arg;
+    hg_thread_ret_t thread_ret = (hg_thread_ret_t) 0;
+
+    while (!hg_atomic_get32(&trigger_info->done)) {
+        unsigned int actual_count = 0;
+        hg_return_t ret;
+
+        ret = HG_Trigger(trigger_info->context, HG_PERF_TRIGGER_TIMEOUT, 1,
+            &actual_count);
+        if (ret == HG_TIMEOUT)
+            continue;
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Trigger() failed (%s)", HG_Error_to_string(ret));
+
+        if (actual_count > 0)
+            hg_atomic_incr64(&trigger_info->triggered_count);
+    }
+
+done:
+    hg_thread_exit(thread_ret);
+    return thread_ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_trigger_rpc_cb(hg_handle_t handle)
+{
+    return HG_Destroy(handle);
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_trigger_forward_cb(const struct hg_cb_info *hg_cb_info)
+{
+    struct hg_perf_trigger_info *trigger_info =
+        (struct hg_perf_trigger_info *) hg_cb_info->arg;
+
+    hg_atomic_incr32(&trigger_info->completed);
+
+    return HG_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_run(const struct hg_test_info *hg_test_info,
+    struct hg_perf_class_info *info, unsigned int thread_count)
+{
+    struct hg_perf_trigger_info trigger_info = {.context = info->context,
+        .triggered_count = HG_ATOMIC_VAR_INIT(0),
+        .completed = HG_ATOMIC_VAR_INIT(0),
+        .done = HG_ATOMIC_VAR_INIT(0)};
+    hg_thread_t *threads = NULL;
+    unsigned int thread_started = 0, i;
+    hg_time_t t1, t2;
+    hg_return_t ret;
+    int loop;
+
+    threads = (hg_thread_t *) malloc(thread_count * sizeof(*threads));
+    HG_TEST_CHECK_ERROR(threads == NULL, error, ret, HG_NOMEM,
+        "Could not allocate array of %u threads", thread_count);
+
+    for (i = 0; i < thread_count; i++) {
+        int rc = hg_thread_create(
+            &threads[i], hg_perf_trigger_thread, &trigger_info);
+        HG_TEST_CHECK_ERROR(
+            rc != 0, error, ret, HG_NOMEM, "hg_thread_create() failed");
+        thread_started++;
+    }
+
+    hg_time_get_current(&t1);
+
+    for (loop = 0; loop < hg_test_info->na_test_info.loop; loop++) {
+        size_t j;
+
+        hg_atomic_set32(&trigger_info.completed, 0);
+
+        /* Each self-forward produces one process and one forward completion */
+        for (j = 0; j < info->handle_max; j++) {
+            ret = HG_Forward(info->handles[j], hg_perf_trigger_forward_cb,
+                &trigger_info, NULL);
+            HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Forward() failed (%s)",
+                HG_Error_to_string(ret));
+        }
+
+        while (hg_atomic_get32(&trigger_info.completed) <
+               (int32_t) info->handle_max)
+            hg_thread_yield();
+    }
+
+    hg_time_get_current(&t2);
+
+    hg_perf_print_rate(thread_count,
+        (size_t) hg_atomic_get64(&trigger_info.triggered_count),
+        hg_time_subtract(t2, t1));
+
+    hg_atomic_set32(&trigger_info.done, 1);
+    for (i = 0; i < thread_started; i++)
+        hg_thread_join(threads[i]);
+    free(threads);
+
+    return HG_SUCCESS;
+
+error:
+    hg_atomic_set32(&trigger_info.done, 1);
+    for (i = 0; i < thread_started; i++)
+        hg_thread_join(threads[i]);
+    free(threads);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    struct hg_perf_info perf_info;
+    struct hg_test_info *hg_test_info;
+    struct hg_perf_class_info *info;
+    unsigned int thread_count;
+    hg_return_t hg_ret;
+
+    /* Initialize the interface */
+    hg_ret = hg_perf_init(argc, argv, false, &perf_info);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_init() failed (%s)",
+        HG_Error_to_string(hg_ret));
+    hg_test_info = &perf_info.hg_test_info;
+    info = &perf_info.class_info[0];
+
+    /* Completions are generated locally */
+    HG_TEST_CHECK_ERROR(!hg_test_info->na_test_info.self_send, error, hg_ret,
+        HG_INVALID_ARG, "%s must be run with --self_send", argv[0]);
+
+    /* Register RPC with no response */
+    hg_ret = HG_Register(
+        info->hg_class, HG_PERF_TRIGGER_RATE, NULL, NULL, hg_perf_trigger_rpc_cb);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "HG_Register() failed (%s)",
+        HG_Error_to_string(hg_ret));
+
+    hg_ret = HG_Registered_disable_response(
+        info->hg_class, HG_PERF_TRIGGER_RATE, HG_TRUE);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+        "HG_Registered_disable_response() failed (%s)",
+        HG_Error_to_string(hg_ret));
+
+    /* Set HG handles */
+    hg_ret = hg_perf_set_handles(
+        hg_test_info, info, (enum hg_perf_rpc_id) HG_PERF_TRIGGER_RATE);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_set_handles() failed (%s)",
+        HG_Error_to_string(hg_ret));
+
+    /* Header info */
+    hg_perf_print_header_trigger(hg_test_info, info, BENCHMARK_NAME);
+
+    /* Increase number of trigger threads */
+    for (thread_count = 1; thread_count <= hg_test_info->thread_count;
+         thread_count *= 2) {
+        hg_ret = hg_perf_run(hg_test_info, info, thread_count);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_run() failed (%s)",
+            HG_Error_to_string(hg_ret));
+    }
+
+    hg_perf_cleanup(&perf_info);
+
+    return EXIT_SUCCESS;
+
+error:
+    hg_perf_cleanup(&perf_info);
+
+    return EXIT_FAILURE;
+}
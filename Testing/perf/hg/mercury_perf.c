@@ -1220,6 +1220,77 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+void
+hg_perf_print_header_trigger(const struct hg_test_info *hg_test_info,
+    const struct hg_perf_class_info *info, const char *benchmark)
+{
+    printf("# %s v%s\n", benchmark, VERSION_NAME);
+    printf("# Loop %d times from 1 to %u trigger thread(s) with %zu handle(s) "
+           "in-flight\n",
+        hg_test_info->na_test_info.loop, hg_test_info->thread_count,
+        info->handle_max);
+    printf("%-*s%*s%*s\n", 10, "# Threads", NWIDTH, "Avg time (us)", NWIDTH,
+        "Avg rate (completions/s)");
+    fflush(stdout);
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_perf_print_rate(unsigned int thread_count, size_t op_count, hg_time_t t)
+{
+    double op_time;
+
+    op_time = hg_time_to_double(t) * 1e6 / (double) op_count;
+
+    printf("%-*u%*.*f%*lu\n", 10, thread_count, NWIDTH, NDIGITS, op_time,
+        NWIDTH, (long unsigned int) (1e6 / op_time));
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_perf_print_header_create(const struct hg_test_info *hg_test_info,
+    const struct hg_perf_class_info *info, const char *benchmark)
+{
+    (void) info;
+
+    printf("# %s v%s\n", benchmark, VERSION_NAME);
+    printf("# Loop %d times from 1 to %u thread(s)\n",
+        hg_test_info->na_test_info.loop, hg_test_info->thread_count);
+    printf("%-*s%*s%*s\n", 10, "# Threads", NWIDTH, "Avg time (us)", NWIDTH,
+        "Avg rate (ops/s)");
+    fflush(stdout);
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_perf_print_header_priority(const struct hg_test_info *hg_test_info,
+    const struct hg_perf_class_info *info, const char *benchmark,
+    size_t high_size, size_t low_size)
+{
+    printf("# %s v%s\n", benchmark, VERSION_NAME);
+    printf("# Loop %d times with 1 high priority handle of size %zu byte(s) "
+           "and %zu background handle(s) of size %zu byte(s) in-flight\n",
+        hg_test_info->na_test_info.loop, high_size, info->handle_max - 1,
+        low_size);
+    printf("%-*s%*s%*s%*s%*s\n", 10, "# Mode", NWIDTH / 2, "p50 (us)",
+        NWIDTH / 2, "p99 (us)", NWIDTH / 2, "p99.9 (us)", NWIDTH / 2,
+        "Max (us)");
+    fflush(stdout);
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_perf_print_priority(const char *mode, const struct hg_histogram *histogram)
+{
+    printf("%-*s%*.*f%*.*f%*.*f%*.*f\n", 10, mode, NWIDTH / 2, NDIGITS,
+        (double) hg_histogram_percentile(histogram, 50.0) / 1e3, NWIDTH / 2,
+        NDIGITS, (double) hg_histogram_percentile(histogram, 99.0) / 1e3,
+        NWIDTH / 2, NDIGITS,
+        (double) hg_histogram_percentile(histogram, 99.9) / 1e3, NWIDTH / 2,
+        NDIGITS, (double) hg_histogram_max(histogram) / 1e3);
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 hg_perf_send_done(struct hg_perf_class_info *info)
@@ -11,6 +11,7 @@
 #include "mercury_test.h"
 
 #include "mercury_bulk.h"
+#include "mercury_histogram.h"
 #include "mercury_param.h"
 #include "mercury_poll.h"
 #include "mercury_time.h"
@@ -145,6 +146,25 @@ void
 hg_perf_print_bw(const struct hg_test_info *hg_test_info,
     const struct hg_perf_class_info *info, size_t buf_size, hg_time_t t);
 
+void
+hg_perf_print_header_trigger(const struct hg_test_info *hg_test_info,
+    const struct hg_perf_class_info *info, const char *benchmark);
+
+void
+hg_perf_print_rate(unsigned int thread_count, size_t op_count, hg_time_t t);
+
+void
+hg_perf_print_header_create(const struct hg_test_info *hg_test_info,
+    const struct hg_perf_class_info *info, const char *benchmark);
+
+void
+hg_perf_print_header_priority(const struct hg_test_info *hg_test_info,
+    const struct hg_perf_class_info *info, const char *benchmark,
+    size_t high_size, size_t low_size);
+
+void
+hg_perf_print_priority(const char *mode, const struct hg_histogram *histogram);
+
 hg_return_t
 hg_perf_send_done(struct hg_perf_class_info *info);
 
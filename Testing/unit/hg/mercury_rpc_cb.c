@@ -304,6 +304,26 @@ HG_TEST_RPC_CB(hg_test_cancel_rpc, handle)
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+HG_TEST_RPC_CB(hg_test_rpc_sleep, handle)
+{
+    hg_return_t ret = HG_SUCCESS;
+
+    /* Hold handle for a while before responding */
+    hg_time_sleep(hg_time_from_ms(HG_TEST_RPC_SLEEP_TIME));
+
+    ret = HG_Respond(handle, NULL, NULL, NULL);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Respond() failed (%s)", HG_Error_to_string(ret));
+
+done:
+    ret = HG_Destroy(handle);
+    HG_TEST_CHECK_ERROR_DONE(
+        ret != HG_SUCCESS, "HG_Destroy() failed (%s)", HG_Error_to_string(ret));
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 HG_TEST_RPC_CB(hg_test_bulk_write, handle)
 {
@@ -782,6 +802,7 @@ HG_TEST_THREAD_CB(hg_test_rpc_open)
 HG_TEST_THREAD_CB(hg_test_rpc_open_no_resp)
 HG_TEST_THREAD_CB(hg_test_overflow)
 HG_TEST_THREAD_CB(hg_test_cancel_rpc)
+HG_TEST_THREAD_CB(hg_test_rpc_sleep)
 
 HG_TEST_THREAD_CB(hg_test_bulk_write)
 HG_TEST_THREAD_CB(hg_test_bulk_bind_write)
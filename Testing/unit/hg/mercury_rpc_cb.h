@@ -21,6 +21,8 @@ hg_return_t
 hg_test_overflow_cb(hg_handle_t handle);
 hg_return_t
 hg_test_cancel_rpc_cb(hg_handle_t handle);
+hg_return_t
+hg_test_rpc_sleep_cb(hg_handle_t handle);
 
 /**
  * test_bulk
@@ -50,7 +50,7 @@ hg_test_finalize_rpc_cb(const struct hg_cb_info *callback_info);
 static hg_return_t
 hg_test_finalize_cb(hg_handle_t handle);
 
-static void
+static hg_return_t
 hg_test_register(hg_class_t *hg_class);
 
 /*******************/
@@ -63,6 +63,7 @@ hg_id_t hg_test_rpc_open_id_g = 0;
 hg_id_t hg_test_rpc_open_id_no_resp_g = 0;
 hg_id_t hg_test_overflow_id_g = 0;
 hg_id_t hg_test_cancel_rpc_id_g = 0;
+hg_id_t hg_test_rpc_sleep_id_g = 0;
 
 /* test_bulk */
 hg_id_t hg_test_bulk_write_id_g = 0;
@@ -199,7 +200,7 @@ done:
 }
 
 /*---------------------------------------------------------------------------*/
-static void
+static hg_return_t
 hg_test_register(hg_class_t *hg_class)
 {
     /* test_rpc */
@@ -219,6 +220,8 @@ hg_test_register(hg_class_t *hg_class)
         overflow_out_t, hg_test_overflow_cb);
     hg_test_cancel_rpc_id_g = MERCURY_REGISTER(
         hg_class, "hg_test_cancel_rpc", void, void, hg_test_cancel_rpc_cb);
+    hg_test_rpc_sleep_id_g = MERCURY_REGISTER(
+        hg_class, "hg_test_rpc_sleep", void, void, hg_test_rpc_sleep_cb);
 
     /* test_bulk */
     hg_test_bulk_write_id_g = MERCURY_REGISTER(hg_class, "hg_test_bulk_write",
@@ -244,6 +247,9 @@ hg_test_register(hg_class_t *hg_class)
     /* test_finalize */
     hg_test_finalize_id_g = MERCURY_REGISTER(
         hg_class, "hg_test_finalize", void, void, hg_test_finalize_cb);
+
+    /* All test RPCs are registered, lookups can use a frozen RPC map */
+    return HG_Registered_freeze(hg_class);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -340,7 +346,9 @@ hg_unit_init(int argc, char *argv[], bool listen, struct hg_unit_info *info)
         HG_Error_to_string(ret));
 
     /* Register routines */
-    hg_test_register(info->hg_class);
+    ret = hg_test_register(info->hg_class);
+    HG_TEST_CHECK_HG_ERROR(error, ret, "hg_test_register() failed (%s)",
+        HG_Error_to_string(ret));
 
     if (listen || info->hg_test_info.na_test_info.self_send) {
         /* Make sure that thread count is at least max_contexts */
@@ -49,6 +49,9 @@ struct hg_test_handle_info {
 /* Public Macros */
 /*****************/
 
+/* Time in ms that hg_test_rpc_sleep holds its handle before responding */
+#define HG_TEST_RPC_SLEEP_TIME (100)
+
 /*********************/
 /* Public Prototypes */
 /*********************/
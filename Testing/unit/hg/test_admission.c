@@ -0,0 +1,244 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_unit.h"
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Wait timeout in ms */
+#define HG_TEST_WAIT_TIMEOUT (HG_TEST_TIMEOUT * 1000)
+
+/* Number of attempts / delay in ms before the target admits requests again */
+#define HG_TEST_ADMIT_RETRY_MAX  (100)
+#define HG_TEST_ADMIT_RETRY_TIME (10)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+struct forward_admission_cb_args {
+    hg_return_t *rets;       /* Return values */
+    hg_thread_mutex_t mutex; /* Protects completion */
+    int32_t expected_count;  /* Expected count */
+    int32_t complete_count;  /* Completed count */
+    hg_request_t *request;   /* Request */
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static hg_return_t
+hg_test_admission_multi(hg_handle_t *handles, size_t handle_max,
+    hg_addr_t addr, hg_id_t rpc_id, hg_request_t *request,
+    size_t *busy_count_p);
+
+static hg_return_t
+hg_test_admission_multi_cb(const struct hg_cb_info *callback_info);
+
+static hg_return_t
+hg_test_admission_null(hg_handle_t handle, hg_addr_t addr, hg_id_t rpc_id,
+    hg_request_t *request);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+extern hg_id_t hg_test_rpc_null_id_g;
+extern hg_id_t hg_test_rpc_sleep_id_g;
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_admission_multi(hg_handle_t *handles, size_t handle_max,
+    hg_addr_t addr, hg_id_t rpc_id, hg_request_t *request,
+    size_t *busy_count_p)
+{
+    struct forward_admission_cb_args args = {.rets = NULL,
+        .mutex = HG_THREAD_MUTEX_INITIALIZER,
+        .expected_count = (int32_t) handle_max,
+        .complete_count = 0,
+        .request = request};
+    size_t i, busy_count = 0, success_count = 0;
+    unsigned int flag;
+    hg_return_t ret;
+    int rc;
+
+    hg_request_reset(request);
+
+    args.rets = (hg_return_t *) calloc(handle_max, sizeof(hg_return_t));
+    HG_TEST_CHECK_ERROR(args.rets == NULL, error, ret, HG_NOMEM,
+        "Could not allocate array of return values");
+
+    /* Keep all requests in process on the target at once */
+    HG_TEST_LOG_DEBUG("Forwarding %zu requests...", handle_max);
+    for (i = 0; i < handle_max; i++) {
+        ret = HG_Reset(handles[i], addr, rpc_id);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Reset() failed (%s)", HG_Error_to_string(ret));
+
+        ret = HG_Forward(handles[i], hg_test_admission_multi_cb, &args, NULL);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    rc = hg_request_wait(request, HG_TEST_WAIT_TIMEOUT, &flag);
+    HG_TEST_CHECK_ERROR(rc != HG_UTIL_SUCCESS, error, ret, HG_PROTOCOL_ERROR,
+        "hg_request_wait() failed");
+    HG_TEST_CHECK_ERROR(
+        !flag, error, ret, HG_TIMEOUT, "hg_request_wait() timed out");
+
+    /* Requests are either processed or rejected */
+    for (i = 0; i < handle_max; i++) {
+        if (args.rets[i] == HG_BUSY)
+            busy_count++;
+        else {
+            ret = args.rets[i];
+            HG_TEST_CHECK_HG_ERROR(error, ret, "Error in HG callback (%s)",
+                HG_Error_to_string(ret));
+            success_count++;
+        }
+    }
+    HG_TEST_LOG_DEBUG(
+        "%zu requests processed, %zu rejected", success_count, busy_count);
+    HG_TEST_CHECK_ERROR(success_count == 0, error, ret, HG_FAULT,
+        "No request was processed");
+
+    free(args.rets);
+    *busy_count_p = busy_count;
+
+    return HG_SUCCESS;
+
+error:
+    free(args.rets);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_admission_multi_cb(const struct hg_cb_info *callback_info)
+{
+    struct forward_admission_cb_args *args =
+        (struct forward_admission_cb_args *) callback_info->arg;
+    int32_t complete_count;
+
+    hg_thread_mutex_lock(&args->mutex);
+    args->rets[args->complete_count] = callback_info->ret;
+    complete_count = ++args->complete_count;
+    hg_thread_mutex_unlock(&args->mutex);
+    if (complete_count == args->expected_count)
+        hg_request_complete(args->request);
+
+    return HG_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_admission_null(
+    hg_handle_t handle, hg_addr_t addr, hg_id_t rpc_id, hg_request_t *request)
+{
+    struct forward_admission_cb_args args = {.rets = NULL,
+        .mutex = HG_THREAD_MUTEX_INITIALIZER,
+        .expected_count = 1,
+        .complete_count = 0,
+        .request = request};
+    hg_return_t rpc_ret = HG_BUSY;
+    unsigned int i;
+    hg_return_t ret;
+
+    args.rets = &rpc_ret;
+
+    /* Rejected requests may still be released on the target */
+    for (i = 0; i < HG_TEST_ADMIT_RETRY_MAX && rpc_ret == HG_BUSY; i++) {
+        unsigned int flag;
+        int rc;
+
+        if (i > 0)
+            hg_time_sleep(hg_time_from_ms(HG_TEST_ADMIT_RETRY_TIME));
+
+        hg_request_reset(request);
+        args.complete_count = 0;
+
+        ret = HG_Reset(handle, addr, rpc_id);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Reset() failed (%s)", HG_Error_to_string(ret));
+
+        ret = HG_Forward(handle, hg_test_admission_multi_cb, &args, NULL);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+
+        rc = hg_request_wait(request, HG_TEST_WAIT_TIMEOUT, &flag);
+        HG_TEST_CHECK_ERROR(rc != HG_UTIL_SUCCESS, error, ret,
+            HG_PROTOCOL_ERROR, "hg_request_wait() failed");
+        HG_TEST_CHECK_ERROR(
+            !flag, error, ret, HG_TIMEOUT, "hg_request_wait() timed out");
+    }
+
+    ret = rpc_ret;
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "Error in HG callback (%s)", HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    struct hg_unit_info info;
+    size_t busy_count = 0;
+    hg_return_t hg_ret;
+
+    /* Initialize the interface */
+    hg_ret = hg_unit_init(argc, argv, false, &info);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_unit_init() failed (%s)",
+        HG_Error_to_string(hg_ret));
+
+    /* RPC test with more requests in flight than the target admits */
+    HG_TEST("multi RPCs with request_max");
+    HG_Test_log_disable(); // Rejected requests produce errors
+    hg_ret = hg_test_admission_multi(info.handles, info.handle_max,
+        info.target_addr, hg_test_rpc_sleep_id_g, info.request, &busy_count);
+    HG_Test_log_enable();
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+        "hg_test_admission_multi() failed (%s)", HG_Error_to_string(hg_ret));
+    /* Targets that post fewer handles than request_max may either queue
+     * requests (single-recv) or reject them (multi-recv) */
+    if (info.hg_test_info.request_max > 0 &&
+        info.handle_max > info.hg_test_info.request_max &&
+        (info.hg_test_info.request_post_init == 0 ||
+            info.hg_test_info.request_post_init >
+                info.hg_test_info.request_max))
+        HG_TEST_CHECK_ERROR_NORET(busy_count == 0, error,
+            "No request was rejected (%zu in flight, request_max is %u)",
+            info.handle_max, info.hg_test_info.request_max);
+    HG_PASSED();
+
+    /* Target must admit requests again once rejected ones are released */
+    HG_TEST("RPC after rejected requests");
+    HG_Test_log_disable(); // Rejected requests produce errors
+    hg_ret = hg_test_admission_null(info.handles[0], info.target_addr,
+        hg_test_rpc_null_id_g, info.request);
+    HG_Test_log_enable();
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+        "hg_test_admission_null() failed (%s)", HG_Error_to_string(hg_ret));
+    HG_PASSED();
+
+    hg_unit_cleanup(&info);
+
+    return EXIT_SUCCESS;
+
+error:
+    hg_unit_cleanup(&info);
+
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,281 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_unit.h"
+
+#include "mercury_engine.h"
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Wait timeout in ms */
+#define HG_TEST_WAIT_TIMEOUT (HG_TEST_TIMEOUT * 1000)
+
+/* Delay in ms between checks of completed callbacks */
+#define HG_TEST_ENGINE_POLL_TIME (1)
+
+/* Number of engine workers */
+#define HG_TEST_ENGINE_WORKER_COUNT (2)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+struct forward_engine_cb_args {
+    hg_atomic_int32_t complete_count; /* Completed count */
+    hg_atomic_int32_t error_count;    /* Failed count */
+    hg_atomic_int32_t blocked;        /* A callback is blocked */
+    int32_t expected_count;           /* Expected count */
+    bool block;                       /* Block first callback */
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static hg_return_t
+hg_test_engine_forward(hg_handle_t *handles, size_t handle_max,
+    hg_addr_t addr, hg_id_t rpc_id, struct forward_engine_cb_args *args);
+
+static hg_return_t
+hg_test_engine_forward_cb(const struct hg_cb_info *callback_info);
+
+static bool
+hg_test_engine_wait(hg_atomic_int32_t *count, int32_t expected_count);
+
+static hg_return_t
+hg_test_engine_multi(struct hg_unit_info *info, bool block);
+
+static hg_return_t
+hg_test_engine_shutdown(struct hg_unit_info *info);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+extern hg_id_t hg_test_rpc_null_id_g;
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_engine_forward(hg_handle_t *handles, size_t handle_max,
+    hg_addr_t addr, hg_id_t rpc_id, struct forward_engine_cb_args *args)
+{
+    size_t i;
+    hg_return_t ret;
+
+    hg_atomic_init32(&args->complete_count, 0);
+    hg_atomic_init32(&args->error_count, 0);
+    hg_atomic_init32(&args->blocked, 0);
+    args->expected_count = (int32_t) handle_max;
+
+    HG_TEST_LOG_DEBUG("Forwarding %zu requests...", handle_max);
+    for (i = 0; i < handle_max; i++) {
+        ret = HG_Reset(handles[i], addr, rpc_id);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Reset() failed (%s)", HG_Error_to_string(ret));
+
+        ret = HG_Forward(handles[i], hg_test_engine_forward_cb, args, NULL);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_engine_forward_cb(const struct hg_cb_info *callback_info)
+{
+    struct forward_engine_cb_args *args =
+        (struct forward_engine_cb_args *) callback_info->arg;
+
+    if (callback_info->ret != HG_SUCCESS)
+        hg_atomic_incr32(&args->error_count);
+
+    /* Block the worker that executes this callback until all other callbacks
+     * have been executed, entries queued on that worker must be stolen */
+    if (args->block && hg_atomic_cas32(&args->blocked, 0, 1)) {
+        if (!hg_test_engine_wait(
+                &args->complete_count, args->expected_count - 1)) {
+            HG_TEST_LOG_ERROR("Callbacks queued behind blocked worker were "
+                              "not executed (%d/%d)",
+                hg_atomic_get32(&args->complete_count),
+                args->expected_count - 1);
+            hg_atomic_incr32(&args->error_count);
+        }
+    }
+
+    hg_atomic_incr32(&args->complete_count);
+
+    return HG_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static bool
+hg_test_engine_wait(hg_atomic_int32_t *count, int32_t expected_count)
+{
+    hg_time_t deadline, now = hg_time_from_ms(0);
+
+    hg_time_get_current_ms(&deadline);
+    deadline = hg_time_add(deadline, hg_time_from_ms(HG_TEST_WAIT_TIMEOUT));
+
+    while (hg_atomic_get32(count) < expected_count &&
+           hg_time_less(now, deadline)) {
+        hg_time_sleep(hg_time_from_ms(HG_TEST_ENGINE_POLL_TIME));
+        hg_time_get_current_ms(&now);
+    }
+
+    return hg_atomic_get32(count) >= expected_count;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_engine_multi(struct hg_unit_info *info, bool block)
+{
+    struct hg_engine_info engine_info = HG_ENGINE_INFO_INITIALIZER;
+    struct forward_engine_cb_args args = {.block = block};
+    hg_engine_t *engine = NULL;
+    hg_return_t ret, cleanup_ret;
+
+    engine_info.worker_count = HG_TEST_ENGINE_WORKER_COUNT;
+    ret = HG_Engine_create(&info->context, 1, &engine_info, &engine);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Engine_create() failed (%s)", HG_Error_to_string(ret));
+
+    ret = hg_test_engine_forward(info->handles, info->handle_max,
+        info->target_addr, hg_test_rpc_null_id_g, &args);
+    HG_TEST_CHECK_HG_ERROR(destroy, ret,
+        "hg_test_engine_forward() failed (%s)", HG_Error_to_string(ret));
+
+    HG_TEST_CHECK_ERROR(
+        !hg_test_engine_wait(&args.complete_count, args.expected_count),
+        destroy, ret, HG_TIMEOUT, "Callbacks were not executed (%d/%d)",
+        hg_atomic_get32(&args.complete_count), args.expected_count);
+    HG_TEST_CHECK_ERROR(hg_atomic_get32(&args.error_count) > 0, destroy, ret,
+        HG_FAULT, "Error in %d callbacks", hg_atomic_get32(&args.error_count));
+
+    ret = HG_Engine_destroy(engine);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Engine_destroy() failed (%s)", HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+destroy:
+    cleanup_ret = HG_Engine_destroy(engine);
+    HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+        "HG_Engine_destroy() failed (%s)", HG_Error_to_string(cleanup_ret));
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_engine_shutdown(struct hg_unit_info *info)
+{
+    struct hg_engine_info engine_info = HG_ENGINE_INFO_INITIALIZER;
+    struct forward_engine_cb_args args = {.block = false};
+    hg_engine_t *engine = NULL;
+    hg_time_t deadline, now = hg_time_from_ms(0);
+    unsigned int actual_count;
+    hg_return_t ret;
+
+    engine_info.worker_count = HG_TEST_ENGINE_WORKER_COUNT;
+    ret = HG_Engine_create(&info->context, 1, &engine_info, &engine);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Engine_create() failed (%s)", HG_Error_to_string(ret));
+
+    /* Destroy engine while operations are still in flight */
+    ret = hg_test_engine_forward(info->handles, info->handle_max,
+        info->target_addr, hg_test_rpc_null_id_g, &args);
+
+    HG_TEST_CHECK_ERROR_DONE(HG_Engine_destroy(engine) != HG_SUCCESS,
+        "HG_Engine_destroy() failed");
+    HG_TEST_CHECK_HG_ERROR(error, ret, "hg_test_engine_forward() failed (%s)",
+        HG_Error_to_string(ret));
+    HG_TEST_LOG_DEBUG("%d callbacks executed by engine",
+        hg_atomic_get32(&args.complete_count));
+
+    /* Remaining operations are left to the caller */
+    hg_time_get_current_ms(&deadline);
+    deadline = hg_time_add(deadline, hg_time_from_ms(HG_TEST_WAIT_TIMEOUT));
+    while (hg_atomic_get32(&args.complete_count) < args.expected_count &&
+           hg_time_less(now, deadline)) {
+        ret = HG_Progress(info->context, HG_TEST_ENGINE_POLL_TIME);
+        if (ret != HG_TIMEOUT)
+            HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Progress() failed (%s)",
+                HG_Error_to_string(ret));
+
+        do {
+            actual_count = 0;
+            ret = HG_Trigger(info->context, 0, 1, &actual_count);
+        } while (ret == HG_SUCCESS && actual_count > 0);
+        hg_time_get_current_ms(&now);
+    }
+
+    /* Every callback must have been executed exactly once */
+    ret = HG_Trigger(info->context, 0, 1, &actual_count);
+    HG_TEST_CHECK_ERROR(ret != HG_TIMEOUT, error, ret, HG_FAULT,
+        "Callbacks left after shutdown");
+    HG_TEST_CHECK_ERROR(
+        hg_atomic_get32(&args.complete_count) != args.expected_count, error,
+        ret, HG_FAULT, "Callbacks were not executed once (%d/%d)",
+        hg_atomic_get32(&args.complete_count), args.expected_count);
+    HG_TEST_CHECK_ERROR(hg_atomic_get32(&args.error_count) > 0, error, ret,
+        HG_FAULT, "Error in %d callbacks", hg_atomic_get32(&args.error_count));
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    struct hg_unit_info info;
+    hg_return_t hg_ret;
+
+    /* Initialize the interface */
+    hg_ret = hg_unit_init(argc, argv, false, &info);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_unit_init() failed (%s)",
+        HG_Error_to_string(hg_ret));
+
+    /* RPC test with callbacks executed by engine workers */
+    HG_TEST("engine multi RPCs");
+    hg_ret = hg_test_engine_multi(&info, false);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_test_engine_multi() failed (%s)",
+        HG_Error_to_string(hg_ret));
+    HG_PASSED();
+
+    /* RPC test with one worker blocked, its entries must be stolen */
+    HG_TEST("engine work stealing");
+    hg_ret = hg_test_engine_multi(&info, true);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_test_engine_multi() failed (%s)",
+        HG_Error_to_string(hg_ret));
+    HG_PASSED();
+
+    /* RPC test with engine destroyed while RPCs are in flight */
+    HG_TEST("engine shutdown");
+    hg_ret = hg_test_engine_shutdown(&info);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+        "hg_test_engine_shutdown() failed (%s)", HG_Error_to_string(hg_ret));
+    HG_PASSED();
+
+    hg_unit_cleanup(&info);
+
+    return EXIT_SUCCESS;
+
+error:
+    hg_unit_cleanup(&info);
+
+    return EXIT_FAILURE;
+}
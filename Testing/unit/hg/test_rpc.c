@@ -17,6 +17,25 @@
 /* Wait timeout in ms */
 #define HG_TEST_WAIT_TIMEOUT (HG_TEST_TIMEOUT * 1000)
 
+/* Timeout in ms of timed RPCs that are expected to expire */
+#define HG_TEST_RPC_EXPIRE_TIMEOUT (HG_TEST_RPC_SLEEP_TIME / 10)
+
+/* Timeout in ms of timed RPCs that are expected to complete */
+#define HG_TEST_RPC_TIMED_TIMEOUT (200)
+
+/* Name that no plugin can look up */
+#define HG_TEST_RPC_INVALID_NAME "invalid://name"
+
+/* Number of RPC IDs registered after the RPC map was frozen (many more than
+ * the frozen IDs so that the map is rebuilt several times) */
+#define HG_TEST_RPC_MAP_COUNT (256)
+
+/* First RPC ID registered after the RPC map was frozen */
+#define HG_TEST_RPC_MAP_ID (UINT64_C(1) << 48)
+
+/* RPC ID forwarded to self without procs */
+#define HG_TEST_RPC_SELF_ID (UINT64_C(1) << 49)
+
 /************************************/
 /* Local Type and Struct Definition */
 /************************************/
@@ -50,6 +69,33 @@ struct hg_test_multi_thread {
     hg_return_t ret;
 };
 
+struct hg_test_rpc_target {
+    hg_class_t *hg_class;   /* Target class */
+    hg_context_t *context;  /* Target context */
+    hg_thread_t thread;     /* Progress thread */
+    hg_atomic_int32_t done; /* Stop progress */
+};
+
+struct hg_test_rpc_map_reader {
+    hg_class_t *hg_class;   /* Class of RPC map */
+    hg_thread_t thread;     /* Lookup thread */
+    hg_atomic_int32_t done; /* Stop lookups */
+    hg_return_t ret;        /* Lookup result */
+};
+
+/* Input and output struct of self RPCs */
+struct hg_test_rpc_self_struct {
+    char *buf;       /* Memory owned by the origin */
+    uint64_t cookie; /* Value */
+};
+
+struct hg_test_rpc_self_args {
+    hg_request_t *request; /* Request */
+    char *buf;             /* Expected buffer */
+    uint64_t cookie;       /* Expected cookie */
+    hg_return_t ret;       /* Forward result */
+};
+
 /********************/
 /* Local Prototypes */
 /********************/
@@ -79,16 +125,70 @@ hg_test_rpc_output_overflow_cb(const struct hg_cb_info *callback_info);
 
 static hg_return_t
 hg_test_rpc_cancel(hg_handle_t handle, hg_addr_t addr, hg_id_t rpc_id,
-    hg_cb_t callback, hg_request_t *request);
+    hg_cb_t callback, hg_request_t *request, bool cancel_all);
+
+static hg_return_t
+hg_test_rpc_timed(hg_handle_t handle, hg_addr_t addr, hg_id_t rpc_id,
+    unsigned int timeout, hg_return_t expected_ret, hg_request_t *request);
+
+static hg_return_t
+hg_test_rpc_lookup_batch(struct hg_unit_info *info);
+
+static hg_return_t
+hg_test_rpc_map(hg_class_t *hg_class);
+
+static hg_return_t
+hg_test_rpc_map_check(hg_class_t *hg_class, const int *values,
+    unsigned int first, unsigned int step, bool registered);
+
+static void
+hg_test_rpc_map_free(void *arg);
+
+static HG_THREAD_RETURN_TYPE
+hg_test_rpc_map_lookup(void *arg);
+
+static hg_return_t
+hg_test_rpc_self_bypass(struct hg_unit_info *info);
+
+static hg_return_t
+hg_test_rpc_self_proc(hg_proc_t proc, void *data);
+
+static hg_return_t
+hg_test_rpc_self_cb(hg_handle_t handle);
+
+static hg_return_t
+hg_test_rpc_self_output_cb(const struct hg_cb_info *callback_info);
 
 static hg_return_t
 hg_test_rpc_multi(hg_handle_t *handles, size_t handle_max, hg_addr_t addr,
     hg_uint8_t target_id, hg_id_t rpc_id, hg_cb_t callback,
     hg_request_t *request);
 
+static hg_return_t
+hg_test_rpc_multi_addrs(hg_handle_t *handles, size_t handle_max,
+    const hg_addr_t *addrs, size_t addr_count, hg_uint8_t target_id,
+    hg_id_t rpc_id, hg_cb_t callback, hg_request_t *request);
+
 static hg_return_t
 hg_test_rpc_multi_cb(const struct hg_cb_info *callback_info);
 
+static hg_return_t
+hg_test_rpc_target_init(const struct hg_unit_info *info,
+    struct hg_test_rpc_target *target, hg_addr_t *addr_p);
+
+static void
+hg_test_rpc_target_finalize(struct hg_test_rpc_target *target);
+
+static HG_THREAD_RETURN_TYPE
+hg_test_rpc_target_progress(void *arg);
+
+static hg_return_t
+hg_test_rpc_target_open_cb(hg_handle_t handle);
+
+static hg_return_t
+hg_test_rpc_events(hg_context_t *context, hg_handle_t *handles,
+    size_t handle_max, hg_addr_t addr, hg_id_t rpc_id);
+
 static hg_return_t
 hg_test_rpc_launch_threads(struct hg_unit_info *info, hg_thread_func_t func);
 
@@ -123,6 +223,7 @@ extern hg_id_t hg_test_rpc_open_id_g;
 extern hg_id_t hg_test_rpc_open_id_no_resp_g;
 extern hg_id_t hg_test_overflow_id_g;
 extern hg_id_t hg_test_cancel_rpc_id_g;
+extern hg_id_t hg_test_rpc_sleep_id_g;
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
@@ -362,7 +463,7 @@ done:
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_test_rpc_cancel(hg_handle_t handle, hg_addr_t addr, hg_id_t rpc_id,
-    hg_cb_t callback, hg_request_t *request)
+    hg_cb_t callback, hg_request_t *request, bool cancel_all)
 {
     hg_return_t ret;
     struct forward_cb_args forward_cb_args = {
@@ -384,9 +485,15 @@ hg_test_rpc_cancel(hg_handle_t handle, hg_addr_t addr, hg_id_t rpc_id,
 
     /* Cancel request before making progress, this ensures that the RPC has
      * not completed yet. */
-    ret = HG_Cancel(handle);
-    HG_TEST_CHECK_HG_ERROR(
-        error, ret, "HG_Cancel() failed (%s)", HG_Error_to_string(ret));
+    if (cancel_all) {
+        ret = HG_Addr_cancel_all(HG_Get_info(handle)->context, addr);
+        HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Addr_cancel_all() failed (%s)",
+            HG_Error_to_string(ret));
+    } else {
+        ret = HG_Cancel(handle);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Cancel() failed (%s)", HG_Error_to_string(ret));
+    }
 
     rc = hg_request_wait(request, HG_TEST_WAIT_TIMEOUT, &flag);
     HG_TEST_CHECK_ERROR(rc != HG_UTIL_SUCCESS, error, ret, HG_PROTOCOL_ERROR,
@@ -404,11 +511,469 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_timed(hg_handle_t handle, hg_addr_t addr, hg_id_t rpc_id,
+    unsigned int timeout, hg_return_t expected_ret, hg_request_t *request)
+{
+    hg_return_t ret;
+    struct forward_cb_args forward_cb_args = {
+        .request = request, .ret = HG_SUCCESS};
+    unsigned int flag;
+    int rc;
+
+    hg_request_reset(request);
+
+    ret = HG_Reset(handle, addr, rpc_id);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Reset() failed (%s)", HG_Error_to_string(ret));
+
+    HG_TEST_LOG_DEBUG("Forwarding RPC, op id: %" PRIu64 ", timeout: %u ms...",
+        rpc_id, timeout);
+
+    ret = HG_Forward_timed(
+        handle, hg_test_rpc_no_output_cb, &forward_cb_args, NULL, timeout);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Forward_timed() failed (%s)", HG_Error_to_string(ret));
+
+    rc = hg_request_wait(request, HG_TEST_WAIT_TIMEOUT, &flag);
+    HG_TEST_CHECK_ERROR(rc != HG_UTIL_SUCCESS, error, ret, HG_PROTOCOL_ERROR,
+        "hg_request_wait() failed");
+
+    HG_TEST_CHECK_ERROR(
+        !flag, error, ret, HG_TIMEOUT, "hg_request_wait() timed out");
+    ret = forward_cb_args.ret;
+    HG_TEST_CHECK_ERROR_NORET(ret != expected_ret, error,
+        "Error in HG callback (%s, expected %s)", HG_Error_to_string(ret),
+        HG_Error_to_string(expected_ret));
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_lookup_batch(struct hg_unit_info *info)
+{
+    const char *target_name = info->hg_test_info.na_test_info.target_name;
+    const char *names[3] = {target_name, target_name, target_name};
+    hg_addr_t addrs[3] = {HG_ADDR_NULL, HG_ADDR_NULL, HG_ADDR_NULL};
+    hg_addr_t shared_addr = HG_ADDR_NULL;
+    hg_return_t ret;
+    size_t i;
+
+    /* Duplicate names share the same address */
+    ret = HG_Addr_lookup_batch(info->hg_class, names, 2, addrs);
+    HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Addr_lookup_batch() failed (%s)",
+        HG_Error_to_string(ret));
+    HG_TEST_CHECK_ERROR(addrs[0] == HG_ADDR_NULL || addrs[0] != addrs[1],
+        error, ret, HG_FAULT, "Duplicate names do not share their address");
+    shared_addr = addrs[0];
+    addrs[0] = HG_ADDR_NULL;
+
+    ret = HG_Addr_free(info->hg_class, addrs[1]);
+    addrs[1] = HG_ADDR_NULL;
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Addr_free() failed (%s)", HG_Error_to_string(ret));
+
+    /* One invalid name fails the whole batch, including names that were
+     * already resolved or repeat within the batch */
+    names[1] = HG_TEST_RPC_INVALID_NAME;
+    for (i = 0; i < 3; i++)
+        addrs[i] = (hg_addr_t) info; /* Must be reset */
+    HG_Test_log_disable(); // Expected to produce errors
+    ret = HG_Addr_lookup_batch(info->hg_class, names, 3, addrs);
+    HG_Test_log_enable();
+    HG_TEST_CHECK_ERROR(ret == HG_SUCCESS, error, ret, HG_FAULT,
+        "HG_Addr_lookup_batch() with invalid name succeeded");
+    for (i = 0; i < 3; i++)
+        HG_TEST_CHECK_ERROR(addrs[i] != HG_ADDR_NULL, error, ret, HG_FAULT,
+            "Address %zu returned by failed batch", i);
+
+    /* Failed batch must not have released references of earlier batches */
+    ret = hg_test_rpc_no_input(info->handles[0], shared_addr,
+        hg_test_rpc_null_id_g, hg_test_rpc_no_output_cb, info->request);
+    HG_TEST_CHECK_HG_ERROR(error, ret, "hg_test_rpc_no_input() failed (%s)",
+        HG_Error_to_string(ret));
+
+    /* Later batches still share the address */
+    ret = HG_Addr_lookup_batch(info->hg_class, names, 1, addrs);
+    HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Addr_lookup_batch() failed (%s)",
+        HG_Error_to_string(ret));
+    HG_TEST_CHECK_ERROR(addrs[0] != shared_addr, error, ret, HG_FAULT,
+        "Batches do not share their address");
+
+    ret = HG_Addr_free(info->hg_class, addrs[0]);
+    addrs[0] = HG_ADDR_NULL;
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Addr_free() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Addr_free(info->hg_class, shared_addr);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Addr_free() failed (%s)", HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    for (i = 0; i < 3; i++)
+        if (addrs[i] != HG_ADDR_NULL && addrs[i] != (hg_addr_t) info)
+            (void) HG_Addr_free(info->hg_class, addrs[i]);
+    if (shared_addr != HG_ADDR_NULL)
+        (void) HG_Addr_free(info->hg_class, shared_addr);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_map(hg_class_t *hg_class)
+{
+    struct hg_test_rpc_map_reader reader = {
+        .hg_class = hg_class, .ret = HG_SUCCESS};
+    int values[HG_TEST_RPC_MAP_COUNT];
+    bool reader_started = false;
+    hg_return_t ret;
+    unsigned int i;
+    uint8_t flag;
+    int rc;
+
+    /* Lookups of IDs registered before freeze */
+    ret = HG_Registered(hg_class, hg_test_rpc_open_id_g, &flag);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Registered() failed (%s)", HG_Error_to_string(ret));
+    HG_TEST_CHECK_ERROR(
+        !flag, error, ret, HG_FAULT, "Frozen RPC ID is not registered");
+    ret = HG_Registered(hg_class, HG_TEST_RPC_MAP_ID, &flag);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Registered() failed (%s)", HG_Error_to_string(ret));
+    HG_TEST_CHECK_ERROR(
+        flag, error, ret, HG_FAULT, "Unknown RPC ID is registered");
+
+    /* Keep looking up frozen IDs while the map is updated */
+    hg_atomic_init32(&reader.done, 0);
+    rc = hg_thread_create(&reader.thread, hg_test_rpc_map_lookup, &reader);
+    HG_TEST_CHECK_ERROR(rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+        "hg_thread_create() failed");
+    reader_started = true;
+
+    /* Register after freeze */
+    for (i = 0; i < HG_TEST_RPC_MAP_COUNT; i++) {
+        values[i] = 0;
+        ret = HG_Register(hg_class, HG_TEST_RPC_MAP_ID + i, NULL, NULL, NULL);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Register() failed (%s)", HG_Error_to_string(ret));
+        ret = HG_Register_data(
+            hg_class, HG_TEST_RPC_MAP_ID + i, &values[i], hg_test_rpc_map_free);
+        HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Register_data() failed (%s)",
+            HG_Error_to_string(ret));
+    }
+    ret = hg_test_rpc_map_check(hg_class, values, 0, 1, true);
+    HG_TEST_CHECK_HG_ERROR(error, ret, "hg_test_rpc_map_check() failed (%s)",
+        HG_Error_to_string(ret));
+
+    ret = HG_Registered_freeze(hg_class);
+    HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Registered_freeze() failed (%s)",
+        HG_Error_to_string(ret));
+    ret = hg_test_rpc_map_check(hg_class, values, 0, 1, true);
+    HG_TEST_CHECK_HG_ERROR(error, ret, "hg_test_rpc_map_check() failed (%s)",
+        HG_Error_to_string(ret));
+
+    /* Deregister every other ID after freeze, remaining IDs must still be
+     * found past the slots of removed IDs */
+    for (i = 0; i < HG_TEST_RPC_MAP_COUNT; i += 2) {
+        ret = HG_Deregister(hg_class, HG_TEST_RPC_MAP_ID + i);
+        HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Deregister() failed (%s)",
+            HG_Error_to_string(ret));
+        HG_TEST_CHECK_ERROR(values[i] != 1, error, ret, HG_FAULT,
+            "Data of RPC ID %u was not freed on deregister", i);
+    }
+    ret = hg_test_rpc_map_check(hg_class, values, 0, 2, false);
+    HG_TEST_CHECK_HG_ERROR(error, ret, "hg_test_rpc_map_check() failed (%s)",
+        HG_Error_to_string(ret));
+    ret = hg_test_rpc_map_check(hg_class, values, 1, 2, true);
+    HG_TEST_CHECK_HG_ERROR(error, ret, "hg_test_rpc_map_check() failed (%s)",
+        HG_Error_to_string(ret));
+
+    /* Deregister remaining IDs from a frozen map */
+    ret = HG_Registered_freeze(hg_class);
+    HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Registered_freeze() failed (%s)",
+        HG_Error_to_string(ret));
+    for (i = 1; i < HG_TEST_RPC_MAP_COUNT; i += 2) {
+        ret = HG_Deregister(hg_class, HG_TEST_RPC_MAP_ID + i);
+        HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Deregister() failed (%s)",
+            HG_Error_to_string(ret));
+    }
+    ret = hg_test_rpc_map_check(hg_class, values, 0, 1, false);
+    HG_TEST_CHECK_HG_ERROR(error, ret, "hg_test_rpc_map_check() failed (%s)",
+        HG_Error_to_string(ret));
+    for (i = 0; i < HG_TEST_RPC_MAP_COUNT; i++)
+        HG_TEST_CHECK_ERROR(values[i] != 1, error, ret, HG_FAULT,
+            "Data of RPC ID %u freed %d times", i, values[i]);
+
+    /* Leave test IDs frozen for the following tests */
+    ret = HG_Registered_freeze(hg_class);
+    HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Registered_freeze() failed (%s)",
+        HG_Error_to_string(ret));
+
+    hg_atomic_set32(&reader.done, 1);
+    hg_thread_join(reader.thread);
+    ret = reader.ret;
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_rpc_map_lookup() failed (%s)",
+        HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    if (reader_started) {
+        hg_atomic_set32(&reader.done, 1);
+        hg_thread_join(reader.thread);
+    }
+    HG_Test_log_disable(); // Some IDs are no longer registered
+    for (i = 0; i < HG_TEST_RPC_MAP_COUNT; i++)
+        (void) HG_Deregister(hg_class, HG_TEST_RPC_MAP_ID + i);
+    HG_Test_log_enable();
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_map_check(hg_class_t *hg_class, const int *values,
+    unsigned int first, unsigned int step, bool registered)
+{
+    hg_return_t ret;
+    unsigned int i;
+
+    for (i = first; i < HG_TEST_RPC_MAP_COUNT; i += step) {
+        uint8_t flag;
+
+        ret = HG_Registered(hg_class, HG_TEST_RPC_MAP_ID + i, &flag);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Registered() failed (%s)", HG_Error_to_string(ret));
+        HG_TEST_CHECK_ERROR(flag != registered, error, ret, HG_FAULT,
+            "RPC ID %u registered flag is %u, expected %d", i, flag,
+            registered);
+        if (registered)
+            HG_TEST_CHECK_ERROR(
+                HG_Registered_data(hg_class, HG_TEST_RPC_MAP_ID + i) !=
+                    &values[i],
+                error, ret, HG_FAULT, "Data of RPC ID %u does not match", i);
+    }
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_test_rpc_map_free(void *arg)
+{
+    (*(int *) arg)++;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+hg_test_rpc_map_lookup(void *arg)
+{
+    struct hg_test_rpc_map_reader *reader =
+        (struct hg_test_rpc_map_reader *) arg;
+    hg_thread_ret_t tret = (hg_thread_ret_t) 0;
+
+    while (!hg_atomic_get32(&reader->done)) {
+        uint8_t flag;
+
+        reader->ret =
+            HG_Registered(reader->hg_class, hg_test_rpc_open_id_g, &flag);
+        HG_TEST_CHECK_HG_ERROR(done, reader->ret, "HG_Registered() failed (%s)",
+            HG_Error_to_string(reader->ret));
+        HG_TEST_CHECK_ERROR(!flag, done, reader->ret, HG_FAULT,
+            "Frozen RPC ID is not registered");
+    }
+
+done:
+    return tret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_self_bypass(struct hg_unit_info *info)
+{
+    struct hg_test_rpc_self_args args = {
+        .request = info->request, .ret = HG_SUCCESS};
+    struct hg_test_rpc_self_struct in_struct;
+    hg_addr_t self_addr = HG_ADDR_NULL;
+    hg_handle_t handle = HG_HANDLE_NULL;
+    char *buf = NULL;
+    hg_return_t ret, cleanup_ret;
+    unsigned int flag;
+    int rc;
+
+    /* Procs fail so that any use of them is reported */
+    ret = HG_Register(info->hg_class, HG_TEST_RPC_SELF_ID,
+        hg_test_rpc_self_proc, hg_test_rpc_self_proc, hg_test_rpc_self_cb);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Register() failed (%s)", HG_Error_to_string(ret));
+    ret = HG_Registered_set_self_bypass(info->hg_class, HG_TEST_RPC_SELF_ID,
+        sizeof(struct hg_test_rpc_self_struct),
+        sizeof(struct hg_test_rpc_self_struct));
+    HG_TEST_CHECK_HG_ERROR(done, ret,
+        "HG_Registered_set_self_bypass() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Addr_self(info->hg_class, &self_addr);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Addr_self() failed (%s)", HG_Error_to_string(ret));
+    ret = HG_Create(info->context, self_addr, HG_TEST_RPC_SELF_ID, &handle);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+
+    buf = strdup(HG_TEST_RPC_PATH);
+    HG_TEST_CHECK_ERROR(
+        buf == NULL, done, ret, HG_NOMEM, "Could not allocate buffer");
+    in_struct.buf = buf;
+    in_struct.cookie = 100;
+    args.buf = buf;
+    args.cookie = in_struct.cookie;
+
+    hg_request_reset(info->request);
+
+    ret = HG_Forward(handle, hg_test_rpc_self_output_cb, &args, &in_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+
+    /* Input struct was copied and may be released */
+    memset(&in_struct, 0, sizeof(in_struct));
+
+    rc = hg_request_wait(info->request, HG_TEST_WAIT_TIMEOUT, &flag);
+    HG_TEST_CHECK_ERROR(rc != HG_UTIL_SUCCESS, done, ret, HG_PROTOCOL_ERROR,
+        "hg_request_wait() failed");
+    HG_TEST_CHECK_ERROR(
+        !flag, done, ret, HG_TIMEOUT, "hg_request_wait() timed out");
+    ret = args.ret;
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "Error in HG callback (%s)", HG_Error_to_string(ret));
+
+    /* Freeing input and output must have left caller memory untouched */
+    HG_TEST_CHECK_ERROR(strcmp(buf, HG_TEST_RPC_PATH) != 0, done, ret,
+        HG_FAULT, "Caller buffer was modified");
+
+done:
+    if (handle != HG_HANDLE_NULL) {
+        cleanup_ret = HG_Destroy(handle);
+        HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+            "HG_Destroy() failed (%s)", HG_Error_to_string(cleanup_ret));
+    }
+    if (self_addr != HG_ADDR_NULL) {
+        cleanup_ret = HG_Addr_free(info->hg_class, self_addr);
+        HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+            "HG_Addr_free() failed (%s)", HG_Error_to_string(cleanup_ret));
+    }
+    free(buf);
+    HG_Test_log_disable(); // ID may not be registered
+    (void) HG_Deregister(info->hg_class, HG_TEST_RPC_SELF_ID);
+    HG_Test_log_enable();
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_self_proc(hg_proc_t proc, void *data)
+{
+    (void) proc;
+    (void) data;
+
+    HG_TEST_LOG_ERROR("Proc called on bypassed RPC");
+
+    return HG_PROTOCOL_ERROR;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_self_cb(hg_handle_t handle)
+{
+    struct hg_test_rpc_self_struct in_struct, out_struct;
+    hg_return_t ret;
+
+    ret = HG_Get_input(handle, &in_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Get_input() failed (%s)", HG_Error_to_string(ret));
+
+    /* Members still point to origin memory */
+    out_struct.buf = in_struct.buf;
+    out_struct.cookie = in_struct.cookie + 1;
+
+    ret = HG_Free_input(handle, &in_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Free_input() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Respond(handle, NULL, NULL, &out_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Respond() failed (%s)", HG_Error_to_string(ret));
+
+done:
+    (void) HG_Destroy(handle);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_self_output_cb(const struct hg_cb_info *callback_info)
+{
+    hg_handle_t handle = callback_info->info.forward.handle;
+    struct hg_test_rpc_self_args *args =
+        (struct hg_test_rpc_self_args *) callback_info->arg;
+    struct hg_test_rpc_self_struct out_struct;
+    hg_return_t ret = callback_info->ret;
+
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Error in HG callback (%s)",
+        HG_Error_to_string(callback_info->ret));
+
+    ret = HG_Get_output(handle, &out_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Get_output() failed (%s)", HG_Error_to_string(ret));
+
+    HG_TEST_CHECK_ERROR(out_struct.buf != args->buf, free, ret, HG_FAULT,
+        "Buffer pointer did not round-trip");
+    HG_TEST_CHECK_ERROR(out_struct.cookie != args->cookie + 1, free, ret,
+        HG_FAULT, "Cookie did not round-trip (%" PRIu64 ")", out_struct.cookie);
+
+free:
+    if (ret != HG_SUCCESS)
+        (void) HG_Free_output(handle, &out_struct);
+    else {
+        ret = HG_Free_output(handle, &out_struct);
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Free_output() failed (%s)", HG_Error_to_string(ret));
+    }
+
+done:
+    args->ret = ret;
+
+    hg_request_complete(args->request);
+
+    return HG_SUCCESS;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_test_rpc_multi(hg_handle_t *handles, size_t handle_max, hg_addr_t addr,
     hg_uint8_t target_id, hg_id_t rpc_id, hg_cb_t callback,
     hg_request_t *request)
+{
+    return hg_test_rpc_multi_addrs(handles, handle_max, &addr, 1, target_id,
+        rpc_id, callback, request);
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_multi_addrs(hg_handle_t *handles, size_t handle_max,
+    const hg_addr_t *addrs, size_t addr_count, hg_uint8_t target_id,
+    hg_id_t rpc_id, hg_cb_t callback, hg_request_t *request)
 {
     hg_return_t ret;
     rpc_handle_t rpc_open_handle = {.cookie = 100};
@@ -440,7 +1005,7 @@ hg_test_rpc_multi(hg_handle_t *handles, size_t handle_max, hg_addr_t addr,
      */
     HG_TEST_LOG_DEBUG("Creating %zu requests...", handle_max);
     for (i = 0; i < handle_max; i++) {
-        ret = HG_Reset(handles[i], addr, rpc_id);
+        ret = HG_Reset(handles[i], addrs[i % addr_count], rpc_id);
         HG_TEST_CHECK_HG_ERROR(
             error, ret, "HG_Reset() failed (%s)", HG_Error_to_string(ret));
 
@@ -527,12 +1092,253 @@ done:
     args->rets[args->complete_count] = ret;
     complete_count = ++args->complete_count;
     hg_thread_mutex_unlock(&args->mutex);
-    if (complete_count == args->expected_count)
+    if (complete_count == args->expected_count && args->request != NULL)
         hg_request_complete(args->request);
 
     return HG_SUCCESS;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_target_init(const struct hg_unit_info *info,
+    struct hg_test_rpc_target *target, hg_addr_t *addr_p)
+{
+    struct hg_init_info hg_init_info = HG_INIT_INFO_INITIALIZER;
+    const struct na_test_info *na_test_info = &info->hg_test_info.na_test_info;
+    char info_string[64], addr_string[256];
+    hg_size_t addr_string_size = sizeof(addr_string);
+    hg_addr_t self_addr = HG_ADDR_NULL;
+    hg_id_t rpc_id;
+    hg_return_t ret;
+    int rc;
+
+    target->hg_class = NULL;
+    target->context = NULL;
+    hg_atomic_init32(&target->done, 0);
+
+    if (na_test_info->comm != NULL)
+        snprintf(info_string, sizeof(info_string), "%s+%s", na_test_info->comm,
+            na_test_info->protocol);
+    else
+        snprintf(
+            info_string, sizeof(info_string), "%s", na_test_info->protocol);
+
+    /* Second target sends its responses in batches */
+    hg_init_info.coalesce_responses = true;
+    target->hg_class = HG_Init_opt2(info_string, true,
+        HG_VERSION(HG_VERSION_MAJOR, HG_VERSION_MINOR), &hg_init_info);
+    HG_TEST_CHECK_ERROR(target->hg_class == NULL, error, ret, HG_FAULT,
+        "HG_Init_opt2() failed");
+
+    target->context = HG_Context_create(target->hg_class);
+    HG_TEST_CHECK_ERROR(target->context == NULL, error, ret, HG_FAULT,
+        "HG_Context_create() failed");
+
+    /* Same name, and therefore same ID, as the RPC forwarded to the server */
+    rpc_id = MERCURY_REGISTER(target->hg_class, "hg_test_rpc_open",
+        rpc_open_in_t, rpc_open_out_t, hg_test_rpc_target_open_cb);
+    HG_TEST_CHECK_ERROR(rpc_id != hg_test_rpc_open_id_g, error, ret,
+        HG_FAULT, "MERCURY_REGISTER() failed");
+
+    ret = HG_Addr_self(target->hg_class, &self_addr);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Addr_self() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Addr_to_string(
+        target->hg_class, addr_string, &addr_string_size, self_addr);
+    HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Addr_to_string() failed (%s)",
+        HG_Error_to_string(ret));
+
+    ret = HG_Addr_free(target->hg_class, self_addr);
+    self_addr = HG_ADDR_NULL;
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Addr_free() failed (%s)", HG_Error_to_string(ret));
+
+    rc = hg_thread_create(
+        &target->thread, hg_test_rpc_target_progress, target);
+    HG_TEST_CHECK_ERROR(rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+        "hg_thread_create() failed");
+
+    ret = HG_Addr_lookup2(info->hg_class, addr_string, addr_p);
+    HG_TEST_CHECK_HG_ERROR(error_thread, ret, "HG_Addr_lookup2() failed (%s)",
+        HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error_thread:
+    hg_test_rpc_target_finalize(target);
+
+    return ret;
+
+error:
+    if (self_addr != HG_ADDR_NULL)
+        (void) HG_Addr_free(target->hg_class, self_addr);
+    if (target->context != NULL)
+        (void) HG_Context_destroy(target->context);
+    if (target->hg_class != NULL)
+        (void) HG_Finalize(target->hg_class);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_test_rpc_target_finalize(struct hg_test_rpc_target *target)
+{
+    hg_return_t ret;
+
+    hg_atomic_set32(&target->done, 1);
+    hg_thread_join(target->thread);
+
+    ret = HG_Context_destroy(target->context);
+    HG_TEST_CHECK_ERROR_DONE(ret != HG_SUCCESS,
+        "HG_Context_destroy() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Finalize(target->hg_class);
+    HG_TEST_CHECK_ERROR_DONE(ret != HG_SUCCESS, "HG_Finalize() failed (%s)",
+        HG_Error_to_string(ret));
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+hg_test_rpc_target_progress(void *arg)
+{
+    struct hg_test_rpc_target *target = (struct hg_test_rpc_target *) arg;
+    hg_thread_ret_t tret = (hg_thread_ret_t) 0;
+    hg_return_t ret;
+
+    while (!hg_atomic_get32(&target->done)) {
+        unsigned int actual_count = 0;
+
+        do {
+            ret = HG_Trigger(target->context, 0, 1, &actual_count);
+        } while ((ret == HG_SUCCESS) && actual_count);
+        HG_TEST_CHECK_ERROR_NORET(ret != HG_SUCCESS && ret != HG_TIMEOUT, done,
+            "HG_Trigger() failed (%s)", HG_Error_to_string(ret));
+
+        ret = HG_Progress(target->context, 100);
+        HG_TEST_CHECK_ERROR_NORET(ret != HG_SUCCESS && ret != HG_TIMEOUT, done,
+            "HG_Progress() failed (%s)", HG_Error_to_string(ret));
+    }
+
+done:
+    return tret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_target_open_cb(hg_handle_t handle)
+{
+    rpc_open_in_t in_struct;
+    rpc_open_out_t out_struct;
+    hg_return_t ret;
+
+    ret = HG_Get_input(handle, &in_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Get_input() failed (%s)", HG_Error_to_string(ret));
+
+    out_struct.event_id = (hg_int32_t) in_struct.handle.cookie;
+    out_struct.ret = 0;
+
+    ret = HG_Free_input(handle, &in_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Free_input() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Respond(handle, NULL, NULL, &out_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Respond() failed (%s)", HG_Error_to_string(ret));
+
+done:
+    (void) HG_Destroy(handle);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_events(hg_context_t *context, hg_handle_t *handles,
+    size_t handle_max, hg_addr_t addr, hg_id_t rpc_id)
+{
+    hg_return_t ret;
+    rpc_handle_t rpc_open_handle = {.cookie = 100};
+    struct forward_multi_cb_args forward_multi_cb_args = {
+        .rpc_handle = &rpc_open_handle,
+        .request = NULL,
+        .rets = NULL,
+        .mutex = HG_THREAD_MUTEX_INITIALIZER,
+        .complete_count = 0,
+        .expected_count = (int32_t) handle_max};
+    rpc_open_in_t in_struct = {
+        .handle = rpc_open_handle, .path = HG_TEST_RPC_PATH};
+    struct hg_cb_event events[4];
+    hg_time_t deadline, now;
+    size_t i;
+
+    HG_TEST_CHECK_ERROR(handle_max == 0, error, ret, HG_INVALID_PARAM,
+        "Handle max cannot be 0");
+
+    forward_multi_cb_args.rets =
+        (hg_return_t *) calloc(handle_max, sizeof(hg_return_t));
+    HG_TEST_CHECK_ERROR(forward_multi_cb_args.rets == NULL, error, ret,
+        HG_NOMEM, "Could not allocate array of return values");
+
+    for (i = 0; i < handle_max; i++) {
+        ret = HG_Reset(handles[i], addr, rpc_id);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Reset() failed (%s)", HG_Error_to_string(ret));
+
+        ret = HG_Forward(handles[i], hg_test_rpc_multi_cb,
+            &forward_multi_cb_args, &in_struct);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    /* Retrieve events in batches smaller than the number of RPCs and
+     * dispatch them manually */
+    hg_time_get_current_ms(&now);
+    deadline = hg_time_add(now, hg_time_from_ms(HG_TEST_WAIT_TIMEOUT));
+    while (forward_multi_cb_args.complete_count <
+           forward_multi_cb_args.expected_count) {
+        unsigned int actual_count = 0, j;
+
+        HG_TEST_CHECK_ERROR(!hg_time_less(now, deadline), error, ret,
+            HG_TIMEOUT, "Timed out waiting for events");
+
+        ret = HG_Progress(context, 100);
+        HG_TEST_CHECK_ERROR_NORET(ret != HG_SUCCESS && ret != HG_TIMEOUT,
+            error, "HG_Progress() failed (%s)", HG_Error_to_string(ret));
+
+        ret = HG_Trigger_events(context, 0, 4, events, &actual_count);
+        HG_TEST_CHECK_ERROR_NORET(ret != HG_SUCCESS && ret != HG_TIMEOUT,
+            error, "HG_Trigger_events() failed (%s)", HG_Error_to_string(ret));
+
+        for (j = 0; j < actual_count; j++) {
+            HG_TEST_CHECK_ERROR(events[j].info.type != HG_CB_FORWARD ||
+                                    events[j].callback != hg_test_rpc_multi_cb,
+                error, ret, HG_FAULT, "Unexpected event");
+            (void) events[j].callback(&events[j].info);
+        }
+        HG_Release_events(events, actual_count);
+
+        hg_time_get_current_ms(&now);
+    }
+
+    for (i = 0; i < handle_max; i++) {
+        ret = forward_multi_cb_args.rets[i];
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "Error in HG callback (%s)", HG_Error_to_string(ret));
+    }
+
+    free(forward_multi_cb_args.rets);
+
+    return HG_SUCCESS;
+
+error:
+    free(forward_multi_cb_args.rets);
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_test_rpc_launch_threads(struct hg_unit_info *info, hg_thread_func_t func)
@@ -893,6 +1699,20 @@ main(int argc, char *argv[])
         HG_Error_to_string(hg_ret), HG_Error_to_string(HG_NOENTRY));
     HG_PASSED();
 
+    /* RPC map test */
+    HG_TEST("RPC map updates after freeze");
+    hg_ret = hg_test_rpc_map(info.hg_class);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_test_rpc_map() failed (%s)",
+        HG_Error_to_string(hg_ret));
+    HG_PASSED();
+
+    /* Self RPC test without procs */
+    HG_TEST("RPC to self with bypassed procs");
+    hg_ret = hg_test_rpc_self_bypass(&info);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+        "hg_test_rpc_self_bypass() failed (%s)", HG_Error_to_string(hg_ret));
+    HG_PASSED();
+
     /* NULL RPC test */
     HG_TEST("NULL RPC");
     hg_ret = hg_test_rpc_no_input(info.handles[0], info.target_addr,
@@ -950,6 +1770,13 @@ main(int argc, char *argv[])
             info.hg_test_info.na_test_info.target_name, &info.target_addr);
         HG_TEST_CHECK_HG_ERROR(error, hg_ret, "HG_Addr_lookup2() failed (%s)",
             HG_Error_to_string(hg_ret));
+
+        HG_TEST("RPC with batch lookup");
+        hg_ret = hg_test_rpc_lookup_batch(&info);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+            "hg_test_rpc_lookup_batch() failed (%s)",
+            HG_Error_to_string(hg_ret));
+        HG_PASSED();
     }
 
     /* RPC test with no response */
@@ -996,10 +1823,69 @@ main(int argc, char *argv[])
     if (!info.hg_test_info.na_test_info.self_send) {
         HG_TEST("RPC cancelation");
         hg_ret = hg_test_rpc_cancel(info.handles[0], info.target_addr,
-            hg_test_cancel_rpc_id_g, hg_test_rpc_no_output_cb, info.request);
+            hg_test_cancel_rpc_id_g, hg_test_rpc_no_output_cb, info.request,
+            false);
         HG_TEST_CHECK_HG_ERROR(error, hg_ret,
             "hg_test_rpc_cancel() failed (%s)", HG_Error_to_string(hg_ret));
         HG_PASSED();
+
+        HG_TEST("RPC cancelation by address");
+        hg_ret = hg_test_rpc_cancel(info.handles[0], info.target_addr,
+            hg_test_cancel_rpc_id_g, hg_test_rpc_no_output_cb, info.request,
+            true);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+            "hg_test_rpc_cancel() failed (%s)", HG_Error_to_string(hg_ret));
+        HG_PASSED();
+    }
+
+    /* Timed RPC tests (calls forwarded to self ignore timeout) */
+    if (!info.hg_test_info.na_test_info.self_send) {
+        struct hg_stats stats;
+        uint64_t timeout_count;
+        unsigned int flag;
+
+        HG_TEST("timed RPC expiry");
+        hg_ret = HG_Create(info.context, info.target_addr,
+            hg_test_rpc_sleep_id_g, &handle);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret, "HG_Create() failed (%s)",
+            HG_Error_to_string(hg_ret));
+        hg_ret = hg_test_rpc_timed(handle, info.target_addr,
+            hg_test_rpc_sleep_id_g, HG_TEST_RPC_EXPIRE_TIMEOUT, HG_TIMEOUT,
+            info.request);
+        HG_Destroy(handle);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+            "hg_test_rpc_timed() failed (%s)", HG_Error_to_string(hg_ret));
+
+        hg_ret = HG_Context_get_stats(info.context, &stats);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+            "HG_Context_get_stats() failed (%s)", HG_Error_to_string(hg_ret));
+        HG_TEST_CHECK_ERROR_NORET(stats.rpc_req_timeout == 0, error,
+            "Expired RPC was not counted");
+        timeout_count = stats.rpc_req_timeout;
+
+        /* Let the target respond to the expired RPC */
+        hg_request_reset(info.request);
+        hg_request_wait(info.request, 2 * HG_TEST_RPC_SLEEP_TIME, &flag);
+        HG_PASSED();
+
+        HG_TEST("timed RPC completed in time");
+        hg_ret = hg_test_rpc_timed(info.handles[0], info.target_addr,
+            hg_test_rpc_null_id_g, HG_TEST_RPC_TIMED_TIMEOUT, HG_SUCCESS,
+            info.request);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+            "hg_test_rpc_timed() failed (%s)", HG_Error_to_string(hg_ret));
+
+        /* Make progress past the deadline, timer must have been disarmed */
+        hg_request_reset(info.request);
+        hg_request_wait(info.request, 2 * HG_TEST_RPC_TIMED_TIMEOUT, &flag);
+
+        hg_ret = HG_Context_get_stats(info.context, &stats);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+            "HG_Context_get_stats() failed (%s)", HG_Error_to_string(hg_ret));
+        HG_TEST_CHECK_ERROR_NORET(stats.rpc_req_timeout != timeout_count,
+            error, "Completed RPC expired (%" PRIu64 " timeouts)",
+            stats.rpc_req_timeout - timeout_count);
+        HG_PASSED();
     }
 
     /* RPC test with multiple handles in flight */
@@ -1010,6 +1896,14 @@ main(int argc, char *argv[])
         HG_Error_to_string(hg_ret));
     HG_PASSED();
 
+    /* RPC test with completions retrieved as events */
+    HG_TEST("multi RPCs with trigger events");
+    hg_ret = hg_test_rpc_events(info.context, info.handles, info.handle_max,
+        info.target_addr, hg_test_rpc_open_id_g);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_test_rpc_events() failed (%s)",
+        HG_Error_to_string(hg_ret));
+    HG_PASSED();
+
     /* RPC test with multiple handles in flight from multiple threads */
     HG_TEST("concurrent multi RPCs");
     hg_ret = hg_test_rpc_launch_threads(&info, hg_test_rpc_multi_thread);
@@ -1032,6 +1926,36 @@ main(int argc, char *argv[])
         "hg_test_rpc_launch_threads() failed (%s)", HG_Error_to_string(hg_ret));
     HG_PASSED();
 
+    /* RPC test with coalesced responses from two targets, the second target
+     * runs in this process */
+    if (info.hg_test_info.coalesce &&
+        !info.hg_test_info.na_test_info.self_send &&
+        strcmp(HG_Class_get_name(info.hg_class), "mpi") &&
+        strcmp(HG_Class_get_name(info.hg_class), "bmi")) {
+        struct hg_test_rpc_target target;
+        hg_addr_t addrs[2] = {info.target_addr, HG_ADDR_NULL};
+        size_t i;
+
+        HG_TEST("multi RPCs to two targets");
+        hg_ret = hg_test_rpc_target_init(&info, &target, &addrs[1]);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+            "hg_test_rpc_target_init() failed (%s)",
+            HG_Error_to_string(hg_ret));
+
+        hg_ret = hg_test_rpc_multi_addrs(info.handles, info.handle_max, addrs,
+            2, 0, hg_test_rpc_open_id_g, hg_test_rpc_multi_cb, info.request);
+
+        /* Handles must no longer refer to the second target */
+        for (i = 1; i < info.handle_max; i += 2)
+            (void) HG_Reset(info.handles[i], info.target_addr, 0);
+        (void) HG_Addr_free(info.hg_class, addrs[1]);
+        hg_test_rpc_target_finalize(&target);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+            "hg_test_rpc_multi_addrs() failed (%s)",
+            HG_Error_to_string(hg_ret));
+        HG_PASSED();
+    }
+
     /* RPC test with multiple handles to multiple target contexts */
     if (info.hg_test_info.na_test_info.max_contexts) {
         hg_uint8_t i,
@@ -6,7 +6,9 @@
  */
 
 #include "mercury_atomic_queue.h"
+#include "mercury_thread.h"
 
+#include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -14,8 +16,248 @@ struct my_entry {
     int value;
 };
 
+struct thread_args {
+    struct hg_atomic_seg_queue *queue;
+    struct my_entry *entries;
+    hg_atomic_int32_t n_popped;
+    hg_atomic_int64_t sum;
+};
+
 #define HG_TEST_QUEUE_SIZE 16
 
+#define HG_TEST_SEG_QUEUE_ENTRIES (HG_TEST_QUEUE_SIZE * 64)
+
+#define HG_TEST_BATCH_SIZE 7
+
+#ifndef HG_TEST_NUM_THREADS_DEFAULT
+#    define HG_TEST_NUM_THREADS_DEFAULT (8)
+#endif
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+thread_cb_push(void *arg)
+{
+    struct thread_args *thread_args = (struct thread_args *) arg;
+    hg_thread_ret_t thread_ret = (hg_thread_ret_t) 0;
+    int i;
+
+    for (i = 0; i < HG_TEST_SEG_QUEUE_ENTRIES; i++)
+        if (hg_atomic_seg_queue_push(thread_args->queue,
+                &thread_args->entries[i]) != HG_UTIL_SUCCESS)
+            thread_ret = (hg_thread_ret_t) 1;
+
+    hg_thread_exit(thread_ret);
+    return thread_ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+thread_cb_pop(void *arg)
+{
+    struct thread_args *thread_args = (struct thread_args *) arg;
+    hg_thread_ret_t thread_ret = (hg_thread_ret_t) 0;
+
+    while (hg_atomic_get32(&thread_args->n_popped) <
+           HG_TEST_SEG_QUEUE_ENTRIES * HG_TEST_NUM_THREADS_DEFAULT) {
+        struct my_entry *my_entry_ptr =
+            hg_atomic_seg_queue_pop(thread_args->queue);
+        int64_t sum;
+
+        if (my_entry_ptr == NULL)
+            continue;
+        hg_atomic_incr32(&thread_args->n_popped);
+
+        do {
+            sum = hg_atomic_get64(&thread_args->sum);
+        } while (!hg_atomic_cas64(
+            &thread_args->sum, sum, sum + my_entry_ptr->value));
+    }
+
+    hg_thread_exit(thread_ret);
+    return thread_ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+test_seg_queue(void)
+{
+    struct thread_args thread_args;
+    hg_thread_t threads[HG_TEST_NUM_THREADS_DEFAULT * 2];
+    struct my_entry *entries = NULL;
+    int64_t sum = 0;
+    int ret = EXIT_SUCCESS, i;
+
+    entries = (struct my_entry *) malloc(
+        HG_TEST_SEG_QUEUE_ENTRIES * sizeof(struct my_entry));
+    if (entries == NULL) {
+        fprintf(stderr, "Error: could not allocate entries\n");
+        return EXIT_FAILURE;
+    }
+    for (i = 0; i < HG_TEST_SEG_QUEUE_ENTRIES; i++) {
+        entries[i].value = i;
+        sum += i;
+    }
+
+    thread_args.queue = hg_atomic_seg_queue_alloc(HG_TEST_QUEUE_SIZE);
+    if (!thread_args.queue) {
+        fprintf(stderr, "Error: could not allocate queue\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+    thread_args.entries = entries;
+    hg_atomic_init32(&thread_args.n_popped, 0);
+    hg_atomic_init64(&thread_args.sum, 0);
+
+    /* Queue must grow past its initial size and preserve order */
+    for (i = 0; i < HG_TEST_SEG_QUEUE_ENTRIES; i++) {
+        if (hg_atomic_seg_queue_push(thread_args.queue, &entries[i]) !=
+            HG_UTIL_SUCCESS) {
+            fprintf(stderr, "Error: could not push entry %d\n", i);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+    if (hg_atomic_seg_queue_count(thread_args.queue) !=
+        HG_TEST_SEG_QUEUE_ENTRIES) {
+        fprintf(stderr, "Error: expected %d entries, got %u\n",
+            HG_TEST_SEG_QUEUE_ENTRIES,
+            hg_atomic_seg_queue_count(thread_args.queue));
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+    for (i = 0; i < HG_TEST_SEG_QUEUE_ENTRIES; i++) {
+        struct my_entry *my_entry_ptr =
+            hg_atomic_seg_queue_pop(thread_args.queue);
+        if (my_entry_ptr == NULL || my_entry_ptr->value != i) {
+            fprintf(stderr, "Error: expected value %d\n", i);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+    if (!hg_atomic_seg_queue_is_empty(thread_args.queue)) {
+        fprintf(stderr, "Error: queue should be empty\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    /* Batch pops must cross segments and preserve order */
+    for (i = 0; i < HG_TEST_SEG_QUEUE_ENTRIES; i++) {
+        if (hg_atomic_seg_queue_push(thread_args.queue, &entries[i]) !=
+            HG_UTIL_SUCCESS) {
+            fprintf(stderr, "Error: could not push entry %d\n", i);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+    for (i = 0; i < HG_TEST_SEG_QUEUE_ENTRIES;) {
+        void *batch[HG_TEST_BATCH_SIZE];
+        unsigned int count, j;
+
+        count = hg_atomic_seg_queue_pop_n(
+            thread_args.queue, batch, HG_TEST_BATCH_SIZE);
+        if (count == 0) {
+            fprintf(stderr, "Error: queue should not be empty\n");
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+        for (j = 0; j < count; j++, i++) {
+            if (((struct my_entry *) batch[j])->value != i) {
+                fprintf(stderr, "Error: expected value %d\n", i);
+                ret = EXIT_FAILURE;
+                goto done;
+            }
+        }
+    }
+    if (!hg_atomic_seg_queue_is_empty(thread_args.queue)) {
+        fprintf(stderr, "Error: queue should be empty\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    /* Concurrent producers and consumers */
+    for (i = 0; i < HG_TEST_NUM_THREADS_DEFAULT; i++) {
+        hg_thread_create(&threads[i], thread_cb_push, &thread_args);
+        hg_thread_create(&threads[i + HG_TEST_NUM_THREADS_DEFAULT],
+            thread_cb_pop, &thread_args);
+    }
+    for (i = 0; i < HG_TEST_NUM_THREADS_DEFAULT * 2; i++)
+        hg_thread_join(threads[i]);
+
+    if (hg_atomic_get64(&thread_args.sum) !=
+        sum * HG_TEST_NUM_THREADS_DEFAULT) {
+        fprintf(stderr, "Error: sums do not match, expected %" PRId64
+                        ", got %" PRId64 "\n",
+            sum * HG_TEST_NUM_THREADS_DEFAULT,
+            hg_atomic_get64(&thread_args.sum));
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+    if (!hg_atomic_seg_queue_is_empty(thread_args.queue)) {
+        fprintf(stderr, "Error: queue should be empty\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+done:
+    hg_atomic_seg_queue_free(thread_args.queue);
+    free(entries);
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+test_seg_queue_recycle(void)
+{
+    struct hg_atomic_seg_queue *queue;
+    struct hg_atomic_queue_seg *seg;
+    struct my_entry entry = {.value = 0};
+    int64_t head;
+    int ret = EXIT_SUCCESS, i;
+
+    queue = hg_atomic_seg_queue_alloc(HG_TEST_QUEUE_SIZE);
+    if (!queue) {
+        fprintf(stderr, "Error: could not allocate queue\n");
+        return EXIT_FAILURE;
+    }
+
+    /* Fill first segment so that a second one gets linked */
+    for (i = 0; i < HG_TEST_QUEUE_SIZE; i++)
+        (void) hg_atomic_seg_queue_push(queue, &entry);
+
+    /* Consumer that read head before the first segment was recycled */
+    head = hg_atomic_get64(&queue->head);
+    seg = queue->segs[HG_ATOMIC_SEG_QUEUE_IDX(head)];
+
+    /* Drain queue and fill second segment so that first one is reused */
+    while (hg_atomic_seg_queue_pop(queue) != NULL)
+        continue;
+    for (i = 0; i < HG_TEST_QUEUE_SIZE * 2; i++)
+        (void) hg_atomic_seg_queue_push(queue, &entry);
+    if (queue->segs[HG_ATOMIC_SEG_QUEUE_IDX(hg_atomic_get64(&queue->tail))] !=
+        seg) {
+        fprintf(stderr, "Error: first segment was not reused\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    /* Stale consumer must not pop newer entries out of order */
+    if (hg_atomic_queue_seg_pop(seg, HG_ATOMIC_SEG_QUEUE_GEN(head)) != NULL) {
+        fprintf(stderr, "Error: popped entry from recycled segment\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+    if (hg_atomic_seg_queue_count(queue) != HG_TEST_QUEUE_SIZE * 2) {
+        fprintf(stderr, "Error: expected %d entries, got %u\n",
+            HG_TEST_QUEUE_SIZE * 2, hg_atomic_seg_queue_count(queue));
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+done:
+    hg_atomic_seg_queue_free(queue);
+    return ret;
+}
+
 int
 main(void)
 {
@@ -24,7 +266,7 @@ main(void)
     int value1 = 10, value2 = 20;
     struct my_entry my_entry1 = {.value = value1};
     struct my_entry my_entry2 = {.value = value2};
-    struct my_entry *my_entry_ptr;
+    struct my_entry *my_entry_ptr, *batch[2];
 
     hg_atomic_queue = hg_atomic_queue_alloc(HG_TEST_QUEUE_SIZE);
     if (!hg_atomic_queue) {
@@ -62,6 +304,35 @@ main(void)
         goto done;
     }
 
+    /* Batch pop returns at most max_count entries in order */
+    hg_atomic_queue_push(hg_atomic_queue, &my_entry1);
+    hg_atomic_queue_push(hg_atomic_queue, &my_entry2);
+    hg_atomic_queue_push(hg_atomic_queue, &my_entry1);
+
+    if (hg_atomic_queue_pop_mc_n(hg_atomic_queue, (void **) batch, 2) != 2 ||
+        batch[0]->value != value1 || batch[1]->value != value2) {
+        fprintf(stderr, "Error: could not pop batch of 2 entries\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+    if (hg_atomic_queue_pop_mc_n(hg_atomic_queue, (void **) batch, 2) != 1 ||
+        batch[0]->value != value1) {
+        fprintf(stderr, "Error: could not pop remaining entry\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+    if (hg_atomic_queue_pop_mc_n(hg_atomic_queue, (void **) batch, 2) != 0) {
+        fprintf(stderr, "Error: queue should be empty\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    ret = test_seg_queue();
+    if (ret != EXIT_SUCCESS)
+        goto done;
+
+    ret = test_seg_queue_recycle();
+
 done:
     hg_atomic_queue_free(hg_atomic_queue);
     return ret;
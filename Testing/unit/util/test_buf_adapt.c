@@ -0,0 +1,160 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_buf_adapt.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BUF_SIZE    4096
+#define SIZE_FACTOR 4
+#define COUNT       4
+#define COUNT_MIN   2
+#define COUNT_MAX   8
+
+/* Consume all buffers of a round, return flags of the last one. Buffer
+ * times are accounted for through a repost that must not free buffers. */
+static unsigned int
+test_round(struct hg_buf_adapt *hg_buf_adapt, int32_t posted_count,
+    int64_t copy_count, double fill_time, double hold_time)
+{
+    unsigned int count = hg_buf_adapt->count, i;
+
+    for (i = 0; i < count - 1; i++) {
+        if (hg_buf_adapt_consumed(hg_buf_adapt, posted_count, copy_count) != 0)
+            return 0;
+    }
+    if (hg_buf_adapt->park == 0 &&
+        hg_buf_adapt_repost(hg_buf_adapt, fill_time, hold_time))
+        return 0;
+
+    return hg_buf_adapt_consumed(hg_buf_adapt, posted_count, copy_count);
+}
+
+int
+main(int argc, char *argv[])
+{
+    struct hg_buf_adapt hg_buf_adapt;
+    unsigned int flags, i;
+    int ret = EXIT_SUCCESS;
+
+    (void) argc;
+    (void) argv;
+
+    hg_buf_adapt_init(
+        &hg_buf_adapt, BUF_SIZE, SIZE_FACTOR, COUNT, COUNT_MIN, COUNT_MAX, 0);
+
+    /* Saturated rounds add buffers up to COUNT_MAX */
+    for (i = COUNT; i < COUNT_MAX; i++) {
+        flags = test_round(&hg_buf_adapt, 0, 0, 1., 2.);
+        if (flags != (HG_BUF_ADAPT_ROUND | HG_BUF_ADAPT_ADD)) {
+            fprintf(stderr, "Error: buffer not added (flags %u)\n", flags);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+        hg_buf_adapt_added(&hg_buf_adapt);
+        if (hg_buf_adapt.copy_threshold != (int32_t) (i - COUNT + 1)) {
+            fprintf(stderr, "Error: copy threshold not raised\n");
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+
+    /* Then enlarge buffers up to SIZE_FACTOR */
+    for (i = 0; i < 4; i++) {
+        flags = test_round(&hg_buf_adapt, 0, 0, 1., 2.);
+        if (hg_buf_adapt.buf_size < BUF_SIZE * SIZE_FACTOR &&
+            flags != (HG_BUF_ADAPT_ROUND | HG_BUF_ADAPT_RESIZE)) {
+            fprintf(stderr, "Error: buffers not enlarged (flags %u)\n", flags);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+    if (flags != HG_BUF_ADAPT_ROUND || hg_buf_adapt.count != COUNT_MAX ||
+        hg_buf_adapt.buf_size != BUF_SIZE * SIZE_FACTOR) {
+        fprintf(stderr, "Error: buffers not capped (count %u, size %zu)\n",
+            hg_buf_adapt.count, hg_buf_adapt.buf_size);
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    /* Copy threshold must stay below number of buffers */
+    if (hg_buf_adapt.copy_threshold != COUNT_MAX - 1) {
+        fprintf(stderr, "Error: copy threshold is %d, expected %d\n",
+            (int) hg_buf_adapt.copy_threshold, COUNT_MAX - 1);
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    /* Idle rounds with copies lower copy threshold first */
+    for (i = 0; i < COUNT_MAX - 1; i++) {
+        flags = test_round(&hg_buf_adapt, 2, (int64_t) i + 1, 1., 0.);
+        if (flags != HG_BUF_ADAPT_ROUND ||
+            hg_buf_adapt.copy_threshold != (int32_t) (COUNT_MAX - 2 - i)) {
+            fprintf(stderr, "Error: copy threshold not lowered\n");
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+
+    /* Then shrink buffers back to their initial size */
+    for (i = 0; i < 2; i++) {
+        flags = test_round(&hg_buf_adapt, 2, COUNT_MAX, 1., 0.);
+        if (flags != (HG_BUF_ADAPT_ROUND | HG_BUF_ADAPT_RESIZE)) {
+            fprintf(stderr, "Error: buffers not shrunk (flags %u)\n", flags);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+    if (hg_buf_adapt.buf_size != BUF_SIZE) {
+        fprintf(stderr, "Error: buffer size is %zu, expected %d\n",
+            hg_buf_adapt.buf_size, BUF_SIZE);
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    /* Then park buffers, saturation cancels parking */
+    flags = test_round(&hg_buf_adapt, 2, COUNT_MAX, 1., 0.);
+    if (flags != HG_BUF_ADAPT_ROUND || hg_buf_adapt.park != 1) {
+        fprintf(stderr, "Error: buffer not parked\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+    flags = test_round(&hg_buf_adapt, 0, COUNT_MAX, 1., 0.);
+    if (flags != HG_BUF_ADAPT_ROUND || hg_buf_adapt.park != 0) {
+        fprintf(stderr, "Error: parking not cancelled\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+    for (i = 0; i < COUNT_MAX; i++)
+        (void) test_round(&hg_buf_adapt, 2, COUNT_MAX, 1., 0.);
+    if (hg_buf_adapt.park != COUNT_MAX - COUNT_MIN) {
+        fprintf(stderr, "Error: %u buffers parked, expected %d\n",
+            hg_buf_adapt.park, COUNT_MAX - COUNT_MIN);
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    /* Parked buffers are freed on repost down to COUNT_MIN */
+    for (i = 0; i < COUNT_MAX - COUNT_MIN; i++) {
+        if (!hg_buf_adapt_repost(&hg_buf_adapt, 1., 0.)) {
+            fprintf(stderr, "Error: parked buffer not freed\n");
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+    if (hg_buf_adapt_repost(&hg_buf_adapt, 1., 0.) ||
+        hg_buf_adapt.count != COUNT_MIN) {
+        fprintf(stderr, "Error: %u buffers remaining, expected %d\n",
+            hg_buf_adapt.count, COUNT_MIN);
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+done:
+    return ret;
+}
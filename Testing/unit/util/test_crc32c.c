@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_crc32c.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HG_TEST_CRC32C_BUF_SIZE (256)
+
+/* Bitwise reference, reflected Castagnoli polynomial */
+static uint32_t
+hg_test_crc32c_ref(uint32_t crc, const unsigned char *buf, size_t size)
+{
+    unsigned int k;
+
+    crc = ~crc;
+    while (size-- > 0) {
+        crc ^= *buf++;
+        for (k = 0; k < 8; k++)
+            crc = (crc >> 1) ^ (0x82F63B78 & (0 - (crc & 1)));
+    }
+
+    return ~crc;
+}
+
+int
+main(int argc, char *argv[])
+{
+    unsigned char buf[HG_TEST_CRC32C_BUF_SIZE];
+    unsigned char zeros[32];
+    size_t offset, size, split;
+    uint32_t crc, ref;
+    int ret = EXIT_SUCCESS;
+
+    (void) argc;
+    (void) argv;
+
+    /* Standard check values */
+    crc = hg_crc32c(0, "123456789", 9);
+    if (crc != 0xE3069283) {
+        fprintf(stderr, "Error: crc32c(\"123456789\") is 0x%08X\n", crc);
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    memset(zeros, 0, sizeof(zeros));
+    crc = hg_crc32c(0, zeros, sizeof(zeros));
+    if (crc != 0x8A9136AA) {
+        fprintf(stderr, "Error: crc32c(32 zero bytes) is 0x%08X\n", crc);
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    if (hg_crc32c(0, NULL, 0) != 0) {
+        fprintf(stderr, "Error: crc32c of empty buffer is not 0\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    for (size = 0; size < sizeof(buf); size++)
+        buf[size] = (unsigned char) (size * 31 + 7);
+
+    /* Unaligned heads and tails must match the byte-wise computation */
+    for (offset = 0; offset < 8; offset++) {
+        for (size = 0; size <= 67; size++) {
+            crc = hg_crc32c(0, buf + offset, size);
+            ref = hg_test_crc32c_ref(0, buf + offset, size);
+            if (crc != ref) {
+                fprintf(stderr,
+                    "Error: crc32c mismatch at offset %zu, size %zu "
+                    "(0x%08X != 0x%08X)\n",
+                    offset, size, crc, ref);
+                ret = EXIT_FAILURE;
+                goto done;
+            }
+        }
+    }
+
+    /* Chained computation must match one-shot computation */
+    ref = hg_crc32c(0, buf, sizeof(buf));
+    for (split = 0; split <= sizeof(buf); split += 13) {
+        crc = hg_crc32c(0, buf, split);
+        crc = hg_crc32c(crc, buf + split, sizeof(buf) - split);
+        if (crc != ref) {
+            fprintf(stderr, "Error: chained crc32c mismatch at split %zu\n",
+                split);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+
+done:
+    return ret;
+}
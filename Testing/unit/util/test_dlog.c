@@ -0,0 +1,239 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_atomic.h"
+#include "mercury_dlog.h"
+#include "mercury_thread.h"
+
+#include <inttypes.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NTHREADS     4
+#define RING_SIZE    100 /* rounded up to 128 */
+#define RING_RECORDS 1000
+
+#define DUMP_BASE "test_dlog"
+#define DUMP_FILE DUMP_BASE ".rec"
+
+/* number of threads done recording, threads exit once all are done */
+static hg_atomic_int32_t done_count_g;
+static int32_t done_wait_g;
+
+static HG_THREAD_RETURN_TYPE
+thread_cb_rec(void *arg)
+{
+    hg_thread_ret_t thread_ret = (hg_thread_ret_t) 0;
+    struct hg_dlog_rec *rec = (struct hg_dlog_rec *) arg;
+    uint64_t i;
+
+    for (i = 0; i < RING_RECORDS; i++)
+        hg_dlog_rec_add(rec, 1, rec, i, i * 2);
+
+    /* keep rings in use so that they are not reused by other threads */
+    hg_atomic_incr32(&done_count_g);
+    while (hg_atomic_get32(&done_count_g) < done_wait_g)
+        hg_thread_yield();
+
+    hg_thread_exit(thread_ret);
+    return thread_ret;
+}
+
+static int
+check_dump(const struct hg_dlog_rec *rec, unsigned int nrings)
+{
+    struct hg_dlog_rec_header hdr;
+    struct hg_dlog_rec_entry *entries = NULL;
+    FILE *fp;
+    unsigned int i;
+    int ret = EXIT_FAILURE;
+
+    fp = fopen(DUMP_FILE, "rb");
+    if (fp == NULL) {
+        fprintf(stderr, "Error: could not open " DUMP_FILE "\n");
+        return EXIT_FAILURE;
+    }
+
+    if (fread(&hdr, sizeof(hdr), 1, fp) != 1 ||
+        strncmp(hdr.magic, HG_DLOG_RECMAGIC "test", HG_DLOG_MAGICLEN) != 0 ||
+        hdr.version != HG_DLOG_REC_VERSION ||
+        hdr.esize != sizeof(struct hg_dlog_rec_entry) || hdr.size != 128 ||
+        hdr.nrings != nrings) {
+        fprintf(stderr, "Error: bad dump header\n");
+        goto done;
+    }
+
+    entries = malloc(sizeof(*entries) * hdr.size);
+    if (entries == NULL)
+        goto done;
+
+    for (i = 0; i < hdr.nrings; i++) {
+        struct hg_dlog_rec_ring_header rhdr;
+        uint64_t head_end, seq;
+
+        if (fread(&rhdr, sizeof(rhdr), 1, fp) != 1 ||
+            fread(entries, sizeof(*entries), hdr.size, fp) != hdr.size ||
+            fread(&head_end, sizeof(head_end), 1, fp) != 1) {
+            fprintf(stderr, "Error: truncated ring %u\n", i);
+            goto done;
+        }
+        if (rhdr.head != RING_RECORDS || head_end != rhdr.head) {
+            fprintf(stderr, "Error: ring %u has head %" PRIu64 "\n", rhdr.id,
+                rhdr.head);
+            goto done;
+        }
+
+        /* oldest records were overwritten, newest ones must be intact */
+        for (seq = rhdr.head - hdr.size; seq < rhdr.head; seq++) {
+            const struct hg_dlog_rec_entry *e =
+                &entries[seq & (hdr.size - 1)];
+            if (e->event != 1 || e->handle != (uint64_t) (uintptr_t) rec ||
+                e->arg[0] != seq || e->arg[1] != seq * 2 || e->time == 0) {
+                fprintf(stderr, "Error: bad record %" PRIu64 " in ring %u\n",
+                    seq, rhdr.id);
+                goto done;
+            }
+        }
+    }
+
+    ret = EXIT_SUCCESS;
+
+done:
+    free(entries);
+    fclose(fp);
+    return ret;
+}
+
+static int
+check_copy(struct hg_dlog_rec *rec, unsigned int nrings)
+{
+    struct hg_dlog_rec_record *records;
+    size_t count, i;
+    uint64_t seq;
+    int ret = EXIT_FAILURE;
+
+    records = malloc(sizeof(*records) * rec->size * nrings);
+    if (records == NULL)
+        return EXIT_FAILURE;
+
+    /* last record of each ring is counted as in progress and discarded */
+    count = hg_dlog_rec_copy(rec, records, (size_t) rec->size * nrings);
+    if (count != (size_t) (rec->size - 1) * nrings) {
+        fprintf(stderr, "Error: copied %zu records\n", count);
+        goto done;
+    }
+    for (i = 0; i < count; i++) {
+        seq = RING_RECORDS - rec->size + 1 + i % (rec->size - 1);
+        if (records[i].ring != i / (rec->size - 1) ||
+            records[i].entry.arg[0] != seq ||
+            records[i].entry.arg[1] != seq * 2) {
+            fprintf(stderr, "Error: bad copied record %zu\n", i);
+            goto done;
+        }
+    }
+
+    /* rings that do not fit are skipped */
+    count = hg_dlog_rec_copy(rec, records, rec->size);
+    if (count != rec->size - 1) {
+        fprintf(stderr, "Error: copied %zu records into one ring\n", count);
+        goto done;
+    }
+
+    ret = EXIT_SUCCESS;
+
+done:
+    free(records);
+    return ret;
+}
+
+int
+main(int argc, char *argv[])
+{
+    hg_thread_t threads[NTHREADS];
+    struct hg_dlog_rec *rec;
+#ifndef _WIN32
+    uint64_t total;
+#endif
+    unsigned int i;
+    int ret = EXIT_SUCCESS;
+
+    (void) argc;
+    (void) argv;
+
+    /* one ring less than threads, last thread's records are dropped */
+    rec = hg_dlog_rec_alloc("test", RING_SIZE, NTHREADS - 1);
+    if (rec == NULL) {
+        fprintf(stderr, "Error: could not allocate recorder\n");
+        return EXIT_FAILURE;
+    }
+
+    hg_atomic_init32(&done_count_g, 0);
+    done_wait_g = NTHREADS;
+    for (i = 0; i < NTHREADS; i++)
+        hg_thread_create(&threads[i], thread_cb_rec, rec);
+    for (i = 0; i < NTHREADS; i++)
+        hg_thread_join(threads[i]);
+
+    if (hg_dlog_rec_dump_file(rec, DUMP_BASE, 0) != HG_UTIL_SUCCESS) {
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+    ret = check_dump(rec, NTHREADS - 1);
+    if (ret != EXIT_SUCCESS)
+        goto done;
+    remove(DUMP_FILE);
+
+    ret = check_copy(rec, NTHREADS - 1);
+    if (ret != EXIT_SUCCESS)
+        goto done;
+
+    /* stopped recorder must not take new records */
+    hg_dlog_rec_setstop(rec, 1);
+    if (hg_dlog_rec_add(rec, 2, NULL, 0, 0) != 0) {
+        fprintf(stderr, "Error: stopped recorder took a record\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+    hg_dlog_rec_setstop(rec, 0);
+
+#ifndef _WIN32
+    /* user signal dumps and returns */
+    if (hg_dlog_rec_set_sigdump(rec, DUMP_BASE, 0, SIGUSR2) !=
+        HG_UTIL_SUCCESS) {
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+    raise(SIGUSR2);
+    ret = check_dump(rec, NTHREADS - 1);
+    if (ret != EXIT_SUCCESS)
+        goto done;
+    remove(DUMP_FILE);
+#endif
+
+#ifndef _WIN32
+    /* rings of exited threads are reused by new threads */
+    hg_atomic_init32(&done_count_g, 0);
+    done_wait_g = 1;
+    hg_thread_create(&threads[0], thread_cb_rec, rec);
+    hg_thread_join(threads[0]);
+    for (i = 0, total = 0; i < (unsigned int) hg_atomic_get32(&rec->nrings);
+         i++)
+        total += (uint64_t) hg_atomic_get64(&rec->rings[i]->head);
+    if (hg_atomic_get32(&rec->nrings) != NTHREADS - 1 ||
+        total != (uint64_t) NTHREADS * RING_RECORDS) {
+        fprintf(stderr, "Error: ring of exited thread was not reused\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+#endif
+
+done:
+    hg_dlog_rec_free(rec);
+    return ret;
+}
@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_histogram.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+int
+main(int argc, char *argv[])
+{
+    struct hg_histogram *hg_histogram = NULL;
+    uint64_t value, p50, p99, p999;
+    unsigned int i;
+    int ret = EXIT_SUCCESS;
+
+    (void) argc;
+    (void) argv;
+
+    /* Every value must belong to a bucket that contains it */
+    for (value = 0; value < (UINT64_C(1) << 20); value += 7) {
+        i = hg_histogram_bucket_index(value);
+        if (i >= HG_HISTOGRAM_BUCKETS || hg_histogram_bucket_value(i) < value ||
+            (i > 0 && hg_histogram_bucket_value(i - 1) >= value)) {
+            fprintf(stderr, "Error: value %" PRIu64 " in wrong bucket %u\n",
+                value, i);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+    if (hg_histogram_bucket_index(UINT64_MAX) != HG_HISTOGRAM_BUCKETS - 1) {
+        fprintf(stderr, "Error: max value not clamped to last bucket\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    hg_histogram = (struct hg_histogram *) calloc(1, sizeof(*hg_histogram));
+    if (hg_histogram == NULL) {
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    if (hg_histogram_percentile(hg_histogram, 50.0) != 0) {
+        fprintf(stderr, "Error: empty histogram has non-zero percentile\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    /* Record 1..100000 */
+    for (value = 1; value <= 100000; value++)
+        hg_histogram_record(hg_histogram, value);
+
+    if (hg_histogram_count(hg_histogram) != 100000 ||
+        hg_histogram_max(hg_histogram) != 100000) {
+        fprintf(stderr, "Error: count or max mismatch\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    /* Relative error is bounded by bucket width */
+    p50 = hg_histogram_percentile(hg_histogram, 50.0);
+    p99 = hg_histogram_percentile(hg_histogram, 99.0);
+    p999 = hg_histogram_percentile(hg_histogram, 99.9);
+    if (p50 < 50000 || p50 > 50000 + 50000 / HG_HISTOGRAM_SUB_COUNT ||
+        p99 < 99000 || p99 > 100000 || p999 < 99900 || p999 > 100000) {
+        fprintf(stderr,
+            "Error: unexpected percentiles p50=%" PRIu64 " p99=%" PRIu64
+            " p999=%" PRIu64 "\n",
+            p50, p99, p999);
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    hg_histogram_reset(hg_histogram);
+    if (hg_histogram_count(hg_histogram) != 0 ||
+        hg_histogram_max(hg_histogram) != 0) {
+        fprintf(stderr, "Error: histogram not reset\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+done:
+    free(hg_histogram);
+
+    return ret;
+}
@@ -10,6 +10,92 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#ifdef __linux__
+#    include <errno.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(SYS_set_mempolicy) &&                        \
+    defined(SYS_get_mempolicy)
+#    define HG_TEST_MEM_HAS_NUMA
+#    define HG_TEST_MPOL_PREFERRED (1)
+#endif
+
+#ifdef HG_TEST_MEM_HAS_NUMA
+static int
+hg_test_mem_numa(void)
+{
+    struct hg_mem_numa_policy prev_policy, policy;
+    long rc;
+
+    /* Skip if memory policies are not supported or not permitted */
+    rc = syscall(SYS_get_mempolicy, &policy.mode, policy.nodemask,
+        (unsigned long) HG_MEM_NUMA_NODE_MAX, NULL, 0UL);
+    if (rc != 0) {
+        fprintf(stderr, "Warning: get_mempolicy() not available, skipping\n");
+        return EXIT_SUCCESS;
+    }
+    rc = syscall(SYS_set_mempolicy, policy.mode, policy.nodemask,
+        (unsigned long) HG_MEM_NUMA_NODE_MAX + 1);
+    if (rc != 0) {
+        fprintf(stderr, "Warning: set_mempolicy() not available, skipping\n");
+        return EXIT_SUCCESS;
+    }
+
+    /* Prefer node 0, which always exists */
+    if (hg_mem_numa_preferred_set(0, &prev_policy) != HG_UTIL_SUCCESS) {
+        fprintf(stderr, "Error: could not set preferred NUMA node\n");
+        return EXIT_FAILURE;
+    }
+    rc = syscall(SYS_get_mempolicy, &policy.mode, policy.nodemask,
+        (unsigned long) HG_MEM_NUMA_NODE_MAX, NULL, 0UL);
+    if (rc != 0 || policy.mode != HG_TEST_MPOL_PREFERRED ||
+        !(policy.nodemask[0] & 1UL)) {
+        fprintf(stderr, "Error: preferred NUMA node policy was not set\n");
+        (void) hg_mem_numa_policy_restore(&prev_policy);
+        return EXIT_FAILURE;
+    }
+
+    /* Restore previous policy */
+    if (hg_mem_numa_policy_restore(&prev_policy) != HG_UTIL_SUCCESS) {
+        fprintf(stderr, "Error: could not restore NUMA policy\n");
+        return EXIT_FAILURE;
+    }
+    rc = syscall(SYS_get_mempolicy, &policy.mode, policy.nodemask,
+        (unsigned long) HG_MEM_NUMA_NODE_MAX, NULL, 0UL);
+    if (rc != 0 || policy.mode != prev_policy.mode) {
+        fprintf(stderr, "Error: previous NUMA policy was not restored\n");
+        return EXIT_FAILURE;
+    }
+
+    /* Out of range nodes are rejected, last node must not be silently
+     * dropped from the mask (unless the system has that many nodes) */
+    if (hg_mem_numa_preferred_set(HG_MEM_NUMA_NODE_MAX, &prev_policy) ==
+        HG_UTIL_SUCCESS) {
+        fprintf(stderr, "Error: invalid NUMA node was accepted\n");
+        (void) hg_mem_numa_policy_restore(&prev_policy);
+        return EXIT_FAILURE;
+    }
+    if (hg_mem_numa_preferred_set(HG_MEM_NUMA_NODE_MAX - 1, &prev_policy) ==
+        HG_UTIL_SUCCESS) {
+        rc = syscall(SYS_get_mempolicy, &policy.mode, policy.nodemask,
+            (unsigned long) HG_MEM_NUMA_NODE_MAX, NULL, 0UL);
+        (void) hg_mem_numa_policy_restore(&prev_policy);
+        if (rc != 0 || policy.mode != HG_TEST_MPOL_PREFERRED ||
+            !(policy.nodemask[(HG_MEM_NUMA_NODE_MAX - 1) /
+                              (8 * sizeof(unsigned long))] &
+                (1UL << ((HG_MEM_NUMA_NODE_MAX - 1) %
+                         (8 * sizeof(unsigned long)))))) {
+            fprintf(stderr, "Error: last NUMA node was not set\n");
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+#endif
+
 int
 main(void)
 {
@@ -38,6 +124,11 @@ main(void)
             (void) hg_mem_huge_free(ptr, page_size * 4);
     }
 
+#ifdef HG_TEST_MEM_HAS_NUMA
+    if (hg_test_mem_numa() != EXIT_SUCCESS)
+        goto error;
+#endif
+
     return EXIT_SUCCESS;
 
 error:
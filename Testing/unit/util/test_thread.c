@@ -11,6 +11,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#ifndef _WIN32
+static int key_value = 0;
+#endif
+
 static HG_THREAD_RETURN_TYPE
 thread_cb_incr(void *arg)
 {
@@ -63,6 +67,28 @@ done:
     return thread_ret;
 }
 
+#ifndef _WIN32
+static void
+key_destructor(void *arg)
+{
+    /* Destructor is called with the value of the exiting thread */
+    *(int *) arg = 2;
+}
+
+static HG_THREAD_RETURN_TYPE
+thread_cb_key_value(void *arg)
+{
+    hg_thread_ret_t thread_ret = (hg_thread_ret_t) 0;
+    hg_thread_key_t *thread_key = (hg_thread_key_t *) arg;
+
+    key_value = 1;
+    hg_thread_setspecific(*thread_key, &key_value);
+
+    hg_thread_exit(thread_ret);
+    return thread_ret;
+}
+#endif
+
 static HG_THREAD_RETURN_TYPE
 thread_cb_equal(void *arg)
 {
@@ -111,6 +137,18 @@ main(int argc, char *argv[])
     hg_thread_join(thread);
     hg_thread_key_delete(thread_key);
 
+#ifndef _WIN32
+    hg_thread_key_create2(&thread_key, key_destructor);
+    hg_thread_create(&thread, thread_cb_key_value, &thread_key);
+    hg_thread_join(thread);
+    hg_thread_key_delete(thread_key);
+    if (key_value != 2) {
+        fprintf(stderr, "Error: Key destructor was not called\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+#endif
+
     hg_thread_create(&thread, thread_cb_equal, &thread);
     hg_thread_join(thread);
 
@@ -15,6 +15,7 @@
 
 #include "mercury_hash_string.h"
 #include "mercury_mem.h"
+#include "mercury_param.h"
 #include "mercury_thread_spin.h"
 
 #include <assert.h>
@@ -31,6 +32,9 @@
 #define HG_HANDLE_CLASS(handle)                                                \
     ((struct hg_private_class *) ((handle)->info.hg_class))
 
+/* Number of core events retrieved at once by HG_Trigger_events() */
+#define HG_TRIGGER_EVENTS_BATCH (64)
+
 /* Name of this subsystem */
 #define HG_SUBSYS_NAME        hg
 #define HG_STRINGIFY(x)       HG_UTIL_STRINGIFY(x)
@@ -58,6 +62,8 @@ struct hg_proc_info {
     hg_proc_cb_t out_proc_cb;      /* Output proc callback */
     void *data;                    /* User data */
     void (*free_callback)(void *); /* User data free callback */
+    hg_size_t in_struct_size;      /* Input struct size (self bypass) */
+    hg_size_t out_struct_size;     /* Output struct size (self bypass) */
 };
 
 /* HG handle */
@@ -79,6 +85,7 @@ struct hg_private_handle {
     hg_size_t in_extra_buf_size;        /* Extra input buffer size */
     hg_size_t out_extra_buf_size;       /* Extra output buffer size */
     bool use_checksums;                 /* Handle uses checksums */
+    bool self_bypass;                   /* Structs are copied, not encoded */
 };
 
 /* HG op id */
@@ -171,6 +178,35 @@ static hg_return_t
 hg_free_struct(struct hg_private_handle *hg_handle,
     const struct hg_proc_info *hg_proc_info, hg_op_t op, void *struct_ptr);
 
+/**
+ * Size of input/output structure if procs are bypassed, 0 otherwise.
+ */
+static HG_INLINE hg_size_t
+hg_struct_self_size(const struct hg_private_handle *hg_handle,
+    const struct hg_proc_info *hg_proc_info, hg_op_t op);
+
+/**
+ * Copy input/output structure from the handle buffer (self bypass).
+ */
+static hg_return_t
+hg_get_struct_self(struct hg_private_handle *hg_handle,
+    const struct hg_proc_info *hg_proc_info, hg_op_t op, void *struct_ptr);
+
+/**
+ * Copy input/output structure to the handle buffer (self bypass).
+ */
+static hg_return_t
+hg_set_struct_self(struct hg_private_handle *hg_handle,
+    const struct hg_proc_info *hg_proc_info, hg_op_t op, void *struct_ptr,
+    hg_size_t *payload_size);
+
+/**
+ * Forward call with optional timeout.
+ */
+static hg_return_t
+hg_forward(hg_handle_t handle, hg_cb_t callback, void *arg, void *in_struct,
+    unsigned int timeout);
+
 /**
  * Get extra user payload using bulk transfer.
  */
@@ -202,6 +238,20 @@ hg_core_forward_cb(const struct hg_core_cb_info *callback_info);
 static HG_INLINE hg_return_t
 hg_core_respond_cb(const struct hg_core_cb_info *callback_info);
 
+/**
+ * Convert core event to event. Internal events are completed directly, in
+ * which case false is returned.
+ */
+static bool
+hg_core_event_get(
+    struct hg_core_cb_event *hg_core_cb_event, struct hg_cb_event *hg_cb_event);
+
+/**
+ * Release event.
+ */
+static HG_INLINE void
+hg_event_release(struct hg_cb_event *hg_cb_event);
+
 /*******************/
 /* Local Variables */
 /*******************/
@@ -485,6 +535,10 @@ hg_get_struct(struct hg_private_handle *hg_handle,
     hg_size_t header_offset = hg_header_get_size(op);
     hg_return_t ret;
 
+    /* Origin and target share the same handle and address space */
+    if (hg_struct_self_size(hg_handle, hg_proc_info, op) > 0)
+        return hg_get_struct_self(hg_handle, hg_proc_info, op, struct_ptr);
+
     switch (op) {
         case HG_INPUT:
             /* Use custom header offset */
@@ -612,6 +666,11 @@ hg_set_struct(struct hg_private_handle *hg_handle,
     hg_size_t header_offset = hg_header_get_size(op);
     hg_return_t ret;
 
+    /* Skip encoding, the handler receives a copy of the struct */
+    if (hg_struct_self_size(hg_handle, hg_proc_info, op) > 0)
+        return hg_set_struct_self(
+            hg_handle, hg_proc_info, op, struct_ptr, payload_size);
+
     switch (op) {
         case HG_INPUT:
             /* Use custom header offset */
@@ -841,20 +900,23 @@ hg_free_struct(struct hg_private_handle *hg_handle,
     HG_CHECK_SUBSYS_ERROR(rpc, proc_cb == NULL, error, ret, HG_FAULT,
         "No proc set, proc must be set in HG_Register()");
 
+    /* Nothing was allocated if the struct was copied */
+    if (hg_struct_self_size(hg_handle, hg_proc_info, op) == 0) {
 #ifdef HG_HAS_XDR
-    /* Include our own header offset */
-    buf = (char *) buf + header_offset;
-    buf_size -= header_offset;
+        /* Include our own header offset */
+        buf = (char *) buf + header_offset;
+        buf_size -= header_offset;
 #endif
 
-    /* Reset proc */
-    ret = hg_proc_reset(proc, buf, buf_size, HG_FREE);
-    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not reset proc");
+        /* Reset proc */
+        ret = hg_proc_reset(proc, buf, buf_size, HG_FREE);
+        HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not reset proc");
 
-    /* Free memory allocated during decode operation */
-    ret = proc_cb(proc, struct_ptr);
-    HG_CHECK_SUBSYS_HG_ERROR(
-        rpc, error, ret, "Could not free allocated parameters");
+        /* Free memory allocated during decode operation */
+        ret = proc_cb(proc, struct_ptr);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            rpc, error, ret, "Could not free allocated parameters");
+    }
 
     /* Decrement ref count or free */
     ret = HG_Core_destroy(hg_handle->handle.core_handle);
@@ -867,6 +929,182 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static HG_INLINE hg_size_t
+hg_struct_self_size(const struct hg_private_handle *hg_handle,
+    const struct hg_proc_info *hg_proc_info, hg_op_t op)
+{
+    if (!hg_handle->self_bypass)
+        return 0;
+
+    return (op == HG_INPUT) ? hg_proc_info->in_struct_size
+                            : hg_proc_info->out_struct_size;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_get_struct_self(struct hg_private_handle *hg_handle,
+    const struct hg_proc_info *hg_proc_info, hg_op_t op, void *struct_ptr)
+{
+    hg_size_t header_offset = hg_header_get_size(op), struct_size;
+    hg_proc_cb_t proc_cb;
+    void *buf;
+    hg_size_t buf_size;
+    hg_return_t ret;
+
+    switch (op) {
+        case HG_INPUT:
+            header_offset += hg_handle->handle.info.hg_class->in_offset;
+            proc_cb = hg_proc_info->in_proc_cb;
+            struct_size = hg_proc_info->in_struct_size;
+            ret = HG_Core_get_input(
+                hg_handle->handle.core_handle, &buf, &buf_size);
+            HG_CHECK_SUBSYS_HG_ERROR(
+                rpc, error, ret, "Could not get input buffer");
+            break;
+        case HG_OUTPUT:
+            header_offset += hg_handle->handle.info.hg_class->out_offset;
+            proc_cb = hg_proc_info->out_proc_cb;
+            struct_size = hg_proc_info->out_struct_size;
+            ret = HG_Core_get_output(
+                hg_handle->handle.core_handle, &buf, &buf_size);
+            HG_CHECK_SUBSYS_HG_ERROR(
+                rpc, error, ret, "Could not get output buffer");
+            break;
+        default:
+            HG_GOTO_SUBSYS_ERROR(
+                rpc, error, ret, HG_INVALID_ARG, "Invalid HG op");
+    }
+    HG_CHECK_SUBSYS_ERROR(rpc, proc_cb == NULL, error, ret, HG_FAULT,
+        "No proc set, proc must be set in HG_Register()");
+    HG_CHECK_SUBSYS_ERROR(rpc, header_offset + struct_size > buf_size, error,
+        ret, HG_OVERFLOW, "Struct size (%" PRIu64 ") exceeds buffer size",
+        struct_size);
+
+    /* Shallow copy, members point to memory owned by the origin */
+    memcpy(struct_ptr, (char *) buf + header_offset, (size_t) struct_size);
+
+    /* Increment ref count on handle so that it remains valid until free_struct
+     * is called */
+    HG_Core_ref_incr(hg_handle->handle.core_handle);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_set_struct_self(struct hg_private_handle *hg_handle,
+    const struct hg_proc_info *hg_proc_info, hg_op_t op, void *struct_ptr,
+    hg_size_t *payload_size)
+{
+    hg_size_t header_offset = hg_header_get_size(op), struct_size;
+    hg_proc_cb_t proc_cb;
+    void *buf;
+    hg_size_t buf_size;
+    hg_return_t ret;
+
+    switch (op) {
+        case HG_INPUT:
+            header_offset += hg_handle->handle.info.hg_class->in_offset;
+            proc_cb = hg_proc_info->in_proc_cb;
+            struct_size = hg_proc_info->in_struct_size;
+            ret = HG_Core_get_input(
+                hg_handle->handle.core_handle, &buf, &buf_size);
+            HG_CHECK_SUBSYS_HG_ERROR(
+                rpc, error, ret, "Could not get input buffer");
+            break;
+        case HG_OUTPUT:
+            header_offset += hg_handle->handle.info.hg_class->out_offset;
+            proc_cb = hg_proc_info->out_proc_cb;
+            struct_size = hg_proc_info->out_struct_size;
+            ret = HG_Core_get_output(
+                hg_handle->handle.core_handle, &buf, &buf_size);
+            HG_CHECK_SUBSYS_HG_ERROR(
+                rpc, error, ret, "Could not get output buffer");
+            break;
+        default:
+            HG_GOTO_SUBSYS_ERROR(
+                rpc, error, ret, HG_INVALID_ARG, "Invalid HG op");
+    }
+    if (proc_cb == NULL || struct_ptr == NULL) {
+        /* Silently skip */
+        *payload_size = header_offset;
+        return HG_SUCCESS;
+    }
+    HG_CHECK_SUBSYS_ERROR(rpc, header_offset + struct_size > buf_size, error,
+        ret, HG_OVERFLOW, "Struct size (%" PRIu64 ") exceeds buffer size",
+        struct_size);
+
+    /* Copy struct so that it can be released once forward/respond returns,
+     * memory referenced by its members must remain valid until completion */
+    memcpy((char *) buf + header_offset, struct_ptr, (size_t) struct_size);
+    *payload_size = header_offset + struct_size;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_forward(hg_handle_t handle, hg_cb_t callback, void *arg, void *in_struct,
+    unsigned int timeout)
+{
+    struct hg_private_handle *private_handle =
+        (struct hg_private_handle *) handle;
+    const struct hg_proc_info *hg_proc_info = NULL;
+    hg_size_t payload_size = 0;
+    bool more_data = false;
+    uint8_t flags = 0;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(rpc, handle == HG_HANDLE_NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG handle");
+    HG_CHECK_SUBSYS_ERROR(rpc, handle->info.addr == HG_ADDR_NULL, error, ret,
+        HG_INVALID_ARG, "NULL target addr");
+
+    /* Set callback data */
+    private_handle->forward_cb = callback;
+    private_handle->forward_arg = arg;
+
+    /* Retrieve RPC data */
+    hg_proc_info =
+        (const struct hg_proc_info *) HG_Core_get_rpc_data(handle->core_handle);
+    HG_CHECK_SUBSYS_ERROR(rpc, hg_proc_info == NULL, error, ret, HG_FAULT,
+        "Could not get proc info");
+
+    /* Handles forwarded to self are also passed to the RPC callback */
+    private_handle->self_bypass =
+        (hg_proc_info->in_struct_size > 0 ||
+            hg_proc_info->out_struct_size > 0) &&
+        HG_Core_addr_is_self(handle->core_handle->info.addr);
+
+    /* Set input struct */
+    ret = hg_set_struct(private_handle, hg_proc_info, HG_INPUT, in_struct,
+        &payload_size, &more_data);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        rpc, error, ret, "Could not set input (%s)", HG_Error_to_string(ret));
+
+    /* Set more data flag on handle so that handle_more_callback is triggered */
+    if (more_data)
+        flags |= HG_CORE_MORE_DATA;
+
+    /* Send request */
+    ret = HG_Core_forward_timed(handle->core_handle, hg_core_forward_cb,
+        handle, flags, payload_size, timeout);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not forward call (%s)",
+        HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_get_extra_payload(struct hg_private_handle *hg_handle, hg_op_t op,
@@ -1035,6 +1273,104 @@ hg_core_respond_cb(const struct hg_core_cb_info *callback_info)
     return HG_SUCCESS;
 }
 
+/*---------------------------------------------------------------------------*/
+static bool
+hg_core_event_get(
+    struct hg_core_cb_event *hg_core_cb_event, struct hg_cb_event *hg_cb_event)
+{
+    const struct hg_core_cb_info *callback_info = &hg_core_cb_event->info;
+
+    switch (callback_info->type) {
+        case HG_CB_LOOKUP: {
+            struct hg_op_id *hg_op_id = (struct hg_op_id *) callback_info->arg;
+
+            *hg_cb_event = (struct hg_cb_event){.callback = hg_op_id->callback,
+                .info = {.arg = hg_op_id->arg,
+                    .ret = callback_info->ret,
+                    .type = hg_op_id->type,
+                    .info.lookup.addr =
+                        (hg_addr_t) callback_info->info.lookup.addr},
+                .op_id = HG_OP_ID_NULL};
+
+            /* NB. OK to free now, op ID is not re-used */
+            free(hg_op_id);
+            break;
+        }
+        case HG_CB_FORWARD: {
+            struct hg_private_handle *hg_handle =
+                (struct hg_private_handle *) callback_info->arg;
+
+            *hg_cb_event =
+                (struct hg_cb_event){.callback = hg_handle->forward_cb,
+                    .info = {.arg = hg_handle->forward_arg,
+                        .ret = callback_info->ret,
+                        .type = callback_info->type,
+                        .info.forward.handle = (hg_handle_t) hg_handle},
+                    .op_id = HG_OP_ID_NULL};
+            break;
+        }
+        case HG_CB_RESPOND: {
+            struct hg_private_handle *hg_handle =
+                (struct hg_private_handle *) callback_info->arg;
+
+            *hg_cb_event =
+                (struct hg_cb_event){.callback = hg_handle->respond_cb,
+                    .info = {.arg = hg_handle->respond_arg,
+                        .ret = callback_info->ret,
+                        .type = callback_info->type,
+                        .info.respond.handle = (hg_handle_t) hg_handle},
+                    .op_id = HG_OP_ID_NULL};
+            break;
+        }
+        case HG_CB_BULK:
+            hg_bulk_get_event(
+                (struct hg_bulk_op_id *) callback_info->arg, hg_cb_event);
+
+            /* Extra payload transfers are internal */
+            if (hg_cb_event->callback == hg_get_extra_payload_cb) {
+                hg_bulk_trigger_entry(
+                    (struct hg_bulk_op_id *) callback_info->arg);
+                return false;
+            }
+            break;
+        default:
+            HG_LOG_SUBSYS_ERROR(poll, "Invalid type of event (%d)",
+                (int) callback_info->type);
+            return false;
+    }
+
+    /* Operations without callback are not reported */
+    if (hg_cb_event->callback == NULL) {
+        hg_event_release(hg_cb_event);
+        return false;
+    }
+
+    return true;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE void
+hg_event_release(struct hg_cb_event *hg_cb_event)
+{
+    switch (hg_cb_event->info.type) {
+        case HG_CB_FORWARD:
+            (void) HG_Core_destroy(
+                hg_cb_event->info.info.forward.handle->core_handle);
+            break;
+        case HG_CB_RESPOND:
+            (void) HG_Core_destroy(
+                hg_cb_event->info.info.respond.handle->core_handle);
+            break;
+        case HG_CB_BULK:
+            hg_bulk_release_entry((struct hg_bulk_op_id *) hg_cb_event->op_id);
+            break;
+        case HG_CB_LOOKUP:
+        default:
+            /* Nothing to release */
+            break;
+    }
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Version_get(
@@ -1228,6 +1564,44 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Class_get_stats(hg_class_t *hg_class, struct hg_stats *stats)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(
+        cls, hg_class == NULL, error, ret, HG_INVALID_ARG, "NULL HG class");
+
+    ret = HG_Core_class_get_stats(hg_class->core_class, stats);
+    HG_CHECK_SUBSYS_HG_ERROR(cls, error, ret,
+        "Could not get HG core class stats (%s)", HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Class_dump_trace(hg_class_t *hg_class, const char *file)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(
+        cls, hg_class == NULL, error, ret, HG_INVALID_ARG, "NULL HG class");
+
+    ret = HG_Core_class_dump_trace(hg_class->core_class, file);
+    HG_CHECK_SUBSYS_HG_ERROR(cls, error, ret,
+        "Could not dump HG core class trace (%s)", HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_context_t *
 HG_Context_create(hg_class_t *hg_class)
@@ -1238,6 +1612,13 @@ HG_Context_create(hg_class_t *hg_class)
 /*---------------------------------------------------------------------------*/
 hg_context_t *
 HG_Context_create_id(hg_class_t *hg_class, uint8_t id)
+{
+    return HG_Context_create_numa(hg_class, id, -1);
+}
+
+/*---------------------------------------------------------------------------*/
+hg_context_t *
+HG_Context_create_numa(hg_class_t *hg_class, uint8_t id, int numa_node)
 {
     struct hg_context *hg_context = NULL;
     hg_return_t ret;
@@ -1250,7 +1631,7 @@ HG_Context_create_id(hg_class_t *hg_class, uint8_t id)
 
     hg_context->hg_class = hg_class;
     hg_context->core_context =
-        HG_Core_context_create_id(hg_class->core_class, id);
+        HG_Core_context_create_numa(hg_class->core_class, id, numa_node);
     HG_CHECK_SUBSYS_ERROR_NORET(ctx, hg_context->core_context == NULL, error,
         "Could not create context for ID %u", id);
 
@@ -1316,6 +1697,25 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Context_get_stats(const hg_context_t *context, struct hg_stats *stats)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(
+        ctx, context == NULL, error, ret, HG_INVALID_ARG, "NULL HG context");
+
+    ret = HG_Core_context_get_stats(context->core_context, stats);
+    HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret,
+        "Could not get HG core context stats (%s)", HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_id_t
 HG_Register_name(hg_class_t *hg_class, const char *func_name,
@@ -1575,6 +1975,97 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Registered_set_self_bypass(hg_class_t *hg_class, hg_id_t id,
+    hg_size_t in_struct_size, hg_size_t out_struct_size)
+{
+    struct hg_proc_info *hg_proc_info = NULL;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(
+        cls, hg_class == NULL, error, ret, HG_INVALID_ARG, "NULL HG class");
+
+    /* Retrieve proc function from function map */
+    hg_proc_info = (struct hg_proc_info *) HG_Core_registered_data(
+        hg_class->core_class, id);
+    HG_CHECK_SUBSYS_ERROR(cls, hg_proc_info == NULL, error, ret, HG_NOENTRY,
+        "Could not get registered data for RPC ID %" PRIu64, id);
+
+    hg_proc_info->in_struct_size = in_struct_size;
+    hg_proc_info->out_struct_size = out_struct_size;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Registered_set_priority(
+    hg_class_t *hg_class, hg_id_t id, hg_priority_t priority)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(
+        cls, hg_class == NULL, error, ret, HG_INVALID_ARG, "NULL HG class");
+
+    return HG_Core_registered_set_priority(hg_class->core_class, id, priority);
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Registered_get_priority(
+    hg_class_t *hg_class, hg_id_t id, hg_priority_t *priority_p)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(
+        cls, hg_class == NULL, error, ret, HG_INVALID_ARG, "NULL HG class");
+
+    return HG_Core_registered_get_priority(
+        hg_class->core_class, id, priority_p);
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Registered_freeze(hg_class_t *hg_class)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(
+        cls, hg_class == NULL, error, ret, HG_INVALID_ARG, "NULL HG class");
+
+    return HG_Core_registered_freeze(hg_class->core_class);
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Registered_get_latency(hg_class_t *hg_class, hg_id_t id,
+    struct hg_rpc_latency *latency, uint8_t reset)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(
+        cls, hg_class == NULL, error, ret, HG_INVALID_ARG, "NULL HG class");
+
+    return HG_Core_registered_get_latency(
+        hg_class->core_class, id, latency, reset);
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Addr_lookup1(hg_context_t *context, hg_cb_t callback, void *arg,
@@ -1631,6 +2122,27 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Addr_lookup_batch(hg_class_t *hg_class, const char *const names[],
+    unsigned int count, hg_addr_t addrs[])
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(
+        addr, hg_class == NULL, error, ret, HG_INVALID_ARG, "NULL HG class");
+
+    ret = HG_Core_addr_lookup_batch(
+        hg_class->core_class, names, count, (hg_core_addr_t *) addrs);
+    HG_CHECK_SUBSYS_HG_ERROR(addr, error, ret,
+        "Could not lookup %u addresses (%s)", count, HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Addr_free(hg_class_t *hg_class, hg_addr_t addr)
@@ -2078,49 +2590,15 @@ error:
 hg_return_t
 HG_Forward(hg_handle_t handle, hg_cb_t callback, void *arg, void *in_struct)
 {
-    struct hg_private_handle *private_handle =
-        (struct hg_private_handle *) handle;
-    const struct hg_proc_info *hg_proc_info = NULL;
-    hg_size_t payload_size = 0;
-    bool more_data = false;
-    uint8_t flags = 0;
-    hg_return_t ret;
-
-    HG_CHECK_SUBSYS_ERROR(rpc, handle == HG_HANDLE_NULL, error, ret,
-        HG_INVALID_ARG, "NULL HG handle");
-    HG_CHECK_SUBSYS_ERROR(rpc, handle->info.addr == HG_ADDR_NULL, error, ret,
-        HG_INVALID_ARG, "NULL target addr");
-
-    /* Set callback data */
-    private_handle->forward_cb = callback;
-    private_handle->forward_arg = arg;
-
-    /* Retrieve RPC data */
-    hg_proc_info =
-        (const struct hg_proc_info *) HG_Core_get_rpc_data(handle->core_handle);
-    HG_CHECK_SUBSYS_ERROR(rpc, hg_proc_info == NULL, error, ret, HG_FAULT,
-        "Could not get proc info");
-
-    /* Set input struct */
-    ret = hg_set_struct(private_handle, hg_proc_info, HG_INPUT, in_struct,
-        &payload_size, &more_data);
-    HG_CHECK_SUBSYS_HG_ERROR(
-        rpc, error, ret, "Could not set input (%s)", HG_Error_to_string(ret));
-
-    /* Set more data flag on handle so that handle_more_callback is triggered */
-    if (more_data)
-        flags |= HG_CORE_MORE_DATA;
-
-    /* Send request */
-    ret = HG_Core_forward(
-        handle->core_handle, hg_core_forward_cb, handle, flags, payload_size);
-    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not forward call (%s)",
-        HG_Error_to_string(ret));
-
-    return HG_SUCCESS;
+    return hg_forward(handle, callback, arg, in_struct, 0);
+}
 
-error:
-    return ret;
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Forward_timed(hg_handle_t handle, hg_cb_t callback, void *arg,
+    void *in_struct, unsigned int timeout)
+{
+    return hg_forward(handle, callback, arg, in_struct, timeout);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -2189,6 +2667,25 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Addr_cancel_all(hg_context_t *context, hg_addr_t addr)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(ctx, context == NULL, error, ret, HG_INVALID_ARG,
+        "NULL HG context");
+
+    ret = HG_Core_addr_cancel_all(context->core_context, (hg_core_addr_t) addr);
+    HG_CHECK_SUBSYS_HG_ERROR(addr, error, ret,
+        "Could not cancel operations to addr (%s)", HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Progress(hg_context_t *context, unsigned int timeout)
@@ -2226,3 +2723,61 @@ HG_Trigger(hg_context_t *context, unsigned int timeout, unsigned int max_count,
 done:
     return ret;
 }
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Trigger_events(hg_context_t *context, unsigned int timeout,
+    unsigned int max_count, struct hg_cb_event *events,
+    unsigned int *actual_count_p)
+{
+    struct hg_core_cb_event core_events[HG_TRIGGER_EVENTS_BATCH];
+    unsigned int count = 0;
+    hg_return_t ret = HG_SUCCESS;
+
+    HG_CHECK_SUBSYS_ERROR(
+        poll, context == NULL, done, ret, HG_INVALID_ARG, "NULL HG context");
+    HG_CHECK_SUBSYS_ERROR(poll, events == NULL && max_count > 0, done, ret,
+        HG_INVALID_ARG, "NULL event array");
+
+    while (count < max_count) {
+        unsigned int batch_count = MIN(max_count - count,
+                         HG_TRIGGER_EVENTS_BATCH),
+                     core_count = 0, i;
+
+        /* Only wait if nothing was retrieved yet */
+        ret = HG_Core_trigger_events(context->core_context,
+            (count == 0) ? timeout : 0, batch_count, core_events, &core_count);
+        if (ret == HG_TIMEOUT) {
+            if (count > 0)
+                ret = HG_SUCCESS;
+            break;
+        }
+        HG_CHECK_SUBSYS_HG_ERROR(poll, done, ret,
+            "Could not retrieve events from context (%s)",
+            HG_Error_to_string(ret));
+
+        for (i = 0; i < core_count; i++)
+            if (hg_core_event_get(&core_events[i], &events[count]))
+                count++;
+
+        if (core_count < batch_count)
+            break;
+    }
+
+done:
+    /* Events already retrieved must be released by the caller even on error */
+    if (actual_count_p)
+        *actual_count_p = count;
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+HG_Release_events(struct hg_cb_event *events, unsigned int count)
+{
+    unsigned int i;
+
+    for (i = 0; i < count; i++)
+        hg_event_release(&events[i]);
+}
@@ -314,6 +314,31 @@ HG_PUBLIC hg_return_t
 HG_Class_set_handle_create_callback(hg_class_t *hg_class,
     hg_return_t (*callback)(hg_handle_t, void *), void *arg);
 
+/**
+ * Retrieve stats accumulated by all the contexts (including destroyed ones)
+ * that were created from that class. See HG_Context_get_stats().
+ *
+ * \param hg_class [IN]         pointer to HG class
+ * \param stats [OUT]           pointer to stats struct
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Class_get_stats(hg_class_t *hg_class, struct hg_stats *stats);
+
+/**
+ * Write the handle lifecycle events recorded so far as Chrome trace event
+ * JSON. Tracing must have been enabled by setting trace_file at init time.
+ * See HG_Core_class_dump_trace().
+ *
+ * \param hg_class [IN]         pointer to HG class
+ * \param file [IN]             path of trace file
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Class_dump_trace(hg_class_t *hg_class, const char *file);
+
 /**
  * Create a new context. Must be destroyed by calling HG_Context_destroy().
  *
@@ -348,6 +373,30 @@ HG_Context_create(hg_class_t *hg_class) HG_WARN_UNUSED_RESULT;
 HG_PUBLIC hg_context_t *
 HG_Context_create_id(hg_class_t *hg_class, uint8_t id) HG_WARN_UNUSED_RESULT;
 
+/**
+ * Create a new context with a user-defined context identifier, see
+ * HG_Context_create_id(). Resources of the context (handle pools, bulk op
+ * pool, NA message and multi-recv buffers) are preferably allocated on NUMA
+ * node \numa_node so that progressing threads running on that node do not
+ * access remote memory. Placement is only a hint, the context is still created
+ * if it cannot be applied.
+ * Context must be destroyed by calling HG_Context_destroy().
+ *
+ * \remark This routine is internally equivalent to:
+ *   - HG_Core_context_create_numa() with specified context ID and NUMA node
+ *   - If listening
+ *       - HG_Core_context_post() with repost set to HG_TRUE
+ *
+ * \param hg_class [IN]         pointer to HG class
+ * \param id [IN]               user-defined context ID
+ * \param numa_node [IN]        NUMA node (negative for no preference)
+ *
+ * \return Pointer to HG context or NULL in case of failure
+ */
+HG_PUBLIC hg_context_t *
+HG_Context_create_numa(
+    hg_class_t *hg_class, uint8_t id, int numa_node) HG_WARN_UNUSED_RESULT;
+
 /**
  * Destroy a context created by HG_Context_create(). If listening and
  * HG_Context_unpost() has not already been called, also cancels previously
@@ -415,6 +464,20 @@ HG_Context_set_data(
 static HG_INLINE void *
 HG_Context_get_data(const hg_context_t *context) HG_WARN_UNUSED_RESULT;
 
+/**
+ * Retrieve stats accumulated by context since its creation. Stats are always
+ * available (including in release builds) and may be retrieved while the
+ * context is in use, in which case counters may not all reflect the same
+ * point in time.
+ *
+ * \param context [IN]          pointer to HG context
+ * \param stats [OUT]           pointer to stats struct
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Context_get_stats(const hg_context_t *context, struct hg_stats *stats);
+
 /**
  * Dynamically register a function func_name as an RPC as well as the
  * RPC callback executed when the RPC request ID associated to func_name is
@@ -568,6 +631,88 @@ HG_PUBLIC hg_return_t
 HG_Registered_disabled_response(
     hg_class_t *hg_class, hg_id_t id, uint8_t *disabled_p);
 
+/**
+ * Bypass input/output procs for a given RPC ID when it is forwarded to self.
+ * Origin and target then share the same address space and the RPC callback
+ * receives a shallow copy of the input struct passed to HG_Forward() (and
+ * the origin a shallow copy of the output struct passed to HG_Respond()),
+ * without any encoding or decoding. Memory referenced by struct members
+ * (strings, buffers, bulk handles, etc) is therefore not copied and must
+ * remain valid until the operation completes, HG_Free_input() and
+ * HG_Free_output() do not release it. Structs must fit into the eager
+ * buffers. A size of 0 keeps the proc of the corresponding struct. By
+ * default, procs are always used.
+ *
+ * \param hg_class [IN]         pointer to HG class
+ * \param id [IN]               registered function ID
+ * \param in_struct_size [IN]   size of input struct
+ * \param out_struct_size [IN]  size of output struct
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Registered_set_self_bypass(hg_class_t *hg_class, hg_id_t id,
+    hg_size_t in_struct_size, hg_size_t out_struct_size);
+
+/**
+ * Set default priority of a given RPC ID. Handles created for that RPC ID
+ * use that priority unless HG_Set_priority() is called. On the target,
+ * RPCs are processed with the highest of the priority sent by the origin
+ * and the priority registered for that RPC ID.
+ * By default, all RPCs use HG_PRIORITY_DEFAULT.
+ *
+ * \param hg_class [IN]         pointer to HG class
+ * \param id [IN]               registered function ID
+ * \param priority [IN]         priority
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Registered_set_priority(
+    hg_class_t *hg_class, hg_id_t id, hg_priority_t priority);
+
+/**
+ * Get default priority of a given RPC ID.
+ *
+ * \param hg_class [IN]         pointer to HG class
+ * \param id [IN]               registered function ID
+ * \param priority_p [OUT]      pointer to returned priority
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Registered_get_priority(
+    hg_class_t *hg_class, hg_id_t id, hg_priority_t *priority_p);
+
+/**
+ * Compile the map of registered RPC IDs into a perfect hash table so that
+ * each lookup of an incoming RPC ID reads a single slot. This is meant to be
+ * called once all RPCs have been registered. RPC IDs can still be registered
+ * or deregistered afterwards, in which case the map is converted back to its
+ * default representation.
+ *
+ * \param hg_class [IN]         pointer to HG class
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Registered_freeze(hg_class_t *hg_class);
+
+/**
+ * Get a snapshot of the latencies recorded for an RPC ID. Latencies are only
+ * recorded when the class is initialized with stats set.
+ *
+ * \param hg_class [IN]         pointer to HG class
+ * \param id [IN]               registered function ID
+ * \param latency [OUT]         pointer to latency struct
+ * \param reset [IN]            reset histograms after snapshot
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Registered_get_latency(hg_class_t *hg_class, hg_id_t id,
+    struct hg_rpc_latency *latency, uint8_t reset);
+
 /**
  * Lookup an addr from a peer address/name. Addresses need to be
  * freed by calling HG_Addr_free(). After completion, user callback is
@@ -605,6 +750,24 @@ HG_Addr_lookup1(hg_context_t *context, hg_cb_t callback, void *arg,
 HG_PUBLIC hg_return_t
 HG_Addr_lookup2(hg_class_t *hg_class, const char *name, hg_addr_t *addr_p);
 
+/**
+ * Lookup an array of addrs from peer addresses/names, see HG_Addr_lookup2().
+ * Names that have already been looked up by a previous batch, or that appear
+ * multiple times in the same batch, share the same address. Each returned
+ * address must be freed by calling HG_Addr_free(). If one of the lookups
+ * fails, no address is returned.
+ *
+ * \param hg_class [IN/OUT]     pointer to HG class
+ * \param names [IN]            array of lookup names
+ * \param count [IN]            number of names
+ * \param addrs [OUT]           array of count returned addresses
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Addr_lookup_batch(hg_class_t *hg_class, const char *const names[],
+    unsigned int count, hg_addr_t addrs[]);
+
 /**
  * Free the addr.
  *
@@ -958,6 +1121,22 @@ HG_Get_output_extra_buf(
 static HG_INLINE hg_return_t
 HG_Set_target_id(hg_handle_t handle, uint8_t id);
 
+/**
+ * Set priority of the RPC request. Completions of handles with a higher
+ * priority are triggered first, using a weighted policy that still lets
+ * lower priorities make progress. The priority is also sent to the target
+ * so that the RPC callback is scheduled accordingly. Priority defaults to
+ * the one set with HG_Registered_set_priority() and is reset when the
+ * handle is reset with a different RPC ID.
+ *
+ * \param handle [IN]           HG handle
+ * \param priority [IN]         priority
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+static HG_INLINE hg_return_t
+HG_Set_priority(hg_handle_t handle, hg_priority_t priority);
+
 /**
  * Forward a call to a local/remote target using an existing HG handle.
  * Input structure can be passed and parameters serialized using a previously
@@ -980,6 +1159,26 @@ HG_Set_target_id(hg_handle_t handle, uint8_t id);
 HG_PUBLIC hg_return_t
 HG_Forward(hg_handle_t handle, hg_cb_t callback, void *arg, void *in_struct);
 
+/**
+ * Forward a call to a local/remote target using an existing HG handle, see
+ * HG_Forward(). If the call has not completed after timeout milliseconds, it
+ * is canceled and its callback completes with HG_TIMEOUT. Expired calls are
+ * detected while the context makes progress.
+ *
+ * \remark Calls forwarded to self cannot be canceled and ignore timeout.
+ *
+ * \param handle [IN]           HG handle
+ * \param callback [IN]         pointer to function callback
+ * \param arg [IN]              pointer to data passed to callback
+ * \param in_struct [IN]        pointer to input structure
+ * \param timeout [IN]          timeout (in milliseconds), 0 for no timeout
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Forward_timed(hg_handle_t handle, hg_cb_t callback, void *arg,
+    void *in_struct, unsigned int timeout);
+
 /**
  * Respond back to origin using an existing HG handle.
  * Output structure can be passed and parameters serialized using a previously
@@ -1011,6 +1210,21 @@ HG_Respond(hg_handle_t handle, hg_cb_t callback, void *arg, void *out_struct);
 HG_PUBLIC hg_return_t
 HG_Cancel(hg_handle_t handle);
 
+/**
+ * Cancel all ongoing operations of a context that target an address, i.e.,
+ * forwarded RPCs, responses and bulk transfers. This is typically used once
+ * a peer is known to have failed and replaces calls to HG_Cancel() and
+ * HG_Bulk_cancel() on each operation. Callbacks of canceled operations are
+ * still triggered and return HG_CANCELED.
+ *
+ * \param context [IN]          pointer to HG context
+ * \param addr [IN]             abstract address
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Addr_cancel_all(hg_context_t *context, hg_addr_t addr);
+
 /**
  * (Deprecated in favor of HG_Event_progress())
  * Try to progress RPC execution for at most timeout until timeout is reached or
@@ -1044,6 +1258,44 @@ HG_PUBLIC hg_return_t
 HG_Trigger(hg_context_t *context, unsigned int timeout, unsigned int max_count,
     unsigned int *actual_count_p);
 
+/**
+ * Retrieve at most max_count completion events without executing their
+ * callbacks. Completed operations are removed from the completion queue in
+ * batches and each event describes the operation type, its handle (or op ID
+ * for bulk transfers), its return code and the user argument that was passed
+ * when the operation was posted, along with the callback that would have been
+ * executed, so that callers can dispatch them on their own. If timeout is
+ * non-zero, wait up to timeout before returning.
+ *
+ * \remark Incoming RPC requests and internal operations are still processed
+ * and are not reported, operations that have no callback attached are not
+ * reported either. Events hold a reference to their handle or op ID, which
+ * must be released with HG_Release_events() once events have been processed.
+ * If an error is returned, actual_count_p is still set to the number of events
+ * that were already retrieved, which must also be released.
+ *
+ * \param context [IN]          pointer to HG context
+ * \param timeout [IN]          timeout (in milliseconds)
+ * \param max_count [IN]        maximum number of events returned
+ * \param events [OUT]          array of at least max_count events
+ * \param actual_count_p [OUT]  actual number of events returned
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Trigger_events(hg_context_t *context, unsigned int timeout,
+    unsigned int max_count, struct hg_cb_event *events,
+    unsigned int *actual_count_p);
+
+/**
+ * Release resources held by events returned by HG_Trigger_events().
+ *
+ * \param events [IN]           array of events
+ * \param count [IN]            number of events
+ */
+HG_PUBLIC void
+HG_Release_events(struct hg_cb_event *events, unsigned int count);
+
 /**
  * Retrieve file descriptor from internal wait object when supported.
  * The descriptor can be used by upper layers for manual polling through the
@@ -1293,6 +1545,13 @@ HG_Set_target_id(hg_handle_t handle, uint8_t id)
     return HG_Core_set_target_id(handle->core_handle, id);
 }
 
+/*---------------------------------------------------------------------------*/
+static HG_INLINE hg_return_t
+HG_Set_priority(hg_handle_t handle, hg_priority_t priority)
+{
+    return HG_Core_set_priority(handle->core_handle, priority);
+}
+
 /*---------------------------------------------------------------------------*/
 static HG_INLINE int
 HG_Event_get_wait_fd(const hg_context_t *context)
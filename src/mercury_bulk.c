@@ -25,6 +25,9 @@
 /* Limit for number of segments statically allocated */
 #define HG_BULK_STATIC_MAX (8)
 
+/* Number of op IDs canceled per pass when canceling by address */
+#define HG_BULK_CANCEL_BATCH (64)
+
 /* Additional internal bulk flags (can hold up to 8 bits) */
 #define HG_BULK_ALLOC (1 << 4) /* memory is allocated */
 #define HG_BULK_BIND  (1 << 5) /* address is bound to segment */
@@ -194,6 +197,7 @@ struct hg_bulk_op_id {
         hg_completion_entry;           /* Entry in completion queue */
     struct hg_cb_info callback_info;   /* Callback info struct */
     LIST_ENTRY(hg_bulk_op_id) pending; /* Pending list entry */
+    LIST_ENTRY(hg_bulk_op_id) active;  /* Active list entry */
     struct hg_bulk_op_pool *op_pool;   /* Pool that op ID belongs to */
     hg_cb_t callback;                  /* Pointer to function */
     hg_bulk_na_op_id_t na_op_ids;      /* NA operations IDs */
@@ -203,12 +207,15 @@ struct hg_bulk_op_id {
     hg_core_context_t *core_context;      /* Context */
     na_class_t *na_class;                 /* NA class */
     na_context_t *na_context;             /* NA context */
+    struct hg_core_addr *origin_addr;     /* Origin addr (tracked only) */
+    na_addr_t *na_addr;                   /* NA addr of origin */
     hg_atomic_int32_t status;             /* Operation status */
     hg_atomic_int32_t ret_status;         /* Return status */
     hg_atomic_int32_t op_completed_count; /* Number of operations completed */
     hg_atomic_int32_t ref_count;          /* Refcount */
     uint32_t op_count;                    /* Number of ongoing operations */
     bool reuse;                           /* Re-use op ID once ref_count is 0 */
+    bool tracked;                         /* NA transfer in active list */
 };
 
 /* Pool of op IDs */
@@ -218,6 +225,8 @@ struct hg_bulk_op_pool {
     hg_core_context_t *core_context;         /* Context */
     LIST_HEAD(, hg_bulk_op_id) pending_list; /* Pending op IDs */
     hg_thread_spin_t pending_list_lock;      /* Pending list lock */
+    LIST_HEAD(, hg_bulk_op_id) active_list;  /* Op IDs with NA transfers */
+    hg_thread_spin_t active_list_lock;       /* Active list lock */
     unsigned long count;                     /* Number of op IDs */
     bool extending;                          /* When extending the pool */
 };
@@ -362,6 +371,19 @@ hg_bulk_op_create(
 static void
 hg_bulk_op_destroy(struct hg_bulk_op_id *hg_bulk_op_id);
 
+/**
+ * Remove operation ID from active list of its pool.
+ */
+static void
+hg_bulk_op_untrack(struct hg_bulk_op_id *hg_bulk_op_id);
+
+/**
+ * Check whether operation ID transfers data from/to address.
+ */
+static bool
+hg_bulk_op_match_addr(
+    const struct hg_bulk_op_id *hg_bulk_op_id, const struct hg_core_addr *addr);
+
 /**
  * Retrive bulk operation ID from pool.
  */
@@ -1751,6 +1773,40 @@ hg_bulk_op_destroy(struct hg_bulk_op_id *hg_bulk_op_id)
     }
 }
 
+/*---------------------------------------------------------------------------*/
+static void
+hg_bulk_op_untrack(struct hg_bulk_op_id *hg_bulk_op_id)
+{
+    if (!hg_bulk_op_id->tracked)
+        return;
+
+    hg_thread_spin_lock(&hg_bulk_op_id->op_pool->active_list_lock);
+    LIST_REMOVE(hg_bulk_op_id, active);
+    hg_bulk_op_id->tracked = false;
+    hg_thread_spin_unlock(&hg_bulk_op_id->op_pool->active_list_lock);
+
+    (void) HG_Core_addr_free(hg_bulk_op_id->origin_addr);
+    hg_bulk_op_id->origin_addr = NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+static bool
+hg_bulk_op_match_addr(
+    const struct hg_bulk_op_id *hg_bulk_op_id, const struct hg_core_addr *addr)
+{
+    na_addr_t *na_addr = addr->na_addr;
+
+#ifdef NA_HAS_SM
+    if (hg_bulk_op_id->na_class == addr->core_class->na_sm_class)
+        na_addr = addr->na_sm_addr;
+#endif
+
+    return na_addr != NULL &&
+           (hg_bulk_op_id->na_addr == na_addr ||
+               NA_Addr_cmp(
+                   hg_bulk_op_id->na_class, hg_bulk_op_id->na_addr, na_addr));
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 hg_bulk_op_pool_create(hg_core_context_t *core_context, unsigned int init_count,
@@ -1772,6 +1828,8 @@ hg_bulk_op_pool_create(hg_core_context_t *core_context, unsigned int init_count,
     hg_bulk_op_pool->core_context = core_context;
     LIST_INIT(&hg_bulk_op_pool->pending_list);
     hg_thread_spin_init(&hg_bulk_op_pool->pending_list_lock);
+    LIST_INIT(&hg_bulk_op_pool->active_list);
+    hg_thread_spin_init(&hg_bulk_op_pool->active_list_lock);
     hg_bulk_op_pool->count = init_count;
     hg_bulk_op_pool->extending = false;
 
@@ -1835,10 +1893,60 @@ hg_bulk_op_pool_destroy(struct hg_bulk_op_pool *hg_bulk_op_pool)
     hg_thread_mutex_destroy(&hg_bulk_op_pool->extend_mutex);
     hg_thread_cond_destroy(&hg_bulk_op_pool->extend_cond);
     hg_thread_spin_destroy(&hg_bulk_op_pool->pending_list_lock);
+    hg_thread_spin_destroy(&hg_bulk_op_pool->active_list_lock);
 
     free(hg_bulk_op_pool);
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+hg_bulk_op_pool_cancel_addr(
+    struct hg_bulk_op_pool *hg_bulk_op_pool, const struct hg_core_addr *addr)
+{
+    struct hg_bulk_op_id *hg_bulk_op_ids[HG_BULK_CANCEL_BATCH];
+    hg_return_t ret = HG_SUCCESS;
+    unsigned int count;
+
+    /* Canceled op IDs are no longer selected, keep going until a pass
+     * leaves room in the batch */
+    do {
+        struct hg_bulk_op_id *hg_bulk_op_id;
+        unsigned int i;
+
+        count = 0;
+        hg_thread_spin_lock(&hg_bulk_op_pool->active_list_lock);
+        LIST_FOREACH (hg_bulk_op_id, &hg_bulk_op_pool->active_list, active) {
+            if (hg_atomic_get32(&hg_bulk_op_id->status) &
+                (HG_BULK_OP_COMPLETED | HG_BULK_OP_CANCELED |
+                    HG_BULK_OP_ERRORED))
+                continue;
+
+            /* Active op IDs hold a reference to their origin addr */
+            if (!hg_bulk_op_match_addr(hg_bulk_op_id, addr))
+                continue;
+
+            /* Active op IDs are not released until completed */
+            hg_atomic_incr32(&hg_bulk_op_id->ref_count);
+            hg_bulk_op_ids[count++] = hg_bulk_op_id;
+            if (count == HG_BULK_CANCEL_BATCH)
+                break;
+        }
+        hg_thread_spin_unlock(&hg_bulk_op_pool->active_list_lock);
+
+        for (i = 0; i < count; i++) {
+            hg_return_t cancel_ret = hg_bulk_cancel(hg_bulk_op_ids[i]);
+            HG_CHECK_SUBSYS_ERROR_DONE(bulk, cancel_ret != HG_SUCCESS,
+                "Could not cancel bulk op ID (%p)", (void *) hg_bulk_op_ids[i]);
+            if (ret == HG_SUCCESS)
+                ret = cancel_ret;
+
+            hg_bulk_op_destroy(hg_bulk_op_ids[i]);
+        }
+    } while (count == HG_BULK_CANCEL_BATCH);
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_bulk_op_pool_get(struct hg_bulk_op_pool *hg_bulk_op_pool,
@@ -1980,6 +2088,8 @@ hg_bulk_transfer(hg_core_context_t *core_context, hg_cb_t callback, void *arg,
         ret = hg_bulk_transfer_self(op, origin_segments, origin_count,
             origin_offset, local_segments, local_count, local_offset, size,
             hg_bulk_op_id);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            bulk, error, ret, "Could not transfer data through self");
     } else {
         struct hg_bulk_na_mem_desc *origin_mem_descs, *local_mem_descs;
         na_mem_handle_t **origin_mem_handles, **local_mem_handles;
@@ -2014,10 +2124,25 @@ hg_bulk_transfer(hg_core_context_t *core_context, hg_cb_t callback, void *arg,
         local_mem_handles =
             HG_BULK_MEM_HANDLES(local_mem_descs, local_count, local_flags);
 
+        /* Track transfer so that it can be canceled with its origin */
+        hg_bulk_op_id->na_addr = na_origin_addr;
+        if (hg_bulk_op_id->op_pool) {
+            hg_core_addr_ref_incr(origin_addr);
+            hg_bulk_op_id->origin_addr = origin_addr;
+            hg_thread_spin_lock(&hg_bulk_op_id->op_pool->active_list_lock);
+            LIST_INSERT_HEAD(
+                &hg_bulk_op_id->op_pool->active_list, hg_bulk_op_id, active);
+            hg_bulk_op_id->tracked = true;
+            hg_thread_spin_unlock(&hg_bulk_op_id->op_pool->active_list_lock);
+        }
+
         ret = hg_bulk_transfer_na(op, na_origin_addr, origin_id,
             origin_segments, origin_count, origin_mem_handles, origin_flags,
             origin_offset, local_segments, local_count, local_mem_handles,
             local_flags, local_offset, size, hg_bulk_op_id);
+        if (ret != HG_SUCCESS)
+            hg_bulk_op_untrack(hg_bulk_op_id);
+        HG_CHECK_SUBSYS_HG_ERROR(bulk, error, ret, "Could not transfer data");
     }
 
     /* Assign op_id */
@@ -2027,8 +2152,11 @@ hg_bulk_transfer(hg_core_context_t *core_context, hg_cb_t callback, void *arg,
     return HG_SUCCESS;
 
 error:
-    if (hg_bulk_op_id)
+    if (hg_bulk_op_id) {
+        (void) hg_bulk_free(hg_bulk_origin);
+        (void) hg_bulk_free(hg_bulk_local);
         hg_bulk_op_destroy(hg_bulk_op_id);
+    }
 
     return ret;
 }
@@ -2431,9 +2559,16 @@ hg_bulk_complete(
     /* Mark op id as completed */
     hg_atomic_or32(&hg_bulk_op_id->status, HG_BULK_OP_COMPLETED);
 
+    /* No longer cancelable by address */
+    hg_bulk_op_untrack(hg_bulk_op_id);
+
     /* Forward status to callback */
     hg_bulk_op_id->callback_info.ret = ret;
 
+    if (ret == HG_SUCCESS)
+        hg_core_stats_bulk(hg_bulk_op_id->core_context,
+            hg_bulk_op_id->callback_info.info.bulk.size, self_notify);
+
     hg_bulk_op_id->hg_completion_entry.op_type = HG_BULK;
     hg_bulk_op_id->hg_completion_entry.op_id.hg_bulk_op_id = hg_bulk_op_id;
 
@@ -2492,6 +2627,23 @@ hg_bulk_trigger_entry(struct hg_bulk_op_id *hg_bulk_op_id)
     if (hg_bulk_op_id->callback)
         hg_bulk_op_id->callback(&hg_bulk_op_id->callback_info);
 
+    hg_bulk_release_entry(hg_bulk_op_id);
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_bulk_get_event(
+    struct hg_bulk_op_id *hg_bulk_op_id, struct hg_cb_event *hg_cb_event)
+{
+    hg_cb_event->callback = hg_bulk_op_id->callback;
+    hg_cb_event->info = hg_bulk_op_id->callback_info;
+    hg_cb_event->op_id = (hg_op_id_t) hg_bulk_op_id;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_bulk_release_entry(struct hg_bulk_op_id *hg_bulk_op_id)
+{
     /* Decrement ref_count */
     (void) hg_bulk_free(hg_bulk_op_id->callback_info.info.bulk.origin_handle);
     (void) hg_bulk_free(hg_bulk_op_id->callback_info.info.bulk.local_handle);
@@ -9,16 +9,19 @@
 #include "mercury_private.h"
 
 #include "mercury_atomic_queue.h"
+#include "mercury_buf_adapt.h"
+#include "mercury_dlog.h"
 #include "mercury_error.h"
 #include "mercury_event.h"
+#include "mercury_hash_string.h"
 #include "mercury_hash_table.h"
+#include "mercury_histogram.h"
 #include "mercury_mem.h"
 #include "mercury_param.h"
 #include "mercury_poll.h"
 #include "mercury_thread_condition.h"
 #include "mercury_thread_mutex.h"
 #include "mercury_thread_pool.h"
-#include "mercury_thread_rwlock.h"
 #include "mercury_thread_spin.h"
 #include "mercury_time.h"
 
@@ -26,8 +29,14 @@
 #    include <na_sm.h>
 #endif
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#ifdef _WIN32
+#    include <process.h>
+#else
+#    include <unistd.h>
+#endif
 
 /****************/
 /* Local Macros */
@@ -36,21 +45,109 @@
 /* Private flags */
 #define HG_CORE_NO_RESPONSE  (1 << 1) /* No response required */
 #define HG_CORE_SELF_FORWARD (1 << 2) /* Forward to self */
-
-/* Size of comletion queue used for holding completed requests */
+#define HG_CORE_BATCH_OUTPUT (1 << 3) /* Response may be coalesced */
+
+/* Priority is sent along with the request flags, a value of zero means that
+ * the origin did not set any priority */
+#define HG_CORE_PRIORITY_SHIFT (4)
+#define HG_CORE_PRIORITY_MASK  (0x3 << HG_CORE_PRIORITY_SHIFT)
+
+/* Number of completions triggered per priority within a drain cycle */
+#define HG_CORE_PRIORITY_WEIGHT_LOW     (1)
+#define HG_CORE_PRIORITY_WEIGHT_DEFAULT (4)
+#define HG_CORE_PRIORITY_WEIGHT_HIGH    (16)
+#define HG_CORE_PRIORITY_CYCLE                                                 \
+    (HG_CORE_PRIORITY_WEIGHT_LOW + HG_CORE_PRIORITY_WEIGHT_DEFAULT +           \
+        HG_CORE_PRIORITY_WEIGHT_HIGH)
+
+/* Initial size of completion queue used for holding completed requests */
 #define HG_CORE_ATOMIC_QUEUE_SIZE (1024)
 
+/* Weight of new samples in average inter-arrival time */
+#define HG_CORE_PROGRESS_SPIN_WEIGHT (0.125)
+
+/* Max number of completion entries popped at once when retrieving events */
+#define HG_CORE_TRIGGER_EVENTS_BATCH (64)
+
 /* Pre-posted requests and op IDs */
 #define HG_CORE_POST_INIT          (512)
 #define HG_CORE_POST_INCR          (512)
 #define HG_CORE_BULK_OP_INIT_COUNT (256)
 
+/* Number of destroyed user handles cached per magazine */
+#define HG_CORE_HANDLE_MAG_SIZE (16)
+
+/* Max number of full magazines kept in the shared depot of a context */
+#define HG_CORE_HANDLE_DEPOT_MAX (8)
+
+/* Initial number of slots in RPC map */
+#define HG_CORE_MAP_INIT_SIZE (64)
+
+/* Number of RPC map lookup counters (power of 2), spread across threads */
+#define HG_CORE_MAP_READERS (8)
+
+/* Multiplier used to derive displaced hashes */
+#define HG_CORE_MAP_GOLDEN UINT64_C(0x9e3779b97f4a7c15)
+
+/* Max displacement tried per bucket and max slots per entry when freezing */
+#define HG_CORE_MAP_DISP_MAX   (1 << 16)
+#define HG_CORE_MAP_FREEZE_MAX (16)
+
+/* Max number of requests coalesced into a single message */
+#define HG_CORE_BATCH_MAX (64)
+
+/* Max number of handles kept for processing coalesced requests */
+#define HG_CORE_BATCH_HANDLE_MAX (256)
+
+/* Number of buckets used for looking up handles waiting for a response (must
+ * be a power of 2) */
+#define HG_CORE_BATCH_OUTPUT_MAP_SIZE (256)
+
+/* Number of buckets used for counting requests per origin (must be a power
+ * of 2), origins that share a bucket share their fair share of requests */
+#define HG_CORE_ADMISSION_ORIGIN_MAX (64)
+
+/* Forward deadlines are kept in a hierarchical timer wheel of 1 ms ticks, each
+ * level has HG_CORE_TIMER_SLOTS slots that cover HG_CORE_TIMER_SLOTS times
+ * the range of the level below, later deadlines wait in the last level */
+#define HG_CORE_TIMER_LEVELS    (4)
+#define HG_CORE_TIMER_SLOT_BITS (6)
+#define HG_CORE_TIMER_SLOTS     (1 << HG_CORE_TIMER_SLOT_BITS)
+#define HG_CORE_TIMER_RANGE                                                    \
+    (UINT64_C(1) << (HG_CORE_TIMER_LEVELS * HG_CORE_TIMER_SLOT_BITS))
+
+/* Request tags are split into ranges, each context allocates its own range
+ * so that tags do not collide between contexts without sharing a counter.
+ * Ranges are only used if each range keeps HG_CORE_REQUEST_TAG_MIN_BITS. */
+#define HG_CORE_REQUEST_TAG_RANGE_BITS (8)
+#define HG_CORE_REQUEST_TAG_RANGES     (1 << HG_CORE_REQUEST_TAG_RANGE_BITS)
+#define HG_CORE_REQUEST_TAG_MIN_BITS   (16)
+
 /* Number of multi-recv buffer pre-posted */
 #define HG_CORE_MULTI_RECV_OP_COUNT (4)
 
+/* Adaptive multi-recv: default max number of buffers, min number of buffers
+ * kept and max growth factor of buffer size */
+#define HG_CORE_MULTI_RECV_ADAPT_OP_MAX      (16)
+#define HG_CORE_MULTI_RECV_ADAPT_OP_MIN      (2)
+#define HG_CORE_MULTI_RECV_ADAPT_SIZE_FACTOR (8)
+
+/* Arena chunk size when hugepage size is unknown, number of distinct buffer
+ * sizes served by an arena (larger buffers are allocated individually) */
+#define HG_CORE_ARENA_CHUNK_SIZE (2 * 1024 * 1024)
+#define HG_CORE_ARENA_SIZES      (4)
+
+/* Number of trace records kept per thread and max number of running threads
+ * that record */
+#define HG_CORE_TRACE_RING_SIZE  (8192)
+#define HG_CORE_TRACE_THREAD_MAX (64)
+
 /* Timeout on finalize */
 #define HG_CORE_CLEANUP_TIMEOUT (5000)
 
+/* Number of handles canceled per pass when canceling by address */
+#define HG_CORE_CANCEL_BATCH (64)
+
 /* Max number of events for progress */
 #define HG_CORE_MAX_EVENTS (1)
 
@@ -70,6 +167,7 @@
 #define HG_CORE_HANDLE_MULTI_RECV      (1 << 2) /* Handle used for multi-recv */
 #define HG_CORE_HANDLE_USER            (1 << 3) /* User-created handle */
 #define HG_CORE_HANDLE_MULTI_RECV_COPY (1 << 4) /* Copy on multi-recv */
+#define HG_CORE_HANDLE_BATCH           (1 << 5) /* Coalesced request handle */
 
 /* Op status bits */
 #define HG_CORE_OP_COMPLETED  (1 << 0) /* Operation completed */
@@ -78,6 +176,7 @@
 #define HG_CORE_OP_ERRORED    (1 << 3) /* Operation encountered error */
 #define HG_CORE_OP_QUEUED     (1 << 4) /* Operation queued into CQ */
 #define HG_CORE_OP_MULTI_RECV (1 << 5) /* Operation uses multi-recv */
+#define HG_CORE_OP_BATCHED    (1 << 6) /* Output received in a batch */
 
 /* Encode type */
 #define HG_CORE_TYPE_ENCODE(                                                   \
@@ -120,6 +219,8 @@
 #define HG_CORE_HANDLE_CONTEXT(handle)                                         \
     ((struct hg_core_private_context *) (handle->core_handle.info.context))
 
+#define HG_CORE_HANDLE_STATS(handle) (HG_CORE_HANDLE_CONTEXT(handle)->stats)
+
 #define HG_CORE_ADDR_CLASS(addr)                                               \
     ((struct hg_core_private_class *) (addr->core_addr.core_class))
 
@@ -138,18 +239,63 @@ struct hg_core_init_info {
     uint32_t request_post_incr;         /* Increment request count */
     uint32_t multi_recv_op_max;         /* Multi-recv op max */
     uint32_t multi_recv_copy_threshold; /* Copy threshold */
+    uint32_t completion_queue_size;     /* Initial completion queue size */
+    uint32_t progress_spin_max;         /* Max spin time before blocking */
     hg_checksum_level_t checksum_level; /* Checksum level */
     uint8_t progress_mode;              /* Progress mode */
     bool loopback;                      /* Use loopback capability */
     bool na_ext_init;                   /* NA externally initialized */
     bool multi_recv;                    /* Use multi-recv capability */
+    bool multi_recv_adaptive;           /* Adapt multi-recv buffers */
+    bool hugepage_arena;                /* Hugepage-backed msg buffers */
     bool listen;                        /* Listening on incoming RPC requests */
+    bool stats;                         /* Collect RPC latency histograms */
+    bool coalesce_requests;             /* Coalesce RPC requests */
+    bool coalesce_responses;            /* Coalesce RPC responses */
+    uint32_t request_max;               /* Max requests in process */
+    uint32_t request_trim_time;         /* Idle time before pool trim */
+};
+
+/* RPC map table (slots are only added in place when not frozen) */
+struct hg_core_map_table {
+    uint32_t *disp;            /* Bucket displacements (frozen only) */
+    uint64_t disp_mask;        /* Displacement bucket mask */
+    unsigned int shift;        /* Shift of hash to get slot index */
+    unsigned int size;         /* Number of slots (power of 2) */
+    unsigned int count;        /* Number of entries */
+    hg_atomic_int64_t slots[]; /* RPC info pointers */
 };
 
-/* RPC map */
+/* RPC latency histograms (in ns) */
+struct hg_core_rpc_hist {
+    struct hg_histogram forward; /* Forward to forward callback */
+    struct hg_histogram handler; /* RPC callback to respond completion */
+};
+
+/* RPC map entry */
+struct hg_core_map_entry {
+    struct hg_core_rpc_info rpc_info; /* Must remain as first field */
+    struct hg_core_rpc_hist *hist;    /* Latency histograms (stats only) */
+};
+
+/* RPC map lookups in progress, indexed by epoch parity */
+struct hg_core_map_readers {
+    HG_UTIL_ALIGNED(hg_atomic_int32_t count[2], HG_MEM_CACHE_LINE_SIZE);
+};
+
+/* RPC map (replaced tables and removed entries are freed by updates once
+ * lookups counted in readers that may still read them have completed) */
 struct hg_core_map {
-    hg_thread_rwlock_t lock; /* Map RW lock */
-    hg_hash_table_t *map;    /* Map */
+    struct hg_core_map_readers readers[HG_CORE_MAP_READERS];
+    hg_thread_mutex_t lock;  /* Serialize updates */
+    hg_atomic_int64_t table; /* Current table */
+    hg_atomic_int32_t epoch; /* Selects counters of new lookups */
+};
+
+/* Addresses returned by batch lookups, indexed by lookup name */
+struct hg_core_addr_map {
+    hg_thread_mutex_t lock; /* Map lock */
+    hg_hash_table_t *map;   /* Name to addr map */
 };
 
 /* More data callbacks */
@@ -168,6 +314,16 @@ struct hg_core_counters {
     hg_atomic_int64_t *rpc_req_extra_count;  /* RPC that require extra data */
     hg_atomic_int64_t *rpc_resp_extra_count; /* RPC that require extra data */
     hg_atomic_int64_t *bulk_count;           /* Bulk count */
+    hg_atomic_int64_t *progress_spin_count;  /* Progressed while spinning */
+    hg_atomic_int64_t *progress_block_count; /* Progressed after blocking */
+};
+
+/* List of contexts */
+struct hg_core_context_list {
+    LIST_HEAD(, hg_core_private_context) list; /* Context list */
+    struct hg_stats retired;                   /* Destroyed context stats */
+    uint64_t tag_ranges[HG_CORE_REQUEST_TAG_RANGES / 64]; /* Used tag ranges */
+    hg_thread_spin_t lock;                                /* Context list lock */
 };
 
 /* HG class */
@@ -178,8 +334,12 @@ struct hg_core_private_class {
     na_sm_id_t host_id; /* Host ID for local identification */
 #endif
     struct hg_core_map rpc_map;               /* RPC Map */
+    struct hg_core_addr_map addr_map;         /* Addr map (batch lookups) */
     struct hg_core_more_data_cb more_data_cb; /* More data callbacks */
+    struct hg_core_context_list context_list; /* Contexts (for stats) */
+    struct hg_core_trace *trace;              /* Handle tracer */
     na_tag_t request_max_tag;                 /* Max value for tag */
+    unsigned int request_tag_shift;           /* Tag range shift (0 if none) */
 #if defined(HG_HAS_DEBUG) && !defined(_WIN32)
     struct hg_core_counters counters; /* Diag counters */
 #endif
@@ -198,12 +358,13 @@ enum hg_core_poll_type {
     HG_CORE_POLL_NA
 };
 
-/* Completion queue */
-struct hg_core_completion_queue {
-    STAILQ_HEAD(, hg_completion_entry) queue; /* Completion queue */
-    hg_thread_cond_t cond;                    /* Completion queue cond */
-    hg_thread_mutex_t mutex;                  /* Completion queue mutex */
-    hg_atomic_int32_t count;                  /* Number of entries */
+/* Completion queue wait */
+struct hg_core_completion_cond {
+    STAILQ_HEAD(, hg_completion_entry) overflow; /* Entries not queued */
+    hg_thread_cond_t cond;                       /* Completion queue cond */
+    hg_thread_mutex_t mutex;                     /* Completion queue mutex */
+    hg_atomic_int32_t waiters;                   /* Number of waiters */
+    hg_atomic_int32_t overflow_count;            /* Number of overflow entries */
 };
 
 /* List of handles */
@@ -234,11 +395,95 @@ struct hg_core_multi_recv_op {
     void *plugin_data;                       /* NA plugin data */
     na_op_id_t *op_id;                       /* NA operation ID */
     unsigned int id;                         /* ID for that op */
+    hg_time_t post_time;                     /* Time buffer was posted */
+    hg_time_t consume_time;                  /* Time buffer was consumed */
     hg_atomic_int32_t last;                  /* Buffer is consumed */
     hg_atomic_int32_t ref_count; /* Number of handles using that buffer */
     hg_atomic_int32_t op_count;  /* Total number of ops completed */
 };
 
+/* Adaptive multi-recv state */
+struct hg_core_multi_recv_adapt {
+    hg_thread_mutex_t mutex;  /* Lock */
+    struct hg_buf_adapt bufs; /* Number and size of buffers */
+};
+
+/* Freed arena buffer, kept in the buffer itself */
+struct hg_core_arena_buf {
+    struct hg_core_arena_buf *next; /* Next free buffer of same size */
+};
+
+/* Arena chunk, registered once as a single message buffer */
+struct hg_core_arena_chunk {
+    struct hg_core_arena_buf *free_list[HG_CORE_ARENA_SIZES]; /* Free bufs */
+    char *buf;         /* Chunk buffer */
+    void *plugin_data; /* NA plugin data of chunk */
+    size_t used;       /* Bytes carved out */
+    unsigned int busy; /* Number of buffers handed out */
+};
+
+/* Arena of message buffers for a given NA class */
+struct hg_core_arena {
+    size_t sizes[HG_CORE_ARENA_SIZES];  /* Buffer sizes */
+    hg_thread_mutex_t mutex;            /* Lock */
+    struct hg_core_arena_chunk *chunks; /* Chunks */
+    na_class_t *na_class;               /* NA class */
+    size_t chunk_size;                  /* Chunk size */
+    unsigned int chunk_count;           /* Number of chunks */
+};
+
+/* Coalesced requests sent to the same target */
+struct hg_core_batch {
+    LIST_ENTRY(hg_core_batch) entry; /* Open / free list entry */
+    struct hg_core_private_handle
+        *handles[HG_CORE_BATCH_MAX];         /* Coalesced handles */
+    struct hg_core_private_context *context; /* Context */
+    na_class_t *na_class;                    /* NA class */
+    na_context_t *na_context;                /* NA context */
+    na_addr_t *na_addr;                      /* Target NA addr */
+    void *buf;                               /* Message buffer */
+    void *plugin_data;                       /* NA plugin data */
+    na_op_id_t *op_id;                       /* NA operation ID */
+    size_t buf_size;                         /* Message buffer size */
+    size_t buf_used;                         /* Amount of buffer used */
+    size_t header_offset;                    /* NA header offset */
+    unsigned int count;                      /* Number of handles */
+    uint8_t context_id;                      /* Target context ID */
+    bool output;                             /* Batch of responses */
+};
+
+/* Batches of coalesced requests / responses */
+struct hg_core_batch_list {
+    LIST_HEAD(, hg_core_batch) open_list; /* Batches being filled */
+    LIST_HEAD(, hg_core_batch) free_list; /* Batches that can be re-used */
+    LIST_HEAD(, hg_core_private_handle) handle_list; /* Released handles */
+    LIST_HEAD(, hg_core_private_handle)
+    output_map[HG_CORE_BATCH_OUTPUT_MAP_SIZE]; /* Handles waiting for output */
+    hg_thread_mutex_t mutex;      /* Batch list mutex */
+    hg_thread_spin_t output_lock; /* Output map lock */
+    hg_atomic_int32_t open_count; /* Number of open batches */
+    hg_atomic_int32_t live_count; /* Number of handles in use */
+    unsigned int handle_count;    /* Number of released handles */
+};
+
+/* Requests being processed, only used when request_max is set */
+struct hg_core_admission {
+    hg_atomic_int32_t origin_counts
+        [HG_CORE_ADMISSION_ORIGIN_MAX]; /* Requests per origin bucket */
+    hg_atomic_int32_t count;            /* Requests being processed */
+    hg_atomic_int32_t origin_count;     /* Origin buckets in use */
+};
+
+/* Timer wheel of forwarded handles that have a deadline */
+struct hg_core_timer_wheel {
+    LIST_HEAD(, hg_core_private_handle)
+    slots[HG_CORE_TIMER_LEVELS][HG_CORE_TIMER_SLOTS]; /* Armed handles */
+    unsigned int level_counts[HG_CORE_TIMER_LEVELS];   /* Handles per level */
+    uint64_t now;            /* Last tick processed */
+    hg_thread_mutex_t mutex; /* Wheel mutex */
+    hg_atomic_int32_t count; /* Number of armed handles */
+};
+
 /* Pool of handles */
 struct hg_core_handle_pool {
     hg_thread_mutex_t extend_mutex;          /* To extend pool */
@@ -248,11 +493,84 @@ struct hg_core_handle_pool {
     na_class_t *na_class;                    /* NA class */
     na_context_t *na_context;                /* NA context */
     struct hg_core_handle_list pending_list; /* Pending handle list */
+    uint64_t trim_time;                      /* Next trim check (ms) */
     unsigned int count;                      /* Number of handles */
+    unsigned int init_count;                 /* Count never trimmed */
     unsigned int incr_count;                 /* Incremement count */
+    unsigned int pending_count;              /* Handles in pending list */
+    unsigned int pending_min;                /* Min pending since trim */
     bool extending;                          /* When extending the pool */
 };
 
+/* Magazine of destroyed user handles kept for re-use */
+struct hg_core_handle_mag {
+    LIST_ENTRY(hg_core_handle_mag) entry; /* Depot list entry */
+    struct hg_core_private_handle
+        *handles[HG_CORE_HANDLE_MAG_SIZE]; /* Cached handles */
+    unsigned int count;                    /* Number of cached handles */
+};
+
+/* Per-thread pair of magazines */
+struct hg_core_handle_cache {
+    LIST_ENTRY(hg_core_handle_cache) entry; /* Depot cache list entry */
+    struct hg_core_handle_depot *depot;     /* Depot the cache belongs to */
+    struct hg_core_handle_mag *loaded;      /* Magazine in use */
+    struct hg_core_handle_mag *previous;    /* Previously used magazine */
+};
+
+/* Magazines shared between threads of a context */
+struct hg_core_handle_depot {
+    LIST_HEAD(, hg_core_handle_mag) full_list;    /* Full magazines */
+    LIST_HEAD(, hg_core_handle_mag) empty_list;   /* Empty magazines */
+    LIST_HEAD(, hg_core_handle_cache) cache_list; /* Per-thread caches */
+    hg_thread_key_t cache_key;                    /* Per-thread cache key */
+    hg_thread_spin_t lock;                        /* Depot lock */
+    unsigned int full_count;                      /* Number of full mags */
+    bool finalized;                               /* Depot is finalized */
+};
+
+/* Adaptive spin before blocking, spinning is not serialized between threads
+ * that progress the context, estimates are therefore updated atomically */
+struct hg_core_progress_spin {
+    hg_time_t start;            /* Reference time (read-only) */
+    hg_atomic_int64_t last;     /* Time of last completion since start (ns) */
+    hg_atomic_int64_t interval; /* Average inter-arrival time (ns) */
+    int64_t max;                /* Max spin time (ns, read-only) */
+};
+
+/* Stats counters (see struct hg_stats) */
+struct hg_core_stats_counters {
+    hg_atomic_int64_t rpc_req_sent;         /* RPC requests sent */
+    hg_atomic_int64_t rpc_req_recv;         /* RPC requests received */
+    hg_atomic_int64_t rpc_resp_sent;        /* RPC responses sent */
+    hg_atomic_int64_t rpc_resp_recv;        /* RPC responses received */
+    hg_atomic_int64_t rpc_req_extra;        /* RPC requests with overflow */
+    hg_atomic_int64_t rpc_resp_extra;       /* RPC responses with overflow */
+    hg_atomic_int64_t msg_bytes_sent;       /* Bytes sent in RPC messages */
+    hg_atomic_int64_t msg_bytes_recv;       /* Bytes received in RPC messages */
+    hg_atomic_int64_t bulk_count;           /* Bulk transfers completed */
+    hg_atomic_int64_t bulk_bytes;           /* Bytes moved by bulk transfers */
+    hg_atomic_int64_t multi_recv_copy;      /* Multi-recv payloads copied */
+    hg_atomic_int64_t multi_recv_exhausted; /* All buffers consumed */
+    hg_atomic_int64_t multi_recv_resize;    /* Multi-recv buffers resized */
+    hg_atomic_int64_t retry;                /* Sends that must be retried */
+    hg_atomic_int64_t rpc_req_busy;         /* RPC requests rejected */
+    hg_atomic_int64_t rpc_req_unfair;       /* RPC requests rejected (origin) */
+    hg_atomic_int64_t rpc_req_timeout;      /* RPC requests past deadline */
+    hg_atomic_int64_t handle_pool_grow;     /* Handle pools extended */
+    hg_atomic_int64_t handle_pool_shrink;   /* Handle pools trimmed */
+    hg_atomic_int64_t progress_spin;        /* Progressed while spinning */
+    hg_atomic_int64_t progress_block;       /* Progressed after blocking */
+};
+
+/* Context stats, counters updated from NA callbacks are only written by the
+ * thread making progress and do not require atomic read-modify-write */
+struct hg_core_context_stats {
+    struct hg_core_stats_counters progress; /* Written while progressing */
+    HG_UTIL_ALIGNED(struct hg_core_stats_counters shared,
+        HG_MEM_CACHE_LINE_SIZE); /* Written from any thread */
+};
+
 #ifdef HG_HAS_MULTI_PROGRESS
 /* Ensure thread safety when progressing context from multiple threads */
 struct hg_core_progress_multi {
@@ -265,27 +583,45 @@ struct hg_core_progress_multi {
 /* HG context */
 struct hg_core_private_context {
     struct hg_core_context core_context; /* Must remain as first field */
+    LIST_ENTRY(hg_core_private_context) entry; /* Class context list entry */
+    struct hg_core_context_stats *stats;       /* Context stats */
 #ifdef HG_HAS_MULTI_PROGRESS
     struct hg_core_progress_multi progress_multi; /* Progress multi */
 #endif
-    struct hg_core_completion_queue backfill_queue; /* Backfill queue */
-    struct hg_atomic_queue *completion_queue;       /* Default queue */
+    struct hg_core_completion_cond completion_cond; /* Completion wait */
+    struct hg_atomic_seg_queue
+        *completion_queues[HG_PRIORITY_MAX];        /* Queues per priority */
+    struct hg_core_progress_spin progress_spin;     /* Adaptive spin */
     struct hg_core_loopback_notify loopback_notify; /* Loopback notification */
     struct hg_core_handle_list user_list;           /* Created handle list */
     struct hg_core_handle_list internal_list;       /* Created handle list */
     struct hg_core_handle_pool *handle_pool;        /* Pool of handles */
+    struct hg_core_handle_depot handle_depot;       /* User handle cache */
+    struct hg_core_batch_list batch_list;           /* Coalesced requests */
+    struct hg_core_admission admission;             /* Admission control */
+    struct hg_core_timer_wheel timer_wheel;         /* Forward deadlines */
 #ifdef NA_HAS_SM
     struct hg_core_handle_pool *sm_handle_pool; /* Pool of SM handles */
 #endif
     struct hg_core_multi_recv_op *multi_recv_ops;     /* Multi-recv ops */
+    struct hg_core_multi_recv_adapt *multi_recv_adapt; /* Adaptive state */
     struct hg_core_handle_create_cb handle_create_cb; /* Handle create cb */
     struct hg_bulk_op_pool *hg_bulk_op_pool;          /* Pool of op IDs */
+    struct hg_core_arena *arena;                      /* Msg buffer arena */
+#ifdef NA_HAS_SM
+    struct hg_core_arena *sm_arena; /* SM msg buffer arena */
+#endif
     struct hg_poll_set *poll_set;                     /* Poll set */
     int na_event;                                     /* NA event */
 #ifdef NA_HAS_SM
     int na_sm_event; /* NA SM event */
 #endif
+    hg_atomic_int32_t request_tag;         /* Current RPC tag in range */
+    int request_tag_range;                 /* Tag range (-1 for class tags) */
+    int numa_node;                         /* NUMA node (-1 for none) */
+    hg_atomic_int32_t completion_ticket;   /* Weighted drain position */
     hg_atomic_int32_t multi_recv_op_count; /* Number of multi-recv posted */
+    hg_atomic_int32_t multi_recv_copy_threshold; /* Copy threshold */
     hg_atomic_int32_t n_handles;           /* Number of handles */
     hg_atomic_int32_t unposting;           /* Prevent re-posting handles */
     bool posted;                           /* Posted receives on context */
@@ -299,6 +635,7 @@ struct hg_core_private_addr {
     size_t na_sm_addr_serialize_size; /* Cached serialization size */
     na_sm_id_t host_id;               /* NA SM Host ID */
 #endif
+    char *lookup_name;           /* Key in addr map if any */
     hg_atomic_int32_t ref_count; /* Reference count */
 };
 
@@ -312,6 +649,27 @@ struct hg_core_private_addr {
 enum hg_core_op_type { HG_CORE_OP_TYPE };
 #undef X
 
+/* Handle lifecycle events */
+#define HG_CORE_TRACE_EVENT                                                    \
+    X(HG_CORE_TRACE_FORWARD)     /*!< Forward issued */                        \
+    X(HG_CORE_TRACE_SEND_INPUT)  /*!< Input sent */                            \
+    X(HG_CORE_TRACE_RECV_INPUT)  /*!< Input received */                        \
+    X(HG_CORE_TRACE_PROCESS)     /*!< RPC callback started */                  \
+    X(HG_CORE_TRACE_RESPOND)     /*!< Respond issued */                        \
+    X(HG_CORE_TRACE_RECV_OUTPUT) /*!< Output received */                       \
+    X(HG_CORE_TRACE_TRIGGER)     /*!< Completion callback triggered */
+
+#define X(a) a,
+enum hg_core_trace_event { HG_CORE_TRACE_EVENT };
+#undef X
+
+/* Handle lifecycle tracer, records hold the RPC ID and an event argument (op
+ * type of triggers) */
+struct hg_core_trace {
+    struct hg_dlog_rec *rec; /* Per-thread rings */
+    char *file;              /* File written on finalize */
+};
+
 /* HG core operations */
 struct hg_core_ops {
     hg_return_t (*forward)(
@@ -327,6 +685,8 @@ struct hg_core_private_handle {
     struct hg_completion_entry hg_completion_entry; /* Completion queue entry */
     LIST_ENTRY(hg_core_private_handle) created;     /* Created list entry */
     LIST_ENTRY(hg_core_private_handle) pending;     /* Pending list entry */
+    LIST_ENTRY(hg_core_private_handle) output;      /* Output map entry */
+    LIST_ENTRY(hg_core_private_handle) timer;       /* Timer wheel entry */
     struct hg_core_header in_header;                /* Input header */
     struct hg_core_header out_header;               /* Output header */
     struct hg_core_handle_list *created_list;       /* Created list */
@@ -357,13 +717,22 @@ struct hg_core_private_handle {
     hg_atomic_int32_t ret_status;       /* Handle return status */
     hg_atomic_int32_t op_completed_count; /* Completed operation count */
     hg_atomic_int32_t
-        op_expected_count;        /* Expected operation count for completion */
-    hg_atomic_int32_t flags;      /* Flags */
-    enum hg_core_op_type op_type; /* Core operation type */
-    hg_return_t ret;              /* Return code associated to handle */
-    uint8_t cookie;               /* Cookie */
-    bool multi_recv_copy;         /* Copy on multi-recv */
-    bool reuse;                   /* Re-use handle once ref_count is 0 */
+        op_expected_count;         /* Expected operation count for completion */
+    hg_atomic_int32_t flags;       /* Flags */
+    hg_atomic_int32_t timer_armed; /* Forward deadline is armed */
+    enum hg_core_op_type op_type;  /* Core operation type */
+    hg_time_t forward_time;        /* Forward start time (stats only) */
+    hg_time_t process_time;        /* RPC callback start time (stats only) */
+    uint64_t timer_expiry;         /* Forward deadline (timer wheel ticks) */
+    hg_return_t ret;               /* Return code associated to handle */
+    unsigned int admission_slot;   /* Origin bucket + 1 (0 if not admitted) */
+    unsigned int timer_level;      /* Timer wheel level */
+    uint8_t cookie;                /* Cookie */
+    bool multi_recv_copy;          /* Copy on multi-recv */
+    bool busy;                     /* Request rejected by admission control */
+    bool reuse;                    /* Re-use handle once ref_count is 0 */
+    bool batch;                    /* Handle of a coalesced request */
+    bool batch_output;             /* Handle is in output map */
 };
 
 /* HG op id */
@@ -402,11 +771,99 @@ static void
 hg_core_counters_init(struct hg_core_counters *hg_core_counters);
 #endif
 
+/**
+ * Add value to stats counter that is only written by the thread making
+ * progress.
+ */
+static HG_INLINE void
+hg_core_stats_add(hg_atomic_int64_t *counter, int64_t value);
+
+/**
+ * Add value to stats counter that may be written from any thread.
+ */
+static HG_INLINE void
+hg_core_stats_add_shared(hg_atomic_int64_t *counter, int64_t value);
+
+/**
+ * Accumulate context stats.
+ */
+static void
+hg_core_context_stats_sum(
+    const struct hg_core_private_context *context, struct hg_stats *stats);
+
+/**
+ * Get latency histograms of the RPC associated to handle.
+ */
+static HG_INLINE struct hg_core_rpc_hist *
+hg_core_rpc_hist_get(const struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Record time elapsed since start into histogram.
+ */
+static HG_INLINE void
+hg_core_rpc_hist_record(struct hg_histogram *hg_histogram, hg_time_t start);
+
+/**
+ * Summarize histogram.
+ */
+static void
+hg_core_rpc_hist_summary(
+    const struct hg_histogram *hg_histogram, struct hg_latency *latency);
+
+/**
+ * Print latency summary of registered RPCs.
+ */
+static void
+hg_core_rpc_hist_dump(struct hg_core_map *hg_core_map);
+
+/**
+ * Create handle tracer, file is kept to write the trace on finalize.
+ */
+static hg_return_t
+hg_core_trace_create(const char *file, struct hg_core_trace **trace_p);
+
+/**
+ * Destroy handle tracer.
+ */
+static void
+hg_core_trace_destroy(struct hg_core_trace *trace);
+
+/**
+ * Record handle event if tracing is enabled.
+ */
+static HG_INLINE void
+hg_core_trace_event(struct hg_core_private_handle *hg_core_handle,
+    enum hg_core_trace_event event, uint32_t arg);
+
+/**
+ * Sort trace records by handle and time.
+ */
+static int
+hg_core_trace_record_cmp(const void *a, const void *b);
+
+/**
+ * Write trace as Chrome trace event JSON.
+ */
+static hg_return_t
+hg_core_trace_dump(struct hg_core_trace *trace, const char *file);
+
 /**
  * Generate a new tag.
  */
 static HG_INLINE na_tag_t
-hg_core_gen_request_tag(struct hg_core_private_class *hg_core_class);
+hg_core_gen_request_tag(struct hg_core_private_context *context);
+
+/**
+ * Allocate a request tag range for context (class lock must be held).
+ */
+static void
+hg_core_tag_range_alloc(struct hg_core_private_context *context);
+
+/**
+ * Release request tag range of context (class lock must be held).
+ */
+static void
+hg_core_tag_range_free(struct hg_core_private_context *context);
 
 /**
  * Proc request header and verify it if decoded.
@@ -441,7 +898,19 @@ hg_core_finalize(struct hg_core_private_class *hg_core_class);
  */
 static hg_return_t
 hg_core_context_create(struct hg_core_private_class *hg_core_class, uint8_t id,
-    struct hg_core_private_context **context_p);
+    int numa_node, struct hg_core_private_context **context_p);
+
+/**
+ * Prefer allocating memory on NUMA node until hg_core_numa_leave() is called.
+ */
+static bool
+hg_core_numa_enter(int numa_node, struct hg_mem_numa_policy *prev_policy);
+
+/**
+ * Restore memory policy saved by hg_core_numa_enter().
+ */
+static void
+hg_core_numa_leave(bool entered, const struct hg_mem_numa_policy *prev_policy);
 
 /**
  * Destroy context.
@@ -462,6 +931,12 @@ static hg_return_t
 hg_core_context_unpost(
     struct hg_core_private_context *context, unsigned int timeout_ms);
 
+/**
+ * Release posted requests that remained unused.
+ */
+static void
+hg_core_context_trim(struct hg_core_private_context *context);
+
 /**
  * Allocate multi-recv resources.
  */
@@ -525,1656 +1000,4713 @@ static HG_INLINE bool
 hg_core_handle_pool_empty(struct hg_core_handle_pool *hg_core_handle_pool);
 
 /**
- * Get handle from pool and extend pool if needed.
+ * Get handle from pool and extend pool if needed. Returns HG_BUSY if the pool
+ * is empty and already holds request_max handles.
  */
 static hg_return_t
 hg_core_handle_pool_get(struct hg_core_handle_pool *hg_core_handle_pool,
     struct hg_core_private_handle **hg_core_handle_p);
 
 /**
- * Extend pool of handles with incr_count handles.
+ * Create handle that is not part of the pool and only used to reject a
+ * request received while all request_max handles of the pool are in use.
  */
 static hg_return_t
-hg_core_handle_pool_extend(struct hg_core_handle_pool *hg_core_handle_pool);
+hg_core_handle_pool_get_busy(struct hg_core_handle_pool *hg_core_handle_pool,
+    struct hg_core_private_handle **hg_core_handle_p);
 
 /**
- * Create and insert new handle into pool.
+ * Check whether pool of handles may be extended.
  */
-static hg_return_t
-hg_core_handle_pool_insert(struct hg_core_private_context *context,
-    na_class_t *na_class, na_context_t *na_context, unsigned long flags,
-    struct hg_core_handle_pool *hg_core_handle_pool);
+static HG_INLINE bool
+hg_core_handle_pool_extendable(
+    const struct hg_core_handle_pool *hg_core_handle_pool);
 
 /**
- * Cancel pending operations on pool until pending list is empty.
+ * Extend pool of handles with incr_count handles, without exceeding
+ * request_max handles.
  */
 static hg_return_t
-hg_core_handle_pool_unpost(
-    struct hg_core_handle_pool *hg_core_handle_pool, unsigned int timeout_ms);
-
-/**
- * Hash map keys based on RPC ID.
- */
-static HG_INLINE unsigned int
-hg_core_map_hash(hg_hash_table_key_t key);
-
-/**
- * Determine if map keys are equal using RPC ID.
- */
-static HG_INLINE int
-hg_core_map_equal(hg_hash_table_key_t key1, hg_hash_table_key_t key2);
+hg_core_handle_pool_extend(struct hg_core_handle_pool *hg_core_handle_pool);
 
 /**
- * Free value in map.
+ * Shrink pool of handles when handles remained unused since last check.
  */
 static void
-hg_core_map_value_free(hg_hash_table_value_t value);
+hg_core_handle_pool_trim(
+    struct hg_core_handle_pool *hg_core_handle_pool, uint32_t trim_time);
 
 /**
- * Lookup entry for RPC ID.
+ * Add handle to pending list of pool.
  */
-static HG_INLINE struct hg_core_rpc_info *
-hg_core_map_lookup(struct hg_core_map *hg_core_map, hg_id_t *id);
+static HG_INLINE void
+hg_core_handle_pool_push(struct hg_core_handle_pool *hg_core_handle_pool,
+    struct hg_core_private_handle *hg_core_handle);
 
 /**
- * Insert new entry for RPC ID.
+ * Remove handle from pending list of pool.
  */
-static hg_return_t
-hg_core_map_insert(struct hg_core_map *hg_core_map, hg_id_t *id,
-    struct hg_core_rpc_info **hg_core_rpc_info_p);
+static HG_INLINE void
+hg_core_handle_pool_remove(struct hg_core_handle_pool *hg_core_handle_pool,
+    struct hg_core_private_handle *hg_core_handle);
 
 /**
- * Remove entry for RPC ID.
+ * Create and insert new handle into pool.
  */
 static hg_return_t
-hg_core_map_remove(struct hg_core_map *hg_core_map, hg_id_t *id);
+hg_core_handle_pool_insert(struct hg_core_private_context *context,
+    na_class_t *na_class, na_context_t *na_context, unsigned long flags,
+    struct hg_core_handle_pool *hg_core_handle_pool);
 
 /**
- * Lookup addr.
+ * Cancel pending operations on pool until pending list is empty.
  */
 static hg_return_t
-hg_core_addr_lookup(struct hg_core_private_class *hg_core_class,
-    const char *name, struct hg_core_private_addr **addr_p);
+hg_core_handle_pool_unpost(
+    struct hg_core_handle_pool *hg_core_handle_pool, unsigned int timeout_ms);
 
 /**
- * Create addr.
+ * Initialize depot of user handle magazines.
  */
 static hg_return_t
-hg_core_addr_create(struct hg_core_private_class *hg_core_class,
-    struct hg_core_private_addr **hg_core_private_addr_p);
+hg_core_handle_depot_init(struct hg_core_handle_depot *hg_core_handle_depot);
 
 /**
- * Free addr.
+ * Free depot and all per-thread magazines along with cached handles.
  */
 static void
-hg_core_addr_free(struct hg_core_private_addr *hg_core_addr);
+hg_core_handle_depot_finalize(
+    struct hg_core_handle_depot *hg_core_handle_depot);
 
 /**
- * Free NA addr.
+ * Free magazine and cached handles.
  */
 static void
-hg_core_addr_free_na(struct hg_core_private_addr *hg_core_addr);
+hg_core_handle_mag_free(struct hg_core_handle_mag *hg_core_handle_mag);
 
 /**
- * Set addr to be removed.
+ * Get per-thread magazines, create them if needed.
  */
-static hg_return_t
-hg_core_addr_set_remove(struct hg_core_private_addr *hg_core_addr);
+static struct hg_core_handle_cache *
+hg_core_handle_cache_get(struct hg_core_handle_depot *hg_core_handle_depot);
 
 /**
- * Self addr.
+ * Return magazines of an exiting thread to the depot (key destructor).
  */
-static hg_return_t
-hg_core_addr_self(struct hg_core_private_class *hg_core_class,
-    struct hg_core_private_addr **hg_core_addr_p);
+static void
+hg_core_handle_cache_release(void *arg);
 
 /**
- * Dup addr.
+ * Pop handle from per-thread magazines, refill from depot if needed.
  */
-static hg_return_t
-hg_core_addr_dup(struct hg_core_private_addr *hg_core_addr,
-    struct hg_core_private_addr **hg_core_addr_p);
+static struct hg_core_private_handle *
+hg_core_handle_cache_pop(struct hg_core_handle_depot *hg_core_handle_depot);
 
 /**
- * Compare two addresses.
+ * Push destroyed user handle to per-thread magazines, returns false if the
+ * handle cannot be cached and must be freed.
  */
 static bool
-hg_core_addr_cmp(
-    struct hg_core_private_addr *addr1, struct hg_core_private_addr *addr2);
+hg_core_handle_cache_push(struct hg_core_private_handle *hg_core_handle);
 
 /**
- * Convert addr to string.
+ * Initialize RPC map.
  */
 static hg_return_t
-hg_core_addr_to_string(
-    char *buf, hg_size_t *buf_size, struct hg_core_private_addr *hg_core_addr);
+hg_core_map_init(struct hg_core_map *hg_core_map);
 
 /**
- * Get serialize size.
+ * Free RPC map and all registered entries.
  */
-static hg_size_t
-hg_core_addr_get_serialize_size(
-    struct hg_core_private_addr *hg_core_addr, uint8_t flags);
+static void
+hg_core_map_finalize(struct hg_core_map *hg_core_map);
 
 /**
- * Serialize core address.
+ * Mix bits of RPC ID.
  */
-static hg_return_t
-hg_core_addr_serialize(void *buf, hg_size_t buf_size, uint8_t flags,
-    struct hg_core_private_addr *hg_core_addr);
+static HG_INLINE uint64_t
+hg_core_map_mix(uint64_t x);
 
 /**
- * Deserialize core address.
+ * Get slot index of RPC ID.
  */
-static hg_return_t
-hg_core_addr_deserialize(struct hg_core_private_class *hg_core_class,
-    struct hg_core_private_addr **hg_core_addr_p, const void *buf,
-    hg_size_t buf_size);
+static HG_INLINE unsigned int
+hg_core_map_index(const struct hg_core_map_table *table, hg_id_t id);
 
 /**
- * Determine which NA component should be used.
+ * Allocate table of size slots (power of 2) and disp_count displacements.
  */
-static hg_return_t
-hg_core_resolve_na(struct hg_core_private_context *context,
-    struct hg_core_private_addr *hg_core_addr, na_class_t **na_class_p,
-    na_context_t **na_context_p, na_addr_t **na_addr_p);
+static struct hg_core_map_table *
+hg_core_map_table_alloc(unsigned int size, unsigned int disp_count);
 
 /**
- * Create handle.
+ * Find entry for RPC ID in table.
  */
-static hg_return_t
-hg_core_create(struct hg_core_private_context *context, na_class_t *na_class,
-    na_context_t *na_context, unsigned long flags,
-    struct hg_core_private_handle **hg_core_handle_p);
+static HG_INLINE struct hg_core_rpc_info *
+hg_core_map_table_find(const struct hg_core_map_table *table, hg_id_t id);
 
 /**
- * Free handle.
+ * Add entry to table (table must not be frozen).
  */
-static hg_return_t
-hg_core_destroy(struct hg_core_private_handle *hg_core_handle);
+static void
+hg_core_map_table_add(
+    struct hg_core_map_table *table, struct hg_core_rpc_info *hg_core_rpc_info);
 
 /**
- * Allocate new handle.
+ * Place entries in frozen table, returns false if no displacement was found.
  */
-static hg_return_t
-hg_core_alloc(struct hg_core_private_context *context, bool user,
-    struct hg_core_private_handle **hg_core_handle_p);
+static bool
+hg_core_map_table_place(struct hg_core_map_table *table,
+    struct hg_core_rpc_info **entries, unsigned int count);
 
 /**
- * Free handle.
+ * Start lookup, returns counter to pass to hg_core_map_read_end().
  */
-static void
-hg_core_free(struct hg_core_private_handle *hg_core_handle);
+static HG_INLINE hg_atomic_int32_t *
+hg_core_map_read_begin(struct hg_core_map *hg_core_map);
 
 /**
- * Allocate NA resources.
+ * End lookup.
  */
-static hg_return_t
-hg_core_alloc_na(struct hg_core_private_handle *hg_core_handle,
-    na_class_t *na_class, na_context_t *na_context, unsigned long flags);
+static HG_INLINE void
+hg_core_map_read_end(hg_atomic_int32_t *readers);
 
 /**
- * Freee NA resources.
+ * Wait for completion of lookups that started before the last update.
  */
 static void
-hg_core_free_na(struct hg_core_private_handle *hg_core_handle);
+hg_core_map_sync(struct hg_core_map *hg_core_map);
 
 /**
- * Reset handle.
+ * Replace current table and free previous one once no lookup reads it.
  */
 static void
-hg_core_reset(struct hg_core_private_handle *hg_core_handle);
+hg_core_map_publish(
+    struct hg_core_map *hg_core_map, struct hg_core_map_table *table);
 
 /**
- * Reset handle and re-post it.
+ * Copy entries of current table except removed into a new table that can
+ * hold count entries.
  */
 static hg_return_t
-hg_core_reset_post(struct hg_core_private_handle *hg_core_handle);
+hg_core_map_rebuild(struct hg_core_map *hg_core_map, unsigned int count,
+    const struct hg_core_rpc_info *removed);
 
 /**
- * Set target addr / RPC ID
+ * Free value in map.
  */
-static hg_return_t
-hg_core_set_rpc(struct hg_core_private_handle *hg_core_handle,
-    struct hg_core_private_addr *hg_core_addr, na_addr_t *na_addr, hg_id_t id);
+static void
+hg_core_map_value_free(struct hg_core_rpc_info *hg_core_rpc_info);
 
 /**
- * Post handle and add it to pending list.
+ * Lookup entry for RPC ID.
  */
-static hg_return_t
-hg_core_post(struct hg_core_private_handle *hg_core_handle);
+static HG_INLINE struct hg_core_rpc_info *
+hg_core_map_lookup(struct hg_core_map *hg_core_map, hg_id_t *id);
 
 /**
- * Post multi-recv operation.
+ * Insert new entry for RPC ID, latency histograms are allocated along with
+ * the entry if requested.
  */
 static hg_return_t
-hg_core_post_multi(struct hg_core_multi_recv_op *multi_recv_op,
-    na_class_t *na_class, na_context_t *na_context);
+hg_core_map_insert(struct hg_core_map *hg_core_map, hg_id_t *id, bool hist,
+    struct hg_core_rpc_info **hg_core_rpc_info_p);
 
 /**
- * Release hold on input buffer so that it can be re-used early.
+ * Remove entry for RPC ID.
  */
 static hg_return_t
-hg_core_release_input(struct hg_core_private_handle *hg_core_handle);
+hg_core_map_remove(struct hg_core_map *hg_core_map, hg_id_t *id);
 
 /**
- * Forward handle.
+ * Compile RPC map into a perfect hash table.
  */
 static hg_return_t
-hg_core_forward(struct hg_core_private_handle *hg_core_handle,
-    hg_core_cb_t callback, void *arg, uint8_t flags, hg_size_t payload_size);
+hg_core_map_freeze(struct hg_core_map *hg_core_map);
 
 /**
- * Forward handle locally.
+ * Lookup addr.
  */
 static hg_return_t
-hg_core_forward_self(struct hg_core_private_handle *hg_core_handle);
+hg_core_addr_lookup(struct hg_core_private_class *hg_core_class,
+    const char *name, struct hg_core_private_addr **addr_p);
 
 /**
- * Forward handle through NA.
+ * Initialize addr map.
  */
 static hg_return_t
-hg_core_forward_na(struct hg_core_private_handle *hg_core_handle);
+hg_core_addr_map_init(struct hg_core_addr_map *addr_map);
 
 /**
- * Send response.
+ * Finalize addr map.
  */
-static hg_return_t
-hg_core_respond(struct hg_core_private_handle *hg_core_handle,
-    hg_core_cb_t callback, void *arg, uint8_t flags, hg_size_t payload_size,
-    hg_return_t ret_code);
+static void
+hg_core_addr_map_finalize(struct hg_core_addr_map *addr_map);
 
 /**
- * Send response locally.
+ * Hash function for addr map.
  */
-static HG_INLINE hg_return_t
-hg_core_respond_self(
-    struct hg_core_private_handle *hg_core_handle, hg_return_t ret_code);
+static HG_INLINE unsigned int
+hg_core_addr_map_hash(hg_hash_table_key_t key);
 
 /**
- * Do not send response locally.
+ * Equal function for addr map.
  */
-static HG_INLINE void
-hg_core_no_respond_self(struct hg_core_private_handle *hg_core_handle);
+static HG_INLINE int
+hg_core_addr_map_equal(hg_hash_table_key_t key1, hg_hash_table_key_t key2);
 
 /**
- * Send response through NA.
+ * Get a reference to an address of the addr map (NULL if none).
+ */
+static struct hg_core_private_addr *
+hg_core_addr_map_lookup(struct hg_core_addr_map *addr_map, const char *name);
+
+/**
+ * Remove address from addr map.
+ */
+static void
+hg_core_addr_map_remove(struct hg_core_private_addr *hg_core_addr);
+
+/**
+ * Lookup array of addrs, addresses are shared with previous batch lookups.
  */
 static hg_return_t
-hg_core_respond_na(
-    struct hg_core_private_handle *hg_core_handle, hg_return_t ret_code);
+hg_core_addr_lookup_batch(struct hg_core_private_class *hg_core_class,
+    const char *const names[], unsigned int count,
+    struct hg_core_private_addr *addrs[]);
 
 /**
- * Send input callback.
+ * Create addr.
  */
-static HG_INLINE void
-hg_core_send_input_cb(const struct na_cb_info *callback_info);
+static hg_return_t
+hg_core_addr_create(struct hg_core_private_class *hg_core_class,
+    struct hg_core_private_addr **hg_core_private_addr_p);
 
 /**
- * Recv input callback.
+ * Free addr.
  */
 static void
-hg_core_recv_input_cb(const struct na_cb_info *callback_info);
+hg_core_addr_free(struct hg_core_private_addr *hg_core_addr);
 
 /**
- * Multi-recv input callback.
+ * Free NA addr.
  */
 static void
-hg_core_multi_recv_input_cb(const struct na_cb_info *callback_info);
+hg_core_addr_free_na(struct hg_core_private_addr *hg_core_addr);
 
 /**
- * Process input.
+ * Set addr to be removed.
  */
 static hg_return_t
-hg_core_process_input(struct hg_core_private_handle *hg_core_handle);
+hg_core_addr_set_remove(struct hg_core_private_addr *hg_core_addr);
 
 /**
- * Send output callback.
+ * Self addr.
  */
-static HG_INLINE void
-hg_core_send_output_cb(const struct na_cb_info *callback_info);
+static hg_return_t
+hg_core_addr_self(struct hg_core_private_class *hg_core_class,
+    struct hg_core_private_addr **hg_core_addr_p);
 
 /**
- * Recv output callback.
+ * Dup addr.
  */
-static HG_INLINE void
-hg_core_recv_output_cb(const struct na_cb_info *callback_info);
+static hg_return_t
+hg_core_addr_dup(struct hg_core_private_addr *hg_core_addr,
+    struct hg_core_private_addr **hg_core_addr_p);
 
 /**
- * Process output.
+ * Compare two addresses.
+ */
+static bool
+hg_core_addr_cmp(
+    struct hg_core_private_addr *addr1, struct hg_core_private_addr *addr2);
+
+/**
+ * Convert addr to string.
  */
 static hg_return_t
-hg_core_process_output(struct hg_core_private_handle *hg_core_handle,
-    void (*done_callback)(hg_core_handle_t, hg_return_t));
+hg_core_addr_to_string(
+    char *buf, hg_size_t *buf_size, struct hg_core_private_addr *hg_core_addr);
 
 /**
- * Callback for HG_CORE_MORE_DATA operation.
+ * Get serialize size.
  */
-static HG_INLINE void
-hg_core_more_data_complete(hg_core_handle_t handle, hg_return_t ret);
+static hg_size_t
+hg_core_addr_get_serialize_size(
+    struct hg_core_private_addr *hg_core_addr, uint8_t flags);
 
 /**
- * Send ack for HG_CORE_MORE_DATA flag on output.
+ * Serialize core address.
  */
-static void
-hg_core_send_ack(hg_core_handle_t handle, hg_return_t ret);
+static hg_return_t
+hg_core_addr_serialize(void *buf, hg_size_t buf_size, uint8_t flags,
+    struct hg_core_private_addr *hg_core_addr);
 
 /**
- * Ack callback. (HG_CORE_MORE_DATA flag on output)
+ * Deserialize core address.
  */
-static HG_INLINE void
-hg_core_ack_cb(const struct na_cb_info *callback_info);
+static hg_return_t
+hg_core_addr_deserialize(struct hg_core_private_class *hg_core_class,
+    struct hg_core_private_addr **hg_core_addr_p, const void *buf,
+    hg_size_t buf_size);
 
 /**
- * Process handle.
+ * Determine which NA component should be used.
  */
 static hg_return_t
-hg_core_process(struct hg_core_private_handle *hg_core_handle);
+hg_core_resolve_na(struct hg_core_private_context *context,
+    struct hg_core_private_addr *hg_core_addr, na_class_t **na_class_p,
+    na_context_t **na_context_p, na_addr_t **na_addr_p);
 
 /**
- * Complete handle operation.
+ * Create handle.
  */
-static HG_INLINE void
-hg_core_complete_op(struct hg_core_private_handle *hg_core_handle);
+static hg_return_t
+hg_core_create(struct hg_core_private_context *context, na_class_t *na_class,
+    na_context_t *na_context, unsigned long flags,
+    struct hg_core_private_handle **hg_core_handle_p);
 
 /**
- * Complete handle and add to completion queue.
+ * Free handle.
  */
-static HG_INLINE void
-hg_core_complete(
-    struct hg_core_private_handle *hg_core_handle, hg_return_t ret);
+static hg_return_t
+hg_core_destroy(struct hg_core_private_handle *hg_core_handle);
 
 /**
- * Completion queue notification callback.
+ * Allocate new handle.
  */
-static HG_INLINE hg_return_t
-hg_core_loopback_event_set(struct hg_core_private_context *context);
+static hg_return_t
+hg_core_alloc(struct hg_core_private_context *context, bool user,
+    struct hg_core_private_handle **hg_core_handle_p);
 
 /**
- * Completion queue notification callback.
+ * Free handle.
  */
-static HG_INLINE hg_return_t
-hg_core_loopback_event_get(
-    struct hg_core_private_context *context, bool *notified_p);
+static void
+hg_core_free(struct hg_core_private_handle *hg_core_handle);
 
 /**
- * Get completion entry from queue.
+ * Remove handle from context and release its address.
  */
-static struct hg_completion_entry *
-hg_core_completion_get(struct hg_core_private_context *context);
+static void
+hg_core_detach(struct hg_core_private_handle *hg_core_handle);
 
 /**
- * Wait timeout_ms for new completion entry.
+ * Re-initialize cached handle and attach it back to context.
  */
 static hg_return_t
-hg_core_completion_wait(
-    struct hg_core_private_context *context, unsigned int timeout_ms);
+hg_core_recycle(struct hg_core_private_context *context,
+    struct hg_core_private_handle *hg_core_handle, na_class_t *na_class,
+    na_context_t *na_context);
 
 /**
- * Get current number of completion entries in context's completion queue.
+ * Allocate NA resources.
  */
-static HG_INLINE unsigned int
-hg_core_completion_count(const struct hg_core_private_context *context);
+static hg_return_t
+hg_core_alloc_na(struct hg_core_private_handle *hg_core_handle,
+    na_class_t *na_class, na_context_t *na_context, unsigned long flags);
 
 /**
- * Trigger completion entry.
+ * Freee NA resources.
  */
 static void
-hg_core_completion_trigger(struct hg_completion_entry *hg_completion_entry);
+hg_core_free_na(struct hg_core_private_handle *hg_core_handle);
 
 /**
- * Make progress.
+ * Create arena of message buffers.
  */
 static hg_return_t
-hg_core_progress_wait(
-    struct hg_core_private_context *context, unsigned int timeout_ms);
+hg_core_arena_create(na_class_t *na_class, struct hg_core_arena **arena_p);
 
 /**
- * Poll for timeout ms on context.
+ * Destroy arena and free its chunks.
  */
-static hg_return_t
-hg_core_poll_wait(struct hg_core_private_context *context,
-    unsigned int timeout_ms, bool *progressed_p);
+static void
+hg_core_arena_destroy(struct hg_core_arena *arena);
 
 /**
- * Progress context without blocking.
+ * Get arena of context for NA class (NULL if none).
  */
-static hg_return_t
-hg_core_progress(
-    struct hg_core_private_context *context, unsigned int *count_p);
+static HG_INLINE struct hg_core_arena *
+hg_core_context_arena(
+    const struct hg_core_private_context *context, const na_class_t *na_class);
 
 /**
- * Progress context without blocking (legacy path).
+ * Get arena size slot of buffer size (HG_CORE_ARENA_SIZES if none).
  */
-static hg_return_t
-hg_core_progress_legacy(struct hg_core_private_context *context,
-    unsigned int timeout_ms, bool *progressed_p);
+static unsigned int
+hg_core_arena_slot(struct hg_core_arena *arena, size_t size, bool alloc);
 
 /**
- * Progress for timeout ms on on NA layer.
+ * Get arena chunk that contains buffer (NULL if none).
  */
-static hg_return_t
-hg_core_progress_wait_na(na_class_t *na_class, na_context_t *na_context,
-    unsigned int timeout_ms, bool *progressed_p);
+static struct hg_core_arena_chunk *
+hg_core_arena_chunk_find(struct hg_core_arena *arena, const void *buf);
 
 /**
- * Progress NA layer without blocking.
+ * Allocate message buffer, from context arena if any.
  */
-static hg_return_t
-hg_core_progress_na(
-    na_class_t *na_class, na_context_t *na_context, unsigned int *count_p);
+static void *
+hg_core_msg_buf_alloc(struct hg_core_private_context *context,
+    na_class_t *na_class, size_t buf_size, unsigned long flags,
+    void **plugin_data_p);
 
 /**
- * Trigger callbacks (wait for new callbacks).
+ * Free message buffer allocated with hg_core_msg_buf_alloc().
  */
-static hg_return_t
-hg_core_trigger_wait(struct hg_core_private_context *context,
-    unsigned int timeout_ms, unsigned int max_count,
-    unsigned int *actual_count_p);
+static void
+hg_core_msg_buf_free(struct hg_core_private_context *context,
+    na_class_t *na_class, void *buf, size_t buf_size, void *plugin_data);
 
 /**
- * Trigger available callbacks.
+ * Reset handle.
  */
 static void
-hg_core_trigger(struct hg_core_private_context *context, unsigned int max_count,
-    unsigned int *actual_count_p);
+hg_core_reset(struct hg_core_private_handle *hg_core_handle);
 
 /**
- * Trigger callback from HG lookup op ID.
+ * Reset handle and re-post it.
  */
-static HG_INLINE void
-hg_core_trigger_lookup_entry(struct hg_core_op_id *hg_core_op_id);
+static hg_return_t
+hg_core_reset_post(struct hg_core_private_handle *hg_core_handle);
 
 /**
- * Trigger callback from HG core handle.
+ * Set target addr / RPC ID
  */
-static HG_INLINE void
-hg_core_trigger_entry(struct hg_core_private_handle *hg_core_handle);
+static hg_return_t
+hg_core_set_rpc(struct hg_core_private_handle *hg_core_handle,
+    struct hg_core_private_addr *hg_core_addr, na_addr_t *na_addr, hg_id_t id);
 
 /**
- * Trigger callback from self HG core handle.
+ * Post handle and add it to pending list.
  */
-static HG_INLINE void
-hg_core_trigger_self(struct hg_core_private_handle *hg_core_handle);
+static hg_return_t
+hg_core_post(struct hg_core_private_handle *hg_core_handle);
 
 /**
- * Trigger callback from HG core handle.
+ * Post multi-recv operation.
  */
-static HG_INLINE void
-hg_core_trigger_na(struct hg_core_private_handle *hg_core_handle);
+static hg_return_t
+hg_core_post_multi(struct hg_core_multi_recv_op *multi_recv_op,
+    na_class_t *na_class, na_context_t *na_context);
 
 /**
- * Trigger RPC handler callback from HG core handle.
+ * Repost consumed multi-recv buffer once it is no longer referenced. In
+ * adaptive mode, the buffer may be resized or freed instead.
  */
-static void
-hg_core_trigger_process(struct hg_core_private_handle *hg_core_handle);
+static hg_return_t
+hg_core_multi_recv_repost(struct hg_core_multi_recv_op *multi_recv_op,
+    na_class_t *na_class, na_context_t *na_context);
 
 /**
- * Trigger forward callback.
+ * Replace multi-recv buffer with a buffer of buf_size (buffer is kept on
+ * error).
  */
-static HG_INLINE void
-hg_core_trigger_forward_cb(struct hg_core_private_handle *hg_core_handle);
+static hg_return_t
+hg_core_multi_recv_buf_resize(struct hg_core_multi_recv_op *multi_recv_op,
+    na_class_t *na_class, size_t buf_size);
 
 /**
- * Trigger respond callback.
+ * Account for consumed multi-recv buffer and adapt buffers once per round.
  */
-static HG_INLINE void
-hg_core_trigger_respond_cb(struct hg_core_private_handle *hg_core_handle);
+static void
+hg_core_multi_recv_consumed(struct hg_core_multi_recv_op *multi_recv_op,
+    int32_t posted_count, na_class_t *na_class, na_context_t *na_context);
 
 /**
- * Wrapper for local callback execution.
+ * Release hold on input buffer so that it can be re-used early.
  */
-static void
-hg_core_trigger_self_respond_cb(struct hg_core_private_handle *hg_core_handle);
+static hg_return_t
+hg_core_release_input(struct hg_core_private_handle *hg_core_handle);
 
 /**
- * Cancel handle.
+ * Forward handle.
  */
 static hg_return_t
-hg_core_cancel(struct hg_core_private_handle *hg_core_handle);
+hg_core_forward(struct hg_core_private_handle *hg_core_handle,
+    hg_core_cb_t callback, void *arg, uint8_t flags, hg_size_t payload_size,
+    unsigned int timeout_ms);
+
+/**
+ * Forward handle locally.
+ */
+static hg_return_t
+hg_core_forward_self(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Forward handle through NA.
+ */
+static hg_return_t
+hg_core_forward_na(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Get current timer wheel tick.
+ */
+static HG_INLINE uint64_t
+hg_core_timer_now(void);
+
+/**
+ * Insert handle into timer wheel slot that matches its expiry.
+ */
+static void
+hg_core_timer_insert(struct hg_core_timer_wheel *timer_wheel,
+    struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Arm forward deadline of handle.
+ */
+static void
+hg_core_timer_arm(
+    struct hg_core_private_handle *hg_core_handle, unsigned int timeout_ms);
+
+/**
+ * Disarm forward deadline of handle if armed.
+ */
+static HG_INLINE void
+hg_core_timer_disarm(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Remove handle from timer wheel.
+ */
+static HG_INLINE void
+hg_core_timer_remove(struct hg_core_timer_wheel *timer_wheel,
+    struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Advance timer wheel and cancel handles whose deadline has expired.
+ */
+static void
+hg_core_timer_advance(struct hg_core_private_context *context);
+
+/**
+ * Clamp timeout so that blocking progress does not delay deadlines.
+ */
+static unsigned int
+hg_core_timer_wait_ms(
+    struct hg_core_private_context *context, unsigned int timeout_ms);
+
+/**
+ * Initialize batch list.
+ */
+static hg_return_t
+hg_core_batch_list_init(struct hg_core_batch_list *batch_list);
+
+/**
+ * Finalize batch list.
+ */
+static void
+hg_core_batch_list_finalize(struct hg_core_batch_list *batch_list);
+
+/**
+ * Get a released handle for processing a coalesced request.
+ */
+static struct hg_core_private_handle *
+hg_core_batch_handle_pop(
+    struct hg_core_batch_list *batch_list, na_class_t *na_class);
+
+/**
+ * Keep handle for processing subsequent coalesced requests.
+ */
+static bool
+hg_core_batch_handle_push(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Allocate new batch.
+ */
+static hg_return_t
+hg_core_batch_alloc(struct hg_core_private_context *context,
+    na_class_t *na_class, na_context_t *na_context, bool output,
+    struct hg_core_batch **batch_p);
+
+/**
+ * Free batch.
+ */
+static void
+hg_core_batch_free(struct hg_core_batch *batch);
+
+/**
+ * Coalesce request (or response if output is set) with other messages to the
+ * same address. queued_p is set to false if the message must be sent on its
+ * own.
+ */
+static hg_return_t
+hg_core_batch_add(struct hg_core_private_handle *hg_core_handle, bool output,
+    bool *queued_p);
+
+/**
+ * Send all open batches of context.
+ */
+static void
+hg_core_batch_flush(struct hg_core_private_context *context);
+
+/**
+ * Send batch.
+ */
+static void
+hg_core_batch_send(struct hg_core_batch *batch);
+
+/**
+ * Send batch callback.
+ */
+static void
+hg_core_batch_send_cb(const struct na_cb_info *callback_info);
+
+/**
+ * Complete send of coalesced messages and release batch.
+ */
+static void
+hg_core_batch_complete(struct hg_core_batch *batch, na_return_t na_ret);
+
+/**
+ * Fan out coalesced requests received on handle to separate handles, the
+ * last request is kept by the handle. Does nothing if input is not a batch.
+ */
+static hg_return_t
+hg_core_batch_unpack(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Process coalesced request on a new handle.
+ */
+static void
+hg_core_batch_process(struct hg_core_private_handle *hg_core_handle,
+    na_tag_t tag, const void *msg, size_t msg_size);
+
+/**
+ * Add handle to output map so that its response can be received in a batch.
+ */
+static void
+hg_core_batch_output_add(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Remove handle from output map. Returns true if its output was already
+ * received in a batch.
+ */
+static bool
+hg_core_batch_output_remove(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Dispatch coalesced responses received on handle to the handles that they
+ * belong to, the response of the handle is moved to the front of its buffer.
+ * Does nothing if output is not a batch.
+ */
+static hg_return_t
+hg_core_batch_output_unpack(
+    struct hg_core_private_handle *hg_core_handle, size_t buf_size);
+
+/**
+ * Process coalesced response on the handle waiting for it, handles are matched
+ * by tag and by the address the batch was received from.
+ */
+static void
+hg_core_batch_output_process(struct hg_core_private_context *context,
+    na_class_t *na_class, na_addr_t *na_addr, na_tag_t tag, const void *msg,
+    size_t msg_size);
+
+/**
+ * Send response.
+ */
+static hg_return_t
+hg_core_respond(struct hg_core_private_handle *hg_core_handle,
+    hg_core_cb_t callback, void *arg, uint8_t flags, hg_size_t payload_size,
+    hg_return_t ret_code);
+
+/**
+ * Send response locally.
+ */
+static HG_INLINE hg_return_t
+hg_core_respond_self(
+    struct hg_core_private_handle *hg_core_handle, hg_return_t ret_code);
+
+/**
+ * Do not send response locally.
+ */
+static HG_INLINE void
+hg_core_no_respond_self(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Send response through NA.
+ */
+static hg_return_t
+hg_core_respond_na(
+    struct hg_core_private_handle *hg_core_handle, hg_return_t ret_code);
+
+/**
+ * Send input callback.
+ */
+static void
+hg_core_send_input_cb(const struct na_cb_info *callback_info);
+
+/**
+ * Recv input callback.
+ */
+static void
+hg_core_recv_input_cb(const struct na_cb_info *callback_info);
+
+/**
+ * Multi-recv input callback.
+ */
+static void
+hg_core_multi_recv_input_cb(const struct na_cb_info *callback_info);
+
+/**
+ * Process input.
+ */
+static hg_return_t
+hg_core_process_input(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Admit incoming request or mark it as busy when the context is overloaded.
+ */
+static void
+hg_core_admission_acquire(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Release request admitted by hg_core_admission_acquire().
+ */
+static HG_INLINE void
+hg_core_admission_release(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Get priority of incoming RPC from request flags and registered priority.
+ */
+static HG_INLINE hg_priority_t
+hg_core_process_priority(const struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Send output callback.
+ */
+static void
+hg_core_send_output_cb(const struct na_cb_info *callback_info);
+
+/**
+ * Recv output callback.
+ */
+static HG_INLINE void
+hg_core_recv_output_cb(const struct na_cb_info *callback_info);
+
+/**
+ * Process output.
+ */
+static hg_return_t
+hg_core_process_output(struct hg_core_private_handle *hg_core_handle,
+    void (*done_callback)(hg_core_handle_t, hg_return_t));
+
+/**
+ * Callback for HG_CORE_MORE_DATA operation.
+ */
+static HG_INLINE void
+hg_core_more_data_complete(hg_core_handle_t handle, hg_return_t ret);
+
+/**
+ * Send ack for HG_CORE_MORE_DATA flag on output.
+ */
+static void
+hg_core_send_ack(hg_core_handle_t handle, hg_return_t ret);
+
+/**
+ * Ack callback. (HG_CORE_MORE_DATA flag on output)
+ */
+static HG_INLINE void
+hg_core_ack_cb(const struct na_cb_info *callback_info);
+
+/**
+ * Process handle.
+ */
+static hg_return_t
+hg_core_process(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Complete handle operation.
+ */
+static HG_INLINE void
+hg_core_complete_op(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Complete handle and add to completion queue.
+ */
+static HG_INLINE void
+hg_core_complete(
+    struct hg_core_private_handle *hg_core_handle, hg_return_t ret);
+
+/**
+ * Completion queue notification callback.
+ */
+static HG_INLINE hg_return_t
+hg_core_loopback_event_set(struct hg_core_private_context *context);
+
+/**
+ * Completion queue notification callback.
+ */
+static HG_INLINE hg_return_t
+hg_core_loopback_event_get(
+    struct hg_core_private_context *context, bool *notified_p);
+
+/**
+ * Get completion entry from queues, using weighted priorities.
+ */
+static struct hg_completion_entry *
+hg_core_completion_get(struct hg_core_private_context *context);
+
+/**
+ * Get completion entry from overflow list.
+ */
+static struct hg_completion_entry *
+hg_core_completion_overflow_get(struct hg_core_private_context *context);
+
+/**
+ * Get up to max_count completion entries from queue.
+ */
+static unsigned int
+hg_core_completion_get_n(struct hg_core_private_context *context,
+    struct hg_completion_entry **entries, unsigned int max_count);
+
+/**
+ * Wait timeout_ms for new completion entry.
+ */
+static hg_return_t
+hg_core_completion_wait(
+    struct hg_core_private_context *context, unsigned int timeout_ms);
+
+/**
+ * Get current number of completion entries in context's completion queues.
+ */
+static unsigned int
+hg_core_completion_count(const struct hg_core_private_context *context);
+
+/**
+ * Trigger completion entry.
+ */
+static void
+hg_core_completion_trigger(struct hg_completion_entry *hg_completion_entry);
+
+/**
+ * Convert completion entry to event. Entries that are not reported as events
+ * are triggered directly, in which case false is returned.
+ */
+static bool
+hg_core_completion_event(struct hg_completion_entry *hg_completion_entry,
+    struct hg_core_cb_event *event);
+
+/**
+ * Make progress.
+ */
+static hg_return_t
+hg_core_progress_wait(
+    struct hg_core_private_context *context, unsigned int timeout_ms);
+
+/**
+ * Spin on progress for an adaptive amount of time before blocking.
+ */
+static hg_return_t
+hg_core_progress_spin(struct hg_core_private_context *context,
+    hg_time_t deadline, bool *progressed_p);
+
+/**
+ * Update average inter-arrival time of completions.
+ */
+static HG_INLINE void
+hg_core_progress_spin_update(
+    struct hg_core_progress_spin *progress_spin, hg_time_t now);
+
+/**
+ * Check whether there is work to progress before blocking, equivalent of
+ * HG_Core_event_ready() that is too large to be inlined into progress.
+ */
+static bool
+hg_core_event_ready(struct hg_core_private_context *context);
+
+/**
+ * Poll for timeout ms on context.
+ */
+static hg_return_t
+hg_core_poll_wait(struct hg_core_private_context *context,
+    unsigned int timeout_ms, bool *progressed_p);
+
+/**
+ * Progress context without blocking.
+ */
+static hg_return_t
+hg_core_progress(
+    struct hg_core_private_context *context, unsigned int *count_p);
+
+/**
+ * Progress context without blocking (legacy path).
+ */
+static hg_return_t
+hg_core_progress_legacy(struct hg_core_private_context *context,
+    unsigned int timeout_ms, bool *progressed_p);
+
+/**
+ * Progress for timeout ms on on NA layer.
+ */
+static hg_return_t
+hg_core_progress_wait_na(na_class_t *na_class, na_context_t *na_context,
+    unsigned int timeout_ms, bool *progressed_p);
+
+/**
+ * Progress NA layer without blocking.
+ */
+static hg_return_t
+hg_core_progress_na(
+    na_class_t *na_class, na_context_t *na_context, unsigned int *count_p);
+
+/**
+ * Trigger callbacks (wait for new callbacks).
+ */
+static hg_return_t
+hg_core_trigger_wait(struct hg_core_private_context *context,
+    unsigned int timeout_ms, unsigned int max_count,
+    unsigned int *actual_count_p);
+
+/**
+ * Trigger available callbacks.
+ */
+static void
+hg_core_trigger(struct hg_core_private_context *context, unsigned int max_count,
+    unsigned int *actual_count_p);
+
+/**
+ * Retrieve events (wait for new completions).
+ */
+static hg_return_t
+hg_core_trigger_events_wait(struct hg_core_private_context *context,
+    unsigned int timeout_ms, unsigned int max_count,
+    struct hg_core_cb_event *events, unsigned int *actual_count_p);
+
+/**
+ * Retrieve available events.
+ */
+static unsigned int
+hg_core_trigger_events(struct hg_core_private_context *context,
+    unsigned int max_count, struct hg_core_cb_event *events);
+
+/**
+ * Trigger callback from HG lookup op ID.
+ */
+static HG_INLINE void
+hg_core_trigger_lookup_entry(struct hg_core_op_id *hg_core_op_id);
+
+/**
+ * Trigger callback from HG core handle.
+ */
+static HG_INLINE void
+hg_core_trigger_entry(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Trigger callback from self HG core handle.
+ */
+static HG_INLINE void
+hg_core_trigger_self(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Trigger callback from HG core handle.
+ */
+static HG_INLINE void
+hg_core_trigger_na(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Trigger RPC handler callback from HG core handle.
+ */
+static void
+hg_core_trigger_process(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Record latency of completed forward / response in RPC histograms.
+ */
+static HG_INLINE void
+hg_core_trigger_hist_record(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Trigger forward callback.
+ */
+static HG_INLINE void
+hg_core_trigger_forward_cb(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Trigger respond callback.
+ */
+static HG_INLINE void
+hg_core_trigger_respond_cb(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Wrapper for local callback execution.
+ */
+static void
+hg_core_trigger_self_respond_cb(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Cancel handle.
+ */
+static hg_return_t
+hg_core_cancel(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Check whether handle has operations posted to address.
+ */
+static bool
+hg_core_handle_match_addr(const struct hg_core_private_handle *hg_core_handle,
+    const struct hg_core_addr *addr);
+
+/**
+ * Cancel handles of list that have operations posted to address.
+ */
+static hg_return_t
+hg_core_handle_list_cancel_addr(
+    struct hg_core_handle_list *handle_list, const struct hg_core_addr *addr);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/* Callback type string table */
+#define X(a) #a,
+#ifdef HG_HAS_DEBUG
+static const char *const hg_core_op_type_name_g[] = {HG_CORE_OP_TYPE};
+#endif
+#undef X
+
+/* Trace event string table */
+#define X(a) #a,
+static const char *const hg_core_trace_event_name_g[] = {HG_CORE_TRACE_EVENT};
+#undef X
+
+/* Default ops */
+static const struct hg_core_ops hg_core_ops_na_g = {
+    .forward = hg_core_forward_na,
+    .respond = hg_core_respond_na,
+    .trigger = hg_core_trigger_na};
+
+static const struct hg_core_ops hg_core_ops_self_g = {
+    .forward = hg_core_forward_self,
+    .respond = hg_core_respond_self,
+    .trigger = hg_core_trigger_self};
+
+/*---------------------------------------------------------------------------*/
+#ifdef HG_HAS_DEBUG
+static const char *
+hg_core_op_type_to_string(enum hg_core_op_type op_type)
+{
+    return hg_core_op_type_name_g[op_type];
+}
+#endif
+
+/*---------------------------------------------------------------------------*/
+#if defined(HG_HAS_DEBUG) && !defined(_WIN32)
+static void
+hg_core_counters_init(struct hg_core_counters *hg_core_counters)
+{
+    /* TODO we could revert the linked list to avoid registration in reverse
+     * order */
+    HG_LOG_ADD_COUNTER64(hg_diag, &hg_core_counters->progress_block_count,
+        "progress_block_count", "Progress completed after blocking");
+    HG_LOG_ADD_COUNTER64(hg_diag, &hg_core_counters->progress_spin_count,
+        "progress_spin_count", "Progress completed while spinning");
+    HG_LOG_ADD_COUNTER64(hg_diag, &hg_core_counters->bulk_count, "bulk_count",
+        "Bulk transfers (inc. extra bulks)");
+    HG_LOG_ADD_COUNTER64(hg_diag, &hg_core_counters->rpc_resp_extra_count,
+        "rpc_resp_extra_count", "RPCs with extra bulk response");
+    HG_LOG_ADD_COUNTER64(hg_diag, &hg_core_counters->rpc_req_extra_count,
+        "rpc_req_extra_count", "RPCs with extra bulk request");
+    HG_LOG_ADD_COUNTER64(hg_diag, &hg_core_counters->rpc_resp_recv_count,
+        "rpc_resp_recv_count", "RPC responses received");
+    HG_LOG_ADD_COUNTER64(hg_diag, &hg_core_counters->rpc_resp_sent_count,
+        "rpc_resp_sent_count", "RPC responses sent");
+    HG_LOG_ADD_COUNTER64(hg_diag, &hg_core_counters->rpc_req_recv_count,
+        "rpc_req_recv_count", "RPC requests received");
+    HG_LOG_ADD_COUNTER64(hg_diag, &hg_core_counters->rpc_req_sent_count,
+        "rpc_req_sent_count", "RPC requests sent");
+}
+#endif
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE void
+hg_core_stats_add(hg_atomic_int64_t *counter, int64_t value)
+{
+    /* Single writer, readers only need to observe a consistent value */
+    hg_atomic_set64(counter, hg_atomic_get64(counter) + value);
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE void
+hg_core_stats_add_shared(hg_atomic_int64_t *counter, int64_t value)
+{
+    int64_t old;
+
+    do {
+        old = hg_atomic_get64(counter);
+    } while (!hg_atomic_cas64(counter, old, old + value));
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_context_stats_sum(
+    const struct hg_core_private_context *context, struct hg_stats *stats)
+{
+    const struct hg_core_stats_counters *counters[] = {
+        &context->stats->progress, &context->stats->shared};
+    size_t i;
+
+    for (i = 0; i < sizeof(counters) / sizeof(counters[0]); i++) {
+        stats->rpc_req_sent +=
+            (uint64_t) hg_atomic_get64(&counters[i]->rpc_req_sent);
+        stats->rpc_req_recv +=
+            (uint64_t) hg_atomic_get64(&counters[i]->rpc_req_recv);
+        stats->rpc_resp_sent +=
+            (uint64_t) hg_atomic_get64(&counters[i]->rpc_resp_sent);
+        stats->rpc_resp_recv +=
+            (uint64_t) hg_atomic_get64(&counters[i]->rpc_resp_recv);
+        stats->rpc_req_extra +=
+            (uint64_t) hg_atomic_get64(&counters[i]->rpc_req_extra);
+        stats->rpc_resp_extra +=
+            (uint64_t) hg_atomic_get64(&counters[i]->rpc_resp_extra);
+        stats->msg_bytes_sent +=
+            (uint64_t) hg_atomic_get64(&counters[i]->msg_bytes_sent);
+        stats->msg_bytes_recv +=
+            (uint64_t) hg_atomic_get64(&counters[i]->msg_bytes_recv);
+        stats->bulk_count +=
+            (uint64_t) hg_atomic_get64(&counters[i]->bulk_count);
+        stats->bulk_bytes +=
+            (uint64_t) hg_atomic_get64(&counters[i]->bulk_bytes);
+        stats->multi_recv_copy +=
+            (uint64_t) hg_atomic_get64(&counters[i]->multi_recv_copy);
+        stats->multi_recv_exhausted +=
+            (uint64_t) hg_atomic_get64(&counters[i]->multi_recv_exhausted);
+        stats->multi_recv_resize +=
+            (uint64_t) hg_atomic_get64(&counters[i]->multi_recv_resize);
+        stats->retry += (uint64_t) hg_atomic_get64(&counters[i]->retry);
+        stats->rpc_req_busy +=
+            (uint64_t) hg_atomic_get64(&counters[i]->rpc_req_busy);
+        stats->rpc_req_unfair +=
+            (uint64_t) hg_atomic_get64(&counters[i]->rpc_req_unfair);
+        stats->rpc_req_timeout +=
+            (uint64_t) hg_atomic_get64(&counters[i]->rpc_req_timeout);
+        stats->handle_pool_grow +=
+            (uint64_t) hg_atomic_get64(&counters[i]->handle_pool_grow);
+        stats->handle_pool_shrink +=
+            (uint64_t) hg_atomic_get64(&counters[i]->handle_pool_shrink);
+        stats->progress_spin +=
+            (uint64_t) hg_atomic_get64(&counters[i]->progress_spin);
+        stats->progress_block +=
+            (uint64_t) hg_atomic_get64(&counters[i]->progress_block);
+    }
+
+    for (i = 0; i < HG_PRIORITY_MAX; i++)
+        stats->completion_spill +=
+            hg_atomic_seg_queue_spill_count(context->completion_queues[i]);
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE struct hg_core_rpc_hist *
+hg_core_rpc_hist_get(const struct hg_core_private_handle *hg_core_handle)
+{
+    const struct hg_core_map_entry *entry =
+        (const struct hg_core_map_entry *) hg_core_handle->core_handle.rpc_info;
+
+    return (entry != NULL) ? entry->hist : NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE void
+hg_core_rpc_hist_record(struct hg_histogram *hg_histogram, hg_time_t start)
+{
+    hg_time_t now;
+
+    hg_time_get_current(&now);
+    hg_histogram_record(hg_histogram,
+        (uint64_t) (hg_time_to_double(hg_time_subtract(now, start)) * 1e9));
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_rpc_hist_summary(
+    const struct hg_histogram *hg_histogram, struct hg_latency *latency)
+{
+    latency->count = hg_histogram_count(hg_histogram);
+    latency->p50 = hg_histogram_percentile(hg_histogram, 50.0);
+    latency->p99 = hg_histogram_percentile(hg_histogram, 99.0);
+    latency->p999 = hg_histogram_percentile(hg_histogram, 99.9);
+    latency->max = hg_histogram_max(hg_histogram);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_rpc_hist_dump(struct hg_core_map *hg_core_map)
+{
+    const struct hg_core_map_table *table =
+        (const struct hg_core_map_table *) (uintptr_t) hg_atomic_get64(
+            &hg_core_map->table);
+    hg_log_func_t log_func = hg_log_get_func();
+    FILE *stream = hg_log_get_stream_debug();
+    unsigned int i;
+
+    if (table == NULL)
+        return;
+
+    log_func(stream, "### ----------------------\n"
+                     "### (hg) RPC latency summary (ns)\n"
+                     "### ----------------------\n");
+    for (i = 0; i < table->size; i++) {
+        const struct hg_core_map_entry *entry =
+            (const struct hg_core_map_entry *) (uintptr_t) hg_atomic_get64(
+                &table->slots[i]);
+        struct hg_rpc_latency latency;
+
+        if (entry == NULL || entry->hist == NULL)
+            continue;
+
+        hg_core_rpc_hist_summary(&entry->hist->forward, &latency.forward);
+        hg_core_rpc_hist_summary(&entry->hist->handler, &latency.handler);
+        if (latency.forward.count == 0 && latency.handler.count == 0)
+            continue;
+
+        log_func(stream,
+            "# RPC ID %" PRIu64 ": forward (count=%" PRIu64 ", p50=%" PRIu64
+            ", p99=%" PRIu64 ", p999=%" PRIu64 ", max=%" PRIu64
+            "), handler (count=%" PRIu64 ", p50=%" PRIu64 ", p99=%" PRIu64
+            ", p999=%" PRIu64 ", max=%" PRIu64 ")\n",
+            entry->rpc_info.id, latency.forward.count, latency.forward.p50,
+            latency.forward.p99, latency.forward.p999, latency.forward.max,
+            latency.handler.count, latency.handler.p50, latency.handler.p99,
+            latency.handler.p999, latency.handler.max);
+    }
+    log_func(stream, "# -\n");
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_trace_create(const char *file, struct hg_core_trace **trace_p)
+{
+    struct hg_core_trace *trace;
+    hg_return_t ret;
+
+    trace = (struct hg_core_trace *) calloc(1, sizeof(*trace));
+    HG_CHECK_SUBSYS_ERROR(cls, trace == NULL, error, ret, HG_NOMEM,
+        "Could not allocate tracer");
+
+    if (file != NULL) {
+        trace->file = strdup(file);
+        HG_CHECK_SUBSYS_ERROR(cls, trace->file == NULL, error_free, ret,
+            HG_NOMEM, "Could not duplicate trace file name");
+    }
+
+    trace->rec = hg_dlog_rec_alloc(
+        "hg_core", HG_CORE_TRACE_RING_SIZE, HG_CORE_TRACE_THREAD_MAX);
+    HG_CHECK_SUBSYS_ERROR(cls, trace->rec == NULL, error_free, ret, HG_NOMEM,
+        "Could not allocate trace recorder");
+
+    *trace_p = trace;
+
+    return HG_SUCCESS;
+
+error_free:
+    free(trace->file);
+    free(trace);
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_trace_destroy(struct hg_core_trace *trace)
+{
+    hg_dlog_rec_free(trace->rec);
+    free(trace->file);
+    free(trace);
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE void
+hg_core_trace_event(struct hg_core_private_handle *hg_core_handle,
+    enum hg_core_trace_event event, uint32_t arg)
+{
+    struct hg_core_trace *trace = HG_CORE_HANDLE_CLASS(hg_core_handle)->trace;
+
+    if (trace != NULL)
+        (void) hg_dlog_rec_add(trace->rec, (uint32_t) event, hg_core_handle,
+            hg_core_handle->core_handle.info.id, arg);
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_core_trace_record_cmp(const void *a, const void *b)
+{
+    const struct hg_dlog_rec_entry *entry_a =
+        &((const struct hg_dlog_rec_record *) a)->entry;
+    const struct hg_dlog_rec_entry *entry_b =
+        &((const struct hg_dlog_rec_record *) b)->entry;
+
+    if (entry_a->handle != entry_b->handle)
+        return (entry_a->handle < entry_b->handle) ? -1 : 1;
+    if (entry_a->time != entry_b->time)
+        return (entry_a->time < entry_b->time) ? -1 : 1;
+
+    return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_trace_dump(struct hg_core_trace *trace, const char *file)
+{
+    struct hg_dlog_rec_record *records = NULL;
+    size_t count, max_count, i;
+    FILE *fp = NULL;
+    uint64_t start = UINT64_MAX;
+    double prev_ts = 0.;
+    hg_return_t ret;
+    int pid;
+
+#ifdef _WIN32
+    pid = _getpid();
+#else
+    pid = getpid();
+#endif
+
+    /* Rings created while copying are skipped */
+    max_count = (size_t) hg_atomic_get32(&trace->rec->nrings) *
+                trace->rec->size;
+    if (max_count > 0) {
+        records = (struct hg_dlog_rec_record *) malloc(
+            max_count * sizeof(*records));
+        HG_CHECK_SUBSYS_ERROR(cls, records == NULL, error, ret, HG_NOMEM,
+            "Could not allocate trace records");
+    }
+    count = hg_dlog_rec_copy(trace->rec, records, max_count);
+
+    /* Group records by handle, time stamps are relative to the oldest one */
+    if (count > 0)
+        qsort(records, count, sizeof(*records), hg_core_trace_record_cmp);
+    for (i = 0; i < count; i++)
+        start = MIN(start, records[i].entry.time);
+
+    fp = fopen(file, "w");
+    HG_CHECK_SUBSYS_ERROR(cls, fp == NULL, error, ret, HG_NOENTRY,
+        "Could not open trace file %s", file);
+
+    /* Each handle lifecycle is an async slice that starts on forward (origin)
+     * or input reception (target), transitions are instant events */
+    fprintf(fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    for (i = 0; i < count; i++) {
+        const struct hg_dlog_rec_entry *entry = &records[i].entry;
+        const void *handle = (const void *) (uintptr_t) entry->handle;
+        double ts = (double) (entry->time - start) / 1e3;
+        bool handle_first =
+                 (i == 0 || records[i - 1].entry.handle != entry->handle),
+             handle_last = (i == count - 1 ||
+                            records[i + 1].entry.handle != entry->handle);
+
+        if (handle_first || entry->event == HG_CORE_TRACE_FORWARD ||
+            entry->event == HG_CORE_TRACE_RECV_INPUT) {
+            if (!handle_first)
+                fprintf(fp,
+                    ",\n{\"name\":\"rpc\",\"cat\":\"hg\",\"ph\":\"e\","
+                    "\"id\":\"%p\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f}",
+                    handle, pid, records[i - 1].ring, prev_ts);
+            fprintf(fp,
+                "%s\n{\"name\":\"rpc\",\"cat\":\"hg\",\"ph\":\"b\","
+                "\"id\":\"%p\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f,"
+                "\"args\":{\"rpc_id\":%" PRIu64 "}}",
+                (i == 0) ? "" : ",", handle, pid, records[i].ring, ts,
+                entry->arg[0]);
+        }
+        fprintf(fp,
+            ",\n{\"name\":\"%s\",\"cat\":\"hg\",\"ph\":\"n\",\"id\":\"%p\","
+            "\"pid\":%d,\"tid\":%u,\"ts\":%.3f,\"args\":{\"rpc_id\":%" PRIu64
+            ",\"arg\":%" PRIu64 "}}",
+            hg_core_trace_event_name_g[entry->event] +
+                sizeof("HG_CORE_TRACE_") - 1,
+            handle, pid, records[i].ring, ts, entry->arg[0], entry->arg[1]);
+        prev_ts = ts;
+        if (handle_last)
+            fprintf(fp,
+                ",\n{\"name\":\"rpc\",\"cat\":\"hg\",\"ph\":\"e\","
+                "\"id\":\"%p\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f}",
+                handle, pid, records[i].ring, ts);
+    }
+    fprintf(fp, "\n]}\n");
+
+    HG_CHECK_SUBSYS_ERROR(cls, fclose(fp) != 0, error_free, ret, HG_FAULT,
+        "Could not close trace file %s", file);
+    free(records);
+
+    return HG_SUCCESS;
+
+error:
+    if (fp != NULL)
+        fclose(fp);
+error_free:
+    free(records);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE na_tag_t
+hg_core_gen_request_tag(struct hg_core_private_context *context)
+{
+    struct hg_core_private_class *hg_core_class =
+        HG_CORE_CONTEXT_CLASS(context);
+    na_tag_t request_tag = 0, max_tag;
+
+    /* Upper bits hold the range index, the counter is not shared with other
+     * contexts */
+    if (context->request_tag_range >= 0) {
+        max_tag = ((na_tag_t) 1 << hg_core_class->request_tag_shift) - 1;
+        return ((na_tag_t) context->request_tag_range
+                   << hg_core_class->request_tag_shift) |
+               ((na_tag_t) hg_atomic_incr32(&context->request_tag) & max_tag);
+    }
+
+    /* Class tags are restricted to the first range if ranges are used */
+    max_tag = (hg_core_class->request_tag_shift > 0)
+                  ? ((na_tag_t) 1 << hg_core_class->request_tag_shift) - 1
+                  : hg_core_class->request_max_tag;
+
+    /* Compare and swap tag if reached max tag */
+    if (!hg_atomic_cas32(&hg_core_class->request_tag, (int32_t) max_tag, 0)) {
+        /* Increment tag */
+        request_tag = (na_tag_t) hg_atomic_incr32(&hg_core_class->request_tag);
+    }
+
+    return request_tag;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_tag_range_alloc(struct hg_core_private_context *context)
+{
+    struct hg_core_private_class *hg_core_class =
+        HG_CORE_CONTEXT_CLASS(context);
+    uint64_t *tag_ranges = hg_core_class->context_list.tag_ranges;
+    unsigned int i;
+
+    hg_atomic_init32(&context->request_tag, 0);
+    context->request_tag_range = -1;
+    if (hg_core_class->request_tag_shift == 0)
+        return;
+
+    /* First range is kept for class tags, used by contexts without range */
+    for (i = 1; i < HG_CORE_REQUEST_TAG_RANGES; i++) {
+        if (!(tag_ranges[i / 64] & (UINT64_C(1) << (i % 64)))) {
+            tag_ranges[i / 64] |= UINT64_C(1) << (i % 64);
+            context->request_tag_range = (int) i;
+            break;
+        }
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_tag_range_free(struct hg_core_private_context *context)
+{
+    unsigned int i;
+
+    if (context->request_tag_range < 0)
+        return;
+
+    i = (unsigned int) context->request_tag_range;
+    HG_CORE_CONTEXT_CLASS(context)->context_list.tag_ranges[i / 64] &=
+        ~(UINT64_C(1) << (i % 64));
+    context->request_tag_range = -1;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE hg_return_t
+hg_core_proc_header_request(struct hg_core_handle *hg_core_handle,
+    struct hg_core_header *hg_core_header, hg_proc_op_t op)
+{
+    char *header_buf =
+        (char *) hg_core_handle->in_buf + hg_core_handle->na_in_header_offset;
+    size_t header_buf_size =
+        hg_core_handle->in_buf_size - hg_core_handle->na_in_header_offset;
+    hg_return_t ret;
+
+    /* Proc request header */
+    ret = hg_core_header_request_proc(
+        op, header_buf, header_buf_size, hg_core_header);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        rpc, error, ret, "Could not process request header");
+
+    if (op == HG_DECODE) {
+        ret = hg_core_header_request_verify(hg_core_header);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            rpc, error, ret, "Could not verify request header");
+    }
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE hg_return_t
+hg_core_proc_header_response(struct hg_core_handle *hg_core_handle,
+    struct hg_core_header *hg_core_header, hg_proc_op_t op)
+{
+    char *header_buf =
+        (char *) hg_core_handle->out_buf + hg_core_handle->na_out_header_offset;
+    size_t header_buf_size =
+        hg_core_handle->out_buf_size - hg_core_handle->na_out_header_offset;
+    hg_return_t ret;
+
+    /* Proc response header */
+    ret = hg_core_header_response_proc(
+        op, header_buf, header_buf_size, hg_core_header);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        rpc, error, ret, "Could not process response header");
+
+    if (op == HG_DECODE) {
+        ret = hg_core_header_response_verify(hg_core_header);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            rpc, error, ret, "Could not verify response header");
+    }
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_init(const char *na_info_string, bool na_listen, unsigned int version,
+    const struct hg_init_info *hg_init_info_p,
+    struct hg_core_private_class **class_p)
+{
+    struct hg_init_info hg_init_info = HG_INIT_INFO_INITIALIZER;
+    struct na_init_info na_init_info = NA_INIT_INFO_INITIALIZER;
+    unsigned int na_version = NA_VERSION(NA_VERSION_MAJOR, NA_VERSION_MINOR);
+    struct na_init_info *na_init_info_p = NULL;
+    struct hg_core_private_class *hg_core_class = NULL;
+#ifdef NA_HAS_SM
+    const char *na_class_name;
+#endif
+    hg_return_t ret;
+    int rc;
+
+    /* Prevent newer versions */
+    HG_CHECK_SUBSYS_ERROR(cls,
+        HG_VERSION_LT(HG_VERSION(HG_VERSION_MAJOR, HG_VERSION_MINOR), version),
+        error, ret, HG_INVALID_ARG, "API version cannot be newer than library");
+
+    /* Create new HG class */
+    hg_core_class =
+        (struct hg_core_private_class *) calloc(1, sizeof(*hg_core_class));
+    HG_CHECK_SUBSYS_ERROR(cls, hg_core_class == NULL, error_free, ret, HG_NOMEM,
+        "Could not allocate HG class");
+
+    hg_atomic_init32(&hg_core_class->request_tag, 0);
+    hg_atomic_init32(&hg_core_class->n_contexts, 0);
+    hg_atomic_init32(&hg_core_class->n_addrs, 0);
+    hg_atomic_init32(&hg_core_class->n_bulks, 0);
+
+    /* Contexts are tracked for class stats */
+    LIST_INIT(&hg_core_class->context_list.list);
+    rc = hg_thread_spin_init(&hg_core_class->context_list.lock);
+    HG_CHECK_SUBSYS_ERROR(cls, rc != HG_UTIL_SUCCESS, error_free, ret,
+        HG_NOMEM, "hg_thread_spin_init() failed");
+
+    /* Create new function map */
+    ret = hg_core_map_init(&hg_core_class->rpc_map);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        cls, error_lock, ret, "Could not create RPC map");
+
+    /* Create addr map */
+    ret = hg_core_addr_map_init(&hg_core_class->addr_map);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        cls, error_map, ret, "Could not create addr map");
+
+    /* Ensure init info is API compatible */
+    if (hg_init_info_p) {
+        HG_CHECK_SUBSYS_ERROR(cls, version == 0, error, ret, HG_INVALID_ARG,
+            "API version cannot be 0");
+        HG_LOG_SUBSYS_DEBUG(cls, "Init info version used: v%d.%d",
+            HG_MAJOR(version), HG_MINOR(version));
+        na_init_info_p = &na_init_info;
+
+        /* Get init info and overwrite defaults */
+        if (HG_VERSION_GE(version, HG_VERSION(2, 4))) {
+            hg_init_info = *hg_init_info_p;
+            na_init_info.traffic_class = hg_init_info.traffic_class;
+        } else if (HG_VERSION_GE(version, HG_VERSION(2, 3)))
+            hg_init_info_dup_2_3(&hg_init_info,
+                (const struct hg_init_info_2_3 *) hg_init_info_p);
+        else
+            hg_init_info_dup_2_2(&hg_init_info,
+                (const struct hg_init_info_2_2 *) hg_init_info_p);
+    }
+
+    /* Set post init / incr / multi-recv values  */
+    hg_core_class->init_info.request_post_init =
+        (hg_init_info.request_post_init == 0) ? HG_CORE_POST_INIT
+                                              : hg_init_info.request_post_init;
+    if (hg_init_info.request_post_incr < 0)
+        hg_core_class->init_info.request_post_incr = 0;
+    else if (hg_init_info.request_post_incr == 0)
+        hg_core_class->init_info.request_post_incr = HG_CORE_POST_INCR;
+    else
+        hg_core_class->init_info.request_post_incr =
+            (uint32_t) hg_init_info.request_post_incr;
+    hg_core_class->init_info.multi_recv_adaptive =
+        hg_init_info.multi_recv_adaptive;
+    hg_core_class->init_info.hugepage_arena = hg_init_info.hugepage_arena;
+    if (hg_init_info.multi_recv_op_max != 0)
+        hg_core_class->init_info.multi_recv_op_max =
+            hg_init_info.multi_recv_op_max;
+    else
+        hg_core_class->init_info.multi_recv_op_max =
+            hg_init_info.multi_recv_adaptive ? HG_CORE_MULTI_RECV_ADAPT_OP_MAX
+                                             : HG_CORE_MULTI_RECV_OP_COUNT;
+
+    HG_CHECK_SUBSYS_ERROR(cls,
+        hg_init_info.multi_recv_copy_threshold >
+            (unsigned int) hg_core_class->init_info.multi_recv_op_max,
+        error, ret, HG_INVALID_ARG,
+        "multi_recv_copy_threshold (%u) cannot exceed multi_recv_op_max "
+        "(%u)",
+        hg_init_info.multi_recv_copy_threshold,
+        (unsigned int) hg_core_class->init_info.multi_recv_op_max);
+    hg_core_class->init_info.multi_recv_copy_threshold =
+        hg_init_info.multi_recv_copy_threshold;
+
+    /* Initial completion queue size */
+    HG_CHECK_SUBSYS_ERROR(cls,
+        hg_init_info.completion_queue_size != 0 &&
+            (hg_init_info.completion_queue_size < 2 ||
+                !powerof2(hg_init_info.completion_queue_size)),
+        error, ret, HG_INVALID_ARG,
+        "completion_queue_size (%u) must be a power of 2",
+        hg_init_info.completion_queue_size);
+    hg_core_class->init_info.completion_queue_size =
+        (hg_init_info.completion_queue_size == 0)
+            ? HG_CORE_ATOMIC_QUEUE_SIZE
+            : hg_init_info.completion_queue_size;
+
+#ifdef HG_HAS_CHECKSUMS
+    /* Save checksum level */
+    hg_core_class->init_info.checksum_level = hg_init_info.checksum_level;
+#else
+    HG_CHECK_SUBSYS_WARNING(cls,
+        hg_init_info.checksum_level != HG_CHECKSUM_NONE,
+        "Option checksum_level requires CMake option MERCURY_USE_CHECKSUMS "
+        "to be turned ON.");
+    hg_core_class->init_info.checksum_level = HG_CHECKSUM_NONE;
+#endif
+
+    /* Save progress mode */
+    hg_core_class->init_info.progress_mode =
+        hg_init_info.na_init_info.progress_mode;
+    hg_core_class->init_info.progress_spin_max = hg_init_info.progress_spin_max;
+    hg_core_class->init_info.stats = hg_init_info.stats;
+    hg_core_class->init_info.coalesce_requests = hg_init_info.coalesce_requests;
+    hg_core_class->init_info.coalesce_responses =
+        hg_init_info.coalesce_responses;
+    hg_core_class->init_info.request_max = hg_init_info.request_max;
+    hg_core_class->init_info.request_trim_time = hg_init_info.request_trim_time;
+
+    /* Handle lifecycle tracing */
+    if (hg_init_info.trace_file != NULL) {
+        ret = hg_core_trace_create(
+            hg_init_info.trace_file, &hg_core_class->trace);
+        HG_CHECK_SUBSYS_HG_ERROR(cls, error, ret, "Could not create tracer");
+    }
+
+    /* Loopback capability */
+    hg_core_class->init_info.loopback = !hg_init_info.no_loopback;
+
+    /* Listening */
+    hg_core_class->init_info.listen = na_listen;
+
+    /* Stats / counters */
+#if defined(HG_HAS_DEBUG) && !defined(_WIN32)
+    hg_core_counters_init(&hg_core_class->counters);
+#endif
+
+#ifdef HG_HAS_DEBUG
+    if (hg_init_info.stats)
+        hg_log_set_subsys_level("diag", HG_LOG_LEVEL_DEBUG);
+#endif
+
+    if (hg_init_info.na_class != NULL) {
+        /* External NA class */
+        hg_core_class->core_class.na_class = hg_init_info.na_class;
+        hg_core_class->init_info.na_ext_init = true;
+    } else {
+        /* Initialize NA if not provided externally */
+        hg_core_class->core_class.na_class = NA_Initialize_opt2(na_info_string,
+            hg_core_class->init_info.listen, na_version, na_init_info_p);
+        HG_CHECK_SUBSYS_ERROR(cls, hg_core_class->core_class.na_class == NULL,
+            error, ret, HG_NA_ERROR,
+            "Could not initialize NA class (info_string=%s, listen=%d)",
+            na_info_string, hg_core_class->init_info.listen);
+    }
+
+    /* Multi-recv capability */
+    hg_core_class->init_info.multi_recv =
+        NA_Has_opt_feature(
+            hg_core_class->core_class.na_class, NA_OPT_MULTI_RECV) &&
+        !hg_init_info.no_multi_recv;
+    HG_LOG_SUBSYS_DEBUG(
+        cls, "Multi-recv set to %" PRIu8, hg_core_class->init_info.multi_recv);
+    if (hg_core_class->init_info.multi_recv &&
+        (hg_core_class->init_info.request_post_incr == 0)) {
+        hg_core_class->init_info.request_post_incr = HG_CORE_POST_INCR;
+        HG_LOG_SUBSYS_WARNING(cls,
+            "Using multi-recv with no handle post increment is currently not "
+            "supported, resetting to default value of %d",
+            HG_CORE_POST_INCR);
+    }
+
+    /* Compute max request tag */
+    hg_core_class->request_max_tag =
+        NA_Msg_get_max_tag(hg_core_class->core_class.na_class);
+    HG_CHECK_SUBSYS_ERROR(cls, hg_core_class->request_max_tag == 0, error, ret,
+        HG_NA_ERROR, "NA Max tag is not defined");
+
+#ifdef NA_HAS_SM
+    /* Retrieve NA class name */
+    na_class_name = NA_Get_class_name(hg_core_class->core_class.na_class);
+
+    /* Initialize SM plugin */
+    if (hg_init_info.auto_sm && ((strcmp(na_class_name, "mpi") == 0) ||
+                                    (strcmp(na_class_name, "na") == 0))) {
+        HG_LOG_SUBSYS_WARNING(cls,
+            "Auto SM mode is not compatible with current NA class, disabling");
+    } else if (hg_init_info.auto_sm) {
+        char info_string[HG_CORE_ADDR_MAX_SIZE], *info_string_p;
+        na_tag_t na_sm_max_tag;
+        na_return_t na_ret;
+
+        if (hg_init_info.sm_info_string != NULL) {
+            rc = snprintf(info_string, HG_CORE_ADDR_MAX_SIZE, "na+sm://%s",
+                hg_init_info.sm_info_string);
+            HG_CHECK_SUBSYS_ERROR(cls, rc < 0 || rc > HG_CORE_ADDR_MAX_SIZE,
+                error, ret, HG_OVERFLOW, "snprintf() failed, rc: %d", rc);
+            info_string_p = info_string;
+        } else
+            info_string_p = "na+sm";
+
+        /* Initialize NA SM first so that tmp directories are created */
+        hg_core_class->core_class.na_sm_class =
+            NA_Initialize_opt2(info_string_p, hg_core_class->init_info.listen,
+                na_version, na_init_info_p);
+        HG_CHECK_SUBSYS_ERROR(cls,
+            hg_core_class->core_class.na_sm_class == NULL, error, ret,
+            HG_NA_ERROR,
+            "Could not initialize NA SM class (info_string=%s, listen=%d)",
+            info_string_p, hg_core_class->init_info.listen);
+
+        /* Get SM host ID */
+        na_ret = NA_SM_Host_id_get(&hg_core_class->host_id);
+        HG_CHECK_SUBSYS_ERROR(cls, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "NA_SM_Host_id_get() failed (%s)",
+            NA_Error_to_string(na_ret));
+
+        /* Get max tag */
+        na_sm_max_tag =
+            NA_Msg_get_max_tag(hg_core_class->core_class.na_sm_class);
+        HG_CHECK_SUBSYS_ERROR(cls, na_sm_max_tag == 0, error, ret, HG_NA_ERROR,
+            "NA Max tag is not defined");
+        hg_core_class->request_max_tag =
+            MIN(hg_core_class->request_max_tag, na_sm_max_tag);
+    }
+#else
+    HG_CHECK_SUBSYS_WARNING(cls, hg_init_info.auto_sm,
+        "Option auto_sm requested but NA SM pluging was not compiled, "
+        "please turn ON NA_USE_SM in CMake options");
+#endif
+
+    /* Split tag space into per-context ranges when it is large enough */
+    {
+        unsigned int tag_bits = 0;
+
+        while (tag_bits < 32 && ((UINT64_C(1) << (tag_bits + 1)) - 1) <=
+                                    (uint64_t) hg_core_class->request_max_tag)
+            tag_bits++;
+        hg_core_class->request_tag_shift =
+            (tag_bits >= HG_CORE_REQUEST_TAG_RANGE_BITS +
+                             HG_CORE_REQUEST_TAG_MIN_BITS)
+                ? tag_bits - HG_CORE_REQUEST_TAG_RANGE_BITS
+                : 0;
+    }
+
+    *class_p = hg_core_class;
+
+    return HG_SUCCESS;
+
+error:
+    if (hg_core_class->core_class.na_class != NULL &&
+        !hg_core_class->init_info.na_ext_init) {
+        na_return_t na_ret = NA_Finalize(hg_core_class->core_class.na_class);
+        HG_CHECK_SUBSYS_ERROR_DONE(cls, na_ret != NA_SUCCESS,
+            "Could not finalize NA class (%s)", NA_Error_to_string(na_ret));
+    }
+#ifdef NA_HAS_SM
+    if (hg_core_class->core_class.na_sm_class != NULL) {
+        na_return_t na_ret = NA_Finalize(hg_core_class->core_class.na_sm_class);
+        HG_CHECK_SUBSYS_ERROR_DONE(cls, na_ret != NA_SUCCESS,
+            "Could not finalize NA SM class (%s)", NA_Error_to_string(na_ret));
+    }
+#endif
+    hg_core_addr_map_finalize(&hg_core_class->addr_map);
+    if (hg_core_class->trace != NULL)
+        hg_core_trace_destroy(hg_core_class->trace);
+
+error_map:
+    hg_core_map_finalize(&hg_core_class->rpc_map);
+
+error_lock:
+    (void) hg_thread_spin_destroy(&hg_core_class->context_list.lock);
+
+error_free:
+    free(hg_core_class);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_finalize(struct hg_core_private_class *hg_core_class)
+{
+    int32_t n_addrs, n_contexts, n_bulks;
+    hg_return_t ret;
+
+    if (hg_core_class == NULL)
+        return HG_SUCCESS;
+
+    n_bulks = hg_atomic_get32(&hg_core_class->n_bulks);
+    HG_CHECK_SUBSYS_ERROR(cls, n_bulks != 0, error, ret, HG_BUSY,
+        "HG bulk handles must be destroyed before finalizing HG (%d "
+        "remaining)",
+        n_bulks);
+
+    n_contexts = hg_atomic_get32(&hg_core_class->n_contexts);
+    HG_CHECK_SUBSYS_ERROR(cls, n_contexts != 0, error, ret, HG_BUSY,
+        "HG contexts must be destroyed before finalizing HG (%d remaining)",
+        n_contexts);
+
+    n_addrs = hg_atomic_get32(&hg_core_class->n_addrs);
+    HG_CHECK_SUBSYS_ERROR(cls, n_addrs != 0, error, ret, HG_BUSY,
+        "HG addrs must be freed before finalizing HG (%d remaining)", n_addrs);
+
+    /* Finalize NA class */
+    if (hg_core_class->core_class.na_class != NULL &&
+        !hg_core_class->init_info.na_ext_init) {
+        na_return_t na_ret = NA_Finalize(hg_core_class->core_class.na_class);
+        HG_CHECK_SUBSYS_ERROR(cls, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "Could not finalize NA class (%s)",
+            NA_Error_to_string(na_ret));
+        hg_core_class->core_class.na_class = NULL;
+    }
+
+#ifdef NA_HAS_SM
+    /* Finalize NA SM class */
+    if (hg_core_class->core_class.na_sm_class != NULL) {
+        na_return_t na_ret = NA_Finalize(hg_core_class->core_class.na_sm_class);
+        HG_CHECK_SUBSYS_ERROR(cls, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "Could not finalize NA SM class (%s)",
+            NA_Error_to_string(na_ret));
+        hg_core_class->core_class.na_sm_class = NULL;
+    }
+#endif
+
+    /* Free user data */
+    if (hg_core_class->core_class.data_free_callback)
+        hg_core_class->core_class.data_free_callback(
+            hg_core_class->core_class.data);
+
+    /* Print RPC latencies before the map goes away */
+    if (hg_core_class->init_info.stats)
+        hg_core_rpc_hist_dump(&hg_core_class->rpc_map);
+
+    /* Write handle trace */
+    if (hg_core_class->trace != NULL) {
+        ret = hg_core_trace_dump(
+            hg_core_class->trace, hg_core_class->trace->file);
+        HG_CHECK_SUBSYS_ERROR_DONE(cls, ret != HG_SUCCESS,
+            "Could not write trace to %s", hg_core_class->trace->file);
+        hg_core_trace_destroy(hg_core_class->trace);
+        hg_core_class->trace = NULL;
+    }
+
+    /* Delete RPC map */
+    hg_core_map_finalize(&hg_core_class->rpc_map);
+    hg_core_addr_map_finalize(&hg_core_class->addr_map);
+    (void) hg_thread_spin_destroy(&hg_core_class->context_list.lock);
+    free(hg_core_class);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_core_bulk_incr(hg_core_class_t *hg_core_class)
+{
+    hg_atomic_incr32(
+        &((struct hg_core_private_class *) hg_core_class)->n_bulks);
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_core_bulk_decr(hg_core_class_t *hg_core_class)
+{
+    hg_atomic_decr32(
+        &((struct hg_core_private_class *) hg_core_class)->n_bulks);
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_context_create(struct hg_core_private_class *hg_core_class, uint8_t id,
+    int numa_node, struct hg_core_private_context **context_p)
+{
+    struct hg_core_private_context *context = NULL;
+    struct hg_core_completion_cond *completion_cond = NULL;
+    struct hg_mem_numa_policy prev_policy;
+    bool numa_entered;
+    hg_return_t ret;
+    unsigned int i;
+    int na_poll_fd, loopback_event = 0, rc;
+    bool completion_cond_mutex_init = false, completion_cond_cond_init = false,
+         loopback_notify_mutex_init = false, user_list_lock_init = false,
+         internal_list_lock_init = false, handle_depot_init = false,
+         batch_list_init = false, timer_wheel_init = false;
+#ifdef HG_HAS_MULTI_PROGRESS
+    struct hg_core_progress_multi *progress_multi = NULL;
+    bool progress_multi_mutex_init = false, progress_multi_cond_init = false;
+#endif
+
+    /* Resources of the context, including NA ones, are allocated on its node */
+    numa_entered = hg_core_numa_enter(numa_node, &prev_policy);
+
+    context = (struct hg_core_private_context *) calloc(1, sizeof(*context));
+    HG_CHECK_SUBSYS_ERROR(ctx, context == NULL, error, ret, HG_NOMEM,
+        "Could not allocate HG context");
+    context->numa_node = numa_node;
+    hg_atomic_init32(&context->n_handles, 0);
+    hg_atomic_init32(&context->unposting, 0);
+
+    context->core_context.core_class = (struct hg_core_class *) hg_core_class;
+    completion_cond = &context->completion_cond;
+
+    STAILQ_INIT(&completion_cond->overflow);
+    hg_atomic_init32(&completion_cond->waiters, 0);
+    hg_atomic_init32(&completion_cond->overflow_count, 0);
+    rc = hg_thread_mutex_init(&completion_cond->mutex);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+        "hg_thread_mutex_init() failed");
+    completion_cond_mutex_init = true;
+    rc = hg_thread_cond_init(&completion_cond->cond);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+        "hg_thread_cond_init() failed");
+    completion_cond_cond_init = true;
+
+    for (i = 0; i < HG_PRIORITY_MAX; i++) {
+        context->completion_queues[i] = hg_atomic_seg_queue_alloc(
+            hg_core_class->init_info.completion_queue_size);
+        HG_CHECK_SUBSYS_ERROR(ctx, context->completion_queues[i] == NULL,
+            error, ret, HG_NOMEM, "Could not allocate queue");
+    }
+    hg_atomic_init32(&context->completion_ticket, 0);
+
+    /* Stats are padded so that counters written while progressing do not
+     * share cache lines with counters written by other threads */
+    context->stats = (struct hg_core_context_stats *) hg_mem_aligned_alloc(
+        HG_MEM_CACHE_LINE_SIZE, sizeof(*context->stats));
+    HG_CHECK_SUBSYS_ERROR(ctx, context->stats == NULL, error, ret, HG_NOMEM,
+        "Could not allocate context stats");
+    memset(context->stats, 0, sizeof(*context->stats));
+
+    /* Start by spinning up to the max until arrivals are observed */
+    context->progress_spin.max =
+        (int64_t) hg_core_class->init_info.progress_spin_max * 1000;
+    hg_atomic_init64(&context->progress_spin.interval,
+        context->progress_spin.max);
+    hg_atomic_init64(&context->progress_spin.last, 0);
+    hg_time_get_current(&context->progress_spin.start);
+
+    /* Notifications of completion queue events */
+    hg_atomic_init32(&context->loopback_notify.must_notify, 0);
+    hg_atomic_init32(&context->loopback_notify.nevents, 0);
+    rc = hg_thread_mutex_init(&context->loopback_notify.mutex);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+        "hg_thread_mutex_init() failed");
+    loopback_notify_mutex_init = true;
+
+    LIST_INIT(&context->user_list.list);
+    rc = hg_thread_spin_init(&context->user_list.lock);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+        "hg_thread_spin_init() failed");
+    user_list_lock_init = true;
+
+    LIST_INIT(&context->internal_list.list);
+    rc = hg_thread_spin_init(&context->internal_list.lock);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+        "hg_thread_spin_init() failed");
+    internal_list_lock_init = true;
+
+    /* Per-thread caches of destroyed user handles */
+    ret = hg_core_handle_depot_init(&context->handle_depot);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        ctx, error, ret, "Could not initialize handle depot");
+    handle_depot_init = true;
+
+    ret = hg_core_batch_list_init(&context->batch_list);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        ctx, error, ret, "Could not initialize batch list");
+    batch_list_init = true;
+
+    /* Timer wheel for forward deadlines, slots are zeroed lists */
+    hg_atomic_init32(&context->timer_wheel.count, 0);
+    rc = hg_thread_mutex_init(&context->timer_wheel.mutex);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+        "hg_thread_mutex_init() failed");
+    timer_wheel_init = true;
+
+#ifdef HG_HAS_MULTI_PROGRESS
+    /* Initialize multi-progress lock */
+    progress_multi = &context->progress_multi;
+    hg_atomic_init32(&progress_multi->count, 0);
+    rc = hg_thread_mutex_init(&progress_multi->mutex);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+        "hg_thread_mutex_init() failed");
+    progress_multi_mutex_init = true;
+
+    rc = hg_thread_cond_init(&progress_multi->cond);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+        "hg_thread_cond_init() failed");
+    progress_multi_cond_init = true;
+#endif
+
+    /* Create NA context */
+    context->core_context.na_context =
+        NA_Context_create_id(hg_core_class->core_class.na_class, id);
+    HG_CHECK_SUBSYS_ERROR(ctx, context->core_context.na_context == NULL, error,
+        ret, HG_NOMEM, "Could not create NA context");
+
+#ifdef NA_HAS_SM
+    if (hg_core_class->core_class.na_sm_class) {
+        context->core_context.na_sm_context =
+            NA_Context_create(hg_core_class->core_class.na_sm_class);
+        HG_CHECK_SUBSYS_ERROR(ctx, context->core_context.na_sm_context == NULL,
+            error, ret, HG_NOMEM, "Could not create NA SM context");
+    }
+#endif
+
+    /* Handle buffers are carved out of hugepage-backed chunks */
+    if (hg_core_class->init_info.hugepage_arena) {
+        ret = hg_core_arena_create(
+            hg_core_class->core_class.na_class, &context->arena);
+        HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret, "Could not create arena");
+#ifdef NA_HAS_SM
+        if (context->core_context.na_sm_context != NULL) {
+            ret = hg_core_arena_create(
+                hg_core_class->core_class.na_sm_class, &context->sm_arena);
+            HG_CHECK_SUBSYS_HG_ERROR(
+                ctx, error, ret, "Could not create SM arena");
+        }
+#endif
+    }
+
+    /* If NA plugin exposes fd, we will use poll set and use appropriate
+     * progress function */
+    na_poll_fd = NA_Poll_get_fd(
+        hg_core_class->core_class.na_class, context->core_context.na_context);
+
+    if (!(hg_core_class->init_info.progress_mode & NA_NO_BLOCK) &&
+        (na_poll_fd > 0)) {
+        struct hg_poll_event event = {.events = HG_POLLIN, .data.u64 = 0};
+
+        /* Create poll set */
+        context->poll_set = hg_poll_create();
+        HG_CHECK_SUBSYS_ERROR(ctx, context->poll_set == NULL, error, ret,
+            HG_NOMEM, "Could not create poll set");
+
+        event.data.u32 = (uint32_t) HG_CORE_POLL_NA;
+        rc = hg_poll_add(context->poll_set, na_poll_fd, &event);
+        HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+            "hg_poll_add() failed (na_poll_fd=%d)", na_poll_fd);
+        context->na_event = na_poll_fd;
+
+#ifdef NA_HAS_SM
+        if (hg_core_class->core_class.na_sm_class &&
+            context->core_context.na_sm_context) {
+            na_poll_fd = NA_Poll_get_fd(hg_core_class->core_class.na_sm_class,
+                context->core_context.na_sm_context);
+            HG_CHECK_SUBSYS_ERROR(ctx, na_poll_fd < 0, error, ret,
+                HG_PROTOCOL_ERROR, "Could not get NA SM poll fd");
+
+            event.data.u32 = (uint32_t) HG_CORE_POLL_SM;
+            rc = hg_poll_add(context->poll_set, na_poll_fd, &event);
+            HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret,
+                HG_NOMEM, "hg_poll_add() failed (na_poll_fd=%d)", na_poll_fd);
+            context->na_sm_event = na_poll_fd;
+        }
+#endif
+
+        if (hg_core_class->init_info.loopback) {
+            /* Create event for completion queue notification */
+            loopback_event = hg_event_create();
+            HG_CHECK_SUBSYS_ERROR(ctx, loopback_event < 0, error, ret, HG_NOMEM,
+                "Could not create event");
+
+            /* Add event to context poll set */
+            event.data.u32 = (uint32_t) HG_CORE_POLL_LOOPBACK;
+            rc = hg_poll_add(context->poll_set, loopback_event, &event);
+            HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret,
+                HG_NOMEM, "hg_poll_add() failed (loopback_event=%d)",
+                loopback_event);
+            context->loopback_notify.event = loopback_event;
+        }
+    }
+
+    /* Assign context ID */
+    context->core_context.id = id;
+
+    /* Create pool of bulk op IDs */
+    ret = hg_bulk_op_pool_create((hg_core_context_t *) context,
+        HG_CORE_BULK_OP_INIT_COUNT, &context->hg_bulk_op_pool);
+    HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret, "Could not create bulk op pool");
+
+    /* Increment context count of parent class */
+    hg_atomic_incr32(&HG_CORE_CONTEXT_CLASS(context)->n_contexts);
+
+    hg_thread_spin_lock(&hg_core_class->context_list.lock);
+    LIST_INSERT_HEAD(&hg_core_class->context_list.list, context, entry);
+    hg_core_tag_range_alloc(context);
+    hg_thread_spin_unlock(&hg_core_class->context_list.lock);
+
+    hg_core_numa_leave(numa_entered, &prev_policy);
+
+    *context_p = context;
+
+    return HG_SUCCESS;
+
+error:
+    if (context != NULL) {
+        if (context->poll_set != NULL) {
+            if (context->na_event > 0) {
+                rc = hg_poll_remove(context->poll_set, context->na_event);
+                HG_CHECK_SUBSYS_ERROR_DONE(ctx, rc != HG_UTIL_SUCCESS,
+                    "Could not remove NA poll descriptor from poll set");
+            }
+#ifdef NA_HAS_SM
+            if (context->na_sm_event > 0) {
+                rc = hg_poll_remove(context->poll_set, context->na_sm_event);
+                HG_CHECK_SUBSYS_ERROR_DONE(ctx, rc != HG_UTIL_SUCCESS,
+                    "Could not remove NA SM poll descriptor from poll set");
+            }
+#endif
+            if (context->loopback_notify.event > 0) {
+                rc = hg_poll_remove(
+                    context->poll_set, context->loopback_notify.event);
+                HG_CHECK_SUBSYS_ERROR_DONE(ctx, rc != HG_UTIL_SUCCESS,
+                    "Could not remove loopback poll descriptor from poll set");
+            }
+            rc = hg_poll_destroy(context->poll_set);
+            HG_CHECK_SUBSYS_ERROR_DONE(
+                ctx, rc != HG_UTIL_SUCCESS, "Could not destroy poll set");
+        }
+
+        if (loopback_event > 0) {
+            rc = hg_event_destroy(loopback_event);
+            HG_CHECK_SUBSYS_ERROR_DONE(
+                ctx, rc != HG_UTIL_SUCCESS, "Could not destroy loopback event");
+        }
+
+        if (context->arena != NULL)
+            hg_core_arena_destroy(context->arena);
+#ifdef NA_HAS_SM
+        if (context->sm_arena != NULL)
+            hg_core_arena_destroy(context->sm_arena);
+#endif
+
+        if (context->core_context.na_context != NULL) {
+            na_return_t na_ret =
+                NA_Context_destroy(hg_core_class->core_class.na_class,
+                    context->core_context.na_context);
+            HG_CHECK_SUBSYS_ERROR_DONE(ctx, na_ret != NA_SUCCESS,
+                "Could not destroy NA context (%s)",
+                NA_Error_to_string(na_ret));
+        }
+#ifdef NA_HAS_SM
+        if (context->core_context.na_sm_context != NULL) {
+            na_return_t na_ret =
+                NA_Context_destroy(hg_core_class->core_class.na_sm_class,
+                    context->core_context.na_sm_context);
+            HG_CHECK_SUBSYS_ERROR_DONE(ctx, na_ret != NA_SUCCESS,
+                "Could not destroy NA SM context (%s)",
+                NA_Error_to_string(na_ret));
+        }
+#endif
+
+        if (completion_cond_mutex_init)
+            (void) hg_thread_mutex_destroy(&completion_cond->mutex);
+        if (completion_cond_cond_init)
+            (void) hg_thread_cond_destroy(&completion_cond->cond);
+        if (loopback_notify_mutex_init)
+            (void) hg_thread_mutex_destroy(&context->loopback_notify.mutex);
+        if (user_list_lock_init)
+            (void) hg_thread_spin_destroy(&context->user_list.lock);
+        if (internal_list_lock_init)
+            (void) hg_thread_spin_destroy(&context->internal_list.lock);
+        if (handle_depot_init)
+            hg_core_handle_depot_finalize(&context->handle_depot);
+        if (batch_list_init)
+            hg_core_batch_list_finalize(&context->batch_list);
+        if (timer_wheel_init)
+            (void) hg_thread_mutex_destroy(&context->timer_wheel.mutex);
+#ifdef HG_HAS_MULTI_PROGRESS
+        if (progress_multi_mutex_init)
+            (void) hg_thread_mutex_destroy(&progress_multi->mutex);
+        if (progress_multi_cond_init)
+            (void) hg_thread_cond_destroy(&progress_multi->cond);
+#endif
+        for (i = 0; i < HG_PRIORITY_MAX; i++)
+            hg_atomic_seg_queue_free(context->completion_queues[i]);
+        hg_mem_aligned_free(context->stats);
+        free(context);
+    }
+    hg_core_numa_leave(numa_entered, &prev_policy);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_context_destroy(struct hg_core_private_context *context)
+{
+    struct hg_core_private_class *hg_core_class = NULL;
+#ifdef HG_HAS_MULTI_PROGRESS
+    struct hg_core_progress_multi *progress_multi = NULL;
+#endif
+    bool empty;
+    hg_return_t ret;
+    unsigned int i;
+    int rc;
+
+    if (context == NULL)
+        return HG_SUCCESS;
+
+    /* Keep reference to class */
+    hg_core_class = HG_CORE_CONTEXT_CLASS(context);
+#ifdef HG_HAS_MULTI_PROGRESS
+    /* Check that we are no longer progressing */
+    progress_multi = &context->progress_multi;
+    HG_CHECK_SUBSYS_ERROR(ctx, hg_atomic_get32(&progress_multi->count) > 0,
+        error, ret, HG_BUSY, "Still progressing on context");
+#endif
+
+    if (context->posted) {
+        /* Unpost requests */
+        ret = hg_core_context_unpost(context, HG_CORE_CLEANUP_TIMEOUT);
+        HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret, "Could not unpost requests");
+    }
+
+    /* Send coalesced messages so that their handles can complete */
+    hg_core_batch_flush(context);
+
+    /* Wait on created list (user created handles) */
+    ret = hg_core_context_list_wait(
+        context, &context->user_list, HG_CORE_CLEANUP_TIMEOUT);
+    HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret, "Could not wait on handle list");
+
+    /* Number of handles for that context should be 0 */
+    if (hg_atomic_get32(&context->n_handles) > 0) {
+        HG_LOG_SUBSYS_ERROR(ctx,
+            "HG core handles must be freed before destroying context (%" PRId32
+            " remaining)",
+            hg_atomic_get32(&context->n_handles));
+
+        ret = hg_core_context_check_handle_list(&context->user_list);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            ctx, error, ret, "User-created handles are still in use");
+
+        ret = hg_core_context_check_handle_list(&context->internal_list);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            ctx, error, ret, "Internal handles are still in use");
+    }
+
+    /* Check that completion queue is empty now */
+    empty = (hg_core_completion_count(context) == 0);
+    HG_CHECK_SUBSYS_ERROR(ctx, empty == false, error, ret, HG_BUSY,
+        "Completion queue should be empty");
+
+    /* Free cached user handles */
+    hg_core_handle_depot_finalize(&context->handle_depot);
+
+    /* Free batches, all coalesced requests have completed at this point */
+    hg_core_batch_list_finalize(&context->batch_list);
+
+    /* No deadline remains armed once all handles have completed */
+    (void) hg_thread_mutex_destroy(&context->timer_wheel.mutex);
+
+    /* Destroy pool of bulk op IDs */
+    if (context->hg_bulk_op_pool != NULL) {
+        hg_bulk_op_pool_destroy(context->hg_bulk_op_pool);
+        context->hg_bulk_op_pool = NULL;
+    }
+
+    /* Free arenas, handle buffers have all been returned */
+    if (context->arena != NULL) {
+        hg_core_arena_destroy(context->arena);
+        context->arena = NULL;
+    }
+#ifdef NA_HAS_SM
+    if (context->sm_arena != NULL) {
+        hg_core_arena_destroy(context->sm_arena);
+        context->sm_arena = NULL;
+    }
+#endif
+
+    /* Stop listening for events */
+    if (context->loopback_notify.event > 0) {
+        rc = hg_poll_remove(context->poll_set, context->loopback_notify.event);
+        HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret,
+            HG_NOENTRY, "Could not remove loopback notify event from poll set");
+
+        rc = hg_event_destroy(context->loopback_notify.event);
+        HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret,
+            HG_NOENTRY, "Could not destroy loopback notify event");
+        context->loopback_notify.event = 0;
+    }
+
+    if (context->na_event > 0) {
+        rc = hg_poll_remove(context->poll_set, context->na_event);
+        HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret,
+            HG_NOENTRY, "Could not remove NA event from poll set");
+        context->na_event = 0;
+    }
+
+#ifdef NA_HAS_SM
+    if (context->na_sm_event > 0) {
+        rc = hg_poll_remove(context->poll_set, context->na_sm_event);
+        HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret,
+            HG_NOENTRY, "Could not remove NA SM event from poll set");
+        context->na_sm_event = 0;
+    }
+#endif
+
+    /* Destroy poll set */
+    if (context->poll_set != NULL) {
+        rc = hg_poll_destroy(context->poll_set);
+        HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_FAULT,
+            "Could not destroy poll set");
+        context->poll_set = NULL;
+    }
+
+    /* Destroy NA context */
+    if (context->core_context.na_context != NULL) {
+        na_return_t na_ret =
+            NA_Context_destroy(context->core_context.core_class->na_class,
+                context->core_context.na_context);
+        HG_CHECK_SUBSYS_ERROR(ctx, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "Could not destroy NA context (%s)",
+            NA_Error_to_string(na_ret));
+        context->core_context.na_context = NULL;
+    }
+
+#ifdef NA_HAS_SM
+    /* Destroy NA SM context */
+    if (context->core_context.na_sm_context) {
+        na_return_t na_ret =
+            NA_Context_destroy(context->core_context.core_class->na_sm_class,
+                context->core_context.na_sm_context);
+        HG_CHECK_SUBSYS_ERROR(ctx, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "Could not destroy NA SM context (%s)",
+            NA_Error_to_string(na_ret));
+        context->core_context.na_sm_context = NULL;
+    }
+#endif
+
+    /* Free user data */
+    if (context->core_context.data_free_callback)
+        context->core_context.data_free_callback(context->core_context.data);
+
+    /* Destroy completion queue mutex/cond */
+    (void) hg_thread_mutex_destroy(&context->completion_cond.mutex);
+    (void) hg_thread_cond_destroy(&context->completion_cond.cond);
+    (void) hg_thread_mutex_destroy(&context->loopback_notify.mutex);
+    (void) hg_thread_spin_destroy(&context->user_list.lock);
+    (void) hg_thread_spin_destroy(&context->internal_list.lock);
+#ifdef HG_HAS_MULTI_PROGRESS
+    (void) hg_thread_mutex_destroy(&progress_multi->mutex);
+    (void) hg_thread_cond_destroy(&progress_multi->cond);
+#endif
+
+    /* Keep stats of destroyed contexts for class stats */
+    hg_thread_spin_lock(&hg_core_class->context_list.lock);
+    LIST_REMOVE(context, entry);
+    hg_core_tag_range_free(context);
+    hg_core_context_stats_sum(context, &hg_core_class->context_list.retired);
+    hg_thread_spin_unlock(&hg_core_class->context_list.lock);
+
+    for (i = 0; i < HG_PRIORITY_MAX; i++)
+        hg_atomic_seg_queue_free(context->completion_queues[i]);
+    hg_mem_aligned_free(context->stats);
+    free(context);
+
+    /* Decrement context count of parent class */
+    hg_atomic_decr32(&hg_core_class->n_contexts);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_context_post(struct hg_core_private_context *context)
+{
+    struct hg_core_private_class *hg_core_class =
+        HG_CORE_CONTEXT_CLASS(context);
+    unsigned long flags = HG_CORE_HANDLE_LISTEN;
+    struct hg_mem_numa_policy prev_policy;
+    bool numa_entered = false;
+    hg_return_t ret;
+
+    /* Allocate resources for "listening" on incoming RPCs */
+    HG_CHECK_SUBSYS_ERROR(ctx, !hg_core_class->init_info.listen, error, ret,
+        HG_OPNOTSUPPORTED, "Cannot post handles on non-listening class");
+
+    /* Handles, NA message buffers and multi-recv buffers are first touched
+     * here, place them on the node of the context */
+    numa_entered = hg_core_numa_enter(context->numa_node, &prev_policy);
+
+    /* Allocate multi-recv operations */
+    if (hg_core_class->init_info.multi_recv) {
+        ret = hg_core_context_multi_recv_alloc(context,
+            hg_core_class->core_class.na_class,
+            hg_core_class->init_info.request_post_init);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            ctx, error, ret, "Could not allocate multi-recv resources");
+        flags |= HG_CORE_HANDLE_MULTI_RECV;
+        if (hg_core_class->init_info.multi_recv_copy_threshold > 0 ||
+            hg_core_class->init_info.multi_recv_adaptive)
+            flags |= HG_CORE_HANDLE_MULTI_RECV_COPY;
+    }
+
+    /* Create pool of handles */
+    ret = hg_core_handle_pool_create(context,
+        hg_core_class->core_class.na_class, context->core_context.na_context,
+        flags, hg_core_class->init_info.request_post_init,
+        hg_core_class->init_info.request_post_incr, &context->handle_pool);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        ctx, error, ret, "Could not allocate pool of handles");
+
+#ifdef NA_HAS_SM
+    /* Create pool of SM handles */
+    if (context->core_context.na_sm_context != NULL) {
+        ret = hg_core_handle_pool_create(context,
+            hg_core_class->core_class.na_sm_class,
+            context->core_context.na_sm_context, HG_CORE_HANDLE_LISTEN,
+            hg_core_class->init_info.request_post_init,
+            hg_core_class->init_info.request_post_incr,
+            &context->sm_handle_pool);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            ctx, error, ret, "Could not allocate pool of SM handles");
+    }
+#endif
+
+    /* Only post multi-recv after pool of handles has been created */
+    if (hg_core_class->init_info.multi_recv) {
+        ret = hg_core_context_multi_recv_post(context,
+            hg_core_class->core_class.na_class,
+            context->core_context.na_context);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            ctx, error, ret, "Could not post multi-recv operations");
+    }
+
+    context->posted = true;
+
+    hg_core_numa_leave(numa_entered, &prev_policy);
+
+    return HG_SUCCESS;
+
+error:
+    if (context->handle_pool != NULL) {
+        (void) hg_core_handle_pool_unpost(
+            context->handle_pool, HG_CORE_CLEANUP_TIMEOUT);
+        hg_core_handle_pool_destroy(context->handle_pool);
+    }
+#ifdef NA_HAS_SM
+    if (context->sm_handle_pool != NULL) {
+        (void) hg_core_handle_pool_unpost(
+            context->sm_handle_pool, HG_CORE_CLEANUP_TIMEOUT);
+        hg_core_handle_pool_destroy(context->sm_handle_pool);
+    }
+#endif
+    if (hg_core_class->init_info.multi_recv)
+        hg_core_context_multi_recv_free(
+            context, hg_core_class->core_class.na_class);
+    hg_core_numa_leave(numa_entered, &prev_policy);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static bool
+hg_core_numa_enter(int numa_node, struct hg_mem_numa_policy *prev_policy)
+{
+    int rc;
+
+    if (numa_node < 0)
+        return false;
+
+    /* Placement is only a hint, allocations proceed if it cannot be set */
+    rc = hg_mem_numa_preferred_set(numa_node, prev_policy);
+    HG_CHECK_SUBSYS_WARNING(ctx, rc != HG_UTIL_SUCCESS,
+        "Could not prefer allocations on NUMA node %d", numa_node);
+
+    return rc == HG_UTIL_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_numa_leave(bool entered, const struct hg_mem_numa_policy *prev_policy)
+{
+    int rc;
+
+    if (!entered)
+        return;
+
+    rc = hg_mem_numa_policy_restore(prev_policy);
+    HG_CHECK_SUBSYS_WARNING(
+        ctx, rc != HG_UTIL_SUCCESS, "Could not restore memory policy");
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_context_unpost(
+    struct hg_core_private_context *context, unsigned int timeout_ms)
+{
+    struct hg_core_private_class *hg_core_class =
+        HG_CORE_CONTEXT_CLASS(context);
+    hg_return_t ret;
+
+    if (!hg_core_class->init_info.listen || !context->posted)
+        return HG_SUCCESS;
+
+    /* Prevent requests from being reposted as they complete */
+    hg_atomic_set32(&context->unposting, 1);
+
+    if (hg_core_class->init_info.multi_recv) {
+        ret = hg_core_context_multi_recv_unpost(context,
+            hg_core_class->core_class.na_class,
+            context->core_context.na_context);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            ctx, error, ret, "Could not unpost multi-recv operations");
+    }
+
+    if (context->handle_pool != NULL) {
+        ret = hg_core_handle_pool_unpost(context->handle_pool, timeout_ms);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            ctx, error, ret, "Could not unpost pool of handles");
+
+        hg_core_handle_pool_destroy(context->handle_pool);
+        context->handle_pool = NULL;
+    }
+
+#ifdef NA_HAS_SM
+    if (context->sm_handle_pool != NULL) {
+        ret = hg_core_handle_pool_unpost(context->sm_handle_pool, timeout_ms);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            ctx, error, ret, "Could not unpost pool of handles");
+
+        hg_core_handle_pool_destroy(context->sm_handle_pool);
+        context->sm_handle_pool = NULL;
+    }
+#endif
+
+    /* Wait on internal list */
+    ret =
+        hg_core_context_list_wait(context, &context->internal_list, timeout_ms);
+    HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret, "Could not wait on handle list");
+
+    if (hg_core_class->init_info.multi_recv)
+        hg_core_context_multi_recv_free(
+            context, hg_core_class->core_class.na_class);
+
+    context->posted = false;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_context_trim(struct hg_core_private_context *context)
+{
+    uint32_t trim_time =
+        HG_CORE_CONTEXT_CLASS(context)->init_info.request_trim_time;
+
+    if (trim_time == 0 || !context->posted ||
+        hg_atomic_get32(&context->unposting))
+        return;
+
+    if (context->handle_pool != NULL)
+        hg_core_handle_pool_trim(context->handle_pool, trim_time);
+#ifdef NA_HAS_SM
+    if (context->sm_handle_pool != NULL)
+        hg_core_handle_pool_trim(context->sm_handle_pool, trim_time);
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_context_multi_recv_alloc(struct hg_core_private_context *context,
+    na_class_t *na_class, unsigned int request_count)
+{
+    const struct hg_core_init_info *init_info =
+        &HG_CORE_CONTEXT_CLASS(context)->init_info;
+    unsigned int multi_recv_op_max = init_info->multi_recv_op_max,
+                 buf_count = multi_recv_op_max;
+    size_t unexpected_msg_size;
+    hg_return_t ret;
+    unsigned int i;
+
+    unexpected_msg_size = NA_Msg_get_max_unexpected_size(na_class);
+    HG_CHECK_SUBSYS_ERROR(ctx, unexpected_msg_size == 0, error, ret,
+        HG_INVALID_PARAM, "Invalid unexpected message size");
+    context->multi_recv_ops =
+        calloc(multi_recv_op_max, sizeof(*context->multi_recv_ops));
+    HG_CHECK_SUBSYS_ERROR(ctx, context->multi_recv_ops == NULL, error, ret,
+        HG_NOMEM, "Could not allocate %u multi-recv op entries",
+        multi_recv_op_max);
+    hg_atomic_init32(&context->multi_recv_copy_threshold,
+        (int32_t) init_info->multi_recv_copy_threshold);
+
+    /* Adaptive mode starts with fewer buffers, others are allocated on
+     * demand */
+    if (init_info->multi_recv_adaptive) {
+        struct hg_core_multi_recv_adapt *adapt;
+        int rc;
+
+        adapt = (struct hg_core_multi_recv_adapt *) calloc(1, sizeof(*adapt));
+        HG_CHECK_SUBSYS_ERROR(ctx, adapt == NULL, error, ret, HG_NOMEM,
+            "Could not allocate adaptive multi-recv state");
+        rc = hg_thread_mutex_init(&adapt->mutex);
+        if (rc != HG_UTIL_SUCCESS) {
+            free(adapt);
+            HG_GOTO_SUBSYS_ERROR(ctx, error, ret, HG_NOMEM,
+                "hg_thread_mutex_init() failed");
+        }
+        buf_count = MIN(HG_CORE_MULTI_RECV_OP_COUNT, multi_recv_op_max);
+        hg_buf_adapt_init(&adapt->bufs, request_count * unexpected_msg_size,
+            HG_CORE_MULTI_RECV_ADAPT_SIZE_FACTOR, buf_count,
+            HG_CORE_MULTI_RECV_ADAPT_OP_MIN, multi_recv_op_max,
+            (int32_t) init_info->multi_recv_copy_threshold);
+        context->multi_recv_adapt = adapt;
+    }
+
+    for (i = 0; i < multi_recv_op_max; i++) {
+        struct hg_core_multi_recv_op *multi_recv_op =
+            &context->multi_recv_ops[i];
+
+        multi_recv_op->context = context;
+        multi_recv_op->id = i;
+        multi_recv_op->op_id = NA_Op_create(na_class, NA_OP_MULTI);
+        HG_CHECK_SUBSYS_ERROR(ctx, multi_recv_op->op_id == NULL, error, ret,
+            HG_NOMEM, "Could not create new OP ID");
+        hg_atomic_init32(&multi_recv_op->last, 0);
+        hg_atomic_init32(&multi_recv_op->ref_count, 0);
+        hg_atomic_init32(&multi_recv_op->op_count, 0);
+        if (i >= buf_count)
+            continue;
+
+        /* Keep total buffer size as max of unexpected msg size x number of
+         * "pre-posted" operations. */
+        multi_recv_op->buf_size = request_count * unexpected_msg_size;
+
+        multi_recv_op->buf = NA_Msg_buf_alloc(na_class, multi_recv_op->buf_size,
+            init_info->hugepage_arena ? NA_MULTI_RECV | NA_HUGE : NA_MULTI_RECV,
+            &multi_recv_op->plugin_data);
+        HG_CHECK_SUBSYS_ERROR(ctx, multi_recv_op->buf == NULL, error, ret,
+            HG_NOMEM, "Could not allocate multi-recv buffer of size %zu",
+            multi_recv_op->buf_size);
+    }
+
+    return HG_SUCCESS;
+
+error:
+    if (context->multi_recv_ops == NULL)
+        return ret;
+
+    for (i = 0; i < multi_recv_op_max; i++) {
+        struct hg_core_multi_recv_op *multi_recv_op =
+            &context->multi_recv_ops[i];
+        NA_Op_destroy(na_class, multi_recv_op->op_id);
+        multi_recv_op->op_id = NULL;
+        if (multi_recv_op->buf != NULL)
+            NA_Msg_buf_free(
+                na_class, multi_recv_op->buf, multi_recv_op->plugin_data);
+        multi_recv_op->buf = NULL;
+        multi_recv_op->plugin_data = NULL;
+        multi_recv_op->buf_size = 0;
+    }
+    free(context->multi_recv_ops);
+    context->multi_recv_ops = NULL;
+    if (context->multi_recv_adapt != NULL) {
+        (void) hg_thread_mutex_destroy(&context->multi_recv_adapt->mutex);
+        free(context->multi_recv_adapt);
+        context->multi_recv_adapt = NULL;
+    }
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_context_multi_recv_free(
+    struct hg_core_private_context *context, na_class_t *na_class)
+{
+    unsigned int multi_recv_op_max =
+        HG_CORE_CONTEXT_CLASS(context)->init_info.multi_recv_op_max;
+    unsigned int i;
+
+    if (context->multi_recv_ops == NULL)
+        return;
+
+    for (i = 0; i < multi_recv_op_max; i++) {
+        struct hg_core_multi_recv_op *multi_recv_op =
+            &context->multi_recv_ops[i];
+
+        HG_CHECK_SUBSYS_WARNING(ctx,
+            hg_atomic_get32(&multi_recv_op->ref_count) != 0,
+            "Freeing multi-recv operation that is still being referenced "
+            "(%" PRId32 ")",
+            hg_atomic_get32(&multi_recv_op->ref_count));
+
+        NA_Op_destroy(na_class, multi_recv_op->op_id);
+        multi_recv_op->op_id = NULL;
+        if (multi_recv_op->buf != NULL)
+            NA_Msg_buf_free(
+                na_class, multi_recv_op->buf, multi_recv_op->plugin_data);
+        multi_recv_op->buf = NULL;
+        multi_recv_op->plugin_data = NULL;
+        multi_recv_op->buf_size = 0;
+    }
+    free(context->multi_recv_ops);
+    context->multi_recv_ops = NULL;
+    if (context->multi_recv_adapt != NULL) {
+        (void) hg_thread_mutex_destroy(&context->multi_recv_adapt->mutex);
+        free(context->multi_recv_adapt);
+        context->multi_recv_adapt = NULL;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_context_multi_recv_post(struct hg_core_private_context *context,
+    na_class_t *na_class, na_context_t *na_context)
+{
+    unsigned int multi_recv_op_max =
+        HG_CORE_CONTEXT_CLASS(context)->init_info.multi_recv_op_max;
+    int32_t posted_count = 0;
+    hg_return_t ret;
+    unsigned int i;
+
+    /* Ensure we have enough recvs pre-posted so that handles can be re-assigned
+     * a new buffer until the previous buffer can be safely re-used once it's
+     * consumed. */
+    for (i = 0; i < multi_recv_op_max; i++) {
+        struct hg_core_multi_recv_op *multi_recv_op =
+            &context->multi_recv_ops[i];
+
+        /* Not allocated yet (adaptive) */
+        if (multi_recv_op->buf == NULL)
+            continue;
+
+        ret = hg_core_post_multi(multi_recv_op, na_class, na_context);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            ctx, error, ret, "Could not post multi-recv buffer %u", i);
+        posted_count++;
+    }
+    hg_atomic_init32(&context->multi_recv_op_count, posted_count);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_context_multi_recv_unpost(struct hg_core_private_context *context,
+    na_class_t *na_class, na_context_t *na_context)
+{
+    unsigned int multi_recv_op_max =
+        HG_CORE_CONTEXT_CLASS(context)->init_info.multi_recv_op_max;
+    hg_return_t ret;
+    unsigned int i;
+
+    for (i = 0; i < multi_recv_op_max; i++) {
+        struct hg_core_multi_recv_op *multi_recv_op =
+            &context->multi_recv_ops[i];
+        na_return_t na_ret;
+
+        if (multi_recv_op->buf == NULL)
+            continue;
+
+        na_ret = NA_Cancel(na_class, na_context, multi_recv_op->op_id);
+        HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "NA_Cancel() of multi-recv op failed (%s)",
+            NA_Error_to_string(na_ret));
+    }
+
+    while (hg_atomic_get32(&context->multi_recv_op_count) != 0) {
+        ret = hg_core_progress_na(na_class, na_context, NULL);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            ctx, error, ret, "Could not make progress on NA");
+    }
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_context_check_handle_list(struct hg_core_handle_list *handle_list)
+{
+    struct hg_core_private_handle *hg_core_handle = NULL;
+    hg_return_t ret;
+
+    hg_thread_spin_lock(&handle_list->lock);
+
+    if (LIST_EMPTY(&handle_list->list))
+        HG_GOTO_DONE(unlock, ret, HG_SUCCESS);
+
+    LIST_FOREACH (hg_core_handle, &handle_list->list, created) {
+        /* TODO ideally we'd want the upper layer to print that */
+        if (hg_core_handle->core_handle.data)
+            HG_LOG_SUBSYS_ERROR(ctx, "Handle (%p) was not destroyed",
+                hg_core_handle->core_handle.data);
+        HG_LOG_SUBSYS_DEBUG(
+            ctx, "Core handle (%p) was not destroyed", (void *) hg_core_handle);
+    }
+    ret = HG_BUSY;
+
+unlock:
+    hg_thread_spin_unlock(&handle_list->lock);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_context_list_wait(struct hg_core_private_context *context,
+    struct hg_core_handle_list *handle_list, unsigned int timeout_ms)
+{
+    bool list_empty = false;
+    hg_time_t deadline, now = hg_time_from_ms(0);
+    unsigned int count = hg_core_completion_count(context);
+    hg_return_t ret;
+
+    if (timeout_ms != 0)
+        hg_time_get_current_ms(&now);
+    deadline = hg_time_add(now, hg_time_from_ms(timeout_ms));
+
+    /* Make first progress pass without waiting to empty trigger queues */
+    ret = hg_core_progress_wait(context, 0);
+    HG_CHECK_SUBSYS_ERROR_NORET(ctx, ret != HG_SUCCESS && ret != HG_TIMEOUT,
+        error, "Could not make progress");
+
+    for (;;) {
+        /* Trigger everything we can from HG */
+        hg_core_trigger(context, count, NULL);
+
+        /* Make progress until list is empty */
+        hg_thread_spin_lock(&handle_list->lock);
+        list_empty = LIST_EMPTY(&handle_list->list);
+        hg_thread_spin_unlock(&handle_list->lock);
+        if (list_empty)
+            break;
+
+        /* Gives a chance to always call trigger after progress */
+        if (timeout_ms != 0)
+            hg_time_get_current_ms(&now);
+        if (!hg_time_less(now, deadline))
+            break;
+
+        ret = hg_core_progress(context, &count);
+        HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret, "Could not make progress");
+    }
+
+    HG_LOG_SUBSYS_DEBUG(ctx, "List empty: %d (timeout=%u ms)", list_empty,
+        hg_time_to_ms(hg_time_subtract(deadline, now)));
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_core_addr_ref_incr(struct hg_core_addr *core_addr)
+{
+    hg_atomic_incr32(&((struct hg_core_private_addr *) core_addr)->ref_count);
+}
+
+/*---------------------------------------------------------------------------*/
+struct hg_bulk_op_pool *
+hg_core_context_get_bulk_op_pool(struct hg_core_context *core_context)
+{
+    return ((struct hg_core_private_context *) core_context)->hg_bulk_op_pool;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_handle_pool_create(struct hg_core_private_context *context,
+    na_class_t *na_class, na_context_t *na_context, unsigned long flags,
+    unsigned int init_count, unsigned int incr_count,
+    struct hg_core_handle_pool **hg_core_handle_pool_p)
+{
+    struct hg_core_handle_pool *hg_core_handle_pool = NULL;
+    bool pending_list_lock_init = false, extend_mutex_init = false,
+         extend_cond_init = false;
+    hg_return_t ret;
+    unsigned int i;
+    int rc;
+
+    HG_LOG_SUBSYS_DEBUG(ctx,
+        "Creating pool of handles (init_count=%u, incr_count=%u)", init_count,
+        init_count);
+
+    hg_core_handle_pool =
+        (struct hg_core_handle_pool *) calloc(1, sizeof(*hg_core_handle_pool));
+    HG_CHECK_SUBSYS_ERROR(ctx, hg_core_handle_pool == NULL, error, ret,
+        HG_NOMEM, "Could not allocate handle pool");
+
+    LIST_INIT(&hg_core_handle_pool->pending_list.list);
+    rc = hg_thread_spin_init(&hg_core_handle_pool->pending_list.lock);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+        "hg_thread_spin_init() failed");
+    pending_list_lock_init = true;
+
+    rc = hg_thread_mutex_init(&hg_core_handle_pool->extend_mutex);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+        "hg_thread_mutex_init() failed");
+    extend_mutex_init = true;
+    hg_thread_cond_init(&hg_core_handle_pool->extend_cond);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+        "hg_thread_cond_init() failed");
+    extend_cond_init = true;
+
+    hg_core_handle_pool->count = init_count;
+    hg_core_handle_pool->init_count = init_count;
+    hg_core_handle_pool->incr_count = incr_count;
+    hg_core_handle_pool->extending = false;
+    hg_core_handle_pool->context = context;
+    hg_core_handle_pool->na_class = na_class;
+    hg_core_handle_pool->na_context = na_context;
+    hg_core_handle_pool->flags = flags;
 
-/*******************/
-/* Local Variables */
-/*******************/
+    for (i = 0; i < init_count; i++) {
+        ret = hg_core_handle_pool_insert(
+            context, na_class, na_context, flags, hg_core_handle_pool);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            ctx, error, ret, "Could not insert handle %u into pool", i);
+    }
 
-/* Callback type string table */
-#define X(a) #a,
-#ifdef HG_HAS_DEBUG
-static const char *const hg_core_op_type_name_g[] = {HG_CORE_OP_TYPE};
-#endif
-#undef X
+    HG_LOG_SUBSYS_DEBUG(
+        ctx, "Created handle pool (%p)", (void *) hg_core_handle_pool);
 
-/* Default ops */
-static const struct hg_core_ops hg_core_ops_na_g = {
-    .forward = hg_core_forward_na,
-    .respond = hg_core_respond_na,
-    .trigger = hg_core_trigger_na};
+    *hg_core_handle_pool_p = hg_core_handle_pool;
 
-static const struct hg_core_ops hg_core_ops_self_g = {
-    .forward = hg_core_forward_self,
-    .respond = hg_core_respond_self,
-    .trigger = hg_core_trigger_self};
+    return HG_SUCCESS;
+
+error:
+    if (hg_core_handle_pool != NULL) {
+        struct hg_core_private_handle *hg_core_handle;
+
+        hg_core_handle = LIST_FIRST(&hg_core_handle_pool->pending_list.list);
+        while (hg_core_handle) {
+            struct hg_core_private_handle *hg_core_handle_next =
+                LIST_NEXT(hg_core_handle, pending);
+            LIST_REMOVE(hg_core_handle, pending);
+
+            /* Prevent re-initialization */
+            hg_core_handle->reuse = false;
+
+            /* Destroy handle */
+            (void) hg_core_destroy(hg_core_handle);
+            hg_core_handle = hg_core_handle_next;
+        }
+
+        if (pending_list_lock_init)
+            (void) hg_thread_spin_destroy(
+                &hg_core_handle_pool->pending_list.lock);
+        if (extend_mutex_init)
+            (void) hg_thread_mutex_destroy(&hg_core_handle_pool->extend_mutex);
+        if (extend_cond_init)
+            (void) hg_thread_cond_destroy(&hg_core_handle_pool->extend_cond);
+
+        free(hg_core_handle_pool);
+    }
+    return ret;
+}
 
 /*---------------------------------------------------------------------------*/
-#ifdef HG_HAS_DEBUG
-static const char *
-hg_core_op_type_to_string(enum hg_core_op_type op_type)
+static void
+hg_core_handle_pool_destroy(struct hg_core_handle_pool *hg_core_handle_pool)
 {
-    return hg_core_op_type_name_g[op_type];
+    struct hg_core_private_handle *hg_core_handle = NULL;
+
+    HG_LOG_DEBUG("Free handle pool (%p)", (void *) hg_core_handle_pool);
+
+    hg_thread_spin_lock(&hg_core_handle_pool->pending_list.lock);
+    hg_core_handle = LIST_FIRST(&hg_core_handle_pool->pending_list.list);
+    while (hg_core_handle) {
+        struct hg_core_private_handle *hg_core_handle_next =
+            LIST_NEXT(hg_core_handle, pending);
+        LIST_REMOVE(hg_core_handle, pending);
+
+        /* Prevent re-initialization */
+        hg_core_handle->reuse = false;
+
+        /* Destroy handle */
+        (void) hg_core_destroy(hg_core_handle);
+        hg_core_handle = hg_core_handle_next;
+    }
+    hg_thread_spin_unlock(&hg_core_handle_pool->pending_list.lock);
+
+    (void) hg_thread_mutex_destroy(&hg_core_handle_pool->extend_mutex);
+    (void) hg_thread_cond_destroy(&hg_core_handle_pool->extend_cond);
+    (void) hg_thread_spin_destroy(&hg_core_handle_pool->pending_list.lock);
+
+    free(hg_core_handle_pool);
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE bool
+hg_core_handle_pool_empty(struct hg_core_handle_pool *hg_core_handle_pool)
+{
+    bool ret;
+
+    hg_thread_spin_lock(&hg_core_handle_pool->pending_list.lock);
+    ret = LIST_EMPTY(&hg_core_handle_pool->pending_list.list);
+    hg_thread_spin_unlock(&hg_core_handle_pool->pending_list.lock);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_handle_pool_get(struct hg_core_handle_pool *hg_core_handle_pool,
+    struct hg_core_private_handle **hg_core_handle_p)
+{
+    struct hg_core_private_handle *hg_core_handle;
+    hg_return_t ret;
+
+    do {
+        hg_thread_spin_lock(&hg_core_handle_pool->pending_list.lock);
+        hg_core_handle = LIST_FIRST(&hg_core_handle_pool->pending_list.list);
+        if (hg_core_handle != NULL) {
+            LIST_REMOVE(hg_core_handle, pending);
+            if (--hg_core_handle_pool->pending_count <
+                hg_core_handle_pool->pending_min)
+                hg_core_handle_pool->pending_min =
+                    hg_core_handle_pool->pending_count;
+            hg_thread_spin_unlock(&hg_core_handle_pool->pending_list.lock);
+            break;
+        }
+        hg_thread_spin_unlock(&hg_core_handle_pool->pending_list.lock);
+
+        /* Grow pool when needed, up to request_max handles */
+        if (!hg_core_handle_pool_extendable(hg_core_handle_pool))
+            return HG_BUSY;
+        ret = hg_core_handle_pool_extend(hg_core_handle_pool);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            ctx, error, ret, "Could not extend pool of handles");
+
+    } while (hg_core_handle == NULL);
+
+    *hg_core_handle_p = hg_core_handle;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_handle_pool_get_busy(struct hg_core_handle_pool *hg_core_handle_pool,
+    struct hg_core_private_handle **hg_core_handle_p)
+{
+    struct hg_core_private_context *context = hg_core_handle_pool->context;
+    struct hg_core_private_handle *hg_core_handle = NULL;
+    struct hg_core_private_addr *hg_core_addr = NULL;
+    hg_return_t ret;
+
+    /* Request is always copied so that multi-recv buffer is released early */
+    ret = hg_core_create(context, hg_core_handle_pool->na_class,
+        hg_core_handle_pool->na_context,
+        hg_core_handle_pool->flags | HG_CORE_HANDLE_MULTI_RECV_COPY,
+        &hg_core_handle);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        ctx, error, ret, "Could not create HG core handle");
+
+    hg_atomic_set32(&hg_core_handle->status, 0);
+    hg_atomic_set32(&hg_core_handle->ret_status, (int32_t) HG_SUCCESS);
+
+    ret = hg_core_addr_create(HG_CORE_CONTEXT_CLASS(context), &hg_core_addr);
+    HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret, "Could not create HG addr");
+    hg_core_handle->core_handle.info.addr = (hg_core_addr_t) hg_core_addr;
+
+    /* Freed instead of being returned to the pool once done */
+    hg_core_handle->reuse = false;
+    hg_core_handle->busy = true;
+    hg_core_stats_add(&context->stats->progress.rpc_req_busy, 1);
+    HG_LOG_SUBSYS_DEBUG(rpc,
+        "Rejecting handle %p, pool already holds %u handles",
+        (void *) hg_core_handle, hg_core_handle_pool->count);
+
+    *hg_core_handle_p = hg_core_handle;
+
+    return HG_SUCCESS;
+
+error:
+    (void) hg_core_destroy(hg_core_handle);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE bool
+hg_core_handle_pool_extendable(
+    const struct hg_core_handle_pool *hg_core_handle_pool)
+{
+    uint32_t request_max =
+        HG_CORE_CONTEXT_CLASS(hg_core_handle_pool->context)
+            ->init_info.request_max;
+
+    return (request_max == 0) || (hg_core_handle_pool->count < request_max);
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_handle_pool_extend(struct hg_core_handle_pool *hg_core_handle_pool)
+{
+    uint32_t request_max =
+        HG_CORE_CONTEXT_CLASS(hg_core_handle_pool->context)
+            ->init_info.request_max;
+    struct hg_mem_numa_policy prev_policy;
+    unsigned int incr_count, i;
+    bool numa_entered;
+    hg_return_t ret = HG_SUCCESS;
+
+    /* Create another batch of IDs if empty */
+    hg_thread_mutex_lock(&hg_core_handle_pool->extend_mutex);
+    if (hg_core_handle_pool->extending) {
+        hg_thread_cond_wait(&hg_core_handle_pool->extend_cond,
+            &hg_core_handle_pool->extend_mutex);
+        hg_thread_mutex_unlock(&hg_core_handle_pool->extend_mutex);
+        return HG_SUCCESS;
+    }
+    hg_core_handle_pool->extending = true;
+    hg_thread_mutex_unlock(&hg_core_handle_pool->extend_mutex);
+
+    /* Do not grow past request_max handles */
+    incr_count = hg_core_handle_pool->incr_count;
+    if (request_max > 0)
+        incr_count = (hg_core_handle_pool->count < request_max)
+                         ? MIN(incr_count,
+                               request_max - hg_core_handle_pool->count)
+                         : 0;
+
+    numa_entered = hg_core_numa_enter(
+        hg_core_handle_pool->context->numa_node, &prev_policy);
+
+    /* Only a single thread can extend the pool */
+    for (i = 0; i < incr_count; i++) {
+        ret = hg_core_handle_pool_insert(hg_core_handle_pool->context,
+            hg_core_handle_pool->na_class, hg_core_handle_pool->na_context,
+            hg_core_handle_pool->flags, hg_core_handle_pool);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            ctx, unlock, ret, "Could not insert handle %u into pool", i);
+    }
+    hg_core_handle_pool->count += incr_count;
+    hg_core_stats_add_shared(
+        &hg_core_handle_pool->context->stats->shared.handle_pool_grow, 1);
+
+unlock:
+    hg_core_numa_leave(numa_entered, &prev_policy);
+
+    hg_thread_mutex_lock(&hg_core_handle_pool->extend_mutex);
+    hg_core_handle_pool->extending = false;
+    hg_thread_cond_broadcast(&hg_core_handle_pool->extend_cond);
+    hg_thread_mutex_unlock(&hg_core_handle_pool->extend_mutex);
+
+    return ret;
 }
-#endif
 
 /*---------------------------------------------------------------------------*/
-#if defined(HG_HAS_DEBUG) && !defined(_WIN32)
 static void
-hg_core_counters_init(struct hg_core_counters *hg_core_counters)
+hg_core_handle_pool_trim(
+    struct hg_core_handle_pool *hg_core_handle_pool, uint32_t trim_time)
 {
-    /* TODO we could revert the linked list to avoid registration in reverse
-     * order */
-    HG_LOG_ADD_COUNTER64(hg_diag, &hg_core_counters->bulk_count, "bulk_count",
-        "Bulk transfers (inc. extra bulks)");
-    HG_LOG_ADD_COUNTER64(hg_diag, &hg_core_counters->rpc_resp_extra_count,
-        "rpc_resp_extra_count", "RPCs with extra bulk response");
-    HG_LOG_ADD_COUNTER64(hg_diag, &hg_core_counters->rpc_req_extra_count,
-        "rpc_req_extra_count", "RPCs with extra bulk request");
-    HG_LOG_ADD_COUNTER64(hg_diag, &hg_core_counters->rpc_resp_recv_count,
-        "rpc_resp_recv_count", "RPC responses received");
-    HG_LOG_ADD_COUNTER64(hg_diag, &hg_core_counters->rpc_resp_sent_count,
-        "rpc_resp_sent_count", "RPC responses sent");
-    HG_LOG_ADD_COUNTER64(hg_diag, &hg_core_counters->rpc_req_recv_count,
-        "rpc_req_recv_count", "RPC requests received");
-    HG_LOG_ADD_COUNTER64(hg_diag, &hg_core_counters->rpc_req_sent_count,
-        "rpc_req_sent_count", "RPC requests sent");
+    LIST_HEAD(, hg_core_private_handle) trim_list;
+    struct hg_core_private_handle *hg_core_handle;
+    unsigned int surplus, skip, i;
+    uint64_t now;
+
+    /* Pool was never extended */
+    if (hg_core_handle_pool->count <= hg_core_handle_pool->init_count)
+        return;
+
+    now = hg_core_timer_now();
+    if (now < hg_core_handle_pool->trim_time)
+        return;
+
+    /* Only a single thread can extend or trim the pool */
+    hg_thread_mutex_lock(&hg_core_handle_pool->extend_mutex);
+    if (hg_core_handle_pool->extending ||
+        now < hg_core_handle_pool->trim_time) {
+        hg_thread_mutex_unlock(&hg_core_handle_pool->extend_mutex);
+        return;
+    }
+    hg_core_handle_pool->extending = true;
+    hg_core_handle_pool->trim_time = now + trim_time;
+    hg_thread_mutex_unlock(&hg_core_handle_pool->extend_mutex);
+
+    LIST_INIT(&trim_list);
+
+    /* Handles that remained in the pending list since the last check were not
+     * needed, release them starting from the least recently used ones */
+    hg_thread_spin_lock(&hg_core_handle_pool->pending_list.lock);
+    surplus = MIN(hg_core_handle_pool->pending_min,
+        hg_core_handle_pool->count - hg_core_handle_pool->init_count);
+    skip = hg_core_handle_pool->pending_count - surplus;
+    hg_core_handle = LIST_FIRST(&hg_core_handle_pool->pending_list.list);
+    for (i = 0; i < surplus && hg_core_handle != NULL;) {
+        struct hg_core_private_handle *hg_core_handle_next =
+            LIST_NEXT(hg_core_handle, pending);
+
+        /* Skip handles still being canceled from a previous trim */
+        if (!hg_core_handle->reuse || skip > 0) {
+            if (hg_core_handle->reuse)
+                skip--;
+            hg_core_handle = hg_core_handle_next;
+            continue;
+        }
+
+        /* Free handle on completion, either canceled or once a request that
+         * raced with cancelation has been processed */
+        hg_core_handle->reuse = false;
+        if (hg_core_handle_pool->flags & HG_CORE_HANDLE_MULTI_RECV) {
+            LIST_REMOVE(hg_core_handle, pending);
+            LIST_INSERT_HEAD(&trim_list, hg_core_handle, pending);
+        } else {
+            hg_return_t ret = hg_core_cancel(hg_core_handle);
+            HG_CHECK_SUBSYS_ERROR_DONE(ctx, ret != HG_SUCCESS,
+                "Could not cancel handle (%p)", (void *) hg_core_handle);
+        }
+        hg_core_handle = hg_core_handle_next;
+        i++;
+    }
+    surplus = i;
+    hg_core_handle_pool->pending_count -= surplus;
+    hg_core_handle_pool->pending_min = hg_core_handle_pool->pending_count;
+    hg_core_handle_pool->count -= surplus;
+    hg_thread_spin_unlock(&hg_core_handle_pool->pending_list.lock);
+
+    while ((hg_core_handle = LIST_FIRST(&trim_list)) != NULL) {
+        LIST_REMOVE(hg_core_handle, pending);
+        (void) hg_core_destroy(hg_core_handle);
+    }
+
+    if (surplus > 0) {
+        HG_LOG_SUBSYS_DEBUG(ctx, "Trimmed %u handles from pool (%p)", surplus,
+            (void *) hg_core_handle_pool);
+        hg_core_stats_add_shared(
+            &hg_core_handle_pool->context->stats->shared.handle_pool_shrink,
+            1);
+    }
+
+    hg_thread_mutex_lock(&hg_core_handle_pool->extend_mutex);
+    hg_core_handle_pool->extending = false;
+    hg_thread_cond_broadcast(&hg_core_handle_pool->extend_cond);
+    hg_thread_mutex_unlock(&hg_core_handle_pool->extend_mutex);
 }
-#endif
 
 /*---------------------------------------------------------------------------*/
-static HG_INLINE na_tag_t
-hg_core_gen_request_tag(struct hg_core_private_class *hg_core_class)
+static HG_INLINE void
+hg_core_handle_pool_push(struct hg_core_handle_pool *hg_core_handle_pool,
+    struct hg_core_private_handle *hg_core_handle)
 {
-    na_tag_t request_tag = 0;
-
-    /* Compare and swap tag if reached max tag */
-    if (!hg_atomic_cas32(&hg_core_class->request_tag,
-            (int32_t) hg_core_class->request_max_tag, 0)) {
-        /* Increment tag */
-        request_tag = (na_tag_t) hg_atomic_incr32(&hg_core_class->request_tag);
-    }
+    hg_thread_spin_lock(&hg_core_handle_pool->pending_list.lock);
+    LIST_INSERT_HEAD(
+        &hg_core_handle_pool->pending_list.list, hg_core_handle, pending);
+    hg_core_handle_pool->pending_count++;
+    hg_thread_spin_unlock(&hg_core_handle_pool->pending_list.lock);
+}
 
-    return request_tag;
+/*---------------------------------------------------------------------------*/
+static HG_INLINE void
+hg_core_handle_pool_remove(struct hg_core_handle_pool *hg_core_handle_pool,
+    struct hg_core_private_handle *hg_core_handle)
+{
+    hg_thread_spin_lock(&hg_core_handle_pool->pending_list.lock);
+    LIST_REMOVE(hg_core_handle, pending);
+    /* Trimmed handles were already accounted for */
+    if (hg_core_handle->reuse && --hg_core_handle_pool->pending_count <
+                                     hg_core_handle_pool->pending_min)
+        hg_core_handle_pool->pending_min = hg_core_handle_pool->pending_count;
+    hg_thread_spin_unlock(&hg_core_handle_pool->pending_list.lock);
 }
 
 /*---------------------------------------------------------------------------*/
-static HG_INLINE hg_return_t
-hg_core_proc_header_request(struct hg_core_handle *hg_core_handle,
-    struct hg_core_header *hg_core_header, hg_proc_op_t op)
+static hg_return_t
+hg_core_handle_pool_insert(struct hg_core_private_context *context,
+    na_class_t *na_class, na_context_t *na_context, unsigned long flags,
+    struct hg_core_handle_pool *hg_core_handle_pool)
 {
-    char *header_buf =
-        (char *) hg_core_handle->in_buf + hg_core_handle->na_in_header_offset;
-    size_t header_buf_size =
-        hg_core_handle->in_buf_size - hg_core_handle->na_in_header_offset;
+    struct hg_core_private_handle *hg_core_handle = NULL;
+    struct hg_core_private_addr *hg_core_addr = NULL;
     hg_return_t ret;
+    bool post = false;
 
-    /* Proc request header */
-    ret = hg_core_header_request_proc(
-        op, header_buf, header_buf_size, hg_core_header);
+    /* Create new handle */
+    ret = hg_core_create(context, na_class, na_context, flags, &hg_core_handle);
     HG_CHECK_SUBSYS_HG_ERROR(
-        rpc, error, ret, "Could not process request header");
+        ctx, error, ret, "Could not create HG core handle");
 
-    if (op == HG_DECODE) {
-        ret = hg_core_header_request_verify(hg_core_header);
-        HG_CHECK_SUBSYS_HG_ERROR(
-            rpc, error, ret, "Could not verify request header");
+    /* Reset status */
+    hg_atomic_set32(&hg_core_handle->status, 0);
+    hg_atomic_set32(&hg_core_handle->ret_status, (int32_t) HG_SUCCESS);
+
+    /* Create new (empty) source addresses */
+    ret = hg_core_addr_create(HG_CORE_CONTEXT_CLASS(context), &hg_core_addr);
+    HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret, "Could not create HG addr");
+    hg_core_handle->core_handle.info.addr = (hg_core_addr_t) hg_core_addr;
+
+    /* Re-use handle on completion */
+    hg_core_handle->reuse = true;
+
+    /* Add handle to pending list */
+    hg_core_handle_pool_push(hg_core_handle_pool, hg_core_handle);
+
+    /* Handle is pre-posted only when muti-recv is off */
+    if (!(flags & HG_CORE_HANDLE_MULTI_RECV)) {
+        /* Handle will need to be posted */
+        post = true;
+
+        ret = hg_core_post(hg_core_handle);
+        HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret, "Could not post handle (%p)",
+            (void *) hg_core_handle);
     }
 
     return HG_SUCCESS;
 
 error:
+    if (hg_core_handle != NULL) {
+        if (post)
+            hg_core_handle_pool_remove(hg_core_handle_pool, hg_core_handle);
+        hg_core_handle->reuse = false;
+        (void) hg_core_destroy(hg_core_handle);
+    }
+
     return ret;
 }
 
 /*---------------------------------------------------------------------------*/
-static HG_INLINE hg_return_t
-hg_core_proc_header_response(struct hg_core_handle *hg_core_handle,
-    struct hg_core_header *hg_core_header, hg_proc_op_t op)
+static hg_return_t
+hg_core_handle_pool_unpost(
+    struct hg_core_handle_pool *hg_core_handle_pool, unsigned int timeout_ms)
 {
-    char *header_buf =
-        (char *) hg_core_handle->out_buf + hg_core_handle->na_out_header_offset;
-    size_t header_buf_size =
-        hg_core_handle->out_buf_size - hg_core_handle->na_out_header_offset;
+    struct hg_core_private_handle *hg_core_handle;
     hg_return_t ret;
 
-    /* Proc response header */
-    ret = hg_core_header_response_proc(
-        op, header_buf, header_buf_size, hg_core_header);
-    HG_CHECK_SUBSYS_HG_ERROR(
-        rpc, error, ret, "Could not process response header");
+    if (hg_core_handle_pool->flags & HG_CORE_HANDLE_MULTI_RECV)
+        return HG_SUCCESS; /* Nothing to do */
 
-    if (op == HG_DECODE) {
-        ret = hg_core_header_response_verify(hg_core_header);
-        HG_CHECK_SUBSYS_HG_ERROR(
-            rpc, error, ret, "Could not verify response header");
+    /* Check pending list and cancel posted handles */
+    hg_thread_spin_lock(&hg_core_handle_pool->pending_list.lock);
+
+    LIST_FOREACH (
+        hg_core_handle, &hg_core_handle_pool->pending_list.list, pending) {
+        /* Cancel handle */
+        ret = hg_core_cancel(hg_core_handle);
+        HG_CHECK_SUBSYS_HG_ERROR(ctx, unlock, ret,
+            "Could not cancel handle (%p)", (void *) hg_core_handle);
     }
 
+    hg_thread_spin_unlock(&hg_core_handle_pool->pending_list.lock);
+
+    /* Check that operations have completed */
+    ret = hg_core_context_list_wait(hg_core_handle_pool->context,
+        &hg_core_handle_pool->pending_list, timeout_ms);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        ctx, error, ret, "Could not wait on pool handle list");
+
     return HG_SUCCESS;
 
+unlock:
+    hg_thread_spin_unlock(&hg_core_handle_pool->pending_list.lock);
+
 error:
     return ret;
 }
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_init(const char *na_info_string, bool na_listen, unsigned int version,
-    const struct hg_init_info *hg_init_info_p,
-    struct hg_core_private_class **class_p)
+hg_core_handle_depot_init(struct hg_core_handle_depot *hg_core_handle_depot)
 {
-    struct hg_init_info hg_init_info = HG_INIT_INFO_INITIALIZER;
-    struct na_init_info na_init_info = NA_INIT_INFO_INITIALIZER;
-    unsigned int na_version = NA_VERSION(NA_VERSION_MAJOR, NA_VERSION_MINOR);
-    struct na_init_info *na_init_info_p = NULL;
-    struct hg_core_private_class *hg_core_class = NULL;
-#ifdef NA_HAS_SM
-    const char *na_class_name;
-#endif
     hg_return_t ret;
     int rc;
 
-    /* Prevent newer versions */
-    HG_CHECK_SUBSYS_ERROR(cls,
-        HG_VERSION_LT(HG_VERSION(HG_VERSION_MAJOR, HG_VERSION_MINOR), version),
-        error, ret, HG_INVALID_ARG, "API version cannot be newer than library");
-
-    /* Create new HG class */
-    hg_core_class =
-        (struct hg_core_private_class *) calloc(1, sizeof(*hg_core_class));
-    HG_CHECK_SUBSYS_ERROR(cls, hg_core_class == NULL, error_free, ret, HG_NOMEM,
-        "Could not allocate HG class");
-
-    hg_atomic_init32(&hg_core_class->request_tag, 0);
-    hg_atomic_init32(&hg_core_class->n_contexts, 0);
-    hg_atomic_init32(&hg_core_class->n_addrs, 0);
-    hg_atomic_init32(&hg_core_class->n_bulks, 0);
+    LIST_INIT(&hg_core_handle_depot->full_list);
+    LIST_INIT(&hg_core_handle_depot->empty_list);
+    LIST_INIT(&hg_core_handle_depot->cache_list);
+    hg_core_handle_depot->full_count = 0;
+    hg_core_handle_depot->finalized = false;
 
-    /* Initialize mutex */
-    rc = hg_thread_rwlock_init(&hg_core_class->rpc_map.lock);
-    HG_CHECK_SUBSYS_ERROR(cls, rc != HG_UTIL_SUCCESS, error_free, ret, HG_NOMEM,
-        "hg_thread_rwlock_init() failed");
+    rc = hg_thread_spin_init(&hg_core_handle_depot->lock);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+        "hg_thread_spin_init() failed");
 
-    /* Create new function map */
-    hg_core_class->rpc_map.map =
-        hg_hash_table_new(hg_core_map_hash, hg_core_map_equal);
-    HG_CHECK_SUBSYS_ERROR(cls, hg_core_class->rpc_map.map == NULL, error, ret,
-        HG_NOMEM, "Could not create RPC map");
+    rc = hg_thread_key_create2(
+        &hg_core_handle_depot->cache_key, hg_core_handle_cache_release);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error_key, ret, HG_NOMEM,
+        "hg_thread_key_create() failed");
 
-    /* Automatically free all the values with the hash map */
-    hg_hash_table_register_free_functions(
-        hg_core_class->rpc_map.map, NULL, hg_core_map_value_free);
+    return HG_SUCCESS;
 
-    /* Ensure init info is API compatible */
-    if (hg_init_info_p) {
-        HG_CHECK_SUBSYS_ERROR(cls, version == 0, error, ret, HG_INVALID_ARG,
-            "API version cannot be 0");
-        HG_LOG_SUBSYS_DEBUG(cls, "Init info version used: v%d.%d",
-            HG_MAJOR(version), HG_MINOR(version));
-        na_init_info_p = &na_init_info;
+error_key:
+    (void) hg_thread_spin_destroy(&hg_core_handle_depot->lock);
+error:
+    return ret;
+}
 
-        /* Get init info and overwrite defaults */
-        if (HG_VERSION_GE(version, HG_VERSION(2, 4))) {
-            hg_init_info = *hg_init_info_p;
-            na_init_info.traffic_class = hg_init_info.traffic_class;
-        } else if (HG_VERSION_GE(version, HG_VERSION(2, 3)))
-            hg_init_info_dup_2_3(&hg_init_info,
-                (const struct hg_init_info_2_3 *) hg_init_info_p);
-        else
-            hg_init_info_dup_2_2(&hg_init_info,
-                (const struct hg_init_info_2_2 *) hg_init_info_p);
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_handle_depot_finalize(struct hg_core_handle_depot *hg_core_handle_depot)
+{
+    LIST_HEAD(, hg_core_handle_cache) cache_list;
+    struct hg_core_handle_cache *hg_core_handle_cache;
+    struct hg_core_handle_mag *hg_core_handle_mag;
+
+    /* Threads that exit from now on no longer release their magazines */
+    (void) hg_thread_key_delete(hg_core_handle_depot->cache_key);
+
+    /* Threads that were already exiting may still be releasing their
+     * magazines, caches that remain listed are now owned by finalize */
+    LIST_INIT(&cache_list);
+    hg_thread_spin_lock(&hg_core_handle_depot->lock);
+    hg_core_handle_depot->finalized = true;
+    while ((hg_core_handle_cache =
+                   LIST_FIRST(&hg_core_handle_depot->cache_list)) != NULL) {
+        LIST_REMOVE(hg_core_handle_cache, entry);
+        LIST_INSERT_HEAD(&cache_list, hg_core_handle_cache, entry);
     }
+    hg_thread_spin_unlock(&hg_core_handle_depot->lock);
 
-    /* Set post init / incr / multi-recv values  */
-    hg_core_class->init_info.request_post_init =
-        (hg_init_info.request_post_init == 0) ? HG_CORE_POST_INIT
-                                              : hg_init_info.request_post_init;
-    if (hg_init_info.request_post_incr < 0)
-        hg_core_class->init_info.request_post_incr = 0;
-    else if (hg_init_info.request_post_incr == 0)
-        hg_core_class->init_info.request_post_incr = HG_CORE_POST_INCR;
-    else
-        hg_core_class->init_info.request_post_incr =
-            (uint32_t) hg_init_info.request_post_incr;
-    hg_core_class->init_info.multi_recv_op_max =
-        (hg_init_info.multi_recv_op_max == 0) ? HG_CORE_MULTI_RECV_OP_COUNT
-                                              : hg_init_info.multi_recv_op_max;
-
-    HG_CHECK_SUBSYS_ERROR(cls,
-        hg_init_info.multi_recv_copy_threshold >
-            (unsigned int) hg_core_class->init_info.multi_recv_op_max,
-        error, ret, HG_INVALID_ARG,
-        "multi_recv_copy_threshold (%u) cannot exceed multi_recv_op_max "
-        "(%u)",
-        hg_init_info.multi_recv_copy_threshold,
-        (unsigned int) hg_core_class->init_info.multi_recv_op_max);
-    hg_core_class->init_info.multi_recv_copy_threshold =
-        hg_init_info.multi_recv_copy_threshold;
-
-#ifdef HG_HAS_CHECKSUMS
-    /* Save checksum level */
-    hg_core_class->init_info.checksum_level = hg_init_info.checksum_level;
-#else
-    HG_CHECK_SUBSYS_WARNING(cls,
-        hg_init_info.checksum_level != HG_CHECKSUM_NONE,
-        "Option checksum_level requires CMake option MERCURY_USE_CHECKSUMS "
-        "to be turned ON.");
-    hg_core_class->init_info.checksum_level = HG_CHECKSUM_NONE;
-#endif
-
-    /* Save progress mode */
-    hg_core_class->init_info.progress_mode =
-        hg_init_info.na_init_info.progress_mode;
-
-    /* Loopback capability */
-    hg_core_class->init_info.loopback = !hg_init_info.no_loopback;
-
-    /* Listening */
-    hg_core_class->init_info.listen = na_listen;
-
-    /* Stats / counters */
-#if defined(HG_HAS_DEBUG) && !defined(_WIN32)
-    hg_core_counters_init(&hg_core_class->counters);
-#endif
-
-    if (hg_init_info.stats) {
-#ifdef HG_HAS_DEBUG
-        hg_log_set_subsys_level("diag", HG_LOG_LEVEL_DEBUG);
-#else
-        HG_LOG_SUBSYS_WARNING(cls, "stats option requires MERCURY_ENABLE_DEBUG "
-                                   "CMake option to be turned ON.");
-#endif
+    while ((hg_core_handle_cache = LIST_FIRST(&cache_list)) != NULL) {
+        LIST_REMOVE(hg_core_handle_cache, entry);
+        hg_core_handle_mag_free(hg_core_handle_cache->loaded);
+        hg_core_handle_mag_free(hg_core_handle_cache->previous);
+        free(hg_core_handle_cache);
     }
 
-    if (hg_init_info.na_class != NULL) {
-        /* External NA class */
-        hg_core_class->core_class.na_class = hg_init_info.na_class;
-        hg_core_class->init_info.na_ext_init = true;
-    } else {
-        /* Initialize NA if not provided externally */
-        hg_core_class->core_class.na_class = NA_Initialize_opt2(na_info_string,
-            hg_core_class->init_info.listen, na_version, na_init_info_p);
-        HG_CHECK_SUBSYS_ERROR(cls, hg_core_class->core_class.na_class == NULL,
-            error, ret, HG_NA_ERROR,
-            "Could not initialize NA class (info_string=%s, listen=%d)",
-            na_info_string, hg_core_class->init_info.listen);
+    while ((hg_core_handle_mag =
+                   LIST_FIRST(&hg_core_handle_depot->full_list)) != NULL) {
+        LIST_REMOVE(hg_core_handle_mag, entry);
+        hg_core_handle_mag_free(hg_core_handle_mag);
     }
 
-    /* Multi-recv capability */
-    hg_core_class->init_info.multi_recv =
-        NA_Has_opt_feature(
-            hg_core_class->core_class.na_class, NA_OPT_MULTI_RECV) &&
-        !hg_init_info.no_multi_recv;
-    HG_LOG_SUBSYS_DEBUG(
-        cls, "Multi-recv set to %" PRIu8, hg_core_class->init_info.multi_recv);
-    if (hg_core_class->init_info.multi_recv &&
-        (hg_core_class->init_info.request_post_incr == 0)) {
-        hg_core_class->init_info.request_post_incr = HG_CORE_POST_INCR;
-        HG_LOG_SUBSYS_WARNING(cls,
-            "Using multi-recv with no handle post increment is currently not "
-            "supported, resetting to default value of %d",
-            HG_CORE_POST_INCR);
+    while ((hg_core_handle_mag =
+                   LIST_FIRST(&hg_core_handle_depot->empty_list)) != NULL) {
+        LIST_REMOVE(hg_core_handle_mag, entry);
+        hg_core_handle_mag_free(hg_core_handle_mag);
     }
+    hg_core_handle_depot->full_count = 0;
 
-    /* Compute max request tag */
-    hg_core_class->request_max_tag =
-        NA_Msg_get_max_tag(hg_core_class->core_class.na_class);
-    HG_CHECK_SUBSYS_ERROR(cls, hg_core_class->request_max_tag == 0, error, ret,
-        HG_NA_ERROR, "NA Max tag is not defined");
+    (void) hg_thread_spin_destroy(&hg_core_handle_depot->lock);
+}
 
-#ifdef NA_HAS_SM
-    /* Retrieve NA class name */
-    na_class_name = NA_Get_class_name(hg_core_class->core_class.na_class);
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_handle_mag_free(struct hg_core_handle_mag *hg_core_handle_mag)
+{
+    unsigned int i;
 
-    /* Initialize SM plugin */
-    if (hg_init_info.auto_sm && ((strcmp(na_class_name, "mpi") == 0) ||
-                                    (strcmp(na_class_name, "na") == 0))) {
-        HG_LOG_SUBSYS_WARNING(cls,
-            "Auto SM mode is not compatible with current NA class, disabling");
-    } else if (hg_init_info.auto_sm) {
-        char info_string[HG_CORE_ADDR_MAX_SIZE], *info_string_p;
-        na_tag_t na_sm_max_tag;
-        na_return_t na_ret;
+    if (hg_core_handle_mag == NULL)
+        return;
 
-        if (hg_init_info.sm_info_string != NULL) {
-            rc = snprintf(info_string, HG_CORE_ADDR_MAX_SIZE, "na+sm://%s",
-                hg_init_info.sm_info_string);
-            HG_CHECK_SUBSYS_ERROR(cls, rc < 0 || rc > HG_CORE_ADDR_MAX_SIZE,
-                error, ret, HG_OVERFLOW, "snprintf() failed, rc: %d", rc);
-            info_string_p = info_string;
-        } else
-            info_string_p = "na+sm";
+    /* Cached handles are already detached from context */
+    for (i = 0; i < hg_core_handle_mag->count; i++) {
+        struct hg_core_private_handle *hg_core_handle =
+            hg_core_handle_mag->handles[i];
 
-        /* Initialize NA SM first so that tmp directories are created */
-        hg_core_class->core_class.na_sm_class =
-            NA_Initialize_opt2(info_string_p, hg_core_class->init_info.listen,
-                na_version, na_init_info_p);
-        HG_CHECK_SUBSYS_ERROR(cls,
-            hg_core_class->core_class.na_sm_class == NULL, error, ret,
-            HG_NA_ERROR,
-            "Could not initialize NA SM class (info_string=%s, listen=%d)",
-            info_string_p, hg_core_class->init_info.listen);
+        hg_core_free_na(hg_core_handle);
+        hg_core_header_request_finalize(&hg_core_handle->in_header);
+        hg_core_header_response_finalize(&hg_core_handle->out_header);
+        free(hg_core_handle);
+    }
 
-        /* Get SM host ID */
-        na_ret = NA_SM_Host_id_get(&hg_core_class->host_id);
-        HG_CHECK_SUBSYS_ERROR(cls, na_ret != NA_SUCCESS, error, ret,
-            (hg_return_t) na_ret, "NA_SM_Host_id_get() failed (%s)",
-            NA_Error_to_string(na_ret));
+    free(hg_core_handle_mag);
+}
 
-        /* Get max tag */
-        na_sm_max_tag =
-            NA_Msg_get_max_tag(hg_core_class->core_class.na_sm_class);
-        HG_CHECK_SUBSYS_ERROR(cls, na_sm_max_tag == 0, error, ret, HG_NA_ERROR,
-            "NA Max tag is not defined");
-        hg_core_class->request_max_tag =
-            MIN(hg_core_class->request_max_tag, na_sm_max_tag);
-    }
-#else
-    HG_CHECK_SUBSYS_WARNING(cls, hg_init_info.auto_sm,
-        "Option auto_sm requested but NA SM pluging was not compiled, "
-        "please turn ON NA_USE_SM in CMake options");
-#endif
+/*---------------------------------------------------------------------------*/
+static struct hg_core_handle_cache *
+hg_core_handle_cache_get(struct hg_core_handle_depot *hg_core_handle_depot)
+{
+    struct hg_core_handle_cache *hg_core_handle_cache;
+    int rc;
 
-    *class_p = hg_core_class;
+    hg_core_handle_cache =
+        (struct hg_core_handle_cache *) hg_thread_getspecific(
+            hg_core_handle_depot->cache_key);
+    if (hg_core_handle_cache != NULL)
+        return hg_core_handle_cache;
+
+    hg_core_handle_cache = (struct hg_core_handle_cache *) calloc(
+        1, sizeof(*hg_core_handle_cache));
+    HG_CHECK_SUBSYS_ERROR_NORET(rpc, hg_core_handle_cache == NULL, error,
+        "Could not allocate handle cache");
+    hg_core_handle_cache->depot = hg_core_handle_depot;
+
+    hg_core_handle_cache->loaded = (struct hg_core_handle_mag *) calloc(
+        1, sizeof(*hg_core_handle_cache->loaded));
+    HG_CHECK_SUBSYS_ERROR_NORET(rpc, hg_core_handle_cache->loaded == NULL,
+        error, "Could not allocate handle magazine");
+
+    hg_core_handle_cache->previous = (struct hg_core_handle_mag *) calloc(
+        1, sizeof(*hg_core_handle_cache->previous));
+    HG_CHECK_SUBSYS_ERROR_NORET(rpc, hg_core_handle_cache->previous == NULL,
+        error, "Could not allocate handle magazine");
+
+    rc = hg_thread_setspecific(
+        hg_core_handle_depot->cache_key, hg_core_handle_cache);
+    HG_CHECK_SUBSYS_ERROR_NORET(rpc, rc != HG_UTIL_SUCCESS, error,
+        "hg_thread_setspecific() failed");
+
+    /* Keep track of magazines so that they can be flushed */
+    hg_thread_spin_lock(&hg_core_handle_depot->lock);
+    LIST_INSERT_HEAD(
+        &hg_core_handle_depot->cache_list, hg_core_handle_cache, entry);
+    hg_thread_spin_unlock(&hg_core_handle_depot->lock);
 
-    return HG_SUCCESS;
+    return hg_core_handle_cache;
 
 error:
-    if (hg_core_class->core_class.na_class != NULL &&
-        !hg_core_class->init_info.na_ext_init) {
-        na_return_t na_ret = NA_Finalize(hg_core_class->core_class.na_class);
-        HG_CHECK_SUBSYS_ERROR_DONE(cls, na_ret != NA_SUCCESS,
-            "Could not finalize NA class (%s)", NA_Error_to_string(na_ret));
+    if (hg_core_handle_cache != NULL) {
+        free(hg_core_handle_cache->loaded);
+        free(hg_core_handle_cache->previous);
+        free(hg_core_handle_cache);
     }
-#ifdef NA_HAS_SM
-    if (hg_core_class->core_class.na_sm_class != NULL) {
-        na_return_t na_ret = NA_Finalize(hg_core_class->core_class.na_sm_class);
-        HG_CHECK_SUBSYS_ERROR_DONE(cls, na_ret != NA_SUCCESS,
-            "Could not finalize NA SM class (%s)", NA_Error_to_string(na_ret));
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_handle_cache_release(void *arg)
+{
+    struct hg_core_handle_cache *hg_core_handle_cache =
+        (struct hg_core_handle_cache *) arg;
+    struct hg_core_handle_depot *hg_core_handle_depot =
+        hg_core_handle_cache->depot;
+    struct hg_core_handle_mag *mags[2] = {
+        hg_core_handle_cache->loaded, hg_core_handle_cache->previous};
+    unsigned int i;
+
+    /* Magazines that still hold handles go back to the depot so that other
+     * threads can re-use them, others are freed */
+    hg_thread_spin_lock(&hg_core_handle_depot->lock);
+    if (hg_core_handle_depot->finalized) {
+        /* Cache is freed by hg_core_handle_depot_finalize() */
+        hg_thread_spin_unlock(&hg_core_handle_depot->lock);
+        return;
     }
-#endif
-    if (hg_core_class->rpc_map.map)
-        hg_hash_table_free(hg_core_class->rpc_map.map);
-    (void) hg_thread_rwlock_destroy(&hg_core_class->rpc_map.lock);
+    LIST_REMOVE(hg_core_handle_cache, entry);
+    for (i = 0; i < 2; i++) {
+        if (mags[i]->count > 0 &&
+            hg_core_handle_depot->full_count < HG_CORE_HANDLE_DEPOT_MAX) {
+            LIST_INSERT_HEAD(&hg_core_handle_depot->full_list, mags[i], entry);
+            hg_core_handle_depot->full_count++;
+            mags[i] = NULL;
+        }
+    }
+    hg_thread_spin_unlock(&hg_core_handle_depot->lock);
 
-error_free:
-    free(hg_core_class);
+    for (i = 0; i < 2; i++)
+        hg_core_handle_mag_free(mags[i]);
+    free(hg_core_handle_cache);
+}
 
-    return ret;
+/*---------------------------------------------------------------------------*/
+static struct hg_core_private_handle *
+hg_core_handle_cache_pop(struct hg_core_handle_depot *hg_core_handle_depot)
+{
+    struct hg_core_handle_cache *hg_core_handle_cache;
+    struct hg_core_handle_mag *hg_core_handle_mag;
+
+    hg_core_handle_cache = hg_core_handle_cache_get(hg_core_handle_depot);
+    if (hg_core_handle_cache == NULL)
+        return NULL;
+
+    if (hg_core_handle_cache->loaded->count == 0) {
+        if (hg_core_handle_cache->previous->count == 0) {
+            /* Exchange empty magazine for a full one from the depot */
+            hg_thread_spin_lock(&hg_core_handle_depot->lock);
+            hg_core_handle_mag = LIST_FIRST(&hg_core_handle_depot->full_list);
+            if (hg_core_handle_mag == NULL) {
+                hg_thread_spin_unlock(&hg_core_handle_depot->lock);
+                return NULL;
+            }
+            LIST_REMOVE(hg_core_handle_mag, entry);
+            hg_core_handle_depot->full_count--;
+            LIST_INSERT_HEAD(&hg_core_handle_depot->empty_list,
+                hg_core_handle_cache->previous, entry);
+            hg_thread_spin_unlock(&hg_core_handle_depot->lock);
+
+            hg_core_handle_cache->previous = hg_core_handle_mag;
+        }
+
+        /* Swap magazines */
+        hg_core_handle_mag = hg_core_handle_cache->loaded;
+        hg_core_handle_cache->loaded = hg_core_handle_cache->previous;
+        hg_core_handle_cache->previous = hg_core_handle_mag;
+    }
+
+    return hg_core_handle_cache->loaded
+        ->handles[--hg_core_handle_cache->loaded->count];
 }
 
 /*---------------------------------------------------------------------------*/
-static hg_return_t
-hg_core_finalize(struct hg_core_private_class *hg_core_class)
+static bool
+hg_core_handle_cache_push(struct hg_core_private_handle *hg_core_handle)
 {
-    int32_t n_addrs, n_contexts, n_bulks;
-    hg_return_t ret;
+    struct hg_core_private_context *context =
+        HG_CORE_HANDLE_CONTEXT(hg_core_handle);
+    struct hg_core_handle_depot *hg_core_handle_depot = &context->handle_depot;
+    struct hg_core_handle_cache *hg_core_handle_cache;
+    struct hg_core_handle_mag *hg_core_handle_mag;
 
-    if (hg_core_class == NULL)
-        return HG_SUCCESS;
+    /* Only user-created handles with NA resources are cached */
+    if (hg_core_handle->created_list != &context->user_list ||
+        hg_core_handle->na_class == NULL)
+        return false;
 
-    n_bulks = hg_atomic_get32(&hg_core_class->n_bulks);
-    HG_CHECK_SUBSYS_ERROR(cls, n_bulks != 0, error, ret, HG_BUSY,
-        "HG bulk handles must be destroyed before finalizing HG (%d "
-        "remaining)",
-        n_bulks);
+    hg_core_handle_cache = hg_core_handle_cache_get(hg_core_handle_depot);
+    if (hg_core_handle_cache == NULL)
+        return false;
 
-    n_contexts = hg_atomic_get32(&hg_core_class->n_contexts);
-    HG_CHECK_SUBSYS_ERROR(cls, n_contexts != 0, error, ret, HG_BUSY,
-        "HG contexts must be destroyed before finalizing HG (%d remaining)",
-        n_contexts);
+    if (hg_core_handle_cache->loaded->count == HG_CORE_HANDLE_MAG_SIZE) {
+        if (hg_core_handle_cache->previous->count == HG_CORE_HANDLE_MAG_SIZE) {
+            /* Exchange full magazine for an empty one from the depot */
+            hg_thread_spin_lock(&hg_core_handle_depot->lock);
+            if (hg_core_handle_depot->full_count == HG_CORE_HANDLE_DEPOT_MAX) {
+                hg_thread_spin_unlock(&hg_core_handle_depot->lock);
+                return false;
+            }
+            hg_core_handle_mag = LIST_FIRST(&hg_core_handle_depot->empty_list);
+            if (hg_core_handle_mag != NULL)
+                LIST_REMOVE(hg_core_handle_mag, entry);
+            hg_thread_spin_unlock(&hg_core_handle_depot->lock);
+
+            if (hg_core_handle_mag == NULL) {
+                hg_core_handle_mag = (struct hg_core_handle_mag *) calloc(
+                    1, sizeof(*hg_core_handle_mag));
+                if (hg_core_handle_mag == NULL)
+                    return false;
+            }
 
-    n_addrs = hg_atomic_get32(&hg_core_class->n_addrs);
-    HG_CHECK_SUBSYS_ERROR(cls, n_addrs != 0, error, ret, HG_BUSY,
-        "HG addrs must be freed before finalizing HG (%d remaining)", n_addrs);
+            hg_thread_spin_lock(&hg_core_handle_depot->lock);
+            if (hg_core_handle_depot->full_count == HG_CORE_HANDLE_DEPOT_MAX) {
+                LIST_INSERT_HEAD(&hg_core_handle_depot->empty_list,
+                    hg_core_handle_mag, entry);
+                hg_thread_spin_unlock(&hg_core_handle_depot->lock);
+                return false;
+            }
+            LIST_INSERT_HEAD(&hg_core_handle_depot->full_list,
+                hg_core_handle_cache->previous, entry);
+            hg_core_handle_depot->full_count++;
+            hg_thread_spin_unlock(&hg_core_handle_depot->lock);
 
-    /* Finalize NA class */
-    if (hg_core_class->core_class.na_class != NULL &&
-        !hg_core_class->init_info.na_ext_init) {
-        na_return_t na_ret = NA_Finalize(hg_core_class->core_class.na_class);
-        HG_CHECK_SUBSYS_ERROR(cls, na_ret != NA_SUCCESS, error, ret,
-            (hg_return_t) na_ret, "Could not finalize NA class (%s)",
-            NA_Error_to_string(na_ret));
-        hg_core_class->core_class.na_class = NULL;
-    }
+            hg_core_handle_cache->previous = hg_core_handle_mag;
+        }
 
-#ifdef NA_HAS_SM
-    /* Finalize NA SM class */
-    if (hg_core_class->core_class.na_sm_class != NULL) {
-        na_return_t na_ret = NA_Finalize(hg_core_class->core_class.na_sm_class);
-        HG_CHECK_SUBSYS_ERROR(cls, na_ret != NA_SUCCESS, error, ret,
-            (hg_return_t) na_ret, "Could not finalize NA SM class (%s)",
-            NA_Error_to_string(na_ret));
-        hg_core_class->core_class.na_sm_class = NULL;
+        /* Swap magazines */
+        hg_core_handle_mag = hg_core_handle_cache->loaded;
+        hg_core_handle_cache->loaded = hg_core_handle_cache->previous;
+        hg_core_handle_cache->previous = hg_core_handle_mag;
     }
-#endif
 
-    /* Free user data */
-    if (hg_core_class->core_class.data_free_callback)
-        hg_core_class->core_class.data_free_callback(
-            hg_core_class->core_class.data);
+    /* Handle no longer belongs to context until it is re-used */
+    hg_core_detach(hg_core_handle);
 
-    /* Delete RPC map */
-    if (hg_core_class->rpc_map.map != NULL) {
-        hg_hash_table_free(hg_core_class->rpc_map.map);
-        hg_core_class->rpc_map.map = NULL;
+    hg_core_handle_cache->loaded
+        ->handles[hg_core_handle_cache->loaded->count++] = hg_core_handle;
+
+    return true;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_map_init(struct hg_core_map *hg_core_map)
+{
+    struct hg_core_map_table *table;
+    hg_return_t ret;
+    unsigned int i;
+    int rc;
+
+    rc = hg_thread_mutex_init(&hg_core_map->lock);
+    HG_CHECK_SUBSYS_ERROR(cls, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+        "hg_thread_mutex_init() failed");
+
+    table = hg_core_map_table_alloc(HG_CORE_MAP_INIT_SIZE, 0);
+    HG_CHECK_SUBSYS_ERROR(cls, table == NULL, error_free, ret, HG_NOMEM,
+        "Could not allocate RPC map table");
+    hg_atomic_init64(&hg_core_map->table, (int64_t) (uintptr_t) table);
+    hg_atomic_init32(&hg_core_map->epoch, 0);
+    for (i = 0; i < HG_CORE_MAP_READERS; i++) {
+        hg_atomic_init32(&hg_core_map->readers[i].count[0], 0);
+        hg_atomic_init32(&hg_core_map->readers[i].count[1], 0);
     }
-    (void) hg_thread_rwlock_destroy(&hg_core_class->rpc_map.lock);
-    free(hg_core_class);
 
     return HG_SUCCESS;
 
+error_free:
+    (void) hg_thread_mutex_destroy(&hg_core_map->lock);
 error:
     return ret;
 }
 
 /*---------------------------------------------------------------------------*/
-void
-hg_core_bulk_incr(hg_core_class_t *hg_core_class)
+static void
+hg_core_map_finalize(struct hg_core_map *hg_core_map)
 {
-    hg_atomic_incr32(
-        &((struct hg_core_private_class *) hg_core_class)->n_bulks);
+    struct hg_core_map_table *table =
+        (struct hg_core_map_table *) (uintptr_t) hg_atomic_get64(
+            &hg_core_map->table);
+    unsigned int i;
+
+    if (table == NULL)
+        return;
+
+    for (i = 0; i < table->size; i++) {
+        struct hg_core_rpc_info *hg_core_rpc_info =
+            (struct hg_core_rpc_info *) (uintptr_t) hg_atomic_get64(
+                &table->slots[i]);
+
+        if (hg_core_rpc_info != NULL)
+            hg_core_map_value_free(hg_core_rpc_info);
+    }
+    free(table);
+    hg_atomic_set64(&hg_core_map->table, 0);
+
+    (void) hg_thread_mutex_destroy(&hg_core_map->lock);
 }
 
 /*---------------------------------------------------------------------------*/
-void
-hg_core_bulk_decr(hg_core_class_t *hg_core_class)
+static HG_INLINE uint64_t
+hg_core_map_mix(uint64_t x)
 {
-    hg_atomic_decr32(
-        &((struct hg_core_private_class *) hg_core_class)->n_bulks);
+    /* splitmix64 finalizer */
+    x ^= x >> 30;
+    x *= UINT64_C(0xbf58476d1ce4e5b9);
+    x ^= x >> 27;
+    x *= UINT64_C(0x94d049bb133111eb);
+    x ^= x >> 31;
+
+    return x;
 }
 
 /*---------------------------------------------------------------------------*/
-static hg_return_t
-hg_core_context_create(struct hg_core_private_class *hg_core_class, uint8_t id,
-    struct hg_core_private_context **context_p)
+static HG_INLINE unsigned int
+hg_core_map_index(const struct hg_core_map_table *table, hg_id_t id)
 {
-    struct hg_core_private_context *context = NULL;
-    struct hg_core_completion_queue *backfill_queue = NULL;
-    hg_return_t ret;
-    int na_poll_fd, loopback_event = 0, rc;
-    bool backfill_queue_mutex_init = false, backfill_queue_cond_init = false,
-         loopback_notify_mutex_init = false, user_list_lock_init = false,
-         internal_list_lock_init = false;
-#ifdef HG_HAS_MULTI_PROGRESS
-    struct hg_core_progress_multi *progress_multi = NULL;
-    bool progress_multi_mutex_init = false, progress_multi_cond_init = false;
-#endif
+    uint64_t hash = hg_core_map_mix(id);
 
-    context = (struct hg_core_private_context *) calloc(1, sizeof(*context));
-    HG_CHECK_SUBSYS_ERROR(ctx, context == NULL, error, ret, HG_NOMEM,
-        "Could not allocate HG context");
-    hg_atomic_init32(&context->n_handles, 0);
-    hg_atomic_init32(&context->unposting, 0);
+    /* Frozen tables displace each bucket of IDs so that no two IDs collide */
+    if (table->disp != NULL) {
+        uint64_t disp = table->disp[hash & table->disp_mask];
 
-    context->core_context.core_class = (struct hg_core_class *) hg_core_class;
-    backfill_queue = &context->backfill_queue;
+        hash = hg_core_map_mix(id ^ (disp * HG_CORE_MAP_GOLDEN));
+    }
 
-    STAILQ_INIT(&backfill_queue->queue);
-    hg_atomic_init32(&backfill_queue->count, 0);
-    rc = hg_thread_mutex_init(&backfill_queue->mutex);
-    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
-        "hg_thread_mutex_init() failed");
-    backfill_queue_mutex_init = true;
-    rc = hg_thread_cond_init(&backfill_queue->cond);
-    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
-        "hg_thread_cond_init() failed");
-    backfill_queue_cond_init = true;
+    return (unsigned int) (hash >> table->shift);
+}
+
+/*---------------------------------------------------------------------------*/
+static struct hg_core_map_table *
+hg_core_map_table_alloc(unsigned int size, unsigned int disp_count)
+{
+    struct hg_core_map_table *table;
+    unsigned int i;
 
-    context->completion_queue =
-        hg_atomic_queue_alloc(HG_CORE_ATOMIC_QUEUE_SIZE);
-    HG_CHECK_SUBSYS_ERROR(ctx, context->completion_queue == NULL, error, ret,
-        HG_NOMEM, "Could not allocate queue");
+    table = (struct hg_core_map_table *) malloc(sizeof(*table) +
+                                                size * sizeof(table->slots[0]) +
+                                                disp_count * sizeof(uint32_t));
+    if (table == NULL)
+        return NULL;
+
+    table->size = size;
+    table->count = 0;
+    for (table->shift = 64; size > 1; size >>= 1)
+        table->shift--;
+    for (i = 0; i < table->size; i++)
+        hg_atomic_init64(&table->slots[i], 0);
+
+    if (disp_count > 0) {
+        table->disp = (uint32_t *) ((char *) table + sizeof(*table) +
+                                    table->size * sizeof(table->slots[0]));
+        table->disp_mask = disp_count - 1;
+        memset(table->disp, 0, disp_count * sizeof(uint32_t));
+    } else {
+        table->disp = NULL;
+        table->disp_mask = 0;
+    }
 
-    /* Notifications of completion queue events */
-    hg_atomic_init32(&context->loopback_notify.must_notify, 0);
-    hg_atomic_init32(&context->loopback_notify.nevents, 0);
-    rc = hg_thread_mutex_init(&context->loopback_notify.mutex);
-    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
-        "hg_thread_mutex_init() failed");
-    loopback_notify_mutex_init = true;
+    return table;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE struct hg_core_rpc_info *
+hg_core_map_table_find(const struct hg_core_map_table *table, hg_id_t id)
+{
+    unsigned int index = hg_core_map_index(table, id), i;
+
+    /* Tables always keep empty slots so that probing stops */
+    for (i = 0; i < table->size; i++) {
+        struct hg_core_rpc_info *hg_core_rpc_info =
+            (struct hg_core_rpc_info *) (uintptr_t) hg_atomic_get64(
+                &table->slots[index]);
+
+        if (hg_core_rpc_info == NULL)
+            break;
+        if (hg_core_rpc_info->id == id)
+            return hg_core_rpc_info;
+        /* No probing in frozen tables */
+        if (table->disp != NULL)
+            break;
+        index = (index + 1) & (table->size - 1);
+    }
+
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_map_table_add(
+    struct hg_core_map_table *table, struct hg_core_rpc_info *hg_core_rpc_info)
+{
+    unsigned int index = hg_core_map_index(table, hg_core_rpc_info->id);
+
+    while (hg_atomic_get64(&table->slots[index]) != 0)
+        index = (index + 1) & (table->size - 1);
+
+    /* Entry must be initialized before readers can see it */
+    hg_atomic_set64(
+        &table->slots[index], (int64_t) (uintptr_t) hg_core_rpc_info);
+    table->count++;
+}
+
+/*---------------------------------------------------------------------------*/
+static bool
+hg_core_map_table_place(struct hg_core_map_table *table,
+    struct hg_core_rpc_info **entries, unsigned int count)
+{
+    unsigned int disp_count = (unsigned int) table->disp_mask + 1;
+    unsigned int *buckets = NULL, *bucket_sizes = NULL, *indices = NULL;
+    struct hg_core_rpc_info **bucket_entries = NULL;
+    unsigned int max_size = 0, size, i;
+    bool ret = false;
+
+    buckets = (unsigned int *) malloc(count * sizeof(*buckets));
+    bucket_sizes = (unsigned int *) calloc(disp_count, sizeof(*bucket_sizes));
+    if (buckets == NULL || bucket_sizes == NULL)
+        goto done;
+
+    for (i = 0; i < count; i++) {
+        buckets[i] =
+            (unsigned int) (hg_core_map_mix(entries[i]->id) & table->disp_mask);
+        if (++bucket_sizes[buckets[i]] > max_size)
+            max_size = bucket_sizes[buckets[i]];
+    }
+
+    bucket_entries = (struct hg_core_rpc_info **) malloc(
+        max_size * sizeof(*bucket_entries));
+    indices = (unsigned int *) malloc(max_size * sizeof(*indices));
+    if (bucket_entries == NULL || indices == NULL)
+        goto done;
+
+    /* Place largest buckets first while the table is still sparse */
+    for (size = max_size; size > 0; size--) {
+        unsigned int bucket;
+
+        for (bucket = 0; bucket < disp_count; bucket++) {
+            unsigned int n = 0;
+            uint32_t disp;
+
+            if (bucket_sizes[bucket] != size)
+                continue;
+
+            for (i = 0; i < count; i++)
+                if (buckets[i] == bucket)
+                    bucket_entries[n++] = entries[i];
+
+            /* Find displacement that sends all entries to free slots */
+            for (disp = 0; disp < HG_CORE_MAP_DISP_MAX; disp++) {
+                unsigned int j;
+
+                table->disp[bucket] = disp;
+                for (i = 0; i < n; i++) {
+                    indices[i] =
+                        hg_core_map_index(table, bucket_entries[i]->id);
+                    if (hg_atomic_get64(&table->slots[indices[i]]) != 0)
+                        break;
+                    for (j = 0; j < i; j++)
+                        if (indices[j] == indices[i])
+                            break;
+                    if (j < i)
+                        break;
+                }
+                if (i == n)
+                    break;
+            }
+            if (disp == HG_CORE_MAP_DISP_MAX)
+                goto done;
+
+            for (i = 0; i < n; i++)
+                hg_atomic_init64(&table->slots[indices[i]],
+                    (int64_t) (uintptr_t) bucket_entries[i]);
+        }
+    }
+    table->count = count;
+    ret = true;
+
+done:
+    free(buckets);
+    free(bucket_sizes);
+    free(bucket_entries);
+    free(indices);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE hg_atomic_int32_t *
+hg_core_map_read_begin(struct hg_core_map *hg_core_map)
+{
+    uint64_t hash = hg_core_map_mix((uint64_t) (uintptr_t) hg_thread_self());
+    int32_t parity = hg_atomic_get32(&hg_core_map->epoch) & 1;
+    hg_atomic_int32_t *readers =
+        &hg_core_map->readers[hash & (HG_CORE_MAP_READERS - 1)].count[parity];
 
-    LIST_INIT(&context->user_list.list);
-    rc = hg_thread_spin_init(&context->user_list.lock);
-    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
-        "hg_thread_spin_init() failed");
-    user_list_lock_init = true;
+    /* Counter must be visible to updates before the table is read */
+    hg_atomic_incr32(readers);
+    hg_atomic_fence();
 
-    LIST_INIT(&context->internal_list.list);
-    rc = hg_thread_spin_init(&context->internal_list.lock);
-    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
-        "hg_thread_spin_init() failed");
-    internal_list_lock_init = true;
+    return readers;
+}
 
-#ifdef HG_HAS_MULTI_PROGRESS
-    /* Initialize multi-progress lock */
-    progress_multi = &context->progress_multi;
-    hg_atomic_init32(&progress_multi->count, 0);
-    rc = hg_thread_mutex_init(&progress_multi->mutex);
-    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
-        "hg_thread_mutex_init() failed");
-    progress_multi_mutex_init = true;
+/*---------------------------------------------------------------------------*/
+static HG_INLINE void
+hg_core_map_read_end(hg_atomic_int32_t *readers)
+{
+    hg_atomic_decr32(readers);
+}
 
-    rc = hg_thread_cond_init(&progress_multi->cond);
-    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
-        "hg_thread_cond_init() failed");
-    progress_multi_cond_init = true;
-#endif
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_map_sync(struct hg_core_map *hg_core_map)
+{
+    unsigned int i, j;
 
-    /* Create NA context */
-    context->core_context.na_context =
-        NA_Context_create_id(hg_core_class->core_class.na_class, id);
-    HG_CHECK_SUBSYS_ERROR(ctx, context->core_context.na_context == NULL, error,
-        ret, HG_NOMEM, "Could not create NA context");
+    /* Flip epoch twice so that lookups that read the epoch before a flip but
+     * incremented their counter after it are also waited for */
+    for (i = 0; i < 2; i++) {
+        int32_t parity = hg_atomic_get32(&hg_core_map->epoch) & 1;
 
-#ifdef NA_HAS_SM
-    if (hg_core_class->core_class.na_sm_class) {
-        context->core_context.na_sm_context =
-            NA_Context_create(hg_core_class->core_class.na_sm_class);
-        HG_CHECK_SUBSYS_ERROR(ctx, context->core_context.na_sm_context == NULL,
-            error, ret, HG_NOMEM, "Could not create NA SM context");
+        hg_atomic_fence();
+        hg_atomic_incr32(&hg_core_map->epoch);
+        hg_atomic_fence();
+
+        /* Lookups are short and new ones use the other counters */
+        for (j = 0; j < HG_CORE_MAP_READERS; j++)
+            while (hg_atomic_get32(&hg_core_map->readers[j].count[parity]) != 0)
+                hg_thread_yield();
     }
-#endif
+}
 
-    /* If NA plugin exposes fd, we will use poll set and use appropriate
-     * progress function */
-    na_poll_fd = NA_Poll_get_fd(
-        hg_core_class->core_class.na_class, context->core_context.na_context);
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_map_publish(
+    struct hg_core_map *hg_core_map, struct hg_core_map_table *table)
+{
+    struct hg_core_map_table *old_table =
+        (struct hg_core_map_table *) (uintptr_t) hg_atomic_get64(
+            &hg_core_map->table);
 
-    if (!(hg_core_class->init_info.progress_mode & NA_NO_BLOCK) &&
-        (na_poll_fd > 0)) {
-        struct hg_poll_event event = {.events = HG_POLLIN, .data.u64 = 0};
+    hg_atomic_set64(&hg_core_map->table, (int64_t) (uintptr_t) table);
 
-        /* Create poll set */
-        context->poll_set = hg_poll_create();
-        HG_CHECK_SUBSYS_ERROR(ctx, context->poll_set == NULL, error, ret,
-            HG_NOMEM, "Could not create poll set");
+    /* Concurrent lookups may still be reading the old table */
+    hg_core_map_sync(hg_core_map);
+    free(old_table);
+}
 
-        event.data.u32 = (uint32_t) HG_CORE_POLL_NA;
-        rc = hg_poll_add(context->poll_set, na_poll_fd, &event);
-        HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
-            "hg_poll_add() failed (na_poll_fd=%d)", na_poll_fd);
-        context->na_event = na_poll_fd;
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_map_rebuild(struct hg_core_map *hg_core_map, unsigned int count,
+    const struct hg_core_rpc_info *removed)
+{
+    struct hg_core_map_table *old_table =
+        (struct hg_core_map_table *) (uintptr_t) hg_atomic_get64(
+            &hg_core_map->table);
+    struct hg_core_map_table *table;
+    unsigned int size = HG_CORE_MAP_INIT_SIZE, i;
+    hg_return_t ret;
 
-#ifdef NA_HAS_SM
-        if (hg_core_class->core_class.na_sm_class &&
-            context->core_context.na_sm_context) {
-            na_poll_fd = NA_Poll_get_fd(hg_core_class->core_class.na_sm_class,
-                context->core_context.na_sm_context);
-            HG_CHECK_SUBSYS_ERROR(ctx, na_poll_fd < 0, error, ret,
-                HG_PROTOCOL_ERROR, "Could not get NA SM poll fd");
+    /* Keep load factor under 1/2 */
+    while (size < 2 * count)
+        size *= 2;
 
-            event.data.u32 = (uint32_t) HG_CORE_POLL_SM;
-            rc = hg_poll_add(context->poll_set, na_poll_fd, &event);
-            HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret,
-                HG_NOMEM, "hg_poll_add() failed (na_poll_fd=%d)", na_poll_fd);
-            context->na_sm_event = na_poll_fd;
-        }
-#endif
+    table = hg_core_map_table_alloc(size, 0);
+    HG_CHECK_SUBSYS_ERROR(cls, table == NULL, error, ret, HG_NOMEM,
+        "Could not allocate RPC map table");
 
-        if (hg_core_class->init_info.loopback) {
-            /* Create event for completion queue notification */
-            loopback_event = hg_event_create();
-            HG_CHECK_SUBSYS_ERROR(ctx, loopback_event < 0, error, ret, HG_NOMEM,
-                "Could not create event");
+    for (i = 0; i < old_table->size; i++) {
+        struct hg_core_rpc_info *hg_core_rpc_info =
+            (struct hg_core_rpc_info *) (uintptr_t) hg_atomic_get64(
+                &old_table->slots[i]);
 
-            /* Add event to context poll set */
-            event.data.u32 = (uint32_t) HG_CORE_POLL_LOOPBACK;
-            rc = hg_poll_add(context->poll_set, loopback_event, &event);
-            HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret,
-                HG_NOMEM, "hg_poll_add() failed (loopback_event=%d)",
-                loopback_event);
-            context->loopback_notify.event = loopback_event;
-        }
+        if (hg_core_rpc_info != NULL && hg_core_rpc_info != removed)
+            hg_core_map_table_add(table, hg_core_rpc_info);
     }
 
-    /* Assign context ID */
-    context->core_context.id = id;
+    hg_core_map_publish(hg_core_map, table);
 
-    /* Create pool of bulk op IDs */
-    ret = hg_bulk_op_pool_create((hg_core_context_t *) context,
-        HG_CORE_BULK_OP_INIT_COUNT, &context->hg_bulk_op_pool);
-    HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret, "Could not create bulk op pool");
+    return HG_SUCCESS;
 
-    /* Increment context count of parent class */
-    hg_atomic_incr32(&HG_CORE_CONTEXT_CLASS(context)->n_contexts);
+error:
+    return ret;
+}
 
-    *context_p = context;
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_map_value_free(struct hg_core_rpc_info *hg_core_rpc_info)
+{
+    if (hg_core_rpc_info->free_callback)
+        hg_core_rpc_info->free_callback(hg_core_rpc_info->data);
+    free(hg_core_rpc_info);
+}
 
-    return HG_SUCCESS;
+/*---------------------------------------------------------------------------*/
+static HG_INLINE struct hg_core_rpc_info *
+hg_core_map_lookup(struct hg_core_map *hg_core_map, hg_id_t *id)
+{
+    hg_atomic_int32_t *readers = hg_core_map_read_begin(hg_core_map);
+    struct hg_core_rpc_info *hg_core_rpc_info;
 
-error:
-    if (context != NULL) {
-        if (context->poll_set != NULL) {
-            if (context->na_event > 0) {
-                rc = hg_poll_remove(context->poll_set, context->na_event);
-                HG_CHECK_SUBSYS_ERROR_DONE(ctx, rc != HG_UTIL_SUCCESS,
-                    "Could not remove NA poll descriptor from poll set");
-            }
-#ifdef NA_HAS_SM
-            if (context->na_sm_event > 0) {
-                rc = hg_poll_remove(context->poll_set, context->na_sm_event);
-                HG_CHECK_SUBSYS_ERROR_DONE(ctx, rc != HG_UTIL_SUCCESS,
-                    "Could not remove NA SM poll descriptor from poll set");
-            }
-#endif
-            if (context->loopback_notify.event > 0) {
-                rc = hg_poll_remove(
-                    context->poll_set, context->loopback_notify.event);
-                HG_CHECK_SUBSYS_ERROR_DONE(ctx, rc != HG_UTIL_SUCCESS,
-                    "Could not remove loopback poll descriptor from poll set");
-            }
-            rc = hg_poll_destroy(context->poll_set);
-            HG_CHECK_SUBSYS_ERROR_DONE(
-                ctx, rc != HG_UTIL_SUCCESS, "Could not destroy poll set");
-        }
+    /* Updates do not free tables and entries before lookups end, lookups
+     * therefore do not need to take the map lock */
+    hg_core_rpc_info = hg_core_map_table_find(
+        (const struct hg_core_map_table *) (uintptr_t) hg_atomic_get64(
+            &hg_core_map->table),
+        *id);
 
-        if (loopback_event > 0) {
-            rc = hg_event_destroy(loopback_event);
-            HG_CHECK_SUBSYS_ERROR_DONE(
-                ctx, rc != HG_UTIL_SUCCESS, "Could not destroy loopback event");
-        }
+    hg_core_map_read_end(readers);
 
-        if (context->core_context.na_context != NULL) {
-            na_return_t na_ret =
-                NA_Context_destroy(hg_core_class->core_class.na_class,
-                    context->core_context.na_context);
-            HG_CHECK_SUBSYS_ERROR_DONE(ctx, na_ret != NA_SUCCESS,
-                "Could not destroy NA context (%s)",
-                NA_Error_to_string(na_ret));
-        }
-#ifdef NA_HAS_SM
-        if (context->core_context.na_sm_context != NULL) {
-            na_return_t na_ret =
-                NA_Context_destroy(hg_core_class->core_class.na_sm_class,
-                    context->core_context.na_sm_context);
-            HG_CHECK_SUBSYS_ERROR_DONE(ctx, na_ret != NA_SUCCESS,
-                "Could not destroy NA SM context (%s)",
-                NA_Error_to_string(na_ret));
-        }
-#endif
+    return hg_core_rpc_info;
+}
 
-        if (backfill_queue_mutex_init)
-            (void) hg_thread_mutex_destroy(&backfill_queue->mutex);
-        if (backfill_queue_cond_init)
-            (void) hg_thread_cond_destroy(&backfill_queue->cond);
-        if (loopback_notify_mutex_init)
-            (void) hg_thread_mutex_destroy(&context->loopback_notify.mutex);
-        if (user_list_lock_init)
-            (void) hg_thread_spin_destroy(&context->user_list.lock);
-        if (internal_list_lock_init)
-            (void) hg_thread_spin_destroy(&context->internal_list.lock);
-#ifdef HG_HAS_MULTI_PROGRESS
-        if (progress_multi_mutex_init)
-            (void) hg_thread_mutex_destroy(&progress_multi->mutex);
-        if (progress_multi_cond_init)
-            (void) hg_thread_cond_destroy(&progress_multi->cond);
-#endif
-        hg_atomic_queue_free(context->completion_queue);
-        free(context);
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_map_insert(struct hg_core_map *hg_core_map, hg_id_t *id, bool hist,
+    struct hg_core_rpc_info **hg_core_rpc_info_p)
+{
+    struct hg_core_rpc_info *hg_core_rpc_info = NULL;
+    struct hg_core_map_table *table;
+    hg_return_t ret;
+
+    hg_thread_mutex_lock(&hg_core_map->lock);
+
+    /* Another thread may have inserted that ID already */
+    hg_core_rpc_info = hg_core_map_lookup(hg_core_map, id);
+    if (hg_core_rpc_info != NULL) {
+        hg_thread_mutex_unlock(&hg_core_map->lock);
+        *hg_core_rpc_info_p = hg_core_rpc_info;
+        return HG_SUCCESS;
     }
 
+    /* Allocate new RPC info */
+    hg_core_rpc_info = (struct hg_core_rpc_info *) calloc(1,
+        sizeof(struct hg_core_map_entry) +
+            (hist ? sizeof(struct hg_core_rpc_hist) : 0));
+    HG_CHECK_SUBSYS_ERROR(cls, hg_core_rpc_info == NULL, unlock, ret, HG_NOMEM,
+        "Could not allocate HG core RPC info");
+    hg_core_rpc_info->id = *id;
+    hg_core_rpc_info->priority = HG_PRIORITY_DEFAULT;
+    if (hist)
+        ((struct hg_core_map_entry *) hg_core_rpc_info)->hist =
+            (struct hg_core_rpc_hist *) ((char *) hg_core_rpc_info +
+                                         sizeof(struct hg_core_map_entry));
+
+    /* Frozen tables cannot be updated in place */
+    table = (struct hg_core_map_table *) (uintptr_t) hg_atomic_get64(
+        &hg_core_map->table);
+    if (table->disp != NULL || (table->count + 1) * 2 > table->size) {
+        ret = hg_core_map_rebuild(hg_core_map, table->count + 1, NULL);
+        HG_CHECK_SUBSYS_HG_ERROR(cls, unlock, ret, "Could not grow RPC map");
+        table = (struct hg_core_map_table *) (uintptr_t) hg_atomic_get64(
+            &hg_core_map->table);
+    }
+    hg_core_map_table_add(table, hg_core_rpc_info);
+
+    hg_thread_mutex_unlock(&hg_core_map->lock);
+
+    *hg_core_rpc_info_p = hg_core_rpc_info;
+
+    return HG_SUCCESS;
+
+unlock:
+    hg_thread_mutex_unlock(&hg_core_map->lock);
+    free(hg_core_rpc_info);
+
     return ret;
 }
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_context_destroy(struct hg_core_private_context *context)
+hg_core_map_remove(struct hg_core_map *hg_core_map, hg_id_t *id)
 {
-    struct hg_core_private_class *hg_core_class = NULL;
-#ifdef HG_HAS_MULTI_PROGRESS
-    struct hg_core_progress_multi *progress_multi = NULL;
-#endif
-    struct hg_core_completion_queue *backfill_queue = NULL;
-    bool empty;
+    struct hg_core_rpc_info *hg_core_rpc_info;
+    struct hg_core_map_table *table;
     hg_return_t ret;
-    int rc;
 
-    if (context == NULL)
-        return HG_SUCCESS;
+    hg_thread_mutex_lock(&hg_core_map->lock);
 
-    /* Keep reference to class */
-    hg_core_class = HG_CORE_CONTEXT_CLASS(context);
-#ifdef HG_HAS_MULTI_PROGRESS
-    /* Check that we are no longer progressing */
-    progress_multi = &context->progress_multi;
-    HG_CHECK_SUBSYS_ERROR(ctx, hg_atomic_get32(&progress_multi->count) > 0,
-        error, ret, HG_BUSY, "Still progressing on context");
-#endif
+    table = (struct hg_core_map_table *) (uintptr_t) hg_atomic_get64(
+        &hg_core_map->table);
+    hg_core_rpc_info = hg_core_map_table_find(table, *id);
+    HG_CHECK_SUBSYS_ERROR(cls, hg_core_rpc_info == NULL, unlock, ret,
+        HG_NOENTRY, "Could not find RPC ID (%" PRIu64 ")", *id);
 
-    if (context->posted) {
-        /* Unpost requests */
-        ret = hg_core_context_unpost(context, HG_CORE_CLEANUP_TIMEOUT);
-        HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret, "Could not unpost requests");
-    }
+    /* Removing in place would break probe sequences and frozen tables cannot
+     * be updated, the new table is published once concurrent lookups that
+     * may read the entry have completed */
+    ret = hg_core_map_rebuild(hg_core_map, table->count - 1, hg_core_rpc_info);
+    HG_CHECK_SUBSYS_HG_ERROR(cls, unlock, ret, "Could not rebuild RPC map");
 
-    /* Wait on created list (user created handles) */
-    ret = hg_core_context_list_wait(
-        context, &context->user_list, HG_CORE_CLEANUP_TIMEOUT);
-    HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret, "Could not wait on handle list");
+    hg_thread_mutex_unlock(&hg_core_map->lock);
 
-    /* Number of handles for that context should be 0 */
-    if (hg_atomic_get32(&context->n_handles) > 0) {
-        HG_LOG_SUBSYS_ERROR(ctx,
-            "HG core handles must be freed before destroying context (%" PRId32
-            " remaining)",
-            hg_atomic_get32(&context->n_handles));
+    hg_core_map_value_free(hg_core_rpc_info);
 
-        ret = hg_core_context_check_handle_list(&context->user_list);
-        HG_CHECK_SUBSYS_HG_ERROR(
-            ctx, error, ret, "User-created handles are still in use");
+    return HG_SUCCESS;
 
-        ret = hg_core_context_check_handle_list(&context->internal_list);
-        HG_CHECK_SUBSYS_HG_ERROR(
-            ctx, error, ret, "Internal handles are still in use");
-    }
+unlock:
+    hg_thread_mutex_unlock(&hg_core_map->lock);
 
-    /* Check that backfill completion queue is empty now */
-    backfill_queue = &context->backfill_queue;
-    hg_thread_mutex_lock(&backfill_queue->mutex);
-    empty = STAILQ_EMPTY(&backfill_queue->queue);
-    hg_thread_mutex_unlock(&backfill_queue->mutex);
-    HG_CHECK_SUBSYS_ERROR(ctx, empty == false, error, ret, HG_BUSY,
-        "Completion queue should be empty");
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_map_freeze(struct hg_core_map *hg_core_map)
+{
+    struct hg_core_map_table *old_table, *table = NULL;
+    struct hg_core_rpc_info **entries = NULL;
+    unsigned int disp_count = 1, size, count = 0, i;
+    hg_return_t ret;
 
-    /* Check that atomic completion queue is empty now */
-    empty = hg_atomic_queue_is_empty(context->completion_queue);
-    HG_CHECK_SUBSYS_ERROR(ctx, empty == false, error, ret, HG_BUSY,
-        "Completion queue should be empty");
+    hg_thread_mutex_lock(&hg_core_map->lock);
 
-    /* Destroy pool of bulk op IDs */
-    if (context->hg_bulk_op_pool != NULL) {
-        hg_bulk_op_pool_destroy(context->hg_bulk_op_pool);
-        context->hg_bulk_op_pool = NULL;
+    old_table = (struct hg_core_map_table *) (uintptr_t) hg_atomic_get64(
+        &hg_core_map->table);
+    if (old_table->disp != NULL || old_table->count == 0) {
+        hg_thread_mutex_unlock(&hg_core_map->lock);
+        return HG_SUCCESS; /* Nothing to do */
     }
 
-    /* Stop listening for events */
-    if (context->loopback_notify.event > 0) {
-        rc = hg_poll_remove(context->poll_set, context->loopback_notify.event);
-        HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret,
-            HG_NOENTRY, "Could not remove loopback notify event from poll set");
-
-        rc = hg_event_destroy(context->loopback_notify.event);
-        HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret,
-            HG_NOENTRY, "Could not destroy loopback notify event");
-        context->loopback_notify.event = 0;
-    }
+    entries = (struct hg_core_rpc_info **) malloc(
+        old_table->count * sizeof(*entries));
+    HG_CHECK_SUBSYS_ERROR(cls, entries == NULL, unlock, ret, HG_NOMEM,
+        "Could not allocate array of RPC map entries");
 
-    if (context->na_event > 0) {
-        rc = hg_poll_remove(context->poll_set, context->na_event);
-        HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret,
-            HG_NOENTRY, "Could not remove NA event from poll set");
-        context->na_event = 0;
-    }
+    for (i = 0; i < old_table->size; i++) {
+        struct hg_core_rpc_info *hg_core_rpc_info =
+            (struct hg_core_rpc_info *) (uintptr_t) hg_atomic_get64(
+                &old_table->slots[i]);
 
-#ifdef NA_HAS_SM
-    if (context->na_sm_event > 0) {
-        rc = hg_poll_remove(context->poll_set, context->na_sm_event);
-        HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret,
-            HG_NOENTRY, "Could not remove NA SM event from poll set");
-        context->na_sm_event = 0;
+        if (hg_core_rpc_info != NULL)
+            entries[count++] = hg_core_rpc_info;
     }
-#endif
 
-    /* Destroy poll set */
-    if (context->poll_set != NULL) {
-        rc = hg_poll_destroy(context->poll_set);
-        HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_FAULT,
-            "Could not destroy poll set");
-        context->poll_set = NULL;
-    }
+    /* One bucket per entry on average, load factor under 1/2 */
+    while (disp_count < count)
+        disp_count *= 2;
+    for (size = 2 * disp_count; size <= HG_CORE_MAP_FREEZE_MAX * disp_count;
+         size *= 2) {
+        table = hg_core_map_table_alloc(size, disp_count);
+        HG_CHECK_SUBSYS_ERROR(cls, table == NULL, unlock, ret, HG_NOMEM,
+            "Could not allocate RPC map table");
 
-    /* Destroy NA context */
-    if (context->core_context.na_context != NULL) {
-        na_return_t na_ret =
-            NA_Context_destroy(context->core_context.core_class->na_class,
-                context->core_context.na_context);
-        HG_CHECK_SUBSYS_ERROR(ctx, na_ret != NA_SUCCESS, error, ret,
-            (hg_return_t) na_ret, "Could not destroy NA context (%s)",
-            NA_Error_to_string(na_ret));
-        context->core_context.na_context = NULL;
-    }
+        if (hg_core_map_table_place(table, entries, count))
+            break;
 
-#ifdef NA_HAS_SM
-    /* Destroy NA SM context */
-    if (context->core_context.na_sm_context) {
-        na_return_t na_ret =
-            NA_Context_destroy(context->core_context.core_class->na_sm_class,
-                context->core_context.na_sm_context);
-        HG_CHECK_SUBSYS_ERROR(ctx, na_ret != NA_SUCCESS, error, ret,
-            (hg_return_t) na_ret, "Could not destroy NA SM context (%s)",
-            NA_Error_to_string(na_ret));
-        context->core_context.na_sm_context = NULL;
+        free(table);
+        table = NULL;
     }
-#endif
+    HG_CHECK_SUBSYS_ERROR(cls, table == NULL, unlock, ret, HG_FAULT,
+        "Could not build perfect hash for %u RPC IDs", count);
 
-    /* Free user data */
-    if (context->core_context.data_free_callback)
-        context->core_context.data_free_callback(context->core_context.data);
+    hg_core_map_publish(hg_core_map, table);
 
-    /* Destroy completion queue mutex/cond */
-    (void) hg_thread_mutex_destroy(&backfill_queue->mutex);
-    (void) hg_thread_cond_destroy(&backfill_queue->cond);
-    (void) hg_thread_mutex_destroy(&context->loopback_notify.mutex);
-    (void) hg_thread_spin_destroy(&context->user_list.lock);
-    (void) hg_thread_spin_destroy(&context->internal_list.lock);
-#ifdef HG_HAS_MULTI_PROGRESS
-    (void) hg_thread_mutex_destroy(&progress_multi->mutex);
-    (void) hg_thread_cond_destroy(&progress_multi->cond);
-#endif
+    hg_thread_mutex_unlock(&hg_core_map->lock);
 
-    hg_atomic_queue_free(context->completion_queue);
-    free(context);
+    HG_LOG_SUBSYS_DEBUG(cls, "Froze RPC map of %u IDs into %u slots", count,
+        table->size);
 
-    /* Decrement context count of parent class */
-    hg_atomic_decr32(&hg_core_class->n_contexts);
+    free(entries);
 
     return HG_SUCCESS;
 
-error:
+unlock:
+    hg_thread_mutex_unlock(&hg_core_map->lock);
+    free(entries);
+
     return ret;
 }
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_context_post(struct hg_core_private_context *context)
+hg_core_addr_lookup(struct hg_core_private_class *hg_core_class,
+    const char *name, struct hg_core_private_addr **addr_p)
 {
-    struct hg_core_private_class *hg_core_class =
-        HG_CORE_CONTEXT_CLASS(context);
-    unsigned long flags = HG_CORE_HANDLE_LISTEN;
+    struct hg_core_private_addr *hg_core_addr = NULL;
+    na_class_t **na_class_p = NULL;
+    na_addr_t **na_addr_p = NULL;
+    size_t *na_addr_serialize_size_p = NULL;
+    na_return_t na_ret;
+    const char *name_str = NULL;
     hg_return_t ret;
 
-    /* Allocate resources for "listening" on incoming RPCs */
-    HG_CHECK_SUBSYS_ERROR(ctx, !hg_core_class->init_info.listen, error, ret,
-        HG_OPNOTSUPPORTED, "Cannot post handles on non-listening class");
+    /* Allocate addr */
+    ret = hg_core_addr_create(hg_core_class, &hg_core_addr);
+    HG_CHECK_SUBSYS_HG_ERROR(addr, error, ret, "Could not create HG core addr");
 
-    /* Allocate multi-recv operations */
-    if (hg_core_class->init_info.multi_recv) {
-        ret = hg_core_context_multi_recv_alloc(context,
-            hg_core_class->core_class.na_class,
-            hg_core_class->init_info.request_post_init);
-        HG_CHECK_SUBSYS_HG_ERROR(
-            ctx, error, ret, "Could not allocate multi-recv resources");
-        flags |= HG_CORE_HANDLE_MULTI_RECV;
-        if (hg_core_class->init_info.multi_recv_copy_threshold > 0)
-            flags |= HG_CORE_HANDLE_MULTI_RECV_COPY;
-    }
+    /* TODO lookup could also create self addresses */
 
-    /* Create pool of handles */
-    ret = hg_core_handle_pool_create(context,
-        hg_core_class->core_class.na_class, context->core_context.na_context,
-        flags, hg_core_class->init_info.request_post_init,
-        hg_core_class->init_info.request_post_incr, &context->handle_pool);
-    HG_CHECK_SUBSYS_HG_ERROR(
-        ctx, error, ret, "Could not allocate pool of handles");
+#ifdef NA_HAS_SM
+    if (hg_core_class->core_class.na_sm_class != NULL)
+        name_str = strstr(name, HG_CORE_ADDR_DELIMITER);
+
+    /* Parse name string */
+    if (name_str != NULL) {
+        char uuid_str[NA_SM_HOST_ID_LEN + 1];
+        int rc;
+
+        /* Get first part of address string with host ID */
+        rc = sscanf(name, "uid://%11[^#]", uuid_str);
+        HG_CHECK_SUBSYS_ERROR(addr, rc != 1, error, ret, HG_PROTONOSUPPORT,
+            "Malformed address format (%s)", name);
+
+        na_ret = NA_SM_String_to_host_id(uuid_str, &hg_core_addr->host_id);
+        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "NA_SM_String_to_host_id() failed (%s)",
+            NA_Error_to_string(na_ret));
+
+        /* Skip delimiter */
+        name_str += HG_CORE_ADDR_DELIMITER_LEN;
+
+        /* Compare IDs, if they match it's local address */
+        if (NA_SM_Host_id_cmp(hg_core_addr->host_id, hg_core_class->host_id)) {
+            HG_LOG_SUBSYS_DEBUG(addr, "%s is a local address", name);
+            na_class_p = &hg_core_addr->core_addr.core_class->na_sm_class;
+            na_addr_p = &hg_core_addr->core_addr.na_sm_addr;
+            na_addr_serialize_size_p = &hg_core_addr->na_sm_addr_serialize_size;
+        } else {
+            /* Remote lookup */
+            name_str = strstr(name_str, HG_CORE_ADDR_DELIMITER);
+            HG_CHECK_SUBSYS_ERROR(addr, name_str == NULL, error, ret,
+                HG_PROTONOSUPPORT, "Malformed remote address string (%s)",
+                name);
 
+            na_class_p = &hg_core_addr->core_addr.core_class->na_class;
+            na_addr_p = &hg_core_addr->core_addr.na_addr;
+            na_addr_serialize_size_p = &hg_core_addr->na_addr_serialize_size;
+            name_str += HG_CORE_ADDR_DELIMITER_LEN;
+        }
+    } else {
+#endif
+        /* Remote lookup */
+        na_class_p = &hg_core_addr->core_addr.core_class->na_class;
+        na_addr_p = &hg_core_addr->core_addr.na_addr;
+        na_addr_serialize_size_p = &hg_core_addr->na_addr_serialize_size;
+        name_str = name;
 #ifdef NA_HAS_SM
-    /* Create pool of SM handles */
-    if (context->core_context.na_sm_context != NULL) {
-        ret = hg_core_handle_pool_create(context,
-            hg_core_class->core_class.na_sm_class,
-            context->core_context.na_sm_context, HG_CORE_HANDLE_LISTEN,
-            hg_core_class->init_info.request_post_init,
-            hg_core_class->init_info.request_post_incr,
-            &context->sm_handle_pool);
-        HG_CHECK_SUBSYS_HG_ERROR(
-            ctx, error, ret, "Could not allocate pool of SM handles");
     }
 #endif
 
-    /* Only post multi-recv after pool of handles has been created */
-    if (hg_core_class->init_info.multi_recv) {
-        ret = hg_core_context_multi_recv_post(context,
-            hg_core_class->core_class.na_class,
-            context->core_context.na_context);
-        HG_CHECK_SUBSYS_HG_ERROR(
-            ctx, error, ret, "Could not post multi-recv operations");
-    }
+    /* Lookup adress */
+    na_ret = NA_Addr_lookup(*na_class_p, name_str, na_addr_p);
+    HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
+        (hg_return_t) na_ret, "Could not lookup address %s (%s)", name_str,
+        NA_Error_to_string(na_ret));
 
-    context->posted = true;
+    /* Cache serialize size */
+    *na_addr_serialize_size_p =
+        NA_Addr_get_serialize_size(*na_class_p, *na_addr_p);
+
+    *addr_p = hg_core_addr;
 
     return HG_SUCCESS;
 
 error:
-    if (context->handle_pool != NULL) {
-        (void) hg_core_handle_pool_unpost(
-            context->handle_pool, HG_CORE_CLEANUP_TIMEOUT);
-        hg_core_handle_pool_destroy(context->handle_pool);
-    }
-#ifdef NA_HAS_SM
-    if (context->sm_handle_pool != NULL) {
-        (void) hg_core_handle_pool_unpost(
-            context->sm_handle_pool, HG_CORE_CLEANUP_TIMEOUT);
-        hg_core_handle_pool_destroy(context->sm_handle_pool);
-    }
-#endif
-    if (hg_core_class->init_info.multi_recv)
-        hg_core_context_multi_recv_free(
-            context, hg_core_class->core_class.na_class);
+    hg_core_addr_free(hg_core_addr);
 
     return ret;
 }
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_context_unpost(
-    struct hg_core_private_context *context, unsigned int timeout_ms)
+hg_core_addr_map_init(struct hg_core_addr_map *addr_map)
 {
-    struct hg_core_private_class *hg_core_class =
-        HG_CORE_CONTEXT_CLASS(context);
     hg_return_t ret;
+    int rc;
 
-    if (!hg_core_class->init_info.listen || !context->posted)
-        return HG_SUCCESS;
+    addr_map->map =
+        hg_hash_table_new(hg_core_addr_map_hash, hg_core_addr_map_equal);
+    HG_CHECK_SUBSYS_ERROR(addr, addr_map->map == NULL, error, ret, HG_NOMEM,
+        "hg_hash_table_new() failed");
 
-    /* Prevent requests from being reposted as they complete */
-    hg_atomic_set32(&context->unposting, 1);
+    rc = hg_thread_mutex_init(&addr_map->lock);
+    HG_CHECK_SUBSYS_ERROR(addr, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+        "hg_thread_mutex_init() failed");
 
-    if (hg_core_class->init_info.multi_recv) {
-        ret = hg_core_context_multi_recv_unpost(context,
-            hg_core_class->core_class.na_class,
-            context->core_context.na_context);
-        HG_CHECK_SUBSYS_HG_ERROR(
-            ctx, error, ret, "Could not unpost multi-recv operations");
+    return HG_SUCCESS;
+
+error:
+    if (addr_map->map != NULL) {
+        hg_hash_table_free(addr_map->map);
+        addr_map->map = NULL;
     }
 
-    if (context->handle_pool != NULL) {
-        ret = hg_core_handle_pool_unpost(context->handle_pool, timeout_ms);
-        HG_CHECK_SUBSYS_HG_ERROR(
-            ctx, error, ret, "Could not unpost pool of handles");
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_addr_map_finalize(struct hg_core_addr_map *addr_map)
+{
+    /* Keys and values are owned by addresses, which have all been freed */
+    hg_hash_table_free(addr_map->map);
+    (void) hg_thread_mutex_destroy(&addr_map->lock);
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE unsigned int
+hg_core_addr_map_hash(hg_hash_table_key_t key)
+{
+    return hg_hash_string((const char *) key);
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE int
+hg_core_addr_map_equal(hg_hash_table_key_t key1, hg_hash_table_key_t key2)
+{
+    return strcmp((const char *) key1, (const char *) key2) == 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static struct hg_core_private_addr *
+hg_core_addr_map_lookup(struct hg_core_addr_map *addr_map, const char *name)
+{
+    union {
+        const char *const_ptr;
+        char *ptr;
+    } key = {.const_ptr = name};
+    struct hg_core_private_addr *hg_core_addr;
+    int32_t ref_count;
+
+    /* Must be called with addr map lock held */
+    hg_core_addr = (struct hg_core_private_addr *) hg_hash_table_lookup(
+        addr_map->map, (hg_hash_table_key_t) key.ptr);
+    if (hg_core_addr == HG_HASH_TABLE_NULL)
+        return NULL;
+
+    /* Address is being freed if its last reference was released */
+    do {
+        ref_count = hg_atomic_get32(&hg_core_addr->ref_count);
+        if (ref_count == 0)
+            return NULL;
+    } while (!hg_atomic_cas32(
+        &hg_core_addr->ref_count, ref_count, ref_count + 1));
+
+    return hg_core_addr;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_addr_map_remove(struct hg_core_private_addr *hg_core_addr)
+{
+    struct hg_core_addr_map *addr_map =
+        &HG_CORE_ADDR_CLASS(hg_core_addr)->addr_map;
+
+    hg_thread_mutex_lock(&addr_map->lock);
+    /* Entry may have been replaced by a more recent lookup */
+    if (hg_hash_table_lookup(addr_map->map,
+            (hg_hash_table_key_t) hg_core_addr->lookup_name) ==
+        (hg_hash_table_value_t) hg_core_addr)
+        (void) hg_hash_table_remove(
+            addr_map->map, (hg_hash_table_key_t) hg_core_addr->lookup_name);
+    hg_thread_mutex_unlock(&addr_map->lock);
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_addr_lookup_batch(struct hg_core_private_class *hg_core_class,
+    const char *const names[], unsigned int count,
+    struct hg_core_private_addr *addrs[])
+{
+    struct hg_core_addr_map *addr_map = &hg_core_class->addr_map;
+    hg_hash_table_t *batch_map = NULL;
+    unsigned int *first = NULL; /* Index of first occurrence of each name */
+    unsigned int i;
+    hg_return_t ret;
+
+    for (i = 0; i < count; i++)
+        addrs[i] = NULL;
+    if (count == 0)
+        return HG_SUCCESS;
 
-        hg_core_handle_pool_destroy(context->handle_pool);
-        context->handle_pool = NULL;
+    first = (unsigned int *) malloc(count * sizeof(*first));
+    HG_CHECK_SUBSYS_ERROR(addr, first == NULL, error, ret, HG_NOMEM,
+        "Could not allocate lookup indices");
+
+    batch_map =
+        hg_hash_table_new(hg_core_addr_map_hash, hg_core_addr_map_equal);
+    HG_CHECK_SUBSYS_ERROR(addr, batch_map == NULL, error, ret, HG_NOMEM,
+        "hg_hash_table_new() failed");
+
+    /* Take names already known with a single lock acquisition and only keep
+     * the first occurrence of names that repeat within the batch */
+    hg_thread_mutex_lock(&addr_map->lock);
+    for (i = 0; i < count; i++) {
+        union {
+            const char *const_ptr;
+            char *ptr;
+        } key = {.const_ptr = names[i]};
+        hg_hash_table_value_t value;
+
+        addrs[i] = hg_core_addr_map_lookup(addr_map, names[i]);
+        if (addrs[i] != NULL) {
+            first[i] = count;
+            continue;
+        }
+
+        /* Indices are stored shifted by one as NULL is not a valid value */
+        value = hg_hash_table_lookup(batch_map, (hg_hash_table_key_t) key.ptr);
+        if (value != HG_HASH_TABLE_NULL)
+            first[i] = (unsigned int) ((uintptr_t) value - 1);
+        else if (hg_hash_table_insert(batch_map, (hg_hash_table_key_t) key.ptr,
+                     (hg_hash_table_value_t) ((uintptr_t) i + 1)) != 0)
+            first[i] = i;
+        else {
+            hg_thread_mutex_unlock(&addr_map->lock);
+            HG_GOTO_SUBSYS_ERROR(
+                addr, error, ret, HG_NOMEM, "Could not insert %s", names[i]);
+        }
     }
+    hg_thread_mutex_unlock(&addr_map->lock);
 
-#ifdef NA_HAS_SM
-    if (context->sm_handle_pool != NULL) {
-        ret = hg_core_handle_pool_unpost(context->sm_handle_pool, timeout_ms);
+    /* Issue remaining NA lookups back to back, without the lock held and
+     * without touching the map in between, any failure fails the batch */
+    for (i = 0; i < count; i++) {
+        if (first[i] != i)
+            continue;
+
+        ret = hg_core_addr_lookup(hg_core_class, names[i], &addrs[i]);
         HG_CHECK_SUBSYS_HG_ERROR(
-            ctx, error, ret, "Could not unpost pool of handles");
+            addr, error, ret, "Could not lookup address for %s", names[i]);
 
-        hg_core_handle_pool_destroy(context->sm_handle_pool);
-        context->sm_handle_pool = NULL;
+        addrs[i]->lookup_name = strdup(names[i]);
+        HG_CHECK_SUBSYS_ERROR(addr, addrs[i]->lookup_name == NULL, error, ret,
+            HG_NOMEM, "Could not duplicate lookup name");
     }
-#endif
 
-    /* Wait on internal list */
-    ret =
-        hg_core_context_list_wait(context, &context->internal_list, timeout_ms);
-    HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret, "Could not wait on handle list");
+    /* Publish new addresses with a single lock acquisition */
+    hg_thread_mutex_lock(&addr_map->lock);
+    for (i = 0; i < count; i++) {
+        struct hg_core_private_addr *hg_map_addr;
+
+        if (first[i] != i)
+            continue;
+
+        /* Concurrent batch may have inserted the same name */
+        hg_map_addr = hg_core_addr_map_lookup(addr_map, names[i]);
+        if (hg_map_addr != NULL) {
+            free(addrs[i]->lookup_name);
+            addrs[i]->lookup_name = NULL;
+            hg_core_addr_free(addrs[i]);
+            addrs[i] = hg_map_addr;
+        } else if (hg_hash_table_insert(addr_map->map,
+                       (hg_hash_table_key_t) addrs[i]->lookup_name,
+                       (hg_hash_table_value_t) addrs[i]) == 0) {
+            /* Address remains valid, it is just not shared */
+            HG_LOG_SUBSYS_WARNING(
+                addr, "Could not insert %s into addr map", names[i]);
+            free(addrs[i]->lookup_name);
+            addrs[i]->lookup_name = NULL;
+        }
+    }
+    hg_thread_mutex_unlock(&addr_map->lock);
+
+    /* Repeated names share the address of their first occurrence */
+    for (i = 0; i < count; i++) {
+        if (first[i] == count || first[i] == i)
+            continue;
+        addrs[i] = addrs[first[i]];
+        hg_atomic_incr32(&addrs[i]->ref_count);
+    }
 
-    if (hg_core_class->init_info.multi_recv)
-        hg_core_context_multi_recv_free(
-            context, hg_core_class->core_class.na_class);
+    hg_hash_table_free(batch_map);
+    free(first);
 
-    context->posted = false;
+    return HG_SUCCESS;
 
 error:
+    /* Addresses of failed batches were never published */
+    for (i = 0; i < count; i++) {
+        if (addrs[i] != NULL && first != NULL && first[i] == i) {
+            free(addrs[i]->lookup_name);
+            addrs[i]->lookup_name = NULL;
+        }
+        hg_core_addr_free(addrs[i]);
+        addrs[i] = NULL;
+    }
+    if (batch_map != NULL)
+        hg_hash_table_free(batch_map);
+    free(first);
+
     return ret;
 }
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_context_multi_recv_alloc(struct hg_core_private_context *context,
-    na_class_t *na_class, unsigned int request_count)
+hg_core_addr_create(struct hg_core_private_class *hg_core_class,
+    struct hg_core_private_addr **hg_core_addr_p)
 {
-    unsigned int multi_recv_op_max =
-        HG_CORE_CONTEXT_CLASS(context)->init_info.multi_recv_op_max;
-    size_t unexpected_msg_size;
+    struct hg_core_private_addr *hg_core_addr = NULL;
     hg_return_t ret;
-    unsigned int i;
-
-    unexpected_msg_size = NA_Msg_get_max_unexpected_size(na_class);
-    HG_CHECK_SUBSYS_ERROR(ctx, unexpected_msg_size == 0, error, ret,
-        HG_INVALID_PARAM, "Invalid unexpected message size");
-    context->multi_recv_ops =
-        calloc(multi_recv_op_max, sizeof(*context->multi_recv_ops));
-    HG_CHECK_SUBSYS_ERROR(ctx, context->multi_recv_ops == NULL, error, ret,
-        HG_NOMEM, "Could not allocate %u multi-recv op entries",
-        multi_recv_op_max);
 
-    for (i = 0; i < multi_recv_op_max; i++) {
-        struct hg_core_multi_recv_op *multi_recv_op =
-            &context->multi_recv_ops[i];
+    hg_core_addr =
+        (struct hg_core_private_addr *) calloc(1, sizeof(*hg_core_addr));
+    HG_CHECK_SUBSYS_ERROR(addr, hg_core_addr == NULL, error, ret, HG_NOMEM,
+        "Could not allocate HG core addr");
 
-        multi_recv_op->context = context;
-        multi_recv_op->op_id = NA_Op_create(na_class, NA_OP_MULTI);
-        HG_CHECK_SUBSYS_ERROR(ctx, multi_recv_op->op_id == NULL, error, ret,
-            HG_NOMEM, "Could not create new OP ID");
+    hg_core_addr->core_addr.core_class = (hg_core_class_t *) hg_core_class;
+    hg_core_addr->core_addr.na_addr = NULL;
+#ifdef NA_HAS_SM
+    hg_core_addr->core_addr.na_sm_addr = NULL;
+#endif
+    hg_core_addr->core_addr.is_self = false;
 
-        /* Keep total buffer size as max of unexpected msg size x number of
-         * "pre-posted" operations. */
-        multi_recv_op->buf_size = request_count * unexpected_msg_size;
+    hg_atomic_init32(&hg_core_addr->ref_count, 1);
 
-        multi_recv_op->buf = NA_Msg_buf_alloc(na_class, multi_recv_op->buf_size,
-            NA_MULTI_RECV, &multi_recv_op->plugin_data);
-        HG_CHECK_SUBSYS_ERROR(ctx, multi_recv_op->buf == NULL, error, ret,
-            HG_NOMEM, "Could not allocate multi-recv buffer of size %zu",
-            multi_recv_op->buf_size);
+    /* Increment N addrs from HG class */
+    hg_atomic_incr32(&hg_core_class->n_addrs);
 
-        hg_atomic_init32(&multi_recv_op->last, 0);
-        hg_atomic_init32(&multi_recv_op->ref_count, 0);
-        hg_atomic_init32(&multi_recv_op->op_count, 0);
-    }
+    *hg_core_addr_p = hg_core_addr;
 
     return HG_SUCCESS;
 
 error:
-    if (context->multi_recv_ops == NULL)
-        return ret;
-
-    for (i = 0; i < multi_recv_op_max; i++) {
-        struct hg_core_multi_recv_op *multi_recv_op =
-            &context->multi_recv_ops[i];
-        NA_Op_destroy(na_class, multi_recv_op->op_id);
-        multi_recv_op->op_id = NULL;
-        NA_Msg_buf_free(
-            na_class, multi_recv_op->buf, multi_recv_op->plugin_data);
-        multi_recv_op->buf = NULL;
-        multi_recv_op->plugin_data = NULL;
-        multi_recv_op->buf_size = 0;
-    }
-    free(context->multi_recv_ops);
-
     return ret;
 }
 
 /*---------------------------------------------------------------------------*/
 static void
-hg_core_context_multi_recv_free(
-    struct hg_core_private_context *context, na_class_t *na_class)
+hg_core_addr_free(struct hg_core_private_addr *hg_core_addr)
 {
-    unsigned int multi_recv_op_max =
-        HG_CORE_CONTEXT_CLASS(context)->init_info.multi_recv_op_max;
-    unsigned int i;
+    struct hg_core_private_class *hg_core_class;
 
-    if (context->multi_recv_ops == NULL)
+    if (hg_core_addr == NULL)
         return;
 
-    for (i = 0; i < multi_recv_op_max; i++) {
-        struct hg_core_multi_recv_op *multi_recv_op =
-            &context->multi_recv_ops[i];
+    if (hg_atomic_decr32(&hg_core_addr->ref_count))
+        /* Cannot free yet */
+        return;
 
-        HG_CHECK_SUBSYS_WARNING(ctx,
-            hg_atomic_get32(&multi_recv_op->ref_count) != 0,
-            "Freeing multi-recv operation that is still being referenced "
-            "(%" PRId32 ")",
-            hg_atomic_get32(&multi_recv_op->ref_count));
+    /* Keep reference to core class */
+    hg_core_class = HG_CORE_ADDR_CLASS(hg_core_addr);
 
-        NA_Op_destroy(na_class, multi_recv_op->op_id);
-        multi_recv_op->op_id = NULL;
-        NA_Msg_buf_free(
-            na_class, multi_recv_op->buf, multi_recv_op->plugin_data);
-        multi_recv_op->buf = NULL;
-        multi_recv_op->plugin_data = NULL;
-        multi_recv_op->buf_size = 0;
+    /* No longer shared with batch lookups */
+    if (hg_core_addr->lookup_name != NULL) {
+        hg_core_addr_map_remove(hg_core_addr);
+        free(hg_core_addr->lookup_name);
     }
-    free(context->multi_recv_ops);
-}
 
-/*---------------------------------------------------------------------------*/
-static hg_return_t
-hg_core_context_multi_recv_post(struct hg_core_private_context *context,
-    na_class_t *na_class, na_context_t *na_context)
-{
-    unsigned int multi_recv_op_max =
-        HG_CORE_CONTEXT_CLASS(context)->init_info.multi_recv_op_max;
-    hg_return_t ret;
-    unsigned int i;
+    /* Free NA addresses */
+    hg_core_addr_free_na(hg_core_addr);
 
-    /* Ensure we have enough recvs pre-posted so that handles can be re-assigned
-     * a new buffer until the previous buffer can be safely re-used once it's
-     * consumed. */
-    for (i = 0; i < multi_recv_op_max; i++) {
-        struct hg_core_multi_recv_op *multi_recv_op =
-            &context->multi_recv_ops[i];
+    free(hg_core_addr);
 
-        multi_recv_op->id = i;
+    /* Decrement N addrs from HG class */
+    hg_atomic_decr32(&hg_core_class->n_addrs);
+}
 
-        ret = hg_core_post_multi(multi_recv_op, na_class, na_context);
-        HG_CHECK_SUBSYS_HG_ERROR(
-            ctx, error, ret, "Could not post multi-recv buffer %u", i);
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_addr_free_na(struct hg_core_private_addr *hg_core_addr)
+{
+    /* Free NA address */
+    if (hg_core_addr->core_addr.na_addr != NULL) {
+        NA_Addr_free(hg_core_addr->core_addr.core_class->na_class,
+            hg_core_addr->core_addr.na_addr);
+        hg_core_addr->core_addr.na_addr = NULL;
+        hg_core_addr->na_addr_serialize_size = 0;
     }
-    hg_atomic_init32(
-        &context->multi_recv_op_count, (int32_t) multi_recv_op_max);
-
-    return HG_SUCCESS;
 
-error:
-    return ret;
+#ifdef NA_HAS_SM
+    /* Free NA SM address */
+    if (hg_core_addr->core_addr.na_sm_addr != NULL) {
+        NA_Addr_free(hg_core_addr->core_addr.core_class->na_sm_class,
+            hg_core_addr->core_addr.na_sm_addr);
+        hg_core_addr->core_addr.na_sm_addr = NULL;
+        hg_core_addr->na_sm_addr_serialize_size = 0;
+    }
+#endif
 }
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_context_multi_recv_unpost(struct hg_core_private_context *context,
-    na_class_t *na_class, na_context_t *na_context)
+hg_core_addr_set_remove(struct hg_core_private_addr *hg_core_addr)
 {
-    unsigned int multi_recv_op_max =
-        HG_CORE_CONTEXT_CLASS(context)->init_info.multi_recv_op_max;
     hg_return_t ret;
-    unsigned int i;
 
-    for (i = 0; i < multi_recv_op_max; i++) {
-        struct hg_core_multi_recv_op *multi_recv_op =
-            &context->multi_recv_ops[i];
-        na_return_t na_ret;
+    /* Next lookups must not return this address */
+    if (hg_core_addr->lookup_name != NULL)
+        hg_core_addr_map_remove(hg_core_addr);
 
-        na_ret = NA_Cancel(na_class, na_context, multi_recv_op->op_id);
-        HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_SUCCESS, error, ret,
-            (hg_return_t) na_ret, "NA_Cancel() of multi-recv op failed (%s)",
+    if (hg_core_addr->core_addr.na_addr != NULL) {
+        na_return_t na_ret =
+            NA_Addr_set_remove(hg_core_addr->core_addr.core_class->na_class,
+                hg_core_addr->core_addr.na_addr);
+        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "NA_Addr_set_remove() failed (%s)",
             NA_Error_to_string(na_ret));
     }
 
-    while (hg_atomic_get32(&context->multi_recv_op_count) != 0) {
-        ret = hg_core_progress_na(na_class, na_context, NULL);
-        HG_CHECK_SUBSYS_HG_ERROR(
-            ctx, error, ret, "Could not make progress on NA");
+#ifdef NA_HAS_SM
+    if (hg_core_addr->core_addr.na_sm_addr != NULL) {
+        na_return_t na_ret =
+            NA_Addr_set_remove(hg_core_addr->core_addr.core_class->na_sm_class,
+                hg_core_addr->core_addr.na_sm_addr);
+        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "NA_Addr_set_remove() failed (%s)",
+            NA_Error_to_string(na_ret));
     }
+#endif
 
     return HG_SUCCESS;
 
@@ -2184,480 +5716,632 @@ error:
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_context_check_handle_list(struct hg_core_handle_list *handle_list)
+hg_core_addr_self(struct hg_core_private_class *hg_core_class,
+    struct hg_core_private_addr **hg_core_addr_p)
 {
-    struct hg_core_private_handle *hg_core_handle = NULL;
+    struct hg_core_private_addr *hg_core_addr = NULL;
     hg_return_t ret;
+    na_return_t na_ret;
 
-    hg_thread_spin_lock(&handle_list->lock);
+    ret = hg_core_addr_create(hg_core_class, &hg_core_addr);
+    HG_CHECK_SUBSYS_HG_ERROR(addr, error, ret, "Could not create HG core addr");
+    hg_core_addr->core_addr.is_self = true;
 
-    if (LIST_EMPTY(&handle_list->list))
-        HG_GOTO_DONE(unlock, ret, HG_SUCCESS);
+    /* Get NA address */
+    na_ret = NA_Addr_self(
+        hg_core_class->core_class.na_class, &hg_core_addr->core_addr.na_addr);
+    HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
+        (hg_return_t) na_ret, "Could not get self address (%s)",
+        NA_Error_to_string(na_ret));
 
-    LIST_FOREACH (hg_core_handle, &handle_list->list, created) {
-        /* TODO ideally we'd want the upper layer to print that */
-        if (hg_core_handle->core_handle.data)
-            HG_LOG_SUBSYS_ERROR(ctx, "Handle (%p) was not destroyed",
-                hg_core_handle->core_handle.data);
-        HG_LOG_SUBSYS_DEBUG(
-            ctx, "Core handle (%p) was not destroyed", (void *) hg_core_handle);
+    /* Cache serialize size */
+    hg_core_addr->na_addr_serialize_size = NA_Addr_get_serialize_size(
+        hg_core_class->core_class.na_class, hg_core_addr->core_addr.na_addr);
+
+#ifdef NA_HAS_SM
+    if (hg_core_class->core_class.na_sm_class) {
+        /* Get SM address */
+        na_ret = NA_Addr_self(hg_core_class->core_class.na_sm_class,
+            &hg_core_addr->core_addr.na_sm_addr);
+        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "Could not get self SM address (%s)",
+            NA_Error_to_string(na_ret));
+
+        /* Cache serialize size */
+        hg_core_addr->na_sm_addr_serialize_size =
+            NA_Addr_get_serialize_size(hg_core_class->core_class.na_sm_class,
+                hg_core_addr->core_addr.na_sm_addr);
+
+        /* Copy local host ID */
+        NA_SM_Host_id_copy(&hg_core_addr->host_id, hg_core_class->host_id);
     }
-    ret = HG_BUSY;
+#endif
 
-unlock:
-    hg_thread_spin_unlock(&handle_list->lock);
+    *hg_core_addr_p = hg_core_addr;
+
+    return HG_SUCCESS;
+
+error:
+    hg_core_addr_free(hg_core_addr);
 
     return ret;
 }
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_context_list_wait(struct hg_core_private_context *context,
-    struct hg_core_handle_list *handle_list, unsigned int timeout_ms)
+hg_core_addr_dup(struct hg_core_private_addr *hg_core_addr,
+    struct hg_core_private_addr **hg_core_addr_p)
 {
-    bool list_empty = false;
-    hg_time_t deadline, now = hg_time_from_ms(0);
-    unsigned int count = hg_core_completion_count(context);
+    struct hg_core_private_addr *hg_new_addr = NULL;
     hg_return_t ret;
 
-    if (timeout_ms != 0)
-        hg_time_get_current_ms(&now);
-    deadline = hg_time_add(now, hg_time_from_ms(timeout_ms));
+    ret = hg_core_addr_create(HG_CORE_ADDR_CLASS(hg_core_addr), &hg_new_addr);
+    HG_CHECK_SUBSYS_HG_ERROR(addr, error, ret, "Could not create HG core addr");
+    hg_new_addr->core_addr.is_self = hg_core_addr->core_addr.is_self;
 
-    /* Make first progress pass without waiting to empty trigger queues */
-    ret = hg_core_progress_wait(context, 0);
-    HG_CHECK_SUBSYS_ERROR_NORET(ctx, ret != HG_SUCCESS && ret != HG_TIMEOUT,
-        error, "Could not make progress");
+    if (hg_core_addr->core_addr.na_addr != NULL) {
+        na_return_t na_ret = NA_Addr_dup(
+            hg_core_addr->core_addr.core_class->na_class,
+            hg_core_addr->core_addr.na_addr, &hg_new_addr->core_addr.na_addr);
+        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "Could not duplicate address (%s)",
+            NA_Error_to_string(na_ret));
 
-    for (;;) {
-        /* Trigger everything we can from HG */
-        hg_core_trigger(context, count, NULL);
+        /* Copy serialize size */
+        hg_new_addr->na_addr_serialize_size =
+            hg_core_addr->na_addr_serialize_size;
+    }
 
-        /* Make progress until list is empty */
-        hg_thread_spin_lock(&handle_list->lock);
-        list_empty = LIST_EMPTY(&handle_list->list);
-        hg_thread_spin_unlock(&handle_list->lock);
-        if (list_empty)
-            break;
+#ifdef NA_HAS_SM
+    if (hg_core_addr->core_addr.na_sm_addr != NULL) {
+        na_return_t na_ret =
+            NA_Addr_dup(hg_core_addr->core_addr.core_class->na_sm_class,
+                hg_core_addr->core_addr.na_sm_addr,
+                &hg_new_addr->core_addr.na_sm_addr);
+        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "Could not duplicate address (%s)",
+            NA_Error_to_string(na_ret));
 
-        /* Gives a chance to always call trigger after progress */
-        if (timeout_ms != 0)
-            hg_time_get_current_ms(&now);
-        if (!hg_time_less(now, deadline))
-            break;
+        /* Copy serialize size */
+        hg_new_addr->na_sm_addr_serialize_size =
+            hg_core_addr->na_sm_addr_serialize_size;
 
-        ret = hg_core_progress(context, &count);
-        HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret, "Could not make progress");
+        /* Copy local host ID */
+        NA_SM_Host_id_copy(&hg_new_addr->host_id, hg_core_addr->host_id);
     }
+#endif
 
-    HG_LOG_SUBSYS_DEBUG(ctx, "List empty: %d (timeout=%u ms)", list_empty,
-        hg_time_to_ms(hg_time_subtract(deadline, now)));
+    *hg_core_addr_p = hg_new_addr;
 
     return HG_SUCCESS;
 
 error:
+    hg_core_addr_free(hg_new_addr);
+
     return ret;
 }
 
 /*---------------------------------------------------------------------------*/
-struct hg_bulk_op_pool *
-hg_core_context_get_bulk_op_pool(struct hg_core_context *core_context)
+static bool
+hg_core_addr_cmp(
+    struct hg_core_private_addr *addr1, struct hg_core_private_addr *addr2)
 {
-    return ((struct hg_core_private_context *) core_context)->hg_bulk_op_pool;
+    bool ret = true;
+
+    /* Cannot be separate classes */
+    if (addr1->core_addr.core_class != addr2->core_addr.core_class)
+        return false;
+
+    /* Self addresses are always equal */
+    if (addr1->core_addr.is_self && addr2->core_addr.is_self)
+        return true;
+
+    /* Compare NA addresses */
+    ret &= NA_Addr_cmp(addr1->core_addr.core_class->na_class,
+        addr1->core_addr.na_addr, addr2->core_addr.na_addr);
+
+#ifdef NA_HAS_SM
+    /* Compare NA SM addresses */
+    if (addr1->core_addr.core_class->na_sm_class)
+        ret &= NA_Addr_cmp(addr1->core_addr.core_class->na_sm_class,
+            addr1->core_addr.na_sm_addr, addr2->core_addr.na_sm_addr);
+#endif
+
+    return ret;
 }
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_handle_pool_create(struct hg_core_private_context *context,
-    na_class_t *na_class, na_context_t *na_context, unsigned long flags,
-    unsigned int init_count, unsigned int incr_count,
-    struct hg_core_handle_pool **hg_core_handle_pool_p)
+hg_core_addr_to_string(
+    char *buf, hg_size_t *buf_size, struct hg_core_private_addr *hg_core_addr)
 {
-    struct hg_core_handle_pool *hg_core_handle_pool = NULL;
-    bool pending_list_lock_init = false, extend_mutex_init = false,
-         extend_cond_init = false;
+    na_class_t *na_class = hg_core_addr->core_addr.core_class->na_class;
+    na_addr_t *na_addr = hg_core_addr->core_addr.na_addr;
+    char *buf_ptr = buf;
+    size_t new_buf_size = 0, buf_size_used = 0;
     hg_return_t ret;
-    unsigned int i;
-    int rc;
+    na_return_t na_ret;
 
-    HG_LOG_SUBSYS_DEBUG(ctx,
-        "Creating pool of handles (init_count=%u, incr_count=%u)", init_count,
-        init_count);
+    new_buf_size = (size_t) *buf_size;
 
-    hg_core_handle_pool =
-        (struct hg_core_handle_pool *) calloc(1, sizeof(*hg_core_handle_pool));
-    HG_CHECK_SUBSYS_ERROR(ctx, hg_core_handle_pool == NULL, error, ret,
-        HG_NOMEM, "Could not allocate handle pool");
+#ifdef NA_HAS_SM
+    /* When we have local and remote addresses */
+    if ((hg_core_addr->core_addr.na_sm_addr != NULL) &&
+        (hg_core_addr->core_addr.na_addr != NULL)) {
+        char addr_str[HG_CORE_ADDR_MAX_SIZE];
+        char uuid_str[NA_SM_HOST_ID_LEN + 1];
+        int desc_len;
 
-    LIST_INIT(&hg_core_handle_pool->pending_list.list);
-    rc = hg_thread_spin_init(&hg_core_handle_pool->pending_list.lock);
-    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
-        "hg_thread_spin_init() failed");
-    pending_list_lock_init = true;
+        /* Convert host ID to string and generate addr string */
+        na_ret = NA_SM_Host_id_to_string(hg_core_addr->host_id, uuid_str);
+        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "NA_SM_Host_id_to_string() failed (%s)",
+            NA_Error_to_string(na_ret));
 
-    rc = hg_thread_mutex_init(&hg_core_handle_pool->extend_mutex);
-    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
-        "hg_thread_mutex_init() failed");
-    extend_mutex_init = true;
-    hg_thread_cond_init(&hg_core_handle_pool->extend_cond);
-    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
-        "hg_thread_cond_init() failed");
-    extend_cond_init = true;
+        desc_len = snprintf(addr_str, HG_CORE_ADDR_MAX_SIZE,
+            "uid://%s" HG_CORE_ADDR_DELIMITER, uuid_str);
+        HG_CHECK_SUBSYS_ERROR(addr, desc_len > HG_CORE_ADDR_MAX_SIZE, error,
+            ret, HG_OVERFLOW, "Exceeding max addr name");
 
-    hg_core_handle_pool->count = init_count;
-    hg_core_handle_pool->incr_count = incr_count;
-    hg_core_handle_pool->extending = false;
-    hg_core_handle_pool->context = context;
-    hg_core_handle_pool->na_class = na_class;
-    hg_core_handle_pool->na_context = na_context;
-    hg_core_handle_pool->flags = flags;
+        if (buf_ptr) {
+            strcpy(buf_ptr, addr_str);
+            buf_ptr += desc_len;
+        }
+        buf_size_used += (hg_size_t) desc_len;
+        if (*buf_size > (unsigned int) desc_len)
+            new_buf_size = *buf_size - (size_t) desc_len;
 
-    for (i = 0; i < init_count; i++) {
-        ret = hg_core_handle_pool_insert(
-            context, na_class, na_context, flags, hg_core_handle_pool);
-        HG_CHECK_SUBSYS_HG_ERROR(
-            ctx, error, ret, "Could not insert handle %u into pool", i);
+        /* Get NA SM address string */
+        na_ret =
+            NA_Addr_to_string(hg_core_addr->core_addr.core_class->na_sm_class,
+                buf_ptr, &new_buf_size, hg_core_addr->core_addr.na_sm_addr);
+        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "Could not convert SM address to string (%s)",
+            NA_Error_to_string(na_ret));
+
+        if (buf_ptr) {
+            buf_ptr[new_buf_size - 1] = *HG_CORE_ADDR_DELIMITER;
+            buf_ptr += new_buf_size;
+        }
+        buf_size_used += new_buf_size;
+        if (*buf_size > new_buf_size)
+            new_buf_size = *buf_size - new_buf_size;
+    } else if (hg_core_addr->core_addr.na_sm_addr != NULL) {
+        na_class = hg_core_addr->core_addr.core_class->na_sm_class;
+        na_addr = hg_core_addr->core_addr.na_sm_addr;
     }
+#endif
 
-    HG_LOG_SUBSYS_DEBUG(
-        ctx, "Created handle pool (%p)", (void *) hg_core_handle_pool);
+    /* Get NA address string */
+    na_ret = NA_Addr_to_string(na_class, buf_ptr, &new_buf_size, na_addr);
+    HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
+        (hg_return_t) na_ret, "Could not convert address (%p) to string (%s)",
+        (void *) na_addr, NA_Error_to_string(na_ret));
 
-    *hg_core_handle_pool_p = hg_core_handle_pool;
+    *buf_size = (hg_size_t) (new_buf_size + buf_size_used);
 
     return HG_SUCCESS;
 
 error:
-    if (hg_core_handle_pool != NULL) {
-        struct hg_core_private_handle *hg_core_handle;
-
-        hg_core_handle = LIST_FIRST(&hg_core_handle_pool->pending_list.list);
-        while (hg_core_handle) {
-            struct hg_core_private_handle *hg_core_handle_next =
-                LIST_NEXT(hg_core_handle, pending);
-            LIST_REMOVE(hg_core_handle, pending);
+    return ret;
+}
 
-            /* Prevent re-initialization */
-            hg_core_handle->reuse = false;
+/*---------------------------------------------------------------------------*/
+static hg_size_t
+hg_core_addr_get_serialize_size(
+    struct hg_core_private_addr *hg_core_addr, uint8_t flags)
+{
+    hg_size_t ret = sizeof(size_t);
 
-            /* Destroy handle */
-            (void) hg_core_destroy(hg_core_handle);
-            hg_core_handle = hg_core_handle_next;
+    if (hg_core_addr->core_addr.na_addr != NULL) {
+        if (hg_core_addr->na_addr_serialize_size == 0) {
+            /* Cache serialize size */
+            hg_core_addr->na_addr_serialize_size = NA_Addr_get_serialize_size(
+                hg_core_addr->core_addr.core_class->na_class,
+                hg_core_addr->core_addr.na_addr);
         }
 
-        if (pending_list_lock_init)
-            (void) hg_thread_spin_destroy(
-                &hg_core_handle_pool->pending_list.lock);
-        if (extend_mutex_init)
-            (void) hg_thread_mutex_destroy(&hg_core_handle_pool->extend_mutex);
-        if (extend_cond_init)
-            (void) hg_thread_cond_destroy(&hg_core_handle_pool->extend_cond);
+        ret += hg_core_addr->na_addr_serialize_size;
+    }
+
+#ifdef NA_HAS_SM
+    ret += sizeof(size_t);
+
+    if ((flags & HG_CORE_SM) && hg_core_addr->core_addr.na_sm_addr != NULL) {
+        if (hg_core_addr->na_sm_addr_serialize_size == 0) {
+            /* Cache serialize size */
+            hg_core_addr->na_sm_addr_serialize_size =
+                NA_Addr_get_serialize_size(
+                    hg_core_addr->core_addr.core_class->na_sm_class,
+                    hg_core_addr->core_addr.na_sm_addr);
+        }
 
-        free(hg_core_handle_pool);
+        ret += hg_core_addr->na_sm_addr_serialize_size +
+               sizeof(hg_core_addr->host_id);
     }
+#else
+    (void) flags;
+#endif
+
     return ret;
 }
 
 /*---------------------------------------------------------------------------*/
-static void
-hg_core_handle_pool_destroy(struct hg_core_handle_pool *hg_core_handle_pool)
+static hg_return_t
+hg_core_addr_serialize(void *buf, hg_size_t buf_size, uint8_t flags,
+    struct hg_core_private_addr *hg_core_addr)
 {
-    struct hg_core_private_handle *hg_core_handle = NULL;
+    char *buf_ptr = (char *) buf;
+    hg_size_t buf_size_left = buf_size;
+    hg_return_t ret;
 
-    HG_LOG_DEBUG("Free handle pool (%p)", (void *) hg_core_handle_pool);
+    if (hg_core_addr->core_addr.na_addr != NULL) {
+        na_return_t na_ret;
 
-    hg_thread_spin_lock(&hg_core_handle_pool->pending_list.lock);
-    hg_core_handle = LIST_FIRST(&hg_core_handle_pool->pending_list.list);
-    while (hg_core_handle) {
-        struct hg_core_private_handle *hg_core_handle_next =
-            LIST_NEXT(hg_core_handle, pending);
-        LIST_REMOVE(hg_core_handle, pending);
+        HG_CORE_ENCODE(addr, error, ret, buf_ptr, buf_size_left,
+            &hg_core_addr->na_addr_serialize_size, size_t);
 
-        /* Prevent re-initialization */
-        hg_core_handle->reuse = false;
+        na_ret = NA_Addr_serialize(hg_core_addr->core_addr.core_class->na_class,
+            buf_ptr, buf_size_left, hg_core_addr->core_addr.na_addr);
+        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "Could not serialize NA address (%s)",
+            NA_Error_to_string(na_ret));
+        buf_ptr += hg_core_addr->na_addr_serialize_size;
+        buf_size_left -= hg_core_addr->na_addr_serialize_size;
+    } else {
+        size_t na_sm_addr_serialize_size = 0;
 
-        /* Destroy handle */
-        (void) hg_core_destroy(hg_core_handle);
-        hg_core_handle = hg_core_handle_next;
+        /* Encode a 0 instead of flag */
+        HG_CORE_ENCODE(addr, error, ret, buf_ptr, buf_size_left,
+            &na_sm_addr_serialize_size, size_t);
     }
-    hg_thread_spin_unlock(&hg_core_handle_pool->pending_list.lock);
 
-    (void) hg_thread_mutex_destroy(&hg_core_handle_pool->extend_mutex);
-    (void) hg_thread_cond_destroy(&hg_core_handle_pool->extend_cond);
-    (void) hg_thread_spin_destroy(&hg_core_handle_pool->pending_list.lock);
+#ifdef NA_HAS_SM
+    if ((flags & HG_CORE_SM) && hg_core_addr->core_addr.na_sm_addr != NULL) {
+        na_return_t na_ret;
 
-    free(hg_core_handle_pool);
-}
+        HG_CORE_ENCODE(addr, error, ret, buf_ptr, buf_size_left,
+            &hg_core_addr->na_sm_addr_serialize_size, size_t);
 
-/*---------------------------------------------------------------------------*/
-static HG_INLINE bool
-hg_core_handle_pool_empty(struct hg_core_handle_pool *hg_core_handle_pool)
-{
-    bool ret;
+        na_ret =
+            NA_Addr_serialize(hg_core_addr->core_addr.core_class->na_sm_class,
+                buf_ptr, buf_size_left, hg_core_addr->core_addr.na_sm_addr);
+        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "Could not serialize NA SM address (%s)",
+            NA_Error_to_string(na_ret));
+        /*
+        buf_ptr += hg_core_addr->na_sm_addr_serialize_size;
+        buf_size_left -= hg_core_addr->na_sm_addr_serialize_size;
+*/
+    } else {
+        size_t na_sm_addr_serialize_size = 0;
 
-    hg_thread_spin_lock(&hg_core_handle_pool->pending_list.lock);
-    ret = LIST_EMPTY(&hg_core_handle_pool->pending_list.list);
-    hg_thread_spin_unlock(&hg_core_handle_pool->pending_list.lock);
+        /* Encode a 0 instead of flag */
+        HG_CORE_ENCODE(addr, error, ret, buf_ptr, buf_size_left,
+            &na_sm_addr_serialize_size, size_t);
+    }
+#else
+    (void) flags;
+#endif
+
+    return HG_SUCCESS;
 
+error:
     return ret;
 }
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_handle_pool_get(struct hg_core_handle_pool *hg_core_handle_pool,
-    struct hg_core_private_handle **hg_core_handle_p)
+hg_core_addr_deserialize(struct hg_core_private_class *hg_core_class,
+    struct hg_core_private_addr **hg_core_addr_p, const void *buf,
+    hg_size_t buf_size)
 {
-    struct hg_core_private_handle *hg_core_handle;
+    struct hg_core_private_addr *hg_core_addr = NULL;
+    const char *buf_ptr = (const char *) buf;
+    hg_size_t buf_size_left = buf_size;
+    bool is_self = true;
     hg_return_t ret;
 
-    do {
-        hg_thread_spin_lock(&hg_core_handle_pool->pending_list.lock);
-        hg_core_handle = LIST_FIRST(&hg_core_handle_pool->pending_list.list);
-        if (hg_core_handle != NULL) {
-            LIST_REMOVE(hg_core_handle, pending);
-            hg_thread_spin_unlock(&hg_core_handle_pool->pending_list.lock);
-            break;
-        }
-        hg_thread_spin_unlock(&hg_core_handle_pool->pending_list.lock);
+    /* Create new address */
+    ret = hg_core_addr_create(hg_core_class, &hg_core_addr);
+    HG_CHECK_SUBSYS_HG_ERROR(addr, error, ret, "Could not create HG core addr");
 
-        /* Grow pool when needed */
-        ret = hg_core_handle_pool_extend(hg_core_handle_pool);
-        HG_CHECK_SUBSYS_HG_ERROR(
-            ctx, error, ret, "Could not extend pool of handles");
+    HG_CORE_DECODE(addr, error, ret, buf_ptr, buf_size_left,
+        &hg_core_addr->na_addr_serialize_size, size_t);
 
-    } while (hg_core_handle == NULL);
+    if (hg_core_addr->na_addr_serialize_size != 0) {
+        na_return_t na_ret =
+            NA_Addr_deserialize(hg_core_class->core_class.na_class,
+                &hg_core_addr->core_addr.na_addr, buf_ptr, buf_size_left);
+        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "Could not deserialize NA address (%s)",
+            NA_Error_to_string(na_ret));
+        buf_ptr += hg_core_addr->na_addr_serialize_size;
+        buf_size_left -= hg_core_addr->na_addr_serialize_size;
 
-    *hg_core_handle_p = hg_core_handle;
+        is_self &= NA_Addr_is_self(hg_core_class->core_class.na_class,
+            hg_core_addr->core_addr.na_addr);
+    }
+
+#ifdef NA_HAS_SM
+    HG_CORE_DECODE(addr, error, ret, buf_ptr, buf_size_left,
+        &hg_core_addr->na_sm_addr_serialize_size, size_t);
+
+    if (hg_core_addr->na_sm_addr_serialize_size != 0) {
+        na_return_t na_ret =
+            NA_Addr_deserialize(hg_core_class->core_class.na_sm_class,
+                &hg_core_addr->core_addr.na_sm_addr, buf_ptr, buf_size_left);
+        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "Could not deserialize NA SM address (%s)",
+            NA_Error_to_string(na_ret));
+        /*
+        buf_ptr += hg_core_addr->na_sm_addr_serialize_size;
+        buf_size_left -= hg_core_addr->na_sm_addr_serialize_size;
+        */
+        is_self &= NA_Addr_is_self(hg_core_class->core_class.na_class,
+            hg_core_addr->core_addr.na_addr);
+    }
+#endif
+    hg_core_addr->core_addr.is_self = is_self;
+
+    *hg_core_addr_p = hg_core_addr;
 
     return HG_SUCCESS;
 
 error:
+    hg_core_addr_free(hg_core_addr);
+
     return ret;
 }
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_handle_pool_extend(struct hg_core_handle_pool *hg_core_handle_pool)
+hg_core_resolve_na(struct hg_core_private_context *context,
+    struct hg_core_private_addr *hg_core_addr, na_class_t **na_class_p,
+    na_context_t **na_context_p, na_addr_t **na_addr_p)
 {
-    unsigned int i;
     hg_return_t ret;
 
-    /* Create another batch of IDs if empty */
-    hg_thread_mutex_lock(&hg_core_handle_pool->extend_mutex);
-    if (hg_core_handle_pool->extending) {
-        hg_thread_cond_wait(&hg_core_handle_pool->extend_cond,
-            &hg_core_handle_pool->extend_mutex);
-        hg_thread_mutex_unlock(&hg_core_handle_pool->extend_mutex);
-        return HG_SUCCESS;
-    }
-    hg_core_handle_pool->extending = true;
-    hg_thread_mutex_unlock(&hg_core_handle_pool->extend_mutex);
+    /* Determine which NA class/context to use */
+    if (hg_core_addr != NULL) {
+        HG_CHECK_SUBSYS_ERROR(addr,
+            hg_core_addr->core_addr.core_class !=
+                context->core_context.core_class,
+            error, ret, HG_INVALID_ARG,
+            "Address and context passed belong to different classes");
 
-    /* Only a single thread can extend the pool */
-    for (i = 0; i < hg_core_handle_pool->incr_count; i++) {
-        ret = hg_core_handle_pool_insert(hg_core_handle_pool->context,
-            hg_core_handle_pool->na_class, hg_core_handle_pool->na_context,
-            hg_core_handle_pool->flags, hg_core_handle_pool);
-        HG_CHECK_SUBSYS_HG_ERROR(
-            ctx, unlock, ret, "Could not insert handle %u into pool", i);
+#ifdef NA_HAS_SM
+        if (!hg_core_addr->core_addr.is_self &&
+            (hg_core_addr->core_addr.na_sm_addr != NULL)) {
+            HG_LOG_SUBSYS_DEBUG(rpc, "Using NA SM class");
+            *na_class_p = context->core_context.core_class->na_sm_class;
+            *na_context_p = context->core_context.na_sm_context;
+            *na_addr_p = hg_core_addr->core_addr.na_sm_addr;
+        } else {
+#endif
+            /* Default */
+            HG_LOG_SUBSYS_DEBUG(rpc, "Using default NA class");
+            *na_class_p = context->core_context.core_class->na_class;
+            *na_context_p = context->core_context.na_context;
+            *na_addr_p = hg_core_addr->core_addr.na_addr;
+#ifdef NA_HAS_SM
+        }
+#endif
+    } else {
+        /* Default */
+        HG_LOG_SUBSYS_DEBUG(rpc, "Using default NA class");
+        *na_class_p = context->core_context.core_class->na_class;
+        *na_context_p = context->core_context.na_context;
+        *na_addr_p = NULL;
     }
-    hg_core_handle_pool->count += hg_core_handle_pool->incr_count;
 
-unlock:
-    hg_thread_mutex_lock(&hg_core_handle_pool->extend_mutex);
-    hg_core_handle_pool->extending = false;
-    hg_thread_cond_broadcast(&hg_core_handle_pool->extend_cond);
-    hg_thread_mutex_unlock(&hg_core_handle_pool->extend_mutex);
+    return HG_SUCCESS;
 
+error:
     return ret;
 }
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_handle_pool_insert(struct hg_core_private_context *context,
-    na_class_t *na_class, na_context_t *na_context, unsigned long flags,
-    struct hg_core_handle_pool *hg_core_handle_pool)
+hg_core_create(struct hg_core_private_context *context, na_class_t *na_class,
+    na_context_t *na_context, unsigned long flags,
+    struct hg_core_private_handle **hg_core_handle_p)
 {
     struct hg_core_private_handle *hg_core_handle = NULL;
-    struct hg_core_private_addr *hg_core_addr = NULL;
     hg_return_t ret;
-    bool post = false;
-
-    /* Create new handle */
-    ret = hg_core_create(context, na_class, na_context, flags, &hg_core_handle);
-    HG_CHECK_SUBSYS_HG_ERROR(
-        ctx, error, ret, "Could not create HG core handle");
-
-    /* Reset status */
-    hg_atomic_set32(&hg_core_handle->status, 0);
-    hg_atomic_set32(&hg_core_handle->ret_status, (int32_t) HG_SUCCESS);
-
-    /* Create new (empty) source addresses */
-    ret = hg_core_addr_create(HG_CORE_CONTEXT_CLASS(context), &hg_core_addr);
-    HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret, "Could not create HG addr");
-    hg_core_handle->core_handle.info.addr = (hg_core_addr_t) hg_core_addr;
 
-    /* Re-use handle on completion */
-    hg_core_handle->reuse = true;
+    /* Re-use previously destroyed user handle if any */
+    if (flags & HG_CORE_HANDLE_USER)
+        hg_core_handle = hg_core_handle_cache_pop(&context->handle_depot);
+    else if (flags & HG_CORE_HANDLE_BATCH)
+        hg_core_handle =
+            hg_core_batch_handle_pop(&context->batch_list, na_class);
 
-    /* Add handle to pending list */
-    hg_thread_spin_lock(&hg_core_handle_pool->pending_list.lock);
-    LIST_INSERT_HEAD(
-        &hg_core_handle_pool->pending_list.list, hg_core_handle, pending);
-    hg_thread_spin_unlock(&hg_core_handle_pool->pending_list.lock);
+    if (hg_core_handle != NULL) {
+        ret = hg_core_recycle(context, hg_core_handle, na_class, na_context);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            rpc, error, ret, "Could not re-use cached handle");
+    } else {
+        /* Allocate new handle */
+        ret = hg_core_alloc(
+            context, flags & HG_CORE_HANDLE_USER, &hg_core_handle);
+        HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not allocate handle");
 
-    /* Handle is pre-posted only when muti-recv is off */
-    if (!(flags & HG_CORE_HANDLE_MULTI_RECV)) {
-        /* Handle will need to be posted */
-        post = true;
+        /* Alloc/init NA resources */
+        ret = hg_core_alloc_na(hg_core_handle, na_class, na_context, flags);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            rpc, error, ret, "Could not allocate NA handle resources");
+    }
 
-        ret = hg_core_post(hg_core_handle);
-        HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret, "Could not post handle (%p)",
-            (void *) hg_core_handle);
+    /* Execute class callback on handle, this allows upper layers to
+     * allocate private data on handle creation */
+    if (context->handle_create_cb.callback) {
+        ret = context->handle_create_cb.callback(
+            (hg_core_handle_t) hg_core_handle, context->handle_create_cb.arg);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            rpc, error, ret, "Error in HG handle create callback");
     }
 
+    HG_LOG_SUBSYS_DEBUG(
+        rpc, "Created new handle (%p)", (void *) hg_core_handle);
+
+    *hg_core_handle_p = hg_core_handle;
+
     return HG_SUCCESS;
 
 error:
-    if (hg_core_handle != NULL) {
-        if (post) {
-            hg_thread_spin_lock(&hg_core_handle_pool->pending_list.lock);
-            LIST_REMOVE(hg_core_handle, pending);
-            hg_thread_spin_unlock(&hg_core_handle_pool->pending_list.lock);
-        }
-        hg_core_handle->reuse = false;
-        (void) hg_core_destroy(hg_core_handle);
-    }
+    (void) hg_core_destroy(hg_core_handle);
 
     return ret;
 }
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_handle_pool_unpost(
-    struct hg_core_handle_pool *hg_core_handle_pool, unsigned int timeout_ms)
+hg_core_destroy(struct hg_core_private_handle *hg_core_handle)
 {
-    struct hg_core_private_handle *hg_core_handle;
+    int32_t ref_count, flags, no_response_done = 0;
     hg_return_t ret;
 
-    if (hg_core_handle_pool->flags & HG_CORE_HANDLE_MULTI_RECV)
-        return HG_SUCCESS; /* Nothing to do */
+    if (hg_core_handle == NULL)
+        return HG_SUCCESS;
 
-    /* Check pending list and cancel posted handles */
-    hg_thread_spin_lock(&hg_core_handle_pool->pending_list.lock);
+    /* Retrieve flags before decrementing refcount */
+    flags = hg_atomic_get32(&hg_core_handle->flags);
+    if ((flags & HG_CORE_SELF_FORWARD) && (flags & HG_CORE_NO_RESPONSE))
+        no_response_done = hg_atomic_get32(&hg_core_handle->no_response_done);
 
-    LIST_FOREACH (
-        hg_core_handle, &hg_core_handle_pool->pending_list.list, pending) {
-        /* Cancel handle */
-        ret = hg_core_cancel(hg_core_handle);
-        HG_CHECK_SUBSYS_HG_ERROR(ctx, unlock, ret,
-            "Could not cancel handle (%p)", (void *) hg_core_handle);
+    /* Standard destroy refcount decrement */
+    ref_count = hg_atomic_decr32(&hg_core_handle->ref_count);
+    HG_LOG_SUBSYS_DEBUG(rpc_ref, "Handle (%p) ref_count decr to %" PRId32,
+        (void *) hg_core_handle, ref_count);
+
+    if (ref_count > 0) {
+        /* This will push the RPC handle back to completion queue when no
+         * response is sent and we are sending to ourselves. This ensures that
+         * there is no race between the callback execution and the RPC
+         * completion. */
+        if (ref_count == no_response_done)
+            hg_core_no_respond_self(hg_core_handle);
+
+        return HG_SUCCESS; /* Cannot free yet */
     }
 
-    hg_thread_spin_unlock(&hg_core_handle_pool->pending_list.lock);
+    /* Let other requests be admitted */
+    hg_core_admission_release(hg_core_handle);
+    hg_core_handle->busy = false;
+    if (hg_core_handle->batch)
+        hg_atomic_decr32(
+            &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->batch_list.live_count);
 
-    /* Check that operations have completed */
-    ret = hg_core_context_list_wait(hg_core_handle_pool->context,
-        &hg_core_handle_pool->pending_list, timeout_ms);
-    HG_CHECK_SUBSYS_HG_ERROR(
-        ctx, error, ret, "Could not wait on pool handle list");
+    /* Re-use handle if we were listening, otherwise destroy it */
+    if (hg_core_handle->reuse &&
+        !hg_atomic_get32(&HG_CORE_HANDLE_CONTEXT(hg_core_handle)->unposting)) {
+        HG_LOG_SUBSYS_DEBUG(
+            rpc, "Re-using handle (%p)", (void *) hg_core_handle);
 
-    return HG_SUCCESS;
+        /* Repost handle */
+        ret = hg_core_reset_post(hg_core_handle);
+        HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Cannot re-use handle (%p)",
+            (void *) hg_core_handle);
 
-unlock:
-    hg_thread_spin_unlock(&hg_core_handle_pool->pending_list.lock);
+        /* TODO handle error */
+    } else {
+        struct hg_core_private_class *hg_core_class =
+            HG_CORE_HANDLE_CLASS(hg_core_handle);
 
-error:
-    return ret;
-}
+        HG_LOG_SUBSYS_DEBUG(
+            rpc, "Freeing handle (%p)", (void *) hg_core_handle);
 
-/*---------------------------------------------------------------------------*/
-static HG_INLINE unsigned int
-hg_core_map_hash(hg_hash_table_key_t key)
-{
-    return *((hg_id_t *) key) & 0xffffffff;
-}
+        /* Free extra data here if needed */
+        if (hg_core_class->more_data_cb.release)
+            hg_core_class->more_data_cb.release(
+                (hg_core_handle_t) hg_core_handle);
 
-/*---------------------------------------------------------------------------*/
-static HG_INLINE int
-hg_core_map_equal(hg_hash_table_key_t key1, hg_hash_table_key_t key2)
-{
-    return *((hg_id_t *) key1) == *((hg_id_t *) key2);
-}
+        /* Free user data */
+        if (hg_core_handle->core_handle.data_free_callback)
+            hg_core_handle->core_handle.data_free_callback(
+                hg_core_handle->core_handle.data);
+        hg_core_handle->core_handle.data = NULL;
+        hg_core_handle->core_handle.data_free_callback = NULL;
 
-/*---------------------------------------------------------------------------*/
-static void
-hg_core_map_value_free(hg_hash_table_value_t value)
-{
-    struct hg_core_rpc_info *hg_core_rpc_info =
-        (struct hg_core_rpc_info *) value;
+        /* Keep user handles and their NA resources for later re-use */
+        if (hg_core_handle_cache_push(hg_core_handle))
+            return HG_SUCCESS;
 
-    if (hg_core_rpc_info->free_callback)
-        hg_core_rpc_info->free_callback(hg_core_rpc_info->data);
-    free(hg_core_rpc_info);
-}
+        /* Same for handles of coalesced requests */
+        if (hg_core_batch_handle_push(hg_core_handle))
+            return HG_SUCCESS;
 
-/*---------------------------------------------------------------------------*/
-static HG_INLINE struct hg_core_rpc_info *
-hg_core_map_lookup(struct hg_core_map *hg_core_map, hg_id_t *id)
-{
-    hg_hash_table_value_t value = NULL;
+        /* Free NA resources */
+        if (hg_core_handle->na_class)
+            hg_core_free_na(hg_core_handle);
+
+        /* Free handle */
+        hg_core_free(hg_core_handle);
+    }
 
-    /* Lookup key */
-    hg_thread_rwlock_rdlock(&hg_core_map->lock);
-    value = hg_hash_table_lookup(hg_core_map->map, (hg_hash_table_key_t) id);
-    hg_thread_rwlock_release_rdlock(&hg_core_map->lock);
+    return HG_SUCCESS;
 
-    return (value == HG_HASH_TABLE_NULL) ? NULL
-                                         : (struct hg_core_rpc_info *) value;
+error:
+    return ret;
 }
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_map_insert(struct hg_core_map *hg_core_map, hg_id_t *id,
-    struct hg_core_rpc_info **hg_core_rpc_info_p)
+hg_core_alloc(struct hg_core_private_context *context, bool user,
+    struct hg_core_private_handle **hg_core_handle_p)
 {
-    struct hg_core_rpc_info *hg_core_rpc_info;
+    hg_checksum_level_t checksum_level =
+        HG_CORE_CONTEXT_CLASS(context)->init_info.checksum_level;
+    struct hg_core_private_handle *hg_core_handle = NULL;
     hg_return_t ret;
-    int rc;
 
-    /* Allocate new RPC info */
-    hg_core_rpc_info =
-        (struct hg_core_rpc_info *) calloc(1, sizeof(*hg_core_rpc_info));
-    HG_CHECK_SUBSYS_ERROR(cls, hg_core_rpc_info == NULL, error, ret, HG_NOMEM,
-        "Could not allocate HG core RPC info");
-    hg_core_rpc_info->id = *id;
+    hg_core_handle =
+        (struct hg_core_private_handle *) calloc(1, sizeof(*hg_core_handle));
+    HG_CHECK_SUBSYS_ERROR(rpc, hg_core_handle == NULL, error, ret, HG_NOMEM,
+        "Could not allocate handle");
 
-    hg_thread_rwlock_wrlock(&hg_core_map->lock);
-    rc = hg_hash_table_insert(hg_core_map->map,
-        (hg_hash_table_key_t) &hg_core_rpc_info->id,
-        (hg_hash_table_value_t) hg_core_rpc_info);
-    hg_thread_rwlock_release_wrlock(&hg_core_map->lock);
-    HG_CHECK_SUBSYS_ERROR(
-        cls, rc == 0, error, ret, HG_NOMEM, "hg_hash_table_insert() failed");
+    hg_core_handle->op_type = HG_CORE_PROCESS; /* Default */
+    hg_core_handle->core_handle.info.core_class =
+        context->core_context.core_class;
+    hg_core_handle->core_handle.info.context = &context->core_context;
+    hg_core_handle->core_handle.info.addr = HG_CORE_ADDR_NULL;
+    hg_core_handle->core_handle.priority = HG_PRIORITY_DEFAULT;
 
-    *hg_core_rpc_info_p = hg_core_rpc_info;
+    /* Default ops */
+    hg_core_handle->ops = hg_core_ops_na_g;
 
-    return HG_SUCCESS;
+    /* Default return code */
+    hg_core_handle->ret = HG_SUCCESS;
 
-error:
-    free(hg_core_rpc_info);
+    /* Add handle to handle list so that we can track it */
+    hg_core_handle->created_list =
+        (user) ? &context->user_list : &context->internal_list;
+    hg_thread_spin_lock(&hg_core_handle->created_list->lock);
+    LIST_INSERT_HEAD(
+        &hg_core_handle->created_list->list, hg_core_handle, created);
+    hg_thread_spin_unlock(&hg_core_handle->created_list->lock);
 
-    return ret;
-}
+    /* Completed by default */
+    hg_atomic_init32(&hg_core_handle->status, HG_CORE_OP_COMPLETED);
+    hg_atomic_init32(
+        &hg_core_handle->ret_status, (int32_t) hg_core_handle->ret);
 
-/*---------------------------------------------------------------------------*/
-static hg_return_t
-hg_core_map_remove(struct hg_core_map *hg_core_map, hg_id_t *id)
-{
-    hg_return_t ret;
-    int rc;
+    /* Init in/out header */
+    hg_core_header_request_init(
+        &hg_core_handle->in_header, checksum_level > HG_CHECKSUM_NONE);
+    hg_core_header_response_init(
+        &hg_core_handle->out_header, checksum_level > HG_CHECKSUM_NONE);
 
-    /* Remove key */
-    hg_thread_rwlock_wrlock(&hg_core_map->lock);
-    rc = hg_hash_table_remove(hg_core_map->map, (hg_hash_table_key_t) id);
-    hg_thread_rwlock_release_wrlock(&hg_core_map->lock);
-    HG_CHECK_SUBSYS_ERROR(
-        cls, rc != 1, error, ret, HG_NOENTRY, "hg_hash_table_remove() failed");
+    /* Set refcount to 1 */
+    hg_atomic_init32(&hg_core_handle->ref_count, 1);
+    HG_LOG_SUBSYS_DEBUG(rpc_ref, "Handle (%p) ref_count set to %" PRId32,
+        (void *) hg_core_handle, 1);
+
+    /* Increment N handles from HG context */
+    hg_atomic_incr32(&context->n_handles);
+
+    *hg_core_handle_p = hg_core_handle;
 
     return HG_SUCCESS;
 
@@ -2666,413 +6350,621 @@ error:
 }
 
 /*---------------------------------------------------------------------------*/
-static hg_return_t
-hg_core_addr_lookup(struct hg_core_private_class *hg_core_class,
-    const char *name, struct hg_core_private_addr **addr_p)
+static void
+hg_core_free(struct hg_core_private_handle *hg_core_handle)
 {
-    struct hg_core_private_addr *hg_core_addr = NULL;
-    na_class_t **na_class_p = NULL;
-    na_addr_t **na_addr_p = NULL;
-    size_t *na_addr_serialize_size_p = NULL;
-    na_return_t na_ret;
-    const char *name_str = NULL;
-    hg_return_t ret;
+    hg_core_detach(hg_core_handle);
 
-    /* Allocate addr */
-    ret = hg_core_addr_create(hg_core_class, &hg_core_addr);
-    HG_CHECK_SUBSYS_HG_ERROR(addr, error, ret, "Could not create HG core addr");
+    hg_core_header_request_finalize(&hg_core_handle->in_header);
+    hg_core_header_response_finalize(&hg_core_handle->out_header);
 
-    /* TODO lookup could also create self addresses */
+    free(hg_core_handle);
+}
 
-#ifdef NA_HAS_SM
-    if (hg_core_class->core_class.na_sm_class != NULL)
-        name_str = strstr(name, HG_CORE_ADDR_DELIMITER);
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_detach(struct hg_core_private_handle *hg_core_handle)
+{
+    /* Remove reference to HG addr */
+    hg_core_addr_free(
+        (struct hg_core_private_addr *) hg_core_handle->core_handle.info.addr);
+    hg_core_handle->core_handle.info.addr = HG_CORE_ADDR_NULL;
 
-    /* Parse name string */
-    if (name_str != NULL) {
-        char uuid_str[NA_SM_HOST_ID_LEN + 1];
-        int rc;
+    /* Remove handle from list */
+    hg_thread_spin_lock(&hg_core_handle->created_list->lock);
+    LIST_REMOVE(hg_core_handle, created);
+    hg_thread_spin_unlock(&hg_core_handle->created_list->lock);
 
-        /* Get first part of address string with host ID */
-        rc = sscanf(name, "uid://%11[^#]", uuid_str);
-        HG_CHECK_SUBSYS_ERROR(addr, rc != 1, error, ret, HG_PROTONOSUPPORT,
-            "Malformed address format (%s)", name);
+    /* Decrement N handles from HG context */
+    hg_atomic_decr32(&HG_CORE_HANDLE_CONTEXT(hg_core_handle)->n_handles);
+}
 
-        na_ret = NA_SM_String_to_host_id(uuid_str, &hg_core_addr->host_id);
-        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
-            (hg_return_t) na_ret, "NA_SM_String_to_host_id() failed (%s)",
-            NA_Error_to_string(na_ret));
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_recycle(struct hg_core_private_context *context,
+    struct hg_core_private_handle *hg_core_handle, na_class_t *na_class,
+    na_context_t *na_context)
+{
+    hg_return_t ret;
 
-        /* Skip delimiter */
-        name_str += HG_CORE_ADDR_DELIMITER_LEN;
+    /* Reset handle (user data was already freed on destroy) */
+    hg_core_reset(hg_core_handle);
+    hg_core_handle->core_handle.info.id = 0;
+    hg_core_handle->core_handle.rpc_info = NULL;
+    hg_core_handle->core_handle.priority = HG_PRIORITY_DEFAULT;
+    hg_core_handle->na_addr = NULL;
+    hg_core_handle->ops = hg_core_ops_na_g;
+    hg_atomic_init32(&hg_core_handle->flags, 0);
+    hg_atomic_init32(&hg_core_handle->no_response_done, 0);
+    hg_atomic_init32(&hg_core_handle->status, HG_CORE_OP_COMPLETED);
+    hg_atomic_init32(
+        &hg_core_handle->ret_status, (int32_t) hg_core_handle->ret);
 
-        /* Compare IDs, if they match it's local address */
-        if (NA_SM_Host_id_cmp(hg_core_addr->host_id, hg_core_class->host_id)) {
-            HG_LOG_SUBSYS_DEBUG(addr, "%s is a local address", name);
-            na_class_p = &hg_core_addr->core_addr.core_class->na_sm_class;
-            na_addr_p = &hg_core_addr->core_addr.na_sm_addr;
-            na_addr_serialize_size_p = &hg_core_addr->na_sm_addr_serialize_size;
-        } else {
-            /* Remote lookup */
-            name_str = strstr(name_str, HG_CORE_ADDR_DELIMITER);
-            HG_CHECK_SUBSYS_ERROR(addr, name_str == NULL, error, ret,
-                HG_PROTONOSUPPORT, "Malformed remote address string (%s)",
-                name);
+    /* Add handle back to handle list so that we can track it */
+    hg_thread_spin_lock(&hg_core_handle->created_list->lock);
+    LIST_INSERT_HEAD(
+        &hg_core_handle->created_list->list, hg_core_handle, created);
+    hg_thread_spin_unlock(&hg_core_handle->created_list->lock);
 
-            na_class_p = &hg_core_addr->core_addr.core_class->na_class;
-            na_addr_p = &hg_core_addr->core_addr.na_addr;
-            na_addr_serialize_size_p = &hg_core_addr->na_addr_serialize_size;
-            name_str += HG_CORE_ADDR_DELIMITER_LEN;
-        }
-    } else {
-#endif
-        /* Remote lookup */
-        na_class_p = &hg_core_addr->core_addr.core_class->na_class;
-        na_addr_p = &hg_core_addr->core_addr.na_addr;
-        na_addr_serialize_size_p = &hg_core_addr->na_addr_serialize_size;
-        name_str = name;
-#ifdef NA_HAS_SM
-    }
-#endif
+    /* Set refcount to 1 */
+    hg_atomic_init32(&hg_core_handle->ref_count, 1);
+    HG_LOG_SUBSYS_DEBUG(rpc_ref, "Handle (%p) ref_count set to %" PRId32,
+        (void *) hg_core_handle, 1);
 
-    /* Lookup adress */
-    na_ret = NA_Addr_lookup(*na_class_p, name_str, na_addr_p);
-    HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
-        (hg_return_t) na_ret, "Could not lookup address %s (%s)", name_str,
-        NA_Error_to_string(na_ret));
+    /* Increment N handles from HG context */
+    hg_atomic_incr32(&context->n_handles);
 
-    /* Cache serialize size */
-    *na_addr_serialize_size_p =
-        NA_Addr_get_serialize_size(*na_class_p, *na_addr_p);
+    /* Handle may have been cached with resources from another NA class */
+    if (na_class != hg_core_handle->na_class) {
+        hg_core_free_na(hg_core_handle);
 
-    *addr_p = hg_core_addr;
+        ret = hg_core_alloc_na(
+            hg_core_handle, na_class, na_context, HG_CORE_HANDLE_USER);
+        HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret,
+            "Could not re-allocate NA resources for this handle (%p)",
+            (void *) hg_core_handle);
+    }
 
     return HG_SUCCESS;
 
 error:
-    hg_core_addr_free(hg_core_addr);
-
     return ret;
 }
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_addr_create(struct hg_core_private_class *hg_core_class,
-    struct hg_core_private_addr **hg_core_addr_p)
+hg_core_alloc_na(struct hg_core_private_handle *hg_core_handle,
+    na_class_t *na_class, na_context_t *na_context, unsigned long flags)
 {
-    struct hg_core_private_addr *hg_core_addr = NULL;
+    struct hg_core_private_context *context =
+        HG_CORE_HANDLE_CONTEXT(hg_core_handle);
     hg_return_t ret;
+    na_return_t na_ret;
 
-    hg_core_addr =
-        (struct hg_core_private_addr *) calloc(1, sizeof(*hg_core_addr));
-    HG_CHECK_SUBSYS_ERROR(addr, hg_core_addr == NULL, error, ret, HG_NOMEM,
-        "Could not allocate HG core addr");
+    /* Set NA class / context */
+    hg_core_handle->na_class = na_class;
+    hg_core_handle->na_context = na_context;
 
-    hg_core_addr->core_addr.core_class = (hg_core_class_t *) hg_core_class;
-    hg_core_addr->core_addr.na_addr = NULL;
-#ifdef NA_HAS_SM
-    hg_core_addr->core_addr.na_sm_addr = NULL;
-#endif
-    hg_core_addr->core_addr.is_self = false;
+    /* When using multi-recv, only allocate resources per handle for expected
+     * messages. */
+    if (flags & HG_CORE_HANDLE_MULTI_RECV) {
+        if (flags & HG_CORE_HANDLE_MULTI_RECV_COPY) {
+            hg_core_handle->in_buf_storage_size =
+                NA_Msg_get_max_unexpected_size(na_class);
 
-    hg_atomic_init32(&hg_core_addr->ref_count, 1);
+            hg_core_handle->in_buf_storage = hg_core_msg_buf_alloc(context,
+                na_class, hg_core_handle->in_buf_storage_size, NA_RECV,
+                &hg_core_handle->in_buf_plugin_data);
+            HG_CHECK_SUBSYS_ERROR(rpc, hg_core_handle->in_buf_storage == NULL,
+                error, ret, HG_NOMEM, "Could not allocate buffer for input");
+        }
+        hg_core_handle->core_handle.in_buf = NULL;
+        hg_core_handle->core_handle.in_buf_size = 0;
+    } else {
+        /* Initialize in/out buffers and use unexpected message size */
+        hg_core_handle->in_buf_storage_size =
+            NA_Msg_get_max_unexpected_size(na_class);
 
-    /* Increment N addrs from HG class */
-    hg_atomic_incr32(&hg_core_class->n_addrs);
+        hg_core_handle->in_buf_storage = hg_core_msg_buf_alloc(context,
+            na_class, hg_core_handle->in_buf_storage_size,
+            (flags & HG_CORE_HANDLE_LISTEN) ? NA_RECV : NA_SEND,
+            &hg_core_handle->in_buf_plugin_data);
+        HG_CHECK_SUBSYS_ERROR(rpc, hg_core_handle->in_buf_storage == NULL,
+            error, ret, HG_NOMEM, "Could not allocate buffer for input");
 
-    *hg_core_addr_p = hg_core_addr;
+        hg_core_handle->core_handle.in_buf = hg_core_handle->in_buf_storage;
+        hg_core_handle->core_handle.in_buf_size =
+            hg_core_handle->in_buf_storage_size;
+
+        na_ret =
+            NA_Msg_init_unexpected(na_class, hg_core_handle->in_buf_storage,
+                hg_core_handle->in_buf_storage_size);
+        HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "Could not initialize input buffer (%s)",
+            NA_Error_to_string(na_ret));
+
+        hg_core_handle->na_recv_op_id = NA_Op_create(na_class, NA_OP_SINGLE);
+        HG_CHECK_SUBSYS_ERROR(rpc, hg_core_handle->na_recv_op_id == NULL, error,
+            ret, HG_NA_ERROR, "Could not create NA op ID");
+    }
+
+    hg_core_handle->core_handle.out_buf_size =
+        NA_Msg_get_max_expected_size(na_class);
+
+    hg_core_handle->core_handle.na_in_header_offset =
+        NA_Msg_get_unexpected_header_size(na_class);
+    hg_core_handle->core_handle.na_out_header_offset =
+        NA_Msg_get_expected_header_size(na_class);
+
+    hg_core_handle->core_handle.out_buf = hg_core_msg_buf_alloc(context,
+        na_class, hg_core_handle->core_handle.out_buf_size,
+        (flags & HG_CORE_HANDLE_LISTEN) ? NA_SEND : NA_RECV,
+        &hg_core_handle->out_buf_plugin_data);
+    HG_CHECK_SUBSYS_ERROR(rpc, hg_core_handle->core_handle.out_buf == NULL,
+        error, ret, HG_NOMEM, "Could not allocate buffer for output");
+
+    na_ret = NA_Msg_init_expected(na_class, hg_core_handle->core_handle.out_buf,
+        hg_core_handle->core_handle.out_buf_size);
+    HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_SUCCESS, error, ret,
+        (hg_return_t) na_ret, "Could not initialize output buffer (%s)",
+        NA_Error_to_string(na_ret));
+
+    /* Create NA operation IDs */
+    hg_core_handle->na_send_op_id = NA_Op_create(na_class, NA_OP_SINGLE);
+    HG_CHECK_SUBSYS_ERROR(rpc, hg_core_handle->na_send_op_id == NULL, error,
+        ret, HG_NA_ERROR, "Could not create NA op ID");
+
+    hg_core_handle->na_ack_op_id = NA_Op_create(na_class, NA_OP_SINGLE);
+    HG_CHECK_SUBSYS_ERROR(rpc, hg_core_handle->na_ack_op_id == NULL, error, ret,
+        HG_NA_ERROR, "Could not create NA op ID");
+
+    hg_atomic_init32(
+        &hg_core_handle->op_expected_count, 1); /* Default (no response) */
+    HG_LOG_SUBSYS_DEBUG(rpc_ref, "Handle (%p) expected_count set to %" PRId32,
+        (void *) hg_core_handle, 1);
+    hg_atomic_init32(&hg_core_handle->op_completed_count, 0);
 
     return HG_SUCCESS;
 
 error:
+    hg_core_free_na(hg_core_handle);
+
     return ret;
 }
 
 /*---------------------------------------------------------------------------*/
 static void
-hg_core_addr_free(struct hg_core_private_addr *hg_core_addr)
+hg_core_free_na(struct hg_core_private_handle *hg_core_handle)
 {
-    struct hg_core_private_class *hg_core_class;
-
-    if (hg_core_addr == NULL)
-        return;
+    struct hg_core_private_context *context =
+        HG_CORE_HANDLE_CONTEXT(hg_core_handle);
 
-    if (hg_atomic_decr32(&hg_core_addr->ref_count))
-        /* Cannot free yet */
-        return;
+    /* Destroy NA op IDs */
+    NA_Op_destroy(hg_core_handle->na_class, hg_core_handle->na_send_op_id);
+    hg_core_handle->na_send_op_id = NULL;
 
-    /* Keep reference to core class */
-    hg_core_class = HG_CORE_ADDR_CLASS(hg_core_addr);
+    NA_Op_destroy(hg_core_handle->na_class, hg_core_handle->na_recv_op_id);
+    hg_core_handle->na_recv_op_id = NULL;
 
-    /* Free NA addresses */
-    hg_core_addr_free_na(hg_core_addr);
+    NA_Op_destroy(hg_core_handle->na_class, hg_core_handle->na_ack_op_id);
+    hg_core_handle->na_ack_op_id = NULL;
 
-    free(hg_core_addr);
+    /* Free buffers */
+    if ((hg_atomic_get32(&hg_core_handle->status) & HG_CORE_OP_MULTI_RECV) &&
+        (hg_core_handle->multi_recv_op != NULL)) {
+        hg_atomic_decr32(&hg_core_handle->multi_recv_op->ref_count);
+        hg_core_handle->multi_recv_op = NULL;
+    }
+    hg_core_msg_buf_free(context, hg_core_handle->na_class,
+        hg_core_handle->in_buf_storage, hg_core_handle->in_buf_storage_size,
+        hg_core_handle->in_buf_plugin_data);
+    hg_core_handle->in_buf_storage = NULL;
+    hg_core_handle->core_handle.in_buf = NULL;
+    hg_core_handle->in_buf_plugin_data = NULL;
 
-    /* Decrement N addrs from HG class */
-    hg_atomic_decr32(&hg_core_class->n_addrs);
-}
+    hg_core_msg_buf_free(context, hg_core_handle->na_class,
+        hg_core_handle->core_handle.out_buf,
+        hg_core_handle->core_handle.out_buf_size,
+        hg_core_handle->out_buf_plugin_data);
+    hg_core_handle->core_handle.out_buf = NULL;
+    hg_core_handle->out_buf_plugin_data = NULL;
 
-/*---------------------------------------------------------------------------*/
-static void
-hg_core_addr_free_na(struct hg_core_private_addr *hg_core_addr)
-{
-    /* Free NA address */
-    if (hg_core_addr->core_addr.na_addr != NULL) {
-        NA_Addr_free(hg_core_addr->core_addr.core_class->na_class,
-            hg_core_addr->core_addr.na_addr);
-        hg_core_addr->core_addr.na_addr = NULL;
-        hg_core_addr->na_addr_serialize_size = 0;
+    if (hg_core_handle->ack_buf != NULL) {
+        NA_Msg_buf_free(hg_core_handle->na_class, hg_core_handle->ack_buf,
+            hg_core_handle->ack_buf_plugin_data);
+        hg_core_handle->ack_buf = NULL;
+        hg_core_handle->ack_buf_plugin_data = NULL;
     }
 
-#ifdef NA_HAS_SM
-    /* Free NA SM address */
-    if (hg_core_addr->core_addr.na_sm_addr != NULL) {
-        NA_Addr_free(hg_core_addr->core_addr.core_class->na_sm_class,
-            hg_core_addr->core_addr.na_sm_addr);
-        hg_core_addr->core_addr.na_sm_addr = NULL;
-        hg_core_addr->na_sm_addr_serialize_size = 0;
-    }
-#endif
+    hg_core_handle->na_class = NULL;
+    hg_core_handle->na_context = NULL;
 }
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_addr_set_remove(struct hg_core_private_addr *hg_core_addr)
+hg_core_arena_create(na_class_t *na_class, struct hg_core_arena **arena_p)
 {
+    struct hg_core_arena *arena;
+    long hugepage_size = hg_mem_get_hugepage_size();
     hg_return_t ret;
+    int rc;
 
-    if (hg_core_addr->core_addr.na_addr != NULL) {
-        na_return_t na_ret =
-            NA_Addr_set_remove(hg_core_addr->core_addr.core_class->na_class,
-                hg_core_addr->core_addr.na_addr);
-        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
-            (hg_return_t) na_ret, "NA_Addr_set_remove() failed (%s)",
-            NA_Error_to_string(na_ret));
-    }
+    arena = (struct hg_core_arena *) calloc(1, sizeof(*arena));
+    HG_CHECK_SUBSYS_ERROR(ctx, arena == NULL, error, ret, HG_NOMEM,
+        "Could not allocate arena");
+    arena->na_class = na_class;
+    arena->chunk_size = (hugepage_size > 0) ? (size_t) hugepage_size
+                                            : HG_CORE_ARENA_CHUNK_SIZE;
 
-#ifdef NA_HAS_SM
-    if (hg_core_addr->core_addr.na_sm_addr != NULL) {
-        na_return_t na_ret =
-            NA_Addr_set_remove(hg_core_addr->core_addr.core_class->na_sm_class,
-                hg_core_addr->core_addr.na_sm_addr);
-        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
-            (hg_return_t) na_ret, "NA_Addr_set_remove() failed (%s)",
-            NA_Error_to_string(na_ret));
-    }
-#endif
+    rc = hg_thread_mutex_init(&arena->mutex);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error_free, ret,
+        HG_NOMEM, "hg_thread_mutex_init() failed");
+
+    *arena_p = arena;
 
     return HG_SUCCESS;
 
+error_free:
+    free(arena);
 error:
     return ret;
 }
 
 /*---------------------------------------------------------------------------*/
-static hg_return_t
-hg_core_addr_self(struct hg_core_private_class *hg_core_class,
-    struct hg_core_private_addr **hg_core_addr_p)
+static void
+hg_core_arena_destroy(struct hg_core_arena *arena)
 {
-    struct hg_core_private_addr *hg_core_addr = NULL;
-    hg_return_t ret;
-    na_return_t na_ret;
-
-    ret = hg_core_addr_create(hg_core_class, &hg_core_addr);
-    HG_CHECK_SUBSYS_HG_ERROR(addr, error, ret, "Could not create HG core addr");
-    hg_core_addr->core_addr.is_self = true;
-
-    /* Get NA address */
-    na_ret = NA_Addr_self(
-        hg_core_class->core_class.na_class, &hg_core_addr->core_addr.na_addr);
-    HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
-        (hg_return_t) na_ret, "Could not get self address (%s)",
-        NA_Error_to_string(na_ret));
+    unsigned int i;
 
-    /* Cache serialize size */
-    hg_core_addr->na_addr_serialize_size = NA_Addr_get_serialize_size(
-        hg_core_class->core_class.na_class, hg_core_addr->core_addr.na_addr);
+    /* All buffers have been returned since no handle remains */
+    for (i = 0; i < arena->chunk_count; i++)
+        NA_Msg_buf_free(arena->na_class, arena->chunks[i].buf,
+            arena->chunks[i].plugin_data);
+    free(arena->chunks);
+    (void) hg_thread_mutex_destroy(&arena->mutex);
+    free(arena);
+}
 
+/*---------------------------------------------------------------------------*/
+static HG_INLINE struct hg_core_arena *
+hg_core_context_arena(
+    const struct hg_core_private_context *context, const na_class_t *na_class)
+{
+    if (context->arena != NULL && context->arena->na_class == na_class)
+        return context->arena;
 #ifdef NA_HAS_SM
-    if (hg_core_class->core_class.na_sm_class) {
-        /* Get SM address */
-        na_ret = NA_Addr_self(hg_core_class->core_class.na_sm_class,
-            &hg_core_addr->core_addr.na_sm_addr);
-        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
-            (hg_return_t) na_ret, "Could not get self SM address (%s)",
-            NA_Error_to_string(na_ret));
+    if (context->sm_arena != NULL && context->sm_arena->na_class == na_class)
+        return context->sm_arena;
+#endif
 
-        /* Cache serialize size */
-        hg_core_addr->na_sm_addr_serialize_size =
-            NA_Addr_get_serialize_size(hg_core_class->core_class.na_sm_class,
-                hg_core_addr->core_addr.na_sm_addr);
+    return NULL;
+}
 
-        /* Copy local host ID */
-        NA_SM_Host_id_copy(&hg_core_addr->host_id, hg_core_class->host_id);
+/*---------------------------------------------------------------------------*/
+static unsigned int
+hg_core_arena_slot(struct hg_core_arena *arena, size_t size, bool alloc)
+{
+    unsigned int i;
+
+    /* A size slot is never released so that a given size always maps to the
+     * same slot */
+    for (i = 0; i < HG_CORE_ARENA_SIZES; i++) {
+        if (arena->sizes[i] == size)
+            return i;
+        if (arena->sizes[i] == 0)
+            break;
     }
-#endif
+    if (!alloc || size > arena->chunk_size / 8 || i == HG_CORE_ARENA_SIZES)
+        return HG_CORE_ARENA_SIZES;
+    arena->sizes[i] = size;
 
-    *hg_core_addr_p = hg_core_addr;
+    return i;
+}
 
-    return HG_SUCCESS;
+/*---------------------------------------------------------------------------*/
+static struct hg_core_arena_chunk *
+hg_core_arena_chunk_find(struct hg_core_arena *arena, const void *buf)
+{
+    unsigned int i;
 
-error:
-    hg_core_addr_free(hg_core_addr);
+    for (i = 0; i < arena->chunk_count; i++)
+        if ((const char *) buf >= arena->chunks[i].buf &&
+            (const char *) buf < arena->chunks[i].buf + arena->chunk_size)
+            return &arena->chunks[i];
 
-    return ret;
+    return NULL;
 }
 
 /*---------------------------------------------------------------------------*/
-static hg_return_t
-hg_core_addr_dup(struct hg_core_private_addr *hg_core_addr,
-    struct hg_core_private_addr **hg_core_addr_p)
+static void *
+hg_core_msg_buf_alloc(struct hg_core_private_context *context,
+    na_class_t *na_class, size_t buf_size, unsigned long flags,
+    void **plugin_data_p)
 {
-    struct hg_core_private_addr *hg_new_addr = NULL;
-    hg_return_t ret;
+    struct hg_core_arena *arena = hg_core_context_arena(context, na_class);
+    struct hg_core_arena_chunk *chunk = NULL;
+    char *buf = NULL;
+    size_t size;
+    unsigned int i, slot;
 
-    ret = hg_core_addr_create(HG_CORE_ADDR_CLASS(hg_core_addr), &hg_new_addr);
-    HG_CHECK_SUBSYS_HG_ERROR(addr, error, ret, "Could not create HG core addr");
-    hg_new_addr->core_addr.is_self = hg_core_addr->core_addr.is_self;
+    if (arena == NULL)
+        return NA_Msg_buf_alloc(na_class, buf_size, flags, plugin_data_p);
 
-    if (hg_core_addr->core_addr.na_addr != NULL) {
-        na_return_t na_ret = NA_Addr_dup(
-            hg_core_addr->core_addr.core_class->na_class,
-            hg_core_addr->core_addr.na_addr, &hg_new_addr->core_addr.na_addr);
-        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
-            (hg_return_t) na_ret, "Could not duplicate address (%s)",
-            NA_Error_to_string(na_ret));
+    /* Buffers are carved out of chunks on cache line boundaries */
+    size = (buf_size + HG_MEM_CACHE_LINE_SIZE - 1) &
+           ~((size_t) HG_MEM_CACHE_LINE_SIZE - 1);
 
-        /* Copy serialize size */
-        hg_new_addr->na_addr_serialize_size =
-            hg_core_addr->na_addr_serialize_size;
+    hg_thread_mutex_lock(&arena->mutex);
+    slot = hg_core_arena_slot(arena, size, true);
+    if (slot == HG_CORE_ARENA_SIZES) {
+        hg_thread_mutex_unlock(&arena->mutex);
+        return NA_Msg_buf_alloc(na_class, buf_size, flags, plugin_data_p);
     }
 
-#ifdef NA_HAS_SM
-    if (hg_core_addr->core_addr.na_sm_addr != NULL) {
-        na_return_t na_ret =
-            NA_Addr_dup(hg_core_addr->core_addr.core_class->na_sm_class,
-                hg_core_addr->core_addr.na_sm_addr,
-                &hg_new_addr->core_addr.na_sm_addr);
-        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
-            (hg_return_t) na_ret, "Could not duplicate address (%s)",
-            NA_Error_to_string(na_ret));
+    /* Reuse freed buffers first */
+    for (i = 0; i < arena->chunk_count; i++) {
+        chunk = &arena->chunks[i];
+        if (chunk->free_list[slot] != NULL) {
+            struct hg_core_arena_buf *arena_buf = chunk->free_list[slot];
 
-        /* Copy serialize size */
-        hg_new_addr->na_sm_addr_serialize_size =
-            hg_core_addr->na_sm_addr_serialize_size;
+            chunk->free_list[slot] = arena_buf->next;
+            chunk->busy++;
+            *plugin_data_p = chunk->plugin_data;
+            hg_thread_mutex_unlock(&arena->mutex);
 
-        /* Copy local host ID */
-        NA_SM_Host_id_copy(&hg_new_addr->host_id, hg_core_addr->host_id);
+            /* Match NA_Msg_buf_alloc() that returns zeroed buffers */
+            memset(arena_buf, 0, size);
+
+            return arena_buf;
+        }
     }
-#endif
 
-    *hg_core_addr_p = hg_new_addr;
+    /* Only the last chunk is carved out */
+    chunk = (arena->chunk_count > 0) ? &arena->chunks[arena->chunk_count - 1]
+                                     : NULL;
+    if (chunk == NULL || chunk->used + size > arena->chunk_size) {
+        struct hg_core_arena_chunk *chunks;
+
+        chunks = (struct hg_core_arena_chunk *) realloc(
+            arena->chunks, (arena->chunk_count + 1) * sizeof(*chunks));
+        HG_CHECK_SUBSYS_ERROR_NORET(
+            rpc, chunks == NULL, unlock, "Could not grow arena");
+        arena->chunks = chunks;
+
+        /* A single registration covers all the buffers of a chunk */
+        chunk = &chunks[arena->chunk_count];
+        memset(chunk, 0, sizeof(*chunk));
+        chunk->buf = NA_Msg_buf_alloc(na_class, arena->chunk_size,
+            NA_SEND | NA_RECV | NA_HUGE, &chunk->plugin_data);
+        HG_CHECK_SUBSYS_ERROR_NORET(rpc, chunk->buf == NULL, unlock,
+            "Could not allocate arena chunk of size %zu", arena->chunk_size);
+        arena->chunk_count++;
+    }
 
-    return HG_SUCCESS;
+    buf = chunk->buf + chunk->used;
+    chunk->used += size;
+    chunk->busy++;
+    *plugin_data_p = chunk->plugin_data;
 
-error:
-    hg_core_addr_free(hg_new_addr);
+unlock:
+    hg_thread_mutex_unlock(&arena->mutex);
 
-    return ret;
+    return buf;
 }
 
 /*---------------------------------------------------------------------------*/
-static bool
-hg_core_addr_cmp(
-    struct hg_core_private_addr *addr1, struct hg_core_private_addr *addr2)
+static void
+hg_core_msg_buf_free(struct hg_core_private_context *context,
+    na_class_t *na_class, void *buf, size_t buf_size, void *plugin_data)
 {
-    bool ret = true;
+    struct hg_core_arena *arena = hg_core_context_arena(context, na_class);
 
-    /* Cannot be separate classes */
-    if (addr1->core_addr.core_class != addr2->core_addr.core_class)
-        return false;
+    if (buf == NULL)
+        return;
 
-    /* Self addresses are always equal */
-    if (addr1->core_addr.is_self && addr2->core_addr.is_self)
-        return true;
+    if (arena != NULL) {
+        size_t size = (buf_size + HG_MEM_CACHE_LINE_SIZE - 1) &
+                      ~((size_t) HG_MEM_CACHE_LINE_SIZE - 1);
+        struct hg_core_arena_chunk *chunk;
+        struct hg_core_arena_buf *arena_buf = (struct hg_core_arena_buf *) buf;
+        char *chunk_buf = NULL;
+        void *chunk_plugin_data = NULL;
+        unsigned int slot;
+
+        hg_thread_mutex_lock(&arena->mutex);
+        chunk = hg_core_arena_chunk_find(arena, buf);
+        if (chunk == NULL) {
+            hg_thread_mutex_unlock(&arena->mutex);
+            NA_Msg_buf_free(na_class, buf, plugin_data);
+            return;
+        }
+        slot = hg_core_arena_slot(arena, size, false);
+        arena_buf->next = chunk->free_list[slot];
+        chunk->free_list[slot] = arena_buf;
+        chunk->busy--;
+
+        /* Release chunk once all its buffers are free, keep one chunk so that
+         * a single handle being created and destroyed does not register and
+         * deregister a chunk every time */
+        if (chunk->busy == 0 && arena->chunk_count > 1) {
+            chunk_buf = chunk->buf;
+            chunk_plugin_data = chunk->plugin_data;
+            arena->chunk_count--;
+            memmove(chunk, chunk + 1,
+                (size_t) (&arena->chunks[arena->chunk_count] - chunk) *
+                    sizeof(*chunk));
+        }
+        hg_thread_mutex_unlock(&arena->mutex);
 
-    /* Compare NA addresses */
-    ret &= NA_Addr_cmp(addr1->core_addr.core_class->na_class,
-        addr1->core_addr.na_addr, addr2->core_addr.na_addr);
+        if (chunk_buf != NULL)
+            NA_Msg_buf_free(na_class, chunk_buf, chunk_plugin_data);
+        return;
+    }
 
-#ifdef NA_HAS_SM
-    /* Compare NA SM addresses */
-    if (addr1->core_addr.core_class->na_sm_class)
-        ret &= NA_Addr_cmp(addr1->core_addr.core_class->na_sm_class,
-            addr1->core_addr.na_sm_addr, addr2->core_addr.na_sm_addr);
-#endif
+    NA_Msg_buf_free(na_class, buf, plugin_data);
+}
 
-    return ret;
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_reset(struct hg_core_private_handle *hg_core_handle)
+{
+    struct hg_core_private_class *hg_core_class =
+        HG_CORE_HANDLE_CLASS(hg_core_handle);
+
+    /* TODO context ID must always be reset as it is not passed along with
+     * the addr */
+    hg_core_handle->core_handle.info.context_id = 0;
+
+    hg_core_handle->request_callback = NULL;
+    hg_core_handle->request_arg = NULL;
+    hg_core_handle->response_callback = NULL;
+    hg_core_handle->response_arg = NULL;
+    hg_core_handle->op_type = HG_CORE_PROCESS; /* Default */
+    hg_core_handle->tag = 0;
+    hg_core_handle->cookie = 0;
+    hg_core_handle->ret = HG_SUCCESS;
+    hg_core_handle->in_buf_used = 0;
+    hg_core_handle->out_buf_used = 0;
+    hg_atomic_init32(
+        &hg_core_handle->op_expected_count, 1); /* Default (no response) */
+    HG_LOG_SUBSYS_DEBUG(rpc_ref, "Handle (%p) expected_count set to %" PRId32,
+        (void *) hg_core_handle, 1);
+    hg_atomic_init32(&hg_core_handle->op_completed_count, 0);
+
+    /* Free extra data here if needed */
+    if (hg_core_class->more_data_cb.release)
+        hg_core_class->more_data_cb.release((hg_core_handle_t) hg_core_handle);
+
+    hg_core_header_request_reset(&hg_core_handle->in_header);
+    hg_core_header_response_reset(&hg_core_handle->out_header);
 }
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_addr_to_string(
-    char *buf, hg_size_t *buf_size, struct hg_core_private_addr *hg_core_addr)
+hg_core_reset_post(struct hg_core_private_handle *hg_core_handle)
 {
-    na_class_t *na_class = hg_core_addr->core_addr.core_class->na_class;
-    na_addr_t *na_addr = hg_core_addr->core_addr.na_addr;
-    char *buf_ptr = buf;
-    size_t new_buf_size = 0, buf_size_used = 0;
+    struct hg_core_private_context *context =
+        HG_CORE_HANDLE_CONTEXT(hg_core_handle);
+    struct hg_core_handle_pool *hg_core_handle_pool;
+    bool use_multi_recv =
+        hg_atomic_get32(&hg_core_handle->status) & HG_CORE_OP_MULTI_RECV;
+    struct hg_core_multi_recv_op *multi_recv_op = hg_core_handle->multi_recv_op;
     hg_return_t ret;
-    na_return_t na_ret;
 
-    new_buf_size = (size_t) *buf_size;
+    /* Reset handle info */
+    if (hg_core_handle->core_handle.info.addr != HG_CORE_ADDR_NULL) {
+        hg_core_addr_free_na((struct hg_core_private_addr *)
+                                 hg_core_handle->core_handle.info.addr);
+    }
+    hg_core_handle->core_handle.info.id = 0;
 
-#ifdef NA_HAS_SM
-    /* When we have local and remote addresses */
-    if ((hg_core_addr->core_addr.na_sm_addr != NULL) &&
-        (hg_core_addr->core_addr.na_addr != NULL)) {
-        char addr_str[HG_CORE_ADDR_MAX_SIZE];
-        char uuid_str[NA_SM_HOST_ID_LEN + 1];
-        int desc_len;
+    /* Reset the handle */
+    hg_core_reset(hg_core_handle);
 
-        /* Convert host ID to string and generate addr string */
-        na_ret = NA_SM_Host_id_to_string(hg_core_addr->host_id, uuid_str);
-        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
-            (hg_return_t) na_ret, "NA_SM_Host_id_to_string() failed (%s)",
-            NA_Error_to_string(na_ret));
+    /* Also reset additional handle parameters */
+    hg_atomic_set32(&hg_core_handle->ref_count, 1);
+    hg_core_handle->core_handle.rpc_info = NULL;
+    HG_LOG_SUBSYS_DEBUG(rpc_ref, "Handle (%p) ref_count set to %" PRId32,
+        (void *) hg_core_handle, 1);
 
-        desc_len = snprintf(addr_str, HG_CORE_ADDR_MAX_SIZE,
-            "uid://%s" HG_CORE_ADDR_DELIMITER, uuid_str);
-        HG_CHECK_SUBSYS_ERROR(addr, desc_len > HG_CORE_ADDR_MAX_SIZE, error,
-            ret, HG_OVERFLOW, "Exceeding max addr name");
+    /* Reset status */
+    hg_atomic_set32(&hg_core_handle->status, 0);
+    hg_atomic_set32(&hg_core_handle->ret_status, (int32_t) hg_core_handle->ret);
 
-        if (buf_ptr) {
-            strcpy(buf_ptr, addr_str);
-            buf_ptr += desc_len;
+    /* Multi-recv buffers */
+    if (use_multi_recv) {
+        hg_core_handle->core_handle.in_buf = NULL;
+        hg_core_handle->core_handle.in_buf_size = 0;
+        hg_core_handle->multi_recv_op = NULL;
+    }
+
+#ifdef NA_HAS_SM
+    hg_core_handle_pool = (hg_core_handle->na_class ==
+                              context->core_context.core_class->na_sm_class)
+                              ? context->sm_handle_pool
+                              : context->handle_pool;
+#else
+    hg_core_handle_pool = context->handle_pool;
+#endif
+
+    /* Add handle back to pending list */
+    hg_core_handle_pool_push(hg_core_handle_pool, hg_core_handle);
+
+    if (use_multi_recv) {
+        if (multi_recv_op != NULL &&
+            hg_atomic_decr32(&multi_recv_op->ref_count) == 0 &&
+            hg_atomic_get32(&multi_recv_op->last)) {
+            ret = hg_core_multi_recv_repost(multi_recv_op,
+                hg_core_handle_pool->na_class, hg_core_handle_pool->na_context);
+            HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret,
+                "Cannot repost multi-recv operation (%d)", multi_recv_op->id);
         }
-        buf_size_used += (hg_size_t) desc_len;
-        if (*buf_size > (unsigned int) desc_len)
-            new_buf_size = *buf_size - (size_t) desc_len;
+    } else {
+        /* Repost single recv */
+        ret = hg_core_post(hg_core_handle);
+        HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Cannot post handle");
+    }
 
-        /* Get NA SM address string */
-        na_ret =
-            NA_Addr_to_string(hg_core_addr->core_addr.core_class->na_sm_class,
-                buf_ptr, &new_buf_size, hg_core_addr->core_addr.na_sm_addr);
-        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
-            (hg_return_t) na_ret, "Could not convert SM address to string (%s)",
-            NA_Error_to_string(na_ret));
+    return HG_SUCCESS;
 
-        if (buf_ptr) {
-            buf_ptr[new_buf_size - 1] = *HG_CORE_ADDR_DELIMITER;
-            buf_ptr += new_buf_size;
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_set_rpc(struct hg_core_private_handle *hg_core_handle,
+    struct hg_core_private_addr *hg_core_addr, na_addr_t *na_addr, hg_id_t id)
+{
+    struct hg_core_private_class *hg_core_class =
+        HG_CORE_HANDLE_CLASS(hg_core_handle);
+    struct hg_core_info *info = &hg_core_handle->core_handle.info;
+    hg_return_t ret;
+
+    /* We allow for NULL addr to be passed at creation time, this allows
+     * for pool of handles to be created and later re-used after a call to
+     * HG_Core_reset() */
+    if (hg_core_addr && (info->addr != (hg_core_addr_t) hg_core_addr)) {
+        if (info->addr != HG_CORE_ADDR_NULL)
+            hg_core_addr_free((struct hg_core_private_addr *) info->addr);
+        info->addr = (hg_core_addr_t) hg_core_addr;
+        hg_atomic_incr32(&hg_core_addr->ref_count);
+
+        /* Set NA addr to use */
+        hg_core_handle->na_addr = na_addr;
+
+        /* Set forward call depending on address self */
+        if (hg_core_class->init_info.loopback &&
+            hg_core_addr->core_addr.is_self) {
+            hg_atomic_or32(&hg_core_handle->flags, HG_CORE_SELF_FORWARD);
+            hg_core_handle->ops = hg_core_ops_self_g;
+        } else {
+            hg_atomic_and32(&hg_core_handle->flags, ~HG_CORE_SELF_FORWARD);
+            hg_core_handle->ops = hg_core_ops_na_g;
         }
-        buf_size_used += new_buf_size;
-        if (*buf_size > new_buf_size)
-            new_buf_size = *buf_size - new_buf_size;
-    } else if (hg_core_addr->core_addr.na_sm_addr != NULL) {
-        na_class = hg_core_addr->core_addr.core_class->na_sm_class;
-        na_addr = hg_core_addr->core_addr.na_sm_addr;
     }
-#endif
 
-    /* Get NA address string */
-    na_ret = NA_Addr_to_string(na_class, buf_ptr, &new_buf_size, na_addr);
-    HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
-        (hg_return_t) na_ret, "Could not convert address (%p) to string (%s)",
-        (void *) na_addr, NA_Error_to_string(na_ret));
+    /* We also allow for NULL RPC id to be passed (same reason as above) */
+    if (id && info->id != id) {
+        struct hg_core_rpc_info *hg_core_rpc_info;
 
-    *buf_size = (hg_size_t) (new_buf_size + buf_size_used);
+        /* Retrieve ID function from function map */
+        hg_core_rpc_info = hg_core_map_lookup(&hg_core_class->rpc_map, &id);
+        HG_CHECK_SUBSYS_ERROR(rpc, hg_core_rpc_info == NULL, error, ret,
+            HG_NOENTRY, "Could not find RPC ID (%" PRIu64 ") in RPC map", id);
+
+        info->id = id;
+
+        /* Cache RPC info */
+        hg_core_handle->core_handle.rpc_info = hg_core_rpc_info;
+        hg_core_handle->core_handle.priority = hg_core_rpc_info->priority;
+        if (hg_core_rpc_info->no_response)
+            hg_atomic_or32(&hg_core_handle->flags, HG_CORE_NO_RESPONSE);
+        else
+            hg_atomic_and32(&hg_core_handle->flags, ~HG_CORE_NO_RESPONSE);
+    }
+    HG_LOG_SUBSYS_DEBUG(rpc, "Handle (%p) flags set to 0x%x",
+        (void *) hg_core_handle, hg_atomic_get32(&hg_core_handle->flags));
 
     return HG_SUCCESS;
 
@@ -3081,102 +6973,112 @@ error:
 }
 
 /*---------------------------------------------------------------------------*/
-static hg_size_t
-hg_core_addr_get_serialize_size(
-    struct hg_core_private_addr *hg_core_addr, uint8_t flags)
+static hg_return_t
+hg_core_post(struct hg_core_private_handle *hg_core_handle)
 {
-    hg_size_t ret = sizeof(size_t);
-
-    if (hg_core_addr->core_addr.na_addr != NULL) {
-        if (hg_core_addr->na_addr_serialize_size == 0) {
-            /* Cache serialize size */
-            hg_core_addr->na_addr_serialize_size = NA_Addr_get_serialize_size(
-                hg_core_addr->core_addr.core_class->na_class,
-                hg_core_addr->core_addr.na_addr);
-        }
-
-        ret += hg_core_addr->na_addr_serialize_size;
-    }
+    hg_return_t ret;
+    na_return_t na_ret;
 
-#ifdef NA_HAS_SM
-    ret += sizeof(size_t);
+    /* Post a new unexpected receive */
+    na_ret = NA_Msg_recv_unexpected(hg_core_handle->na_class,
+        hg_core_handle->na_context, hg_core_recv_input_cb, hg_core_handle,
+        hg_core_handle->core_handle.in_buf,
+        hg_core_handle->core_handle.in_buf_size,
+        hg_core_handle->in_buf_plugin_data, hg_core_handle->na_recv_op_id);
+    HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_SUCCESS, error, ret,
+        (hg_return_t) na_ret,
+        "Could not post unexpected recv for input buffer (%s)",
+        NA_Error_to_string(na_ret));
 
-    if ((flags & HG_CORE_SM) && hg_core_addr->core_addr.na_sm_addr != NULL) {
-        if (hg_core_addr->na_sm_addr_serialize_size == 0) {
-            /* Cache serialize size */
-            hg_core_addr->na_sm_addr_serialize_size =
-                NA_Addr_get_serialize_size(
-                    hg_core_addr->core_addr.core_class->na_sm_class,
-                    hg_core_addr->core_addr.na_sm_addr);
-        }
+    HG_LOG_SUBSYS_DEBUG(rpc, "Posted handle (%p)", (void *) hg_core_handle);
 
-        ret += hg_core_addr->na_sm_addr_serialize_size +
-               sizeof(hg_core_addr->host_id);
-    }
-#else
-    (void) flags;
-#endif
+    return HG_SUCCESS;
 
+error:
     return ret;
 }
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_addr_serialize(void *buf, hg_size_t buf_size, uint8_t flags,
-    struct hg_core_private_addr *hg_core_addr)
+hg_core_post_multi(struct hg_core_multi_recv_op *multi_recv_op,
+    na_class_t *na_class, na_context_t *na_context)
 {
-    char *buf_ptr = (char *) buf;
-    hg_size_t buf_size_left = buf_size;
     hg_return_t ret;
+    na_return_t na_ret;
 
-    if (hg_core_addr->core_addr.na_addr != NULL) {
-        na_return_t na_ret;
+    hg_atomic_init32(&multi_recv_op->last, 0);
+    hg_atomic_init32(&multi_recv_op->ref_count, 0);
+    hg_atomic_init32(&multi_recv_op->op_count, 0);
+    if (multi_recv_op->context->multi_recv_adapt != NULL)
+        hg_time_get_current(&multi_recv_op->post_time);
 
-        HG_CORE_ENCODE(addr, error, ret, buf_ptr, buf_size_left,
-            &hg_core_addr->na_addr_serialize_size, size_t);
+    /* Post a new unexpected receive */
+    na_ret = NA_Msg_multi_recv_unexpected(na_class, na_context,
+        hg_core_multi_recv_input_cb, multi_recv_op, multi_recv_op->buf,
+        multi_recv_op->buf_size, multi_recv_op->plugin_data,
+        multi_recv_op->op_id);
+    HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_SUCCESS, error, ret,
+        (hg_return_t) na_ret, "NA_Msg_multi_recv_unexpected() failed (%s)",
+        NA_Error_to_string(na_ret));
 
-        na_ret = NA_Addr_serialize(hg_core_addr->core_addr.core_class->na_class,
-            buf_ptr, buf_size_left, hg_core_addr->core_addr.na_addr);
-        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
-            (hg_return_t) na_ret, "Could not serialize NA address (%s)",
-            NA_Error_to_string(na_ret));
-        buf_ptr += hg_core_addr->na_addr_serialize_size;
-        buf_size_left -= hg_core_addr->na_addr_serialize_size;
-    } else {
-        size_t na_sm_addr_serialize_size = 0;
+    HG_LOG_SUBSYS_DEBUG(rpc, "Posted multi-recv buffer (%p, %zu)",
+        multi_recv_op->buf, multi_recv_op->buf_size);
 
-        /* Encode a 0 instead of flag */
-        HG_CORE_ENCODE(addr, error, ret, buf_ptr, buf_size_left,
-            &na_sm_addr_serialize_size, size_t);
-    }
+    return HG_SUCCESS;
 
-#ifdef NA_HAS_SM
-    if ((flags & HG_CORE_SM) && hg_core_addr->core_addr.na_sm_addr != NULL) {
-        na_return_t na_ret;
+error:
+    return ret;
+}
 
-        HG_CORE_ENCODE(addr, error, ret, buf_ptr, buf_size_left,
-            &hg_core_addr->na_sm_addr_serialize_size, size_t);
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_multi_recv_repost(struct hg_core_multi_recv_op *multi_recv_op,
+    na_class_t *na_class, na_context_t *na_context)
+{
+    struct hg_core_private_context *context = multi_recv_op->context;
+    struct hg_core_multi_recv_adapt *adapt = context->multi_recv_adapt;
+    hg_return_t ret;
 
-        na_ret =
-            NA_Addr_serialize(hg_core_addr->core_addr.core_class->na_sm_class,
-                buf_ptr, buf_size_left, hg_core_addr->core_addr.na_sm_addr);
-        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
-            (hg_return_t) na_ret, "Could not serialize NA SM address (%s)",
-            NA_Error_to_string(na_ret));
-        /*
-        buf_ptr += hg_core_addr->na_sm_addr_serialize_size;
-        buf_size_left -= hg_core_addr->na_sm_addr_serialize_size;
-*/
-    } else {
-        size_t na_sm_addr_serialize_size = 0;
+    if (adapt != NULL) {
+        hg_time_t now;
+
+        hg_time_get_current(&now);
+        hg_thread_mutex_lock(&adapt->mutex);
+        if (hg_buf_adapt_repost(&adapt->bufs,
+                hg_time_to_double(hg_time_subtract(
+                    multi_recv_op->consume_time, multi_recv_op->post_time)),
+                hg_time_to_double(
+                    hg_time_subtract(now, multi_recv_op->consume_time)))) {
+            /* Free buffer instead of reposting it */
+            HG_LOG_SUBSYS_DEBUG(ctx,
+                "Freeing multi-recv buffer %u (%u buffers remaining)",
+                multi_recv_op->id, adapt->bufs.count);
+            NA_Msg_buf_free(
+                na_class, multi_recv_op->buf, multi_recv_op->plugin_data);
+            multi_recv_op->buf = NULL;
+            multi_recv_op->plugin_data = NULL;
+            multi_recv_op->buf_size = 0;
+            hg_thread_mutex_unlock(&adapt->mutex);
+            hg_core_stats_add_shared(
+                &context->stats->shared.multi_recv_resize, 1);
 
-        /* Encode a 0 instead of flag */
-        HG_CORE_ENCODE(addr, error, ret, buf_ptr, buf_size_left,
-            &na_sm_addr_serialize_size, size_t);
+            return HG_SUCCESS;
+        }
+
+        /* Buffer size changed since buffer was posted */
+        if (multi_recv_op->buf_size != adapt->bufs.buf_size)
+            (void) hg_core_multi_recv_buf_resize(
+                multi_recv_op, na_class, adapt->bufs.buf_size);
+        hg_thread_mutex_unlock(&adapt->mutex);
     }
-#else
-    (void) flags;
-#endif
+
+    HG_LOG_SUBSYS_DEBUG(
+        ctx, "Reposting multi-recv buffer %d", multi_recv_op->id);
+
+    ret = hg_core_post_multi(multi_recv_op, na_class, na_context);
+    HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret,
+        "Could not post multi-recv buffer %d", multi_recv_op->id);
+    hg_atomic_incr32(&context->multi_recv_op_count);
 
     return HG_SUCCESS;
 
@@ -3186,107 +7088,138 @@ error:
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_addr_deserialize(struct hg_core_private_class *hg_core_class,
-    struct hg_core_private_addr **hg_core_addr_p, const void *buf,
-    hg_size_t buf_size)
+hg_core_multi_recv_buf_resize(struct hg_core_multi_recv_op *multi_recv_op,
+    na_class_t *na_class, size_t buf_size)
 {
-    struct hg_core_private_addr *hg_core_addr = NULL;
-    const char *buf_ptr = (const char *) buf;
-    hg_size_t buf_size_left = buf_size;
-    bool is_self = true;
+    struct hg_mem_numa_policy prev_policy;
+    void *buf, *plugin_data = NULL;
+    bool numa_entered;
     hg_return_t ret;
 
-    /* Create new address */
-    ret = hg_core_addr_create(hg_core_class, &hg_core_addr);
-    HG_CHECK_SUBSYS_HG_ERROR(addr, error, ret, "Could not create HG core addr");
+    numa_entered =
+        hg_core_numa_enter(multi_recv_op->context->numa_node, &prev_policy);
+    buf = NA_Msg_buf_alloc(na_class, buf_size,
+        HG_CORE_CONTEXT_CLASS(multi_recv_op->context)->init_info.hugepage_arena
+            ? NA_MULTI_RECV | NA_HUGE
+            : NA_MULTI_RECV,
+        &plugin_data);
+    hg_core_numa_leave(numa_entered, &prev_policy);
+    HG_CHECK_SUBSYS_ERROR(ctx, buf == NULL, error, ret, HG_NOMEM,
+        "Could not allocate multi-recv buffer of size %zu", buf_size);
+
+    HG_LOG_SUBSYS_DEBUG(ctx, "Resizing multi-recv buffer %u (%zu to %zu)",
+        multi_recv_op->id, multi_recv_op->buf_size, buf_size);
+
+    if (multi_recv_op->buf != NULL)
+        NA_Msg_buf_free(
+            na_class, multi_recv_op->buf, multi_recv_op->plugin_data);
+    multi_recv_op->buf = buf;
+    multi_recv_op->plugin_data = plugin_data;
+    multi_recv_op->buf_size = buf_size;
 
-    HG_CORE_DECODE(addr, error, ret, buf_ptr, buf_size_left,
-        &hg_core_addr->na_addr_serialize_size, size_t);
+    return HG_SUCCESS;
 
-    if (hg_core_addr->na_addr_serialize_size != 0) {
-        na_return_t na_ret =
-            NA_Addr_deserialize(hg_core_class->core_class.na_class,
-                &hg_core_addr->core_addr.na_addr, buf_ptr, buf_size_left);
-        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
-            (hg_return_t) na_ret, "Could not deserialize NA address (%s)",
-            NA_Error_to_string(na_ret));
-        buf_ptr += hg_core_addr->na_addr_serialize_size;
-        buf_size_left -= hg_core_addr->na_addr_serialize_size;
+error:
+    return ret;
+}
 
-        is_self &= NA_Addr_is_self(hg_core_class->core_class.na_class,
-            hg_core_addr->core_addr.na_addr);
-    }
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_multi_recv_consumed(struct hg_core_multi_recv_op *multi_recv_op,
+    int32_t posted_count, na_class_t *na_class, na_context_t *na_context)
+{
+    struct hg_core_private_context *context = multi_recv_op->context;
+    struct hg_core_multi_recv_adapt *adapt = context->multi_recv_adapt;
+    unsigned int multi_recv_op_max =
+        HG_CORE_CONTEXT_CLASS(context)->init_info.multi_recv_op_max;
+    unsigned int flags;
 
-#ifdef NA_HAS_SM
-    HG_CORE_DECODE(addr, error, ret, buf_ptr, buf_size_left,
-        &hg_core_addr->na_sm_addr_serialize_size, size_t);
+    hg_thread_mutex_lock(&adapt->mutex);
 
-    if (hg_core_addr->na_sm_addr_serialize_size != 0) {
-        na_return_t na_ret =
-            NA_Addr_deserialize(hg_core_class->core_class.na_sm_class,
-                &hg_core_addr->core_addr.na_sm_addr, buf_ptr, buf_size_left);
-        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
-            (hg_return_t) na_ret, "Could not deserialize NA SM address (%s)",
-            NA_Error_to_string(na_ret));
-        /*
-        buf_ptr += hg_core_addr->na_sm_addr_serialize_size;
-        buf_size_left -= hg_core_addr->na_sm_addr_serialize_size;
-        */
-        is_self &= NA_Addr_is_self(hg_core_class->core_class.na_class,
-            hg_core_addr->core_addr.na_addr);
+    flags = hg_buf_adapt_consumed(&adapt->bufs, posted_count,
+        hg_atomic_get64(&context->stats->progress.multi_recv_copy));
+    if (!(flags & HG_BUF_ADAPT_ROUND)) {
+        hg_thread_mutex_unlock(&adapt->mutex);
+        return;
     }
-#endif
-    hg_core_addr->core_addr.is_self = is_self;
+    hg_atomic_set32(
+        &context->multi_recv_copy_threshold, adapt->bufs.copy_threshold);
 
-    *hg_core_addr_p = hg_core_addr;
+    HG_LOG_SUBSYS_DEBUG(ctx,
+        "Multi-recv round: %u buffers of size %zu, copy threshold %" PRId32,
+        adapt->bufs.count, adapt->bufs.buf_size, adapt->bufs.copy_threshold);
 
-    return HG_SUCCESS;
+    if (flags & HG_BUF_ADAPT_ADD) {
+        struct hg_core_multi_recv_op *grow_op = NULL;
+        unsigned int i;
 
-error:
-    hg_core_addr_free(hg_core_addr);
+        for (i = 0; i < multi_recv_op_max; i++) {
+            if (context->multi_recv_ops[i].buf == NULL) {
+                grow_op = &context->multi_recv_ops[i];
+                break;
+            }
+        }
 
-    return ret;
+        if (grow_op != NULL &&
+            hg_core_multi_recv_buf_resize(
+                grow_op, na_class, adapt->bufs.buf_size) == HG_SUCCESS) {
+            if (hg_core_post_multi(grow_op, na_class, na_context) ==
+                HG_SUCCESS) {
+                hg_atomic_incr32(&context->multi_recv_op_count);
+                hg_buf_adapt_added(&adapt->bufs);
+                flags |= HG_BUF_ADAPT_RESIZE;
+            } else {
+                NA_Msg_buf_free(na_class, grow_op->buf, grow_op->plugin_data);
+                grow_op->buf = NULL;
+                grow_op->plugin_data = NULL;
+                grow_op->buf_size = 0;
+            }
+        }
+    }
+
+    hg_thread_mutex_unlock(&adapt->mutex);
+
+    if (flags & HG_BUF_ADAPT_RESIZE)
+        hg_core_stats_add_shared(&context->stats->shared.multi_recv_resize, 1);
 }
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_resolve_na(struct hg_core_private_context *context,
-    struct hg_core_private_addr *hg_core_addr, na_class_t **na_class_p,
-    na_context_t **na_context_p, na_addr_t **na_addr_p)
+hg_core_release_input(struct hg_core_private_handle *hg_core_handle)
 {
+    struct hg_core_private_context *context =
+        HG_CORE_HANDLE_CONTEXT(hg_core_handle);
+    struct hg_core_handle_pool *hg_core_handle_pool;
+    struct hg_core_multi_recv_op *multi_recv_op = hg_core_handle->multi_recv_op;
     hg_return_t ret;
 
-    /* Determine which NA class/context to use */
-    if (hg_core_addr != NULL) {
-        HG_CHECK_SUBSYS_ERROR(addr,
-            hg_core_addr->core_addr.core_class !=
-                context->core_context.core_class,
-            error, ret, HG_INVALID_ARG,
-            "Address and context passed belong to different classes");
+    if (!(hg_atomic_get32(&hg_core_handle->status) & HG_CORE_OP_MULTI_RECV))
+        return HG_SUCCESS;
 
 #ifdef NA_HAS_SM
-        if (!hg_core_addr->core_addr.is_self &&
-            (hg_core_addr->core_addr.na_sm_addr != NULL)) {
-            HG_LOG_SUBSYS_DEBUG(rpc, "Using NA SM class");
-            *na_class_p = context->core_context.core_class->na_sm_class;
-            *na_context_p = context->core_context.na_sm_context;
-            *na_addr_p = hg_core_addr->core_addr.na_sm_addr;
-        } else {
+    hg_core_handle_pool = (hg_core_handle->na_class ==
+                              context->core_context.core_class->na_sm_class)
+                              ? context->sm_handle_pool
+                              : context->handle_pool;
+#else
+    hg_core_handle_pool = context->handle_pool;
 #endif
-            /* Default */
-            HG_LOG_SUBSYS_DEBUG(rpc, "Using default NA class");
-            *na_class_p = context->core_context.core_class->na_class;
-            *na_context_p = context->core_context.na_context;
-            *na_addr_p = hg_core_addr->core_addr.na_addr;
-#ifdef NA_HAS_SM
+
+    /* Multi-recv buffers */
+    if (multi_recv_op != NULL) {
+        if (!hg_core_handle->multi_recv_copy) {
+            hg_core_handle->core_handle.in_buf = NULL;
+            hg_core_handle->core_handle.in_buf_size = 0;
+        }
+        hg_core_handle->multi_recv_op = NULL;
+
+        if (hg_atomic_decr32(&multi_recv_op->ref_count) == 0 &&
+            hg_atomic_get32(&multi_recv_op->last)) {
+            ret = hg_core_multi_recv_repost(multi_recv_op,
+                hg_core_handle_pool->na_class, hg_core_handle_pool->na_context);
+            HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret,
+                "Cannot repost multi-recv operation (%d)", multi_recv_op->id);
         }
-#endif
-    } else {
-        /* Default */
-        HG_LOG_SUBSYS_DEBUG(rpc, "Using default NA class");
-        *na_class_p = context->core_context.core_class->na_class;
-        *na_context_p = context->core_context.na_context;
-        *na_addr_p = NULL;
     }
 
     return HG_SUCCESS;
@@ -3297,512 +7230,787 @@ error:
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_create(struct hg_core_private_context *context, na_class_t *na_class,
-    na_context_t *na_context, unsigned long flags,
-    struct hg_core_private_handle **hg_core_handle_p)
+hg_core_forward(struct hg_core_private_handle *hg_core_handle,
+    hg_core_cb_t callback, void *arg, uint8_t flags, hg_size_t payload_size,
+    unsigned int timeout_ms)
 {
-    struct hg_core_private_handle *hg_core_handle = NULL;
-    hg_return_t ret;
+    int32_t HG_DEBUG_LOG_USED ref_count;
+    int32_t status;
+    hg_size_t header_size;
+    hg_return_t ret = HG_SUCCESS;
 
-    /* Allocate new handle */
-    ret = hg_core_alloc(context, flags & HG_CORE_HANDLE_USER, &hg_core_handle);
-    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not allocate handle");
+    status = hg_atomic_get32(&hg_core_handle->status);
+    HG_CHECK_SUBSYS_ERROR(rpc,
+        !(status & HG_CORE_OP_COMPLETED) || (status & HG_CORE_OP_QUEUED), done,
+        ret, HG_BUSY, "Attempting to use handle that was not completed");
 
-    /* Alloc/init NA resources */
-    ret = hg_core_alloc_na(hg_core_handle, na_class, na_context, flags);
-    HG_CHECK_SUBSYS_HG_ERROR(
-        rpc, error, ret, "Could not allocate NA handle resources");
+    /* Increment ref_count on handle to allow for destroy to be
+     * pre-emptively called */
+    ref_count = hg_atomic_incr32(&hg_core_handle->ref_count);
+    HG_LOG_SUBSYS_DEBUG(rpc_ref, "Handle (%p) ref_count incr to %" PRId32,
+        (void *) hg_core_handle, ref_count);
 
-    /* Execute class callback on handle, this allows upper layers to
-     * allocate private data on handle creation */
-    if (context->handle_create_cb.callback) {
-        ret = context->handle_create_cb.callback(
-            (hg_core_handle_t) hg_core_handle, context->handle_create_cb.arg);
-        HG_CHECK_SUBSYS_HG_ERROR(
-            rpc, error, ret, "Error in HG handle create callback");
-    }
+    /* Reset op counts */
+    hg_atomic_set32(
+        &hg_core_handle->op_expected_count, 1); /* Default (no response) */
+    HG_LOG_SUBSYS_DEBUG(rpc_ref, "Handle (%p) expected_count set to %" PRId32,
+        (void *) hg_core_handle, 1);
+    hg_atomic_set32(&hg_core_handle->op_completed_count, 0);
 
-    HG_LOG_SUBSYS_DEBUG(
-        rpc, "Created new handle (%p)", (void *) hg_core_handle);
+    /* Reset handle ret */
+    hg_core_handle->ret = HG_SUCCESS;
 
-    *hg_core_handle_p = hg_core_handle;
+    /* Reset status */
+    hg_atomic_set32(&hg_core_handle->status, 0);
+    hg_atomic_set32(&hg_core_handle->ret_status, (int32_t) hg_core_handle->ret);
 
-    return HG_SUCCESS;
+    /* Set header size */
+    header_size = hg_core_header_request_get_size() +
+                  hg_core_handle->core_handle.na_in_header_offset;
 
-error:
-    (void) hg_core_destroy(hg_core_handle);
+    /* Set the actual size of the msg that needs to be transmitted */
+    hg_core_handle->in_buf_used = header_size + payload_size;
+    HG_CHECK_SUBSYS_ERROR(rpc,
+        hg_core_handle->in_buf_used > hg_core_handle->core_handle.in_buf_size,
+        error, ret, HG_MSGSIZE, "Exceeding input buffer size");
 
-    return ret;
-}
+    /* Parse flags */
+    if (flags & HG_CORE_MORE_DATA)
+        hg_atomic_or32(&hg_core_handle->flags, HG_CORE_MORE_DATA);
+    else
+        hg_atomic_and32(&hg_core_handle->flags, ~HG_CORE_MORE_DATA);
 
-/*---------------------------------------------------------------------------*/
-static hg_return_t
-hg_core_destroy(struct hg_core_private_handle *hg_core_handle)
-{
-    int32_t ref_count, flags, no_response_done = 0;
-    hg_return_t ret;
+    /* Set callback, keep request and response callbacks separate so that
+     * they do not get overwritten when forwarding to ourself */
+    hg_core_handle->request_callback = callback;
+    hg_core_handle->request_arg = arg;
 
-    if (hg_core_handle == NULL)
-        return HG_SUCCESS;
+    if (hg_core_rpc_hist_get(hg_core_handle) != NULL)
+        hg_time_get_current(&hg_core_handle->forward_time);
+    hg_core_trace_event(hg_core_handle, HG_CORE_TRACE_FORWARD, 0);
 
-    /* Retrieve flags before decrementing refcount */
-    flags = hg_atomic_get32(&hg_core_handle->flags);
-    if ((flags & HG_CORE_SELF_FORWARD) && (flags & HG_CORE_NO_RESPONSE))
-        no_response_done = hg_atomic_get32(&hg_core_handle->no_response_done);
+#if defined(HG_HAS_DEBUG) && !defined(_WIN32)
+    /* Increment counter */
+    hg_atomic_incr64(
+        HG_CORE_HANDLE_CLASS(hg_core_handle)->counters.rpc_req_sent_count);
+#endif
 
-    /* Standard destroy refcount decrement */
+    /* Arm deadline before forwarding as the response may arrive at any time,
+     * calls forwarded to self cannot be canceled */
+    if (timeout_ms > 0 &&
+        !(hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_SELF_FORWARD))
+        hg_core_timer_arm(hg_core_handle, timeout_ms);
+
+    /* If addr is self, forward locally, otherwise send the encoded buffer
+     * through NA and pre-post response */
+    ret = hg_core_handle->ops.forward(hg_core_handle);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not forward buffer");
+
+done:
+    return ret;
+
+error:
+    hg_core_timer_disarm(hg_core_handle);
+
+    /* Handle is no longer in use */
+    hg_atomic_set32(&hg_core_handle->status, HG_CORE_OP_COMPLETED);
+
+    /* Rollback ref_count taken above */
     ref_count = hg_atomic_decr32(&hg_core_handle->ref_count);
     HG_LOG_SUBSYS_DEBUG(rpc_ref, "Handle (%p) ref_count decr to %" PRId32,
         (void *) hg_core_handle, ref_count);
 
-    if (ref_count > 0) {
-        /* This will push the RPC handle back to completion queue when no
-         * response is sent and we are sending to ourselves. This ensures that
-         * there is no race between the callback execution and the RPC
-         * completion. */
-        if (ref_count == no_response_done)
-            hg_core_no_respond_self(hg_core_handle);
+    return ret;
+}
 
-        return HG_SUCCESS; /* Cannot free yet */
+/*---------------------------------------------------------------------------*/
+static HG_INLINE uint64_t
+hg_core_timer_now(void)
+{
+    hg_time_t now;
+
+    hg_time_get_current_ms(&now);
+
+    return (uint64_t) (hg_time_to_double(now) * 1000.0);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_timer_insert(struct hg_core_timer_wheel *timer_wheel,
+    struct hg_core_private_handle *hg_core_handle)
+{
+    uint64_t expiry = hg_core_handle->timer_expiry, delta;
+    unsigned int level = 0, slot;
+
+    /* Entries that already expired go to the slot processed next */
+    delta = (expiry > timer_wheel->now) ? expiry - timer_wheel->now : 0;
+    if (delta >= HG_CORE_TIMER_RANGE) {
+        /* Wait in the last slot of the last level and re-insert later */
+        delta = HG_CORE_TIMER_RANGE - 1;
+        expiry = timer_wheel->now + delta;
     }
+    while (level < HG_CORE_TIMER_LEVELS - 1 &&
+           delta >= (UINT64_C(1) << ((level + 1) * HG_CORE_TIMER_SLOT_BITS)))
+        level++;
+    slot = (unsigned int) (expiry >> (level * HG_CORE_TIMER_SLOT_BITS)) &
+           (HG_CORE_TIMER_SLOTS - 1);
 
-    /* Re-use handle if we were listening, otherwise destroy it */
-    if (hg_core_handle->reuse &&
-        !hg_atomic_get32(&HG_CORE_HANDLE_CONTEXT(hg_core_handle)->unposting)) {
-        HG_LOG_SUBSYS_DEBUG(
-            rpc, "Re-using handle (%p)", (void *) hg_core_handle);
+    LIST_INSERT_HEAD(&timer_wheel->slots[level][slot], hg_core_handle, timer);
+    hg_core_handle->timer_level = level;
+    timer_wheel->level_counts[level]++;
+}
 
-        /* Repost handle */
-        ret = hg_core_reset_post(hg_core_handle);
-        HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Cannot re-use handle (%p)",
-            (void *) hg_core_handle);
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_timer_arm(
+    struct hg_core_private_handle *hg_core_handle, unsigned int timeout_ms)
+{
+    struct hg_core_timer_wheel *timer_wheel =
+        &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->timer_wheel;
+    uint64_t now = hg_core_timer_now();
 
-        /* TODO handle error */
-    } else {
-        struct hg_core_private_class *hg_core_class =
-            HG_CORE_HANDLE_CLASS(hg_core_handle);
+    hg_thread_mutex_lock(&timer_wheel->mutex);
 
-        HG_LOG_SUBSYS_DEBUG(
-            rpc, "Freeing handle (%p)", (void *) hg_core_handle);
+    /* Wheel is not advanced while empty */
+    if (hg_atomic_get32(&timer_wheel->count) == 0)
+        timer_wheel->now = now;
 
-        /* Free extra data here if needed */
-        if (hg_core_class->more_data_cb.release)
-            hg_core_class->more_data_cb.release(
-                (hg_core_handle_t) hg_core_handle);
+    /* Current tick has already been processed */
+    hg_core_handle->timer_expiry = MAX(now + timeout_ms, timer_wheel->now + 1);
+    hg_core_timer_insert(timer_wheel, hg_core_handle);
+    hg_atomic_set32(&hg_core_handle->timer_armed, 1);
+    hg_atomic_incr32(&timer_wheel->count);
 
-        /* Free user data */
-        if (hg_core_handle->core_handle.data_free_callback)
-            hg_core_handle->core_handle.data_free_callback(
-                hg_core_handle->core_handle.data);
+    hg_thread_mutex_unlock(&timer_wheel->mutex);
+}
 
-        /* Free NA resources */
-        if (hg_core_handle->na_class)
-            hg_core_free_na(hg_core_handle);
+/*---------------------------------------------------------------------------*/
+static HG_INLINE void
+hg_core_timer_disarm(struct hg_core_private_handle *hg_core_handle)
+{
+    struct hg_core_timer_wheel *timer_wheel;
 
-        /* Free handle */
-        hg_core_free(hg_core_handle);
-    }
+    if (!hg_atomic_get32(&hg_core_handle->timer_armed))
+        return;
 
-    return HG_SUCCESS;
+    timer_wheel = &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->timer_wheel;
+    hg_thread_mutex_lock(&timer_wheel->mutex);
+    /* Deadline may have expired concurrently */
+    if (hg_atomic_get32(&hg_core_handle->timer_armed))
+        hg_core_timer_remove(timer_wheel, hg_core_handle);
+    hg_thread_mutex_unlock(&timer_wheel->mutex);
+}
 
-error:
-    return ret;
+/*---------------------------------------------------------------------------*/
+static HG_INLINE void
+hg_core_timer_remove(struct hg_core_timer_wheel *timer_wheel,
+    struct hg_core_private_handle *hg_core_handle)
+{
+    LIST_REMOVE(hg_core_handle, timer);
+    timer_wheel->level_counts[hg_core_handle->timer_level]--;
+    hg_atomic_set32(&hg_core_handle->timer_armed, 0);
+    hg_atomic_decr32(&timer_wheel->count);
 }
 
 /*---------------------------------------------------------------------------*/
-static hg_return_t
-hg_core_alloc(struct hg_core_private_context *context, bool user,
-    struct hg_core_private_handle **hg_core_handle_p)
+static void
+hg_core_timer_advance(struct hg_core_private_context *context)
 {
-    hg_checksum_level_t checksum_level =
-        HG_CORE_CONTEXT_CLASS(context)->init_info.checksum_level;
-    struct hg_core_private_handle *hg_core_handle = NULL;
-    hg_return_t ret;
+    struct hg_core_timer_wheel *timer_wheel = &context->timer_wheel;
+    uint64_t now;
 
-    hg_core_handle =
-        (struct hg_core_private_handle *) calloc(1, sizeof(*hg_core_handle));
-    HG_CHECK_SUBSYS_ERROR(rpc, hg_core_handle == NULL, error, ret, HG_NOMEM,
-        "Could not allocate handle");
+    /* Nothing armed */
+    if (hg_atomic_get32(&timer_wheel->count) == 0)
+        return;
 
-    hg_core_handle->op_type = HG_CORE_PROCESS; /* Default */
-    hg_core_handle->core_handle.info.core_class =
-        context->core_context.core_class;
-    hg_core_handle->core_handle.info.context = &context->core_context;
-    hg_core_handle->core_handle.info.addr = HG_CORE_ADDR_NULL;
+    now = hg_core_timer_now();
+    hg_thread_mutex_lock(&timer_wheel->mutex);
 
-    /* Default ops */
-    hg_core_handle->ops = hg_core_ops_na_g;
+    while (timer_wheel->now < now && hg_atomic_get32(&timer_wheel->count) > 0) {
+        struct hg_core_private_handle *hg_core_handle;
+        unsigned int level = 0, slot;
+        uint64_t tick;
+
+        /* Skip ticks up to the next cascade of the first non-empty level */
+        while (level < HG_CORE_TIMER_LEVELS - 1 &&
+               timer_wheel->level_counts[level] == 0)
+            level++;
+        tick = ((timer_wheel->now >> (level * HG_CORE_TIMER_SLOT_BITS)) + 1)
+               << (level * HG_CORE_TIMER_SLOT_BITS);
+        if (tick > now) {
+            /* Nothing expires before now */
+            timer_wheel->now = now;
+            break;
+        }
+        timer_wheel->now = tick;
+
+        /* Cascade slots of upper levels that start at this tick, highest
+         * level first as its handles may move to lower slots being cascaded */
+        for (level = HG_CORE_TIMER_LEVELS - 1; level > 0; level--) {
+            LIST_HEAD(, hg_core_private_handle) list;
+
+            if (tick & ((UINT64_C(1) << (level * HG_CORE_TIMER_SLOT_BITS)) - 1))
+                continue;
+
+            slot = (unsigned int) (tick >> (level * HG_CORE_TIMER_SLOT_BITS)) &
+                   (HG_CORE_TIMER_SLOTS - 1);
+            LIST_INIT(&list);
+            while ((hg_core_handle = LIST_FIRST(
+                        &timer_wheel->slots[level][slot])) != NULL) {
+                LIST_REMOVE(hg_core_handle, timer);
+                timer_wheel->level_counts[level]--;
+                LIST_INSERT_HEAD(&list, hg_core_handle, timer);
+            }
+            while ((hg_core_handle = LIST_FIRST(&list)) != NULL) {
+                LIST_REMOVE(hg_core_handle, timer);
+                hg_core_timer_insert(timer_wheel, hg_core_handle);
+            }
+        }
 
-    /* Default return code */
-    hg_core_handle->ret = HG_SUCCESS;
+        /* Cancel expired handles, completion is held back by the wheel mutex
+         * so handles remain valid until canceled */
+        slot = (unsigned int) tick & (HG_CORE_TIMER_SLOTS - 1);
+        while ((hg_core_handle = LIST_FIRST(&timer_wheel->slots[0][slot])) !=
+               NULL) {
+            hg_return_t ret;
+
+            LIST_REMOVE(hg_core_handle, timer);
+            timer_wheel->level_counts[0]--;
+            hg_atomic_decr32(&timer_wheel->count);
+
+            /* Keep timeout as return code of the canceled operations */
+            hg_atomic_cas32(&hg_core_handle->ret_status, (int32_t) HG_SUCCESS,
+                (int32_t) HG_TIMEOUT);
+            hg_core_stats_add_shared(
+                &context->stats->shared.rpc_req_timeout, 1);
+
+            ret = hg_core_cancel(hg_core_handle);
+            HG_CHECK_SUBSYS_ERROR_DONE(rpc, ret != HG_SUCCESS,
+                "Could not cancel expired handle (%p)",
+                (void *) hg_core_handle);
 
-    /* Add handle to handle list so that we can track it */
-    hg_core_handle->created_list =
-        (user) ? &context->user_list : &context->internal_list;
-    hg_thread_spin_lock(&hg_core_handle->created_list->lock);
-    LIST_INSERT_HEAD(
-        &hg_core_handle->created_list->list, hg_core_handle, created);
-    hg_thread_spin_unlock(&hg_core_handle->created_list->lock);
+            /* Handle may complete once disarmed and the wheel is unlocked */
+            hg_atomic_set32(&hg_core_handle->timer_armed, 0);
+        }
+    }
 
-    /* Completed by default */
-    hg_atomic_init32(&hg_core_handle->status, HG_CORE_OP_COMPLETED);
-    hg_atomic_init32(
-        &hg_core_handle->ret_status, (int32_t) hg_core_handle->ret);
+    hg_thread_mutex_unlock(&timer_wheel->mutex);
+}
 
-    /* Init in/out header */
-    hg_core_header_request_init(
-        &hg_core_handle->in_header, checksum_level > HG_CHECKSUM_NONE);
-    hg_core_header_response_init(
-        &hg_core_handle->out_header, checksum_level > HG_CHECKSUM_NONE);
+/*---------------------------------------------------------------------------*/
+static unsigned int
+hg_core_timer_wait_ms(
+    struct hg_core_private_context *context, unsigned int timeout_ms)
+{
+    struct hg_core_timer_wheel *timer_wheel = &context->timer_wheel;
+    uint64_t next, now;
+    unsigned int level = 0;
 
-    /* Set refcount to 1 */
-    hg_atomic_init32(&hg_core_handle->ref_count, 1);
-    HG_LOG_SUBSYS_DEBUG(rpc_ref, "Handle (%p) ref_count set to %" PRId32,
-        (void *) hg_core_handle, 1);
+    if (hg_atomic_get32(&timer_wheel->count) == 0)
+        return timeout_ms;
 
-    /* Increment N handles from HG context */
-    hg_atomic_incr32(&context->n_handles);
+    now = hg_core_timer_now();
+    hg_thread_mutex_lock(&timer_wheel->mutex);
 
-    *hg_core_handle_p = hg_core_handle;
+    /* Next expiry if the first level has entries, otherwise next cascade */
+    while (level < HG_CORE_TIMER_LEVELS - 1 &&
+           timer_wheel->level_counts[level] == 0)
+        level++;
+    next = ((timer_wheel->now >> (level * HG_CORE_TIMER_SLOT_BITS)) + 1)
+           << (level * HG_CORE_TIMER_SLOT_BITS);
+    if (level == 0)
+        while (LIST_EMPTY(&timer_wheel->slots[0][next &
+                                                 (HG_CORE_TIMER_SLOTS - 1)]))
+            next++;
 
-    return HG_SUCCESS;
+    hg_thread_mutex_unlock(&timer_wheel->mutex);
 
-error:
-    return ret;
+    /* Always wait at least a tick */
+    return (unsigned int) MIN(timeout_ms, (next > now) ? next - now : 1);
 }
 
 /*---------------------------------------------------------------------------*/
-static void
-hg_core_free(struct hg_core_private_handle *hg_core_handle)
+static hg_return_t
+hg_core_forward_self(struct hg_core_private_handle *hg_core_handle)
 {
-    /* Remove reference to HG addr */
-    hg_core_addr_free(
-        (struct hg_core_private_addr *) hg_core_handle->core_handle.info.addr);
+    hg_return_t ret;
+
+    /* Save ref_count, when sending to self and no response is being sent,
+     * we can only use that refcount to determine that the RPC callback has
+     * been fully executed. */
+    if (hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_NO_RESPONSE)
+        hg_atomic_set32(&hg_core_handle->no_response_done,
+            hg_atomic_get32(&hg_core_handle->ref_count));
 
-    /* Remove handle from list */
-    hg_thread_spin_lock(&hg_core_handle->created_list->lock);
-    LIST_REMOVE(hg_core_handle, created);
-    hg_thread_spin_unlock(&hg_core_handle->created_list->lock);
+    /* Set operation type for trigger */
+    hg_core_handle->op_type = HG_CORE_PROCESS;
 
-    hg_core_header_request_finalize(&hg_core_handle->in_header);
-    hg_core_header_response_finalize(&hg_core_handle->out_header);
+    hg_core_stats_add_shared(
+        &HG_CORE_HANDLE_STATS(hg_core_handle)->shared.rpc_req_sent, 1);
 
-    /* Decrement N handles from HG context */
-    hg_atomic_decr32(&HG_CORE_HANDLE_CONTEXT(hg_core_handle)->n_handles);
+    /* Process input */
+    ret = hg_core_process_input(hg_core_handle);
+    if (ret != HG_SUCCESS) {
+        HG_LOG_SUBSYS_ERROR(rpc, "Could not process input");
+        hg_atomic_set32(&hg_core_handle->ret_status, (int32_t) ret);
+    }
 
-    free(hg_core_handle);
+    /* Mark as completed */
+    hg_core_complete_op(hg_core_handle);
+
+    /* Always handle error from callback when forwarding to self, implies
+     * submission is always successful. */
+    return HG_SUCCESS;
 }
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_alloc_na(struct hg_core_private_handle *hg_core_handle,
-    na_class_t *na_class, na_context_t *na_context, unsigned long flags)
+hg_core_forward_na(struct hg_core_private_handle *hg_core_handle)
 {
     hg_return_t ret;
     na_return_t na_ret;
 
-    /* Set NA class / context */
-    hg_core_handle->na_class = na_class;
-    hg_core_handle->na_context = na_context;
+    /* Set operation type for trigger */
+    hg_core_handle->op_type = HG_CORE_FORWARD;
 
-    /* When using multi-recv, only allocate resources per handle for expected
-     * messages. */
-    if (flags & HG_CORE_HANDLE_MULTI_RECV) {
-        if (flags & HG_CORE_HANDLE_MULTI_RECV_COPY) {
-            hg_core_handle->in_buf_storage_size =
-                NA_Msg_get_max_unexpected_size(na_class);
+    /* Let target know that response may be coalesced */
+    if (HG_CORE_HANDLE_CLASS(hg_core_handle)->init_info.coalesce_responses)
+        hg_atomic_or32(&hg_core_handle->flags, HG_CORE_BATCH_OUTPUT);
+    else
+        hg_atomic_and32(&hg_core_handle->flags, ~HG_CORE_BATCH_OUTPUT);
 
-            hg_core_handle->in_buf_storage =
-                NA_Msg_buf_alloc(na_class, hg_core_handle->in_buf_storage_size,
-                    NA_RECV, &hg_core_handle->in_buf_plugin_data);
-            HG_CHECK_SUBSYS_ERROR(rpc, hg_core_handle->in_buf_storage == NULL,
-                error, ret, HG_NOMEM, "Could not allocate buffer for input");
-        }
-        hg_core_handle->core_handle.in_buf = NULL;
-        hg_core_handle->core_handle.in_buf_size = 0;
-    } else {
-        /* Initialize in/out buffers and use unexpected message size */
-        hg_core_handle->in_buf_storage_size =
-            NA_Msg_get_max_unexpected_size(na_class);
+    /* Let target know about the priority of the request */
+    hg_atomic_and32(&hg_core_handle->flags, ~HG_CORE_PRIORITY_MASK);
+    hg_atomic_or32(&hg_core_handle->flags,
+        (int32_t) (hg_core_handle->core_handle.priority + 1)
+            << HG_CORE_PRIORITY_SHIFT);
 
-        hg_core_handle->in_buf_storage =
-            NA_Msg_buf_alloc(na_class, hg_core_handle->in_buf_storage_size,
-                (flags & HG_CORE_HANDLE_LISTEN) ? NA_RECV : NA_SEND,
-                &hg_core_handle->in_buf_plugin_data);
-        HG_CHECK_SUBSYS_ERROR(rpc, hg_core_handle->in_buf_storage == NULL,
-            error, ret, HG_NOMEM, "Could not allocate buffer for input");
+    /* Set header */
+    hg_core_handle->in_header.msg.request.id =
+        hg_core_handle->core_handle.info.id;
+    hg_core_handle->in_header.msg.request.flags =
+        (uint8_t) (hg_atomic_get32(&hg_core_handle->flags) & 0xff);
+    /* Set the cookie as origin context ID, so that when the cookie is
+     * unpacked by the target and assigned to HG info context_id, the NA
+     * layer knows which context ID it needs to send the response to. */
+    hg_core_handle->in_header.msg.request.cookie =
+        hg_core_handle->core_handle.info.context->id;
 
-        hg_core_handle->core_handle.in_buf = hg_core_handle->in_buf_storage;
-        hg_core_handle->core_handle.in_buf_size =
-            hg_core_handle->in_buf_storage_size;
+    /* Encode request header */
+    ret = hg_core_proc_header_request(
+        &hg_core_handle->core_handle, &hg_core_handle->in_header, HG_ENCODE);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not encode header");
 
-        na_ret =
-            NA_Msg_init_unexpected(na_class, hg_core_handle->in_buf_storage,
-                hg_core_handle->in_buf_storage_size);
+    /* Generate tag */
+    hg_core_handle->tag =
+        hg_core_gen_request_tag(HG_CORE_HANDLE_CONTEXT(hg_core_handle));
+
+    /* Pre-post recv (output) if response is expected */
+    if (!(hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_NO_RESPONSE)) {
+        int32_t HG_DEBUG_LOG_USED expected_count;
+
+        na_ret = NA_Msg_recv_expected(hg_core_handle->na_class,
+            hg_core_handle->na_context, hg_core_recv_output_cb, hg_core_handle,
+            hg_core_handle->core_handle.out_buf,
+            hg_core_handle->core_handle.out_buf_size,
+            hg_core_handle->out_buf_plugin_data, hg_core_handle->na_addr,
+            hg_core_handle->core_handle.info.context_id, hg_core_handle->tag,
+            hg_core_handle->na_recv_op_id);
         HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_SUCCESS, error, ret,
-            (hg_return_t) na_ret, "Could not initialize input buffer (%s)",
+            (hg_return_t) na_ret, "Could not post recv for output buffer (%s)",
             NA_Error_to_string(na_ret));
 
-        hg_core_handle->na_recv_op_id = NA_Op_create(na_class, NA_OP_SINGLE);
-        HG_CHECK_SUBSYS_ERROR(rpc, hg_core_handle->na_recv_op_id == NULL, error,
-            ret, HG_NA_ERROR, "Could not create NA op ID");
+        /* Increment number of expected completions */
+        expected_count = hg_atomic_incr32(&hg_core_handle->op_expected_count);
+        HG_LOG_SUBSYS_DEBUG(rpc_ref,
+            "Handle (%p) expected_count incr to %" PRId32,
+            (void *) hg_core_handle, expected_count);
+
+        /* Response may be received in a batch by another handle */
+        if (hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_BATCH_OUTPUT)
+            hg_core_batch_output_add(hg_core_handle);
     }
 
-    hg_core_handle->core_handle.out_buf_size =
-        NA_Msg_get_max_expected_size(na_class);
+    /* Mark handle as posted */
+    hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_POSTED);
 
-    hg_core_handle->core_handle.na_in_header_offset =
-        NA_Msg_get_unexpected_header_size(na_class);
-    hg_core_handle->core_handle.na_out_header_offset =
-        NA_Msg_get_expected_header_size(na_class);
+    /* Coalesce with other requests to the same target if possible */
+    if (HG_CORE_HANDLE_CLASS(hg_core_handle)->init_info.coalesce_requests) {
+        bool queued = false;
 
-    hg_core_handle->core_handle.out_buf =
-        NA_Msg_buf_alloc(na_class, hg_core_handle->core_handle.out_buf_size,
-            (flags & HG_CORE_HANDLE_LISTEN) ? NA_SEND : NA_RECV,
-            &hg_core_handle->out_buf_plugin_data);
-    HG_CHECK_SUBSYS_ERROR(rpc, hg_core_handle->core_handle.out_buf == NULL,
-        error, ret, HG_NOMEM, "Could not allocate buffer for output");
+        ret = hg_core_batch_add(hg_core_handle, false, &queued);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            rpc, error_send, ret, "Could not coalesce request");
+        if (queued)
+            return HG_SUCCESS;
+    }
 
-    na_ret = NA_Msg_init_expected(na_class, hg_core_handle->core_handle.out_buf,
-        hg_core_handle->core_handle.out_buf_size);
-    HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_SUCCESS, error, ret,
-        (hg_return_t) na_ret, "Could not initialize output buffer (%s)",
+    /* Post send (input) */
+    na_ret = NA_Msg_send_unexpected(hg_core_handle->na_class,
+        hg_core_handle->na_context, hg_core_send_input_cb, hg_core_handle,
+        hg_core_handle->core_handle.in_buf, hg_core_handle->in_buf_used,
+        hg_core_handle->in_buf_plugin_data, hg_core_handle->na_addr,
+        hg_core_handle->core_handle.info.context_id, hg_core_handle->tag,
+        hg_core_handle->na_send_op_id);
+    if (na_ret == NA_AGAIN)
+        hg_core_stats_add_shared(
+            &HG_CORE_HANDLE_STATS(hg_core_handle)->shared.retry, 1);
+    HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_SUCCESS, error_send, ret,
+        (hg_return_t) na_ret, "Could not post send for input buffer (%s)",
         NA_Error_to_string(na_ret));
 
-    /* Create NA operation IDs */
-    hg_core_handle->na_send_op_id = NA_Op_create(na_class, NA_OP_SINGLE);
-    HG_CHECK_SUBSYS_ERROR(rpc, hg_core_handle->na_send_op_id == NULL, error,
-        ret, HG_NA_ERROR, "Could not create NA op ID");
+    return HG_SUCCESS;
 
-    hg_core_handle->na_ack_op_id = NA_Op_create(na_class, NA_OP_SINGLE);
-    HG_CHECK_SUBSYS_ERROR(rpc, hg_core_handle->na_ack_op_id == NULL, error, ret,
-        HG_NA_ERROR, "Could not create NA op ID");
+error:
+    return ret;
 
-    hg_atomic_init32(
-        &hg_core_handle->op_expected_count, 1); /* Default (no response) */
-    HG_LOG_SUBSYS_DEBUG(rpc_ref, "Handle (%p) expected_count set to %" PRId32,
-        (void *) hg_core_handle, 1);
-    hg_atomic_init32(&hg_core_handle->op_completed_count, 0);
+error_send:
+    hg_atomic_and32(&hg_core_handle->status, ~HG_CORE_OP_POSTED);
+    hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_ERRORED);
 
-    return HG_SUCCESS;
+    if (hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_NO_RESPONSE) {
+        /* No recv was posted */
+        return ret;
+    } else {
+        int32_t HG_DEBUG_LOG_USED expected_count =
+            hg_atomic_decr32(&hg_core_handle->op_expected_count);
+        HG_LOG_SUBSYS_DEBUG(rpc_ref,
+            "Handle (%p) expected_count decr to %" PRId32,
+            (void *) hg_core_handle, expected_count);
 
-error:
-    hg_core_free_na(hg_core_handle);
+        /* Keep error for return status */
+        hg_atomic_set32(&hg_core_handle->ret_status, (int32_t) ret);
 
-    return ret;
+        /* Mark op as canceled and let it complete */
+        hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_CANCELED);
+
+        /* Cancel the above posted recv op */
+        na_ret = NA_Cancel(hg_core_handle->na_class, hg_core_handle->na_context,
+            hg_core_handle->na_recv_op_id);
+        HG_CHECK_SUBSYS_ERROR_DONE(rpc, na_ret != NA_SUCCESS,
+            "Could not cancel recv op id (%s)", NA_Error_to_string(na_ret));
+
+        /* Return success here but callback will return canceled */
+        return HG_SUCCESS;
+    }
 }
 
 /*---------------------------------------------------------------------------*/
-static void
-hg_core_free_na(struct hg_core_private_handle *hg_core_handle)
+static hg_return_t
+hg_core_batch_list_init(struct hg_core_batch_list *batch_list)
 {
-    /* Destroy NA op IDs */
-    NA_Op_destroy(hg_core_handle->na_class, hg_core_handle->na_send_op_id);
-    hg_core_handle->na_send_op_id = NULL;
-
-    NA_Op_destroy(hg_core_handle->na_class, hg_core_handle->na_recv_op_id);
-    hg_core_handle->na_recv_op_id = NULL;
+    unsigned int i;
+    hg_return_t ret;
+    int rc;
 
-    NA_Op_destroy(hg_core_handle->na_class, hg_core_handle->na_ack_op_id);
-    hg_core_handle->na_ack_op_id = NULL;
+    LIST_INIT(&batch_list->open_list);
+    LIST_INIT(&batch_list->free_list);
+    LIST_INIT(&batch_list->handle_list);
+    for (i = 0; i < HG_CORE_BATCH_OUTPUT_MAP_SIZE; i++)
+        LIST_INIT(&batch_list->output_map[i]);
+    hg_atomic_init32(&batch_list->open_count, 0);
+    hg_atomic_init32(&batch_list->live_count, 0);
+    batch_list->handle_count = 0;
 
-    /* Free buffers */
-    if ((hg_atomic_get32(&hg_core_handle->status) & HG_CORE_OP_MULTI_RECV) &&
-        (hg_core_handle->multi_recv_op != NULL)) {
-        hg_atomic_decr32(&hg_core_handle->multi_recv_op->ref_count);
-        hg_core_handle->multi_recv_op = NULL;
-    }
-    NA_Msg_buf_free(hg_core_handle->na_class, hg_core_handle->in_buf_storage,
-        hg_core_handle->in_buf_plugin_data);
-    hg_core_handle->in_buf_storage = NULL;
-    hg_core_handle->core_handle.in_buf = NULL;
-    hg_core_handle->in_buf_plugin_data = NULL;
+    rc = hg_thread_mutex_init(&batch_list->mutex);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+        "hg_thread_mutex_init() failed");
 
-    NA_Msg_buf_free(hg_core_handle->na_class,
-        hg_core_handle->core_handle.out_buf,
-        hg_core_handle->out_buf_plugin_data);
-    hg_core_handle->core_handle.out_buf = NULL;
-    hg_core_handle->out_buf_plugin_data = NULL;
+    rc = hg_thread_spin_init(&batch_list->output_lock);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error_mutex, ret,
+        HG_NOMEM, "hg_thread_spin_init() failed");
 
-    if (hg_core_handle->ack_buf != NULL) {
-        NA_Msg_buf_free(hg_core_handle->na_class, hg_core_handle->ack_buf,
-            hg_core_handle->ack_buf_plugin_data);
-        hg_core_handle->ack_buf = NULL;
-        hg_core_handle->ack_buf_plugin_data = NULL;
-    }
+    return HG_SUCCESS;
 
-    hg_core_handle->na_class = NULL;
-    hg_core_handle->na_context = NULL;
+error_mutex:
+    (void) hg_thread_mutex_destroy(&batch_list->mutex);
+error:
+    return ret;
 }
 
 /*---------------------------------------------------------------------------*/
 static void
-hg_core_reset(struct hg_core_private_handle *hg_core_handle)
+hg_core_batch_list_finalize(struct hg_core_batch_list *batch_list)
 {
-    struct hg_core_private_class *hg_core_class =
-        HG_CORE_HANDLE_CLASS(hg_core_handle);
-
-    /* TODO context ID must always be reset as it is not passed along with
-     * the addr */
-    hg_core_handle->core_handle.info.context_id = 0;
+    struct hg_core_private_handle *hg_core_handle;
+    struct hg_core_batch *batch;
+
+    /* Batches are flushed before handles are waited on, any batch left open
+     * only refers to handles that have since been freed */
+    while ((batch = LIST_FIRST(&batch_list->open_list)) != NULL) {
+        HG_LOG_SUBSYS_WARNING(ctx,
+            "Dropping batch of %u coalesced message(s) that was never sent",
+            batch->count);
+        LIST_REMOVE(batch, entry);
+        hg_core_batch_free(batch);
+    }
+    hg_atomic_set32(&batch_list->open_count, 0);
 
-    hg_core_handle->request_callback = NULL;
-    hg_core_handle->request_arg = NULL;
-    hg_core_handle->response_callback = NULL;
-    hg_core_handle->response_arg = NULL;
-    hg_core_handle->op_type = HG_CORE_PROCESS; /* Default */
-    hg_core_handle->tag = 0;
-    hg_core_handle->cookie = 0;
-    hg_core_handle->ret = HG_SUCCESS;
-    hg_core_handle->in_buf_used = 0;
-    hg_core_handle->out_buf_used = 0;
-    hg_atomic_init32(
-        &hg_core_handle->op_expected_count, 1); /* Default (no response) */
-    HG_LOG_SUBSYS_DEBUG(rpc_ref, "Handle (%p) expected_count set to %" PRId32,
-        (void *) hg_core_handle, 1);
-    hg_atomic_init32(&hg_core_handle->op_completed_count, 0);
+    while ((batch = LIST_FIRST(&batch_list->free_list)) != NULL) {
+        LIST_REMOVE(batch, entry);
+        hg_core_batch_free(batch);
+    }
 
-    /* Free extra data here if needed */
-    if (hg_core_class->more_data_cb.release)
-        hg_core_class->more_data_cb.release((hg_core_handle_t) hg_core_handle);
+    /* Released handles are already detached from context */
+    while ((hg_core_handle = LIST_FIRST(&batch_list->handle_list)) != NULL) {
+        LIST_REMOVE(hg_core_handle, pending);
+        hg_core_free_na(hg_core_handle);
+        hg_core_header_request_finalize(&hg_core_handle->in_header);
+        hg_core_header_response_finalize(&hg_core_handle->out_header);
+        free(hg_core_handle);
+    }
+    batch_list->handle_count = 0;
 
-    hg_core_header_request_reset(&hg_core_handle->in_header);
-    hg_core_header_response_reset(&hg_core_handle->out_header);
+    (void) hg_thread_spin_destroy(&batch_list->output_lock);
+    (void) hg_thread_mutex_destroy(&batch_list->mutex);
 }
 
 /*---------------------------------------------------------------------------*/
-static hg_return_t
-hg_core_reset_post(struct hg_core_private_handle *hg_core_handle)
+static struct hg_core_private_handle *
+hg_core_batch_handle_pop(
+    struct hg_core_batch_list *batch_list, na_class_t *na_class)
 {
-    struct hg_core_private_context *context =
-        HG_CORE_HANDLE_CONTEXT(hg_core_handle);
-    struct hg_core_handle_pool *hg_core_handle_pool;
-    bool use_multi_recv =
-        hg_atomic_get32(&hg_core_handle->status) & HG_CORE_OP_MULTI_RECV;
-    struct hg_core_multi_recv_op *multi_recv_op = hg_core_handle->multi_recv_op;
-    hg_return_t ret;
+    struct hg_core_private_handle *hg_core_handle;
 
-    /* Reset handle info */
-    if (hg_core_handle->core_handle.info.addr != HG_CORE_ADDR_NULL) {
-        hg_core_addr_free_na((struct hg_core_private_addr *)
-                                 hg_core_handle->core_handle.info.addr);
+    hg_thread_mutex_lock(&batch_list->mutex);
+    LIST_FOREACH (hg_core_handle, &batch_list->handle_list, pending)
+        if (hg_core_handle->na_class == na_class)
+            break;
+    if (hg_core_handle != NULL) {
+        LIST_REMOVE(hg_core_handle, pending);
+        batch_list->handle_count--;
     }
-    hg_core_handle->core_handle.info.id = 0;
+    hg_thread_mutex_unlock(&batch_list->mutex);
 
-    /* Reset the handle */
-    hg_core_reset(hg_core_handle);
+    return hg_core_handle;
+}
 
-    /* Also reset additional handle parameters */
-    hg_atomic_set32(&hg_core_handle->ref_count, 1);
-    hg_core_handle->core_handle.rpc_info = NULL;
-    HG_LOG_SUBSYS_DEBUG(rpc_ref, "Handle (%p) ref_count set to %" PRId32,
-        (void *) hg_core_handle, 1);
+/*---------------------------------------------------------------------------*/
+static bool
+hg_core_batch_handle_push(struct hg_core_private_handle *hg_core_handle)
+{
+    struct hg_core_private_context *context =
+        HG_CORE_HANDLE_CONTEXT(hg_core_handle);
+    struct hg_core_batch_list *batch_list = &context->batch_list;
 
-    /* Reset status */
-    hg_atomic_set32(&hg_core_handle->status, 0);
-    hg_atomic_set32(&hg_core_handle->ret_status, (int32_t) hg_core_handle->ret);
+    if (!hg_core_handle->batch || hg_core_handle->na_class == NULL ||
+        hg_atomic_get32(&context->unposting))
+        return false;
 
-    /* Multi-recv buffers */
-    if (use_multi_recv) {
-        hg_core_handle->core_handle.in_buf = NULL;
-        hg_core_handle->core_handle.in_buf_size = 0;
-        hg_core_handle->multi_recv_op = NULL;
+    hg_thread_mutex_lock(&batch_list->mutex);
+    if (batch_list->handle_count == HG_CORE_BATCH_HANDLE_MAX) {
+        hg_thread_mutex_unlock(&batch_list->mutex);
+        return false;
     }
 
-#ifdef NA_HAS_SM
-    hg_core_handle_pool = (hg_core_handle->na_class ==
-                              context->core_context.core_class->na_sm_class)
-                              ? context->sm_handle_pool
-                              : context->handle_pool;
-#else
-    hg_core_handle_pool = context->handle_pool;
-#endif
+    /* Handle no longer belongs to context until it is re-used */
+    hg_core_detach(hg_core_handle);
 
-    /* Add handle back to pending list */
-    hg_thread_spin_lock(&hg_core_handle_pool->pending_list.lock);
-    LIST_INSERT_HEAD(
-        &hg_core_handle_pool->pending_list.list, hg_core_handle, pending);
-    hg_thread_spin_unlock(&hg_core_handle_pool->pending_list.lock);
+    LIST_INSERT_HEAD(&batch_list->handle_list, hg_core_handle, pending);
+    batch_list->handle_count++;
+    hg_thread_mutex_unlock(&batch_list->mutex);
 
-    if (use_multi_recv) {
-        if (multi_recv_op != NULL &&
-            hg_atomic_decr32(&multi_recv_op->ref_count) == 0 &&
-            hg_atomic_get32(&multi_recv_op->last)) {
-            HG_LOG_SUBSYS_DEBUG(
-                ctx, "Reposting multi-recv buffer %d", multi_recv_op->id);
+    return true;
+}
 
-            /* Repost multi recv */
-            ret = hg_core_post_multi(multi_recv_op,
-                hg_core_handle_pool->na_class, hg_core_handle_pool->na_context);
-            HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret,
-                "Cannot repost multi-recv operation (%d)", multi_recv_op->id);
-            hg_atomic_incr32(&context->multi_recv_op_count);
-        }
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_batch_alloc(struct hg_core_private_context *context,
+    na_class_t *na_class, na_context_t *na_context, bool output,
+    struct hg_core_batch **batch_p)
+{
+    struct hg_core_batch *batch;
+    hg_return_t ret;
+    na_return_t na_ret;
+
+    batch = (struct hg_core_batch *) calloc(1, sizeof(*batch));
+    HG_CHECK_SUBSYS_ERROR(
+        rpc, batch == NULL, error, ret, HG_NOMEM, "Could not allocate batch");
+    batch->context = context;
+    batch->na_class = na_class;
+    batch->na_context = na_context;
+    batch->output = output;
+
+    /* Batches are bounded by the eager message size */
+    if (output) {
+        batch->header_offset = NA_Msg_get_expected_header_size(na_class);
+        batch->buf_size = NA_Msg_get_max_expected_size(na_class);
     } else {
-        /* Repost single recv */
-        ret = hg_core_post(hg_core_handle);
-        HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Cannot post handle");
+        batch->header_offset = NA_Msg_get_unexpected_header_size(na_class);
+        batch->buf_size = NA_Msg_get_max_unexpected_size(na_class);
     }
+    batch->buf = hg_core_msg_buf_alloc(
+        context, na_class, batch->buf_size, NA_SEND, &batch->plugin_data);
+    HG_CHECK_SUBSYS_ERROR(rpc, batch->buf == NULL, error, ret, HG_NOMEM,
+        "Could not allocate buffer for batch");
+
+    na_ret = (output)
+                 ? NA_Msg_init_expected(na_class, batch->buf, batch->buf_size)
+                 : NA_Msg_init_unexpected(
+                       na_class, batch->buf, batch->buf_size);
+    HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_SUCCESS, error, ret,
+        (hg_return_t) na_ret, "Could not initialize batch buffer (%s)",
+        NA_Error_to_string(na_ret));
+
+    batch->op_id = NA_Op_create(na_class, NA_OP_SINGLE);
+    HG_CHECK_SUBSYS_ERROR(rpc, batch->op_id == NULL, error, ret, HG_NA_ERROR,
+        "Could not create NA op ID");
+
+    *batch_p = batch;
 
     return HG_SUCCESS;
 
 error:
+    hg_core_batch_free(batch);
+
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_batch_free(struct hg_core_batch *batch)
+{
+    if (batch == NULL)
+        return;
+
+    NA_Op_destroy(batch->na_class, batch->op_id);
+    hg_core_msg_buf_free(batch->context, batch->na_class, batch->buf,
+        batch->buf_size, batch->plugin_data);
+    free(batch);
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_set_rpc(struct hg_core_private_handle *hg_core_handle,
-    struct hg_core_private_addr *hg_core_addr, na_addr_t *na_addr, hg_id_t id)
+hg_core_batch_add(struct hg_core_private_handle *hg_core_handle, bool output,
+    bool *queued_p)
 {
-    struct hg_core_private_class *hg_core_class =
-        HG_CORE_HANDLE_CLASS(hg_core_handle);
-    struct hg_core_info *info = &hg_core_handle->core_handle.info;
+    struct hg_core_private_context *context =
+        HG_CORE_HANDLE_CONTEXT(hg_core_handle);
+    struct hg_core_batch_list *batch_list = &context->batch_list;
+    struct hg_core_batch *batch, *full_batch = NULL, *send_batch = NULL;
+    struct hg_core_batch *new_batch = NULL;
+    struct hg_core_header_batch_record record;
+    const void *buf;
+    size_t header_offset, buf_size, msg_size, record_size, min_size;
+    bool opened = false;
     hg_return_t ret;
 
-    /* We allow for NULL addr to be passed at creation time, this allows
-     * for pool of handles to be created and later re-used after a call to
-     * HG_Core_reset() */
-    if (hg_core_addr && (info->addr != (hg_core_addr_t) hg_core_addr)) {
-        if (info->addr != HG_CORE_ADDR_NULL)
-            hg_core_addr_free((struct hg_core_private_addr *) info->addr);
-        info->addr = (hg_core_addr_t) hg_core_addr;
-        hg_atomic_incr32(&hg_core_addr->ref_count);
+    if (output) {
+        buf = hg_core_handle->core_handle.out_buf;
+        buf_size = hg_core_handle->core_handle.out_buf_size;
+        header_offset = hg_core_handle->core_handle.na_out_header_offset;
+        msg_size = hg_core_handle->out_buf_used - header_offset;
+        min_size = hg_core_header_response_get_size();
+    } else {
+        buf = hg_core_handle->core_handle.in_buf;
+        buf_size = hg_core_handle->core_handle.in_buf_size;
+        header_offset = hg_core_handle->core_handle.na_in_header_offset;
+        msg_size = hg_core_handle->in_buf_used - header_offset;
+        min_size = hg_core_header_request_get_size();
+    }
+    record_size = hg_core_header_batch_record_get_size() + msg_size;
+    min_size += hg_core_header_batch_record_get_size();
 
-        /* Set NA addr to use */
-        hg_core_handle->na_addr = na_addr;
+    /* Message cannot share a batch with other messages */
+    if (header_offset + hg_core_header_batch_get_size() + record_size >
+        buf_size) {
+        *queued_p = false;
+        return HG_SUCCESS;
+    }
 
-        /* Set forward call depending on address self */
-        if (hg_core_class->init_info.loopback &&
-            hg_core_addr->core_addr.is_self) {
-            hg_atomic_or32(&hg_core_handle->flags, HG_CORE_SELF_FORWARD);
-            hg_core_handle->ops = hg_core_ops_self_g;
+    hg_thread_mutex_lock(&batch_list->mutex);
+
+retry:
+    LIST_FOREACH (batch, &batch_list->open_list, entry)
+        if (batch->output == output &&
+            batch->na_class == hg_core_handle->na_class &&
+            batch->context_id == hg_core_handle->core_handle.info.context_id &&
+            (batch->na_addr == hg_core_handle->na_addr ||
+                NA_Addr_cmp(batch->na_class, batch->na_addr,
+                    hg_core_handle->na_addr)))
+            break;
+
+    /* Send current batch if message does not fit */
+    if (batch != NULL && batch->buf_used + record_size > batch->buf_size) {
+        LIST_REMOVE(batch, entry);
+        hg_atomic_decr32(&batch_list->open_count);
+        full_batch = batch;
+        batch = NULL;
+    }
+
+    if (batch == NULL) {
+        LIST_FOREACH (batch, &batch_list->free_list, entry)
+            if (batch->output == output &&
+                batch->na_class == hg_core_handle->na_class)
+                break;
+
+        if (batch != NULL)
+            LIST_REMOVE(batch, entry);
+        else if (new_batch != NULL) {
+            batch = new_batch;
+            new_batch = NULL;
         } else {
-            hg_atomic_and32(&hg_core_handle->flags, ~HG_CORE_SELF_FORWARD);
-            hg_core_handle->ops = hg_core_ops_na_g;
+            /* Do not allocate while holding the lock, another batch to the
+             * same target may be opened in the meantime */
+            hg_thread_mutex_unlock(&batch_list->mutex);
+            if (full_batch != NULL) {
+                hg_core_batch_send(full_batch);
+                full_batch = NULL;
+            }
+            ret = hg_core_batch_alloc(context, hg_core_handle->na_class,
+                hg_core_handle->na_context, output, &new_batch);
+            HG_CHECK_SUBSYS_HG_ERROR(
+                rpc, error, ret, "Could not allocate batch");
+            hg_thread_mutex_lock(&batch_list->mutex);
+            goto retry;
         }
+        batch->na_addr = hg_core_handle->na_addr;
+        batch->context_id = hg_core_handle->core_handle.info.context_id;
+        batch->buf_used =
+            batch->header_offset + hg_core_header_batch_get_size();
+        batch->count = 0;
+
+        LIST_INSERT_HEAD(&batch_list->open_list, batch, entry);
+        hg_atomic_incr32(&batch_list->open_count);
+        opened = true;
     }
 
-    /* We also allow for NULL RPC id to be passed (same reason as above) */
-    if (id && info->id != id) {
-        struct hg_core_rpc_info *hg_core_rpc_info;
+    /* Append message */
+    record.tag = (uint32_t) hg_core_handle->tag;
+    record.size = (uint32_t) msg_size;
+    (void) hg_core_header_batch_record_proc(HG_ENCODE,
+        (char *) batch->buf + batch->buf_used,
+        batch->buf_size - batch->buf_used, &record);
+    batch->buf_used += hg_core_header_batch_record_get_size();
+    memcpy((char *) batch->buf + batch->buf_used,
+        (const char *) buf + header_offset, msg_size);
+    batch->buf_used += msg_size;
+    batch->handles[batch->count++] = hg_core_handle;
+
+    /* Send batch as soon as no other message can fit */
+    if (batch->count == HG_CORE_BATCH_MAX ||
+        batch->buf_used + min_size > batch->buf_size) {
+        LIST_REMOVE(batch, entry);
+        hg_atomic_decr32(&batch_list->open_count);
+        send_batch = batch;
+    }
 
-        /* Retrieve ID function from function map */
-        hg_core_rpc_info = hg_core_map_lookup(&hg_core_class->rpc_map, &id);
-        HG_CHECK_SUBSYS_ERROR(rpc, hg_core_rpc_info == NULL, error, ret,
-            HG_NOENTRY, "Could not find RPC ID (%" PRIu64 ") in RPC map", id);
+    /* Batch allocated above was not needed */
+    if (new_batch != NULL)
+        LIST_INSERT_HEAD(&batch_list->free_list, new_batch, entry);
 
-        info->id = id;
+    hg_thread_mutex_unlock(&batch_list->mutex);
 
-        /* Cache RPC info */
-        hg_core_handle->core_handle.rpc_info = hg_core_rpc_info;
-        if (hg_core_rpc_info->no_response)
-            hg_atomic_or32(&hg_core_handle->flags, HG_CORE_NO_RESPONSE);
-        else
-            hg_atomic_and32(&hg_core_handle->flags, ~HG_CORE_NO_RESPONSE);
-    }
-    HG_LOG_SUBSYS_DEBUG(rpc, "Handle (%p) flags set to 0x%x",
-        (void *) hg_core_handle, hg_atomic_get32(&hg_core_handle->flags));
+    if (full_batch != NULL)
+        hg_core_batch_send(full_batch);
+    if (send_batch != NULL)
+        hg_core_batch_send(send_batch);
+    else if (opened && context->loopback_notify.event > 0 &&
+             hg_atomic_get32(&context->loopback_notify.must_notify))
+        /* Wake up progress so that the new batch does not wait on it */
+        (void) hg_core_loopback_event_set(context);
+
+    *queued_p = true;
 
     return HG_SUCCESS;
 
@@ -3811,105 +8019,198 @@ error:
 }
 
 /*---------------------------------------------------------------------------*/
-static hg_return_t
-hg_core_post(struct hg_core_private_handle *hg_core_handle)
+static void
+hg_core_batch_flush(struct hg_core_private_context *context)
 {
-    hg_return_t ret;
-    na_return_t na_ret;
-
-    /* Post a new unexpected receive */
-    na_ret = NA_Msg_recv_unexpected(hg_core_handle->na_class,
-        hg_core_handle->na_context, hg_core_recv_input_cb, hg_core_handle,
-        hg_core_handle->core_handle.in_buf,
-        hg_core_handle->core_handle.in_buf_size,
-        hg_core_handle->in_buf_plugin_data, hg_core_handle->na_recv_op_id);
-    HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_SUCCESS, error, ret,
-        (hg_return_t) na_ret,
-        "Could not post unexpected recv for input buffer (%s)",
-        NA_Error_to_string(na_ret));
+    struct hg_core_batch_list *batch_list = &context->batch_list;
+    LIST_HEAD(, hg_core_batch) send_list;
+    struct hg_core_batch *batch;
 
-    HG_LOG_SUBSYS_DEBUG(rpc, "Posted handle (%p)", (void *) hg_core_handle);
+    if (hg_atomic_get32(&batch_list->open_count) == 0)
+        return;
 
-    return HG_SUCCESS;
+    LIST_INIT(&send_list);
+    hg_thread_mutex_lock(&batch_list->mutex);
+    while ((batch = LIST_FIRST(&batch_list->open_list)) != NULL) {
+        LIST_REMOVE(batch, entry);
+        LIST_INSERT_HEAD(&send_list, batch, entry);
+    }
+    hg_atomic_set32(&batch_list->open_count, 0);
+    hg_thread_mutex_unlock(&batch_list->mutex);
 
-error:
-    return ret;
+    while ((batch = LIST_FIRST(&send_list)) != NULL) {
+        LIST_REMOVE(batch, entry);
+        hg_core_batch_send(batch);
+    }
 }
 
 /*---------------------------------------------------------------------------*/
-static hg_return_t
-hg_core_post_multi(struct hg_core_multi_recv_op *multi_recv_op,
-    na_class_t *na_class, na_context_t *na_context)
+static void
+hg_core_batch_send(struct hg_core_batch *batch)
 {
-    hg_return_t ret;
+    struct hg_core_header_batch header = {.hg = HG_CORE_BATCH_IDENTIFIER,
+        .protocol = HG_CORE_PROTOCOL_VERSION,
+        .count = (uint16_t) batch->count};
+    struct hg_core_private_handle *hg_core_handle = batch->handles[0];
     na_return_t na_ret;
 
-    hg_atomic_init32(&multi_recv_op->last, 0);
-    hg_atomic_init32(&multi_recv_op->ref_count, 0);
-    hg_atomic_init32(&multi_recv_op->op_count, 0);
+    HG_LOG_SUBSYS_DEBUG(rpc, "Sending batch of %u %s(s) (%zu bytes)",
+        batch->count, (batch->output) ? "response" : "request",
+        batch->buf_used);
+
+    if (batch->count == 1) {
+        struct hg_core_batch_list *batch_list = &batch->context->batch_list;
+        bool output = batch->output;
+
+        /* Single messages are sent as is */
+        hg_thread_mutex_lock(&batch_list->mutex);
+        LIST_INSERT_HEAD(&batch_list->free_list, batch, entry);
+        hg_thread_mutex_unlock(&batch_list->mutex);
+
+        if (output)
+            na_ret = NA_Msg_send_expected(hg_core_handle->na_class,
+                hg_core_handle->na_context, hg_core_send_output_cb,
+                hg_core_handle, hg_core_handle->core_handle.out_buf,
+                hg_core_handle->out_buf_used,
+                hg_core_handle->out_buf_plugin_data, hg_core_handle->na_addr,
+                hg_core_handle->core_handle.info.context_id,
+                hg_core_handle->tag, hg_core_handle->na_send_op_id);
+        else
+            na_ret = NA_Msg_send_unexpected(hg_core_handle->na_class,
+                hg_core_handle->na_context, hg_core_send_input_cb,
+                hg_core_handle, hg_core_handle->core_handle.in_buf,
+                hg_core_handle->in_buf_used,
+                hg_core_handle->in_buf_plugin_data, hg_core_handle->na_addr,
+                hg_core_handle->core_handle.info.context_id,
+                hg_core_handle->tag, hg_core_handle->na_send_op_id);
+        if (na_ret != NA_SUCCESS) {
+            struct na_cb_info callback_info = {.arg = hg_core_handle,
+                .type = (output) ? NA_CB_SEND_EXPECTED : NA_CB_SEND_UNEXPECTED,
+                .ret = na_ret};
+
+            HG_LOG_SUBSYS_ERROR(rpc,
+                "Could not post send for %s buffer (%s)",
+                (output) ? "output" : "input", NA_Error_to_string(na_ret));
+            if (na_ret == NA_AGAIN)
+                hg_core_stats_add_shared(
+                    &HG_CORE_HANDLE_STATS(hg_core_handle)->shared.retry, 1);
+
+            if (output)
+                hg_core_send_output_cb(&callback_info);
+            else
+                hg_core_send_input_cb(&callback_info);
+        }
+        return;
+    }
 
-    /* Post a new unexpected receive */
-    na_ret = NA_Msg_multi_recv_unexpected(na_class, na_context,
-        hg_core_multi_recv_input_cb, multi_recv_op, multi_recv_op->buf,
-        multi_recv_op->buf_size, multi_recv_op->plugin_data,
-        multi_recv_op->op_id);
-    HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_SUCCESS, error, ret,
-        (hg_return_t) na_ret, "NA_Msg_multi_recv_unexpected() failed (%s)",
-        NA_Error_to_string(na_ret));
+    (void) hg_core_header_batch_proc(HG_ENCODE,
+        (char *) batch->buf + batch->header_offset,
+        hg_core_header_batch_get_size(), &header);
 
-    HG_LOG_SUBSYS_DEBUG(rpc, "Posted multi-recv buffer (%p, %zu)",
-        multi_recv_op->buf, multi_recv_op->buf_size);
+    if (batch->output)
+        na_ret = NA_Msg_send_expected(batch->na_class, batch->na_context,
+            hg_core_batch_send_cb, batch, batch->buf, batch->buf_used,
+            batch->plugin_data, batch->na_addr, batch->context_id,
+            hg_core_handle->tag, batch->op_id);
+    else
+        na_ret = NA_Msg_send_unexpected(batch->na_class, batch->na_context,
+            hg_core_batch_send_cb, batch, batch->buf, batch->buf_used,
+            batch->plugin_data, batch->na_addr, batch->context_id,
+            hg_core_handle->tag, batch->op_id);
+    if (na_ret != NA_SUCCESS) {
+        HG_LOG_SUBSYS_ERROR(rpc, "Could not post send for batch (%s)",
+            NA_Error_to_string(na_ret));
+        if (na_ret == NA_AGAIN)
+            hg_core_stats_add_shared(
+                &batch->context->stats->shared.retry, 1);
+        hg_core_batch_complete(batch, na_ret);
+    }
+}
 
-    return HG_SUCCESS;
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_batch_send_cb(const struct na_cb_info *callback_info)
+{
+    hg_core_batch_complete(
+        (struct hg_core_batch *) callback_info->arg, callback_info->ret);
+}
 
-error:
-    return ret;
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_batch_complete(struct hg_core_batch *batch, na_return_t na_ret)
+{
+    struct hg_core_batch_list *batch_list = &batch->context->batch_list;
+    struct hg_core_private_handle *handles[HG_CORE_BATCH_MAX];
+    struct na_cb_info callback_info = {.arg = NULL,
+        .type = (batch->output) ? NA_CB_SEND_EXPECTED : NA_CB_SEND_UNEXPECTED,
+        .ret = na_ret};
+    unsigned int count = batch->count, i;
+    bool output = batch->output;
+
+    /* Release batch first as context may be destroyed once handles are */
+    memcpy(handles, batch->handles, count * sizeof(*handles));
+    hg_thread_mutex_lock(&batch_list->mutex);
+    LIST_INSERT_HEAD(&batch_list->free_list, batch, entry);
+    hg_thread_mutex_unlock(&batch_list->mutex);
+
+    for (i = 0; i < count; i++) {
+        callback_info.arg = handles[i];
+        if (output)
+            hg_core_send_output_cb(&callback_info);
+        else
+            hg_core_send_input_cb(&callback_info);
+    }
 }
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_release_input(struct hg_core_private_handle *hg_core_handle)
+hg_core_batch_unpack(struct hg_core_private_handle *hg_core_handle)
 {
-    struct hg_core_private_context *context =
-        HG_CORE_HANDLE_CONTEXT(hg_core_handle);
-    struct hg_core_handle_pool *hg_core_handle_pool;
-    struct hg_core_multi_recv_op *multi_recv_op = hg_core_handle->multi_recv_op;
+    size_t header_offset = hg_core_handle->core_handle.na_in_header_offset;
+    char *buf = (char *) hg_core_handle->core_handle.in_buf + header_offset;
+    size_t buf_size, offset;
+    struct hg_core_header_batch header;
+    struct hg_core_header_batch_record record = {.tag = 0, .size = 0};
+    unsigned int i;
     hg_return_t ret;
 
-    if (!(hg_atomic_get32(&hg_core_handle->status) & HG_CORE_OP_MULTI_RECV))
+    if (hg_core_handle->in_buf_used < header_offset ||
+        !hg_core_header_batch_check(
+            buf, hg_core_handle->in_buf_used - header_offset))
         return HG_SUCCESS;
+    buf_size = hg_core_handle->in_buf_used - header_offset;
 
-#ifdef NA_HAS_SM
-    hg_core_handle_pool = (hg_core_handle->na_class ==
-                              context->core_context.core_class->na_sm_class)
-                              ? context->sm_handle_pool
-                              : context->handle_pool;
-#else
-    hg_core_handle_pool = context->handle_pool;
-#endif
+    ret = hg_core_header_batch_proc(HG_DECODE, buf, buf_size, &header);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not decode batch header");
+    HG_CHECK_SUBSYS_ERROR(rpc, header.count == 0, error, ret,
+        HG_PROTOCOL_ERROR, "Empty batch");
 
-    /* Multi-recv buffers */
-    if (multi_recv_op != NULL) {
-        if (!hg_core_handle->multi_recv_copy) {
-            hg_core_handle->core_handle.in_buf = NULL;
-            hg_core_handle->core_handle.in_buf_size = 0;
-        }
-        hg_core_handle->multi_recv_op = NULL;
+    HG_LOG_SUBSYS_DEBUG(rpc, "Received batch of %" PRIu16 " request(s)",
+        header.count);
 
-        if (hg_atomic_decr32(&multi_recv_op->ref_count) == 0 &&
-            hg_atomic_get32(&multi_recv_op->last)) {
-            HG_LOG_SUBSYS_DEBUG(
-                ctx, "Reposting multi-recv buffer %d", multi_recv_op->id);
+    for (i = 0, offset = hg_core_header_batch_get_size();; i++) {
+        ret = hg_core_header_batch_record_proc(
+            HG_DECODE, buf + offset, buf_size - offset, &record);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            rpc, error, ret, "Could not decode batch record");
+        offset += hg_core_header_batch_record_get_size();
+        HG_CHECK_SUBSYS_ERROR(rpc, record.size > buf_size - offset, error, ret,
+            HG_PROTOCOL_ERROR, "Batch record size (%" PRIu32 ") is too large",
+            record.size);
+
+        /* Keep last request, which completes after the others */
+        if (i == (unsigned int) header.count - 1)
+            break;
 
-            /* Repost multi recv */
-            ret = hg_core_post_multi(multi_recv_op,
-                hg_core_handle_pool->na_class, hg_core_handle_pool->na_context);
-            HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret,
-                "Cannot repost multi-recv operation (%d)", multi_recv_op->id);
-            hg_atomic_incr32(&context->multi_recv_op_count);
-        }
+        hg_core_batch_process(
+            hg_core_handle, (na_tag_t) record.tag, buf + offset, record.size);
+        offset += record.size;
     }
 
+    memmove(buf, buf + offset, record.size);
+    hg_core_handle->tag = (na_tag_t) record.tag;
+    hg_core_handle->in_buf_used = header_offset + record.size;
+
     return HG_SUCCESS;
 
 error:
@@ -3917,218 +8218,260 @@ error:
 }
 
 /*---------------------------------------------------------------------------*/
-static hg_return_t
-hg_core_forward(struct hg_core_private_handle *hg_core_handle,
-    hg_core_cb_t callback, void *arg, uint8_t flags, hg_size_t payload_size)
+static void
+hg_core_batch_process(struct hg_core_private_handle *hg_core_handle,
+    na_tag_t tag, const void *msg, size_t msg_size)
 {
-    int32_t HG_DEBUG_LOG_USED ref_count;
-    int32_t status;
-    hg_size_t header_size;
-    hg_return_t ret = HG_SUCCESS;
-
-    status = hg_atomic_get32(&hg_core_handle->status);
-    HG_CHECK_SUBSYS_ERROR(rpc,
-        !(status & HG_CORE_OP_COMPLETED) || (status & HG_CORE_OP_QUEUED), done,
-        ret, HG_BUSY, "Attempting to use handle that was not completed");
-
-    /* Increment ref_count on handle to allow for destroy to be
-     * pre-emptively called */
-    ref_count = hg_atomic_incr32(&hg_core_handle->ref_count);
-    HG_LOG_SUBSYS_DEBUG(rpc_ref, "Handle (%p) ref_count incr to %" PRId32,
-        (void *) hg_core_handle, ref_count);
-
-    /* Reset op counts */
-    hg_atomic_set32(
-        &hg_core_handle->op_expected_count, 1); /* Default (no response) */
-    HG_LOG_SUBSYS_DEBUG(rpc_ref, "Handle (%p) expected_count set to %" PRId32,
-        (void *) hg_core_handle, 1);
-    hg_atomic_set32(&hg_core_handle->op_completed_count, 0);
-
-    /* Reset handle ret */
-    hg_core_handle->ret = HG_SUCCESS;
-
-    /* Reset status */
-    hg_atomic_set32(&hg_core_handle->status, 0);
-    hg_atomic_set32(&hg_core_handle->ret_status, (int32_t) hg_core_handle->ret);
+    struct hg_core_private_context *context =
+        HG_CORE_HANDLE_CONTEXT(hg_core_handle);
+    struct hg_core_private_handle *batch_handle = NULL;
+    struct hg_core_private_addr *hg_core_addr = NULL;
+    size_t header_offset = hg_core_handle->core_handle.na_in_header_offset;
+    uint32_t request_max =
+        HG_CORE_CONTEXT_CLASS(context)->init_info.request_max;
+    int32_t live_count;
+    na_addr_t *na_addr = NULL;
+    hg_return_t ret;
+    na_return_t na_ret;
 
-    /* Set header size */
-    header_size = hg_core_header_request_get_size() +
-                  hg_core_handle->core_handle.na_in_header_offset;
+    /* Requests are copied to a separate handle that is freed once done */
+    ret = hg_core_create(context, hg_core_handle->na_class,
+        hg_core_handle->na_context,
+        HG_CORE_HANDLE_LISTEN | HG_CORE_HANDLE_MULTI_RECV |
+            HG_CORE_HANDLE_MULTI_RECV_COPY | HG_CORE_HANDLE_BATCH,
+        &batch_handle);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        rpc, error, ret, "Could not create HG core handle");
+    batch_handle->batch = true;
+    hg_atomic_set32(&batch_handle->status, 0);
+
+    /* Like pooled handles, no more than request_max handles of coalesced
+     * requests are in use, requests beyond that are rejected */
+    live_count = hg_atomic_incr32(&context->batch_list.live_count);
+    if (request_max > 0 && live_count > (int32_t) request_max) {
+        hg_core_stats_add(&context->stats->progress.rpc_req_busy, 1);
+        batch_handle->busy = true;
+    }
+    hg_atomic_set32(&batch_handle->ret_status, (int32_t) HG_SUCCESS);
 
-    /* Set the actual size of the msg that needs to be transmitted */
-    hg_core_handle->in_buf_used = header_size + payload_size;
+    batch_handle->core_handle.in_buf = batch_handle->in_buf_storage;
+    batch_handle->core_handle.in_buf_size = batch_handle->in_buf_storage_size;
     HG_CHECK_SUBSYS_ERROR(rpc,
-        hg_core_handle->in_buf_used > hg_core_handle->core_handle.in_buf_size,
-        error, ret, HG_MSGSIZE, "Exceeding input buffer size");
+        header_offset + msg_size > batch_handle->core_handle.in_buf_size,
+        error, ret, HG_OVERFLOW, "Coalesced request size (%zu) is too large",
+        msg_size);
+    memcpy((char *) batch_handle->core_handle.in_buf + header_offset, msg,
+        msg_size);
+    batch_handle->in_buf_used = header_offset + msg_size;
+    batch_handle->tag = tag;
+
+    /* Source address */
+    ret = hg_core_addr_create(HG_CORE_CONTEXT_CLASS(context), &hg_core_addr);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not create HG addr");
+    batch_handle->core_handle.info.addr = (hg_core_addr_t) hg_core_addr;
 
-    /* Parse flags */
-    if (flags & HG_CORE_MORE_DATA)
-        hg_atomic_or32(&hg_core_handle->flags, HG_CORE_MORE_DATA);
+    na_ret = NA_Addr_dup(
+        hg_core_handle->na_class, hg_core_handle->na_addr, &na_addr);
+    HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_SUCCESS, error, ret,
+        (hg_return_t) na_ret, "Could not duplicate source address (%s)",
+        NA_Error_to_string(na_ret));
+    batch_handle->na_addr = na_addr;
+#ifdef NA_HAS_SM
+    if (batch_handle->na_class ==
+        batch_handle->core_handle.info.core_class->na_sm_class)
+        hg_core_addr->core_addr.na_sm_addr = na_addr;
     else
-        hg_atomic_and32(&hg_core_handle->flags, ~HG_CORE_MORE_DATA);
-
-    /* Set callback, keep request and response callbacks separate so that
-     * they do not get overwritten when forwarding to ourself */
-    hg_core_handle->request_callback = callback;
-    hg_core_handle->request_arg = arg;
-
-#if defined(HG_HAS_DEBUG) && !defined(_WIN32)
-    /* Increment counter */
-    hg_atomic_incr64(
-        HG_CORE_HANDLE_CLASS(hg_core_handle)->counters.rpc_req_sent_count);
 #endif
+        hg_core_addr->core_addr.na_addr = na_addr;
 
-    /* If addr is self, forward locally, otherwise send the encoded buffer
-     * through NA and pre-post response */
-    ret = hg_core_handle->ops.forward(hg_core_handle);
-    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not forward buffer");
+    ret = hg_core_process_input(batch_handle);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not process input");
 
-done:
-    return ret;
+    hg_core_complete_op(batch_handle);
+
+    return;
 
 error:
-    /* Handle is no longer in use */
-    hg_atomic_set32(&hg_core_handle->status, HG_CORE_OP_COMPLETED);
+    if (batch_handle == NULL)
+        return;
 
-    /* Rollback ref_count taken above */
-    ref_count = hg_atomic_decr32(&hg_core_handle->ref_count);
-    HG_LOG_SUBSYS_DEBUG(rpc_ref, "Handle (%p) ref_count decr to %" PRId32,
-        (void *) hg_core_handle, ref_count);
+    /* Mark handle as errored */
+    hg_atomic_or32(&batch_handle->status, HG_CORE_OP_ERRORED);
+    hg_atomic_cas32(
+        &batch_handle->ret_status, (int32_t) HG_SUCCESS, (int32_t) ret);
 
-    return ret;
+    /* Complete operation */
+    hg_core_complete_op(batch_handle);
 }
 
 /*---------------------------------------------------------------------------*/
-static hg_return_t
-hg_core_forward_self(struct hg_core_private_handle *hg_core_handle)
+static void
+hg_core_batch_output_add(struct hg_core_private_handle *hg_core_handle)
 {
-    hg_return_t ret;
+    struct hg_core_batch_list *batch_list =
+        &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->batch_list;
 
-    /* Save ref_count, when sending to self and no response is being sent,
-     * we can only use that refcount to determine that the RPC callback has
-     * been fully executed. */
-    if (hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_NO_RESPONSE)
-        hg_atomic_set32(&hg_core_handle->no_response_done,
-            hg_atomic_get32(&hg_core_handle->ref_count));
+    hg_thread_spin_lock(&batch_list->output_lock);
+    LIST_INSERT_HEAD(&batch_list->output_map[hg_core_handle->tag &
+                                             (HG_CORE_BATCH_OUTPUT_MAP_SIZE -
+                                                 1)],
+        hg_core_handle, output);
+    hg_core_handle->batch_output = true;
+    hg_thread_spin_unlock(&batch_list->output_lock);
+}
 
-    /* Set operation type for trigger */
-    hg_core_handle->op_type = HG_CORE_PROCESS;
+/*---------------------------------------------------------------------------*/
+static bool
+hg_core_batch_output_remove(struct hg_core_private_handle *hg_core_handle)
+{
+    struct hg_core_batch_list *batch_list =
+        &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->batch_list;
 
-    /* Process input */
-    ret = hg_core_process_input(hg_core_handle);
-    if (ret != HG_SUCCESS) {
-        HG_LOG_SUBSYS_ERROR(rpc, "Could not process input");
-        hg_atomic_set32(&hg_core_handle->ret_status, (int32_t) ret);
+    hg_thread_spin_lock(&batch_list->output_lock);
+    if (hg_core_handle->batch_output) {
+        LIST_REMOVE(hg_core_handle, output);
+        hg_core_handle->batch_output = false;
     }
+    hg_thread_spin_unlock(&batch_list->output_lock);
 
-    /* Mark as completed */
-    hg_core_complete_op(hg_core_handle);
-
-    /* Always handle error from callback when forwarding to self, implies
-     * submission is always successful. */
-    return HG_SUCCESS;
+    /* Status bit is set while holding the lock when output is dispatched */
+    return hg_atomic_get32(&hg_core_handle->status) & HG_CORE_OP_BATCHED;
 }
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_forward_na(struct hg_core_private_handle *hg_core_handle)
-{
+hg_core_batch_output_unpack(
+    struct hg_core_private_handle *hg_core_handle, size_t buf_size)
+{
+    size_t header_offset = hg_core_handle->core_handle.na_out_header_offset;
+    char *buf = (char *) hg_core_handle->core_handle.out_buf + header_offset;
+    size_t offset, own_offset = 0, own_size = 0;
+    struct hg_core_header_batch header;
+    struct hg_core_header_batch_record record;
+    unsigned int i;
+    bool found = false;
     hg_return_t ret;
-    na_return_t na_ret;
 
-    /* Set operation type for trigger */
-    hg_core_handle->op_type = HG_CORE_FORWARD;
+    if (buf_size < header_offset ||
+        !hg_core_header_batch_check(buf, buf_size - header_offset))
+        return HG_SUCCESS;
+    buf_size -= header_offset;
 
-    /* Set header */
-    hg_core_handle->in_header.msg.request.id =
-        hg_core_handle->core_handle.info.id;
-    hg_core_handle->in_header.msg.request.flags =
-        (uint8_t) (hg_atomic_get32(&hg_core_handle->flags) & 0xff);
-    /* Set the cookie as origin context ID, so that when the cookie is
-     * unpacked by the target and assigned to HG info context_id, the NA
-     * layer knows which context ID it needs to send the response to. */
-    hg_core_handle->in_header.msg.request.cookie =
-        hg_core_handle->core_handle.info.context->id;
+    ret = hg_core_header_batch_proc(HG_DECODE, buf, buf_size, &header);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not decode batch header");
 
-    /* Encode request header */
-    ret = hg_core_proc_header_request(
-        &hg_core_handle->core_handle, &hg_core_handle->in_header, HG_ENCODE);
-    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not encode header");
+    HG_LOG_SUBSYS_DEBUG(rpc, "Received batch of %" PRIu16 " response(s)",
+        header.count);
 
-    /* Generate tag */
-    hg_core_handle->tag =
-        hg_core_gen_request_tag(HG_CORE_HANDLE_CLASS(hg_core_handle));
+    for (i = 0, offset = hg_core_header_batch_get_size(); i < header.count;
+         i++) {
+        ret = hg_core_header_batch_record_proc(
+            HG_DECODE, buf + offset, buf_size - offset, &record);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            rpc, error, ret, "Could not decode batch record");
+        offset += hg_core_header_batch_record_get_size();
+        HG_CHECK_SUBSYS_ERROR(rpc, record.size > buf_size - offset, error, ret,
+            HG_PROTOCOL_ERROR, "Batch record size (%" PRIu32 ") is too large",
+            record.size);
+
+        if (!found && (na_tag_t) record.tag == hg_core_handle->tag) {
+            own_offset = offset;
+            own_size = record.size;
+            found = true;
+        } else
+            hg_core_batch_output_process(HG_CORE_HANDLE_CONTEXT(hg_core_handle),
+                hg_core_handle->na_class, hg_core_handle->na_addr,
+                (na_tag_t) record.tag, buf + offset, record.size);
+        offset += record.size;
+    }
+    HG_CHECK_SUBSYS_ERROR(rpc, !found, error, ret, HG_PROTOCOL_ERROR,
+        "No response for handle (%p) in batch", (void *) hg_core_handle);
 
-    /* Pre-post recv (output) if response is expected */
-    if (!(hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_NO_RESPONSE)) {
-        int32_t HG_DEBUG_LOG_USED expected_count;
+    memmove(buf, buf + own_offset, own_size);
 
-        na_ret = NA_Msg_recv_expected(hg_core_handle->na_class,
-            hg_core_handle->na_context, hg_core_recv_output_cb, hg_core_handle,
-            hg_core_handle->core_handle.out_buf,
-            hg_core_handle->core_handle.out_buf_size,
-            hg_core_handle->out_buf_plugin_data, hg_core_handle->na_addr,
-            hg_core_handle->core_handle.info.context_id, hg_core_handle->tag,
-            hg_core_handle->na_recv_op_id);
-        HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_SUCCESS, error, ret,
-            (hg_return_t) na_ret, "Could not post recv for output buffer (%s)",
-            NA_Error_to_string(na_ret));
+    return HG_SUCCESS;
 
-        /* Increment number of expected completions */
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_batch_output_process(struct hg_core_private_context *context,
+    na_class_t *na_class, na_addr_t *na_addr, na_tag_t tag, const void *msg,
+    size_t msg_size)
+{
+    struct hg_core_batch_list *batch_list = &context->batch_list;
+    struct hg_core_private_handle *hg_core_handle;
+    int32_t HG_DEBUG_LOG_USED expected_count;
+    hg_return_t ret;
+    na_return_t na_ret;
+
+    hg_thread_spin_lock(&batch_list->output_lock);
+    LIST_FOREACH (hg_core_handle,
+        &batch_list->output_map[tag & (HG_CORE_BATCH_OUTPUT_MAP_SIZE - 1)],
+        output)
+        /* Tags are only unique per target */
+        if (hg_core_handle->tag == tag &&
+            hg_core_handle->na_class == na_class &&
+            (hg_core_handle->na_addr == na_addr ||
+                NA_Addr_cmp(na_class, hg_core_handle->na_addr, na_addr)))
+            break;
+    if (hg_core_handle != NULL) {
+        LIST_REMOVE(hg_core_handle, output);
+        hg_core_handle->batch_output = false;
+        hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_BATCHED);
+
+        /* Handle cannot complete until output is processed */
         expected_count = hg_atomic_incr32(&hg_core_handle->op_expected_count);
         HG_LOG_SUBSYS_DEBUG(rpc_ref,
             "Handle (%p) expected_count incr to %" PRId32,
             (void *) hg_core_handle, expected_count);
     }
+    hg_thread_spin_unlock(&batch_list->output_lock);
 
-    /* Mark handle as posted */
-    hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_POSTED);
-
-    /* Post send (input) */
-    na_ret = NA_Msg_send_unexpected(hg_core_handle->na_class,
-        hg_core_handle->na_context, hg_core_send_input_cb, hg_core_handle,
-        hg_core_handle->core_handle.in_buf, hg_core_handle->in_buf_used,
-        hg_core_handle->in_buf_plugin_data, hg_core_handle->na_addr,
-        hg_core_handle->core_handle.info.context_id, hg_core_handle->tag,
-        hg_core_handle->na_send_op_id);
-    HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_SUCCESS, error_send, ret,
-        (hg_return_t) na_ret, "Could not post send for input buffer (%s)",
-        NA_Error_to_string(na_ret));
+    /* Handle may have been canceled */
+    if (hg_core_handle == NULL) {
+        HG_LOG_SUBSYS_WARNING(
+            rpc, "No handle waiting for response with tag %u", tag);
+        return;
+    }
 
-    return HG_SUCCESS;
+    HG_LOG_SUBSYS_DEBUG(rpc, "Processing output for handle %p, tag=%u",
+        (void *) hg_core_handle, tag);
 
-error:
-    return ret;
+    /* Release posted recv */
+    na_ret = NA_Cancel(hg_core_handle->na_class, hg_core_handle->na_context,
+        hg_core_handle->na_recv_op_id);
+    HG_CHECK_SUBSYS_ERROR_DONE(rpc, na_ret != NA_SUCCESS,
+        "Could not cancel recv op id (%s)", NA_Error_to_string(na_ret));
 
-error_send:
-    hg_atomic_and32(&hg_core_handle->status, ~HG_CORE_OP_POSTED);
-    hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_ERRORED);
+    HG_CHECK_SUBSYS_ERROR(rpc,
+        hg_core_handle->core_handle.na_out_header_offset + msg_size >
+            hg_core_handle->core_handle.out_buf_size,
+        error, ret, HG_OVERFLOW, "Coalesced response size (%zu) is too large",
+        msg_size);
+    memcpy((char *) hg_core_handle->core_handle.out_buf +
+               hg_core_handle->core_handle.na_out_header_offset,
+        msg, msg_size);
+    hg_core_stats_add(
+        &context->stats->progress.msg_bytes_recv, (int64_t) msg_size);
 
-    if (hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_NO_RESPONSE) {
-        /* No recv was posted */
-        return ret;
-    } else {
-        int32_t HG_DEBUG_LOG_USED expected_count =
-            hg_atomic_decr32(&hg_core_handle->op_expected_count);
-        HG_LOG_SUBSYS_DEBUG(rpc_ref,
-            "Handle (%p) expected_count decr to %" PRId32,
-            (void *) hg_core_handle, expected_count);
+    ret = hg_core_process_output(hg_core_handle, hg_core_send_ack);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not process output");
 
-        /* Keep error for return status */
-        hg_atomic_set32(&hg_core_handle->ret_status, (int32_t) ret);
+    hg_core_complete_op(hg_core_handle);
 
-        /* Mark op as canceled and let it complete */
-        hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_CANCELED);
+    return;
 
-        /* Cancel the above posted recv op */
-        na_ret = NA_Cancel(hg_core_handle->na_class, hg_core_handle->na_context,
-            hg_core_handle->na_recv_op_id);
-        HG_CHECK_SUBSYS_ERROR_DONE(rpc, na_ret != NA_SUCCESS,
-            "Could not cancel recv op id (%s)", NA_Error_to_string(na_ret));
+error:
+    /* Mark handle as errored */
+    hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_ERRORED);
+    hg_atomic_cas32(
+        &hg_core_handle->ret_status, (int32_t) HG_SUCCESS, (int32_t) ret);
 
-        /* Return success here but callback will return canceled */
-        return HG_SUCCESS;
-    }
+    /* Complete operation */
+    hg_core_complete_op(hg_core_handle);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -4146,6 +8489,8 @@ hg_core_respond(struct hg_core_private_handle *hg_core_handle,
         hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_NO_RESPONSE, done,
         ret, HG_OPNOTSUPPORTED, "Sending response was disabled on that RPC");
 
+    hg_core_trace_event(hg_core_handle, HG_CORE_TRACE_RESPOND, 0);
+
     /* Reset handle ret */
     hg_core_handle->ret = HG_SUCCESS;
 
@@ -4210,6 +8555,9 @@ hg_core_respond_self(
     /* Set operation type for trigger */
     hg_core_handle->op_type = HG_CORE_RESPOND;
 
+    hg_core_stats_add_shared(
+        &HG_CORE_HANDLE_STATS(hg_core_handle)->shared.rpc_resp_sent, 1);
+
     /* Pass return code */
     hg_atomic_set32(&hg_core_handle->ret_status, (int32_t) ret_code);
 
@@ -4319,6 +8667,20 @@ hg_core_respond_na(
     /* Mark handle as posted */
     hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_POSTED);
 
+    /* Coalesce with other responses to the same origin if it accepts them */
+    if (HG_CORE_HANDLE_CLASS(hg_core_handle)->init_info.coalesce_responses &&
+        (hg_atomic_get32(&hg_core_handle->flags) &
+            (HG_CORE_BATCH_OUTPUT | HG_CORE_MORE_DATA)) ==
+            HG_CORE_BATCH_OUTPUT) {
+        bool queued = false;
+
+        ret = hg_core_batch_add(hg_core_handle, true, &queued);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            rpc, error, ret, "Could not coalesce response");
+        if (queued)
+            return HG_SUCCESS;
+    }
+
     /* Post expected send (output) */
     na_ret = NA_Msg_send_expected(hg_core_handle->na_class,
         hg_core_handle->na_context, hg_core_send_output_cb, hg_core_handle,
@@ -4327,6 +8689,9 @@ hg_core_respond_na(
         hg_core_handle->core_handle.info.context_id, hg_core_handle->tag,
         hg_core_handle->na_send_op_id);
     /* Expected sends should always succeed after retry */
+    if (na_ret == NA_AGAIN)
+        hg_core_stats_add_shared(
+            &HG_CORE_HANDLE_STATS(hg_core_handle)->shared.retry, 1);
     HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_SUCCESS, error, ret,
         (hg_return_t) na_ret, "Could not post send for output buffer (%s)",
         NA_Error_to_string(na_ret));
@@ -4368,14 +8733,20 @@ error:
 }
 
 /*---------------------------------------------------------------------------*/
-static HG_INLINE void
+static void
 hg_core_send_input_cb(const struct na_cb_info *callback_info)
 {
     struct hg_core_private_handle *hg_core_handle =
         (struct hg_core_private_handle *) callback_info->arg;
 
     if (callback_info->ret == NA_SUCCESS) {
-        /* Nothing */
+        struct hg_core_stats_counters *counters =
+            &HG_CORE_HANDLE_STATS(hg_core_handle)->progress;
+
+        hg_core_stats_add(&counters->rpc_req_sent, 1);
+        hg_core_stats_add(
+            &counters->msg_bytes_sent, (int64_t) hg_core_handle->in_buf_used);
+        hg_core_trace_event(hg_core_handle, HG_CORE_TRACE_SEND_INPUT, 0);
     } else if (callback_info->ret == NA_CANCELED) {
         HG_CHECK_SUBSYS_WARNING(rpc,
             hg_atomic_get32(&hg_core_handle->status) & HG_CORE_OP_COMPLETED,
@@ -4436,14 +8807,14 @@ hg_core_recv_input_cb(const struct na_cb_info *callback_info)
 #else
     hg_core_handle_pool = context->handle_pool;
 #endif
-    hg_thread_spin_lock(&hg_core_handle_pool->pending_list.lock);
-    LIST_REMOVE(hg_core_handle, pending);
-    hg_thread_spin_unlock(&hg_core_handle_pool->pending_list.lock);
+    hg_core_handle_pool_remove(hg_core_handle_pool, hg_core_handle);
 
     if (callback_info->ret == NA_SUCCESS) {
-        /* Extend pool if all handles are being utilized */
+        /* Extend pool if all handles are being utilized (up to request_max
+         * handles, NA keeps further requests queued) */
         if (hg_core_handle_pool->incr_count > 0 &&
             !hg_atomic_get32(&context->unposting) &&
+            hg_core_handle_pool_extendable(hg_core_handle_pool) &&
             hg_core_handle_pool_empty(hg_core_handle_pool)) {
             HG_LOG_SUBSYS_WARNING(perf,
                 "Pre-posted handles have all been consumed / are being "
@@ -4477,6 +8848,11 @@ hg_core_recv_input_cb(const struct na_cb_info *callback_info)
             "Actual transfer size (%zu) is too large for unexpected recv",
             hg_core_handle->in_buf_used);
 
+        /* Fan out coalesced requests */
+        ret = hg_core_batch_unpack(hg_core_handle);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            rpc, error, ret, "Could not unpack coalesced requests");
+
         HG_LOG_SUBSYS_DEBUG(rpc,
             "Processing input for handle %p, tag=%u, buf_size=%zu",
             (void *) hg_core_handle, hg_core_handle->tag,
@@ -4534,11 +8910,16 @@ hg_core_multi_recv_input_cb(const struct na_cb_info *callback_info)
         *na_cb_info_multi_recv_unexpected =
             &callback_info->info.multi_recv_unexpected;
     struct hg_core_private_handle *hg_core_handle = NULL;
+    int32_t posted_count;
     hg_return_t ret;
 
     if (callback_info->ret == NA_SUCCESS) {
-        /* Get a new handle from the pool */
+        /* Get a new handle from the pool, once the pool holds request_max
+         * handles that are all in use, the request is rejected */
         ret = hg_core_handle_pool_get(context->handle_pool, &hg_core_handle);
+        if (ret == HG_BUSY)
+            ret = hg_core_handle_pool_get_busy(
+                context->handle_pool, &hg_core_handle);
         HG_CHECK_SUBSYS_HG_ERROR(
             rpc, error, ret, "Could not get handle from pool");
         hg_core_handle->multi_recv_op = multi_recv_op;
@@ -4547,16 +8928,27 @@ hg_core_multi_recv_input_cb(const struct na_cb_info *callback_info)
         /* Prevent from reposting multi-recv buffer until done with handle */
         hg_atomic_incr32(&multi_recv_op->ref_count);
         hg_core_handle->multi_recv_copy =
-            (unsigned int) hg_atomic_get32(&context->multi_recv_op_count) <=
-            HG_CORE_CONTEXT_CLASS(context)->init_info.multi_recv_copy_threshold;
+            hg_core_handle->busy ||
+            hg_atomic_get32(&context->multi_recv_op_count) <=
+                hg_atomic_get32(&context->multi_recv_copy_threshold);
 
         if (na_cb_info_multi_recv_unexpected->last) {
             HG_LOG_SUBSYS_DEBUG(rpc,
                 "Multi-recv buffer %d has been consumed (%" PRId32
                 " operations completed)",
                 multi_recv_op->id, hg_atomic_get32(&multi_recv_op->op_count));
+            if (context->multi_recv_adapt != NULL)
+                hg_time_get_current(&multi_recv_op->consume_time);
             hg_atomic_set32(&multi_recv_op->last, true);
-            if (hg_atomic_decr32(&context->multi_recv_op_count) == 0) {
+            posted_count = hg_atomic_decr32(&context->multi_recv_op_count);
+            if (posted_count == 0)
+                hg_core_stats_add(
+                    &context->stats->progress.multi_recv_exhausted, 1);
+            if (context->multi_recv_adapt != NULL)
+                hg_core_multi_recv_consumed(multi_recv_op, posted_count,
+                    context->core_context.core_class->na_class,
+                    context->core_context.na_context);
+            else if (posted_count == 0) {
                 unsigned int multi_recv_op_max =
                     HG_CORE_CONTEXT_CLASS(context)->init_info.multi_recv_op_max;
                 unsigned int i;
@@ -4594,6 +8986,7 @@ hg_core_multi_recv_input_cb(const struct na_cb_info *callback_info)
             memcpy(hg_core_handle->in_buf_storage,
                 na_cb_info_multi_recv_unexpected->actual_buf,
                 hg_core_handle->in_buf_used);
+            hg_core_stats_add(&context->stats->progress.multi_recv_copy, 1);
             hg_core_handle->core_handle.in_buf_size =
                 hg_core_handle->in_buf_storage_size;
             hg_core_handle->core_handle.in_buf = hg_core_handle->in_buf_storage;
@@ -4612,6 +9005,11 @@ hg_core_multi_recv_input_cb(const struct na_cb_info *callback_info)
                 na_cb_info_multi_recv_unexpected->actual_buf;
         }
 
+        /* Fan out coalesced requests */
+        ret = hg_core_batch_unpack(hg_core_handle);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            rpc, error, ret, "Could not unpack coalesced requests");
+
         HG_LOG_SUBSYS_DEBUG(rpc,
             "Processing input for handle %p, tag=%u, buf_size=%zu",
             (void *) hg_core_handle, hg_core_handle->tag,
@@ -4655,6 +9053,7 @@ hg_core_process_input(struct hg_core_private_handle *hg_core_handle)
 {
     struct hg_core_private_class *hg_core_class =
         HG_CORE_HANDLE_CLASS(hg_core_handle);
+    bool self = hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_SELF_FORWARD;
     hg_return_t ret;
 
 #if defined(HG_HAS_DEBUG) && !defined(_WIN32)
@@ -4662,8 +9061,21 @@ hg_core_process_input(struct hg_core_private_handle *hg_core_handle)
     hg_atomic_incr64(hg_core_class->counters.rpc_req_recv_count);
 #endif
 
+    /* Self RPCs are processed by the forwarding thread, not by progress */
+    if (self)
+        hg_core_stats_add_shared(
+            &HG_CORE_HANDLE_STATS(hg_core_handle)->shared.rpc_req_recv, 1);
+    else {
+        struct hg_core_stats_counters *counters =
+            &HG_CORE_HANDLE_STATS(hg_core_handle)->progress;
+
+        hg_core_stats_add(&counters->rpc_req_recv, 1);
+        hg_core_stats_add(
+            &counters->msg_bytes_recv, (int64_t) hg_core_handle->in_buf_used);
+    }
+
     /* We can skip RPC headers etc if we are sending to ourselves */
-    if (!(hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_SELF_FORWARD)) {
+    if (!self) {
         /* Get and verify input header */
         ret = hg_core_proc_header_request(&hg_core_handle->core_handle,
             &hg_core_handle->in_header, HG_DECODE);
@@ -4680,6 +9092,16 @@ hg_core_process_input(struct hg_core_private_handle *hg_core_handle)
         /* Parse flags */
         hg_atomic_set32(&hg_core_handle->flags,
             hg_core_handle->in_header.msg.request.flags);
+
+        /* Retrieve RPC info now so that the RPC is queued with its priority,
+         * missing RPC IDs are reported when processing the RPC */
+        hg_core_handle->core_handle.rpc_info = hg_core_map_lookup(
+            &hg_core_class->rpc_map, &hg_core_handle->core_handle.info.id);
+        hg_core_handle->core_handle.priority =
+            hg_core_process_priority(hg_core_handle);
+
+        if (hg_core_class->init_info.request_max > 0 && !hg_core_handle->busy)
+            hg_core_admission_acquire(hg_core_handle);
     }
 
     HG_LOG_SUBSYS_DEBUG(rpc,
@@ -4689,6 +9111,8 @@ hg_core_process_input(struct hg_core_private_handle *hg_core_handle)
         hg_core_handle->cookie,
         hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_NO_RESPONSE);
 
+    hg_core_trace_event(hg_core_handle, HG_CORE_TRACE_RECV_INPUT, 0);
+
     /* Must let upper layer get extra payload if HG_CORE_MORE_DATA is set */
     if (hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_MORE_DATA) {
         int32_t HG_DEBUG_LOG_USED expected_count;
@@ -4711,6 +9135,13 @@ hg_core_process_input(struct hg_core_private_handle *hg_core_handle)
         /* Increment counter */
         hg_atomic_incr64(hg_core_class->counters.rpc_req_extra_count);
 #endif
+        if (self)
+            hg_core_stats_add_shared(
+                &HG_CORE_HANDLE_STATS(hg_core_handle)->shared.rpc_req_extra, 1);
+        else
+            hg_core_stats_add(
+                &HG_CORE_HANDLE_STATS(hg_core_handle)->progress.rpc_req_extra,
+                1);
 
         ret = hg_core_class->more_data_cb.acquire(
             (hg_core_handle_t) hg_core_handle, HG_INPUT,
@@ -4726,15 +9157,104 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_admission_acquire(struct hg_core_private_handle *hg_core_handle)
+{
+    struct hg_core_private_context *context =
+        HG_CORE_HANDLE_CONTEXT(hg_core_handle);
+    struct hg_core_admission *admission = &context->admission;
+    int32_t request_max =
+        (int32_t) HG_CORE_CONTEXT_CLASS(context)->init_info.request_max;
+    unsigned int slot = (unsigned int) (((uintptr_t) hg_core_handle->na_addr *
+                                            UINT64_C(0x9e3779b97f4a7c15)) >>
+                                        32) &
+                        (HG_CORE_ADMISSION_ORIGIN_MAX - 1);
+    int32_t count, origin_count, origins;
+
+    count = hg_atomic_incr32(&admission->count);
+    if (count > request_max) {
+        hg_atomic_decr32(&admission->count);
+        hg_core_stats_add(&context->stats->progress.rpc_req_busy, 1);
+        HG_LOG_SUBSYS_DEBUG(rpc,
+            "Rejecting handle %p, %" PRId32 " requests already in process",
+            (void *) hg_core_handle, request_max);
+        hg_core_handle->busy = true;
+        return;
+    }
+
+    origin_count = hg_atomic_incr32(&admission->origin_counts[slot]);
+    origins = (origin_count == 1) ? hg_atomic_incr32(&admission->origin_count)
+                                  : hg_atomic_get32(&admission->origin_count);
+
+    /* Once half of the requests are in use, do not let a single origin take
+     * more than its share of them */
+    if (count > request_max / 2 && origins > 1 &&
+        origin_count > MAX(request_max / origins, 1)) {
+        if (hg_atomic_decr32(&admission->origin_counts[slot]) == 0)
+            hg_atomic_decr32(&admission->origin_count);
+        hg_atomic_decr32(&admission->count);
+        hg_core_stats_add(&context->stats->progress.rpc_req_unfair, 1);
+        HG_LOG_SUBSYS_DEBUG(rpc,
+            "Rejecting handle %p, origin has %" PRId32 " requests in process",
+            (void *) hg_core_handle, origin_count - 1);
+        hg_core_handle->busy = true;
+        return;
+    }
+
+    hg_core_handle->admission_slot = slot + 1;
+}
+
 /*---------------------------------------------------------------------------*/
 static HG_INLINE void
+hg_core_admission_release(struct hg_core_private_handle *hg_core_handle)
+{
+    struct hg_core_admission *admission =
+        &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->admission;
+
+    if (hg_core_handle->admission_slot == 0)
+        return;
+
+    if (hg_atomic_decr32(
+            &admission->origin_counts[hg_core_handle->admission_slot - 1]) == 0)
+        hg_atomic_decr32(&admission->origin_count);
+    hg_atomic_decr32(&admission->count);
+    hg_core_handle->admission_slot = 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE hg_priority_t
+hg_core_process_priority(const struct hg_core_private_handle *hg_core_handle)
+{
+    const struct hg_core_rpc_info *hg_core_rpc_info =
+        hg_core_handle->core_handle.rpc_info;
+    int32_t wire = (hg_atomic_get32(&hg_core_handle->flags) &
+                       HG_CORE_PRIORITY_MASK) >>
+                   HG_CORE_PRIORITY_SHIFT;
+    hg_priority_t priority = (wire == 0) ? HG_PRIORITY_DEFAULT
+                                         : (hg_priority_t) (wire - 1);
+
+    /* Registered priority may only raise the priority of the request */
+    if (hg_core_rpc_info != NULL && hg_core_rpc_info->priority > priority)
+        priority = (hg_priority_t) hg_core_rpc_info->priority;
+
+    return priority;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
 hg_core_send_output_cb(const struct na_cb_info *callback_info)
 {
     struct hg_core_private_handle *hg_core_handle =
         (struct hg_core_private_handle *) callback_info->arg;
 
     if (callback_info->ret == NA_SUCCESS) {
-        /* Nothing */
+        struct hg_core_stats_counters *counters =
+            &HG_CORE_HANDLE_STATS(hg_core_handle)->progress;
+
+        hg_core_stats_add(&counters->rpc_resp_sent, 1);
+        hg_core_stats_add(
+            &counters->msg_bytes_sent, (int64_t) hg_core_handle->out_buf_used);
     } else if (callback_info->ret == NA_CANCELED) {
         HG_CHECK_SUBSYS_WARNING(rpc,
             hg_atomic_get32(&hg_core_handle->status) & HG_CORE_OP_COMPLETED,
@@ -4765,12 +9285,32 @@ hg_core_recv_output_cb(const struct na_cb_info *callback_info)
 {
     struct hg_core_private_handle *hg_core_handle =
         (struct hg_core_private_handle *) callback_info->arg;
+    bool batch_output =
+        HG_CORE_HANDLE_CLASS(hg_core_handle)->init_info.coalesce_responses;
     hg_return_t ret;
 
+    /* Output was already received in a batch, recv was canceled */
+    if (batch_output && hg_core_batch_output_remove(hg_core_handle)) {
+        hg_core_complete_op(hg_core_handle);
+        return;
+    }
+
     if (callback_info->ret == NA_SUCCESS) {
         HG_LOG_SUBSYS_DEBUG(rpc, "Processing output for handle %p, tag=%u",
             (void *) hg_core_handle, hg_core_handle->tag);
 
+        hg_core_stats_add(
+            &HG_CORE_HANDLE_STATS(hg_core_handle)->progress.msg_bytes_recv,
+            (int64_t) callback_info->info.recv_expected.actual_buf_size);
+
+        /* Dispatch other responses if output is a batch */
+        if (batch_output) {
+            ret = hg_core_batch_output_unpack(hg_core_handle,
+                callback_info->info.recv_expected.actual_buf_size);
+            HG_CHECK_SUBSYS_HG_ERROR(
+                rpc, error, ret, "Could not unpack batch of responses");
+        }
+
         /* Process output information */
         ret = hg_core_process_output(hg_core_handle, hg_core_send_ack);
         HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not process output");
@@ -4811,14 +9351,24 @@ hg_core_process_output(struct hg_core_private_handle *hg_core_handle,
 {
     struct hg_core_private_class *hg_core_class =
         HG_CORE_HANDLE_CLASS(hg_core_handle);
+    bool self = hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_SELF_FORWARD;
     hg_return_t ret;
 
+    hg_core_trace_event(hg_core_handle, HG_CORE_TRACE_RECV_OUTPUT, 0);
+
 #if defined(HG_HAS_DEBUG) && !defined(_WIN32)
     /* Increment counter */
     hg_atomic_incr64(hg_core_class->counters.rpc_resp_recv_count);
 #endif
 
-    if (!(hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_SELF_FORWARD)) {
+    if (self)
+        hg_core_stats_add_shared(
+            &HG_CORE_HANDLE_STATS(hg_core_handle)->shared.rpc_resp_recv, 1);
+    else
+        hg_core_stats_add(
+            &HG_CORE_HANDLE_STATS(hg_core_handle)->progress.rpc_resp_recv, 1);
+
+    if (!self) {
         /* Get and verify output header */
         ret = hg_core_proc_header_response(&hg_core_handle->core_handle,
             &hg_core_handle->out_header, HG_DECODE);
@@ -4860,6 +9410,14 @@ hg_core_process_output(struct hg_core_private_handle *hg_core_handle,
         /* Increment counter */
         hg_atomic_incr64(hg_core_class->counters.rpc_resp_extra_count);
 #endif
+        if (self)
+            hg_core_stats_add_shared(
+                &HG_CORE_HANDLE_STATS(hg_core_handle)->shared.rpc_resp_extra,
+                1);
+        else
+            hg_core_stats_add(
+                &HG_CORE_HANDLE_STATS(hg_core_handle)->progress.rpc_resp_extra,
+                1);
 
         ret = hg_core_class->more_data_cb.acquire(
             (hg_core_handle_t) hg_core_handle, HG_OUTPUT, done_callback);
@@ -4988,30 +9546,17 @@ static hg_return_t
 hg_core_process(struct hg_core_private_handle *hg_core_handle)
 {
     struct hg_core_rpc_info *hg_core_rpc_info;
+    struct hg_core_rpc_hist *hist;
     int32_t HG_DEBUG_LOG_USED ref_count;
     hg_return_t ret;
 
-    /* Already cached for self RPCs */
-    if (hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_SELF_FORWARD)
-        hg_core_rpc_info = hg_core_handle->core_handle.rpc_info;
-    else {
-        /* Retrieve exe function from function map */
-        hg_core_rpc_info =
-            hg_core_map_lookup(&HG_CORE_HANDLE_CLASS(hg_core_handle)->rpc_map,
-                &hg_core_handle->core_handle.info.id);
-        if (hg_core_rpc_info == NULL) {
-            HG_LOG_SUBSYS_WARNING(rpc,
-                "Could not find RPC ID (%" PRIu64 ") in RPC map",
-                hg_core_handle->core_handle.info.id);
-            HG_GOTO_DONE(error, ret, HG_NOENTRY);
-        }
-        // HG_CHECK_SUBSYS_ERROR(rpc, hg_core_rpc_info == NULL, error, ret,
-        // HG_NOENTRY,
-        //     "Could not find RPC ID (%" PRIu64 ") in RPC map",
-        //     hg_core_handle->core_handle.info.id);
-
-        /* Cache RPC info */
-        hg_core_handle->core_handle.rpc_info = hg_core_rpc_info;
+    /* RPC info is cached when processing input */
+    hg_core_rpc_info = hg_core_handle->core_handle.rpc_info;
+    if (hg_core_rpc_info == NULL) {
+        HG_LOG_SUBSYS_WARNING(rpc,
+            "Could not find RPC ID (%" PRIu64 ") in RPC map",
+            hg_core_handle->core_handle.info.id);
+        HG_GOTO_DONE(error, ret, HG_NOENTRY);
     }
     HG_CHECK_SUBSYS_ERROR(rpc, hg_core_rpc_info->rpc_cb == NULL, error, ret,
         HG_INVALID_ARG, "No RPC callback registered");
@@ -5024,10 +9569,19 @@ hg_core_process(struct hg_core_private_handle *hg_core_handle)
         (void *) hg_core_handle, ref_count);
 
     /* Execute RPC callback */
+    hist = hg_core_rpc_hist_get(hg_core_handle);
+    if (hist != NULL)
+        hg_time_get_current(&hg_core_handle->process_time);
+    hg_core_trace_event(hg_core_handle, HG_CORE_TRACE_PROCESS, 0);
     ret = hg_core_rpc_info->rpc_cb((hg_core_handle_t) hg_core_handle);
     HG_CHECK_SUBSYS_HG_ERROR(
         rpc, error, ret, "Error while executing RPC callback");
 
+    /* No response completes, account for time spent in RPC callback */
+    if (hist != NULL && hg_core_rpc_info->no_response)
+        hg_core_rpc_hist_record(
+            &hist->handler, hg_core_handle->process_time);
+
     return HG_SUCCESS;
 
 error:
@@ -5058,6 +9612,9 @@ hg_core_complete_op(struct hg_core_private_handle *hg_core_handle)
 static HG_INLINE void
 hg_core_complete(struct hg_core_private_handle *hg_core_handle, hg_return_t ret)
 {
+    /* Deadline no longer applies */
+    hg_core_timer_disarm(hg_core_handle);
+
     /* Mark op id as completed, also mark the operation as queued to track
      * when it will be released from the completion queue. */
     hg_atomic_or32(
@@ -5120,6 +9677,24 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+void
+hg_core_stats_bulk(
+    struct hg_core_context *core_context, hg_size_t size, bool self)
+{
+    struct hg_core_context_stats *stats =
+        ((struct hg_core_private_context *) core_context)->stats;
+
+    /* Self transfers complete from the thread that issued them */
+    if (self) {
+        hg_core_stats_add_shared(&stats->shared.bulk_count, 1);
+        hg_core_stats_add_shared(&stats->shared.bulk_bytes, (int64_t) size);
+    } else {
+        hg_core_stats_add(&stats->progress.bulk_count, 1);
+        hg_core_stats_add(&stats->progress.bulk_bytes, (int64_t) size);
+    }
+}
+
 /*---------------------------------------------------------------------------*/
 void
 hg_core_completion_add(struct hg_core_context *core_context,
@@ -5127,7 +9702,8 @@ hg_core_completion_add(struct hg_core_context *core_context,
 {
     struct hg_core_private_context *context =
         (struct hg_core_private_context *) core_context;
-    struct hg_core_completion_queue *backfill_queue = &context->backfill_queue;
+    struct hg_core_completion_cond *completion_cond = &context->completion_cond;
+    hg_priority_t priority = HG_PRIORITY_DEFAULT;
     int rc;
 
 #if defined(HG_HAS_DEBUG) && !defined(_WIN32)
@@ -5136,23 +9712,37 @@ hg_core_completion_add(struct hg_core_context *core_context,
         hg_atomic_incr64(HG_CORE_CONTEXT_CLASS(context)->counters.bulk_count);
 #endif
 
-    rc = hg_atomic_queue_push(context->completion_queue, hg_completion_entry);
-    if (rc != HG_UTIL_SUCCESS) {
-        HG_LOG_SUBSYS_WARNING(perf, "Atomic completion queue is full, pushing "
-                                    "completion data to backfill queue");
+    /* Only RPC completions carry a priority */
+    if (hg_completion_entry->op_type == HG_RPC)
+        priority = (hg_priority_t) hg_completion_entry->op_id.hg_core_handle
+                       ->priority;
 
-        /* Queue is full */
-        hg_thread_mutex_lock(&backfill_queue->mutex);
-        STAILQ_INSERT_TAIL(&backfill_queue->queue, hg_completion_entry, entry);
-        hg_atomic_incr32(&backfill_queue->count);
-        hg_thread_mutex_unlock(&backfill_queue->mutex);
+    /* Queue grows as needed, this can only fail if memory is exhausted, in
+     * which case the entry is linked to the overflow list, which does not
+     * allocate, so that its completion is never lost */
+    rc = hg_atomic_seg_queue_push(
+        context->completion_queues[priority], hg_completion_entry);
+    if (rc != HG_UTIL_SUCCESS) {
+        HG_LOG_SUBSYS_WARNING(perf, "Could not push completion entry, pushing "
+                                    "completion data to overflow list");
+
+        hg_thread_mutex_lock(&completion_cond->mutex);
+        STAILQ_INSERT_TAIL(
+            &completion_cond->overflow, hg_completion_entry, entry);
+        hg_atomic_incr32(&completion_cond->overflow_count);
+        hg_thread_mutex_unlock(&completion_cond->mutex);
     }
 
     /* Callback is pushed to the completion queue when something completes
-     * so wake up anyone waiting in trigger */
-    hg_thread_mutex_lock(&backfill_queue->mutex);
-    hg_thread_cond_signal(&backfill_queue->cond);
-    hg_thread_mutex_unlock(&backfill_queue->mutex);
+     * so wake up anyone waiting in trigger. Waiters register themselves
+     * before checking the queue count, the fence therefore guarantees that
+     * either the entry is seen by the waiter or the waiter is seen here. */
+    hg_atomic_fence();
+    if (hg_atomic_get32(&completion_cond->waiters) > 0) {
+        hg_thread_mutex_lock(&completion_cond->mutex);
+        hg_thread_cond_signal(&completion_cond->cond);
+        hg_thread_mutex_unlock(&completion_cond->mutex);
+    }
 
     /* Do not bother notifying if it's not needed as any event call will
      * increase latency */
@@ -5165,51 +9755,156 @@ hg_core_completion_add(struct hg_core_context *core_context,
 static struct hg_completion_entry *
 hg_core_completion_get(struct hg_core_private_context *context)
 {
+    struct hg_completion_entry *hg_completion_entry;
+    unsigned int ticket;
+    int preferred, i;
+
+    /* Most contexts only use the default priority, do not contend on the
+     * shared ticket in that case */
+    if (hg_atomic_seg_queue_is_empty(
+            context->completion_queues[HG_PRIORITY_HIGH]) &&
+        hg_atomic_seg_queue_is_empty(
+            context->completion_queues[HG_PRIORITY_LOW])) {
+        hg_completion_entry = (struct hg_completion_entry *)
+            hg_atomic_seg_queue_pop(
+                context->completion_queues[HG_PRIORITY_DEFAULT]);
+        if (hg_completion_entry != NULL)
+            return hg_completion_entry;
+        return hg_core_completion_overflow_get(context);
+    }
+
+    /* Pick the queue that is due within the weighted cycle so that lower
+     * priorities are not starved when higher priorities are busy */
+    ticket = (unsigned int) hg_atomic_incr32(&context->completion_ticket) %
+             HG_CORE_PRIORITY_CYCLE;
+    if (ticket < HG_CORE_PRIORITY_WEIGHT_HIGH)
+        preferred = HG_PRIORITY_HIGH;
+    else if (ticket <
+             HG_CORE_PRIORITY_WEIGHT_HIGH + HG_CORE_PRIORITY_WEIGHT_DEFAULT)
+        preferred = HG_PRIORITY_DEFAULT;
+    else
+        preferred = HG_PRIORITY_LOW;
+
+    hg_completion_entry = (struct hg_completion_entry *)
+        hg_atomic_seg_queue_pop(context->completion_queues[preferred]);
+    if (hg_completion_entry != NULL)
+        return hg_completion_entry;
+
+    /* Otherwise fall back to the highest priority that has entries */
+    for (i = HG_PRIORITY_MAX - 1; i >= 0; i--) {
+        if (i == preferred)
+            continue;
+        hg_completion_entry = (struct hg_completion_entry *)
+            hg_atomic_seg_queue_pop(context->completion_queues[i]);
+        if (hg_completion_entry != NULL)
+            return hg_completion_entry;
+    }
+
+    return hg_core_completion_overflow_get(context);
+}
+
+/*---------------------------------------------------------------------------*/
+static struct hg_completion_entry *
+hg_core_completion_overflow_get(struct hg_core_private_context *context)
+{
+    struct hg_core_completion_cond *completion_cond = &context->completion_cond;
     struct hg_completion_entry *hg_completion_entry = NULL;
 
-    hg_completion_entry = hg_atomic_queue_pop_mc(context->completion_queue);
-    if (hg_completion_entry == NULL) { /* Check backfill queue */
-        struct hg_core_completion_queue *backfill_queue =
-            &context->backfill_queue;
-
-        if (hg_atomic_get32(&backfill_queue->count) > 0) {
-            hg_thread_mutex_lock(&backfill_queue->mutex);
-            if (hg_atomic_get32(&backfill_queue->count) > 0) {
-                hg_completion_entry = STAILQ_FIRST(&backfill_queue->queue);
-                STAILQ_REMOVE_HEAD(&backfill_queue->queue, entry);
-                hg_atomic_decr32(&backfill_queue->count);
-            }
-            hg_thread_mutex_unlock(&backfill_queue->mutex);
-        }
+    if (hg_atomic_get32(&completion_cond->overflow_count) == 0)
+        return NULL;
+
+    hg_thread_mutex_lock(&completion_cond->mutex);
+    hg_completion_entry = STAILQ_FIRST(&completion_cond->overflow);
+    if (hg_completion_entry != NULL) {
+        STAILQ_REMOVE_HEAD(&completion_cond->overflow, entry);
+        hg_atomic_decr32(&completion_cond->overflow_count);
     }
+    hg_thread_mutex_unlock(&completion_cond->mutex);
 
     return hg_completion_entry;
 }
 
+/*---------------------------------------------------------------------------*/
+static unsigned int
+hg_core_completion_get_n(struct hg_core_private_context *context,
+    struct hg_completion_entry **entries, unsigned int max_count)
+{
+    static const unsigned int weights[HG_PRIORITY_MAX] = {
+        HG_CORE_PRIORITY_WEIGHT_LOW, HG_CORE_PRIORITY_WEIGHT_DEFAULT,
+        HG_CORE_PRIORITY_WEIGHT_HIGH};
+    struct hg_completion_entry *hg_completion_entry;
+    unsigned int count = 0;
+
+    /* Most contexts only use the default priority */
+    if (hg_atomic_seg_queue_is_empty(
+            context->completion_queues[HG_PRIORITY_HIGH]) &&
+        hg_atomic_seg_queue_is_empty(
+            context->completion_queues[HG_PRIORITY_LOW])) {
+        count = hg_atomic_seg_queue_pop_n(
+            context->completion_queues[HG_PRIORITY_DEFAULT], (void **) entries,
+            max_count);
+        goto overflow;
+    }
+
+    /* Take up to weight entries from each queue per round, highest first */
+    while (count < max_count) {
+        unsigned int round_count = 0;
+        int i;
+
+        for (i = HG_PRIORITY_MAX - 1; i >= 0 && count < max_count; i--) {
+            unsigned int n = hg_atomic_seg_queue_pop_n(
+                context->completion_queues[i], (void **) &entries[count],
+                MIN(weights[i], max_count - count));
+
+            count += n;
+            round_count += n;
+        }
+        if (round_count == 0)
+            break;
+    }
+
+overflow:
+    while (count < max_count &&
+           (hg_completion_entry = hg_core_completion_overflow_get(context)) !=
+               NULL)
+        entries[count++] = hg_completion_entry;
+
+    return count;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_core_completion_wait(
     struct hg_core_private_context *context, unsigned int timeout_ms)
 {
-    struct hg_core_completion_queue *backfill_queue = &context->backfill_queue;
+    struct hg_core_completion_cond *completion_cond = &context->completion_cond;
     hg_return_t ret = HG_SUCCESS;
 
-    hg_thread_mutex_lock(&backfill_queue->mutex);
+    hg_thread_mutex_lock(&completion_cond->mutex);
+    hg_atomic_incr32(&completion_cond->waiters);
+    hg_atomic_fence();
     if ((hg_core_completion_count(context) == 0) &&
-        (hg_thread_cond_timedwait(&backfill_queue->cond, &backfill_queue->mutex,
-             timeout_ms) != HG_UTIL_SUCCESS))
+        (hg_thread_cond_timedwait(&completion_cond->cond,
+             &completion_cond->mutex, timeout_ms) != HG_UTIL_SUCCESS))
         ret = HG_TIMEOUT;
-    hg_thread_mutex_unlock(&backfill_queue->mutex);
+    hg_atomic_decr32(&completion_cond->waiters);
+    hg_thread_mutex_unlock(&completion_cond->mutex);
 
     return ret;
 }
 
 /*---------------------------------------------------------------------------*/
-static HG_INLINE unsigned int
+static unsigned int
 hg_core_completion_count(const struct hg_core_private_context *context)
 {
-    return hg_atomic_queue_count(context->completion_queue) +
-           (unsigned int) hg_atomic_get32(&context->backfill_queue.count);
+    return hg_atomic_seg_queue_count(
+               context->completion_queues[HG_PRIORITY_LOW]) +
+           hg_atomic_seg_queue_count(
+               context->completion_queues[HG_PRIORITY_DEFAULT]) +
+           hg_atomic_seg_queue_count(
+               context->completion_queues[HG_PRIORITY_HIGH]) +
+           (unsigned int) hg_atomic_get32(
+               &context->completion_cond.overflow_count);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -5237,6 +9932,83 @@ hg_core_completion_trigger(struct hg_completion_entry *hg_completion_entry)
     }
 }
 
+/*---------------------------------------------------------------------------*/
+static bool
+hg_core_completion_event(struct hg_completion_entry *hg_completion_entry,
+    struct hg_core_cb_event *event)
+{
+    switch (hg_completion_entry->op_type) {
+        case HG_ADDR: {
+            struct hg_core_op_id *hg_core_op_id =
+                hg_completion_entry->op_id.hg_core_op_id;
+
+            event->callback = hg_core_op_id->callback;
+            event->info =
+                (struct hg_core_cb_info){.arg = hg_core_op_id->arg,
+                    .ret = HG_SUCCESS,
+                    .type = HG_CB_LOOKUP,
+                    .info.lookup.addr = (hg_core_addr_t)
+                        hg_core_op_id->info.lookup.hg_core_addr};
+
+            /* NB. OK to free now, op ID is not re-used */
+            free(hg_core_op_id);
+
+            return (event->callback != NULL);
+        }
+        case HG_RPC: {
+            struct hg_core_private_handle *hg_core_handle =
+                (struct hg_core_private_handle *)
+                    hg_completion_entry->op_id.hg_core_handle;
+
+            if (hg_core_handle->op_type == HG_CORE_FORWARD &&
+                hg_core_handle->request_callback != NULL) {
+                event->callback = hg_core_handle->request_callback;
+                event->info = (struct hg_core_cb_info){
+                    .arg = hg_core_handle->request_arg,
+                    .ret = hg_core_handle->ret,
+                    .type = HG_CB_FORWARD,
+                    .info.forward.handle = (hg_core_handle_t) hg_core_handle};
+            } else if (hg_core_handle->op_type == HG_CORE_RESPOND &&
+                       !(hg_atomic_get32(&hg_core_handle->flags) &
+                           HG_CORE_SELF_FORWARD) &&
+                       hg_core_handle->response_callback != NULL) {
+                event->callback = hg_core_handle->response_callback;
+                event->info = (struct hg_core_cb_info){
+                    .arg = hg_core_handle->response_arg,
+                    .ret = hg_core_handle->ret,
+                    .type = HG_CB_RESPOND,
+                    .info.respond.handle = (hg_core_handle_t) hg_core_handle};
+            } else {
+                /* RPC processing and self responses are internal */
+                hg_core_trigger_entry(hg_core_handle);
+                return false;
+            }
+
+            /* Account for the event as if its callback was triggered */
+            hg_atomic_and32(&hg_core_handle->status, ~HG_CORE_OP_QUEUED);
+            hg_core_trace_event(hg_core_handle, HG_CORE_TRACE_TRIGGER,
+                (uint32_t) hg_core_handle->op_type);
+            hg_core_trigger_hist_record(hg_core_handle);
+
+            /* Reference is released by HG_Core_release_events() */
+            return true;
+        }
+        case HG_BULK:
+            /* Bulk op IDs are only known to the upper layer */
+            event->callback = NULL;
+            event->info = (struct hg_core_cb_info){
+                .arg = hg_completion_entry->op_id.hg_bulk_op_id,
+                .ret = HG_SUCCESS,
+                .type = HG_CB_BULK};
+
+            return true;
+        default:
+            HG_LOG_SUBSYS_ERROR(poll, "Invalid type of completion entry (%d)",
+                (int) hg_completion_entry->op_type);
+            return false;
+    }
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_core_progress_wait(
@@ -5253,25 +10025,60 @@ hg_core_progress_wait(
         bool safe_wait = false, progressed = false;
         unsigned int poll_timeout = 0;
 
+        /* Send coalesced requests before waiting on their completion */
+        hg_core_batch_flush(context);
+
+        /* Cancel RPCs whose deadline has expired */
+        hg_core_timer_advance(context);
+
+        /* Release handles left over from bursts */
+        hg_core_context_trim(context);
+
         /* Bypass notifications if timeout_ms is 0 to prevent system calls */
         if (timeout_ms == 0) {
             ; // nothing to do
         } else if (context->poll_set) {
-            if (!HG_Core_event_ready(&context->core_context)) {
+            /* Spin first as checking for events disables notifications */
+            if (context->progress_spin.max > 0) {
+                ret = hg_core_progress_spin(context, deadline, &progressed);
+                HG_CHECK_SUBSYS_HG_ERROR(
+                    poll, error, ret, "Could not spin on context progress");
+                if (progressed)
+                    return HG_SUCCESS;
+                hg_time_get_current_ms(&now);
+            }
+            if (!hg_core_event_ready(context)) {
                 safe_wait = true;
                 poll_timeout = hg_time_to_ms(hg_time_subtract(deadline, now));
             }
         } else if (!HG_CORE_CONTEXT_CLASS(context)->init_info.loopback &&
-                   !HG_Core_event_ready(&context->core_context)) {
+                   !hg_core_event_ready(context)) {
             /* This is the case for NA plugins that don't expose a fd */
             poll_timeout = hg_time_to_ms(hg_time_subtract(deadline, now));
         }
 
+        /* Wake up in time to expire the next deadline */
+        if (poll_timeout > 0)
+            poll_timeout = hg_core_timer_wait_ms(context, poll_timeout);
+
         /* Only enter blocking wait if it is safe to */
         if (safe_wait) {
             ret = hg_core_poll_wait(context, poll_timeout, &progressed);
             HG_CHECK_SUBSYS_HG_ERROR(poll, error, ret,
                 "Could not make blocking progress on context");
+
+            if (progressed && context->progress_spin.max > 0) {
+                hg_time_t t;
+
+                hg_time_get_current(&t);
+                hg_core_progress_spin_update(&context->progress_spin, t);
+                hg_core_stats_add_shared(
+                    &context->stats->shared.progress_block, 1);
+#if defined(HG_HAS_DEBUG) && !defined(_WIN32)
+                hg_atomic_incr64(HG_CORE_CONTEXT_CLASS(context)
+                                     ->counters.progress_block_count);
+#endif
+            }
         } else {
             ret = hg_core_progress_legacy(context, poll_timeout, &progressed);
             HG_CHECK_SUBSYS_HG_ERROR(poll, error, ret,
@@ -5292,6 +10099,98 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_progress_spin(struct hg_core_private_context *context,
+    hg_time_t deadline, bool *progressed_p)
+{
+    struct hg_core_progress_spin *progress_spin = &context->progress_spin;
+    hg_time_t now, spin_deadline;
+    int64_t interval, spin_time;
+    hg_return_t ret;
+
+    /* Entries are already waiting to be triggered */
+    *progressed_p = (hg_core_completion_count(context) > 0);
+    if (*progressed_p)
+        return HG_SUCCESS;
+
+    /* Spinning is only worth it if completions are expected soon enough */
+    interval = hg_atomic_get64(&progress_spin->interval);
+    if (interval > progress_spin->max)
+        return HG_SUCCESS;
+    spin_time = MIN(2 * interval, progress_spin->max);
+
+    hg_time_get_current(&now);
+    spin_deadline =
+        hg_time_add(now, hg_time_from_double((double) spin_time / 1e9));
+    if (hg_time_less(deadline, spin_deadline))
+        spin_deadline = deadline;
+
+    do {
+        unsigned int count = 0;
+
+        ret = hg_core_progress(context, &count);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            poll, error, ret, "Could not make progress on context");
+
+        hg_time_get_current(&now);
+        if (count > 0) {
+            hg_core_progress_spin_update(progress_spin, now);
+            hg_core_stats_add_shared(&context->stats->shared.progress_spin, 1);
+#if defined(HG_HAS_DEBUG) && !defined(_WIN32)
+            hg_atomic_incr64(
+                HG_CORE_CONTEXT_CLASS(context)->counters.progress_spin_count);
+#endif
+            *progressed_p = true;
+            break;
+        }
+    } while (hg_time_less(now, spin_deadline));
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE void
+hg_core_progress_spin_update(
+    struct hg_core_progress_spin *progress_spin, hg_time_t now)
+{
+    int64_t now_ns =
+                (int64_t) (hg_time_diff(now, progress_spin->start) * 1e9),
+            interval = hg_atomic_get64(&progress_spin->interval);
+
+    /* Concurrent updates may overwrite each other, which is fine as long as
+     * the average remains a reasonable estimate */
+    interval += (int64_t) (HG_CORE_PROGRESS_SPIN_WEIGHT *
+                           (double) (now_ns -
+                                     hg_atomic_get64(&progress_spin->last) -
+                                     interval));
+    hg_atomic_set64(&progress_spin->interval, interval);
+    hg_atomic_set64(&progress_spin->last, now_ns);
+}
+
+/*---------------------------------------------------------------------------*/
+static bool
+hg_core_event_ready(struct hg_core_private_context *context)
+{
+    const struct hg_core_class *core_class = context->core_context.core_class;
+
+    if (hg_core_completion_count(context) > 0)
+        return true;
+#ifdef NA_HAS_SM
+    if ((core_class->na_sm_class != NULL) &&
+        !NA_Poll_try_wait(
+            core_class->na_sm_class, context->core_context.na_sm_context))
+        return true;
+#endif
+    if (!NA_Poll_try_wait(
+            core_class->na_class, context->core_context.na_context))
+        return true;
+    return HG_Core_event_ready_loopback(&context->core_context);
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_core_poll_wait(struct hg_core_private_context *context,
@@ -5374,6 +10273,15 @@ hg_core_progress(struct hg_core_private_context *context, unsigned int *count_p)
         HG_CORE_CONTEXT_CLASS(context);
     hg_return_t ret;
 
+    /* Send coalesced requests */
+    hg_core_batch_flush(context);
+
+    /* Cancel RPCs whose deadline has expired */
+    hg_core_timer_advance(context);
+
+    /* Release handles left over from bursts */
+    hg_core_context_trim(context);
+
     /* Read loopback events if any */
     if (context->loopback_notify.event > 0) {
         /* There is no need to notify while we're in progress */
@@ -5635,6 +10543,76 @@ hg_core_trigger(struct hg_core_private_context *context, unsigned int max_count,
         *actual_count_p = count;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_trigger_events_wait(struct hg_core_private_context *context,
+    unsigned int timeout_ms, unsigned int max_count,
+    struct hg_core_cb_event *events, unsigned int *actual_count_p)
+{
+    hg_time_t deadline, now = hg_time_from_ms(0);
+    unsigned int count = 0;
+    hg_return_t ret = HG_SUCCESS;
+
+    if (timeout_ms != 0)
+        hg_time_get_current_ms(&now);
+    deadline = hg_time_add(now, hg_time_from_ms(timeout_ms));
+
+    while (max_count > 0) {
+        bool empty = (hg_core_completion_count(context) == 0);
+
+        count = hg_core_trigger_events(context, max_count, events);
+
+        /* Leave if events were retrieved or entries were processed */
+        if (count > 0 || !empty)
+            break;
+
+        /* Timeout is 0 so leave */
+        if (!hg_time_less(now, deadline)) {
+            ret = HG_TIMEOUT;
+            break;
+        }
+
+        /* Otherwise wait remaining ms */
+        ret = hg_core_completion_wait(
+            context, hg_time_to_ms(hg_time_subtract(deadline, now)));
+        if (ret == HG_TIMEOUT) /* Timeout occurred so leave */
+            break;
+
+        if (timeout_ms != 0)
+            hg_time_get_current_ms(&now);
+    }
+
+    if (actual_count_p)
+        *actual_count_p = count;
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static unsigned int
+hg_core_trigger_events(struct hg_core_private_context *context,
+    unsigned int max_count, struct hg_core_cb_event *events)
+{
+    struct hg_completion_entry *entries[HG_CORE_TRIGGER_EVENTS_BATCH];
+    unsigned int count = 0;
+
+    while (count < max_count) {
+        unsigned int entry_count, i;
+
+        /* Entries are claimed at once and cannot exceed remaining events */
+        entry_count = hg_core_completion_get_n(context, entries,
+            MIN(max_count - count, HG_CORE_TRIGGER_EVENTS_BATCH));
+        if (entry_count == 0)
+            break;
+
+        for (i = 0; i < entry_count; i++)
+            if (hg_core_completion_event(entries[i], &events[count]))
+                count++;
+    }
+
+    return count;
+}
+
 /*---------------------------------------------------------------------------*/
 static HG_INLINE void
 hg_core_trigger_lookup_entry(struct hg_core_op_id *hg_core_op_id)
@@ -5662,6 +10640,8 @@ hg_core_trigger_entry(struct hg_core_private_handle *hg_core_handle)
 
     HG_LOG_SUBSYS_DEBUG(rpc, "Triggering callback type %s",
         hg_core_op_type_to_string(hg_core_handle->op_type));
+    hg_core_trace_event(hg_core_handle, HG_CORE_TRACE_TRIGGER,
+        (uint32_t) hg_core_handle->op_type);
 
     hg_core_handle->ops.trigger(hg_core_handle);
 
@@ -5731,8 +10711,8 @@ hg_core_trigger_process(struct hg_core_private_handle *hg_core_handle)
             (void *) hg_core_handle, ref_count);
     }
 
-    /* Run RPC callback */
-    ret = hg_core_process(hg_core_handle);
+    /* Run RPC callback unless the request was rejected */
+    ret = (hg_core_handle->busy) ? HG_BUSY : hg_core_process(hg_core_handle);
     if (ret != HG_SUCCESS && !(flags & HG_CORE_NO_RESPONSE)) {
         hg_size_t header_size =
             hg_core_header_response_get_size() +
@@ -5743,10 +10723,27 @@ hg_core_trigger_process(struct hg_core_private_handle *hg_core_handle)
     }
 }
 
+/*---------------------------------------------------------------------------*/
+static HG_INLINE void
+hg_core_trigger_hist_record(struct hg_core_private_handle *hg_core_handle)
+{
+    struct hg_core_rpc_hist *hist = hg_core_rpc_hist_get(hg_core_handle);
+
+    if (hist == NULL || hg_core_handle->ret != HG_SUCCESS)
+        return;
+
+    if (hg_core_handle->op_type == HG_CORE_FORWARD)
+        hg_core_rpc_hist_record(&hist->forward, hg_core_handle->forward_time);
+    else if (hg_core_handle->op_type == HG_CORE_RESPOND)
+        hg_core_rpc_hist_record(&hist->handler, hg_core_handle->process_time);
+}
+
 /*---------------------------------------------------------------------------*/
 static HG_INLINE void
 hg_core_trigger_forward_cb(struct hg_core_private_handle *hg_core_handle)
 {
+    hg_core_trigger_hist_record(hg_core_handle);
+
     if (hg_core_handle->request_callback) {
         struct hg_core_cb_info hg_core_cb_info = {
             .arg = hg_core_handle->request_arg,
@@ -5762,6 +10759,8 @@ hg_core_trigger_forward_cb(struct hg_core_private_handle *hg_core_handle)
 static HG_INLINE void
 hg_core_trigger_respond_cb(struct hg_core_private_handle *hg_core_handle)
 {
+    hg_core_trigger_hist_record(hg_core_handle);
+
     if (hg_core_handle->response_callback) {
         struct hg_core_cb_info hg_core_cb_info = {
             .arg = hg_core_handle->response_arg,
@@ -5777,9 +10776,13 @@ hg_core_trigger_respond_cb(struct hg_core_private_handle *hg_core_handle)
 static void
 hg_core_trigger_self_respond_cb(struct hg_core_private_handle *hg_core_handle)
 {
+    struct hg_core_rpc_hist *hist = hg_core_rpc_hist_get(hg_core_handle);
     int32_t HG_DEBUG_LOG_USED ref_count, HG_DEBUG_LOG_USED expected_count;
     hg_return_t ret;
 
+    if (hist != NULL)
+        hg_core_rpc_hist_record(&hist->handler, hg_core_handle->process_time);
+
     /* Increment number of expected completions */
     expected_count = hg_atomic_incr32(&hg_core_handle->op_expected_count);
     HG_LOG_SUBSYS_DEBUG(rpc_ref, "Handle (%p) expected_count incr to %" PRId32,
@@ -5868,6 +10871,94 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static bool
+hg_core_handle_match_addr(const struct hg_core_private_handle *hg_core_handle,
+    const struct hg_core_addr *addr)
+{
+    na_addr_t *na_addr = addr->na_addr;
+
+#ifdef NA_HAS_SM
+    if (hg_core_handle->na_class == addr->core_class->na_sm_class)
+        na_addr = addr->na_sm_addr;
+#endif
+
+    return na_addr != NULL &&
+           (hg_core_handle->na_addr == na_addr ||
+               NA_Addr_cmp(
+                   hg_core_handle->na_class, hg_core_handle->na_addr, na_addr));
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_handle_list_cancel_addr(
+    struct hg_core_handle_list *handle_list, const struct hg_core_addr *addr)
+{
+    struct hg_core_private_handle *hg_core_handles[HG_CORE_CANCEL_BATCH];
+    struct hg_core_private_handle *last = NULL;
+    hg_return_t ret = HG_SUCCESS;
+
+    /* Handles are referenced in batches and compared outside of the list
+     * lock, their NA addr remains valid as long as they are referenced. The
+     * last handle of a full batch stays referenced, and therefore in the
+     * list, so that the next batch resumes after it */
+    do {
+        struct hg_core_private_handle *hg_core_handle;
+        unsigned int count = 0, i;
+
+        hg_thread_spin_lock(&handle_list->lock);
+        hg_core_handle = (last != NULL) ? LIST_NEXT(last, created)
+                                        : LIST_FIRST(&handle_list->list);
+        for (; hg_core_handle != NULL && count < HG_CORE_CANCEL_BATCH;
+             hg_core_handle = LIST_NEXT(hg_core_handle, created)) {
+            int32_t status = hg_atomic_get32(&hg_core_handle->status);
+            int32_t ref_count;
+
+            /* Only handles with operations still in flight */
+            if (!(status & HG_CORE_OP_POSTED) ||
+                (status & (HG_CORE_OP_COMPLETED | HG_CORE_OP_CANCELED |
+                              HG_CORE_OP_ERRORED)) ||
+                (hg_atomic_get32(&hg_core_handle->flags) &
+                    HG_CORE_SELF_FORWARD) ||
+                hg_core_handle->na_addr == NULL)
+                continue;
+
+            /* Keep handle alive while canceling, skip it if being freed */
+            do {
+                ref_count = hg_atomic_get32(&hg_core_handle->ref_count);
+            } while (ref_count > 0 &&
+                     !hg_atomic_cas32(
+                         &hg_core_handle->ref_count, ref_count, ref_count + 1));
+            if (ref_count == 0)
+                continue;
+
+            hg_core_handles[count++] = hg_core_handle;
+        }
+        hg_thread_spin_unlock(&handle_list->lock);
+
+        if (last != NULL)
+            (void) hg_core_destroy(last);
+        last = (count == HG_CORE_CANCEL_BATCH) ? hg_core_handles[count - 1]
+                                               : NULL;
+
+        for (i = 0; i < count; i++) {
+            if (hg_core_handle_match_addr(hg_core_handles[i], addr)) {
+                hg_return_t cancel_ret = hg_core_cancel(hg_core_handles[i]);
+                HG_CHECK_SUBSYS_ERROR_DONE(rpc, cancel_ret != HG_SUCCESS,
+                    "Could not cancel handle (%p)",
+                    (void *) hg_core_handles[i]);
+                if (ret == HG_SUCCESS)
+                    ret = cancel_ret;
+            }
+
+            if (hg_core_handles[i] != last)
+                (void) hg_core_destroy(hg_core_handles[i]);
+        }
+    } while (last != NULL);
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Core_get_na_protocol_info(
@@ -5956,16 +11047,72 @@ error:
 
 /*---------------------------------------------------------------------------*/
 hg_return_t
-HG_Core_finalize(hg_core_class_t *hg_core_class)
+HG_Core_finalize(hg_core_class_t *hg_core_class)
+{
+    hg_return_t ret;
+
+    HG_LOG_SUBSYS_DEBUG(
+        cls, "Finalizing core class (%p)", (void *) hg_core_class);
+
+    ret = hg_core_finalize((struct hg_core_private_class *) hg_core_class);
+    HG_CHECK_SUBSYS_HG_ERROR(cls, error, ret,
+        "Cannot finalize HG core class (%p)", (void *) hg_core_class);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+HG_Core_cleanup(void)
+{
+    NA_Cleanup();
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_set_more_data_callback(struct hg_core_class *hg_core_class,
+    hg_return_t (*more_data_acquire_callback)(hg_core_handle_t, hg_op_t,
+        void (*done_callback)(hg_core_handle_t, hg_return_t)),
+    void (*more_data_release_callback)(hg_core_handle_t))
+{
+    struct hg_core_private_class *private_class =
+        (struct hg_core_private_class *) hg_core_class;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(cls, hg_core_class == NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG core class");
+
+    private_class->more_data_cb.acquire = more_data_acquire_callback;
+    private_class->more_data_cb.release = more_data_release_callback;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_class_get_stats(hg_core_class_t *hg_core_class, struct hg_stats *stats)
 {
+    struct hg_core_private_class *private_class =
+        (struct hg_core_private_class *) hg_core_class;
+    struct hg_core_private_context *context;
     hg_return_t ret;
 
-    HG_LOG_SUBSYS_DEBUG(
-        cls, "Finalizing core class (%p)", (void *) hg_core_class);
+    HG_CHECK_SUBSYS_ERROR(cls, hg_core_class == NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG core class");
+    HG_CHECK_SUBSYS_ERROR(
+        cls, stats == NULL, error, ret, HG_INVALID_ARG, "NULL stats");
 
-    ret = hg_core_finalize((struct hg_core_private_class *) hg_core_class);
-    HG_CHECK_SUBSYS_HG_ERROR(cls, error, ret,
-        "Cannot finalize HG core class (%p)", (void *) hg_core_class);
+    hg_thread_spin_lock(&private_class->context_list.lock);
+    *stats = private_class->context_list.retired;
+    LIST_FOREACH (context, &private_class->context_list.list, entry)
+        hg_core_context_stats_sum(context, stats);
+    hg_thread_spin_unlock(&private_class->context_list.lock);
 
     return HG_SUCCESS;
 
@@ -5973,19 +11120,9 @@ error:
     return ret;
 }
 
-/*---------------------------------------------------------------------------*/
-void
-HG_Core_cleanup(void)
-{
-    NA_Cleanup();
-}
-
 /*---------------------------------------------------------------------------*/
 hg_return_t
-HG_Core_set_more_data_callback(struct hg_core_class *hg_core_class,
-    hg_return_t (*more_data_acquire_callback)(hg_core_handle_t, hg_op_t,
-        void (*done_callback)(hg_core_handle_t, hg_return_t)),
-    void (*more_data_release_callback)(hg_core_handle_t))
+HG_Core_class_dump_trace(hg_core_class_t *hg_core_class, const char *file)
 {
     struct hg_core_private_class *private_class =
         (struct hg_core_private_class *) hg_core_class;
@@ -5993,9 +11130,13 @@ HG_Core_set_more_data_callback(struct hg_core_class *hg_core_class,
 
     HG_CHECK_SUBSYS_ERROR(cls, hg_core_class == NULL, error, ret,
         HG_INVALID_ARG, "NULL HG core class");
+    HG_CHECK_SUBSYS_ERROR(
+        cls, file == NULL, error, ret, HG_INVALID_ARG, "NULL trace file");
+    HG_CHECK_SUBSYS_ERROR(cls, private_class->trace == NULL, error, ret,
+        HG_OPNOTSUPPORTED, "Tracing is only enabled with trace_file set");
 
-    private_class->more_data_cb.acquire = more_data_acquire_callback;
-    private_class->more_data_cb.release = more_data_release_callback;
+    ret = hg_core_trace_dump(private_class->trace, file);
+    HG_CHECK_SUBSYS_HG_ERROR(cls, error, ret, "Could not write trace");
 
     return HG_SUCCESS;
 
@@ -6016,7 +11157,7 @@ HG_Core_context_create(hg_core_class_t *hg_core_class)
     HG_LOG_SUBSYS_DEBUG(ctx, "Creating new context with id=%u", 0);
 
     ret = hg_core_context_create(
-        (struct hg_core_private_class *) hg_core_class, 0, &context);
+        (struct hg_core_private_class *) hg_core_class, 0, -1, &context);
     HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret, "Could not create context");
 
     HG_LOG_SUBSYS_DEBUG(ctx, "Created new context (%p)", (void *) context);
@@ -6040,7 +11181,7 @@ HG_Core_context_create_id(hg_core_class_t *hg_core_class, uint8_t id)
     HG_LOG_SUBSYS_DEBUG(ctx, "Creating new context with id=%u", id);
 
     ret = hg_core_context_create(
-        (struct hg_core_private_class *) hg_core_class, id, &context);
+        (struct hg_core_private_class *) hg_core_class, id, -1, &context);
     HG_CHECK_SUBSYS_HG_ERROR(
         ctx, error, ret, "Could not create context with id=%u", id);
 
@@ -6052,6 +11193,33 @@ error:
     return NULL;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_core_context_t *
+HG_Core_context_create_numa(
+    hg_core_class_t *hg_core_class, uint8_t id, int numa_node)
+{
+    struct hg_core_private_context *context;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR_NORET(
+        ctx, hg_core_class == NULL, error, "NULL HG core class");
+
+    HG_LOG_SUBSYS_DEBUG(ctx, "Creating new context with id=%u on NUMA node %d",
+        id, numa_node);
+
+    ret = hg_core_context_create((struct hg_core_private_class *) hg_core_class,
+        id, numa_node, &context);
+    HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret,
+        "Could not create context with id=%u on NUMA node %d", id, numa_node);
+
+    HG_LOG_SUBSYS_DEBUG(ctx, "Created new context (%p)", (void *) context);
+
+    return (hg_core_context_t *) context;
+
+error:
+    return NULL;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Core_context_destroy(hg_core_context_t *context)
@@ -6084,6 +11252,28 @@ error:
     return 0;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_context_get_stats(
+    const hg_core_context_t *context, struct hg_stats *stats)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(ctx, context == NULL, error, ret, HG_INVALID_ARG,
+        "NULL HG core context");
+    HG_CHECK_SUBSYS_ERROR(
+        ctx, stats == NULL, error, ret, HG_INVALID_ARG, "NULL stats");
+
+    memset(stats, 0, sizeof(*stats));
+    hg_core_context_stats_sum(
+        (const struct hg_core_private_context *) context, stats);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Core_context_set_handle_create_callback(hg_core_context_t *context,
@@ -6166,8 +11356,8 @@ HG_Core_register(
     if (hg_core_rpc_info == NULL) {
         HG_LOG_SUBSYS_DEBUG(cls, "Inserting new RPC ID (%" PRIu64 ")", id);
 
-        ret =
-            hg_core_map_insert(&private_class->rpc_map, &id, &hg_core_rpc_info);
+        ret = hg_core_map_insert(&private_class->rpc_map, &id,
+            private_class->init_info.stats, &hg_core_rpc_info);
         HG_CHECK_SUBSYS_HG_ERROR(
             cls, error, ret, "Could not insert new RPC ID (%" PRIu64 ")", id);
     } else
@@ -6329,6 +11519,116 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_registered_set_priority(
+    hg_core_class_t *hg_core_class, hg_id_t id, hg_priority_t priority)
+{
+    struct hg_core_private_class *private_class =
+        (struct hg_core_private_class *) hg_core_class;
+    struct hg_core_rpc_info *hg_core_rpc_info = NULL;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(cls, hg_core_class == NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG core class");
+    HG_CHECK_SUBSYS_ERROR(cls, (unsigned int) priority >= HG_PRIORITY_MAX,
+        error, ret, HG_INVALID_ARG, "Invalid priority (%d)", (int) priority);
+
+    hg_core_rpc_info = hg_core_map_lookup(&private_class->rpc_map, &id);
+    HG_CHECK_SUBSYS_ERROR(cls, hg_core_rpc_info == NULL, error, ret, HG_NOENTRY,
+        "Could not find RPC ID (%" PRIu64 ") in RPC map", id);
+
+    hg_core_rpc_info->priority = (uint8_t) priority;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_registered_get_priority(
+    hg_core_class_t *hg_core_class, hg_id_t id, hg_priority_t *priority_p)
+{
+    struct hg_core_private_class *private_class =
+        (struct hg_core_private_class *) hg_core_class;
+    struct hg_core_rpc_info *hg_core_rpc_info = NULL;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(cls, hg_core_class == NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG core class");
+    HG_CHECK_SUBSYS_ERROR(cls, priority_p == NULL, error, ret, HG_INVALID_ARG,
+        "NULL pointer to priority");
+
+    hg_core_rpc_info = hg_core_map_lookup(&private_class->rpc_map, &id);
+    HG_CHECK_SUBSYS_ERROR(cls, hg_core_rpc_info == NULL, error, ret, HG_NOENTRY,
+        "Could not find RPC ID (%" PRIu64 ") in RPC map", id);
+
+    *priority_p = (hg_priority_t) hg_core_rpc_info->priority;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_registered_freeze(hg_core_class_t *hg_core_class)
+{
+    struct hg_core_private_class *private_class =
+        (struct hg_core_private_class *) hg_core_class;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(cls, hg_core_class == NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG core class");
+
+    ret = hg_core_map_freeze(&private_class->rpc_map);
+    HG_CHECK_SUBSYS_HG_ERROR(cls, error, ret, "Could not freeze RPC map");
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_registered_get_latency(hg_core_class_t *hg_core_class, hg_id_t id,
+    struct hg_rpc_latency *latency, uint8_t reset)
+{
+    struct hg_core_private_class *private_class =
+        (struct hg_core_private_class *) hg_core_class;
+    struct hg_core_rpc_info *hg_core_rpc_info = NULL;
+    struct hg_core_rpc_hist *hist;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(cls, hg_core_class == NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG core class");
+    HG_CHECK_SUBSYS_ERROR(cls, latency == NULL, error, ret, HG_INVALID_ARG,
+        "NULL pointer to latency");
+    HG_CHECK_SUBSYS_ERROR(cls, !private_class->init_info.stats, error, ret,
+        HG_OPNOTSUPPORTED, "Latencies are only collected with stats set");
+
+    hg_core_rpc_info = hg_core_map_lookup(&private_class->rpc_map, &id);
+    HG_CHECK_SUBSYS_ERROR(cls, hg_core_rpc_info == NULL, error, ret, HG_NOENTRY,
+        "Could not find RPC ID (%" PRIu64 ") in RPC map", id);
+
+    hist = ((struct hg_core_map_entry *) hg_core_rpc_info)->hist;
+    hg_core_rpc_hist_summary(&hist->forward, &latency->forward);
+    hg_core_rpc_hist_summary(&hist->handler, &latency->handler);
+    if (reset) {
+        hg_histogram_reset(&hist->forward);
+        hg_histogram_reset(&hist->handler);
+    }
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Core_addr_lookup1(hg_core_context_t *context, hg_core_cb_t callback,
@@ -6414,6 +11714,36 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_addr_lookup_batch(hg_core_class_t *hg_core_class,
+    const char *const names[], unsigned int count, hg_core_addr_t addrs[])
+{
+    unsigned int i;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(addr, hg_core_class == NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG core class");
+    HG_CHECK_SUBSYS_ERROR(addr, count > 0 && (names == NULL || addrs == NULL),
+        error, ret, HG_INVALID_ARG, "NULL lookup names or addresses");
+    for (i = 0; i < count; i++)
+        HG_CHECK_SUBSYS_ERROR(addr, names[i] == NULL, error, ret,
+            HG_INVALID_ARG, "NULL lookup name (index %u)", i);
+
+    HG_LOG_SUBSYS_DEBUG(addr, "Looking up %u addresses", count);
+
+    ret = hg_core_addr_lookup_batch(
+        (struct hg_core_private_class *) hg_core_class, names, count,
+        (struct hg_core_private_addr **) addrs);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        addr, error, ret, "Could not lookup batch of %u addresses", count);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Core_addr_free(hg_core_addr_t addr)
@@ -6819,7 +12149,36 @@ HG_Core_forward(hg_core_handle_t handle, hg_core_cb_t callback, void *arg,
         (void *) handle, payload_size);
 
     ret = hg_core_forward((struct hg_core_private_handle *) handle, callback,
-        arg, flags, payload_size);
+        arg, flags, payload_size, 0);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        rpc, error, ret, "Could not forward handle (%p)", (void *) handle);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_forward_timed(hg_core_handle_t handle, hg_core_cb_t callback,
+    void *arg, uint8_t flags, hg_size_t payload_size, unsigned int timeout)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(rpc, handle == HG_CORE_HANDLE_NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG core handle");
+    HG_CHECK_SUBSYS_ERROR(rpc, handle->info.addr == HG_CORE_ADDR_NULL, error,
+        ret, HG_INVALID_ARG, "NULL target addr");
+    HG_CHECK_SUBSYS_ERROR(
+        rpc, handle->info.id == 0, error, ret, HG_INVALID_ARG, "NULL RPC ID");
+
+    HG_LOG_SUBSYS_DEBUG(rpc,
+        "Forwarding handle (%p), payload size is %" PRIu64 ", timeout is %u ms",
+        (void *) handle, payload_size, timeout);
+
+    ret = hg_core_forward((struct hg_core_private_handle *) handle, callback,
+        arg, flags, payload_size, timeout);
     HG_CHECK_SUBSYS_HG_ERROR(
         rpc, error, ret, "Could not forward handle (%p)", (void *) handle);
 
@@ -6876,6 +12235,51 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_addr_cancel_all(hg_core_context_t *context, hg_core_addr_t addr)
+{
+    struct hg_core_private_context *private_context =
+        (struct hg_core_private_context *) context;
+    hg_return_t ret, list_ret;
+
+    HG_CHECK_SUBSYS_ERROR(ctx, context == NULL, error, ret, HG_INVALID_ARG,
+        "NULL HG core context");
+    HG_CHECK_SUBSYS_ERROR(addr, addr == HG_CORE_ADDR_NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG core address");
+    HG_CHECK_SUBSYS_ERROR(addr, addr->core_class != context->core_class, error,
+        ret, HG_INVALID_ARG,
+        "Context and address passed belong to different classes");
+
+    /* Nothing is ever posted to self */
+    if (addr->is_self)
+        return HG_SUCCESS;
+
+    HG_LOG_SUBSYS_DEBUG(
+        addr, "Canceling all operations to addr (%p)", (void *) addr);
+
+    /* Cancel everything we can and return the first error: forwards are
+     * on the user list, responses on the internal list */
+    ret = hg_core_handle_list_cancel_addr(&private_context->user_list, addr);
+    list_ret =
+        hg_core_handle_list_cancel_addr(&private_context->internal_list, addr);
+    if (ret == HG_SUCCESS)
+        ret = list_ret;
+    if (private_context->hg_bulk_op_pool != NULL) {
+        list_ret =
+            hg_bulk_op_pool_cancel_addr(private_context->hg_bulk_op_pool, addr);
+        if (ret == HG_SUCCESS)
+            ret = list_ret;
+    }
+    HG_CHECK_SUBSYS_HG_ERROR(addr, error, ret,
+        "Could not cancel all operations to addr (%p)", (void *) addr);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 #ifdef HG_HAS_MULTI_PROGRESS
 hg_return_t
@@ -6994,6 +12398,81 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_trigger_events(hg_core_context_t *context, unsigned int timeout,
+    unsigned int max_count, struct hg_core_cb_event *events,
+    unsigned int *actual_count_p)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(poll, context == NULL, done, ret, HG_INVALID_ARG,
+        "NULL HG core context");
+    HG_CHECK_SUBSYS_ERROR(poll, events == NULL && max_count > 0, done, ret,
+        HG_INVALID_ARG, "NULL event array");
+
+    ret = hg_core_trigger_events_wait(
+        (struct hg_core_private_context *) context, timeout, max_count, events,
+        actual_count_p);
+    HG_CHECK_SUBSYS_ERROR_NORET(poll, ret != HG_SUCCESS && ret != HG_TIMEOUT,
+        done, "Could not retrieve events");
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+HG_Core_release_events(struct hg_core_cb_event *events, unsigned int count)
+{
+    unsigned int i;
+
+    for (i = 0; i < count; i++) {
+        switch (events[i].info.type) {
+            case HG_CB_FORWARD:
+                (void) hg_core_destroy((struct hg_core_private_handle *)
+                                           events[i].info.info.forward.handle);
+                break;
+            case HG_CB_RESPOND:
+                (void) hg_core_destroy((struct hg_core_private_handle *)
+                                           events[i].info.info.respond.handle);
+                break;
+            case HG_CB_BULK:
+                hg_bulk_release_entry(
+                    (struct hg_bulk_op_id *) events[i].info.arg);
+                break;
+            case HG_CB_LOOKUP:
+            default:
+                /* Nothing to release */
+                break;
+        }
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+unsigned int
+HG_Core_completion_get(hg_core_context_t *context, unsigned int max_count,
+    struct hg_completion_entry **entries)
+{
+    HG_CHECK_SUBSYS_ERROR_NORET(
+        poll, context == NULL, error, "NULL HG core context");
+    HG_CHECK_SUBSYS_ERROR_NORET(poll, entries == NULL && max_count > 0, error,
+        "NULL entry array");
+
+    return hg_core_completion_get_n(
+        (struct hg_core_private_context *) context, entries, max_count);
+
+error:
+    return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+HG_Core_completion_trigger(struct hg_completion_entry *entry)
+{
+    hg_core_completion_trigger(entry);
+}
+
 /*---------------------------------------------------------------------------*/
 int
 HG_Core_event_get_wait_fd(const hg_core_context_t *context)
@@ -22,6 +22,7 @@ typedef struct hg_core_context hg_core_context_t; /* Opaque HG core context */
 typedef struct hg_core_addr *hg_core_addr_t;      /* Abstract HG address */
 typedef struct hg_core_handle *hg_core_handle_t;  /* Abstract RPC handle */
 typedef struct hg_core_op_id *hg_core_op_id_t;    /* Abstract operation id */
+struct hg_completion_entry; /* Opaque completion entry */
 
 /* HG info struct */
 struct hg_core_info {
@@ -61,6 +62,12 @@ typedef hg_return_t (*hg_core_rpc_cb_t)(hg_core_handle_t handle);
 typedef hg_return_t (*hg_core_cb_t)(
     const struct hg_core_cb_info *callback_info);
 
+/* Completion event (see HG_Core_trigger_events()) */
+struct hg_core_cb_event {
+    hg_core_cb_t callback;       /* Callback attached to the operation */
+    struct hg_core_cb_info info; /* Callback info */
+};
+
 /*****************/
 /* Public Macros */
 /*****************/
@@ -303,6 +310,32 @@ static HG_INLINE void *
 HG_Core_class_get_data(
     const hg_core_class_t *hg_core_class) HG_WARN_UNUSED_RESULT;
 
+/**
+ * Retrieve stats accumulated by all the contexts (including destroyed ones)
+ * that were created from that class.
+ *
+ * \param hg_core_class [IN]    pointer to HG core class
+ * \param stats [OUT]           pointer to stats struct
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_class_get_stats(
+    hg_core_class_t *hg_core_class, struct hg_stats *stats);
+
+/**
+ * Write the handle lifecycle events recorded so far as Chrome trace event
+ * JSON (viewable with Perfetto or chrome://tracing). Tracing must have been
+ * enabled by setting trace_file at init time.
+ *
+ * \param hg_core_class [IN]    pointer to HG core class
+ * \param file [IN]             path of trace file
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_class_dump_trace(hg_core_class_t *hg_core_class, const char *file);
+
 /**
  * Create a new context. Must be destroyed by calling HG_Core_context_destroy().
  *
@@ -328,6 +361,25 @@ HG_PUBLIC hg_core_context_t *
 HG_Core_context_create_id(
     hg_core_class_t *hg_core_class, uint8_t id) HG_WARN_UNUSED_RESULT;
 
+/**
+ * Create a new context with a user-defined context identifier whose resources
+ * (handle pools, bulk op pool, NA message and multi-recv buffers) are
+ * preferably allocated on NUMA node \numa_node, see
+ * HG_Core_context_create_id(). Memory is placed through the memory policy of
+ * the calling thread and placement is only a hint, the context is still
+ * created if the policy cannot be set.
+ * Context must be destroyed by calling HG_Core_context_destroy().
+ *
+ * \param hg_core_class [IN]    pointer to HG core class
+ * \param id [IN]               context ID
+ * \param numa_node [IN]        NUMA node (negative for no preference)
+ *
+ * \return Pointer to HG core context or NULL in case of failure
+ */
+HG_PUBLIC hg_core_context_t *
+HG_Core_context_create_numa(hg_core_class_t *hg_core_class, uint8_t id,
+    int numa_node) HG_WARN_UNUSED_RESULT;
+
 /**
  * Destroy a context created by HG_Core_context_create().
  *
@@ -418,6 +470,20 @@ HG_PUBLIC unsigned int
 HG_Core_context_get_completion_count(
     const hg_core_context_t *context) HG_WARN_UNUSED_RESULT;
 
+/**
+ * Retrieve stats accumulated by context since its creation. Stats are
+ * gathered without synchronization and may be retrieved while the context is
+ * in use, in which case counters may not all reflect the same point in time.
+ *
+ * \param context [IN]          pointer to HG core context
+ * \param stats [OUT]           pointer to stats struct
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_context_get_stats(
+    const hg_core_context_t *context, struct hg_stats *stats);
+
 /**
  * Set callback to be called on HG core handle creation. Handles are created
  * both on HG_Core_create() and HG_Core_context_post() calls. This allows
@@ -562,6 +628,65 @@ HG_PUBLIC hg_return_t
 HG_Core_registered_disabled_response(
     hg_core_class_t *hg_core_class, hg_id_t id, uint8_t *disabled_p);
 
+/**
+ * Set default priority of a given RPC ID. Handles created for that RPC ID
+ * use that priority unless HG_Core_set_priority() is called. On the target,
+ * RPCs are processed with the highest of the priority sent by the origin
+ * and the priority registered for that RPC ID.
+ * By default, all RPCs use HG_PRIORITY_DEFAULT.
+ *
+ * \param hg_core_class [IN]    pointer to HG core class
+ * \param id [IN]               registered function ID
+ * \param priority [IN]         priority
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_registered_set_priority(
+    hg_core_class_t *hg_core_class, hg_id_t id, hg_priority_t priority);
+
+/**
+ * Get default priority of a given RPC ID.
+ *
+ * \param hg_core_class [IN]    pointer to HG core class
+ * \param id [IN]               registered function ID
+ * \param priority_p [OUT]      pointer to returned priority
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_registered_get_priority(
+    hg_core_class_t *hg_core_class, hg_id_t id, hg_priority_t *priority_p);
+
+/**
+ * Compile the map of registered RPC IDs into a perfect hash table so that
+ * each lookup of an incoming RPC ID reads a single slot. This is meant to be
+ * called once all RPCs have been registered. RPC IDs can still be registered
+ * or deregistered afterwards, in which case the map is converted back to its
+ * default representation.
+ *
+ * \param hg_core_class [IN]    pointer to HG core class
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_registered_freeze(hg_core_class_t *hg_core_class);
+
+/**
+ * Get a snapshot of the latencies recorded for an RPC ID. Latencies are only
+ * recorded when the class is initialized with stats set.
+ *
+ * \param hg_core_class [IN]    pointer to HG core class
+ * \param id [IN]               registered function ID
+ * \param latency [OUT]         pointer to latency struct
+ * \param reset [IN]            reset histograms after snapshot
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_registered_get_latency(hg_core_class_t *hg_core_class, hg_id_t id,
+    struct hg_rpc_latency *latency, uint8_t reset);
+
 /**
  * Lookup an addr from a peer address/name. Addresses need to be
  * freed by calling HG_Core_addr_free(). After completion, user callback is
@@ -593,6 +718,24 @@ HG_PUBLIC hg_return_t
 HG_Core_addr_lookup2(
     hg_core_class_t *hg_core_class, const char *name, hg_core_addr_t *addr_p);
 
+/**
+ * Lookup an array of addrs from peer addresses/names. Names that have already
+ * been looked up by a previous batch, or that appear multiple times in the
+ * same batch, share the same address. Each returned address must be freed by
+ * calling HG_Core_addr_free(). If one of the lookups fails, no address is
+ * returned.
+ *
+ * \param hg_core_class [IN]    pointer to HG core class
+ * \param names [IN]            array of lookup names
+ * \param count [IN]            number of names
+ * \param addrs [OUT]           array of count returned addresses
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_addr_lookup_batch(hg_core_class_t *hg_core_class,
+    const char *const names[], unsigned int count, hg_core_addr_t addrs[]);
+
 /**
  * Free the addr from the list of peers.
  *
@@ -865,6 +1008,22 @@ HG_Core_get_rpc_data(hg_core_handle_t handle) HG_WARN_UNUSED_RESULT;
 static HG_INLINE hg_return_t
 HG_Core_set_target_id(hg_core_handle_t handle, uint8_t id);
 
+/**
+ * Set priority of the RPC request. Completions of handles with a higher
+ * priority are triggered first, using a weighted policy that still lets
+ * lower priorities make progress. The priority is also sent to the target
+ * so that the RPC callback is scheduled accordingly. Priority defaults to
+ * the one set with HG_Core_registered_set_priority() and is reset when the
+ * handle is reset with a different RPC ID.
+ *
+ * \param handle [IN]           HG handle
+ * \param priority [IN]         priority
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+static HG_INLINE hg_return_t
+HG_Core_set_priority(hg_core_handle_t handle, hg_priority_t priority);
+
 /**
  * Get input buffer from handle that can be used for serializing/deserializing
  * parameters.
@@ -926,6 +1085,27 @@ HG_PUBLIC hg_return_t
 HG_Core_forward(hg_core_handle_t handle, hg_core_cb_t callback, void *arg,
     uint8_t flags, hg_size_t payload_size);
 
+/**
+ * Forward a call using an existing HG handle, see HG_Core_forward(). If the
+ * call has not completed after timeout milliseconds, it is canceled and its
+ * callback completes with HG_TIMEOUT. Expired calls are detected while the
+ * context makes progress.
+ *
+ * \remark Calls forwarded to self cannot be canceled and ignore timeout.
+ *
+ * \param handle [IN]           HG handle
+ * \param callback [IN]         pointer to function callback
+ * \param arg [IN]              pointer to data passed to callback
+ * \param flags [IN]            optional flags (e.g., HG_CORE_MORE_DATA)
+ * \param payload_size [IN]     size of payload to send
+ * \param timeout [IN]          timeout (in milliseconds), 0 for no timeout
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_forward_timed(hg_core_handle_t handle, hg_core_cb_t callback,
+    void *arg, uint8_t flags, hg_size_t payload_size, unsigned int timeout);
+
 /**
  * Respond back to the origin. The output buffer, which can be used to encode
  * the response, must first be queried using HG_Core_get_output().
@@ -953,6 +1133,21 @@ HG_Core_respond(hg_core_handle_t handle, hg_core_cb_t callback, void *arg,
 HG_PUBLIC hg_return_t
 HG_Core_cancel(hg_core_handle_t handle);
 
+/**
+ * Cancel all ongoing operations of a context that target an address, i.e.,
+ * forwarded RPCs, responses and bulk transfers. This is typically used once
+ * a peer is known to have failed and avoids canceling each operation
+ * separately. Callbacks of canceled operations are still triggered and
+ * return HG_CANCELED.
+ *
+ * \param context [IN]          pointer to HG core context
+ * \param addr [IN]             abstract address
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_addr_cancel_all(hg_core_context_t *context, hg_core_addr_t addr);
+
 /**
  * (Deprecated in favor of HG_Core_event_progress())
  * Try to progress RPC execution for at most timeout until timeout is reached or
@@ -986,6 +1181,72 @@ HG_PUBLIC hg_return_t
 HG_Core_trigger(hg_core_context_t *context, unsigned int timeout,
     unsigned int max_count, unsigned int *actual_count_p);
 
+/**
+ * Retrieve at most max_count completion events without executing their
+ * callbacks. Completed operations are removed from the completion queue in
+ * batches and each event describes the operation type, its handle or address,
+ * its return code and the user argument that was passed when the operation
+ * was posted, along with the callback that would have been executed, so that
+ * callers can dispatch them on their own. If timeout is non-zero, wait up to
+ * timeout before returning.
+ *
+ * \remark Incoming RPC requests and responses to self-forwarded RPCs are
+ * processed internally and are not reported, operations that have no callback
+ * attached are not reported either. Bulk operations are an exception, their
+ * callback is only known to the upper layer, bulk events are therefore
+ * reported with a NULL callback and their op ID passed as the info arg.
+ * Events hold a reference to their handle or op ID, which must be released with
+ * HG_Core_release_events() once events have been processed.
+ *
+ * \param context [IN]          pointer to HG core context
+ * \param timeout [IN]          timeout (in milliseconds)
+ * \param max_count [IN]        maximum number of events returned
+ * \param events [OUT]          array of at least max_count events
+ * \param actual_count_p [OUT]  actual number of events returned
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_trigger_events(hg_core_context_t *context, unsigned int timeout,
+    unsigned int max_count, struct hg_core_cb_event *events,
+    unsigned int *actual_count_p);
+
+/**
+ * Release resources held by events returned by HG_Core_trigger_events().
+ *
+ * \param events [IN]           array of events
+ * \param count [IN]            number of events
+ */
+HG_PUBLIC void
+HG_Core_release_events(struct hg_core_cb_event *events, unsigned int count);
+
+/**
+ * Remove at most max_count entries from the context's completion queue
+ * without executing them, entries are returned in the same order that
+ * HG_Core_trigger() would execute them. Each entry must then be executed
+ * exactly once by calling HG_Core_completion_trigger(), which may be done
+ * from any thread, so that callers can distribute callbacks to their own
+ * workers.
+ *
+ * \param context [IN]          pointer to HG core context
+ * \param max_count [IN]        maximum number of entries returned
+ * \param entries [OUT]         array of at least max_count entries
+ *
+ * \return Number of entries returned
+ */
+HG_PUBLIC unsigned int
+HG_Core_completion_get(hg_core_context_t *context, unsigned int max_count,
+    struct hg_completion_entry **entries);
+
+/**
+ * Execute the callback of an entry returned by HG_Core_completion_get() and
+ * release the resources attached to it.
+ *
+ * \param entry [IN]            pointer to completion entry
+ */
+HG_PUBLIC void
+HG_Core_completion_trigger(struct hg_completion_entry *entry);
+
 /**
  * Retrieve file descriptor from internal wait object when supported.
  * The descriptor can be used by upper layers for manual polling through the
@@ -1093,6 +1354,7 @@ struct hg_core_rpc_info {
     void (*free_callback)(void *); /* User data free callback */
     hg_id_t id;                    /* RPC ID */
     uint8_t no_response;           /* RPC response not expected */
+    uint8_t priority;              /* RPC priority (hg_priority_t) */
 };
 
 /* HG core handle */
@@ -1107,6 +1369,7 @@ struct hg_core_handle {
     size_t out_buf_size;                /* Output buffer size */
     size_t na_in_header_offset;         /* Input NA header offset */
     size_t na_out_header_offset;        /* Output NA header offset */
+    uint8_t priority;                   /* Priority (hg_priority_t) */
 };
 
 /*---------------------------------------------------------------------------*/
@@ -1299,6 +1562,18 @@ HG_Core_set_target_id(hg_core_handle_t handle, uint8_t id)
     return HG_SUCCESS;
 }
 
+/*---------------------------------------------------------------------------*/
+static HG_INLINE hg_return_t
+HG_Core_set_priority(hg_core_handle_t handle, hg_priority_t priority)
+{
+    if ((unsigned int) priority >= HG_PRIORITY_MAX)
+        return HG_INVALID_ARG;
+
+    handle->priority = (uint8_t) priority;
+
+    return HG_SUCCESS;
+}
+
 /*---------------------------------------------------------------------------*/
 static HG_INLINE hg_return_t
 HG_Core_get_input(
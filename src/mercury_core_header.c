@@ -9,7 +9,7 @@
 #include "mercury_error.h"
 
 #ifdef HG_HAS_CHECKSUMS
-#    include <mchecksum.h>
+#    include "mercury_crc32c.h"
 #endif
 
 #include "mercury_inet.h"
@@ -21,8 +21,6 @@
 /* Local Macros */
 /****************/
 
-#define HG_CORE_HEADER_CHECKSUM "crc16"
-
 /* Convert values between host and network byte order */
 #define hg_core_header_proc_uint8_t_enc(x)  (x & 0xff)
 #define hg_core_header_proc_uint8_t_dec(x)  (x & 0xff)
@@ -41,17 +39,6 @@
 #define hg_core_header_proc_int8_t_dec(x)                                      \
     (int8_t) hg_core_header_proc_uint8_t_dec((uint8_t) x)
 
-/* Update checksum */
-#ifdef HG_HAS_CHECKSUMS
-#    define HG_CORE_HEADER_CHECKSUM_UPDATE(hg_header, data, type)              \
-        do {                                                                   \
-            if (hg_header->checksum != MCHECKSUM_OBJECT_NULL)                  \
-                mchecksum_update(hg_header->checksum, &data, sizeof(type));    \
-        } while (0)
-#else
-#    define HG_CORE_HEADER_CHECKSUM_UPDATE(hg_header, data, type)
-#endif
-
 /* Proc type */
 #define HG_CORE_HEADER_PROC_TYPE(buf_ptr, data, type, op)                      \
     do {                                                                       \
@@ -66,13 +53,6 @@
         buf_ptr = (char *) buf_ptr + sizeof(type);                             \
     } while (0)
 
-/* Proc */
-#define HG_CORE_HEADER_PROC(hg_header, buf_ptr, data, type, op)                \
-    do {                                                                       \
-        HG_CORE_HEADER_PROC_TYPE(buf_ptr, data, type, op);                     \
-        HG_CORE_HEADER_CHECKSUM_UPDATE(hg_header, data, type);                 \
-    } while (0)
-
 /************************************/
 /* Local Type and Struct Definition */
 /************************************/
@@ -83,19 +63,56 @@
 extern const char *
 HG_Error_to_string(hg_return_t errnum);
 
+#ifdef HG_HAS_CHECKSUMS
+/**
+ * Encode or verify checksum of the encoded header fields that precede it.
+ */
+static hg_return_t
+hg_core_header_checksum_proc(
+    hg_proc_op_t op, void *buf, void **buf_ptr_p, uint32_t *hash_p);
+#endif
+
 /*******************/
 /* Local Variables */
 /*******************/
 
+#ifdef HG_HAS_CHECKSUMS
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_header_checksum_proc(
+    hg_proc_op_t op, void *buf, void **buf_ptr_p, uint32_t *hash_p)
+{
+    /* Fields are checksummed at once in their encoded form */
+    uint32_t hash = hg_crc32c(
+        0, buf, (size_t) ((const char *) *buf_ptr_p - (const char *) buf));
+    hg_return_t ret;
+
+    if (op == HG_ENCODE) {
+        *hash_p = hash;
+        HG_CORE_HEADER_PROC_TYPE(*buf_ptr_p, *hash_p, uint32_t, op);
+    } else { /* HG_DECODE */
+        HG_CORE_HEADER_PROC_TYPE(*buf_ptr_p, *hash_p, uint32_t, op);
+        HG_CHECK_SUBSYS_ERROR(rpc, *hash_p != hash, error, ret,
+            HG_CHECKSUM_ERROR,
+            "checksum 0x%08" PRIx32 " does not match (expected 0x%08" PRIx32
+            "!)",
+            hash, *hash_p);
+    }
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+#endif
+
 /*---------------------------------------------------------------------------*/
 void
 hg_core_header_request_init(
     struct hg_core_header *hg_core_header, bool use_checksum)
 {
 #ifdef HG_HAS_CHECKSUMS
-    /* Create a new checksum (CRC16) */
-    if (use_checksum)
-        mchecksum_init(HG_CORE_HEADER_CHECKSUM, &hg_core_header->checksum);
+    hg_core_header->checksum = use_checksum;
 #else
     (void) use_checksum;
 #endif
@@ -109,9 +126,7 @@ hg_core_header_response_init(
     struct hg_core_header *hg_core_header, bool use_checksum)
 {
 #ifdef HG_HAS_CHECKSUMS
-    /* Create a new checksum (CRC16) */
-    if (use_checksum)
-        mchecksum_init(HG_CORE_HEADER_CHECKSUM, &hg_core_header->checksum);
+    hg_core_header->checksum = use_checksum;
 #else
     (void) use_checksum;
 #endif
@@ -123,24 +138,14 @@ hg_core_header_response_init(
 void
 hg_core_header_request_finalize(struct hg_core_header *hg_core_header)
 {
-#ifdef HG_HAS_CHECKSUMS
-    mchecksum_destroy(hg_core_header->checksum);
-    hg_core_header->checksum = MCHECKSUM_OBJECT_NULL;
-#else
     (void) hg_core_header;
-#endif
 }
 
 /*---------------------------------------------------------------------------*/
 void
 hg_core_header_response_finalize(struct hg_core_header *hg_core_header)
 {
-#ifdef HG_HAS_CHECKSUMS
-    mchecksum_destroy(hg_core_header->checksum);
-    hg_core_header->checksum = MCHECKSUM_OBJECT_NULL;
-#else
     (void) hg_core_header;
-#endif
 }
 
 /*---------------------------------------------------------------------------*/
@@ -151,11 +156,6 @@ hg_core_header_request_reset(struct hg_core_header *hg_core_header)
         &hg_core_header->msg.request, 0, sizeof(struct hg_core_header_request));
     hg_core_header->msg.request.hg = HG_CORE_IDENTIFIER;
     hg_core_header->msg.request.protocol = HG_CORE_PROTOCOL_VERSION;
-
-#ifdef HG_HAS_CHECKSUMS
-    if (hg_core_header->checksum != MCHECKSUM_OBJECT_NULL)
-        mchecksum_reset(hg_core_header->checksum);
-#endif
 }
 
 /*---------------------------------------------------------------------------*/
@@ -164,11 +164,6 @@ hg_core_header_response_reset(struct hg_core_header *hg_core_header)
 {
     memset(&hg_core_header->msg.response, 0,
         sizeof(struct hg_core_header_response));
-
-#ifdef HG_HAS_CHECKSUMS
-    if (hg_core_header->checksum != MCHECKSUM_OBJECT_NULL)
-        mchecksum_reset(hg_core_header->checksum);
-#endif
 }
 
 /*---------------------------------------------------------------------------*/
@@ -183,46 +178,29 @@ hg_core_header_request_proc(hg_proc_op_t op, void *buf, size_t buf_size,
     HG_CHECK_SUBSYS_ERROR(rpc, buf_size < sizeof(struct hg_core_header_request),
         error, ret, HG_INVALID_ARG, "Invalid buffer size");
 
-#ifdef HG_HAS_CHECKSUMS
-    /* Reset header checksum first */
-    if (hg_core_header->checksum != MCHECKSUM_OBJECT_NULL)
-        mchecksum_reset(hg_core_header->checksum);
-#endif
-
     /* HG byte */
-    HG_CORE_HEADER_PROC(hg_core_header, buf_ptr, header->hg, uint8_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->hg, uint8_t, op);
 
     /* Protocol */
-    HG_CORE_HEADER_PROC(hg_core_header, buf_ptr, header->protocol, uint8_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->protocol, uint8_t, op);
 
     /* RPC ID */
-    HG_CORE_HEADER_PROC(hg_core_header, buf_ptr, header->id, uint64_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->id, uint64_t, op);
 
     /* Flags */
-    HG_CORE_HEADER_PROC(hg_core_header, buf_ptr, header->flags, uint8_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->flags, uint8_t, op);
 
     /* Cookie */
-    HG_CORE_HEADER_PROC(hg_core_header, buf_ptr, header->cookie, uint8_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->cookie, uint8_t, op);
 
 #ifdef HG_HAS_CHECKSUMS
-    if (hg_core_header->checksum != MCHECKSUM_OBJECT_NULL) {
-        /* Checksum of header */
-        mchecksum_get(hg_core_header->checksum, &header->hash.header,
-            sizeof(uint16_t), MCHECKSUM_FINALIZE);
-
-        if (op == HG_ENCODE) {
-            HG_CORE_HEADER_PROC_TYPE(
-                buf_ptr, header->hash.header, uint16_t, op);
-        } else { /* HG_DECODE */
-            uint16_t h_hash_header = 0;
-
-            HG_CORE_HEADER_PROC_TYPE(buf_ptr, h_hash_header, uint16_t, op);
-            HG_CHECK_SUBSYS_ERROR(rpc, header->hash.header != h_hash_header,
-                error, ret, HG_CHECKSUM_ERROR,
-                "checksum 0x%04" PRIx16 " does not match (expected 0x%04" PRIx16
-                "!)",
-                header->hash.header, h_hash_header);
-        }
+    if (hg_core_header->checksum) {
+        uint32_t hash = header->hash.header;
+
+        /* Packed member cannot be passed by address */
+        ret = hg_core_header_checksum_proc(op, buf, &buf_ptr, &hash);
+        header->hash.header = hash;
+        HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Header checksum failed");
     }
 #endif
 
@@ -245,40 +223,23 @@ hg_core_header_response_proc(hg_proc_op_t op, void *buf, size_t buf_size,
         buf_size < sizeof(struct hg_core_header_response), error, ret,
         HG_OVERFLOW, "Invalid buffer size");
 
-#ifdef HG_HAS_CHECKSUMS
-    /* Reset header checksum first */
-    if (hg_core_header->checksum != MCHECKSUM_OBJECT_NULL)
-        mchecksum_reset(hg_core_header->checksum);
-#endif
-
     /* Return code */
-    HG_CORE_HEADER_PROC(hg_core_header, buf_ptr, header->ret_code, int8_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->ret_code, int8_t, op);
 
     /* Flags */
-    HG_CORE_HEADER_PROC(hg_core_header, buf_ptr, header->flags, uint8_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->flags, uint8_t, op);
 
     /* Cookie */
-    HG_CORE_HEADER_PROC(hg_core_header, buf_ptr, header->cookie, uint16_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->cookie, uint16_t, op);
 
 #ifdef HG_HAS_CHECKSUMS
-    if (hg_core_header->checksum != MCHECKSUM_OBJECT_NULL) {
-        /* Checksum of header */
-        mchecksum_get(hg_core_header->checksum, &header->hash.header,
-            sizeof(uint16_t), MCHECKSUM_FINALIZE);
-
-        if (op == HG_ENCODE) {
-            HG_CORE_HEADER_PROC_TYPE(
-                buf_ptr, header->hash.header, uint16_t, op);
-        } else { /* HG_DECODE */
-            uint16_t h_hash_header = 0;
-
-            HG_CORE_HEADER_PROC_TYPE(buf_ptr, h_hash_header, uint16_t, op);
-            HG_CHECK_SUBSYS_ERROR(rpc, header->hash.header != h_hash_header,
-                error, ret, HG_CHECKSUM_ERROR,
-                "checksum 0x%04" PRIx16 " does not match (expected 0x%04" PRIx16
-                "!)",
-                header->hash.header, h_hash_header);
-        }
+    if (hg_core_header->checksum) {
+        uint32_t hash = header->hash.header;
+
+        /* Packed member cannot be passed by address */
+        ret = hg_core_header_checksum_proc(op, buf, &buf_ptr, &hash);
+        header->hash.header = hash;
+        HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Header checksum failed");
     }
 #endif
 
@@ -288,6 +249,66 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+hg_core_header_batch_proc(hg_proc_op_t op, void *buf, size_t buf_size,
+    struct hg_core_header_batch *header)
+{
+    void *buf_ptr = buf;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(rpc, buf_size < sizeof(struct hg_core_header_batch),
+        error, ret, HG_OVERFLOW, "Invalid buffer size");
+
+    /* HG batch byte */
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->hg, uint8_t, op);
+
+    /* Protocol */
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->protocol, uint8_t, op);
+
+    /* Record count */
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->count, uint16_t, op);
+
+    if (op == HG_DECODE) {
+        HG_CHECK_SUBSYS_ERROR(rpc, header->hg != HG_CORE_BATCH_IDENTIFIER,
+            error, ret, HG_PROTOCOL_ERROR, "Invalid HG batch byte");
+        HG_CHECK_SUBSYS_ERROR(rpc,
+            header->protocol != HG_CORE_PROTOCOL_VERSION, error, ret,
+            HG_PROTONOSUPPORT,
+            "Invalid protocol version, using %" PRIx8 ", expected %x",
+            header->protocol, HG_CORE_PROTOCOL_VERSION);
+    }
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+hg_core_header_batch_record_proc(hg_proc_op_t op, void *buf, size_t buf_size,
+    struct hg_core_header_batch_record *header)
+{
+    void *buf_ptr = buf;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(rpc,
+        buf_size < sizeof(struct hg_core_header_batch_record), error, ret,
+        HG_OVERFLOW, "Invalid buffer size");
+
+    /* Tag */
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->tag, uint32_t, op);
+
+    /* Message size */
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->size, uint32_t, op);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 hg_core_header_request_verify(const struct hg_core_header *hg_core_header)
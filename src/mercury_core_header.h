@@ -16,8 +16,7 @@
 
 #ifdef HG_HAS_CHECKSUMS
 HG_PACKED(union hg_core_header_hash {
-    uint16_t header; /* Header checksum (16-bits checksum) */
-    uint32_t pad;
+    uint32_t header; /* Header checksum (CRC32C) */
 });
 
 HG_PACKED(struct hg_core_header_request {
@@ -57,6 +56,19 @@ HG_PACKED(struct hg_core_header_response {
 });
 #endif
 
+/* Batch header, used when multiple messages are coalesced */
+HG_PACKED(struct hg_core_header_batch {
+    uint8_t hg;       /* Mercury batch identifier */
+    uint8_t protocol; /* Version number */
+    uint16_t count;   /* Number of records */
+});
+
+/* Batch record header, immediately followed by the record message */
+HG_PACKED(struct hg_core_header_batch_record {
+    uint32_t tag;  /* Tag of the record message */
+    uint32_t size; /* Size of the record message */
+});
+
 /* Common header struct request/response */
 struct hg_core_header {
     union {
@@ -64,7 +76,7 @@ struct hg_core_header {
         struct hg_core_header_response response;
     } msg;
 #ifdef HG_HAS_CHECKSUMS
-    struct mchecksum_object *checksum; /* Checksum of header */
+    bool checksum; /* Checksum header */
 #endif
 };
 
@@ -80,6 +92,20 @@ struct hg_core_header {
  *
  * Response:
  * flags / return code / cookie / checksum
+ *
+ * Coalesced messages are sent as a single batch, each record contains a
+ * complete message (header and encoded data) excluding the NA header:
+ *
+ * 0        HG_CORE_HEADER_SIZE                                      size
+ * |______________|_____________|______________|_____|________________|
+ * |    Batch     |   Record    |   Message    | ... |  Last message  |
+ * |______________|_____________|______________|_____|________________|
+ *
+ * Batch:
+ * mercury batch byte / protocol version number / record count
+ *
+ * Record:
+ * tag / message size
  */
 
 /*****************/
@@ -89,8 +115,11 @@ struct hg_core_header {
 /* Mercury identifier for packets sent */
 #define HG_CORE_IDENTIFIER (('H' << 1) | ('G')) /* 0xD7 */
 
+/* Mercury identifier for batches of coalesced messages */
+#define HG_CORE_BATCH_IDENTIFIER (('H' << 1) | ('B')) /* 0xD2 */
+
 /* Mercury protocol version number */
-#define HG_CORE_PROTOCOL_VERSION 0x05
+#define HG_CORE_PROTOCOL_VERSION 0x06
 
 /*********************/
 /* Public Prototypes */
@@ -104,6 +133,12 @@ static HG_INLINE size_t
 hg_core_header_request_get_size(void);
 static HG_INLINE size_t
 hg_core_header_response_get_size(void);
+static HG_INLINE size_t
+hg_core_header_batch_get_size(void);
+static HG_INLINE size_t
+hg_core_header_batch_record_get_size(void);
+static HG_INLINE bool
+hg_core_header_batch_check(const void *buf, size_t buf_size);
 
 /**
  * Get size reserved for request header (separate user data stored in payload).
@@ -127,6 +162,43 @@ hg_core_header_response_get_size(void)
     return sizeof(struct hg_core_header_response);
 }
 
+/**
+ * Get size reserved for batch header.
+ *
+ * \return Non-negative size value
+ */
+static HG_INLINE size_t
+hg_core_header_batch_get_size(void)
+{
+    return sizeof(struct hg_core_header_batch);
+}
+
+/**
+ * Get size reserved for each batch record header.
+ *
+ * \return Non-negative size value
+ */
+static HG_INLINE size_t
+hg_core_header_batch_record_get_size(void)
+{
+    return sizeof(struct hg_core_header_batch_record);
+}
+
+/**
+ * Check whether buffer contains a batch of coalesced messages.
+ *
+ * \param buf [IN]                  buffer
+ * \param buf_size [IN]             buffer size
+ *
+ * \return true if buffer starts with a batch header
+ */
+static HG_INLINE bool
+hg_core_header_batch_check(const void *buf, size_t buf_size)
+{
+    return buf_size >= sizeof(struct hg_core_header_batch) &&
+           *(const uint8_t *) buf == HG_CORE_BATCH_IDENTIFIER;
+}
+
 /**
  * Initialize RPC request header.
  *
@@ -213,6 +285,34 @@ HG_PRIVATE hg_return_t
 hg_core_header_response_proc(hg_proc_op_t op, void *buf, size_t buf_size,
     struct hg_core_header *hg_core_header);
 
+/**
+ * Process batch header.
+ *
+ * \param op [IN]                   operation type: HG_ENCODE / HG_DECODE
+ * \param buf [IN/OUT]              buffer
+ * \param buf_size [IN]             buffer size
+ * \param header [IN/OUT]           pointer to batch header structure
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PRIVATE hg_return_t
+hg_core_header_batch_proc(hg_proc_op_t op, void *buf, size_t buf_size,
+    struct hg_core_header_batch *header);
+
+/**
+ * Process batch record header.
+ *
+ * \param op [IN]                   operation type: HG_ENCODE / HG_DECODE
+ * \param buf [IN/OUT]              buffer
+ * \param buf_size [IN]             buffer size
+ * \param header [IN/OUT]           pointer to record header structure
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PRIVATE hg_return_t
+hg_core_header_batch_record_proc(hg_proc_op_t op, void *buf, size_t buf_size,
+    struct hg_core_header_batch_record *header);
+
 /**
  * Verify private information from request header.
  *
@@ -26,6 +26,14 @@ typedef enum hg_checksum_level {
                                 headers) */
 } hg_checksum_level_t;
 
+/* RPC priorities */
+typedef enum hg_priority {
+    HG_PRIORITY_LOW,     /*!< background traffic */
+    HG_PRIORITY_DEFAULT, /*!< default priority */
+    HG_PRIORITY_HIGH,    /*!< latency-critical traffic */
+    HG_PRIORITY_MAX
+} hg_priority_t;
+
 /**
  * HG init info struct
  * NB. should be initialized using HG_INIT_INFO_INITIALIZER
@@ -82,7 +90,8 @@ struct hg_init_info {
      * Default is: false */
     uint8_t no_loopback;
 
-    /* (Debug) Print stats at exit.
+    /* Collect per-RPC latency histograms and print them at exit (debug builds
+     * also print diagnostic counters).
      * Default is: false */
     uint8_t stats;
 
@@ -117,6 +126,132 @@ struct hg_init_info {
      * multi_recv_op_max.
      * Default value is: 0 (never copy) */
     unsigned int multi_recv_copy_threshold;
+
+    /* Controls the initial number of entries that a context completion queue
+     * can hold before it needs to grow. Value must be a power of 2, a value of
+     * zero is equivalent to using the internal default value.
+     * Default value is: 1024 */
+    unsigned int completion_queue_size;
+
+    /* Controls how long (in microseconds) progress may spin before entering a
+     * blocking wait. The actual spin time adapts to the recent inter-arrival
+     * time of completions, spinning is skipped when completions are expected
+     * to arrive later than that limit. A value of zero disables spinning.
+     * Default value is: 0 */
+    unsigned int progress_spin_max;
+
+    /* Coalesce RPC requests that are forwarded to the same target into a
+     * single message (up to the eager message size). Coalesced requests are
+     * sent once that message is full or when the context makes progress.
+     * Targets always accept coalesced requests.
+     * Default is: false */
+    bool coalesce_requests;
+
+    /* Coalesce RPC responses that are sent to the same origin into a single
+     * message (up to the eager message size), only for origins that also
+     * enable that option. Coalesced responses are sent once that message is
+     * full or when the context makes progress.
+     * Default is: false */
+    bool coalesce_responses;
+
+    /* Controls the number of requests that a context may process at once.
+     * Once reached, incoming requests are rejected and their forward
+     * callback completes with HG_BUSY on the origin. When more than half of
+     * that number is in use, origins are also rejected when they hold more
+     * than their fair share of requests. Handle pools are not extended beyond
+     * that number, further requests remain queued in the NA transport until
+     * handles are reposted or, when using multi-recv, are rejected. A value
+     * of zero means no limit.
+     * Default value is: 0 */
+    uint32_t request_max;
+
+    /* Adapt multi-recv buffers to their observed usage. Buffers are added (up
+     * to multi_recv_op_max) and then enlarged when all posted buffers get
+     * consumed, and are shrunk and freed when spare buffers remain posted.
+     * The copy threshold is raised when buffers are held by handles for
+     * longer than it takes to fill them and lowered when copies are not
+     * needed, multi_recv_copy_threshold is then only the initial value.
+     * In that mode, multi_recv_op_max defaults to 16.
+     * Default is: false */
+    bool multi_recv_adaptive;
+
+    /* Back handle input/output buffers from per-context arenas made of
+     * hugepage-sized chunks that are registered once, and allocate
+     * multi-recv buffers using hugepages. Regular pages are transparently
+     * used when hugepages are not available. A chunk is released once all of
+     * its buffers are freed (e.g., after handles are trimmed), the last chunk
+     * is kept until the context is destroyed.
+     * Default is: false */
+    bool hugepage_arena;
+
+    /* Controls how long (in milliseconds) handles that were posted when
+     * extending the pool of handles may remain unused before they are
+     * unposted and freed. The pool is shrunk by the number of handles that
+     * remained available over that period and never below request_post_init.
+     * A value of zero means that pools are never shrunk.
+     * Default value is: 0 */
+    unsigned int request_trim_time;
+
+    /* Record handle lifecycle events (forward, input sent / received, RPC
+     * callback, respond, output received, trigger) into per-thread rings
+     * and write them to trace_file as Chrome trace event JSON on finalize
+     * (see also HG_Class_dump_trace()). Only the most recent events of each
+     * thread are kept, events of more than 64 concurrent threads are dropped.
+     * Default is: NULL (no tracing) */
+    const char *trace_file;
+};
+
+/**
+ * HG stats struct
+ * Counters accumulated since context creation (or class initialization when
+ * retrieved from a class). Counters are available in release builds.
+ */
+struct hg_stats {
+    uint64_t rpc_req_sent;         /* RPC requests sent */
+    uint64_t rpc_req_recv;         /* RPC requests received */
+    uint64_t rpc_resp_sent;        /* RPC responses sent */
+    uint64_t rpc_resp_recv;        /* RPC responses received */
+    uint64_t rpc_req_extra;        /* RPC requests that used overflow data */
+    uint64_t rpc_resp_extra;       /* RPC responses that used overflow data */
+    uint64_t msg_bytes_sent;       /* Bytes sent in RPC messages */
+    uint64_t msg_bytes_recv;       /* Bytes received in RPC messages */
+    uint64_t bulk_count;           /* Bulk transfers completed */
+    uint64_t bulk_bytes;           /* Bytes moved by bulk transfers */
+    uint64_t multi_recv_copy;      /* Multi-recv payloads copied out */
+    uint64_t multi_recv_exhausted; /* Times all multi-recv buffers consumed */
+    uint64_t multi_recv_resize;    /* Multi-recv buffer count/size changes */
+    uint64_t completion_spill;     /* Completion queue segment spills */
+    uint64_t retry;                /* Sends that must be retried (HG_AGAIN) */
+    uint64_t rpc_req_busy;         /* RPC requests rejected (request_max) */
+    uint64_t rpc_req_unfair;       /* RPC requests rejected (origin share) */
+    uint64_t rpc_req_timeout;      /* RPC requests canceled on deadline */
+    uint64_t handle_pool_grow;     /* Times handle pools were extended */
+    uint64_t handle_pool_shrink;   /* Times handle pools were trimmed */
+    uint64_t progress_spin;        /* Progress completed while spinning */
+    uint64_t progress_block;       /* Progress completed after blocking */
+};
+
+/**
+ * HG latency struct
+ * Latency percentiles (in nanoseconds) summarized from a histogram, values are
+ * rounded up to the histogram bucket resolution.
+ */
+struct hg_latency {
+    uint64_t count; /* Number of samples */
+    uint64_t p50;   /* 50th percentile */
+    uint64_t p99;   /* 99th percentile */
+    uint64_t p999;  /* 99.9th percentile */
+    uint64_t max;   /* Max */
+};
+
+/**
+ * HG RPC latency struct
+ * Latencies of a registered RPC, only collected when the class is initialized
+ * with stats set.
+ */
+struct hg_rpc_latency {
+    struct hg_latency forward; /* Forward to forward callback (origin) */
+    struct hg_latency handler; /* RPC callback to respond completion (target) */
 };
 
 /* Error return codes:
@@ -212,7 +347,11 @@ typedef enum {
         .no_bulk_eager = false, .no_loopback = false, .stats = false,          \
         .no_multi_recv = false, .release_input_early = false,                  \
         .no_overflow = false, .multi_recv_op_max = 0,                          \
-        .multi_recv_copy_threshold = 0                                         \
+        .multi_recv_copy_threshold = 0, .completion_queue_size = 0,            \
+        .progress_spin_max = 0, .coalesce_requests = false,                    \
+        .coalesce_responses = false, .request_max = 0,                         \
+        .multi_recv_adaptive = false, .hugepage_arena = false,                 \
+        .request_trim_time = 0, .trace_file = NULL                             \
     }
 
 #endif /* MERCURY_CORE_TYPES_H */
@@ -0,0 +1,614 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#    define _GNU_SOURCE
+#endif
+#include "mercury_engine.h"
+#include "mercury.h"
+#include "mercury_core.h"
+#include "mercury_error.h"
+
+#include "mercury_atomic.h"
+#include "mercury_mem.h"
+#include "mercury_thread.h"
+#include "mercury_thread_condition.h"
+#include "mercury_thread_mutex.h"
+#include "mercury_thread_spin.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Default number of workers */
+#define HG_ENGINE_WORKER_COUNT_DEFAULT (1)
+
+/* Default progress timeout (ms) */
+#define HG_ENGINE_PROGRESS_TIMEOUT_DEFAULT (100)
+
+/* Initial size of worker deques (must be a power of 2) */
+#define HG_ENGINE_DEQUE_SIZE (256)
+
+/* Number of entries retrieved at once from a context */
+#define HG_ENGINE_DISPATCH_BATCH (64)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+/* Worker, its deque is kept on its own cache line. Entries are pushed to the
+ * tail, the owner pops the newest entry from the tail while other workers
+ * steal the oldest entry from the head. */
+struct hg_engine_worker {
+    HG_UTIL_ALIGNED(hg_thread_spin_t lock, HG_MEM_CACHE_LINE_SIZE);
+    struct hg_completion_entry **entries; /* Ring of entries */
+    unsigned int head;                    /* Index of oldest entry */
+    unsigned int mask;                    /* Ring size - 1 */
+    hg_atomic_int32_t count;              /* Number of entries */
+    struct hg_engine *engine;             /* Engine */
+    unsigned int index;                   /* Worker index */
+    hg_thread_t thread;                   /* Worker thread */
+};
+
+/* Progress thread */
+struct hg_engine_progress {
+    struct hg_engine *engine; /* Engine */
+    hg_context_t *context;    /* Context progressed */
+    unsigned int next_worker; /* Next worker that receives entries */
+    hg_thread_t thread;       /* Progress thread */
+};
+
+/* Engine */
+struct hg_engine {
+    struct hg_engine_worker *workers;    /* Workers */
+    struct hg_engine_progress *progress; /* Progress threads */
+    unsigned int worker_count;           /* Number of workers */
+    unsigned int worker_init_count;      /* Number of deques initialized */
+    unsigned int worker_thread_count;    /* Number of worker threads */
+    unsigned int progress_count;         /* Number of contexts */
+    unsigned int progress_thread_count;  /* Number of progress threads */
+    unsigned int progress_timeout;       /* Progress timeout (ms) */
+    hg_thread_mutex_t mutex;             /* Lock for sleeping workers */
+    hg_thread_cond_t cond;               /* Cond for sleeping workers */
+    hg_atomic_int32_t sleeping;          /* Number of sleeping workers */
+    hg_atomic_int32_t progress_stop;     /* Stop progress threads */
+    bool worker_stop;                    /* Stop workers (protected) */
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+/**
+ * Pin thread to CPU.
+ */
+static hg_return_t
+hg_engine_thread_pin(hg_thread_t thread, int cpu);
+
+/**
+ * Push entry to the tail of a worker deque.
+ */
+static hg_return_t
+hg_engine_deque_push(
+    struct hg_engine_worker *worker, struct hg_completion_entry *entry);
+
+/**
+ * Pop newest entry from the tail of a worker deque (owner only).
+ */
+static struct hg_completion_entry *
+hg_engine_deque_pop(struct hg_engine_worker *worker);
+
+/**
+ * Steal oldest entry from the head of a worker deque.
+ */
+static struct hg_completion_entry *
+hg_engine_deque_steal(struct hg_engine_worker *worker);
+
+/**
+ * Check whether all deques are empty.
+ */
+static bool
+hg_engine_empty(struct hg_engine *engine);
+
+/**
+ * Get entry from own deque or steal it from another worker.
+ */
+static struct hg_completion_entry *
+hg_engine_worker_get(struct hg_engine *engine, struct hg_engine_worker *worker);
+
+/**
+ * Worker thread.
+ */
+static HG_THREAD_RETURN_TYPE
+hg_engine_worker_thread(void *arg);
+
+/**
+ * Move completed entries from context to worker deques.
+ */
+static void
+hg_engine_dispatch(struct hg_engine_progress *progress);
+
+/**
+ * Progress thread.
+ */
+static HG_THREAD_RETURN_TYPE
+hg_engine_progress_thread(void *arg);
+
+/**
+ * Stop threads and free engine.
+ */
+static void
+hg_engine_free(struct hg_engine *engine);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_engine_thread_pin(hg_thread_t thread, int cpu)
+{
+    hg_cpu_set_t cpu_set;
+    hg_return_t ret;
+    int rc;
+
+#if defined(_WIN32)
+    HG_CHECK_SUBSYS_ERROR(ctx, cpu >= (int) (8 * sizeof(cpu_set)), error, ret,
+        HG_INVALID_ARG, "Invalid CPU index (%d)", cpu);
+    cpu_set = (hg_cpu_set_t) 1 << cpu;
+#elif defined(__APPLE__)
+    HG_CHECK_SUBSYS_ERROR(ctx, cpu >= HG_CPU_SETSIZE, error, ret,
+        HG_INVALID_ARG, "Invalid CPU index (%d)", cpu);
+    memset(&cpu_set, 0, sizeof(cpu_set));
+    cpu_set.bits[cpu / HG_NCPUBITS] |= (hg_cpu_mask_t) 1
+                                       << (cpu % HG_NCPUBITS);
+#else
+    HG_CHECK_SUBSYS_ERROR(ctx, cpu >= CPU_SETSIZE, error, ret, HG_INVALID_ARG,
+        "Invalid CPU index (%d)", cpu);
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+#endif
+
+    rc = hg_thread_setaffinity(thread, &cpu_set);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret,
+        HG_OPNOTSUPPORTED, "Could not pin thread to CPU %d", cpu);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_engine_deque_push(
+    struct hg_engine_worker *worker, struct hg_completion_entry *entry)
+{
+    unsigned int count;
+    hg_return_t ret;
+
+    hg_thread_spin_lock(&worker->lock);
+
+    count = (unsigned int) hg_atomic_get32(&worker->count);
+    if (count > worker->mask) {
+        struct hg_completion_entry **entries;
+        unsigned int i;
+
+        /* Grow ring, entries are moved back to index 0 */
+        entries = (struct hg_completion_entry **) malloc(
+            2 * count * sizeof(*entries));
+        HG_CHECK_SUBSYS_ERROR(poll, entries == NULL, unlock, ret, HG_NOMEM,
+            "Could not grow worker deque");
+
+        for (i = 0; i < count; i++)
+            entries[i] = worker->entries[(worker->head + i) & worker->mask];
+        free(worker->entries);
+        worker->entries = entries;
+        worker->head = 0;
+        worker->mask = 2 * count - 1;
+    }
+
+    worker->entries[(worker->head + count) & worker->mask] = entry;
+    hg_atomic_set32(&worker->count, (int32_t) count + 1);
+
+    hg_thread_spin_unlock(&worker->lock);
+
+    return HG_SUCCESS;
+
+unlock:
+    hg_thread_spin_unlock(&worker->lock);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static struct hg_completion_entry *
+hg_engine_deque_pop(struct hg_engine_worker *worker)
+{
+    struct hg_completion_entry *entry = NULL;
+    int32_t count;
+
+    /* Avoid taking the lock of empty deques */
+    if (hg_atomic_get32(&worker->count) == 0)
+        return NULL;
+
+    hg_thread_spin_lock(&worker->lock);
+
+    count = hg_atomic_get32(&worker->count);
+    if (count > 0) {
+        entry = worker->entries[(worker->head + (unsigned int) count - 1) &
+                                worker->mask];
+        hg_atomic_set32(&worker->count, count - 1);
+    }
+
+    hg_thread_spin_unlock(&worker->lock);
+
+    return entry;
+}
+
+/*---------------------------------------------------------------------------*/
+static struct hg_completion_entry *
+hg_engine_deque_steal(struct hg_engine_worker *worker)
+{
+    struct hg_completion_entry *entry = NULL;
+    int32_t count;
+
+    /* Avoid taking the lock of empty deques */
+    if (hg_atomic_get32(&worker->count) == 0)
+        return NULL;
+
+    hg_thread_spin_lock(&worker->lock);
+
+    count = hg_atomic_get32(&worker->count);
+    if (count > 0) {
+        entry = worker->entries[worker->head];
+        worker->head = (worker->head + 1) & worker->mask;
+        hg_atomic_set32(&worker->count, count - 1);
+    }
+
+    hg_thread_spin_unlock(&worker->lock);
+
+    return entry;
+}
+
+/*---------------------------------------------------------------------------*/
+static bool
+hg_engine_empty(struct hg_engine *engine)
+{
+    unsigned int i;
+
+    for (i = 0; i < engine->worker_count; i++)
+        if (hg_atomic_get32(&engine->workers[i].count) > 0)
+            return false;
+
+    return true;
+}
+
+/*---------------------------------------------------------------------------*/
+static struct hg_completion_entry *
+hg_engine_worker_get(struct hg_engine *engine, struct hg_engine_worker *worker)
+{
+    struct hg_completion_entry *entry;
+    unsigned int i;
+
+    /* Newest entries are most likely to still be in cache */
+    entry = hg_engine_deque_pop(worker);
+    if (entry != NULL)
+        return entry;
+
+    /* Steal oldest entries so that they do not wait behind newer ones */
+    for (i = 1; i < engine->worker_count; i++) {
+        entry = hg_engine_deque_steal(
+            &engine->workers[(worker->index + i) % engine->worker_count]);
+        if (entry != NULL)
+            return entry;
+    }
+
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+hg_engine_worker_thread(void *arg)
+{
+    struct hg_engine_worker *worker = (struct hg_engine_worker *) arg;
+    struct hg_engine *engine = worker->engine;
+    hg_thread_ret_t tret = (hg_thread_ret_t) 0;
+
+    for (;;) {
+        struct hg_completion_entry *entry;
+        bool stop;
+
+        entry = hg_engine_worker_get(engine, worker);
+        if (entry != NULL) {
+            HG_Core_completion_trigger(entry);
+            continue;
+        }
+
+        /* Sleep until entries are pushed or the engine stops, sleeping
+         * workers must be visible before deques are checked again */
+        hg_thread_mutex_lock(&engine->mutex);
+        hg_atomic_incr32(&engine->sleeping);
+        hg_atomic_fence();
+        while (!engine->worker_stop && hg_engine_empty(engine)) {
+            int rc = hg_thread_cond_wait(&engine->cond, &engine->mutex);
+
+            /* Check deques again rather than leaving entries behind */
+            if (rc != HG_UTIL_SUCCESS) {
+                HG_LOG_SUBSYS_ERROR(poll, "Could not wait on engine condition");
+                break;
+            }
+        }
+        hg_atomic_decr32(&engine->sleeping);
+        stop = engine->worker_stop && hg_engine_empty(engine);
+        hg_thread_mutex_unlock(&engine->mutex);
+
+        /* Remaining entries are always executed before leaving */
+        if (stop)
+            break;
+    }
+
+    return tret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_engine_dispatch(struct hg_engine_progress *progress)
+{
+    struct hg_engine *engine = progress->engine;
+    struct hg_completion_entry *entries[HG_ENGINE_DISPATCH_BATCH];
+    unsigned int count, total = 0;
+
+    do {
+        unsigned int i;
+
+        count = HG_Core_completion_get(progress->context->core_context,
+            HG_ENGINE_DISPATCH_BATCH, entries);
+
+        for (i = 0; i < count; i++) {
+            hg_return_t ret = hg_engine_deque_push(
+                &engine->workers[progress->next_worker], entries[i]);
+
+            /* Entries must not be lost, execute them in place instead */
+            if (ret != HG_SUCCESS)
+                HG_Core_completion_trigger(entries[i]);
+            else
+                total++;
+
+            progress->next_worker =
+                (progress->next_worker + 1) % engine->worker_count;
+        }
+    } while (count == HG_ENGINE_DISPATCH_BATCH);
+
+    if (total == 0)
+        return;
+
+    /* Entries must be visible before sleeping workers are checked */
+    hg_atomic_fence();
+    if (hg_atomic_get32(&engine->sleeping) > 0) {
+        hg_thread_mutex_lock(&engine->mutex);
+        if (total > 1)
+            hg_thread_cond_broadcast(&engine->cond);
+        else
+            hg_thread_cond_signal(&engine->cond);
+        hg_thread_mutex_unlock(&engine->mutex);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+hg_engine_progress_thread(void *arg)
+{
+    struct hg_engine_progress *progress = (struct hg_engine_progress *) arg;
+    struct hg_engine *engine = progress->engine;
+    hg_thread_ret_t tret = (hg_thread_ret_t) 0;
+
+    while (!hg_atomic_get32(&engine->progress_stop)) {
+        hg_return_t ret =
+            HG_Progress(progress->context, engine->progress_timeout);
+        HG_CHECK_SUBSYS_ERROR_NORET(poll,
+            ret != HG_SUCCESS && ret != HG_TIMEOUT, done,
+            "HG_Progress() failed (%s)", HG_Error_to_string(ret));
+
+        hg_engine_dispatch(progress);
+    }
+
+done:
+    /* Hand over entries that completed before stopping */
+    hg_engine_dispatch(progress);
+
+    return tret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_engine_free(struct hg_engine *engine)
+{
+    unsigned int i;
+
+    /* Stop progress first so that no entry is pushed after workers stop */
+    hg_atomic_set32(&engine->progress_stop, 1);
+    for (i = 0; i < engine->progress_thread_count; i++)
+        (void) hg_thread_join(engine->progress[i].thread);
+
+    hg_thread_mutex_lock(&engine->mutex);
+    engine->worker_stop = true;
+    hg_thread_cond_broadcast(&engine->cond);
+    hg_thread_mutex_unlock(&engine->mutex);
+    for (i = 0; i < engine->worker_thread_count; i++)
+        (void) hg_thread_join(engine->workers[i].thread);
+
+    /* Only reached when worker threads could not be created */
+    for (i = 0; i < engine->worker_init_count; i++) {
+        struct hg_completion_entry *entry;
+
+        while ((entry = hg_engine_deque_pop(&engine->workers[i])) != NULL)
+            HG_Core_completion_trigger(entry);
+    }
+
+    for (i = 0; i < engine->worker_init_count; i++) {
+        (void) hg_thread_spin_destroy(&engine->workers[i].lock);
+        free(engine->workers[i].entries);
+    }
+    hg_mem_aligned_free(engine->workers);
+    free(engine->progress);
+
+    (void) hg_thread_cond_destroy(&engine->cond);
+    (void) hg_thread_mutex_destroy(&engine->mutex);
+    free(engine);
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Engine_create(hg_context_t *contexts[], unsigned int context_count,
+    const struct hg_engine_info *engine_info, hg_engine_t **engine_p)
+{
+    struct hg_engine *engine = NULL;
+    unsigned int i;
+    hg_return_t ret;
+    int rc;
+
+    HG_CHECK_SUBSYS_ERROR(ctx, contexts == NULL || context_count == 0, error,
+        ret, HG_INVALID_ARG, "No HG context to progress");
+    HG_CHECK_SUBSYS_ERROR(ctx, engine_p == NULL, error, ret, HG_INVALID_ARG,
+        "NULL pointer to engine");
+    for (i = 0; i < context_count; i++)
+        HG_CHECK_SUBSYS_ERROR(ctx, contexts[i] == NULL, error, ret,
+            HG_INVALID_ARG, "NULL HG context");
+
+    engine = (struct hg_engine *) calloc(1, sizeof(*engine));
+    HG_CHECK_SUBSYS_ERROR(ctx, engine == NULL, error, ret, HG_NOMEM,
+        "Could not allocate engine");
+    engine->worker_count = (engine_info && engine_info->worker_count > 0)
+                               ? engine_info->worker_count
+                               : HG_ENGINE_WORKER_COUNT_DEFAULT;
+    engine->progress_count = context_count;
+    engine->progress_timeout =
+        (engine_info && engine_info->progress_timeout > 0)
+            ? engine_info->progress_timeout
+            : HG_ENGINE_PROGRESS_TIMEOUT_DEFAULT;
+    hg_atomic_init32(&engine->sleeping, 0);
+    hg_atomic_init32(&engine->progress_stop, 0);
+
+    rc = hg_thread_mutex_init(&engine->mutex);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error_free, ret,
+        HG_NOMEM, "hg_thread_mutex_init() failed");
+
+    rc = hg_thread_cond_init(&engine->cond);
+    if (rc != HG_UTIL_SUCCESS) {
+        (void) hg_thread_mutex_destroy(&engine->mutex);
+        HG_GOTO_SUBSYS_ERROR(
+            ctx, error_free, ret, HG_NOMEM, "hg_thread_cond_init() failed");
+    }
+
+    /* Workers */
+    engine->workers = (struct hg_engine_worker *) hg_mem_aligned_alloc(
+        HG_MEM_CACHE_LINE_SIZE,
+        engine->worker_count * sizeof(struct hg_engine_worker));
+    HG_CHECK_SUBSYS_ERROR(ctx, engine->workers == NULL, error_destroy, ret,
+        HG_NOMEM, "Could not allocate engine workers");
+    memset(engine->workers, 0,
+        engine->worker_count * sizeof(struct hg_engine_worker));
+
+    for (i = 0; i < engine->worker_count; i++) {
+        struct hg_engine_worker *worker = &engine->workers[i];
+
+        worker->entries = (struct hg_completion_entry **) malloc(
+            HG_ENGINE_DEQUE_SIZE * sizeof(*worker->entries));
+        HG_CHECK_SUBSYS_ERROR(ctx, worker->entries == NULL, error_destroy,
+            ret, HG_NOMEM, "Could not allocate worker deque");
+        worker->mask = HG_ENGINE_DEQUE_SIZE - 1;
+        hg_atomic_init32(&worker->count, 0);
+        worker->engine = engine;
+        worker->index = i;
+
+        rc = hg_thread_spin_init(&worker->lock);
+        if (rc != HG_UTIL_SUCCESS) {
+            free(worker->entries);
+            HG_GOTO_SUBSYS_ERROR(ctx, error_destroy, ret, HG_NOMEM,
+                "hg_thread_spin_init() failed");
+        }
+        engine->worker_init_count++;
+    }
+
+    /* Progress threads */
+    engine->progress = (struct hg_engine_progress *) calloc(
+        context_count, sizeof(struct hg_engine_progress));
+    HG_CHECK_SUBSYS_ERROR(ctx, engine->progress == NULL, error_destroy, ret,
+        HG_NOMEM, "Could not allocate engine progress threads");
+
+    /* Start workers before progress threads so that entries are consumed */
+    for (i = 0; i < engine->worker_count; i++) {
+        rc = hg_thread_create(&engine->workers[i].thread,
+            hg_engine_worker_thread, &engine->workers[i]);
+        HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error_destroy, ret,
+            HG_NOMEM, "Could not create worker thread");
+        engine->worker_thread_count++;
+
+        if (engine_info && engine_info->worker_cpus &&
+            engine_info->worker_cpus[i] >= 0) {
+            ret = hg_engine_thread_pin(
+                engine->workers[i].thread, engine_info->worker_cpus[i]);
+            HG_CHECK_SUBSYS_HG_ERROR(ctx, error_destroy, ret,
+                "Could not pin worker thread (%s)", HG_Error_to_string(ret));
+        }
+    }
+
+    for (i = 0; i < context_count; i++) {
+        struct hg_engine_progress *progress = &engine->progress[i];
+
+        progress->engine = engine;
+        progress->context = contexts[i];
+        progress->next_worker = i % engine->worker_count;
+
+        rc = hg_thread_create(
+            &progress->thread, hg_engine_progress_thread, progress);
+        HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error_destroy, ret,
+            HG_NOMEM, "Could not create progress thread");
+        engine->progress_thread_count++;
+
+        if (engine_info && engine_info->progress_cpus &&
+            engine_info->progress_cpus[i] >= 0) {
+            ret = hg_engine_thread_pin(
+                progress->thread, engine_info->progress_cpus[i]);
+            HG_CHECK_SUBSYS_HG_ERROR(ctx, error_destroy, ret,
+                "Could not pin progress thread (%s)", HG_Error_to_string(ret));
+        }
+    }
+
+    *engine_p = engine;
+
+    return HG_SUCCESS;
+
+error_destroy:
+    hg_engine_free(engine);
+
+    return ret;
+
+error_free:
+    free(engine);
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Engine_destroy(hg_engine_t *engine)
+{
+    hg_return_t ret = HG_SUCCESS;
+
+    HG_CHECK_SUBSYS_ERROR(
+        ctx, engine == NULL, done, ret, HG_INVALID_ARG, "NULL engine");
+
+    hg_engine_free(engine);
+
+done:
+    return ret;
+}
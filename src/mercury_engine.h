@@ -0,0 +1,112 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MERCURY_ENGINE_H
+#define MERCURY_ENGINE_H
+
+#include "mercury_types.h"
+
+/*************************************/
+/* Public Type and Struct Definition */
+/*************************************/
+
+typedef struct hg_engine hg_engine_t; /* Opaque HG engine */
+
+/**
+ * HG engine info struct
+ * NB. should be initialized using HG_ENGINE_INFO_INITIALIZER
+ */
+struct hg_engine_info {
+    /* Number of worker threads that execute callbacks. A value of zero is
+     * equivalent to using the internal default value.
+     * Default value is: 1 */
+    unsigned int worker_count;
+
+    /* Maximum time (in milliseconds) that a progress thread blocks before
+     * checking whether the engine is being destroyed, this bounds the time
+     * it takes to destroy the engine. A value of zero is equivalent to using
+     * the internal default value.
+     * Default value is: 100 */
+    unsigned int progress_timeout;
+
+    /* Optional array of context_count CPU indices that progress threads are
+     * pinned to (in the same order as contexts), a negative index leaves the
+     * corresponding thread unpinned.
+     * Default is: NULL (no pinning) */
+    const int *progress_cpus;
+
+    /* Optional array of worker_count CPU indices that worker threads are
+     * pinned to, a negative index leaves the corresponding thread unpinned.
+     * Default is: NULL (no pinning) */
+    const int *worker_cpus;
+};
+
+/*****************/
+/* Public Macros */
+/*****************/
+
+/* HG engine info initializer */
+#define HG_ENGINE_INFO_INITIALIZER                                             \
+    (struct hg_engine_info)                                                    \
+    {                                                                          \
+        .worker_count = 0, .progress_timeout = 0, .progress_cpus = NULL,       \
+        .worker_cpus = NULL                                                    \
+    }
+
+/*********************/
+/* Public Prototypes */
+/*********************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Create an engine that drives the progress of a set of contexts and executes
+ * their callbacks. One progress thread is created per context, it makes
+ * progress on that context and distributes completed operations to a pool of
+ * worker threads that execute their callbacks (including RPC callbacks).
+ * Each worker has its own deque, it executes the most recently distributed
+ * operations first while idle workers steal the oldest operations of other
+ * workers. Callbacks can therefore be executed concurrently and in a
+ * different order than they completed, with a single worker the oldest
+ * operations are only executed once newer ones have been executed.
+ *
+ * \remark Contexts remain owned by the caller and must not be progressed or
+ * triggered by the caller, nor destroyed, until the engine is destroyed.
+ *
+ * \param contexts [IN]         array of pointers to HG contexts
+ * \param context_count [IN]    number of contexts
+ * \param engine_info [IN]      (Optional) engine info, NULL for defaults
+ * \param engine_p [OUT]        pointer to returned engine
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Engine_create(hg_context_t *contexts[], unsigned int context_count,
+    const struct hg_engine_info *engine_info, hg_engine_t **engine_p);
+
+/**
+ * Stop and destroy an engine. Progress threads are stopped first, callbacks of
+ * operations that have already completed are then executed before worker
+ * threads exit.
+ *
+ * \remark Operations that have not completed yet are left to the caller,
+ * which must progress and trigger contexts to complete them.
+ *
+ * \param engine [IN/OUT]       pointer to engine
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Engine_destroy(hg_engine_t *engine);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MERCURY_ENGINE_H */
@@ -62,11 +62,12 @@ struct hg_completion_entry {
         hg_core_handle_t hg_core_handle;
         struct hg_bulk_op_id *hg_bulk_op_id;
     } op_id;
-    STAILQ_ENTRY(hg_completion_entry) entry;
+    STAILQ_ENTRY(hg_completion_entry) entry; /* Overflow list entry */
     hg_op_type_t op_type;
 };
 
 struct hg_bulk_op_pool;
+struct hg_cb_event;
 
 /*****************/
 /* Public Macros */
@@ -120,6 +121,12 @@ hg_core_bulk_incr(hg_core_class_t *hg_core_class);
 HG_PRIVATE void
 hg_core_bulk_decr(hg_core_class_t *hg_core_class);
 
+/**
+ * Take reference to address, released with HG_Core_addr_free().
+ */
+HG_PRIVATE void
+hg_core_addr_ref_incr(struct hg_core_addr *core_addr);
+
 /**
  * Get bulk op pool.
  */
@@ -133,12 +140,32 @@ HG_PRIVATE void
 hg_core_completion_add(struct hg_core_context *core_context,
     struct hg_completion_entry *hg_completion_entry, bool loopback_notify);
 
+/**
+ * Account for a completed bulk transfer in context stats.
+ */
+HG_PRIVATE void
+hg_core_stats_bulk(
+    struct hg_core_context *core_context, hg_size_t size, bool self);
+
 /**
  * Trigger callback from bulk op ID.
  */
 HG_PRIVATE void
 hg_bulk_trigger_entry(struct hg_bulk_op_id *hg_bulk_op_id);
 
+/**
+ * Fill completion event from bulk op ID.
+ */
+HG_PRIVATE void
+hg_bulk_get_event(
+    struct hg_bulk_op_id *hg_bulk_op_id, struct hg_cb_event *hg_cb_event);
+
+/**
+ * Release bulk op ID once its completion has been processed.
+ */
+HG_PRIVATE void
+hg_bulk_release_entry(struct hg_bulk_op_id *hg_bulk_op_id);
+
 /**
  * Create pool of bulk op IDs.
  */
@@ -152,6 +179,13 @@ hg_bulk_op_pool_create(hg_core_context_t *core_context, unsigned int init_count,
 HG_PRIVATE void
 hg_bulk_op_pool_destroy(struct hg_bulk_op_pool *hg_bulk_op_pool);
 
+/**
+ * Cancel bulk op IDs of pool that target address.
+ */
+HG_PRIVATE hg_return_t
+hg_bulk_op_pool_cancel_addr(
+    struct hg_bulk_op_pool *hg_bulk_op_pool, const struct hg_core_addr *addr);
+
 /*---------------------------------------------------------------------------*/
 static HG_INLINE void
 hg_init_info_dup_2_3(
@@ -172,7 +206,16 @@ hg_init_info_dup_2_3(
         .traffic_class = NA_TC_UNSPEC,
         .no_overflow = false,
         .multi_recv_op_max = 0,
-        .multi_recv_copy_threshold = 0};
+        .multi_recv_copy_threshold = 0,
+        .completion_queue_size = 0,
+        .progress_spin_max = 0,
+        .coalesce_requests = false,
+        .coalesce_responses = false,
+        .request_max = 0,
+        .multi_recv_adaptive = false,
+        .hugepage_arena = false,
+        .request_trim_time = 0,
+        .trace_file = NULL};
 }
 
 /*---------------------------------------------------------------------------*/
@@ -195,7 +238,16 @@ hg_init_info_dup_2_2(
         .traffic_class = NA_TC_UNSPEC,
         .no_overflow = false,
         .multi_recv_op_max = 0,
-        .multi_recv_copy_threshold = 0};
+        .multi_recv_copy_threshold = 0,
+        .completion_queue_size = 0,
+        .progress_spin_max = 0,
+        .coalesce_requests = false,
+        .coalesce_responses = false,
+        .request_max = 0,
+        .multi_recv_adaptive = false,
+        .hugepage_arena = false,
+        .request_trim_time = 0,
+        .trace_file = NULL};
 }
 
 #ifdef __cplusplus
@@ -90,6 +90,13 @@ struct hg_cb_info {
 typedef hg_return_t (*hg_rpc_cb_t)(hg_handle_t handle);
 typedef hg_return_t (*hg_cb_t)(const struct hg_cb_info *callback_info);
 
+/* Completion event (see HG_Trigger_events()) */
+struct hg_cb_event {
+    hg_cb_t callback;       /* Callback attached to the operation */
+    struct hg_cb_info info; /* Callback info */
+    hg_op_id_t op_id;       /* Operation ID (bulk operations only) */
+};
+
 /* Proc callback for serializing/deserializing parameters */
 typedef hg_return_t (*hg_proc_cb_t)(hg_proc_t proc, void *data);
 
@@ -1457,9 +1457,22 @@ NA_Msg_buf_alloc(na_class_t *na_class, size_t buf_size, unsigned long flags,
     } else {
         size_t page_size = (size_t) hg_mem_get_page_size();
 
+        /* Transparent hugepages are used when available, buffers must then
+         * be aligned and sized to hugepage boundaries */
+        if (flags & NA_HUGE) {
+            size_t huge_page_size = (size_t) hg_mem_get_hugepage_size();
+
+            if (huge_page_size > page_size) {
+                page_size = huge_page_size;
+                buf_size = (buf_size + page_size - 1) & ~(page_size - 1);
+            }
+        }
+
         ret = hg_mem_aligned_alloc(page_size, buf_size);
         NA_CHECK_SUBSYS_ERROR_NORET(msg, ret == NULL, error,
             "Could not allocate buffer of size %zu", buf_size);
+        if (flags & NA_HUGE)
+            (void) hg_mem_huge_advise(ret, buf_size);
         memset(ret, 0, buf_size);
         *plugin_data_p = (void *) 1; /* Sanity check on free */
     }
@@ -5653,7 +5653,7 @@ na_ofi_mem_alloc(struct na_ofi_class *na_ofi_class, size_t size,
 
 #if !defined(_WIN32) && !defined(__APPLE__)
     page_size = (size_t) hg_mem_get_hugepage_size();
-    if (page_size > 0 && size >= page_size) {
+    if (page_size > 0 && (size >= page_size || (*flags_p & NA_HUGE))) {
         /* Allocate a multiple of page size (TODO use extra space) */
         alloc_size = ((size % page_size) == 0)
                          ? size
@@ -8236,8 +8236,8 @@ na_ofi_msg_buf_alloc(
         "Could not allocate msg_buf_handle");
     msg_buf_handle->flags = flags;
 
-    /* Multi-recv buffers do not need to use the memory pool */
-    if (flags & NA_MULTI_RECV) {
+    /* Multi-recv and hugepage buffers do not need to use the memory pool */
+    if (flags & (NA_MULTI_RECV | NA_HUGE)) {
         mem_ptr = na_ofi_mem_alloc(na_ofi_class, size, &msg_buf_handle->flags,
             &msg_buf_handle->alloc_size, &msg_buf_handle->fi_mr);
         NA_CHECK_SUBSYS_ERROR_NORET(mem, mem_ptr == NULL, error,
@@ -8277,7 +8277,7 @@ na_ofi_msg_buf_free(na_class_t *na_class, void *buf, void *plugin_data)
     struct na_ofi_msg_buf_handle *msg_buf_handle =
         (struct na_ofi_msg_buf_handle *) plugin_data;
 
-    if (msg_buf_handle->flags & NA_MULTI_RECV) {
+    if (msg_buf_handle->flags & (NA_MULTI_RECV | NA_HUGE)) {
         na_ofi_mem_free(na_ofi_class, buf, msg_buf_handle->alloc_size,
             msg_buf_handle->flags, msg_buf_handle->fi_mr);
     } else {
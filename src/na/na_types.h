@@ -232,7 +232,8 @@ typedef void (*na_cb_t)(const struct na_cb_info *callback_info);
 #define NA_SEND       (1 << 0)
 #define NA_RECV       (1 << 1)
 #define NA_MULTI_RECV (1 << 2)
-#define NA_ALLOC_MAX  (1 << 3) /* Maximum flag value */
+#define NA_HUGE       (1 << 3) /* Use hugepages if available */
+#define NA_ALLOC_MAX  (1 << 4) /* Maximum flag value */
 
 /* Op ID creation flags */
 #define NA_OP_SINGLE 0x00
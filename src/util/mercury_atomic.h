@@ -44,6 +44,7 @@ using std::atomic_thread_fence;
 using std::memory_order_acq_rel;
 using std::memory_order_acquire;
 using std::memory_order_release;
+using std::memory_order_seq_cst;
 #    endif
 #    if (__STDC_VERSION__ >= 201710L ||                                        \
          (defined(__cplusplus) && __cplusplus >= 202002L))
@@ -267,7 +268,7 @@ hg_atomic_cas64(
     hg_atomic_int64_t *ptr, int64_t compare_value, int64_t swap_value);
 
 /**
- * Memory barrier.
+ * Full memory barrier (also orders prior stores with subsequent loads).
  *
  */
 static HG_UTIL_INLINE void
@@ -602,11 +603,11 @@ hg_atomic_fence(void)
 #if defined(_WIN32)
     MemoryBarrier();
 #elif defined(HG_UTIL_HAS_STDATOMIC_H)
-    atomic_thread_fence(memory_order_acq_rel);
+    atomic_thread_fence(memory_order_seq_cst);
 #elif defined(__APPLE__)
     OSMemoryBarrier();
 #else
-    __atomic_thread_fence(__ATOMIC_ACQ_REL);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
 #endif
 }
 
@@ -40,11 +40,39 @@
 #include "mercury_util_error.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 /****************/
 /* Local Macros */
 /****************/
 
+/* Max size of a single segment */
+#define HG_ATOMIC_QUEUE_SEG_SIZE_MAX (1 << 20)
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+/**
+ * Allocate a new segment.
+ */
+static struct hg_atomic_queue_seg *
+hg_atomic_queue_seg_alloc(unsigned int count);
+
+/**
+ * Get a segment from the free list or allocate a new one.
+ */
+static struct hg_atomic_queue_seg *
+hg_atomic_seg_queue_seg_get(
+    struct hg_atomic_seg_queue *hg_atomic_seg_queue, unsigned int *idx_p);
+
+/**
+ * Return segment to the free list.
+ */
+static void
+hg_atomic_seg_queue_seg_put(struct hg_atomic_seg_queue *hg_atomic_seg_queue,
+    struct hg_atomic_queue_seg *seg);
+
 /*---------------------------------------------------------------------------*/
 struct hg_atomic_queue *
 hg_atomic_queue_alloc(unsigned int count)
@@ -76,3 +104,275 @@ hg_atomic_queue_free(struct hg_atomic_queue *hg_atomic_queue)
 {
     hg_mem_aligned_free(hg_atomic_queue);
 }
+
+/*---------------------------------------------------------------------------*/
+static struct hg_atomic_queue_seg *
+hg_atomic_queue_seg_alloc(unsigned int count)
+{
+    struct hg_atomic_queue_seg *seg = NULL;
+
+    seg = hg_mem_aligned_alloc(HG_MEM_CACHE_LINE_SIZE,
+        sizeof(struct hg_atomic_queue_seg) + count * sizeof(hg_atomic_int64_t));
+    HG_UTIL_CHECK_ERROR_NORET(
+        seg == NULL, done, "Could not allocate atomic queue segment");
+
+    seg->mask = count - 1;
+    /* Segments are closed until they get linked */
+    hg_atomic_init32(&seg->prod_head, HG_ATOMIC_QUEUE_SEG_CLOSED);
+    hg_atomic_init32(&seg->prod_tail, 0);
+    hg_atomic_init64(&seg->cons_head, HG_ATOMIC_SEG_QUEUE_REF(0, 0));
+    hg_atomic_init32(&seg->cons_tail, 0);
+    hg_atomic_init64(&seg->next, HG_ATOMIC_SEG_QUEUE_REF(0, 0));
+    seg->free_next = NULL;
+
+done:
+    return seg;
+}
+
+/*---------------------------------------------------------------------------*/
+static struct hg_atomic_queue_seg *
+hg_atomic_seg_queue_seg_get(
+    struct hg_atomic_seg_queue *hg_atomic_seg_queue, unsigned int *idx_p)
+{
+    struct hg_atomic_queue_seg *seg = NULL;
+    unsigned int i;
+
+    hg_thread_spin_lock(&hg_atomic_seg_queue->lock);
+
+    seg = hg_atomic_seg_queue->free_list;
+    if (seg != NULL) {
+        hg_atomic_seg_queue->free_list = seg->free_next;
+        seg->free_next = NULL;
+        for (i = 0; i < hg_atomic_seg_queue->seg_count; i++)
+            if (hg_atomic_seg_queue->segs[i] == seg)
+                break;
+        *idx_p = i;
+    } else if (hg_atomic_seg_queue->seg_count < HG_ATOMIC_SEG_QUEUE_MAX) {
+        unsigned int seg_size = hg_atomic_seg_queue->seg_size;
+
+        /* Double segment size up to max */
+        if (seg_size < HG_ATOMIC_QUEUE_SEG_SIZE_MAX)
+            seg_size *= 2;
+
+        seg = hg_atomic_queue_seg_alloc(seg_size);
+        if (seg != NULL) {
+            hg_atomic_seg_queue->seg_size = seg_size;
+            *idx_p = hg_atomic_seg_queue->seg_count;
+            hg_atomic_seg_queue->segs[hg_atomic_seg_queue->seg_count++] = seg;
+        }
+    }
+
+    hg_thread_spin_unlock(&hg_atomic_seg_queue->lock);
+
+    return seg;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_atomic_seg_queue_seg_put(struct hg_atomic_seg_queue *hg_atomic_seg_queue,
+    struct hg_atomic_queue_seg *seg)
+{
+    hg_thread_spin_lock(&hg_atomic_seg_queue->lock);
+    seg->free_next = hg_atomic_seg_queue->free_list;
+    hg_atomic_seg_queue->free_list = seg;
+    hg_thread_spin_unlock(&hg_atomic_seg_queue->lock);
+}
+
+/*---------------------------------------------------------------------------*/
+struct hg_atomic_seg_queue *
+hg_atomic_seg_queue_alloc(unsigned int count)
+{
+    struct hg_atomic_seg_queue *hg_atomic_seg_queue = NULL;
+    struct hg_atomic_queue_seg *seg;
+
+    HG_UTIL_CHECK_ERROR_NORET(!powerof2(count) || count < 2 ||
+                                  count > HG_ATOMIC_QUEUE_SEG_SIZE_MAX,
+        error, "atomic queue size must be power of 2 (max %d)",
+        HG_ATOMIC_QUEUE_SEG_SIZE_MAX);
+
+    hg_atomic_seg_queue = hg_mem_aligned_alloc(
+        HG_MEM_CACHE_LINE_SIZE, sizeof(struct hg_atomic_seg_queue));
+    HG_UTIL_CHECK_ERROR_NORET(hg_atomic_seg_queue == NULL, error,
+        "Could not allocate atomic queue");
+    memset(hg_atomic_seg_queue, 0, sizeof(struct hg_atomic_seg_queue));
+    hg_thread_spin_init(&hg_atomic_seg_queue->lock);
+
+    seg = hg_atomic_queue_seg_alloc(count);
+    HG_UTIL_CHECK_ERROR_NORET(seg == NULL, error, "Could not allocate segment");
+    hg_atomic_set32(&seg->prod_head, 0); /* Open first segment */
+
+    hg_atomic_seg_queue->segs[0] = seg;
+    hg_atomic_seg_queue->seg_count = 1;
+    hg_atomic_seg_queue->seg_size = count;
+    hg_atomic_init64(&hg_atomic_seg_queue->head, HG_ATOMIC_SEG_QUEUE_REF(0, 0));
+    hg_atomic_init64(&hg_atomic_seg_queue->tail, HG_ATOMIC_SEG_QUEUE_REF(0, 0));
+
+    return hg_atomic_seg_queue;
+
+error:
+    hg_atomic_seg_queue_free(hg_atomic_seg_queue);
+
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_atomic_seg_queue_free(struct hg_atomic_seg_queue *hg_atomic_seg_queue)
+{
+    unsigned int i;
+
+    if (hg_atomic_seg_queue == NULL)
+        return;
+
+    for (i = 0; i < hg_atomic_seg_queue->seg_count; i++)
+        hg_mem_aligned_free(hg_atomic_seg_queue->segs[i]);
+    hg_thread_spin_destroy(&hg_atomic_seg_queue->lock);
+    hg_mem_aligned_free(hg_atomic_seg_queue);
+}
+
+/*---------------------------------------------------------------------------*/
+int
+hg_atomic_seg_queue_extend(
+    struct hg_atomic_seg_queue *hg_atomic_seg_queue, int64_t tail)
+{
+    struct hg_atomic_queue_seg *seg =
+        hg_atomic_seg_queue->segs[HG_ATOMIC_SEG_QUEUE_IDX(tail)];
+    struct hg_atomic_queue_seg *new_seg;
+    unsigned int new_idx = 0;
+    int64_t next;
+
+    /* Tail must still reference seg so that next belongs to the same
+     * generation of that segment */
+    next = hg_atomic_get64(&seg->next);
+    if (hg_atomic_get64(&hg_atomic_seg_queue->tail) != tail)
+        return HG_UTIL_SUCCESS;
+
+    /* Another producer already linked a new segment, help moving tail */
+    if (HG_ATOMIC_SEG_QUEUE_IDX(next) != 0) {
+        (void) hg_atomic_cas64(&hg_atomic_seg_queue->tail, tail,
+            HG_ATOMIC_SEG_QUEUE_REF(HG_ATOMIC_SEG_QUEUE_GEN(tail) + 1,
+                HG_ATOMIC_SEG_QUEUE_IDX(next) - 1));
+        return HG_UTIL_SUCCESS;
+    }
+
+    new_seg = hg_atomic_seg_queue_seg_get(hg_atomic_seg_queue, &new_idx);
+    HG_UTIL_CHECK_ERROR_NORET(new_seg == NULL, error,
+        "Could not get new atomic queue segment (%u segments in use)",
+        hg_atomic_seg_queue->seg_count);
+
+    /* Producers that may still reference that segment must wait until it is
+     * either linked or put back */
+    hg_atomic_or32(&new_seg->prod_head, HG_ATOMIC_QUEUE_SEG_PENDING);
+
+    /* Segment is consumed once head has moved past as many segments as tail,
+     * consumers that still reference a previous use of it now fail */
+    hg_atomic_set64(&new_seg->cons_head,
+        HG_ATOMIC_SEG_QUEUE_REF(HG_ATOMIC_SEG_QUEUE_GEN(tail) + 1,
+            HG_ATOMIC_SEG_QUEUE_IDX(hg_atomic_get64(&new_seg->cons_head))));
+    if (!hg_atomic_cas64(&seg->next, next,
+            HG_ATOMIC_SEG_QUEUE_REF(
+                HG_ATOMIC_SEG_QUEUE_GEN(next), new_idx + 1))) {
+        hg_atomic_and32(&new_seg->prod_head, ~HG_ATOMIC_QUEUE_SEG_PENDING);
+        hg_atomic_seg_queue_seg_put(hg_atomic_seg_queue, new_seg);
+        return HG_UTIL_SUCCESS;
+    }
+
+    /* Open segment now that it is linked */
+    hg_atomic_and32(&new_seg->prod_head, ~HG_ATOMIC_QUEUE_SEG_STATE);
+    (void) hg_atomic_cas64(&hg_atomic_seg_queue->tail, tail,
+        HG_ATOMIC_SEG_QUEUE_REF(HG_ATOMIC_SEG_QUEUE_GEN(tail) + 1, new_idx));
+
+    return HG_UTIL_SUCCESS;
+
+error:
+    return HG_UTIL_FAIL;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+hg_atomic_seg_queue_advance(
+    struct hg_atomic_seg_queue *hg_atomic_seg_queue, int64_t head)
+{
+    struct hg_atomic_queue_seg *seg =
+        hg_atomic_seg_queue->segs[HG_ATOMIC_SEG_QUEUE_IDX(head)];
+    int32_t prod_head, pos;
+    int64_t next, tail;
+
+    prod_head = hg_atomic_get32(&seg->prod_head);
+    if ((prod_head & HG_ATOMIC_QUEUE_SEG_STATE) != HG_ATOMIC_QUEUE_SEG_CLOSED)
+        return HG_UTIL_FAIL;
+    pos = prod_head & ~HG_ATOMIC_QUEUE_SEG_STATE;
+
+    /* Segment is closed but next one is not linked yet */
+    next = hg_atomic_get64(&seg->next);
+    if (HG_ATOMIC_SEG_QUEUE_IDX(next) == 0)
+        return HG_UTIL_FAIL;
+
+    /* Wait for pending enqueues / dequeues on that segment to complete */
+    if (hg_atomic_get32(&seg->prod_tail) != pos ||
+        hg_atomic_get32(&seg->cons_tail) != pos) {
+        cpu_spinwait();
+        return HG_UTIL_SUCCESS;
+    }
+
+    /* Head must still reference seg so that values read above belong to the
+     * same generation of that segment */
+    tail = hg_atomic_get64(&hg_atomic_seg_queue->tail);
+    if (hg_atomic_get64(&hg_atomic_seg_queue->head) != head)
+        return HG_UTIL_SUCCESS;
+
+    /* Segment cannot be recycled while tail still references it */
+    if (HG_ATOMIC_SEG_QUEUE_IDX(tail) == HG_ATOMIC_SEG_QUEUE_IDX(head)) {
+        (void) hg_atomic_cas64(&hg_atomic_seg_queue->tail, tail,
+            HG_ATOMIC_SEG_QUEUE_REF(HG_ATOMIC_SEG_QUEUE_GEN(tail) + 1,
+                HG_ATOMIC_SEG_QUEUE_IDX(next) - 1));
+        return HG_UTIL_SUCCESS;
+    }
+
+    if (!hg_atomic_cas64(&hg_atomic_seg_queue->head, head,
+            HG_ATOMIC_SEG_QUEUE_REF(HG_ATOMIC_SEG_QUEUE_GEN(head) + 1,
+                HG_ATOMIC_SEG_QUEUE_IDX(next) - 1)))
+        return HG_UTIL_SUCCESS;
+
+    /* Bump generation so that stale references to seg can no longer link
+     * segments after it, then recycle it */
+    hg_atomic_set64(&seg->next,
+        HG_ATOMIC_SEG_QUEUE_REF(HG_ATOMIC_SEG_QUEUE_GEN(next) + 1, 0));
+    hg_atomic_seg_queue_seg_put(hg_atomic_seg_queue, seg);
+
+    return HG_UTIL_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+unsigned int
+hg_atomic_seg_queue_pop_n(struct hg_atomic_seg_queue *hg_atomic_seg_queue,
+    void **entries, unsigned int max_count)
+{
+    unsigned int count = 0;
+
+    while (count < max_count) {
+        int64_t head = hg_atomic_get64(&hg_atomic_seg_queue->head);
+        struct hg_atomic_queue_seg *seg =
+            hg_atomic_seg_queue->segs[HG_ATOMIC_SEG_QUEUE_IDX(head)];
+
+        count += hg_atomic_queue_seg_pop_n(seg, HG_ATOMIC_SEG_QUEUE_GEN(head),
+            entries + count, max_count - count);
+        if (count == max_count)
+            break;
+
+        /* Head moved, seg may have been recycled */
+        if (hg_atomic_get64(&hg_atomic_seg_queue->head) != head)
+            continue;
+
+        /* Only a closed segment can be followed by another one */
+        if ((hg_atomic_get32(&seg->prod_head) & HG_ATOMIC_QUEUE_SEG_STATE) !=
+            HG_ATOMIC_QUEUE_SEG_CLOSED)
+            break;
+
+        if (hg_atomic_seg_queue_advance(hg_atomic_seg_queue, head) !=
+            HG_UTIL_SUCCESS)
+            break;
+    }
+
+    return count;
+}
@@ -40,6 +40,7 @@
 
 #include "mercury_atomic.h"
 #include "mercury_mem.h"
+#include "mercury_thread_spin.h"
 
 /* For busy loop spinning */
 #ifndef cpu_spinwait
@@ -75,10 +76,54 @@ struct hg_atomic_queue {
     HG_UTIL_ALIGNED(hg_atomic_int64_t ring[], HG_MEM_CACHE_LINE_SIZE);
 };
 
+/* Max number of segments that a segmented queue can use */
+#define HG_ATOMIC_SEG_QUEUE_MAX (32)
+
+/* Segment of a segmented queue. Segments are closed once full and recycled
+ * once drained, segment state is kept in the upper bits of prod_head. The
+ * consumer head is tagged with the generation of the queue head at which the
+ * segment is consumed so that stale consumers cannot pop from a segment that
+ * was recycled. */
+struct hg_atomic_queue_seg {
+    hg_atomic_int32_t prod_head;
+    hg_atomic_int32_t prod_tail;
+    unsigned int mask;
+    hg_atomic_int64_t next; /* Next segment (generation | index + 1) */
+    HG_UTIL_ALIGNED(hg_atomic_int64_t cons_head, HG_MEM_CACHE_LINE_SIZE);
+    hg_atomic_int32_t cons_tail;
+    struct hg_atomic_queue_seg *free_next; /* Next in free list */
+    HG_UTIL_ALIGNED(hg_atomic_int64_t ring[], HG_MEM_CACHE_LINE_SIZE);
+};
+
+/* Segmented queue that grows by linking new segments when full */
+struct hg_atomic_seg_queue {
+    hg_atomic_int64_t tail; /* Producer segment (generation | index) */
+    HG_UTIL_ALIGNED(hg_atomic_int64_t head, HG_MEM_CACHE_LINE_SIZE);
+    HG_UTIL_ALIGNED(struct hg_atomic_queue_seg *segs[HG_ATOMIC_SEG_QUEUE_MAX],
+        HG_MEM_CACHE_LINE_SIZE);
+    HG_UTIL_ALIGNED(hg_thread_spin_t lock, HG_MEM_CACHE_LINE_SIZE);
+    struct hg_atomic_queue_seg *free_list; /* Drained segments */
+    unsigned int seg_count;                /* Number of allocated segments */
+    unsigned int seg_size;                 /* Size of last segment */
+};
+
 /*****************/
 /* Public Macros */
 /*****************/
 
+/* Segment state */
+#define HG_ATOMIC_QUEUE_SEG_CLOSED  (1 << 30)
+#define HG_ATOMIC_QUEUE_SEG_PENDING (1 << 29)
+#define HG_ATOMIC_QUEUE_SEG_STATE                                              \
+    (HG_ATOMIC_QUEUE_SEG_CLOSED | HG_ATOMIC_QUEUE_SEG_PENDING)
+
+/* Segment references are tagged with a generation to prevent ABA issues */
+#define HG_ATOMIC_SEG_QUEUE_REF(gen, idx)                                      \
+    ((int64_t) (((uint64_t) (gen) << 32) | (uint64_t) (idx)))
+#define HG_ATOMIC_SEG_QUEUE_GEN(ref) ((uint32_t) ((uint64_t) (ref) >> 32))
+#define HG_ATOMIC_SEG_QUEUE_IDX(ref)                                           \
+    ((unsigned int) ((uint64_t) (ref) & 0xffffffff))
+
 /*********************/
 /* Public Prototypes */
 /*********************/
@@ -126,6 +171,20 @@ hg_atomic_queue_push(struct hg_atomic_queue *hg_atomic_queue, void *entry);
 static HG_UTIL_INLINE void *
 hg_atomic_queue_pop_mc(struct hg_atomic_queue *hg_atomic_queue);
 
+/**
+ * Pop up to \max_count entries from the queue in a single step
+ * (multi-consumer). Entries are returned in FIFO order.
+ *
+ * \param hg_atomic_queue [IN/OUT]  pointer to queue
+ * \param entries [OUT]             array of popped objects
+ * \param max_count [IN]            maximum number of entries to pop
+ *
+ * \return Number of entries popped or 0 if queue is empty
+ */
+static HG_UTIL_INLINE unsigned int
+hg_atomic_queue_pop_mc_n(struct hg_atomic_queue *hg_atomic_queue,
+    void **entries, unsigned int max_count);
+
 /**
  * Pop an entry from the queue (single consumer).
  *
@@ -156,6 +215,122 @@ hg_atomic_queue_is_empty(const struct hg_atomic_queue *hg_atomic_queue);
 static HG_UTIL_INLINE unsigned int
 hg_atomic_queue_count(const struct hg_atomic_queue *hg_atomic_queue);
 
+/**
+ * Allocate a new segmented queue. The queue initially holds \count elements
+ * and grows by linking additional segments when it becomes full.
+ *
+ * \param count [IN]                initial number of elements
+ *
+ * \return pointer to allocated queue or NULL on failure
+ */
+HG_UTIL_PUBLIC struct hg_atomic_seg_queue *
+hg_atomic_seg_queue_alloc(unsigned int count);
+
+/**
+ * Free an existing segmented queue.
+ *
+ * \param hg_atomic_seg_queue [IN]  pointer to queue
+ */
+HG_UTIL_PUBLIC void
+hg_atomic_seg_queue_free(struct hg_atomic_seg_queue *hg_atomic_seg_queue);
+
+/**
+ * Link a new segment after the tail segment referenced by \tail (slow path
+ * of hg_atomic_seg_queue_push()).
+ *
+ * \param hg_atomic_seg_queue [IN/OUT] pointer to queue
+ * \param tail [IN]                    tail reference that was observed
+ *
+ * \return Non-negative on success or negative on failure
+ */
+HG_UTIL_PUBLIC int
+hg_atomic_seg_queue_extend(
+    struct hg_atomic_seg_queue *hg_atomic_seg_queue, int64_t tail);
+
+/**
+ * Move past the closed head segment referenced by \head and recycle it
+ * (slow path of hg_atomic_seg_queue_pop()).
+ *
+ * \param hg_atomic_seg_queue [IN/OUT] pointer to queue
+ * \param head [IN]                    head reference that was observed
+ *
+ * \return Non-negative if pop should be retried or negative if queue is empty
+ */
+HG_UTIL_PUBLIC int
+hg_atomic_seg_queue_advance(
+    struct hg_atomic_seg_queue *hg_atomic_seg_queue, int64_t head);
+
+/**
+ * Push an entry to the segmented queue.
+ *
+ * \param hg_atomic_seg_queue [IN/OUT] pointer to queue
+ * \param entry [IN]                   pointer to object
+ *
+ * \return Non-negative on success or negative on failure
+ */
+static HG_UTIL_INLINE int
+hg_atomic_seg_queue_push(
+    struct hg_atomic_seg_queue *hg_atomic_seg_queue, void *entry);
+
+/**
+ * Pop an entry from the segmented queue (multi-consumer).
+ *
+ * \param hg_atomic_seg_queue [IN/OUT] pointer to queue
+ *
+ * \return Pointer to popped object or NULL if queue is empty
+ */
+static HG_UTIL_INLINE void *
+hg_atomic_seg_queue_pop(struct hg_atomic_seg_queue *hg_atomic_seg_queue);
+
+/**
+ * Pop up to \max_count entries from the segmented queue (multi-consumer).
+ * Entries of a same segment are claimed in a single step and are returned in
+ * FIFO order.
+ *
+ * \param hg_atomic_seg_queue [IN/OUT] pointer to queue
+ * \param entries [OUT]                array of popped objects
+ * \param max_count [IN]               maximum number of entries to pop
+ *
+ * \return Number of entries popped or 0 if queue is empty
+ */
+HG_UTIL_PUBLIC unsigned int
+hg_atomic_seg_queue_pop_n(struct hg_atomic_seg_queue *hg_atomic_seg_queue,
+    void **entries, unsigned int max_count);
+
+/**
+ * Determine whether segmented queue is empty.
+ *
+ * \param hg_atomic_seg_queue [IN/OUT] pointer to queue
+ *
+ * \return true if empty, false if not
+ */
+static HG_UTIL_INLINE bool
+hg_atomic_seg_queue_is_empty(
+    const struct hg_atomic_seg_queue *hg_atomic_seg_queue);
+
+/**
+ * Determine number of entries in a segmented queue.
+ *
+ * \param hg_atomic_seg_queue [IN/OUT] pointer to queue
+ *
+ * \return Number of entries queued or 0 if none
+ */
+static HG_UTIL_INLINE unsigned int
+hg_atomic_seg_queue_count(
+    const struct hg_atomic_seg_queue *hg_atomic_seg_queue);
+
+/**
+ * Number of times producers had to link a new segment because the tail
+ * segment was full.
+ *
+ * \param hg_atomic_seg_queue [IN]  pointer to queue
+ *
+ * \return Number of segment spills since queue allocation
+ */
+static HG_UTIL_INLINE unsigned int
+hg_atomic_seg_queue_spill_count(
+    const struct hg_atomic_seg_queue *hg_atomic_seg_queue);
+
 /*---------------------------------------------------------------------------*/
 static HG_UTIL_INLINE int
 hg_atomic_queue_push(struct hg_atomic_queue *hg_atomic_queue, void *entry)
@@ -226,6 +401,43 @@ hg_atomic_queue_pop_mc(struct hg_atomic_queue *hg_atomic_queue)
     return entry;
 }
 
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE unsigned int
+hg_atomic_queue_pop_mc_n(struct hg_atomic_queue *hg_atomic_queue,
+    void **entries, unsigned int max_count)
+{
+    int32_t cons_head, cons_next;
+    unsigned int count, i;
+
+    do {
+        cons_head = hg_atomic_get32(&hg_atomic_queue->cons_head);
+        count = ((unsigned int) hg_atomic_get32(&hg_atomic_queue->prod_tail) -
+                    (unsigned int) cons_head) &
+                hg_atomic_queue->cons_mask;
+        if (count == 0)
+            return 0;
+        if (count > max_count)
+            count = max_count;
+        cons_next = (cons_head + (int32_t) count) &
+                    (int) hg_atomic_queue->cons_mask;
+    } while (
+        !hg_atomic_cas32(&hg_atomic_queue->cons_head, cons_head, cons_next));
+
+    for (i = 0; i < count; i++)
+        entries[i] = (void *) hg_atomic_get64(
+            &hg_atomic_queue
+                 ->ring[((unsigned int) cons_head + i) &
+                        hg_atomic_queue->cons_mask]);
+
+    /* Wait for preceding dequeues to complete */
+    while (hg_atomic_get32(&hg_atomic_queue->cons_tail) != cons_head)
+        cpu_spinwait();
+
+    hg_atomic_set32(&hg_atomic_queue->cons_tail, cons_next);
+
+    return count;
+}
+
 /*---------------------------------------------------------------------------*/
 static HG_UTIL_INLINE void *
 hg_atomic_queue_pop_sc(struct hg_atomic_queue *hg_atomic_queue)
@@ -269,6 +481,218 @@ hg_atomic_queue_count(const struct hg_atomic_queue *hg_atomic_queue)
             hg_atomic_queue->prod_mask);
 }
 
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE int
+hg_atomic_queue_seg_push(struct hg_atomic_queue_seg *seg, void *entry)
+{
+    int32_t prod_head, prod_next, cons_tail;
+
+    for (;;) {
+        prod_head = hg_atomic_get32(&seg->prod_head);
+        if (prod_head & HG_ATOMIC_QUEUE_SEG_PENDING) {
+            /* Segment is being linked */
+            cpu_spinwait();
+            continue;
+        }
+        if (prod_head & HG_ATOMIC_QUEUE_SEG_CLOSED)
+            return HG_UTIL_FAIL;
+
+        prod_next = (prod_head + 1) & (int) seg->mask;
+        cons_tail = hg_atomic_get32(&seg->cons_tail);
+
+        if (prod_next == cons_tail) {
+            /* Full, close segment so that next entries go to a new one */
+            (void) hg_atomic_cas32(&seg->prod_head, prod_head,
+                prod_head | HG_ATOMIC_QUEUE_SEG_CLOSED);
+            continue;
+        }
+
+        if (hg_atomic_cas32(&seg->prod_head, prod_head, prod_next))
+            break;
+    }
+
+    hg_atomic_set64(&seg->ring[prod_head], (int64_t) entry);
+
+    /* Wait for preceding enqueues to complete */
+    while (hg_atomic_get32(&seg->prod_tail) != prod_head)
+        cpu_spinwait();
+
+    hg_atomic_set32(&seg->prod_tail, prod_next);
+
+    return HG_UTIL_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE void *
+hg_atomic_queue_seg_pop(struct hg_atomic_queue_seg *seg, uint32_t gen)
+{
+    int64_t cons_ref;
+    int32_t cons_head, cons_next;
+    void *entry = NULL;
+
+    do {
+        cons_ref = hg_atomic_get64(&seg->cons_head);
+        /* Segment was recycled */
+        if (HG_ATOMIC_SEG_QUEUE_GEN(cons_ref) != gen)
+            return NULL;
+        cons_head = (int32_t) HG_ATOMIC_SEG_QUEUE_IDX(cons_ref);
+        cons_next = (cons_head + 1) & (int) seg->mask;
+
+        if (cons_head == hg_atomic_get32(&seg->prod_tail))
+            return NULL;
+    } while (!hg_atomic_cas64(&seg->cons_head, cons_ref,
+        HG_ATOMIC_SEG_QUEUE_REF(gen, cons_next)));
+
+    entry = (void *) hg_atomic_get64(&seg->ring[cons_head]);
+
+    /* Wait for preceding dequeues to complete */
+    while (hg_atomic_get32(&seg->cons_tail) != cons_head)
+        cpu_spinwait();
+
+    hg_atomic_set32(&seg->cons_tail, cons_next);
+
+    return entry;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE unsigned int
+hg_atomic_queue_seg_pop_n(struct hg_atomic_queue_seg *seg, uint32_t gen,
+    void **entries, unsigned int max_count)
+{
+    int64_t cons_ref;
+    int32_t cons_head, cons_next;
+    unsigned int count, i;
+
+    do {
+        cons_ref = hg_atomic_get64(&seg->cons_head);
+        /* Segment was recycled */
+        if (HG_ATOMIC_SEG_QUEUE_GEN(cons_ref) != gen)
+            return 0;
+        cons_head = (int32_t) HG_ATOMIC_SEG_QUEUE_IDX(cons_ref);
+        count = ((unsigned int) hg_atomic_get32(&seg->prod_tail) -
+                    (unsigned int) cons_head) &
+                seg->mask;
+        if (count == 0)
+            return 0;
+        if (count > max_count)
+            count = max_count;
+        cons_next = (cons_head + (int32_t) count) & (int) seg->mask;
+    } while (!hg_atomic_cas64(&seg->cons_head, cons_ref,
+        HG_ATOMIC_SEG_QUEUE_REF(gen, cons_next)));
+
+    for (i = 0; i < count; i++)
+        entries[i] = (void *) hg_atomic_get64(
+            &seg->ring[((unsigned int) cons_head + i) & seg->mask]);
+
+    /* Wait for preceding dequeues to complete */
+    while (hg_atomic_get32(&seg->cons_tail) != cons_head)
+        cpu_spinwait();
+
+    hg_atomic_set32(&seg->cons_tail, cons_next);
+
+    return count;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE int
+hg_atomic_seg_queue_push(
+    struct hg_atomic_seg_queue *hg_atomic_seg_queue, void *entry)
+{
+    for (;;) {
+        int64_t tail = hg_atomic_get64(&hg_atomic_seg_queue->tail);
+
+        if (hg_atomic_queue_seg_push(
+                hg_atomic_seg_queue->segs[HG_ATOMIC_SEG_QUEUE_IDX(tail)],
+                entry) == HG_UTIL_SUCCESS)
+            return HG_UTIL_SUCCESS;
+
+        /* Tail segment is closed */
+        if (hg_atomic_seg_queue_extend(hg_atomic_seg_queue, tail) !=
+            HG_UTIL_SUCCESS)
+            return HG_UTIL_FAIL;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE void *
+hg_atomic_seg_queue_pop(struct hg_atomic_seg_queue *hg_atomic_seg_queue)
+{
+    for (;;) {
+        int64_t head = hg_atomic_get64(&hg_atomic_seg_queue->head);
+        struct hg_atomic_queue_seg *seg =
+            hg_atomic_seg_queue->segs[HG_ATOMIC_SEG_QUEUE_IDX(head)];
+        void *entry;
+
+        entry = hg_atomic_queue_seg_pop(seg, HG_ATOMIC_SEG_QUEUE_GEN(head));
+        if (entry != NULL)
+            return entry;
+
+        /* Head moved, seg may have been recycled */
+        if (hg_atomic_get64(&hg_atomic_seg_queue->head) != head)
+            continue;
+
+        /* Only a closed segment can be followed by another one */
+        if ((hg_atomic_get32(&seg->prod_head) & HG_ATOMIC_QUEUE_SEG_STATE) !=
+            HG_ATOMIC_QUEUE_SEG_CLOSED)
+            return NULL;
+
+        if (hg_atomic_seg_queue_advance(hg_atomic_seg_queue, head) !=
+            HG_UTIL_SUCCESS)
+            return NULL;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE bool
+hg_atomic_seg_queue_is_empty(
+    const struct hg_atomic_seg_queue *hg_atomic_seg_queue)
+{
+    return (hg_atomic_seg_queue_count(hg_atomic_seg_queue) == 0);
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE unsigned int
+hg_atomic_seg_queue_count(const struct hg_atomic_seg_queue *hg_atomic_seg_queue)
+{
+    for (;;) {
+        int64_t head = hg_atomic_get64(&hg_atomic_seg_queue->head);
+        unsigned int idx = HG_ATOMIC_SEG_QUEUE_IDX(head), count = 0, i;
+        uint32_t gen = HG_ATOMIC_SEG_QUEUE_GEN(head);
+
+        /* Segments following head are consumed at consecutive generations,
+         * restart if one of them was recycled during the walk */
+        for (i = 0; i < HG_ATOMIC_SEG_QUEUE_MAX; i++, gen++) {
+            const struct hg_atomic_queue_seg *seg =
+                hg_atomic_seg_queue->segs[idx];
+            unsigned int next;
+
+            if (HG_ATOMIC_SEG_QUEUE_GEN(hg_atomic_get64(&seg->cons_head)) !=
+                gen)
+                break;
+
+            count += ((unsigned int) hg_atomic_get32(&seg->prod_tail) -
+                         (unsigned int) hg_atomic_get32(&seg->cons_tail)) &
+                     seg->mask;
+
+            next = HG_ATOMIC_SEG_QUEUE_IDX(hg_atomic_get64(&seg->next));
+            if (next == 0)
+                return count;
+            idx = next - 1;
+        }
+        if (i == HG_ATOMIC_SEG_QUEUE_MAX)
+            return count;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE unsigned int
+hg_atomic_seg_queue_spill_count(
+    const struct hg_atomic_seg_queue *hg_atomic_seg_queue)
+{
+    /* Tail generation is bumped exactly once per linked segment */
+    return HG_ATOMIC_SEG_QUEUE_GEN(hg_atomic_get64(&hg_atomic_seg_queue->tail));
+}
+
 #ifdef __cplusplus
 }
 #endif
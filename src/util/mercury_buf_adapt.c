@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_buf_adapt.h"
+
+/*---------------------------------------------------------------------------*/
+void
+hg_buf_adapt_init(struct hg_buf_adapt *hg_buf_adapt, size_t buf_size,
+    unsigned int size_factor, unsigned int count, unsigned int count_min,
+    unsigned int count_max, int32_t copy_threshold)
+{
+    hg_buf_adapt->buf_size = buf_size;
+    hg_buf_adapt->buf_size_min = buf_size;
+    hg_buf_adapt->buf_size_max = buf_size * size_factor;
+    hg_buf_adapt->fill_time = 0.;
+    hg_buf_adapt->hold_time = 0.;
+    hg_buf_adapt->copy_count = 0;
+    hg_buf_adapt->posted_min = INT32_MAX;
+    hg_buf_adapt->copy_threshold = copy_threshold;
+    hg_buf_adapt->count = count;
+    hg_buf_adapt->count_min = count_min;
+    hg_buf_adapt->count_max = count_max;
+    hg_buf_adapt->park = 0;
+    hg_buf_adapt->consumed = 0;
+}
+
+/*---------------------------------------------------------------------------*/
+unsigned int
+hg_buf_adapt_consumed(struct hg_buf_adapt *hg_buf_adapt, int32_t posted_count,
+    int64_t copy_count)
+{
+    unsigned int flags = HG_BUF_ADAPT_ROUND;
+
+    if (posted_count < hg_buf_adapt->posted_min)
+        hg_buf_adapt->posted_min = posted_count;
+    if (++hg_buf_adapt->consumed < hg_buf_adapt->count)
+        return 0;
+
+    if (hg_buf_adapt->posted_min == 0) {
+        /* All buffers were consumed during that round, add buffers first and
+         * enlarge them once the max number of buffers is reached */
+        if (hg_buf_adapt->park > 0)
+            hg_buf_adapt->park--;
+        else if (hg_buf_adapt->count < hg_buf_adapt->count_max)
+            flags |= HG_BUF_ADAPT_ADD;
+        else if (hg_buf_adapt->buf_size < hg_buf_adapt->buf_size_max) {
+            hg_buf_adapt->buf_size *= 2;
+            flags |= HG_BUF_ADAPT_RESIZE;
+        }
+
+        /* Buffers are held longer than it takes to fill them, copy payloads
+         * earlier so that buffers can be reposted */
+        if (hg_buf_adapt->hold_time > hg_buf_adapt->fill_time &&
+            (unsigned int) hg_buf_adapt->copy_threshold + 1 <
+                hg_buf_adapt->count)
+            hg_buf_adapt->copy_threshold++;
+    } else if (hg_buf_adapt->posted_min >= 2) {
+        /* Spare buffers remained posted during that round, stop copying
+         * first, then shrink buffers and free them */
+        if (copy_count > hg_buf_adapt->copy_count &&
+            hg_buf_adapt->copy_threshold > 0)
+            hg_buf_adapt->copy_threshold--;
+        else if (hg_buf_adapt->buf_size > hg_buf_adapt->buf_size_min) {
+            hg_buf_adapt->buf_size /= 2;
+            flags |= HG_BUF_ADAPT_RESIZE;
+        } else if (hg_buf_adapt->count - hg_buf_adapt->park >
+                   hg_buf_adapt->count_min)
+            hg_buf_adapt->park++;
+    }
+
+    /* Start new round */
+    hg_buf_adapt->consumed = 0;
+    hg_buf_adapt->posted_min = INT32_MAX;
+    hg_buf_adapt->fill_time = 0.;
+    hg_buf_adapt->hold_time = 0.;
+    hg_buf_adapt->copy_count = copy_count;
+
+    return flags;
+}
+
+/*---------------------------------------------------------------------------*/
+bool
+hg_buf_adapt_repost(
+    struct hg_buf_adapt *hg_buf_adapt, double fill_time, double hold_time)
+{
+    hg_buf_adapt->fill_time += fill_time;
+    hg_buf_adapt->hold_time += hold_time;
+
+    if (hg_buf_adapt->park == 0)
+        return false;
+
+    hg_buf_adapt->park--;
+    hg_buf_adapt->count--;
+
+    return true;
+}
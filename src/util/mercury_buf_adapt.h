@@ -0,0 +1,124 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MERCURY_BUF_ADAPT_H
+#define MERCURY_BUF_ADAPT_H
+
+#include "mercury_util_config.h"
+
+/*****************/
+/* Public Macros */
+/*****************/
+
+/* Flags returned by hg_buf_adapt_consumed() */
+#define HG_BUF_ADAPT_ROUND  (1 << 0) /* Round completed */
+#define HG_BUF_ADAPT_ADD    (1 << 1) /* One more buffer should be posted */
+#define HG_BUF_ADAPT_RESIZE (1 << 2) /* Size of (re)posted buffers changed */
+
+/*************************************/
+/* Public Type and Struct Definition */
+/*************************************/
+
+/* Adaptive set of receive buffers that are consumed and reposted. Buffers are
+ * adapted once per round, i.e., once as many buffers as allocated have been
+ * consumed. Callers must serialize accesses. */
+struct hg_buf_adapt {
+    size_t buf_size;        /* Size of (re)posted buffers */
+    size_t buf_size_min;    /* Initial buffer size */
+    size_t buf_size_max;    /* Max buffer size */
+    double fill_time;       /* Time spent filling buffers in round (s) */
+    double hold_time;       /* Time buffers were held in round (s) */
+    int64_t copy_count;     /* Copies at start of round */
+    int32_t posted_min;     /* Min number of buffers posted in round */
+    int32_t copy_threshold; /* Copy payloads when fewer buffers are posted */
+    unsigned int count;     /* Number of buffers allocated */
+    unsigned int count_min; /* Min number of buffers kept */
+    unsigned int count_max; /* Max number of buffers */
+    unsigned int park;      /* Number of buffers to free on repost */
+    unsigned int consumed;  /* Number of buffers consumed in round */
+};
+
+/*********************/
+/* Public Prototypes */
+/*********************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Initialize adaptive buffer state.
+ *
+ * \param hg_buf_adapt [OUT]    pointer to adaptive buffer state
+ * \param buf_size [IN]         initial buffer size
+ * \param size_factor [IN]      max growth factor of buffer size
+ * \param count [IN]            initial number of buffers
+ * \param count_min [IN]        min number of buffers kept
+ * \param count_max [IN]        max number of buffers
+ * \param copy_threshold [IN]   initial copy threshold
+ */
+HG_UTIL_PUBLIC void
+hg_buf_adapt_init(struct hg_buf_adapt *hg_buf_adapt, size_t buf_size,
+    unsigned int size_factor, unsigned int count, unsigned int count_min,
+    unsigned int count_max, int32_t copy_threshold);
+
+/**
+ * Account for a consumed buffer and adapt buffers if that buffer completes
+ * the round:
+ * - if all buffers were consumed at some point of the round, one buffer is
+ *   added (HG_BUF_ADAPT_ADD), or, once count_max is reached, buffers are
+ *   enlarged. If buffers were also held longer than it took to fill them,
+ *   the copy threshold is raised so that buffers can be reposted sooner.
+ * - if at least two buffers stayed posted during the round, the copy
+ *   threshold is lowered first if payloads were copied, then buffers are
+ *   shrunk and finally buffers are parked (freed on repost) down to
+ *   count_min.
+ * Buffer size changes apply to buffers as they are reposted.
+ *
+ * \param hg_buf_adapt [IN/OUT] pointer to adaptive buffer state
+ * \param posted_count [IN]     number of buffers still posted
+ * \param copy_count [IN]       total number of payloads copied so far
+ *
+ * \return Combination of HG_BUF_ADAPT_* flags
+ */
+HG_UTIL_PUBLIC unsigned int
+hg_buf_adapt_consumed(struct hg_buf_adapt *hg_buf_adapt, int32_t posted_count,
+    int64_t copy_count);
+
+/**
+ * Account for a buffer added after HG_BUF_ADAPT_ADD was returned.
+ *
+ * \param hg_buf_adapt [IN/OUT] pointer to adaptive buffer state
+ */
+static HG_UTIL_INLINE void
+hg_buf_adapt_added(struct hg_buf_adapt *hg_buf_adapt);
+
+/**
+ * Account for a buffer that is no longer used and is about to be reposted.
+ *
+ * \param hg_buf_adapt [IN/OUT] pointer to adaptive buffer state
+ * \param fill_time [IN]        time it took to fill the buffer (s)
+ * \param hold_time [IN]        time the buffer was held once filled (s)
+ *
+ * \return true if the buffer must be freed instead of being reposted
+ */
+HG_UTIL_PUBLIC bool
+hg_buf_adapt_repost(
+    struct hg_buf_adapt *hg_buf_adapt, double fill_time, double hold_time);
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE void
+hg_buf_adapt_added(struct hg_buf_adapt *hg_buf_adapt)
+{
+    hg_buf_adapt->count++;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MERCURY_BUF_ADAPT_H */
@@ -0,0 +1,42 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MERCURY_CRC32C_H
+#define MERCURY_CRC32C_H
+
+#include "mercury_util_config.h"
+
+#include <stddef.h>
+
+/*********************/
+/* Public Prototypes */
+/*********************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Compute CRC32C (Castagnoli) of a buffer. CRC instructions are used when
+ * available (SSE4.2 on x86-64, detected at runtime, or ARMv8 CRC extension),
+ * a table-driven implementation is used otherwise. Passing the value returned
+ * by a previous call as crc continues the computation over additional data.
+ *
+ * \param crc [IN]                 initial value (0 for new computation)
+ * \param buf [IN]                 pointer to data
+ * \param size [IN]                size of data
+ *
+ * \return CRC32C value
+ */
+HG_UTIL_PUBLIC uint32_t
+hg_crc32c(uint32_t crc, const void *buf, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MERCURY_CRC32C_H */
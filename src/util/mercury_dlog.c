@@ -7,11 +7,16 @@
 
 #include "mercury_dlog.h"
 
+#include <errno.h>
+#include <fcntl.h>
 #include <inttypes.h>
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 #ifdef _WIN32
+#    include <io.h>
 #    include <process.h>
 #else
 #    include <unistd.h>
@@ -21,6 +26,25 @@
 /* Local Macros */
 /****************/
 
+/* raw file I/O, usable from a signal handler */
+#ifdef _WIN32
+#    define hg_dlog_open(path)                                                 \
+        _open(path, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY,               \
+            _S_IREAD | _S_IWRITE)
+#    define hg_dlog_write(fd, buf, len) _write(fd, buf, (unsigned int) (len))
+#    define hg_dlog_close(fd)           _close(fd)
+#    define hg_dlog_getpid()            _getpid()
+#else
+#    define hg_dlog_open(path)                                                 \
+        open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644)
+#    define hg_dlog_write(fd, buf, len) write(fd, buf, len)
+#    define hg_dlog_close(fd)           close(fd)
+#    define hg_dlog_getpid()            getpid()
+#endif
+
+/* number of crash signals dumped by hg_dlog_rec_set_sigdump() */
+#define HG_DLOG_REC_NSIGS (5)
+
 /************************************/
 /* Local Type and Struct Definition */
 /************************************/
@@ -29,10 +53,43 @@
 /* Local Prototypes */
 /********************/
 
+/* write all of buf to fd (retry on short writes) */
+static int
+hg_dlog_write_all(int fd, const void *buf, size_t len);
+
+/* write a flight recorder dump to fd without locking or allocating */
+static int
+hg_dlog_rec_write(struct hg_dlog_rec *r, int fd);
+
+/* mark the ring of an exiting thread reusable (thread key destructor) */
+static void
+hg_dlog_rec_ring_release(void *arg);
+
+#ifndef _WIN32
+/* signal handler for hg_dlog_rec_set_sigdump() */
+static void
+hg_dlog_rec_sighandler(int sig);
+
+/* restore signal handlers replaced by hg_dlog_rec_set_sigdump() */
+static void
+hg_dlog_rec_sigrestore(void);
+#endif
+
 /*******************/
 /* Local Variables */
 /*******************/
 
+#ifndef _WIN32
+/* recorder dumped on signal and its output file */
+static struct hg_dlog_rec *volatile hg_dlog_rec_sig_g = NULL;
+static char hg_dlog_rec_sig_path_g[BUFSIZ];
+
+/* signals handled and previous handlers (last one is the user signal) */
+static int hg_dlog_rec_sigs_g[HG_DLOG_REC_NSIGS + 1] = {
+    SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT, 0};
+static struct sigaction hg_dlog_rec_sigold_g[HG_DLOG_REC_NSIGS + 1];
+#endif
+
 /*---------------------------------------------------------------------------*/
 struct hg_dlog *
 hg_dlog_alloc(char *name, unsigned int lesize, int leloop)
@@ -341,3 +398,368 @@ hg_dlog_dump_file(struct hg_dlog *d, const char *base, int addpid, int trylock)
     hg_thread_mutex_unlock(&d->dlock);
     fclose(fp);
 }
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_dlog_write_all(int fd, const void *buf, size_t len)
+{
+    const char *p = (const char *) buf;
+
+    while (len > 0) {
+        long n = (long) hg_dlog_write(fd, p, len);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return HG_UTIL_FAIL;
+        }
+        p += n;
+        len -= (size_t) n;
+    }
+
+    return HG_UTIL_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+struct hg_dlog_rec *
+hg_dlog_rec_alloc(
+    const char *name, unsigned int size, unsigned int max_threads)
+{
+    struct hg_dlog_rec *r;
+    unsigned int rsize = 1;
+
+    if (size == 0 || max_threads == 0)
+        return NULL;
+    while (rsize < size)
+        rsize <<= 1;
+
+    r = malloc(sizeof(*r));
+    if (!r)
+        return NULL;
+    memset(r, 0, sizeof(*r));
+
+    r->rings = calloc(max_threads, sizeof(*r->rings));
+    if (!r->rings) {
+        free(r);
+        return NULL;
+    }
+    if (hg_thread_key_create2(&r->rkey, hg_dlog_rec_ring_release) !=
+        HG_UTIL_SUCCESS) {
+        free(r->rings);
+        free(r);
+        return NULL;
+    }
+
+    snprintf(
+        r->rec_magic, sizeof(r->rec_magic), "%s%s", HG_DLOG_RECMAGIC, name);
+    hg_thread_mutex_init(&r->rlock);
+    r->rmax = max_threads;
+    hg_atomic_init32(&r->nrings, 0);
+    r->size = rsize;
+
+    return r;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_dlog_rec_free(struct hg_dlog_rec *r)
+{
+    unsigned int i, nrings = (unsigned int) hg_atomic_get32(&r->nrings);
+
+#ifndef _WIN32
+    if (hg_dlog_rec_sig_g == r)
+        (void) hg_dlog_rec_set_sigdump(NULL, NULL, 0, 0);
+#endif
+
+    /* delete key first so that exiting threads no longer touch rings */
+    (void) hg_thread_key_delete(r->rkey);
+    for (i = 0; i < nrings; i++)
+        free(r->rings[i]);
+    free(r->rings);
+    hg_thread_mutex_destroy(&r->rlock);
+    free(r);
+}
+
+/*---------------------------------------------------------------------------*/
+struct hg_dlog_rec_ring *
+hg_dlog_rec_ring_create(struct hg_dlog_rec *r)
+{
+    struct hg_dlog_rec_ring *ring = NULL;
+    unsigned int i, nrings = (unsigned int) hg_atomic_get32(&r->nrings);
+
+    /* reuse the ring of an exited thread, its records are kept until they
+     * get overwritten.  published rings are never freed, no lock needed */
+    for (i = 0; i < nrings; i++) {
+        ring = r->rings[i];
+        if (hg_atomic_get32(&ring->exited) &&
+            hg_atomic_cas32(&ring->exited, 1, 0)) {
+            if (hg_thread_setspecific(r->rkey, ring) != HG_UTIL_SUCCESS) {
+                hg_atomic_set32(&ring->exited, 1);
+                return NULL;
+            }
+            return ring;
+        }
+    }
+    ring = NULL;
+
+    /* do not take the lock again once all rings are used */
+    if (nrings >= r->rmax)
+        return NULL;
+
+    hg_thread_mutex_lock(&r->rlock);
+    nrings = (unsigned int) hg_atomic_get32(&r->nrings);
+    if (nrings >= r->rmax)
+        goto done;
+
+    /* records directly follow the ring */
+    ring = malloc(sizeof(*ring) + sizeof(*ring->entries) * r->size);
+    if (!ring)
+        goto done;
+    memset(ring, 0, sizeof(*ring) + sizeof(*ring->entries) * r->size);
+    hg_atomic_init64(&ring->head, 0);
+    hg_atomic_init32(&ring->exited, 0);
+    ring->id = nrings;
+    ring->entries = (struct hg_dlog_rec_entry *) (ring + 1);
+
+    if (hg_thread_setspecific(r->rkey, ring) != HG_UTIL_SUCCESS) {
+        free(ring);
+        ring = NULL;
+        goto done;
+    }
+
+    /* publish ring to dumps */
+    r->rings[nrings] = ring;
+    hg_atomic_set32(&r->nrings, (int32_t) nrings + 1);
+
+done:
+    hg_thread_mutex_unlock(&r->rlock);
+    return ring;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_dlog_rec_ring_release(void *arg)
+{
+    struct hg_dlog_rec_ring *ring = (struct hg_dlog_rec_ring *) arg;
+
+    hg_atomic_set32(&ring->exited, 1);
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_dlog_rec_setstop(struct hg_dlog_rec *r, int stop)
+{
+    r->stop = stop; /* no need to lock */
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_dlog_rec_write(struct hg_dlog_rec *r, int fd)
+{
+    struct hg_dlog_rec_header hdr;
+    unsigned int i, nrings = (unsigned int) hg_atomic_get32(&r->nrings);
+
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, r->rec_magic, sizeof(hdr.magic));
+    hdr.version = HG_DLOG_REC_VERSION;
+    hdr.esize = (uint32_t) sizeof(struct hg_dlog_rec_entry);
+    hdr.size = r->size;
+    hdr.nrings = nrings;
+    hdr.pid = (uint64_t) hg_dlog_getpid();
+    if (hg_dlog_write_all(fd, &hdr, sizeof(hdr)) != HG_UTIL_SUCCESS)
+        return HG_UTIL_FAIL;
+
+    for (i = 0; i < nrings; i++) {
+        struct hg_dlog_rec_ring *ring = r->rings[i];
+        struct hg_dlog_rec_ring_header rhdr;
+        uint64_t head;
+
+        /* records are written straight from the ring, the owner may
+         * overwrite the oldest ones meanwhile, which the decoder detects
+         * by comparing head before and after */
+        memset(&rhdr, 0, sizeof(rhdr));
+        rhdr.id = ring->id;
+        rhdr.head = (uint64_t) hg_atomic_get64(&ring->head);
+        if (hg_dlog_write_all(fd, &rhdr, sizeof(rhdr)) != HG_UTIL_SUCCESS)
+            return HG_UTIL_FAIL;
+        if (hg_dlog_write_all(fd, ring->entries,
+                sizeof(*ring->entries) * r->size) != HG_UTIL_SUCCESS)
+            return HG_UTIL_FAIL;
+        hg_atomic_fence();
+        head = (uint64_t) hg_atomic_get64(&ring->head);
+        if (hg_dlog_write_all(fd, &head, sizeof(head)) != HG_UTIL_SUCCESS)
+            return HG_UTIL_FAIL;
+    }
+
+    return HG_UTIL_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+hg_dlog_rec_dump_file(struct hg_dlog_rec *r, const char *base, int addpid)
+{
+    char buf[BUFSIZ];
+    int fd, rc;
+
+    if (addpid)
+        snprintf(buf, sizeof(buf), "%s-%d.rec", base, (int) hg_dlog_getpid());
+    else
+        snprintf(buf, sizeof(buf), "%s.rec", base);
+
+    fd = hg_dlog_open(buf);
+    if (fd < 0) {
+        perror("open");
+        return HG_UTIL_FAIL;
+    }
+
+    rc = hg_dlog_rec_write(r, fd);
+    if (rc != HG_UTIL_SUCCESS)
+        perror("write");
+    hg_dlog_close(fd);
+
+    return rc;
+}
+
+/*---------------------------------------------------------------------------*/
+size_t
+hg_dlog_rec_copy(struct hg_dlog_rec *r, struct hg_dlog_rec_record *records,
+    size_t max_count)
+{
+    unsigned int i, nrings = (unsigned int) hg_atomic_get32(&r->nrings);
+    size_t count = 0;
+
+    for (i = 0; i < nrings; i++) {
+        struct hg_dlog_rec_ring *ring = r->rings[i];
+        uint64_t head, head_end, lo, seq;
+        size_t first = count, discard;
+
+        head = (uint64_t) hg_atomic_get64(&ring->head);
+        lo = (head > r->size) ? head - r->size : 0;
+        if (head - lo > max_count - count)
+            continue;
+        for (seq = lo; seq < head; seq++) {
+            records[count].entry = ring->entries[seq & (r->size - 1)];
+            records[count].ring = ring->id;
+            count++;
+        }
+
+        /* same bound as hg_dlog_decode: records before head_end + 1 - size
+         * may have been overwritten while being copied (+1 for a record in
+         * progress) */
+        hg_atomic_fence();
+        head_end = (uint64_t) hg_atomic_get64(&ring->head);
+        if (head_end + 1 <= r->size + lo)
+            continue;
+        discard = (size_t) (head_end + 1 - r->size - lo);
+        if (discard > count - first)
+            discard = count - first;
+        memmove(&records[first], &records[first + discard],
+            (count - first - discard) * sizeof(*records));
+        count -= discard;
+    }
+
+    return count;
+}
+
+/*---------------------------------------------------------------------------*/
+#ifndef _WIN32
+static void
+hg_dlog_rec_sighandler(int sig)
+{
+    struct hg_dlog_rec *r = hg_dlog_rec_sig_g;
+    int saved_errno = errno, i;
+
+    /* freeze rings on crash so that the dump shows what led to it */
+    if (r && sig != hg_dlog_rec_sigs_g[HG_DLOG_REC_NSIGS])
+        r->stop = 1;
+
+    if (r) {
+        int fd = hg_dlog_open(hg_dlog_rec_sig_path_g);
+        if (fd >= 0) {
+            (void) hg_dlog_rec_write(r, fd);
+            (void) hg_dlog_close(fd);
+        }
+    }
+
+    if (sig == hg_dlog_rec_sigs_g[HG_DLOG_REC_NSIGS]) {
+        errno = saved_errno;
+        return;
+    }
+
+    /* hand crash over to the previous handler, the re-raised signal is
+     * blocked until we return */
+    for (i = 0; i < HG_DLOG_REC_NSIGS; i++)
+        if (hg_dlog_rec_sigs_g[i] == sig)
+            (void) sigaction(sig, &hg_dlog_rec_sigold_g[i], NULL);
+    (void) raise(sig);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_dlog_rec_sigrestore(void)
+{
+    int i;
+
+    for (i = 0; i < HG_DLOG_REC_NSIGS + 1; i++)
+        if (hg_dlog_rec_sigs_g[i] != 0)
+            (void) sigaction(
+                hg_dlog_rec_sigs_g[i], &hg_dlog_rec_sigold_g[i], NULL);
+    hg_dlog_rec_sigs_g[HG_DLOG_REC_NSIGS] = 0;
+    hg_dlog_rec_sig_g = NULL;
+}
+#endif
+
+/*---------------------------------------------------------------------------*/
+int
+hg_dlog_rec_set_sigdump(
+    struct hg_dlog_rec *r, const char *base, int addpid, int usrsig)
+{
+#ifdef _WIN32
+    (void) r;
+    (void) base;
+    (void) addpid;
+    (void) usrsig;
+
+    return HG_UTIL_FAIL;
+#else
+    struct sigaction sa;
+    int i;
+
+    /* drop previous setup (if any) */
+    if (hg_dlog_rec_sig_g != NULL)
+        hg_dlog_rec_sigrestore();
+    if (r == NULL)
+        return HG_UTIL_SUCCESS;
+
+    /* path must be ready before the handler runs */
+    if (addpid)
+        snprintf(hg_dlog_rec_sig_path_g, sizeof(hg_dlog_rec_sig_path_g),
+            "%s-%d.rec", base, (int) getpid());
+    else
+        snprintf(hg_dlog_rec_sig_path_g, sizeof(hg_dlog_rec_sig_path_g),
+            "%s.rec", base);
+    hg_dlog_rec_sig_g = r;
+    hg_dlog_rec_sigs_g[HG_DLOG_REC_NSIGS] = usrsig;
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = hg_dlog_rec_sighandler;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+    for (i = 0; i < HG_DLOG_REC_NSIGS + 1; i++) {
+        if (hg_dlog_rec_sigs_g[i] == 0)
+            continue;
+        if (sigaction(hg_dlog_rec_sigs_g[i], &sa, &hg_dlog_rec_sigold_g[i]) !=
+            0) {
+            perror("sigaction");
+            /* only restore the ones that were installed */
+            hg_dlog_rec_sigs_g[HG_DLOG_REC_NSIGS] = 0;
+            while (i-- > 0)
+                (void) sigaction(
+                    hg_dlog_rec_sigs_g[i], &hg_dlog_rec_sigold_g[i], NULL);
+            hg_dlog_rec_sig_g = NULL;
+            return HG_UTIL_FAIL;
+        }
+    }
+
+    return HG_UTIL_SUCCESS;
+#endif
+}
@@ -12,6 +12,7 @@
 
 #include "mercury_atomic.h"
 #include "mercury_queue.h"
+#include "mercury_thread.h"
 #include "mercury_thread_mutex.h"
 #include "mercury_time.h"
 
@@ -27,6 +28,14 @@
  */
 #define HG_DLOG_MAGICLEN 16         /* bytes to reserve for magic# */
 #define HG_DLOG_STDMAGIC ">D.LO.G<" /* standard for first 8 bytes */
+#define HG_DLOG_RECMAGIC ">D.RE.C<" /* flight recorder first 8 bytes */
+
+/*
+ * flight recorder dump file version.  dump files are raw native-endian
+ * copies of the rings, bump this when any of the hg_dlog_rec_* on-disk
+ * structures below change.
+ */
+#define HG_DLOG_REC_VERSION 1
 
 /*
  * HG_DLOG_INITIALIZER: initializer for a dlog in a global variable.
@@ -101,6 +110,81 @@ struct hg_dlog {
     int mallocd; /* allocated with malloc? */
 };
 
+/*
+ * hg_dlog_rec_entry: fixed-size binary record in a flight recorder ring.
+ * records are never formatted when added, they are dumped as-is and
+ * decoded offline (see hg_dlog_decode).
+ */
+struct hg_dlog_rec_entry {
+    uint64_t time;     /* time added (ns, monotonic clock) */
+    uint64_t handle;   /* handle (or object) address */
+    uint64_t arg[2];   /* event arguments */
+    uint32_t event;    /* event id */
+    uint32_t reserved; /* always 0 */
+};
+
+/*
+ * hg_dlog_rec_ring: per-thread ring of records.  only the owning thread
+ * writes to it, head is published after each record so that it can be
+ * dumped at any time without locking.  the ring of an exited thread is
+ * reused by the next thread that needs one.
+ */
+struct hg_dlog_rec_ring {
+    hg_atomic_int64_t head;            /* #records added so far */
+    hg_atomic_int32_t exited;          /* owning thread exited? */
+    unsigned int id;                   /* ring id (creation order) */
+    struct hg_dlog_rec_entry *entries; /* array of records */
+};
+
+/*
+ * hg_dlog_rec: flight recorder main structure
+ */
+struct hg_dlog_rec {
+    char rec_magic[HG_DLOG_MAGICLEN]; /* magic number + name */
+    hg_thread_mutex_t rlock;          /* lock for ring creation */
+    hg_thread_key_t rkey;             /* key for calling thread's ring */
+
+    /* rings */
+    struct hg_dlog_rec_ring **rings; /* array of rings */
+    unsigned int rmax;               /* size of rings[] array */
+    hg_atomic_int32_t nrings;        /* #rings in use in rings[] */
+    unsigned int size;               /* #records per ring (power of 2) */
+    int stop;                        /* stop taking new records */
+};
+
+/*
+ * hg_dlog_rec_record: record copied out of a ring by hg_dlog_rec_copy().
+ */
+struct hg_dlog_rec_record {
+    struct hg_dlog_rec_entry entry; /* record */
+    unsigned int ring;              /* id of ring it was copied from */
+};
+
+/*
+ * hg_dlog_rec_header: flight recorder dump file header.  it is followed
+ * by nrings times a hg_dlog_rec_ring_header, the ring's size records and
+ * a uint64_t giving the ring's head once the records were written.
+ */
+struct hg_dlog_rec_header {
+    char magic[HG_DLOG_MAGICLEN]; /* magic number + name */
+    uint32_t version;             /* HG_DLOG_REC_VERSION */
+    uint32_t esize;               /* size of a record */
+    uint32_t size;                /* #records per ring */
+    uint32_t nrings;              /* #rings that follow */
+    uint64_t pid;                 /* pid of dumping process */
+};
+
+/*
+ * hg_dlog_rec_ring_header: header of a ring in a dump file.  records
+ * numbered from "head after" + 1 - size up to (excluding) head may be
+ * trusted, older ones may have been overwritten while dumping.
+ */
+struct hg_dlog_rec_ring_header {
+    uint32_t id;       /* ring id */
+    uint32_t reserved; /* always 0 */
+    uint64_t head;     /* ring head before the records were written */
+};
+
 /*********************/
 /* Public Prototypes */
 /*********************/
@@ -257,6 +341,161 @@ hg_dlog_dump_counters(struct hg_dlog *d,
 HG_UTIL_PUBLIC void
 hg_dlog_dump_file(struct hg_dlog *d, const char *base, int addpid, int trylock);
 
+/**
+ * malloc and return a new flight recorder.  each thread that adds a
+ * record gets its own ring of size records, allocated on first use.
+ *
+ * \param name [IN]             name of recorder (truncated past 8 bytes)
+ * \param size [IN]             number of records per ring (rounded up to
+ *                              a power of 2)
+ * \param max_threads [IN]      max number of running threads that can
+ *                              record, records from other threads are
+ *                              dropped
+ *
+ * \return the new recorder or NULL on error
+ */
+HG_UTIL_PUBLIC struct hg_dlog_rec *
+hg_dlog_rec_alloc(
+    const char *name, unsigned int size, unsigned int max_threads);
+
+/**
+ * free a flight recorder and all of its rings.  assumes no thread is
+ * adding records anymore.  signal dumps are disabled if they were set
+ * up for this recorder.
+ *
+ * \param r [IN]                the recorder to free
+ */
+HG_UTIL_PUBLIC void
+hg_dlog_rec_free(struct hg_dlog_rec *r);
+
+/**
+ * add a record to the calling thread's ring.  the hot path takes no lock
+ * and formats nothing, it only copies the arguments and a time stamp.
+ *
+ * \param r [IN]                the recorder to add the record to
+ * \param event [IN]            event id
+ * \param handle [IN]           handle (or object) the event refers to
+ * \param arg0 [IN]             first event argument
+ * \param arg1 [IN]             second event argument
+ *
+ * \return 1 if added, 0 otherwise
+ */
+static HG_UTIL_INLINE unsigned int
+hg_dlog_rec_add(struct hg_dlog_rec *r, uint32_t event, const void *handle,
+    uint64_t arg0, uint64_t arg1);
+
+/**
+ * create the calling thread's ring (slow path of hg_dlog_rec_add()).
+ * the ring of an exited thread is reused first.
+ *
+ * \param r [IN]                the recorder to create the ring in
+ *
+ * \return the ring or NULL if no more rings can be created
+ */
+HG_UTIL_PUBLIC struct hg_dlog_rec_ring *
+hg_dlog_rec_ring_create(struct hg_dlog_rec *r);
+
+/**
+ * set the value of stop for a recorder (to enable/disable recording)
+ *
+ * \param r [IN]                recorder to set stop in
+ * \param stop [IN]             value of stop to use (1=stop, 0=go)
+ */
+HG_UTIL_PUBLIC void
+hg_dlog_rec_setstop(struct hg_dlog_rec *r, int stop);
+
+/**
+ * dump a flight recorder to a binary file that can be read back with
+ * hg_dlog_decode.  no lock is taken, threads may keep adding records
+ * while dumping.  the output file is "base.rec" or "base-pid.rec"
+ * depending on the value of addpid.
+ *
+ * \param r [IN]                recorder to dump
+ * \param base [IN]             output file basename
+ * \param addpid [IN]           add pid to output filename
+ *
+ * \return Non-negative on success or negative on failure
+ */
+HG_UTIL_PUBLIC int
+hg_dlog_rec_dump_file(struct hg_dlog_rec *r, const char *base, int addpid);
+
+/**
+ * copy the records of a flight recorder into memory.  no lock is taken,
+ * threads may keep adding records while copying, records that may have
+ * been overwritten in the meantime are discarded.  rings that do not fit
+ * into records[] are skipped.
+ *
+ * \param r [IN]                recorder to copy
+ * \param records [OUT]         array of at least max_count records
+ * \param max_count [IN]        size of records[] (nrings * size records
+ *                              are enough to copy all rings)
+ *
+ * eturn number of records copied
+ */
+HG_UTIL_PUBLIC size_t
+hg_dlog_rec_copy(struct hg_dlog_rec *r, struct hg_dlog_rec_record *records,
+    size_t max_count);
+
+/**
+ * dump a flight recorder from a signal handler.  crash signals (SIGSEGV,
+ * SIGBUS, SIGILL, SIGFPE and SIGABRT) stop the recorder, dump it and
+ * re-raise the signal to the previous handler.  if usrsig is non-zero,
+ * receiving usrsig (e.g. SIGUSR2) dumps the recorder and continues.
+ * only one recorder can be dumped on signal, passing a NULL recorder
+ * restores the previous handlers.  not supported on Windows.
+ *
+ * \param r [IN]                recorder to dump (NULL to disable)
+ * \param base [IN]             output file basename
+ * \param addpid [IN]           add pid to output filename
+ * \param usrsig [IN]           user signal that triggers a dump (or 0)
+ *
+ * \return Non-negative on success or negative on failure
+ */
+HG_UTIL_PUBLIC int
+hg_dlog_rec_set_sigdump(
+    struct hg_dlog_rec *r, const char *base, int addpid, int usrsig);
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE unsigned int
+hg_dlog_rec_add(struct hg_dlog_rec *r, uint32_t event, const void *handle,
+    uint64_t arg0, uint64_t arg1)
+{
+    struct hg_dlog_rec_ring *ring;
+    struct hg_dlog_rec_entry *e;
+    hg_time_t now;
+    int64_t head;
+
+    if (r->stop)
+        return 0;
+
+    ring = (struct hg_dlog_rec_ring *) hg_thread_getspecific(r->rkey);
+    if (ring == NULL) {
+        ring = hg_dlog_rec_ring_create(r);
+        if (ring == NULL)
+            return 0;
+    }
+
+    /* only this thread writes to the ring, the release store of head
+     * publishes the record to concurrent dumps */
+    head = hg_atomic_get64(&ring->head);
+    e = &ring->entries[(uint64_t) head & (r->size - 1)];
+    hg_time_get_current(&now);
+#if defined(HG_UTIL_HAS_TIME_H) && defined(HG_UTIL_HAS_CLOCK_GETTIME)
+    e->time = (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+#else
+    e->time =
+        (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_usec * 1000;
+#endif
+    e->handle = (uint64_t) (uintptr_t) handle;
+    e->arg[0] = arg0;
+    e->arg[1] = arg1;
+    e->event = event;
+    e->reserved = 0;
+    hg_atomic_set64(&ring->head, head + 1);
+
+    return 1;
+}
+
 #ifdef __cplusplus
 }
 #endif
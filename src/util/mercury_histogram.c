@@ -0,0 +1,63 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_histogram.h"
+
+/*---------------------------------------------------------------------------*/
+void
+hg_histogram_reset(struct hg_histogram *hg_histogram)
+{
+    unsigned int i;
+
+    for (i = 0; i < HG_HISTOGRAM_BUCKETS; i++)
+        hg_atomic_set64(&hg_histogram->buckets[i], 0);
+    hg_atomic_set64(&hg_histogram->max, 0);
+}
+
+/*---------------------------------------------------------------------------*/
+uint64_t
+hg_histogram_count(const struct hg_histogram *hg_histogram)
+{
+    uint64_t count = 0;
+    unsigned int i;
+
+    for (i = 0; i < HG_HISTOGRAM_BUCKETS; i++)
+        count += (uint64_t) hg_atomic_get64(&hg_histogram->buckets[i]);
+
+    return count;
+}
+
+/*---------------------------------------------------------------------------*/
+uint64_t
+hg_histogram_percentile(
+    const struct hg_histogram *hg_histogram, double percentile)
+{
+    uint64_t count = hg_histogram_count(hg_histogram), target, total = 0,
+             max = hg_histogram_max(hg_histogram);
+    unsigned int i;
+
+    if (count == 0)
+        return 0;
+
+    if (percentile > 100.0)
+        percentile = 100.0;
+    target = (uint64_t) (percentile / 100.0 * (double) count + 0.5);
+    if (target == 0)
+        target = 1;
+
+    for (i = 0; i < HG_HISTOGRAM_BUCKETS; i++) {
+        total += (uint64_t) hg_atomic_get64(&hg_histogram->buckets[i]);
+        if (total >= target) {
+            uint64_t value = hg_histogram_bucket_value(i);
+
+            /* Do not report values above what has been recorded */
+            return (max > 0 && value > max) ? max : value;
+        }
+    }
+
+    return max;
+}
@@ -0,0 +1,189 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MERCURY_HISTOGRAM_H
+#define MERCURY_HISTOGRAM_H
+
+#include "mercury_atomic.h"
+
+/*****************/
+/* Public Macros */
+/*****************/
+
+/* Each power of two is split into 2^HG_HISTOGRAM_SUB_BITS linear buckets,
+ * which bounds the relative error of recorded values to 1/2^SUB_BITS */
+#define HG_HISTOGRAM_SUB_BITS  (3)
+#define HG_HISTOGRAM_SUB_COUNT (1 << HG_HISTOGRAM_SUB_BITS)
+
+/* Values above 2^HG_HISTOGRAM_MAX_BITS - 1 are clamped */
+#define HG_HISTOGRAM_MAX_BITS (40)
+#define HG_HISTOGRAM_VALUE_MAX                                                 \
+    ((UINT64_C(1) << HG_HISTOGRAM_MAX_BITS) - 1)
+
+/* Total number of buckets */
+#define HG_HISTOGRAM_BUCKETS                                                   \
+    ((HG_HISTOGRAM_MAX_BITS - HG_HISTOGRAM_SUB_BITS + 1) *                     \
+        HG_HISTOGRAM_SUB_COUNT)
+
+/*************************************/
+/* Public Type and Struct Definition */
+/*************************************/
+
+/* Log-linear (HDR-style) histogram, can be recorded concurrently */
+struct hg_histogram {
+    hg_atomic_int64_t buckets[HG_HISTOGRAM_BUCKETS]; /* Bucket counts */
+    hg_atomic_int64_t max;                           /* Max recorded value */
+};
+
+/*********************/
+/* Public Prototypes */
+/*********************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Reset all the counts of a histogram. Values recorded concurrently may or
+ * may not be kept.
+ *
+ * \param hg_histogram [IN/OUT] pointer to histogram
+ */
+HG_UTIL_PUBLIC void
+hg_histogram_reset(struct hg_histogram *hg_histogram);
+
+/**
+ * Record value into histogram.
+ *
+ * \param hg_histogram [IN/OUT] pointer to histogram
+ * \param value [IN]            value to record
+ */
+static HG_UTIL_INLINE void
+hg_histogram_record(struct hg_histogram *hg_histogram, uint64_t value);
+
+/**
+ * Get total number of values recorded.
+ *
+ * \param hg_histogram [IN]     pointer to histogram
+ *
+ * \return Number of values
+ */
+HG_UTIL_PUBLIC uint64_t
+hg_histogram_count(const struct hg_histogram *hg_histogram);
+
+/**
+ * Get max value recorded.
+ *
+ * \param hg_histogram [IN]     pointer to histogram
+ *
+ * \return Max value or 0 if histogram is empty
+ */
+static HG_UTIL_INLINE uint64_t
+hg_histogram_max(const struct hg_histogram *hg_histogram);
+
+/**
+ * Get value at percentile, the value returned is the highest value that is
+ * equivalent to the bucket that contains that percentile.
+ *
+ * \param hg_histogram [IN]     pointer to histogram
+ * \param percentile [IN]       percentile (between 0 and 100)
+ *
+ * \return Value or 0 if histogram is empty
+ */
+HG_UTIL_PUBLIC uint64_t
+hg_histogram_percentile(
+    const struct hg_histogram *hg_histogram, double percentile);
+
+/**
+ * Get index of bucket that value belongs to.
+ *
+ * \param value [IN]            value
+ *
+ * \return Bucket index
+ */
+static HG_UTIL_INLINE unsigned int
+hg_histogram_bucket_index(uint64_t value);
+
+/**
+ * Get highest value that belongs to bucket.
+ *
+ * \param index [IN]            bucket index
+ *
+ * \return Highest equivalent value
+ */
+static HG_UTIL_INLINE uint64_t
+hg_histogram_bucket_value(unsigned int index);
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE unsigned int
+hg_histogram_bucket_index(uint64_t value)
+{
+    unsigned int exp;
+
+    if (value < HG_HISTOGRAM_SUB_COUNT)
+        return (unsigned int) value;
+    if (value > HG_HISTOGRAM_VALUE_MAX)
+        value = HG_HISTOGRAM_VALUE_MAX;
+
+#if defined(__GNUC__)
+    exp = 63 - (unsigned int) __builtin_clzll(value);
+#else
+    for (exp = 0; (value >> exp) > 1; exp++)
+        continue;
+#endif
+
+    return (exp - HG_HISTOGRAM_SUB_BITS + 1) * HG_HISTOGRAM_SUB_COUNT +
+           (unsigned int) ((value >> (exp - HG_HISTOGRAM_SUB_BITS)) &
+                           (HG_HISTOGRAM_SUB_COUNT - 1));
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE uint64_t
+hg_histogram_bucket_value(unsigned int index)
+{
+    unsigned int shift;
+
+    if (index < HG_HISTOGRAM_SUB_COUNT)
+        return index;
+
+    shift = index / HG_HISTOGRAM_SUB_COUNT - 1;
+
+    return (((uint64_t) (HG_HISTOGRAM_SUB_COUNT +
+                         index % HG_HISTOGRAM_SUB_COUNT) +
+                1)
+               << shift) -
+           1;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE void
+hg_histogram_record(struct hg_histogram *hg_histogram, uint64_t value)
+{
+    int64_t max;
+
+    hg_atomic_incr64(
+        &hg_histogram->buckets[hg_histogram_bucket_index(value)]);
+
+    /* Max rarely changes, only attempt to update it when it does */
+    max = hg_atomic_get64(&hg_histogram->max);
+    while ((uint64_t) max < value &&
+           !hg_atomic_cas64(&hg_histogram->max, max, (int64_t) value))
+        max = hg_atomic_get64(&hg_histogram->max);
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE uint64_t
+hg_histogram_max(const struct hg_histogram *hg_histogram)
+{
+    return (uint64_t) hg_atomic_get64(&hg_histogram->max);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MERCURY_HISTOGRAM_H */
@@ -21,9 +21,27 @@
 #    include <sys/stat.h> /* For mode constants */
 #    include <sys/types.h>
 #    include <unistd.h>
+#    ifdef __linux__
+#        include <sys/syscall.h>
+#    endif
 #endif
 #include <stdlib.h>
 
+/****************/
+/* Local Macros */
+/****************/
+
+/* Memory policies are set through system calls to avoid depending on libnuma
+ * (see linux/mempolicy.h) */
+#if defined(__linux__) && defined(SYS_set_mempolicy) &&                        \
+    defined(SYS_get_mempolicy)
+#    define HG_MEM_HAS_NUMA
+#    define HG_MEM_MPOL_PREFERRED (1)
+/* set_mempolicy() ignores the last bit of the mask, pass one more node so that
+ * the last node can still be selected */
+#    define HG_MEM_NUMA_SET_MAXNODE ((unsigned long) HG_MEM_NUMA_NODE_MAX + 1)
+#endif
+
 /*---------------------------------------------------------------------------*/
 long
 hg_mem_get_page_size(void)
@@ -148,6 +166,26 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+int
+hg_mem_huge_advise(void *mem_ptr, size_t size)
+{
+#ifdef MADV_HUGEPAGE
+    /* Not an error, transparent huge pages may be disabled */
+    if (madvise(mem_ptr, size, MADV_HUGEPAGE) != 0) {
+        HG_UTIL_LOG_DEBUG("madvise() failed (%s)", strerror(errno));
+        return HG_UTIL_FAIL;
+    }
+
+    return HG_UTIL_SUCCESS;
+#else
+    (void) mem_ptr;
+    (void) size;
+
+    return HG_UTIL_FAIL;
+#endif
+}
+
 /*---------------------------------------------------------------------------*/
 void
 hg_mem_aligned_free(void *mem_ptr)
@@ -282,3 +320,63 @@ hg_mem_shm_unmap(const char *name, void *mem_ptr, size_t size)
 done:
     return ret;
 }
+
+/*---------------------------------------------------------------------------*/
+int
+hg_mem_numa_preferred_set(int node, struct hg_mem_numa_policy *prev_policy)
+{
+    int ret;
+
+#ifdef HG_MEM_HAS_NUMA
+    unsigned long nodemask[HG_MEM_NUMA_NODE_MAX / (8 * sizeof(unsigned long))];
+    long rc;
+
+    HG_UTIL_CHECK_ERROR(node < 0 || node >= HG_MEM_NUMA_NODE_MAX, error, ret,
+        HG_UTIL_FAIL, "Invalid NUMA node (%d)", node);
+
+    rc = syscall(SYS_get_mempolicy, &prev_policy->mode, prev_policy->nodemask,
+        (unsigned long) HG_MEM_NUMA_NODE_MAX, NULL, 0UL);
+    HG_UTIL_CHECK_ERROR(rc != 0, error, ret, HG_UTIL_FAIL,
+        "get_mempolicy() failed (%s)", strerror(errno));
+
+    memset(nodemask, 0, sizeof(nodemask));
+    nodemask[(size_t) node / (8 * sizeof(unsigned long))] |=
+        1UL << ((size_t) node % (8 * sizeof(unsigned long)));
+
+    rc = syscall(SYS_set_mempolicy, HG_MEM_MPOL_PREFERRED, nodemask,
+        HG_MEM_NUMA_SET_MAXNODE);
+    HG_UTIL_CHECK_ERROR(rc != 0, error, ret, HG_UTIL_FAIL,
+        "set_mempolicy() failed (%s)", strerror(errno));
+#else
+    (void) node;
+    (void) prev_policy;
+    HG_UTIL_CHECK_ERROR(1, error, ret, HG_UTIL_FAIL, "not implemented");
+#endif
+
+    return HG_UTIL_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+hg_mem_numa_policy_restore(const struct hg_mem_numa_policy *policy)
+{
+    int ret;
+
+#ifdef HG_MEM_HAS_NUMA
+    long rc = syscall(SYS_set_mempolicy, policy->mode, policy->nodemask,
+        HG_MEM_NUMA_SET_MAXNODE);
+    HG_UTIL_CHECK_ERROR(rc != 0, error, ret, HG_UTIL_FAIL,
+        "set_mempolicy() failed (%s)", strerror(errno));
+#else
+    (void) policy;
+    HG_UTIL_CHECK_ERROR(1, error, ret, HG_UTIL_FAIL, "not implemented");
+#endif
+
+    return HG_UTIL_SUCCESS;
+
+error:
+    return ret;
+}
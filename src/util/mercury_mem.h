@@ -14,6 +14,15 @@
 /* Public Type and Struct Definition */
 /*************************************/
 
+/* Maximum number of NUMA nodes that memory policies can refer to */
+#define HG_MEM_NUMA_NODE_MAX 1024
+
+/* Memory policy of the calling thread */
+struct hg_mem_numa_policy {
+    unsigned long nodemask[HG_MEM_NUMA_NODE_MAX / (8 * sizeof(unsigned long))];
+    int mode;
+};
+
 /*****************/
 /* Public Macros */
 /*****************/
@@ -86,6 +95,19 @@ hg_mem_huge_alloc(size_t size);
 HG_UTIL_PUBLIC int
 hg_mem_huge_free(void *mem_ptr, size_t size);
 
+/**
+ * Advise the system to back an existing memory range with transparent huge
+ * pages. This is only a hint and the range is left unchanged if transparent
+ * huge pages are not supported.
+ *
+ * \param mem_ptr [IN]          pointer to memory range
+ * \param size [IN]             size of memory range
+ *
+ * \return Non-negative on success or negative on failure
+ */
+HG_UTIL_PUBLIC int
+hg_mem_huge_advise(void *mem_ptr, size_t size);
+
 /**
  * Allocate a buffer with a `size`-bytes, `alignment`-aligned payload
  * preceded by a `header_size` header, padding the allocation with up
@@ -115,6 +137,29 @@ hg_mem_header_alloc(size_t header_size, size_t alignment, size_t size);
 HG_UTIL_PUBLIC void
 hg_mem_header_free(size_t header_size, size_t alignment, void *mem_ptr);
 
+/**
+ * Set the memory policy of the calling thread so that memory is preferably
+ * allocated on NUMA node \node, the previous policy is returned so that it can
+ * be restored with hg_mem_numa_policy_restore().
+ *
+ * \param node [IN]             NUMA node
+ * \param prev_policy [OUT]     pointer to previous policy
+ *
+ * \return Non-negative on success or negative on failure
+ */
+HG_UTIL_PUBLIC int
+hg_mem_numa_preferred_set(int node, struct hg_mem_numa_policy *prev_policy);
+
+/**
+ * Restore a memory policy returned by hg_mem_numa_preferred_set().
+ *
+ * \param policy [IN]           pointer to policy
+ *
+ * \return Non-negative on success or negative on failure
+ */
+HG_UTIL_PUBLIC int
+hg_mem_numa_policy_restore(const struct hg_mem_numa_policy *policy);
+
 /**
  * Create/open a shared-memory mapped file of size \size with name \name.
  *
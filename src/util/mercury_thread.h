@@ -131,6 +131,20 @@ hg_thread_equal(hg_thread_t t1, hg_thread_t t2);
 HG_UTIL_PUBLIC int
 hg_thread_key_create(hg_thread_key_t *key);
 
+/**
+ * Create a thread-specific data key visible to all threads in the process.
+ * When a thread that has set a non-NULL value exits, destructor is called with
+ * that value, unless the key has been deleted (destructors are not supported
+ * on Windows and are ignored).
+ *
+ * \param key [OUT]             pointer to thread key object
+ * \param destructor [IN]       destructor called on thread exit (or NULL)
+ *
+ * \return Non-negative on success or negative on failure
+ */
+HG_UTIL_PUBLIC int
+hg_thread_key_create2(hg_thread_key_t *key, void (*destructor)(void *));
+
 /**
  * Delete a thread-specific data key previously returned by
  * hg_thread_key_create().
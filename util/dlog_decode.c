@@ -0,0 +1,237 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_dlog.h"
+
+#include "getopt.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct options {
+    const char *file_name;
+    bool output_csv;
+    bool unsorted;
+};
+
+/* decoded record */
+struct record {
+    struct hg_dlog_rec_entry entry;
+    unsigned int ring;
+};
+
+static const char *short_opts_g = "hcu";
+static const struct option long_opts_g[] = {
+    {"csv", no_arg, 'c'}, {"unsorted", no_arg, 'u'},
+    {NULL, 0, '\0'} /* Must add this at the end */
+};
+
+/*---------------------------------------------------------------------------*/
+static void
+usage(const char *execname)
+{
+    printf("usage: %s [OPTIONS] <file.rec>\n", execname);
+    printf("    OPTIONS\n");
+    printf("    -h, --help           Print a usage message and exit\n");
+    printf("    -c, --csv            Output in CSV format\n");
+    printf("    -u, --unsorted       Output rings one after the other\n");
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+parse_options(int argc, char **argv, struct options *opts)
+{
+    int opt;
+
+    memset(opts, 0, sizeof(*opts));
+
+    while ((opt = getopt(argc, argv, short_opts_g, long_opts_g)) != -1) {
+        switch (opt) {
+            case 'c':
+                opts->output_csv = true;
+                break;
+            case 'u':
+                opts->unsorted = true;
+                break;
+            default:
+                usage(argv[0]);
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if ((argc - opt_ind_g) != 1) {
+        usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    opts->file_name = argv[opt_ind_g];
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+record_cmp(const void *a, const void *b)
+{
+    const struct record *ra = (const struct record *) a,
+                        *rb = (const struct record *) b;
+
+    if (ra->entry.time != rb->entry.time)
+        return (ra->entry.time < rb->entry.time) ? -1 : 1;
+    return (ra->ring < rb->ring) ? -1 : (ra->ring > rb->ring);
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+read_records(FILE *fp, const struct hg_dlog_rec_header *hdr,
+    struct record **records_p, size_t *count_p)
+{
+    struct hg_dlog_rec_entry *entries = NULL;
+    struct record *records = NULL;
+    size_t count = 0;
+    unsigned int i;
+
+    entries = malloc(sizeof(*entries) * hdr->size);
+    records = malloc(sizeof(*records) * hdr->size * (size_t) hdr->nrings);
+    if (entries == NULL || (records == NULL && hdr->nrings > 0)) {
+        fprintf(stderr, "Could not allocate records\n");
+        goto error;
+    }
+
+    for (i = 0; i < hdr->nrings; i++) {
+        struct hg_dlog_rec_ring_header rhdr;
+        uint64_t head_end, lo, seq;
+
+        if (fread(&rhdr, sizeof(rhdr), 1, fp) != 1 ||
+            fread(entries, sizeof(*entries), hdr->size, fp) != hdr->size ||
+            fread(&head_end, sizeof(head_end), 1, fp) != 1) {
+            fprintf(stderr, "Truncated ring %u\n", i);
+            goto error;
+        }
+
+        /* records at and past head_end + 1 - size may have been overwritten
+         * while the ring was being dumped (+1 for a record in progress) */
+        lo = (head_end + 1 > hdr->size) ? head_end + 1 - hdr->size : 0;
+        for (seq = lo; seq < rhdr.head; seq++) {
+            records[count].entry = entries[seq & (hdr->size - 1)];
+            records[count].ring = rhdr.id;
+            count++;
+        }
+    }
+
+    free(entries);
+    *records_p = records;
+    *count_p = count;
+
+    return EXIT_SUCCESS;
+
+error:
+    free(entries);
+    free(records);
+    return EXIT_FAILURE;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+print_csv(const struct record *records, size_t count)
+{
+    size_t i;
+
+    printf("time,ring,event,handle,arg0,arg1\n");
+    for (i = 0; i < count; i++)
+        printf("%" PRIu64 ",%u,%" PRIu32 ",0x%" PRIx64 ",%" PRIu64
+               ",%" PRIu64 "\n",
+            records[i].entry.time, records[i].ring, records[i].entry.event,
+            records[i].entry.handle, records[i].entry.arg[0],
+            records[i].entry.arg[1]);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+print_std(const struct hg_dlog_rec_header *hdr, const struct record *records,
+    size_t count)
+{
+    size_t i;
+
+    printf("# (%.*s) flight recorder of pid %" PRIu64 ", %" PRIu32
+           " ring(s) of %" PRIu32 " records, %zu valid\n",
+        (int) (HG_DLOG_MAGICLEN - strlen(HG_DLOG_RECMAGIC)),
+        hdr->magic + strlen(HG_DLOG_RECMAGIC), hdr->pid, hdr->nrings,
+        hdr->size, count);
+    printf("#%19s %5s %10s %18s %20s %20s\n", "time (s)", "ring", "event",
+        "handle", "arg0", "arg1");
+    for (i = 0; i < count; i++)
+        printf("%10" PRIu64 ".%09" PRIu64 " %5u %10" PRIu32 " 0x%016" PRIx64
+               " %20" PRIu64 " %20" PRIu64 "\n",
+            records[i].entry.time / 1000000000,
+            records[i].entry.time % 1000000000, records[i].ring,
+            records[i].entry.event, records[i].entry.handle,
+            records[i].entry.arg[0], records[i].entry.arg[1]);
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+decode(const struct options *options)
+{
+    struct hg_dlog_rec_header hdr;
+    struct record *records = NULL;
+    size_t count = 0;
+    FILE *fp;
+    int ret = EXIT_FAILURE;
+
+    fp = fopen(options->file_name, "rb");
+    if (fp == NULL) {
+        perror("fopen");
+        return EXIT_FAILURE;
+    }
+
+    if (fread(&hdr, sizeof(hdr), 1, fp) != 1 ||
+        strncmp(hdr.magic, HG_DLOG_RECMAGIC, strlen(HG_DLOG_RECMAGIC)) != 0) {
+        fprintf(stderr, "%s is not a flight recorder dump\n",
+            options->file_name);
+        goto done;
+    }
+    if (hdr.version != HG_DLOG_REC_VERSION ||
+        hdr.esize != sizeof(struct hg_dlog_rec_entry) || hdr.size == 0 ||
+        (hdr.size & (hdr.size - 1)) != 0) {
+        fprintf(stderr,
+            "Unsupported dump (version %" PRIu32 ", record size %" PRIu32
+            ", ring size %" PRIu32 ")\n",
+            hdr.version, hdr.esize, hdr.size);
+        goto done;
+    }
+
+    ret = read_records(fp, &hdr, &records, &count);
+    if (ret != EXIT_SUCCESS)
+        goto done;
+
+    if (!options->unsorted && count > 0)
+        qsort(records, count, sizeof(*records), record_cmp);
+
+    if (options->output_csv)
+        print_csv(records, count);
+    else
+        print_std(&hdr, records, count);
+
+done:
+    free(records);
+    fclose(fp);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    struct options options;
+
+    parse_options(argc, argv, &options);
+
+    return decode(&options);
+}